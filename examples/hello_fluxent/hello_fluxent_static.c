@@ -5,7 +5,7 @@
 
 static void radio_group_apply(RadioGroupMember const *m, int index) {
 	RadioGroup   *g  = m->group;
-	FluxNodeData *nd = flux_node_store_get(g->store, g->nodes [index]);
+	FluxNodeData *nd = flux_node_store_edit(g->store, g->nodes [index]);
 	if (!nd || !nd->component_data) return;
 	if (!xent_get_semantic_enabled(flux_node_store_context(g->store), g->nodes [index])) return;
 
@@ -42,7 +42,7 @@ static void on_toggle_click(void *ctx) {
 	ToggleState *ts  = ( ToggleState * ) ctx;
 	ts->toggled      = !ts->toggled;
 
-	FluxNodeData *nd = flux_node_store_get(ts->store, ts->node);
+	FluxNodeData *nd = flux_node_store_edit(ts->store, ts->node);
 	if (nd && nd->component_data) {
 		FluxButtonData *bd = ( FluxButtonData * ) nd->component_data;
 		bd->is_checked     = ts->toggled;
@@ -124,7 +124,7 @@ demo_create_text(XentContext *ctx, FluxNodeStore *store, XentNodeId parent, char
 }
 
 static void demo_text_set_vertical_center(FluxNodeStore *store, XentNodeId node) {
-	FluxNodeData *nd = flux_node_store_get(store, node);
+	FluxNodeData *nd = flux_node_store_edit(store, node);
 	if (!nd || nd->component_type != FLUX_CONTROL_TEXT || !nd->component_data) return;
 
 	FluxTextData *td       = ( FluxTextData * ) nd->component_data;
@@ -318,7 +318,7 @@ void demo_add_toggle(Demo *d) {
 	XentNodeId tb2  = demo_button(d, row, "Toggled On", NULL, NULL);
 	xent_set_size(d->ctx, tb2, (XentSize) {130, 32});
 	flux_set_control_type(d->ctx, tb2, FLUX_CONTROL_TOGGLE_BUTTON);
-	FluxNodeData *nd = flux_node_store_get(d->store, tb2);
+	FluxNodeData *nd = flux_node_store_edit(d->store, tb2);
 	if (nd && nd->component_data) (( FluxButtonData * ) nd->component_data)->is_checked = true;
 	add_divider(d);
 }
@@ -375,10 +375,10 @@ static void demo_wire_radio_group(Demo *d) {
 	for (int i = 0; i < d->radio->count; i++) {
 		d->members [i].group = d->radio;
 		d->members [i].index = i;
-		FluxNodeData *nd     = flux_node_store_get(d->store, d->radio->nodes [i]);
+		FluxNodeData *nd     = flux_node_store_edit(d->store, d->radio->nodes [i]);
 		if (!nd) continue;
-		nd->behavior.on_click     = radio_group_trampoline;
-		nd->behavior.on_click_ctx = &d->members [i];
+		nd->behavior->on_click     = radio_group_trampoline;
+		nd->behavior->on_click_ctx = &d->members [i];
 	}
 }
 
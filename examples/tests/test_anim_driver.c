@@ -0,0 +1,248 @@
+/**
+ * @file test_anim_driver.c
+ * @brief Headless test of the animation driver under a fake clock. It checks
+ * that awake animators are stepped once per tick with the frame time, that one
+ * registered from a step waits for the next tick, and that steps may
+ * unregister themselves or each other. Sleepers must be stepped by the first
+ * tick at or after their deadline and never before, including deadlines more
+ * than one turn of the timer wheel away and a clock that wraps; a random model
+ * check covers that. The host wake hook must be asked for a frame only when
+ * something is awake or a sleeper comes due, and a host clearing the hook must
+ * leave one installed by another host alone. Finally a caret that re-sleeps
+ * every 530 ms for 10 s is compared with the frames a per-frame animator takes
+ * at 144 Hz.
+ */
+#include "runtime/flux_anim_driver.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define SLEEPERS  400
+#define BLINK_MS  530ul
+#define FRAME_144 7ul
+
+static unsigned long g_now;
+static int           g_wakes;
+static unsigned long g_wake_delay;
+
+static unsigned long fake_clock(void *ctx) {
+	( void ) ctx;
+	return g_now;
+}
+
+static void fake_wake(void *ctx, unsigned long delay_ms) {
+	( void ) ctx;
+	g_wakes++;
+	g_wake_delay = delay_ms;
+}
+
+/* Ticks like the app does: at the frame time, and again whenever it asks. */
+static bool tick_at(unsigned long now) {
+	g_now = now;
+	return flux_anim_tick(now);
+}
+
+typedef struct Counter {
+	int           steps;
+	int           stop_after; /**< Return false on this step (0 = never). */
+	unsigned long last_now;
+	void         *spawn;      /**< Registered from the first step. */
+	void         *kill;       /**< Unregistered from the first step. */
+} Counter;
+
+static bool counter_step(void *ctx, unsigned long now) {
+	Counter *c  = ( Counter * ) ctx;
+	c->last_now = now;
+	if (++c->steps == 1) {
+		if (c->spawn) flux_anim_register(c->spawn, counter_step);
+		if (c->kill) flux_anim_unregister(c->kill);
+	}
+	return c->stop_after == 0 || c->steps < c->stop_after;
+}
+
+typedef struct Sleeper {
+	unsigned long deadline;
+	unsigned long stepped_at;
+	int           steps;
+} Sleeper;
+
+static bool sleeper_step(void *ctx, unsigned long now) {
+	Sleeper *s    = ( Sleeper * ) ctx;
+	s->stepped_at = now;
+	s->steps++;
+	return false;
+}
+
+static int blink_steps;
+
+static bool blink_step(void *ctx, unsigned long now) {
+	blink_steps++;
+	flux_anim_sleep_until(ctx, blink_step, now + BLINK_MS);
+	return true;
+}
+
+static int check_awake(void) {
+	Counter a = {.stop_after = 3};
+	Counter b = {0};
+	Counter c = {0};
+	a.spawn   = &b;
+
+	g_wakes   = 0;
+	flux_anim_register(&a, counter_step);
+	EXPECT(g_wakes == 1 && g_wake_delay == 0, "register asks for a frame now");
+	flux_anim_register(&a, counter_step);
+	EXPECT(tick_at(g_now + 7) && a.steps == 1 && a.last_now == g_now, "stepped once with the frame time");
+	EXPECT(b.steps == 0, "registered from a step waits for the next tick");
+	EXPECT(g_wakes == 2, "no wake asked from inside a tick");
+	tick_at(g_now + 7);
+	EXPECT(a.steps == 2 && b.steps == 1, "both stepped");
+	tick_at(g_now + 7);
+	tick_at(g_now + 7);
+	EXPECT(a.steps == 3 && b.steps == 3, "a finished after returning false");
+
+	c.kill = &b;
+	flux_anim_register(&c, counter_step);
+	tick_at(g_now + 7);
+	int b_steps = b.steps;
+	tick_at(g_now + 7);
+	EXPECT(b.steps == b_steps, "unregistered by another step");
+	flux_anim_unregister(&c);
+	flux_anim_unregister(&b);
+	flux_anim_unregister(&b);
+	EXPECT(!tick_at(g_now + 7), "nothing awake");
+	return 0;
+}
+
+static int check_sleepers(void) {
+	Sleeper s = {0};
+	Sleeper far = {0};
+	g_wakes   = 0;
+	flux_anim_sleep_until(&s, sleeper_step, g_now + 500);
+	EXPECT(g_wakes == 1 && g_wake_delay == 500, "host asked to wake at the deadline");
+	flux_anim_sleep_until(&far, sleeper_step, g_now + 5000);
+	EXPECT(g_wakes == 1, "a later sleeper does not re-arm");
+
+	unsigned long deadline;
+	EXPECT(flux_anim_next_deadline(&deadline) && deadline == g_now + 500, "next deadline");
+	unsigned long start = g_now;
+	EXPECT(!tick_at(start + 100) && s.steps == 0, "not due");
+	EXPECT(g_wake_delay == 400, "re-armed for the rest");
+	tick_at(start + 499);
+	EXPECT(s.steps == 0, "one ms early");
+	tick_at(start + 500);
+	EXPECT(s.steps == 1 && s.stepped_at == start + 500, "stepped at the deadline");
+	EXPECT(flux_anim_next_deadline(&deadline) && deadline == start + 5000, "far sleeper next");
+
+	/* Several turns of the wheel pass over the far sleeper's slot. */
+	for (unsigned long t = start + 516; t < start + 5000; t += 16) {
+		tick_at(t);
+		EXPECT(far.steps == 0, "far sleeper not woken a turn early");
+	}
+	tick_at(start + 5003);
+	EXPECT(far.steps == 1, "far sleeper woken");
+	EXPECT(!flux_anim_next_deadline(NULL), "no sleepers left");
+	return 0;
+}
+
+/* Random deadlines against random frame gaps, across a clock wrap: each
+ * sleeper is stepped exactly once, by the first tick at or after it. */
+static int check_model(void) {
+	static Sleeper sl [SLEEPERS];
+	g_now = ULONG_MAX - 3000ul;
+	for (int i = 0; i < SLEEPERS; i++) {
+		sl [i] = (Sleeper) {.deadline = g_now + 1ul + ( unsigned long ) (rand() % 6000)};
+		flux_anim_sleep_until(&sl [i], sleeper_step, sl [i].deadline);
+	}
+	unsigned long prev = g_now;
+	for (int frame = 0; frame < 2000; frame++) {
+		unsigned long gap = ( unsigned long ) (rand() % 10 == 0 ? rand() % 1500 : 1 + rand() % 20);
+		unsigned long now = prev + gap;
+		tick_at(now);
+		for (int i = 0; i < SLEEPERS; i++) {
+			long since = ( long ) (now - sl [i].deadline);
+			if (since < 0) EXPECT(sl [i].steps == 0, "sleeper stepped before its deadline");
+			else if (( long ) (prev - sl [i].deadline) < 0)
+				EXPECT(sl [i].steps == 1 && sl [i].stepped_at == now, "sleeper stepped by the first tick after it");
+		}
+		prev = now;
+	}
+	for (int i = 0; i < SLEEPERS; i++) EXPECT(sl [i].steps == 1, "every sleeper stepped once");
+	return 0;
+}
+
+static int check_blink(void) {
+	g_now       = 1000;
+	g_wakes     = 0;
+	int dummy   = 0;
+	blink_steps = 0;
+	flux_anim_sleep_until(&dummy, blink_step, g_now + BLINK_MS);
+
+	/* The host loop: render a frame only when asked, at the delay asked for. */
+	int           frames = 0;
+	unsigned long end    = g_now + 10000;
+	while (g_now < end) {
+		unsigned long delay = g_wake_delay;
+		int           wakes = g_wakes;
+		frames++;
+		if (tick_at(g_now + (delay ? delay : FRAME_144))) continue;
+		EXPECT(g_wakes == wakes + 1, "idle driver re-arms once per frame");
+	}
+	flux_anim_unregister(&dummy);
+	EXPECT(blink_steps == frames && blink_steps >= 18 && blink_steps <= 19, "one frame per blink");
+
+	int     busy_frames = 0;
+	Counter spin        = {0};
+	g_now               = 1000;
+	flux_anim_register(&spin, counter_step);
+	for (; g_now < 11000; busy_frames++) tick_at(g_now + FRAME_144);
+	flux_anim_unregister(&spin);
+	printf("caret over 10 s: %d frames as a sleeper, %d as a per-frame animator at 144 Hz\n", frames, busy_frames);
+	return 0;
+}
+
+/* A host tearing down clears only the wake hook it installed itself. */
+static int check_wake_owner(void) {
+	int     other = 0;
+	Counter c     = {0};
+	flux_anim_clear_wake(fake_wake, &other);
+	int wakes = g_wakes;
+	flux_anim_register(&c, counter_step);
+	EXPECT(g_wakes == wakes + 1, "another host's clear leaves the hook");
+	flux_anim_unregister(&c);
+
+	flux_anim_clear_wake(fake_wake, NULL);
+	wakes = g_wakes;
+	flux_anim_register(&c, counter_step);
+	EXPECT(g_wakes == wakes, "the owner's clear removes the hook");
+	flux_anim_unregister(&c);
+	flux_anim_set_wake(fake_wake, NULL);
+	return 0;
+}
+
+int main(void) {
+	srand(7);
+	flux_anim_set_clock(fake_clock, NULL);
+	flux_anim_set_wake(fake_wake, NULL);
+	g_now = 100000;
+
+	if (check_awake()) return 1;
+	if (check_sleepers()) return 1;
+	if (check_model()) return 1;
+	if (check_blink()) return 1;
+	if (check_wake_owner()) return 1;
+
+	flux_anim_set_wake(NULL, NULL);
+	flux_anim_set_clock(NULL, NULL);
+	printf("PASS: animation driver\n");
+	return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file test_frame_stats.c
+ * @brief Headless test for the per-frame timing ring and its Chrome trace.
+ *
+ * Records more frames than the ring holds, with phases timed from synthetic
+ * clock ticks, and checks that the newest frames are kept in order with
+ * their phase spans and counters, that a phase entered twice accumulates,
+ * and that the trace file holds one frame event per kept frame plus one
+ * event per phase that ran. The DirectManipulation tick and sync are phases
+ * of their own on either side of layout. No window or GPU.
+ */
+#include <fluxent/fluxent.h>
+#include "runtime/flux_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define CAPACITY 8
+#define FRAMES   21
+#define MS       (flux_perf_freq() / 1000)
+
+static int count_occurrences(char const *text, char const *needle) {
+	int n = 0;
+	for (char const *p = strstr(text, needle); p; p = strstr(p + 1, needle)) n++;
+	return n;
+}
+
+static int64_t phase_end(FluxFrameRecord const *r, FluxFramePhase p) { return r->phase_start [p] + r->phase_ticks [p]; }
+
+/* Frame f starts at f * 16 ms: 1 ms of layout, then collect in two 1 ms
+ * pieces, and a present on even frames only. */
+static void record_frame(FluxFrameStats *stats, int f) {
+	int64_t          t = ( int64_t ) f * 16 * MS;
+	FluxFrameRecord *r = flux_frame_stats_begin(stats, t);
+	flux_frame_stats_phase(r, FLUX_FRAME_PHASE_LAYOUT, t, t + MS);
+	flux_frame_stats_phase(r, FLUX_FRAME_PHASE_COLLECT, t + MS, t + 2 * MS);
+	flux_frame_stats_phase(r, FLUX_FRAME_PHASE_COLLECT, t + 3 * MS, t + 4 * MS);
+	if (f % 2 == 0) flux_frame_stats_phase(r, FLUX_FRAME_PHASE_PRESENT, t + 4 * MS, t + 5 * MS);
+	r->commands        = ( uint32_t ) (100 + f);
+	r->reused_commands = ( uint32_t ) f;
+	r->snapshot_bytes  = 4096;
+	r->presented       = f % 2 == 0;
+	flux_frame_stats_end(stats, t + 6 * MS);
+}
+
+int main(void) {
+	FluxFrameStats *stats = flux_frame_stats_create(CAPACITY);
+	EXPECT(stats, "ring creation");
+	EXPECT(flux_frame_stats_count(stats) == 0 && !flux_frame_stats_get(stats, 0), "empty ring");
+
+	flux_frame_stats_begin(stats, 0);
+	EXPECT(flux_frame_stats_count(stats) == 0, "an open frame is not readable");
+	flux_frame_stats_clear(stats);
+
+	for (int f = 0; f < FRAMES; f++) record_frame(stats, f);
+	EXPECT(flux_frame_stats_count(stats) == CAPACITY, "ring keeps its capacity");
+	for (uint32_t age = 0; age < CAPACITY; age++) {
+		FluxFrameRecord const *r = flux_frame_stats_get(stats, age);
+		int                    f = FRAMES - 1 - ( int ) age;
+		EXPECT(r && r->commands == ( uint32_t ) (100 + f), "newest frames first");
+		EXPECT(r->frame == ( uint64_t ) f + 1, "sequence numbers count the cleared frame");
+		EXPECT(r->duration == 6 * MS, "frame duration");
+		EXPECT(r->phase_ticks [FLUX_FRAME_PHASE_LAYOUT] == MS, "layout span");
+		EXPECT(r->phase_ticks [FLUX_FRAME_PHASE_COLLECT] == 2 * MS, "a phase entered twice accumulates");
+		EXPECT(r->phase_start [FLUX_FRAME_PHASE_COLLECT] == r->start + MS, "a phase starts where it first ran");
+		bool present = (r->phase_mask & (1u << FLUX_FRAME_PHASE_PRESENT)) != 0;
+		EXPECT(present == (f % 2 == 0) && present == r->presented, "phases that did not run are not marked");
+		EXPECT(!(r->phase_mask & (1u << FLUX_FRAME_PHASE_EXECUTE)), "execute never ran");
+	}
+	EXPECT(!flux_frame_stats_get(stats, CAPACITY), "older frames were overwritten");
+	EXPECT(strcmp(flux_frame_phase_name(FLUX_FRAME_PHASE_LAYOUT), "layout") == 0, "phase names");
+
+	char const *path = "test_frame_stats.json";
+	EXPECT(flux_frame_stats_write_trace(stats, path), "trace written");
+	FILE *f = fopen(path, "rb");
+	EXPECT(f, "trace readable");
+	static char text [1 << 16];
+	size_t      len = fread(text, 1, sizeof(text) - 1, f);
+	fclose(f);
+	remove(path);
+	text [len] = '\0';
+	EXPECT(strncmp(text, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 39) == 0, "trace header");
+	EXPECT(strstr(text, "]}") != NULL, "trace footer");
+	EXPECT(count_occurrences(text, "\"cat\":\"frame\"") == CAPACITY, "one frame event per kept frame");
+	EXPECT(count_occurrences(text, "\"name\":\"collect\"") == CAPACITY, "a phase event per frame");
+	EXPECT(count_occurrences(text, "\"name\":\"present\"") == CAPACITY / 2, "only phases that ran");
+	EXPECT(count_occurrences(text, "\"ph\":\"C\"") == 2 * CAPACITY, "counter tracks");
+	EXPECT(!strstr(text, ",\n,") && !strstr(text, "[\n,"), "events are comma separated");
+
+	/* Tick, layout, sync: three back-to-back phases, none spanning another. */
+	int64_t          t = ( int64_t ) FRAMES * 16 * MS;
+	FluxFrameRecord *r = flux_frame_stats_begin(stats, t);
+	flux_frame_stats_phase(r, FLUX_FRAME_PHASE_DMANIP_TICK, t, t + MS);
+	flux_frame_stats_phase(r, FLUX_FRAME_PHASE_LAYOUT, t + MS, t + 3 * MS);
+	flux_frame_stats_phase(r, FLUX_FRAME_PHASE_DMANIP_SYNC, t + 3 * MS, t + 4 * MS);
+	flux_frame_stats_end(stats, t + 4 * MS);
+	FluxFrameRecord const *last  = flux_frame_stats_get(stats, 0);
+	int64_t const         *start = last->phase_start;
+	EXPECT(phase_end(last, FLUX_FRAME_PHASE_DMANIP_TICK) <= start [FLUX_FRAME_PHASE_LAYOUT], "tick, then layout");
+	EXPECT(phase_end(last, FLUX_FRAME_PHASE_LAYOUT) <= start [FLUX_FRAME_PHASE_DMANIP_SYNC], "layout, then sync");
+	EXPECT(strcmp(flux_frame_phase_name(FLUX_FRAME_PHASE_DMANIP_SYNC), "dmanip_sync") == 0, "sync phase name");
+
+	flux_frame_stats_destroy(stats);
+	printf("PASS: frame stats\n");
+	return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file test_fx_collect_bench.c
+ * @brief Headless benchmark for the render command stream.
+ *
+ * Builds a ~10k-node tree (cards holding a caption and a button), collects it
+ * repeatedly and reports the bytes produced per frame and the average collect
+ * time, both with retained subtrees (unchanged frames) and with every frame
+ * invalidated (full rebuild). Checks that draw payloads stay trimmed to their
+ * control type and that a command's snapshot decodes back intact. No window
+ * or GPU.
+ */
+#include <fluxent/fluxent.h>
+#include "runtime/flux_time.h"
+
+#include <stdio.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define BENCH_CARDS  3334 /* card + text + button = 3 nodes each */
+#define BENCH_FRAMES 20
+
+int main(void) {
+	XentConfig           config   = {0};
+	XentContext         *ctx      = xent_create_context(&config);
+	FluxNodeStore       *store    = flux_node_store_create(4 * BENCH_CARDS);
+	FluxControlRegistry *registry = flux_control_registry_create();
+	EXPECT(ctx && store && registry, "context/store/registry creation");
+	flux_node_store_bind_context(store, ctx);
+	flux_register_builtins(registry);
+
+	XentNodeId root = xent_create_node(ctx);
+	xent_set_protocol(ctx, root, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, root, XENT_FLEX_COLUMN);
+	xent_set_gap(ctx, root, 2.0f);
+
+	XentNodeId probe_text = XENT_NODE_INVALID;
+	for (int i = 0; i < BENCH_CARDS; i++) {
+		XentNodeId card = flux_create_card(&(FluxContainerCreateInfo) {ctx, store, root});
+		xent_set_protocol(ctx, card, XENT_PROTOCOL_FLEX);
+		xent_set_size(ctx, card, (XentSize) {240.0f, 32.0f});
+		XentNodeId text = flux_create_text(&(FluxTextCreateInfo) {ctx, store, card, "Caption", 13.0f});
+		flux_create_button(&(FluxButtonCreateInfo) {ctx, store, card, "Action", NULL, NULL});
+		if (i == 0) probe_text = text;
+	}
+	uint32_t nodes = 1 + 3 * BENCH_CARDS;
+
+	xent_layout(ctx, root, 1280.0f, 40.0f * BENCH_CARDS);
+	flux_node_store_attach_userdata(store, ctx);
+
+	FluxEngine *eng = flux_engine_create(store, registry);
+	EXPECT(eng, "engine creation");
+
+	flux_engine_collect(eng, ctx, root);
+	uint32_t count = flux_engine_command_count(eng);
+	EXPECT(count >= nodes, "one main command per node");
+
+	int64_t start = flux_perf_now();
+	for (int f = 0; f < BENCH_FRAMES; f++) flux_engine_collect(eng, ctx, root);
+	double warm = flux_perf_seconds(flux_perf_now() - start);
+
+	FluxEngineStats stats;
+	flux_engine_get_stats(eng, &stats);
+	EXPECT(stats.snapshots_built < nodes / 100, "unchanged frames rebuild almost no snapshots");
+
+	start = flux_perf_now();
+	for (int f = 0; f < BENCH_FRAMES; f++) {
+		flux_engine_invalidate(eng);
+		flux_engine_collect(eng, ctx, root);
+	}
+	double cold = flux_perf_seconds(flux_perf_now() - start);
+	flux_engine_get_stats(eng, &stats);
+	EXPECT(stats.snapshots_built == nodes && stats.reused_commands == 0, "invalidated frames rebuild everything");
+
+	size_t bytes  = flux_engine_frame_bytes(eng);
+	size_t legacy = ( size_t ) 2 * nodes * (sizeof(FluxRenderSnapshot) + sizeof(FluxRenderCommand));
+	printf(
+	  "collect: %u nodes, %u commands, %zu bytes/frame (%.1f per node, inline snapshots: %zu), %.3f ms/frame retained, "
+	  "%.3f ms/frame rebuilt\n",
+	  nodes, count, bytes, ( double ) bytes / nodes, legacy, warm * 1000.0 / BENCH_FRAMES, cold * 1000.0 / BENCH_FRAMES
+	);
+	EXPECT(bytes > 0, "frame bytes reported");
+	EXPECT(bytes * 2 < legacy, "payloads are trimmed to their control type");
+
+	bool found = false;
+	for (uint32_t i = 0; i < count && !found; i++) {
+		FluxRenderCommand const *cmd = flux_engine_command_at(eng, i);
+		FluxRenderSnapshot       snap;
+		if (cmd->clip_action != FLUX_CLIP_NONE) {
+			EXPECT(!flux_engine_command_snapshot(eng, i, &snap), "clip ops carry no payload");
+			continue;
+		}
+		EXPECT(flux_engine_command_snapshot(eng, i, &snap), "draw command decodes");
+		if (snap.id != probe_text) continue;
+		EXPECT(snap.type == FLUX_CONTROL_TEXT, "decoded type matches");
+		EXPECT(snap.font_size == 13.0f, "decoded base field matches");
+		EXPECT(snap.u.text.text_content && snap.u.text.text_content [0] == 'C', "decoded text arm matches");
+		found = true;
+	}
+	EXPECT(found, "probe text command present");
+
+	flux_engine_destroy(eng);
+	flux_control_registry_destroy(registry);
+	flux_node_store_destroy(store);
+	xent_destroy_context(ctx);
+	printf("PASS: collect bench\n");
+	return 0;
+}
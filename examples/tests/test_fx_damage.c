@@ -0,0 +1,176 @@
+/**
+ * @file test_fx_damage.c
+ * @brief Headless test for damage tracking behind the partial-redraw path.
+ *
+ * Covers the region primitives (merge, overflow, pixel snapping) and the
+ * engine's frame-to-frame diff: the first collect is full, an unchanged
+ * collect is empty, and a single changed control damages only its own rect.
+ * Also drives the tracker directly through a frame whose item count shrinks
+ * well below the previous one, so lookups must stay inside the rebuilt index.
+ * No window or GPU — collect never touches D2D.
+ */
+#include <fluxent/fluxent.h>
+#include "render/flux_damage_tracker.h"
+#include <math.h>
+#include <stdio.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+static bool rect_overlaps(FluxRect a, FluxRect b) {
+	return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+static FluxRect node_rect(XentContext *ctx, XentNodeId node) {
+	XentRect r = {0};
+	xent_get_layout_rect(ctx, node, &r);
+	return (FluxRect) {r.x, r.y, r.w, r.h};
+}
+
+static int test_region(void) {
+	FluxDamageRegion r;
+	flux_damage_clear(&r);
+	EXPECT(flux_damage_is_empty(&r), "cleared region is empty");
+
+	flux_damage_add(&r, (FluxRect) {0, 0, 10, 10});
+	flux_damage_add(&r, (FluxRect) {20, 0, 10, 10});
+	EXPECT(r.count == 2, "disjoint rects stay separate");
+
+	flux_damage_add(&r, (FluxRect) {5, 0, 20, 5});
+	EXPECT(r.count == 1, "bridging rect merges both neighbours");
+	EXPECT(r.rects [0].x == 0.0f && r.rects [0].w == 30.0f, "merged rect spans both");
+
+	flux_damage_clear(&r);
+	for (int i = 0; i < 3 * FLUX_DAMAGE_MAX_RECTS; i++) flux_damage_add(&r, (FluxRect) {i * 20.0f, 0, 10, 10});
+	EXPECT(r.count <= FLUX_DAMAGE_MAX_RECTS, "rect count stays bounded");
+	for (int i = 0; i < 3 * FLUX_DAMAGE_MAX_RECTS; i++) {
+		FluxRect probe = {i * 20.0f + 1.0f, 1.0f, 2.0f, 2.0f};
+		EXPECT(flux_damage_intersects(&r, &probe), "overflow merge still covers every rect");
+	}
+
+	flux_damage_clear(&r);
+	flux_damage_add(&r, (FluxRect) {0.3f, 0.3f, 1.1f, 1.1f});
+	flux_damage_snap(&r, (FluxRect) {0, 0, 100, 100}, 1.5f);
+	EXPECT(r.count == 1, "snap keeps the rect");
+	EXPECT(fabsf(r.rects [0].x * 1.5f - roundf(r.rects [0].x * 1.5f)) < 1e-4f, "snapped left on pixel grid");
+	EXPECT(fabsf(r.rects [0].w * 1.5f - roundf(r.rects [0].w * 1.5f)) < 1e-4f, "snapped width on pixel grid");
+	EXPECT(r.rects [0].x <= 0.3f && r.rects [0].x + r.rects [0].w >= 1.4f, "snap rounds outward");
+
+	flux_damage_add(&r, (FluxRect) {500, 500, 10, 10});
+	flux_damage_snap(&r, (FluxRect) {0, 0, 100, 100}, 1.0f);
+	EXPECT(r.count == 1, "snap drops rects outside the target");
+	return 0;
+}
+
+static int test_engine(void) {
+	XentConfig           config   = {0};
+	XentContext         *ctx      = xent_create_context(&config);
+	FluxNodeStore       *store    = flux_node_store_create(64);
+	FluxControlRegistry *registry = flux_control_registry_create();
+	EXPECT(ctx && store && registry, "context/store/registry creation");
+	flux_node_store_bind_context(store, ctx);
+
+	XentNodeId root = xent_create_node(ctx);
+	xent_set_protocol(ctx, root, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, root, XENT_FLEX_COLUMN);
+	xent_set_gap(ctx, root, 40.0f);
+
+	XentNodeId cards [3];
+	for (int i = 0; i < 3; i++) {
+		cards [i] = flux_create_card(&(FluxContainerCreateInfo) {ctx, store, root});
+		xent_set_size(ctx, cards [i], (XentSize) {120.0f, 40.0f});
+	}
+
+	xent_layout(ctx, root, 400.0f, 300.0f);
+	flux_node_store_attach_userdata(store, ctx);
+
+	FluxEngine *eng = flux_engine_create(store, registry);
+	EXPECT(eng, "engine creation");
+
+	FluxDamageRegion damage;
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_damage(eng, &damage);
+	EXPECT(damage.full, "first collect is full damage");
+
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_damage(eng, &damage);
+	EXPECT(flux_damage_is_empty(&damage), "unchanged collect has no damage");
+
+	FluxNodeData *nd = flux_node_store_edit(store, cards [1]);
+	EXPECT(nd, "card node data");
+	nd->visuals.background = flux_color_rgb(200, 10, 10);
+
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_damage(eng, &damage);
+	EXPECT(!damage.full && damage.count > 0, "changed card yields partial damage");
+	FluxRect changed = node_rect(ctx, cards [1]);
+	EXPECT(flux_damage_intersects(&damage, &changed), "damage covers the changed card");
+	for (uint32_t i = 0; i < damage.count; i++) {
+		EXPECT(!rect_overlaps(damage.rects [i], node_rect(ctx, cards [0])), "first card untouched");
+		EXPECT(!rect_overlaps(damage.rects [i], node_rect(ctx, cards [2])), "last card untouched");
+	}
+
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_damage(eng, &damage);
+	EXPECT(flux_damage_is_empty(&damage), "damage settles once the change is collected");
+
+	flux_engine_invalidate(eng);
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_damage(eng, &damage);
+	EXPECT(damage.full, "invalidate forces full damage");
+
+	flux_engine_destroy(eng);
+	flux_control_registry_destroy(registry);
+	flux_node_store_destroy(store);
+	xent_destroy_context(ctx);
+	return 0;
+}
+
+static void record_items(FluxDamageTracker *t, uint32_t count, uint64_t first_key) {
+	flux_damage_tracker_begin(t);
+	for (uint32_t i = 0; i < count; i++) {
+		FluxRect r = {( float ) (i % 16) * 20.0f, ( float ) (i / 16) * 20.0f, 10, 10};
+		flux_damage_tracker_record(t, first_key + i, 7, r);
+	}
+}
+
+static int test_tracker_shrink(void) {
+	FluxDamageTracker *t = flux_damage_tracker_create();
+	EXPECT(t, "tracker creation");
+	FluxDamageRegion region;
+
+	record_items(t, 1000, 1);
+	flux_damage_tracker_finish(t, &region);
+	EXPECT(region.full, "first frame is full");
+
+	/* Diffing against the 1000-item frame grows the index; the frames after
+	 * diff against three items and must not probe the larger, stale table,
+	 * whose slots point past the smaller item list. The kept keys sat deep in
+	 * the large frame, so a stale slot would name an index the small one lacks. */
+	record_items(t, 3, 501);
+	flux_damage_tracker_finish(t, &region);
+	EXPECT(!flux_damage_is_empty(&region), "dropped items damage their old rects");
+	record_items(t, 3, 501);
+	flux_damage_tracker_finish(t, &region);
+	EXPECT(flux_damage_is_empty(&region), "unchanged small frame is clean after shrinking");
+	record_items(t, 200, 5000);
+	flux_damage_tracker_finish(t, &region);
+	EXPECT(!flux_damage_is_empty(&region), "unknown keys after shrinking are new items");
+
+	flux_damage_tracker_destroy(t);
+	return 0;
+}
+
+int main(void) {
+	if (test_region()) return 1;
+	if (test_engine()) return 1;
+	if (test_tracker_shrink()) return 1;
+	printf("PASS: damage tracking\n");
+	return 0;
+}
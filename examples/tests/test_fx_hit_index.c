@@ -0,0 +1,145 @@
+/**
+ * @file test_fx_hit_index.c
+ * @brief Headless test for hit testing through the engine's hit index.
+ *
+ * A page with a scrolled list of buttons and plain text is collected, then
+ * probed on a grid of points: answers from the index must match the tree walk
+ * (node, bounds and local point), including inside the scrolled viewport and
+ * on a reused (spliced) frame. Destroying a node must fall back to the walk
+ * until the next collect. No window or GPU.
+ */
+#include <fluxent/fluxent.h>
+#include <stdio.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define ROWS 24
+
+static bool rect_equal(FluxRect a, FluxRect b) { return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h; }
+
+static void noop_click(void *ctx) { ( void ) ctx; }
+
+static void on_node_removed(void *userdata, XentNodeId id) { flux_input_node_destroyed(( FluxInput * ) userdata, id); }
+
+/* Probes a 10 DIP grid over the page with and without the index. */
+static int expect_index_matches_walk(FluxInput *indexed, FluxInput *walked, XentNodeId root, uint32_t *hits) {
+	for (float y = 1.0f; y < 500.0f; y += 10.0f) {
+		for (float x = 1.0f; x < 420.0f; x += 10.0f) {
+			FluxHitResult a = flux_input_hit_test(indexed, root, x, y);
+			FluxHitResult b = flux_input_hit_test(walked, root, x, y);
+			EXPECT(a.node == b.node, "index and walk hit the same node");
+			if (a.node == XENT_NODE_INVALID) continue;
+			EXPECT(a.data == b.data, "same node data");
+			EXPECT(rect_equal(a.bounds, b.bounds), "same scroll-adjusted bounds");
+			EXPECT(a.local.x == b.local.x && a.local.y == b.local.y, "same local point");
+			(*hits)++;
+		}
+	}
+	return 0;
+}
+
+int main(void) {
+	XentConfig           config   = {0};
+	XentContext         *ctx      = xent_create_context(&config);
+	FluxNodeStore       *store    = flux_node_store_create(64);
+	FluxControlRegistry *registry = flux_control_registry_create();
+	EXPECT(ctx && store && registry, "context/store/registry creation");
+	flux_node_store_bind_context(store, ctx);
+	flux_register_builtins(registry);
+
+	XentNodeId root = xent_create_node(ctx);
+	xent_set_protocol(ctx, root, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, root, XENT_FLEX_COLUMN);
+
+	XentNodeId header = flux_create_card(&(FluxContainerCreateInfo) {ctx, store, root});
+	xent_set_size(ctx, header, (XentSize) {400.0f, 60.0f});
+	flux_create_text(&(FluxTextCreateInfo) {ctx, store, header, "Header", 13.0f});
+
+	XentNodeId scroll = flux_create_scroll(&(FluxContainerCreateInfo) {ctx, store, root});
+	xent_set_protocol(ctx, scroll, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, scroll, XENT_FLEX_COLUMN);
+	xent_set_size(ctx, scroll, (XentSize) {300.0f, 200.0f});
+
+	XentNodeId buttons [ROWS];
+	for (int i = 0; i < ROWS; i++) {
+		buttons [i] = flux_create_button(&(FluxButtonCreateInfo) {ctx, store, scroll, "Row", noop_click, NULL});
+		xent_set_size(ctx, buttons [i], (XentSize) {280.0f, 32.0f});
+	}
+
+	XentNodeId footer = flux_create_card(&(FluxContainerCreateInfo) {ctx, store, root});
+	xent_set_size(ctx, footer, (XentSize) {400.0f, 80.0f});
+	XentNodeId caption = flux_create_text(&(FluxTextCreateInfo) {ctx, store, footer, "Caption", 13.0f});
+
+	xent_layout(ctx, root, 420.0f, 500.0f);
+	flux_node_store_attach_userdata(store, ctx);
+
+	FluxEngine *eng     = flux_engine_create(store, registry);
+	FluxInput  *indexed = flux_input_create(ctx, store);
+	FluxInput  *walked  = flux_input_create(ctx, store);
+	EXPECT(eng && indexed && walked, "engine/input creation");
+
+	flux_engine_collect(eng, ctx, root);
+	flux_input_set_hit_index(indexed, flux_engine_hit_index(eng));
+	uint32_t hits = 0;
+	if (expect_index_matches_walk(indexed, walked, root, &hits)) return 1;
+	EXPECT(hits > 0, "probes land on nodes");
+
+	XentRect caption_rect = {0};
+	xent_get_layout_rect(ctx, caption, &caption_rect);
+	FluxHitResult through = flux_input_hit_test(indexed, root, caption_rect.x + 2.0f, caption_rect.y + 2.0f);
+	EXPECT(through.node == footer, "plain text is transparent; the card beneath takes the point");
+
+	/* Scroll the list so the viewport shows later rows. */
+	FluxNodeData   *snd = flux_node_store_edit(store, scroll);
+	FluxScrollData *sd  = snd ? ( FluxScrollData * ) snd->component_data : NULL;
+	EXPECT(sd, "scroll data");
+	sd->scroll_y = 96.0f;
+	flux_engine_collect(eng, ctx, root);
+	flux_input_set_hit_index(indexed, flux_engine_hit_index(eng));
+	hits = 0;
+	if (expect_index_matches_walk(indexed, walked, root, &hits)) return 1;
+
+	/* The row under the viewport's top edge is the one laid out 96 DIPs lower. */
+	XentRect scroll_rect = {0};
+	xent_get_layout_rect(ctx, scroll, &scroll_rect);
+	float         py       = scroll_rect.y + 1.0f;
+	FluxHitResult row      = flux_input_hit_test(indexed, root, scroll_rect.x + 10.0f, py);
+	XentNodeId    expected = XENT_NODE_INVALID;
+	for (int i = 0; i < ROWS; i++) {
+		XentRect r = {0};
+		xent_get_layout_rect(ctx, buttons [i], &r);
+		if (py + sd->scroll_y >= r.y && py + sd->scroll_y < r.y + r.h) expected = buttons [i];
+	}
+	EXPECT(expected != XENT_NODE_INVALID && row.node == expected, "scrolled viewport hits the row scrolled under it");
+	EXPECT(row.bounds.y <= py && row.bounds.y + row.bounds.h > py, "row bounds are in scrolled coordinates");
+
+	/* Unchanged frame: spliced commands must index identically. */
+	flux_engine_collect(eng, ctx, root);
+	flux_input_set_hit_index(indexed, flux_engine_hit_index(eng));
+	hits = 0;
+	if (expect_index_matches_walk(indexed, walked, root, &hits)) return 1;
+
+	/* A destroyed node makes the index stale until the next collect. */
+	flux_node_store_set_remove_listener(store, on_node_removed, indexed);
+	xent_destroy_node(ctx, caption);
+	through = flux_input_hit_test(indexed, root, caption_rect.x + 2.0f, caption_rect.y + 2.0f);
+	EXPECT(through.node == root, "stale index falls back to the walk: the emptied card is transparent now");
+	hits = 0;
+	if (expect_index_matches_walk(indexed, walked, root, &hits)) return 1;
+
+	flux_input_destroy(walked);
+	flux_input_destroy(indexed);
+	flux_engine_destroy(eng);
+	flux_control_registry_destroy(registry);
+	flux_node_store_destroy(store);
+	xent_destroy_context(ctx);
+	printf("PASS: hit index\n");
+	return 0;
+}
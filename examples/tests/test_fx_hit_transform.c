@@ -0,0 +1,148 @@
+/**
+ * @file test_fx_hit_transform.c
+ * @brief Headless test for hit testing under render transforms.
+ *
+ * A dialog card is stepped through a scale-in animation and an expander body
+ * through a clipped slide, the way ContentDialog and Expander animate their
+ * subtrees. At every step the pointer must land on what is drawn, not on the
+ * layout rectangles: the index and the tree walk must agree, points inside the
+ * scaled button hit it with local coordinates in layout units, and points the
+ * transform moved content away from (or clipped) must miss it. No window or
+ * GPU.
+ */
+#include <fluxent/fluxent.h>
+#include <math.h>
+#include <stdio.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define SCALE_STEPS 5
+
+static bool near(float a, float b) { return fabsf(a - b) < 0.01f; }
+
+static void noop_click(void *ctx) { ( void ) ctx; }
+
+/* Collects a frame and probes a 7 DIP grid with and without the index. */
+static int expect_index_matches_walk(
+  FluxEngine *eng, XentContext *ctx, FluxInput *indexed, FluxInput *walked, XentNodeId root
+) {
+	flux_engine_collect(eng, ctx, root);
+	flux_input_set_hit_index(indexed, flux_engine_hit_index(eng));
+	for (float y = 1.0f; y < 400.0f; y += 7.0f) {
+		for (float x = 1.0f; x < 400.0f; x += 7.0f) {
+			FluxHitResult a = flux_input_hit_test(indexed, root, x, y);
+			FluxHitResult b = flux_input_hit_test(walked, root, x, y);
+			EXPECT(a.node == b.node, "index and walk hit the same node");
+			if (a.node == XENT_NODE_INVALID) continue;
+			EXPECT(near(a.bounds.x, b.bounds.x) && near(a.bounds.y, b.bounds.y), "same transformed origin");
+			EXPECT(near(a.bounds.w, b.bounds.w) && near(a.bounds.h, b.bounds.h), "same transformed size");
+			EXPECT(near(a.local.x, b.local.x) && near(a.local.y, b.local.y), "same local point");
+		}
+	}
+	return 0;
+}
+
+int main(void) {
+	XentConfig           config   = {0};
+	XentContext         *ctx      = xent_create_context(&config);
+	FluxNodeStore       *store    = flux_node_store_create(64);
+	FluxControlRegistry *registry = flux_control_registry_create();
+	EXPECT(ctx && store && registry, "context/store/registry creation");
+	flux_node_store_bind_context(store, ctx);
+	flux_register_builtins(registry);
+
+	XentNodeId root = xent_create_node(ctx);
+	xent_set_protocol(ctx, root, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, root, XENT_FLEX_COLUMN);
+
+	XentNodeId dialog = flux_create_card(&(FluxContainerCreateInfo) {ctx, store, root});
+	xent_set_protocol(ctx, dialog, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, dialog, XENT_FLEX_COLUMN);
+	xent_set_size(ctx, dialog, (XentSize) {200.0f, 160.0f});
+	XentNodeId confirm = flux_create_button(&(FluxButtonCreateInfo) {ctx, store, dialog, "OK", noop_click, NULL});
+	xent_set_size(ctx, confirm, (XentSize) {200.0f, 40.0f});
+
+	XentNodeId expander = flux_create_card(&(FluxContainerCreateInfo) {ctx, store, root});
+	xent_set_protocol(ctx, expander, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, expander, XENT_FLEX_COLUMN);
+	xent_set_size(ctx, expander, (XentSize) {300.0f, 100.0f});
+	XentNodeId toggle = flux_create_button(&(FluxButtonCreateInfo) {ctx, store, expander, "More", noop_click, NULL});
+	xent_set_size(ctx, toggle, (XentSize) {300.0f, 30.0f});
+
+	xent_layout(ctx, root, 400.0f, 400.0f);
+	flux_node_store_attach_userdata(store, ctx);
+
+	FluxEngine *eng     = flux_engine_create(store, registry);
+	FluxInput  *indexed = flux_input_create(ctx, store);
+	FluxInput  *walked  = flux_input_create(ctx, store);
+	EXPECT(eng && indexed && walked, "engine/input creation");
+
+	XentRect dialog_rect = {0}, confirm_rect = {0}, expander_rect = {0};
+	xent_get_layout_rect(ctx, dialog, &dialog_rect);
+	xent_get_layout_rect(ctx, confirm, &confirm_rect);
+	xent_get_layout_rect(ctx, expander, &expander_rect);
+
+	/* Scale-in about the card's center, as ContentDialog opens. */
+	FluxNodeData *dd = flux_node_store_edit(store, dialog);
+	EXPECT(dd, "dialog data");
+	float cx = dialog_rect.x + dialog_rect.w * 0.5f;
+	float cy = dialog_rect.y + dialog_rect.h * 0.5f;
+	for (int step = 0; step <= SCALE_STEPS; step++) {
+		float s          = 0.5f + 0.6f * ( float ) step / SCALE_STEPS;
+		dd->render_scale = s;
+		if (expect_index_matches_walk(eng, ctx, indexed, walked, root)) return 1;
+
+		/* The button's center is where the scale put it. */
+		float         bx = cx + (confirm_rect.x + confirm_rect.w * 0.5f - cx) * s;
+		float         by = cy + (confirm_rect.y + confirm_rect.h * 0.5f - cy) * s;
+		FluxHitResult hit = flux_input_hit_test(indexed, root, bx, by);
+		EXPECT(hit.node == confirm, "scaled button takes the point at its drawn center");
+		EXPECT(near(hit.bounds.w, confirm_rect.w * s), "bounds are the drawn size");
+		EXPECT(near(hit.local.x, confirm_rect.w * 0.5f) && near(hit.local.y, confirm_rect.h * 0.5f),
+		  "local point is in layout units");
+	}
+
+	/* Half size: the button's layout corner is no longer covered by the card. */
+	dd->render_scale = 0.5f;
+	if (expect_index_matches_walk(eng, ctx, indexed, walked, root)) return 1;
+	FluxHitResult corner = flux_input_hit_test(indexed, root, confirm_rect.x + 2.0f, confirm_rect.y + 2.0f);
+	EXPECT(corner.node == root, "layout rect outside the drawn card misses it");
+	dd->render_scale = 1.0f;
+
+	/* Slide-up under a subtree clip, as Expander collapses its content: the
+	 * toggle is drawn above the card and clipped away. */
+	FluxNodeData *ed = flux_node_store_edit(store, expander);
+	EXPECT(ed, "expander data");
+	ed->render_translate_y  = -40.0f;
+	ed->render_clip_subtree = true;
+	if (expect_index_matches_walk(eng, ctx, indexed, walked, root)) return 1;
+	FluxHitResult top = flux_input_hit_test(indexed, root, expander_rect.x + 10.0f, expander_rect.y + 5.0f);
+	EXPECT(top.node == expander, "slid card covers its top; the toggle moved out from under the point");
+	FluxHitResult above = flux_input_hit_test(indexed, root, expander_rect.x + 10.0f, expander_rect.y - 20.0f);
+	EXPECT(above.node != toggle && above.node != expander, "content slid outside the clip is not hit");
+	FluxHitResult bottom = flux_input_hit_test(indexed, root, expander_rect.x + 10.0f, expander_rect.y + 90.0f);
+	EXPECT(bottom.node == root, "the strip the slide uncovered passes through");
+
+	/* Without the clip the slid toggle is hit where it is drawn. */
+	ed->render_clip_subtree = false;
+	if (expect_index_matches_walk(eng, ctx, indexed, walked, root)) return 1;
+	FluxHitResult slid = flux_input_hit_test(indexed, root, expander_rect.x + 10.0f, expander_rect.y - 20.0f);
+	EXPECT(slid.node == toggle, "unclipped slide hits the toggle at its drawn position");
+	EXPECT(near(slid.local.y, 20.0f), "local point under a translate");
+
+	flux_input_destroy(walked);
+	flux_input_destroy(indexed);
+	flux_engine_destroy(eng);
+	flux_control_registry_destroy(registry);
+	flux_node_store_destroy(store);
+	xent_destroy_context(ctx);
+	printf("PASS: hit transform\n");
+	return 0;
+}
@@ -2,17 +2,23 @@
  * @file test_fx_list.c
  * @brief Headless ListView probe against the real fluxent backend: spine
  * shape (root/scroll/ABSOLUTE host), content extent, realized window vs
- * viewport, row geometry, scroll-driven staleness → re-realization, and
- * node recycling on a same-size window shift.
+ * viewport, row geometry, scroll-driven staleness → re-realization,
+ * node recycling on a same-size window shift, multi-select over fragmented
+ * ranges (timed), and variable row heights (measured rows, refined estimate,
+ * scroll anchoring) over a 1M-row log.
  */
 #include "flux_internal.h"
+#include "runtime/flux_time.h"
 
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
 #include <windows.h>
 
-#define ROWS 100000
+#define ROWS       100000
+#define LOG_ROWS   1000000
+#define MEASURED   200
+#define SEL_PASSES 10
 
 enum
 {
@@ -34,6 +40,11 @@ static XtkEl *row(XtkUi *ui, void *env, int index) {
 	return xtk_text(ui, xtk_fmt(ui, "row %d", index), (XtkTextDesc) {0});
 }
 
+static bool every_other_row(void *ctx, int index) {
+	( void ) ctx;
+	return index % 2 == 0;
+}
+
 static XtkEl *view(XtkUi *ui, void *model) {
 	Model *m = ( Model * ) model;
 	return xtk_sized(
@@ -69,6 +80,23 @@ static XtkEl *grid_view(XtkUi *ui, void *model) {
 	);
 }
 
+static XtkEl *log_view(XtkUi *ui, void *model) {
+	Model *m = ( Model * ) model;
+	return xtk_sized(
+	  xtk_list_view(
+	    ui, (XtkListDesc) {
+	          .count       = LOG_ROWS,
+	          .item_height = 40.0f,
+	          .item        = row,
+	          .env         = m,
+	          .selected    = m->selected,
+	          .on_select   = xtk_msg(MSG_SELECT),
+	        }
+	  ),
+	  800.0f, 600.0f
+	);
+}
+
 #define EXPECT(cond, msg)              \
 	do {                               \
 		if (!(cond)) {                 \
@@ -102,7 +130,7 @@ int main(void) {
 	flux_node_store_attach_userdata(store, ctx);
 
 	XentNodeId        list = rt->root->node;
-	FluxNodeData     *lnd  = flux_node_store_get(store, list);
+	FluxNodeData     *lnd  = flux_node_store_edit(store, list);
 	EXPECT(lnd && lnd->component_type == FLUX_CONTROL_LIST && lnd->component_data, "list data attached");
 	FluxListViewData *ld = ( FluxListViewData * ) lnd->component_data;
 
@@ -110,7 +138,7 @@ int main(void) {
 	 * virtualized); the host is a small rebased canvas spanning just the
 	 * realized window, so physical coordinates never reach 4e6. */
 	EXPECT(ld->scroll != XENT_NODE_INVALID && ld->host != XENT_NODE_INVALID, "scroll + host exist");
-	FluxNodeData   *snd = flux_node_store_get(store, ld->scroll);
+	FluxNodeData   *snd = flux_node_store_edit(store, ld->scroll);
 	FluxScrollData *sd  = ( FluxScrollData * ) snd->component_data;
 	EXPECT(sd->content_manual && sd->virtualized, "virtual extent is manual + rebased");
 	EXPECT(sd->content_h == ( float ) ROWS * 40.0f, "logical extent = count * item_height");
@@ -138,7 +166,7 @@ int main(void) {
 
 	/* Scroll far outside the window: watch fires exactly once, the next
 	 * frame re-realizes around the new offset. */
-	snd          = flux_node_store_get(store, ld->scroll);
+	snd          = flux_node_store_edit(store, ld->scroll);
 	sd           = ( FluxScrollData * ) snd->component_data;
 	sd->scroll_y = 4000.0f;
 	flux_list_view_update_window(ctx, list, lnd);
@@ -148,13 +176,13 @@ int main(void) {
 	xtk_runtime_frame(rt);
 	xent_layout(ctx, host, 800.0f, 600.0f);
 	flux_node_store_attach_userdata(store, ctx);
-	lnd = flux_node_store_get(store, list);
+	lnd = flux_node_store_edit(store, list);
 	ld  = ( FluxListViewData * ) lnd->component_data;
 	/* offset 4000, extent 600: first floor(100)-4 = 96, last ceil(4600/40)-1+4 = 118. */
 	EXPECT(ld->realized_first == 96 && ld->realized_last == 118, "window re-realizes to 96..118");
 
 	/* Rebase followed the window: origin = slot 96, rows sit near the host top. */
-	snd = flux_node_store_get(store, ld->scroll);
+	snd = flux_node_store_edit(store, ld->scroll);
 	sd  = ( FluxScrollData * ) snd->component_data;
 	EXPECT(sd->origin_y == 96.0f * 40.0f, "origin rebased to the first realized row");
 	xent_get_layout_rect(ctx, ld->host, &host_rect);
@@ -190,46 +218,46 @@ int main(void) {
 	xtk_runtime_post(rt, xtk_msg_i(MSG_SELECT, 110));
 	xtk_runtime_frame(rt);
 	EXPECT(m.selected == 110, "selection message consumed");
-	FluxNodeData *row110 = NULL;
+	FluxNodeData const *row110 = NULL;
 	for (int i = 0; i < rt->root->child_count; i++) {
-		FluxNodeData *ind = flux_node_store_get(store, rt->root->children [i]->node);
-		FluxListItemData *it = ind ? ( FluxListItemData * ) ind->component_data : NULL;
+		FluxNodeData const     *ind = flux_node_store_get(store, rt->root->children [i]->node);
+		FluxListItemData const *it  = ind ? ( FluxListItemData const * ) ind->component_data : NULL;
 		if (it && it->index == 110 && it->selected) row110 = ind;
 	}
 	EXPECT(row110, "row 110 carries the selected visual");
 
 	/* Keyboard: Down from row 110 selects 111 (Single, selection follows
 	 * focus); Home jumps to row 0 (scroll-into-view realizes the top). */
-	EXPECT(row110->behavior.on_key, "rows carry the key handler");
-	row110->behavior.on_key(row110->behavior.on_key_ctx, VK_DOWN, true);
+	EXPECT(row110->behavior->on_key, "rows carry the key handler");
+	row110->behavior->on_key(row110->behavior->on_key_ctx, VK_DOWN, true);
 	xtk_runtime_frame(rt);
 	EXPECT(m.selected == 111, "Down selects the next row (follows focus)");
 
-	FluxNodeData *row111 = NULL;
+	FluxNodeData const *row111 = NULL;
 	for (int i = 0; i < rt->root->child_count; i++) {
-		FluxNodeData     *ind = flux_node_store_get(store, rt->root->children [i]->node);
-		FluxListItemData *it  = ind ? ( FluxListItemData * ) ind->component_data : NULL;
+		FluxNodeData const     *ind = flux_node_store_get(store, rt->root->children [i]->node);
+		FluxListItemData const *it  = ind ? ( FluxListItemData const * ) ind->component_data : NULL;
 		if (it && it->index == 111) row111 = ind;
 	}
 	EXPECT(row111, "row 111 realized");
-	row111->behavior.on_key(row111->behavior.on_key_ctx, VK_HOME, true);
+	row111->behavior->on_key(row111->behavior->on_key_ctx, VK_HOME, true);
 	xtk_runtime_frame(rt);
 	xent_layout(ctx, host, 800.0f, 600.0f);
 	flux_node_store_attach_userdata(store, ctx);
-	lnd = flux_node_store_get(store, list);
+	lnd = flux_node_store_edit(store, list);
 	ld  = ( FluxListViewData * ) lnd->component_data;
 	EXPECT(m.selected == 0, "Home selects row 0");
 	EXPECT(ld->realized_first == 0, "Home scrolled the window back to the top");
 
 	/* Click gesture routes through the same state machine. */
-	FluxNodeData *row0 = NULL;
+	FluxNodeData const *row0 = NULL;
 	for (int i = 0; i < rt->root->child_count; i++) {
-		FluxNodeData     *ind = flux_node_store_get(store, rt->root->children [i]->node);
-		FluxListItemData *it  = ind ? ( FluxListItemData * ) ind->component_data : NULL;
+		FluxNodeData const     *ind = flux_node_store_get(store, rt->root->children [i]->node);
+		FluxListItemData const *it  = ind ? ( FluxListItemData const * ) ind->component_data : NULL;
 		if (it && it->index == 5) row0 = ind;
 	}
-	EXPECT(row0 && row0->behavior.on_click, "row 5 realized with click handler");
-	row0->behavior.on_click(row0->behavior.on_click_ctx);
+	EXPECT(row0 && row0->behavior->on_click, "row 5 realized with click handler");
+	row0->behavior->on_click(row0->behavior->on_click_ctx);
 	xtk_runtime_frame(rt);
 	EXPECT(m.selected == 5, "click selects row 5");
 
@@ -237,7 +265,7 @@ int main(void) {
 	 * physical coordinate viewport-sized while row pitch stays exact (integer
 	 * multiples of 40 are exact in float32 below 2^24). This is the guarantee
 	 * that kills the compositor float-precision drift. */
-	snd          = flux_node_store_get(store, ld->scroll);
+	snd          = flux_node_store_edit(store, ld->scroll);
 	sd           = ( FluxScrollData * ) snd->component_data;
 	sd->scroll_y = 99000.0f * 40.0f;
 	flux_list_view_update_window(ctx, list, lnd);
@@ -245,9 +273,9 @@ int main(void) {
 	xtk_runtime_frame(rt);
 	xent_layout(ctx, host, 800.0f, 600.0f);
 	flux_node_store_attach_userdata(store, ctx);
-	lnd = flux_node_store_get(store, list);
+	lnd = flux_node_store_edit(store, list);
 	ld  = ( FluxListViewData * ) lnd->component_data;
-	snd = flux_node_store_get(store, ld->scroll);
+	snd = flux_node_store_edit(store, ld->scroll);
 	sd  = ( FluxScrollData * ) snd->component_data;
 	EXPECT(ld->realized_first == 98996 && ld->realized_last == 99018, "deep window 98996..99018");
 	EXPECT(sd->origin_y == 98996.0f * 40.0f, "origin rebased to the deep window");
@@ -256,8 +284,8 @@ int main(void) {
 	for (int i = 0; i < rt->root->child_count; i++) {
 		XentRect r = {0};
 		xent_get_layout_rect(ctx, rt->root->children [i]->node, &r);
-		FluxNodeData     *ind = flux_node_store_get(store, rt->root->children [i]->node);
-		FluxListItemData *it  = ( FluxListItemData * ) ind->component_data;
+		FluxNodeData const     *ind = flux_node_store_get(store, rt->root->children [i]->node);
+		FluxListItemData const *it  = ( FluxListItemData const * ) ind->component_data;
 		EXPECT(r.y - host_rect.y >= 0.0f && r.y - host_rect.y <= 22.0f * 40.0f, "physical slot stays viewport-sized");
 		EXPECT(
 		  r.y - flux_scroll_off_y(sd) == host_rect.y + ( float ) it->index * 40.0f - sd->scroll_y,
@@ -265,6 +293,45 @@ int main(void) {
 		);
 	}
 
+	/* Fragmented multi-select: every other row of the 100k is its own run.
+	 * Membership (asked per realized cell each frame) and the count must not
+	 * scan the runs. */
+	flux_list_view_set_sel_mode(store, list, XTK_LIST_SELECT_MULTIPLE);
+	flux_list_view_select_where(store, list, every_other_row, NULL);
+	EXPECT(flux_list_view_selection_count(store, list) == ROWS / 2, "predicate selects every other row");
+	EXPECT(ld->range_count == ROWS / 2, "one run per selected row");
+
+	int64_t start = flux_perf_now();
+	int     hits  = 0;
+	for (int pass = 0; pass < SEL_PASSES; pass++)
+		for (int i = 0; i < ROWS; i++) hits += flux_list_view_is_selected(store, list, i);
+	double query = flux_perf_seconds(flux_perf_now() - start) / (( double ) SEL_PASSES * ROWS);
+	EXPECT(hits == SEL_PASSES * (ROWS / 2), "membership matches the predicate");
+
+	start = flux_perf_now();
+	flux_list_view_invert_selection(store, list);
+	double invert = flux_perf_seconds(flux_perf_now() - start);
+	EXPECT(flux_list_view_selection_count(store, list) == ROWS / 2, "inverted count");
+	EXPECT(!flux_list_view_is_selected(store, list, 0) && flux_list_view_is_selected(store, list, 1), "inverted runs");
+
+	flux_list_view_select_range(store, list, 1000, 1999, true);
+	EXPECT(flux_list_view_selection_count(store, list) == ROWS / 2 + 500, "range select merges the runs it covers");
+	flux_list_view_select_range(store, list, 1500, 1509, false);
+	EXPECT(flux_list_view_selection_count(store, list) == ROWS / 2 + 490, "range deselect splits a run");
+	EXPECT(!flux_list_view_is_selected(store, list, 1505) && flux_list_view_is_selected(store, list, 1510),
+	  "deselected span");
+	flux_list_view_select_range(store, list, 0, ROWS - 1, false);
+	EXPECT(flux_list_view_selection_count(store, list) == 0 && ld->range_count == 0, "deselect all");
+	EXPECT(flux_list_view_select_range(store, list, ROWS - 100, ROWS - 1, true), "select the tail");
+	flux_list_view_set_extent(store, list, ROWS - 50, ld->item_height, ld->item_width, ld->columns);
+	EXPECT(flux_list_view_selection_count(store, list) == 50, "shrinking the list trims the selection");
+	EXPECT(!flux_list_view_is_selected(store, list, ROWS - 50), "no selection past the new end");
+	flux_list_view_set_extent(store, list, ROWS, ld->item_height, ld->item_width, ld->columns);
+	EXPECT(flux_list_view_selection_count(store, list) == 50, "growing it back selects nothing new");
+	flux_list_view_select_range(store, list, 0, ROWS - 1, false);
+	printf("selection over %d runs: %.1f ns/is_selected, invert %.3f ms\n", ROWS / 2, query * 1e9, invert * 1000.0);
+	flux_list_view_set_sel_mode(store, list, XTK_LIST_SELECT_SINGLE);
+
 	xtk_runtime_destroy(rt);
 
 	/* ----------------------------------------------------------------
@@ -285,8 +352,8 @@ int main(void) {
 	xent_layout(ctx, ghost, 800.0f, 600.0f);
 	flux_node_store_attach_userdata(store, ctx);
 
-	FluxNodeData     *gnd = flux_node_store_get(store, grt->root->node);
-	FluxListViewData *gld = ( FluxListViewData * ) gnd->component_data;
+	FluxNodeData const     *gnd = flux_node_store_get(store, grt->root->node);
+	FluxListViewData const *gld = ( FluxListViewData const * ) gnd->component_data;
 	EXPECT(gld->kind == XTK_LIST_KIND_GRID, "grid kind");
 	EXPECT(gld->cols == 4, "800px viewport / 200px cells = 4 columns");
 	/* Viewport 600/100 = rows 0..5 visible, +4 overscan → rows 0..9 → cells 0..39. */
@@ -294,36 +361,98 @@ int main(void) {
 
 	XentRect c5 = {0};
 	for (int i = 0; i < grt->root->child_count; i++) {
-		FluxNodeData     *ind = flux_node_store_get(store, grt->root->children [i]->node);
-		FluxListItemData *it  = ind ? ( FluxListItemData * ) ind->component_data : NULL;
+		FluxNodeData const     *ind = flux_node_store_get(store, grt->root->children [i]->node);
+		FluxListItemData const *it  = ind ? ( FluxListItemData const * ) ind->component_data : NULL;
 		if (it && it->index == 5) xent_get_layout_rect(ctx, grt->root->children [i]->node, &c5);
 	}
 	EXPECT(c5.w == 200.0f && c5.h == 100.0f, "cell 5 has the grid cell size");
 	EXPECT(c5.x == 200.0f && c5.y == 100.0f, "cell 5 sits at column 1, row 1");
 
 	/* 2D nav: Down from cell 5 = cell 9 (one row down). */
-	FluxNodeData *cell5 = NULL;
+	FluxNodeData const *cell5 = NULL;
 	for (int i = 0; i < grt->root->child_count; i++) {
-		FluxNodeData     *ind = flux_node_store_get(store, grt->root->children [i]->node);
-		FluxListItemData *it  = ind ? ( FluxListItemData * ) ind->component_data : NULL;
+		FluxNodeData const     *ind = flux_node_store_get(store, grt->root->children [i]->node);
+		FluxListItemData const *it  = ind ? ( FluxListItemData const * ) ind->component_data : NULL;
 		if (it && it->index == 5) cell5 = ind;
 	}
 	EXPECT(cell5, "cell 5 realized");
-	cell5->behavior.on_key(cell5->behavior.on_key_ctx, VK_DOWN, true);
+	cell5->behavior->on_key(cell5->behavior->on_key_ctx, VK_DOWN, true);
 	xtk_runtime_frame(grt);
 	EXPECT(m.selected == 9, "grid Down moves one row (+cols)");
 	cell5 = NULL;
 	for (int i = 0; i < grt->root->child_count; i++) {
-		FluxNodeData     *ind = flux_node_store_get(store, grt->root->children [i]->node);
-		FluxListItemData *it  = ind ? ( FluxListItemData * ) ind->component_data : NULL;
+		FluxNodeData const     *ind = flux_node_store_get(store, grt->root->children [i]->node);
+		FluxListItemData const *it  = ind ? ( FluxListItemData const * ) ind->component_data : NULL;
 		if (it && it->index == 9) cell5 = ind;
 	}
 	EXPECT(cell5, "cell 9 realized");
-	cell5->behavior.on_key(cell5->behavior.on_key_ctx, VK_RIGHT, true);
+	cell5->behavior->on_key(cell5->behavior->on_key_ctx, VK_RIGHT, true);
 	xtk_runtime_frame(grt);
 	EXPECT(m.selected == 10, "grid Right moves one column (+1)");
 
 	xtk_runtime_destroy(grt);
+
+	/* ----------------------------------------------------------------
+	 * Variable heights: a 1M-row log reports measured rows; offsets come
+	 * from the prefix-sum index and unmeasured rows take the average.
+	 * -------------------------------------------------------------- */
+	XentNodeId lhost = xent_create_node(ctx);
+	xent_set_protocol(ctx, lhost, XENT_PROTOCOL_FLEX);
+	m.selected      = -1;
+	XtkRuntime *lrt = xtk_runtime_create(ctx, &be, lhost, &m, update, log_view);
+	EXPECT(lrt, "log runtime");
+	bctx.runtime = lrt;
+	xtk_runtime_frame(lrt);
+	xent_layout(ctx, lhost, 800.0f, 600.0f);
+	flux_node_store_attach_userdata(store, ctx);
+
+	XentNodeId chat = lrt->root->node;
+	lnd             = flux_node_store_edit(store, chat);
+	ld              = ( FluxListViewData * ) lnd->component_data;
+
+	/* Alternating 24/56 rows average 40: the estimate and extent hold. */
+	for (int i = 0; i < MEASURED; i++) flux_list_view_set_row_height(store, chat, i, i % 2 ? 56.0f : 24.0f);
+	snd = flux_node_store_edit(store, ld->scroll);
+	sd  = ( FluxScrollData * ) snd->component_data;
+	EXPECT(sd->content_h == ( float ) LOG_ROWS * 40.0f, "measured average keeps the extent");
+	EXPECT(flux_list_view_row_offset(store, chat, 1) == 24.0f, "row 1 starts below a 24 DIP row");
+	EXPECT(flux_list_view_row_offset(store, chat, 2) == 80.0f, "row 2 starts after 24 + 56");
+	EXPECT(flux_list_view_row_offset(store, chat, 300) == 8000.0f + 100.0f * 40.0f, "unmeasured rows use the estimate");
+
+	/* Scroll 10 DIPs into row 500, then grow a row far above it: the estimate
+	 * moves every unmeasured row, yet row 500 stays put on screen. */
+	sd->scroll_y = flux_list_view_row_offset(store, chat, 500) + 10.0f;
+	flux_list_view_set_row_height(store, chat, 10, 124.0f);
+	float anchor = flux_list_view_row_offset(store, chat, 500);
+	EXPECT(anchor != 20000.0f, "row 500 moved in content space");
+	EXPECT(fabsf(sd->scroll_y - (anchor + 10.0f)) < 0.01f, "scroll anchored to row 500");
+
+	flux_list_view_update_window(ctx, chat, lnd);
+	EXPECT(lrt->force, "anchored viewport re-realizes");
+	xtk_runtime_frame(lrt);
+	xent_layout(ctx, lhost, 800.0f, 600.0f);
+	flux_node_store_attach_userdata(store, ctx);
+	lnd = flux_node_store_edit(store, chat);
+	ld  = ( FluxListViewData * ) lnd->component_data;
+	EXPECT(ld->realized_first == 496 && ld->realized_last >= 514, "window realized around row 500");
+	flux_list_view_update_window(ctx, chat, lnd);
+	EXPECT(!lrt->force, "realized window covers the varied viewport");
+
+	XentRect lhost_rect = {0};
+	xent_get_layout_rect(ctx, ld->host, &lhost_rect);
+	for (int i = 0; i < lrt->root->child_count; i++) {
+		XentRect r = {0};
+		xent_get_layout_rect(ctx, lrt->root->children [i]->node, &r);
+		FluxNodeData const     *ind = flux_node_store_get(store, lrt->root->children [i]->node);
+		FluxListItemData const *it  = ( FluxListItemData const * ) ind->component_data;
+		float                   top = flux_list_view_row_offset(store, chat, it->index);
+		float                   h   = flux_list_view_row_offset(store, chat, it->index + 1) - top;
+		EXPECT(fabsf(r.h - h) < 0.01f, "realized row has its estimated height");
+		EXPECT(fabsf(r.y - flux_scroll_off_y(sd) - (lhost_rect.y + top - sd->scroll_y)) < 0.01f,
+		  "varied row sits at its prefix-sum offset on screen");
+	}
+
+	xtk_runtime_destroy(lrt);
 	flux_node_store_destroy(store);
 	xent_destroy_context(ctx);
 	printf("PASS: fluxent virtualized list\n");
@@ -93,9 +93,9 @@ static XtkEl *view_radio_buttons(XtkUi *ui, void *model) {
 
 static int check_radio_buttons(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
 	( void ) ctx;
-	FluxNodeData *nd = flux_node_store_get(store, rt->root->node);
+	FluxNodeData const *nd = flux_node_store_get(store, rt->root->node);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_RADIO_BUTTONS, "radio buttons data");
-	FluxRadioButtonsData *g = ( FluxRadioButtonsData * ) nd->component_data;
+	FluxRadioButtonsData const *g = ( FluxRadioButtonsData const * ) nd->component_data;
 	EXPECT(g && g->count == 3, "three radio items");
 	XentRect r = node_rect(ctx, rt->root);
 	EXPECT(r.h >= 96.0f, "radio group has vertical extent");
@@ -127,7 +127,7 @@ static XtkEl *view_toggle_split(XtkUi *ui, void *model) {
 
 static int check_toggle_split(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
 	( void ) store;
-	FluxNodeData *nd = flux_node_store_get(store, rt->root->node);
+	FluxNodeData const *nd = flux_node_store_get(store, rt->root->node);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_TOGGLE_SPLIT_BUTTON, "toggle split type");
 	XentRect r = node_rect(ctx, rt->root);
 	EXPECT(r.w >= 48.0f, "toggle split has width");
@@ -145,7 +145,7 @@ static XtkEl *view_breadcrumb(XtkUi *ui, void *model) {
 
 static int check_breadcrumb(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
 	( void ) store;
-	FluxNodeData *nd = flux_node_store_get(store, rt->root->node);
+	FluxNodeData const *nd = flux_node_store_get(store, rt->root->node);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_BREADCRUMB_BAR, "breadcrumb type");
 	XentRect r = node_rect(ctx, rt->root);
 	EXPECT(r.w >= 180.0f && r.h >= 28.0f, "breadcrumb has size");
@@ -169,7 +169,7 @@ static XtkEl *view_selector(XtkUi *ui, void *model) {
 
 static int check_selector(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
 	( void ) store;
-	FluxNodeData *nd = flux_node_store_get(store, rt->root->node);
+	FluxNodeData const *nd = flux_node_store_get(store, rt->root->node);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_SELECTOR_BAR, "selector bar type");
 	XentRect r = node_rect(ctx, rt->root);
 	EXPECT(r.h >= 32.0f && r.w >= 120.0f, "selector bar has size");
@@ -200,9 +200,9 @@ static XtkEl *view_tree(XtkUi *ui, void *model) {
 
 static int check_tree(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
 	( void ) ctx;
-	FluxNodeData *nd = flux_node_store_get(store, rt->root->node);
+	FluxNodeData const *nd = flux_node_store_get(store, rt->root->node);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_TREE_VIEW, "tree view type");
-	FluxTreeViewData *td = ( FluxTreeViewData * ) nd->component_data;
+	FluxTreeViewData const *td = ( FluxTreeViewData const * ) nd->component_data;
 	EXPECT(td && td->flat_count == 3, "expanded tree flattens to three rows");
 	EXPECT(td->list != XENT_NODE_INVALID, "tree owns list spine");
 	return 0;
@@ -233,9 +233,9 @@ static XtkEl *view_items(XtkUi *ui, void *model) {
 
 static int check_items(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
 	( void ) ctx;
-	FluxNodeData *nd = flux_node_store_get(store, rt->root->node);
+	FluxNodeData const *nd = flux_node_store_get(store, rt->root->node);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_ITEMS_VIEW, "items view type");
-	FluxListViewData *ld = ( FluxListViewData * ) nd->component_data;
+	FluxListViewData const *ld = ( FluxListViewData const * ) nd->component_data;
 	EXPECT(ld && ld->scroll != XENT_NODE_INVALID && ld->host != XENT_NODE_INVALID, "items spine");
 	return 0;
 }
@@ -264,11 +264,11 @@ static XtkEl *view_refresh(XtkUi *ui, void *model) {
 
 static int check_refresh(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
 	( void ) rt;
-	FluxNodeData *nd = flux_node_store_get(store, rt->root->node);
+	FluxNodeData const *nd = flux_node_store_get(store, rt->root->node);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_REFRESH, "refresh container type");
-	FluxRefreshData *rd = ( FluxRefreshData * ) nd->component_data;
+	FluxRefreshData const *rd = ( FluxRefreshData const * ) nd->component_data;
 	EXPECT(rd && rd->scroll_child != XENT_NODE_INVALID, "refresh wraps scroll child");
-	FluxNodeData *scroll = flux_node_store_get(store, rd->scroll_child);
+	FluxNodeData const *scroll = flux_node_store_get(store, rd->scroll_child);
 	EXPECT(scroll && scroll->component_type == FLUX_CONTROL_SCROLL, "scroll child type");
 	( void ) ctx;
 	return 0;
@@ -284,9 +284,9 @@ static XtkEl *view_person(XtkUi *ui, void *model) {
 }
 
 static int check_person(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
-	FluxNodeData *nd = flux_node_store_get(store, rt->root->node);
+	FluxNodeData const *nd = flux_node_store_get(store, rt->root->node);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_PERSON_PICTURE, "person picture type");
-	FluxPersonPictureData *pd = ( FluxPersonPictureData * ) nd->component_data;
+	FluxPersonPictureData const *pd = ( FluxPersonPictureData const * ) nd->component_data;
 	EXPECT(pd && strcmp(pd->resolved, "JS") == 0, "initials derive from first+last word");
 	EXPECT(pd->badge_number == 128, "badge number carried");
 	EXPECT(pd->diameter == 80.0f, "requested diameter carried");
@@ -303,9 +303,9 @@ static XtkEl *view_pager(XtkUi *ui, void *model) {
 
 static int check_pager(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
 	( void ) ctx;
-	FluxNodeData *nd = flux_node_store_get(store, rt->root->node);
+	FluxNodeData const *nd = flux_node_store_get(store, rt->root->node);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_PAGER, "pager type");
-	FluxPagerData *pd = ( FluxPagerData * ) nd->component_data;
+	FluxPagerData const *pd = ( FluxPagerData const * ) nd->component_data;
 	EXPECT(pd && pd->count == 32 && pd->selected == 6, "pager config carried");
 
 	/* Center-ellipsis window for sel0=6: 1 … 6 7 8 … 32 (selected page 7 centered). */
@@ -333,23 +333,23 @@ static XtkEl *view_split(XtkUi *ui, void *model) {
 
 static int check_split(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
 	XentNodeId    root = rt->root->node;
-	FluxNodeData *nd   = flux_node_store_get(store, root);
+	FluxNodeData *nd   = flux_node_store_edit(store, root);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_SPLIT_VIEW, "split view type");
-	FluxSplitViewData *d = ( FluxSplitViewData * ) nd->component_data;
+	FluxSplitViewData const *d = ( FluxSplitViewData const * ) nd->component_data;
 	EXPECT(d && d->pane_open && d->display_mode == FLUX_SPLITVIEW_INLINE, "split config carried");
 	EXPECT(d->open_len == FLUX_SPLITVIEW_OPEN_LEN, "default open pane length");
 
-	XentNodeId content = xent_get_first_child(ctx, root);
-	XentNodeId pane    = content != XENT_NODE_INVALID ? xent_get_next_sibling(ctx, content) : XENT_NODE_INVALID;
-	FluxNodeData *cnd  = flux_node_store_get(store, content);
-	FluxNodeData *pnd  = flux_node_store_get(store, pane);
+	XentNodeId          content = xent_get_first_child(ctx, root);
+	XentNodeId          pane    = content != XENT_NODE_INVALID ? xent_get_next_sibling(ctx, content) : XENT_NODE_INVALID;
+	FluxNodeData const *cnd     = flux_node_store_get(store, content);
+	FluxNodeData const *pnd     = flux_node_store_get(store, pane);
 	EXPECT(cnd && cnd->component_type == FLUX_CONTROL_SPLIT_VIEW_CONTENT, "content wrapper first");
 	EXPECT(pnd && pnd->component_type == FLUX_CONTROL_SPLIT_VIEW_PANE, "pane wrapper second");
 
 	/* Drive the layout sync the engine would run each frame, then confirm the
 	 * pane wrapper picked up the (inline) surface state. */
 	flux_split_view_sync(ctx, root, nd);
-	FluxSplitPaneData *pd = ( FluxSplitPaneData * ) pnd->component_data;
+	FluxSplitPaneData const *pd = ( FluxSplitPaneData const * ) pnd->component_data;
 	EXPECT(pd && !pd->overlay && pd->divider, "inline pane: divider, no overlay surface");
 	return 0;
 }
@@ -378,8 +378,8 @@ static int test_refresh_touch(void) {
 	   .userdata   = &fired});
 	EXPECT(root != XENT_NODE_INVALID, "refresh container created");
 
-	FluxNodeData    *nd = flux_node_store_get(store, root);
-	FluxRefreshData *d  = ( FluxRefreshData * ) nd->component_data;
+	FluxNodeData const    *nd = flux_node_store_get(store, root);
+	FluxRefreshData const *d  = ( FluxRefreshData const * ) nd->component_data;
 
 	/* Default visualizer 100dip, execution ratio 0.8 -> threshold 80dip. A 20dip
 	 * over-pull arms and interacts; 90dip crosses the threshold to Pending. */
@@ -418,9 +418,9 @@ static XtkEl *view_title_bar(XtkUi *ui, void *model) {
 
 static int check_title_bar(XentContext *ctx, FluxNodeStore *store, XtkRuntime *rt) {
 	( void ) ctx;
-	FluxNodeData *nd = flux_node_store_get(store, rt->root->node);
+	FluxNodeData const *nd = flux_node_store_get(store, rt->root->node);
 	EXPECT(nd && nd->component_type == FLUX_CONTROL_TITLE_BAR, "title bar type");
-	FluxTitleBarData *d = ( FluxTitleBarData * ) nd->component_data;
+	FluxTitleBarData const *d = ( FluxTitleBarData const * ) nd->component_data;
 	EXPECT(d && d->title && strcmp(d->title, "Fluxent") == 0, "title carried");
 	EXPECT(d->show_back && d->show_pane_toggle, "back + pane-toggle enabled");
 	EXPECT(d->icon_glyph [0] != '\0', "icon resolved to a glyph");
@@ -0,0 +1,125 @@
+/**
+ * @file test_fx_node_bench.c
+ * @brief Traversal microbenchmark over a 50k-node synthetic tree.
+ *
+ * Times a full collect (retention invalidated every frame) and a sweep of hit
+ * tests, by tree walk and through the engine's hit index, and reports the
+ * per-node bytes those walks pull in: the current hot FluxNodeData against the
+ * former inline layout that carried every behavior callback. Also checks that
+ * each node's behavior lives in the store's cold column and still dispatches.
+ * No window or GPU.
+ */
+#include <fluxent/fluxent.h>
+#include "runtime/flux_time.h"
+
+#include <stdio.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define CARDS          2500
+#define CARD_CHILDREN  19
+#define COLLECT_FRAMES 8
+#define HIT_QUERIES    20000
+
+static int click_count;
+
+static void on_click(void *ctx) {
+	( void ) ctx;
+	click_count++;
+}
+
+/* Seconds per query over a fixed sweep of points. */
+static double time_hit_tests(FluxInput *input, XentNodeId root, uint32_t *hits) {
+	int64_t start = flux_perf_now();
+	for (int i = 0; i < HIT_QUERIES; i++) {
+		float         y   = ( float ) (i % 800) + 0.5f;
+		FluxHitResult hit = flux_input_hit_test(input, root, 10.0f + ( float ) (i % 7) * 50.0f, y);
+		if (hit.node != XENT_NODE_INVALID) (*hits)++;
+	}
+	return flux_perf_seconds(flux_perf_now() - start) / HIT_QUERIES;
+}
+
+int main(void) {
+	XentConfig           config   = {0};
+	XentContext         *ctx      = xent_create_context(&config);
+	FluxNodeStore       *store    = flux_node_store_create(1024);
+	FluxControlRegistry *registry = flux_control_registry_create();
+	EXPECT(ctx && store && registry, "context/store/registry creation");
+	flux_node_store_bind_context(store, ctx);
+	flux_register_builtins(registry);
+
+	XentNodeId root = xent_create_node(ctx);
+	xent_set_protocol(ctx, root, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, root, XENT_FLEX_COLUMN);
+
+	XentNodeId first_button = XENT_NODE_INVALID;
+	for (int i = 0; i < CARDS; i++) {
+		XentNodeId card = flux_create_card(&(FluxContainerCreateInfo) {ctx, store, root});
+		xent_set_protocol(ctx, card, XENT_PROTOCOL_FLEX);
+		xent_set_size(ctx, card, (XentSize) {400.0f, 24.0f});
+		for (int j = 0; j < CARD_CHILDREN; j++) {
+			if (j == 0) {
+				XentNodeId b = flux_create_button(&(FluxButtonCreateInfo) {ctx, store, card, "Go", on_click, NULL});
+				if (first_button == XENT_NODE_INVALID) first_button = b;
+				continue;
+			}
+			flux_create_text(&(FluxTextCreateInfo) {ctx, store, card, "Cell", 11.0f});
+		}
+	}
+	uint32_t nodes = flux_node_store_count(store);
+	EXPECT(nodes == CARDS * (1 + CARD_CHILDREN), "synthetic tree size");
+
+	xent_layout(ctx, root, 1200.0f, 800.0f);
+	flux_node_store_attach_userdata(store, ctx);
+
+	/* Behavior sits in the cold column, outside the hot record. */
+	FluxNodeData const *bd = flux_node_store_get(store, first_button);
+	EXPECT(bd && bd->behavior, "node data has a behavior entry");
+	EXPECT(( void * ) bd->behavior < ( void * ) bd || ( void * ) bd->behavior >= ( void * ) (bd + 1),
+	  "behavior is not stored inline");
+	EXPECT(bd->behavior->on_click == on_click, "button callback reachable through the column");
+	bd->behavior->on_click(bd->behavior->on_click_ctx);
+	EXPECT(click_count == 1, "callback dispatches");
+
+	FluxEngine *eng = flux_engine_create(store, registry);
+	EXPECT(eng, "engine creation");
+
+	int64_t start = flux_perf_now();
+	for (int f = 0; f < COLLECT_FRAMES; f++) {
+		flux_engine_invalidate(eng);
+		flux_engine_collect(eng, ctx, root);
+	}
+	double collect = flux_perf_seconds(flux_perf_now() - start) / COLLECT_FRAMES;
+	EXPECT(flux_engine_command_count(eng) >= nodes, "collect walked every node");
+
+	FluxInput *input = flux_input_create(ctx, store);
+	EXPECT(input, "input creation");
+	uint32_t hits     = 0;
+	double   hit_walk = time_hit_tests(input, root, &hits);
+	flux_input_set_hit_index(input, flux_engine_hit_index(eng));
+	double hit_index = time_hit_tests(input, root, &hits);
+	EXPECT(hits > 0, "hit tests land on nodes");
+
+	size_t hot = sizeof(FluxNodeData);
+	size_t was = sizeof(FluxNodeData) - sizeof(FluxNodeBehavior *) + sizeof(FluxNodeBehavior);
+	printf("node layout: %zu bytes walked per node (was %zu with inline behavior), %zu bytes cold\n", hot, was,
+	  sizeof(FluxNodeBehavior));
+	printf("traversal over %u nodes: collect %.3f ms/frame, hit test %.3f us/query (walk) / %.3f us/query (index)\n",
+	  nodes, collect * 1000.0, hit_walk * 1e6, hit_index * 1e6);
+	EXPECT(hot * 3 < was * 2, "hot record is at least a third smaller than the inline layout");
+
+	flux_input_destroy(input);
+	flux_engine_destroy(eng);
+	flux_control_registry_destroy(registry);
+	flux_node_store_destroy(store);
+	xent_destroy_context(ctx);
+	printf("PASS: node traversal bench\n");
+	return 0;
+}
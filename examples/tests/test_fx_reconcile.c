@@ -62,9 +62,9 @@ static XtkEl *view(XtkUi *ui, void *model) {
 	}                                  \
 	while (0)
 
-static FluxNodeData *node_data(FluxNodeStore *store, XtkNode *n) { return flux_node_store_get(store, n->node); }
+static FluxNodeData const *node_data(FluxNodeStore *store, XtkNode *n) { return flux_node_store_get(store, n->node); }
 
-int                  main(void) {
+int                        main(void) {
 	XentConfig     config = {0};
 	XentContext   *ctx    = xent_create_context(&config);
 	FluxNodeStore *store  = flux_node_store_create(64);
@@ -85,31 +85,31 @@ int                  main(void) {
 	EXPECT(rt->root->child_count == 5, "mounted children (slider hidden)");
 	EXPECT(xent_get_child_count(ctx, host) == 1, "root attached to host");
 
-	XtkNode        *btn        = rt->root->children [1];
-	XentNodeId      btn_id     = btn->node;
-	XentNodeId      alpha_id   = rt->root->children [3]->node;
-	XentNodeId      beta_id    = rt->root->children [4]->node;
-	uint32_t        base_count = flux_node_store_count(store);
+	XtkNode              *btn        = rt->root->children [1];
+	XentNodeId            btn_id     = btn->node;
+	XentNodeId            alpha_id   = rt->root->children [3]->node;
+	XentNodeId            beta_id    = rt->root->children [4]->node;
+	uint32_t              base_count = flux_node_store_count(store);
 
-	FluxButtonData *bd         = ( FluxButtonData * ) node_data(store, btn)->component_data;
+	FluxButtonData const *bd         = ( FluxButtonData const * ) node_data(store, btn)->component_data;
 	EXPECT(strcmp(bd->label, "Increment") == 0, "button label mounted");
 
 	/* Simulate clicks through the retained behavior (the real input path). */
-	FluxNodeData *bnd = node_data(store, btn);
-	bnd->behavior.on_click(bnd->behavior.on_click_ctx);
-	bnd->behavior.on_click(bnd->behavior.on_click_ctx);
-	bnd->behavior.on_click(bnd->behavior.on_click_ctx);
+	FluxNodeData const *bnd = node_data(store, btn);
+	bnd->behavior->on_click(bnd->behavior->on_click_ctx);
+	bnd->behavior->on_click(bnd->behavior->on_click_ctx);
+	bnd->behavior->on_click(bnd->behavior->on_click_ctx);
 	xtk_runtime_frame(rt);
 
 	EXPECT(m.count == 3, "messages drained through update");
 	EXPECT(rt->root->children [1]->node == btn_id, "button node reused across diffs");
-	bd = ( FluxButtonData * ) node_data(store, rt->root->children [1])->component_data;
+	bd = ( FluxButtonData const * ) node_data(store, rt->root->children [1])->component_data;
 	EXPECT(strcmp(bd->label, "Lots!") == 0, "label updated in place");
 	EXPECT(flux_node_store_count(store) == base_count, "no node churn on prop diff");
 
 	/* Conditional mount: checkbox toggle reveals the slider. */
-	FluxNodeData *cnd = node_data(store, rt->root->children [2]);
-	cnd->behavior.on_click(cnd->behavior.on_click_ctx);
+	FluxNodeData const *cnd = node_data(store, rt->root->children [2]);
+	cnd->behavior->on_click(cnd->behavior->on_click_ctx);
 	xtk_runtime_frame(rt);
 	EXPECT(m.show_extra, "toggle message carried new state");
 	EXPECT(rt->root->child_count == 6, "slider mounted");
@@ -136,7 +136,7 @@ int                  main(void) {
 
 	/* Conditional unmount: hide the slider again. */
 	cnd = node_data(store, rt->root->children [2]);
-	cnd->behavior.on_click(cnd->behavior.on_click_ctx);
+	cnd->behavior->on_click(cnd->behavior->on_click_ctx);
 	xtk_runtime_frame(rt);
 	EXPECT(rt->root->child_count == 5, "slider unmounted");
 	EXPECT(flux_node_store_count(store) == base_count, "slider node fully released");
@@ -0,0 +1,155 @@
+/**
+ * @file test_fx_retain.c
+ * @brief Headless test for retained command ranges across collects.
+ *
+ * An unchanged tree is spliced from the previous collect without rebuilding
+ * snapshots; a read lookup keeps it that way, while editing a card through
+ * the store rebuilds that card alone and its children stay spliced; layout
+ * and structure changes made without a touch are still picked up. After
+ * every step the stream must match a fresh engine's. No window or GPU.
+ */
+#include <fluxent/fluxent.h>
+#include <stdio.h>
+#include <string.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define CARDS 4
+
+static FluxRect node_rect(XentContext *ctx, XentNodeId node) {
+	XentRect r = {0};
+	xent_get_layout_rect(ctx, node, &r);
+	return (FluxRect) {r.x, r.y, r.w, r.h};
+}
+
+static bool rect_equal(FluxRect a, FluxRect b) { return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h; }
+
+/* Retained and freshly collected streams must be indistinguishable. */
+static int expect_matches_fresh(
+  FluxEngine const *eng, FluxNodeStore *store, FluxControlRegistry const *registry, XentContext *ctx, XentNodeId root
+) {
+	FluxEngine *fresh = flux_engine_create(store, registry);
+	EXPECT(fresh, "fresh engine creation");
+	flux_engine_collect(fresh, ctx, root);
+
+	uint32_t count = flux_engine_command_count(eng);
+	EXPECT(count == flux_engine_command_count(fresh), "retained stream has the fresh command count");
+	for (uint32_t i = 0; i < count; i++) {
+		FluxRenderCommand const *a = flux_engine_command_at(eng, i);
+		FluxRenderCommand const *b = flux_engine_command_at(fresh, i);
+		EXPECT(a->phase == b->phase && a->clip_action == b->clip_action, "same command kinds");
+		EXPECT(rect_equal(a->bounds, b->bounds), "same command bounds");
+		EXPECT(memcmp(&a->state, &b->state, sizeof(a->state)) == 0, "same control state");
+
+		FluxRenderSnapshot sa, sb;
+		bool               has_a = flux_engine_command_snapshot(eng, i, &sa);
+		EXPECT(has_a == flux_engine_command_snapshot(fresh, i, &sb), "same payload presence");
+		if (!has_a) continue;
+		EXPECT(sa.id == sb.id && sa.type == sb.type, "same node per draw");
+		EXPECT(flux_snapshot_hash(&sa) == flux_snapshot_hash(&sb), "same snapshot content");
+	}
+	flux_engine_destroy(fresh);
+	return 0;
+}
+
+int main(void) {
+	XentConfig           config   = {0};
+	XentContext         *ctx      = xent_create_context(&config);
+	FluxNodeStore       *store    = flux_node_store_create(64);
+	FluxControlRegistry *registry = flux_control_registry_create();
+	EXPECT(ctx && store && registry, "context/store/registry creation");
+	flux_node_store_bind_context(store, ctx);
+	flux_register_builtins(registry);
+
+	XentNodeId root = xent_create_node(ctx);
+	xent_set_protocol(ctx, root, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, root, XENT_FLEX_COLUMN);
+	xent_set_gap(ctx, root, 8.0f);
+
+	XentNodeId cards [CARDS];
+	for (int i = 0; i < CARDS; i++) {
+		cards [i] = flux_create_card(&(FluxContainerCreateInfo) {ctx, store, root});
+		xent_set_protocol(ctx, cards [i], XENT_PROTOCOL_FLEX);
+		xent_set_size(ctx, cards [i], (XentSize) {200.0f, 40.0f});
+		flux_create_text(&(FluxTextCreateInfo) {ctx, store, cards [i], "Caption", 13.0f});
+		flux_create_button(&(FluxButtonCreateInfo) {ctx, store, cards [i], "Action", NULL, NULL});
+	}
+	uint32_t nodes = 1 + 3 * CARDS;
+
+	xent_layout(ctx, root, 400.0f, 400.0f);
+	flux_node_store_attach_userdata(store, ctx);
+
+	FluxEngine *eng = flux_engine_create(store, registry);
+	EXPECT(eng, "engine creation");
+
+	FluxEngineStats  stats;
+	FluxDamageRegion damage;
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_stats(eng, &stats);
+	EXPECT(stats.snapshots_built == nodes && stats.reused_commands == 0, "first collect builds every snapshot");
+
+	/* The root is a bare layout node (no store data), so it is rebuilt while
+	 * every card below it is spliced. */
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_stats(eng, &stats);
+	EXPECT(stats.snapshots_built == 1, "unchanged collect rebuilds only the bare root");
+	EXPECT(stats.reused_commands + 1 == stats.commands, "every card's commands are reused");
+	flux_engine_get_damage(eng, &damage);
+	EXPECT(flux_damage_is_empty(&damage), "reused commands cause no damage");
+	if (expect_matches_fresh(eng, store, registry, ctx, root)) return 1;
+
+	/* A plain read touches nothing. */
+	EXPECT(flux_node_store_get(store, cards [1]), "card node data");
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_stats(eng, &stats);
+	EXPECT(stats.snapshots_built == 1, "a read lookup keeps every card reused");
+
+	FluxNodeData *nd = flux_node_store_edit(store, cards [1]);
+	EXPECT(nd, "card node data for writing");
+	nd->visuals.background = flux_color_rgb(200, 10, 10);
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_stats(eng, &stats);
+	EXPECT(stats.snapshots_built == 1 + 1, "touched card is rebuilt, its untouched children reused");
+	flux_engine_get_damage(eng, &damage);
+	FluxRect changed = node_rect(ctx, cards [1]);
+	EXPECT(flux_damage_intersects(&damage, &changed), "damage covers the touched card");
+	if (expect_matches_fresh(eng, store, registry, ctx, root)) return 1;
+
+	/* Layout change through xent only: no store write, no touch. */
+	xent_set_size(ctx, cards [2], (XentSize) {200.0f, 64.0f});
+	xent_layout(ctx, root, 400.0f, 400.0f);
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_stats(eng, &stats);
+	EXPECT(stats.reused_commands > 0, "cards above the resized one are still reused");
+	EXPECT(stats.snapshots_built > 1 + 3, "resized and shifted cards are rebuilt");
+	if (expect_matches_fresh(eng, store, registry, ctx, root)) return 1;
+
+	/* Structure change: a new child is created through the store. */
+	flux_create_text(&(FluxTextCreateInfo) {ctx, store, cards [0], "Extra", 13.0f});
+	xent_layout(ctx, root, 400.0f, 400.0f);
+	flux_node_store_attach_userdata(store, ctx);
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_stats(eng, &stats);
+	EXPECT(stats.commands == flux_engine_command_count(eng), "stats count the stream");
+	EXPECT(stats.snapshots_built >= 1 + 2, "card with a new child is rebuilt along with the child");
+	if (expect_matches_fresh(eng, store, registry, ctx, root)) return 1;
+
+	flux_engine_invalidate(eng);
+	flux_engine_collect(eng, ctx, root);
+	flux_engine_get_stats(eng, &stats);
+	EXPECT(stats.snapshots_built == nodes + 1 && stats.reused_commands == 0, "invalidate rebuilds everything");
+
+	flux_engine_destroy(eng);
+	flux_control_registry_destroy(registry);
+	flux_node_store_destroy(store);
+	xent_destroy_context(ctx);
+	printf("PASS: retained commands\n");
+	return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file test_fx_tree.c
+ * @brief Headless TreeView flat-list probe: a file-browser-shaped forest
+ * (folders of files) is expanded and collapsed programmatically, and after
+ * every step the flat list and the handle → flat map must match the pre-order
+ * of the expanded tree. A 20k-deep folder chain is collapsed, re-expanded and
+ * removed to check nothing walks the tree recursively. Expanding one folder
+ * near the top of the forest is timed. A provider-backed node shows a
+ * placeholder until its children are delivered, and is re-fetched after
+ * eviction; handles to evicted children go stale even once their slots are
+ * reused. Without a provider, a node declared to have children stays a leaf
+ * and is never evicted. Queries leave the tree's generation alone. No window
+ * or GPU.
+ */
+#include <fluxent/fluxent.h>
+#include <fluxent/controls/flux_tree_view_data.h>
+#include "runtime/flux_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FOLDERS 1000
+#define FILES   100
+#define DEPTH   20000
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+static int folder [FOLDERS];
+static int file [FOLDERS][FILES];
+static int populate_calls;
+static int populate_node = -1;
+
+/* The provider only records the request; main() delivers the children later,
+ * as a worker's result posted back to the UI thread would. */
+static void populate(void *ctx, int node) {
+	( void ) ctx;
+	populate_calls++;
+	populate_node = node;
+}
+
+/* Two-level forest: the expected flat list is folder, then its files when expanded. */
+static int expect_flat(FluxNodeStore *store, XentNodeId tree, int first_folder) {
+	int flat = 0;
+	for (int f = first_folder; f < FOLDERS; f++) {
+		EXPECT(flux_tree_view_flat_node(store, tree, flat) == folder [f], "folder row in pre-order");
+		EXPECT(flux_tree_view_node_flat(store, tree, folder [f]) == flat, "folder maps to its row");
+		flat++;
+		bool open = flux_tree_view_is_expanded(store, tree, folder [f]);
+		for (int i = 0; i < FILES; i++) {
+			int row = open ? flat + i : -1;
+			EXPECT(flux_tree_view_node_flat(store, tree, file [f][i]) == row, "file maps to its row, or -1");
+			if (open) EXPECT(flux_tree_view_flat_node(store, tree, row) == file [f][i], "file row in pre-order");
+		}
+		if (open) flat += FILES;
+	}
+	EXPECT(flux_tree_view_flat_count(store, tree) == flat, "flat count matches the expanded tree");
+	return 0;
+}
+
+int main(void) {
+	XentConfig     config = {0};
+	XentContext   *ctx    = xent_create_context(&config);
+	FluxNodeStore *store  = flux_node_store_create(64);
+	EXPECT(ctx && store, "context/store creation");
+	flux_node_store_bind_context(store, ctx);
+
+	XentNodeId root = xent_create_node(ctx);
+	XentNodeId tree = flux_create_tree_view(&(FluxTreeViewCreateInfo) {
+	  .ctx = ctx, .store = store, .parent = root, .on_populate = populate});
+	EXPECT(tree != XENT_NODE_INVALID, "tree view creation");
+
+	for (int f = 0; f < FOLDERS; f++) {
+		folder [f] = flux_tree_view_add_node(store, tree, -1, "folder", NULL);
+		EXPECT(folder [f] >= 0, "folder added");
+		for (int i = 0; i < FILES; i++) file [f][i] = flux_tree_view_add_node(store, tree, folder [f], "file", NULL);
+	}
+	if (expect_flat(store, tree, 0)) return 1;
+
+	/* Expand near the top: the whole forest below shifts by one folder's files. */
+	int64_t start = flux_perf_now();
+	flux_tree_view_set_expanded(store, tree, folder [3], true);
+	double expand = flux_perf_seconds(flux_perf_now() - start);
+	EXPECT(flux_tree_view_node_flat(store, tree, folder [4]) == 4 + FILES, "later folders shift down");
+	/* expect_flat only asks, so the tree's retained commands stay valid. */
+	uint32_t gen = flux_node_store_get(store, tree)->generation;
+	if (expect_flat(store, tree, 0)) return 1;
+	EXPECT(flux_node_store_get(store, tree)->generation == gen, "queries do not mark the tree changed");
+
+	for (int f = 0; f < FOLDERS; f += 2) flux_tree_view_set_expanded(store, tree, folder [f], true);
+	flux_tree_view_set_expanded(store, tree, folder [3], false);
+	if (expect_flat(store, tree, 0)) return 1;
+
+	/* A child added under an expanded folder lands at the end of its run. */
+	int extra = flux_tree_view_add_node(store, tree, folder [0], "late", NULL);
+	EXPECT(flux_tree_view_node_flat(store, tree, extra) == 1 + FILES, "late child follows its siblings");
+	flux_tree_view_remove_node(store, tree, extra);
+	if (expect_flat(store, tree, 0)) return 1;
+
+	/* Deep chain under folder 0, each level expanded before its child arrives. */
+	int leaf = folder [0];
+	for (int i = 0; i < DEPTH; i++) {
+		flux_tree_view_set_expanded(store, tree, leaf, true);
+		leaf = flux_tree_view_add_node(store, tree, leaf, "nested", NULL);
+		EXPECT(leaf >= 0, "nested folder added");
+	}
+	EXPECT(flux_tree_view_node_flat(store, tree, leaf) == FILES + DEPTH, "deep leaf visible below the files");
+	flux_tree_view_set_expanded(store, tree, folder [0], false);
+	EXPECT(flux_tree_view_node_flat(store, tree, leaf) == -1, "collapsed chain hidden");
+	EXPECT(flux_tree_view_node_flat(store, tree, folder [1]) == 1, "collapse closes the whole chain");
+	flux_tree_view_set_expanded(store, tree, folder [0], true);
+	EXPECT(flux_tree_view_node_flat(store, tree, leaf) == FILES + DEPTH, "re-expand restores the chain");
+
+	flux_tree_view_remove_node(store, tree, folder [0]);
+	EXPECT(flux_tree_view_node_flat(store, tree, folder [1]) == 0, "removal closes the folder's run");
+	if (expect_flat(store, tree, 1)) return 1;
+
+	flux_tree_view_clear(store, tree);
+	EXPECT(flux_tree_view_flat_count(store, tree) == 0, "clear empties the flat list");
+
+	/* Lazy children: placeholder while pending, provider re-asked after eviction. */
+	int remote = flux_tree_view_add_node(store, tree, -1, "registry", NULL);
+	flux_tree_view_set_has_children(store, tree, remote, true);
+	flux_tree_view_set_expanded(store, tree, remote, true);
+	EXPECT(populate_calls == 1 && populate_node == remote, "first expand asks the provider");
+	EXPECT(flux_tree_view_flat_count(store, tree) == 2, "placeholder row while pending");
+	int first = flux_tree_view_add_node(store, tree, remote, "package", NULL);
+	int last  = first;
+	for (int i = 1; i < FILES; i++) last = flux_tree_view_add_node(store, tree, remote, "package", NULL);
+	flux_tree_view_finish_children(store, tree, remote);
+	EXPECT(flux_tree_view_flat_count(store, tree) == 1 + FILES, "placeholder replaced by the children");
+	EXPECT(flux_tree_view_node_flat(store, tree, first) == 1, "children follow the parent");
+
+	flux_tree_view_set_expanded(store, tree, remote, false);
+	EXPECT(flux_tree_view_evict_collapsed(store, tree, 0) == FILES, "collapsed children evicted");
+	EXPECT(flux_tree_view_flat_count(store, tree) == 1, "eviction leaves the flat list alone");
+	flux_tree_view_set_expanded(store, tree, remote, true);
+	EXPECT(populate_calls == 2, "expand after eviction asks again");
+	EXPECT(flux_tree_view_node_flat(store, tree, first) == -1, "an evicted child's handle is stale");
+	EXPECT(flux_tree_view_add_node(store, tree, first, "orphan", NULL) == -1, "a stale parent is rejected");
+	flux_tree_view_remove_node(store, tree, last); /* its slot now holds the placeholder */
+	EXPECT(flux_tree_view_flat_count(store, tree) == 2, "a stale handle does not reach the reused slot");
+	flux_tree_view_finish_children(store, tree, remote);
+	EXPECT(flux_tree_view_flat_count(store, tree) == 1, "an empty answer leaves a leaf");
+	flux_tree_view_set_expanded(store, tree, remote, false);
+	flux_tree_view_set_expanded(store, tree, remote, true);
+	EXPECT(populate_calls == 2, "a supplied leaf is not re-fetched");
+
+	/* No provider: a declared-but-unsupplied node has nothing to expand. */
+	XentNodeId plain = flux_create_tree_view(&(FluxTreeViewCreateInfo) {.ctx = ctx, .store = store, .parent = root});
+	int        lone  = flux_tree_view_add_node(store, plain, -1, "lone", NULL);
+	flux_tree_view_set_has_children(store, plain, lone, true);
+	FluxTreeViewData const *pd = ( FluxTreeViewData const * ) flux_node_store_get(store, plain)->component_data;
+	EXPECT(!flux_tree_node_has_children(pd, &pd->nodes [pd->flat [0]]), "no chevron without a provider");
+	int kept = flux_tree_view_add_node(store, plain, lone, "kept", NULL);
+	flux_tree_view_set_has_children(store, plain, lone, true);
+	EXPECT(flux_tree_view_evict_collapsed(store, plain, 0) == 0, "nothing evicted without a provider");
+	flux_tree_view_set_expanded(store, plain, lone, true);
+	EXPECT(flux_tree_view_node_flat(store, plain, kept) == 1, "children kept without a provider");
+	EXPECT(populate_calls == 2, "the other tree's provider is not asked");
+
+	printf("expand near top of %d rows: %.3f ms\n", FOLDERS + FILES, expand * 1000.0);
+	flux_node_store_destroy(store);
+	xent_destroy_context(ctx);
+	printf("PASS: tree view flat list\n");
+	return 0;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file test_grapheme.c
+ * @brief Headless test of the UAX #29 grapheme cluster breaker against cases
+ * in GraphemeBreakTest.txt notation ("÷" break, "×" no break). Every case is
+ * checked with the text split at each byte offset, as a gap buffer would hold
+ * it, through is_boundary and by walking next/prev. Passing the path of a
+ * Unicode 15.0 GraphemeBreakTest.txt as the first argument runs the whole file
+ * as well. Finally caret steps are timed in the middle of 1 MB of text, and
+ * 1 MB of Regional_Indicators is walked pair by pair without rescanning the
+ * run.
+ */
+#include "text/flux_grapheme.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define CASE_BYTES 256
+#define BIG_BYTES  (1u << 20)
+#define STEPS      100000
+
+/* A representative slice of GraphemeBreakTest.txt: one line per rule, plus the file's closing examples. */
+static char const *const cases [] = {
+  "÷ 0020 ÷ 0020 ÷",                                       /* GB999 */
+  "÷ 000D × 000A ÷ 0061 ÷ 000A ÷ 0308 ÷",                  /* GB3, GB4, GB5 */
+  "÷ 000D ÷ 000D × 000A ÷",
+  "÷ 0001 ÷ 0308 ÷",
+  "÷ 0600 ÷ 000A ÷",
+  "÷ 000A ÷ 0903 ÷",
+  "÷ 1100 × 1100 ÷",                                       /* GB6 */
+  "÷ 1100 × 1161 × 11A8 ÷ 1100 ÷",
+  "÷ 1100 × AC00 ÷",
+  "÷ AC00 × 1160 × 11A8 ÷",                                /* GB7 */
+  "÷ 1160 × 11A8 ÷",
+  "÷ AC01 × 11A8 ÷ 1100 ÷",                                /* GB8 */
+  "÷ AC01 ÷ 1160 ÷",
+  "÷ 11A8 ÷ 1100 ÷",
+  "÷ 0020 × 0308 ÷ 0020 ÷",                                /* GB9 */
+  "÷ 0061 × 200D ÷",
+  "÷ 0061 × 0308 ÷ 0062 ÷",
+  "÷ 0061 × 0903 ÷ 0062 ÷",                                /* GB9a */
+  "÷ 0E01 × 0E33 ÷",
+  "÷ 0061 ÷ 0600 × 0062 ÷",                                /* GB9b */
+  "÷ 0600 × 0020 ÷",
+  "÷ 1F6D1 × 200D × 1F6D1 ÷",                              /* GB11 */
+  "÷ 2701 × 200D × 2701 ÷",
+  "÷ 1F6D1 × 0308 × 200D × 1F6D1 ÷",
+  "÷ 1F468 × 200D × 1F469 × 200D × 1F467 ÷",
+  "÷ 1F476 × 1F3FF × 0308 × 200D × 1F476 × 1F3FF ÷",
+  "÷ 0061 × 200D ÷ 1F6D1 ÷",
+  "÷ 0061 × 200D ÷ 2701 ÷",
+  "÷ 200D ÷ 1F6D1 ÷",
+  "÷ 0020 × 200D ÷ 0646 ÷",
+  "÷ 0646 × 200D ÷ 0020 ÷",
+  "÷ 1F476 × 1F3FF ÷ 1F476 ÷",
+  "÷ 0061 × 1F3FF ÷ 1F476 ÷",
+  "÷ 0061 × 1F3FF ÷ 1F476 × 200D × 1F6D1 ÷",
+  "÷ 1F1F7 × 1F1FA ÷ 1F1F8 × 1F1EA ÷",                     /* GB12, GB13 */
+  "÷ 1F1F7 × 1F1FA ÷ 1F1F8 × 1F1EA ÷ 1F1EA ÷",
+  "÷ 0061 ÷ 1F1E6 × 1F1E7 ÷ 1F1E8 ÷ 0062 ÷",
+  "÷ 0061 × 200D ÷ 1F1E6 × 1F1E7 ÷ 1F1E8 ÷ 0062 ÷",
+  "÷ 0061 ÷ 1F1E6 × 200D ÷ 1F1E7 × 1F1E8 ÷ 0062 ÷",
+  "÷ 0061 ÷ 1F1E6 × 1F1E7 × 200D ÷ 1F1E8 × 1F1E9 ÷ 0062 ÷",
+};
+
+typedef struct Case {
+	char     text [CASE_BYTES];
+	uint32_t len;
+	bool     breaks [CASE_BYTES + 1]; /**< Expected boundary at each code point start. */
+	bool     starts [CASE_BYTES + 1]; /**< Code point starts; only these are checked. */
+} Case;
+
+static uint32_t encode(uint32_t cp, char *out) {
+	if (cp < 0x80) {
+		out [0] = ( char ) cp;
+		return 1;
+	}
+	if (cp < 0x800) {
+		out [0] = ( char ) (0xc0 | cp >> 6);
+		out [1] = ( char ) (0x80 | (cp & 0x3f));
+		return 2;
+	}
+	if (cp < 0x10000) {
+		out [0] = ( char ) (0xe0 | cp >> 12);
+		out [1] = ( char ) (0x80 | ((cp >> 6) & 0x3f));
+		out [2] = ( char ) (0x80 | (cp & 0x3f));
+		return 3;
+	}
+	out [0] = ( char ) (0xf0 | cp >> 18);
+	out [1] = ( char ) (0x80 | ((cp >> 12) & 0x3f));
+	out [2] = ( char ) (0x80 | ((cp >> 6) & 0x3f));
+	out [3] = ( char ) (0x80 | (cp & 0x3f));
+	return 4;
+}
+
+/* Parses "÷ 0020 × 0308 ÷"; false on anything else (comments are stripped by the caller). */
+static bool parse_case(char const *line, Case *c) {
+	memset(c, 0, sizeof(*c));
+	size_t const div = strlen("÷");
+	size_t const mul = strlen("×");
+	for (char const *p = line; *p;) {
+		if (*p == ' ' || *p == '\t') {
+			p++;
+		} else if (strncmp(p, "÷", div) == 0) {
+			c->breaks [c->len]  = true;
+			p                  += div;
+		} else if (strncmp(p, "×", mul) == 0) {
+			p += mul;
+		} else {
+			char         *end;
+			unsigned long cp = strtoul(p, &end, 16);
+			if (end == p || cp > 0x10ffff || c->len + 4 > CASE_BYTES) return false;
+			c->starts [c->len]  = true;
+			c->len             += encode(( uint32_t ) cp, c->text + c->len);
+			p                   = end;
+		}
+	}
+	c->starts [c->len] = true;
+	return c->len > 0;
+}
+
+static int check_case(Case const *c, char const *line) {
+	for (uint32_t split = 0; split <= c->len; split++) {
+		FluxGraphemeText t = {c->text, split, c->text + split, c->len - split};
+		for (uint32_t i = 0; i <= c->len; i++) {
+			if (!c->starts [i]) continue;
+			if (flux_grapheme_is_boundary(&t, i) != c->breaks [i]) {
+				printf("  at byte %u, split %u: %s\n", i, split, line);
+				EXPECT(false, "is_boundary matches the test data");
+			}
+		}
+		uint32_t pos = 0;
+		for (uint32_t i = 1; i <= c->len; i++) {
+			if (!c->breaks [i]) continue;
+			uint32_t next = flux_grapheme_next(&t, pos);
+			if (next != i || flux_grapheme_prev(&t, next) != pos) {
+				printf("  from byte %u, split %u: %s\n", pos, split, line);
+				EXPECT(false, "next/prev walk the test data boundaries");
+			}
+			pos = next;
+		}
+	}
+	return 0;
+}
+
+static int run_file(char const *path) {
+	FILE *f = fopen(path, "r");
+	EXPECT(f, "open GraphemeBreakTest.txt");
+	char line [1024];
+	int  count = 0;
+	Case c;
+	while (fgets(line, sizeof(line), f)) {
+		char *hash = strchr(line, '#');
+		if (hash) *hash = '\0';
+		line [strcspn(line, "\r\n")] = '\0';
+		if (!parse_case(line, &c)) continue;
+		if (check_case(&c, line)) {
+			fclose(f);
+			return 1;
+		}
+		count++;
+	}
+	fclose(f);
+	printf("%s: %d cases\n", path, count);
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	Case c;
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases [0]); i++) {
+		EXPECT(parse_case(cases [i], &c), "case parses");
+		if (check_case(&c, cases [i])) return 1;
+	}
+
+	EXPECT(flux_grapheme_property(0x0d) == FLUX_GB_CR, "CR property");
+	EXPECT(flux_grapheme_property(0xac00) == FLUX_GB_LV, "LV syllable");
+	EXPECT(flux_grapheme_property(0xac01) == FLUX_GB_LVT, "LVT syllable");
+	EXPECT(flux_grapheme_property(0x1f3ff) == FLUX_GB_EXTEND, "emoji modifier extends");
+	EXPECT(flux_grapheme_property(0xa9) == FLUX_GB_EXT_PICT, "copyright sign is pictographic");
+
+	/* Invalid bytes are single clusters, as the textbox code point helpers treat them. */
+	char             bad [] = "a\x80\xe2\x82" "b";
+	FluxGraphemeText t      = {bad, 2, bad + 2, 3};
+	EXPECT(flux_grapheme_next(&t, 1) == 2 && flux_grapheme_next(&t, 2) == 3, "invalid bytes step one at a time");
+	EXPECT(flux_grapheme_prev(&t, 4) == 3 && flux_grapheme_prev(&t, 3) == 2, "and back");
+
+	if (argc > 1 && run_file(argv [1])) return 1;
+
+	/* 1 MB of combining sequences and flags with the gap in the middle; a caret step only reads its cluster. */
+	static char const unit [] = "e\xcc\x81\xf0\x9f\x87\xab\xf0\x9f\x87\xb7 "; /* e + U+0301, FR flag, space */
+	uint32_t          ulen    = ( uint32_t ) strlen(unit);
+	char             *big     = ( char * ) malloc(BIG_BYTES);
+	EXPECT(big, "allocation");
+	uint32_t len = 0;
+	for (; len + ulen <= BIG_BYTES; len += ulen) memcpy(big + len, unit, ulen);
+	uint32_t mid = len / 2 / ulen * ulen;
+	t            = (FluxGraphemeText) {big, mid, big + mid, len - mid};
+
+	uint32_t pos   = mid;
+	clock_t  start = clock();
+	for (int i = 0; i < STEPS; i++) pos = flux_grapheme_next(&t, pos);
+	for (int i = 0; i < STEPS; i++) pos = flux_grapheme_prev(&t, pos);
+	double step_ns = ( double ) (clock() - start) / CLOCKS_PER_SEC * 1e9 / (2.0 * STEPS);
+	EXPECT(pos == mid, "forward and back return to the caret");
+	EXPECT(flux_grapheme_next(&t, mid) == mid + 3, "accent joins its base");
+	EXPECT(flux_grapheme_next(&t, mid + 3) == mid + 11, "flag pair is one cluster");
+
+	/* One Regional_Indicator run over the whole megabyte: the forward walk
+	 * carries the pairing along, so it stays linear and exact. */
+	static char const ri [] = "\xf0\x9f\x87\xab"; /* U+1F1EB */
+	for (len = 0; len + 4 <= BIG_BYTES; len += 4) memcpy(big + len, ri, 4);
+	t     = (FluxGraphemeText) {big, len / 2, big + len / 2, len - len / 2};
+	start = clock();
+	for (pos = 0; pos < len;) {
+		uint32_t next = flux_grapheme_next(&t, pos);
+		EXPECT(next == pos + 8, "flags pair up along the run");
+		pos = next;
+	}
+	double walk_ms = ( double ) (clock() - start) / CLOCKS_PER_SEC * 1e3;
+	EXPECT(flux_grapheme_prev(&t, len) < len, "a step back from the end of the run");
+	free(big);
+
+	printf("grapheme step in %u bytes: %.1f ns\n", len, step_ns);
+	printf("walk over %u bytes of flags: %.1f ms\n", len, walk_ms);
+	printf("PASS: grapheme segmentation\n");
+	return 0;
+}
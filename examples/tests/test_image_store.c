@@ -0,0 +1,266 @@
+/**
+ * @file test_image_store.c
+ * @brief Headless test of the image store over a stub backend. Sources named
+ * "WxH..." decode as a WxH image scaled to the requested bucket, anything else
+ * fails. Jobs go to a manual queue that the test runs as its worker, so
+ * pending, ready and failed states, cancellation of evicted decodes and
+ * destruction with decodes in flight are checked deterministically. It checks
+ * the decode-to-size math and the mip levels a downscaled decode lands, then
+ * measures a 12 MP photo shown as a 40-DIP avatar at 150%. Finally a gallery
+ * of 500 images (the old cache stopped at 64) scrolls through a budget of 16
+ * thumbnails.
+ */
+#include "render/flux_image_store.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define QUEUE_MAX     1024
+#define GALLERY       500
+#define GALLERY_VIEW  12
+#define THUMB         64
+#define THUMB_BYTES   (THUMB * THUMB * 4)
+
+typedef struct StubBitmap {
+	uint32_t w, h;
+	uint8_t *pixels; /**< Copy of the upload, to check mip levels. */
+} StubBitmap;
+
+static struct {
+	FluxImageJobFn fn [QUEUE_MAX];
+	void          *job [QUEUE_MAX];
+	int            count;
+	int            decodes;
+	int            uploads;
+	int            live;
+	int            lock_depth;
+	bool           refuse;
+} stub;
+
+static bool stub_decode(
+  void *ctx, char const *source, uint32_t box_w, uint32_t box_h, FluxImagePixels *out, uint32_t *natural_w,
+  uint32_t *natural_h
+) {
+	( void ) ctx;
+	stub.decodes++;
+	unsigned nw = 0, nh = 0;
+	if (sscanf(source, "%ux%u", &nw, &nh) != 2 || !nw || !nh) return false;
+	*natural_w = nw;
+	*natural_h = nh;
+	flux_image_fit_size(nw, nh, box_w, box_h, &out->width, &out->height);
+	out->stride = out->width * 4u + 8u; /* padded rows */
+	out->data   = ( uint8_t * ) malloc(( size_t ) out->stride * out->height);
+	if (!out->data) return false;
+	for (uint32_t y = 0; y < out->height; y++)
+		for (uint32_t x = 0; x < out->width * 4u; x++) out->data [y * out->stride + x] = ( uint8_t ) (x * 7 + y * 13);
+	return true;
+}
+
+static void *stub_upload(void *ctx, FluxImagePixels const *px) {
+	( void ) ctx;
+	StubBitmap *b = ( StubBitmap * ) malloc(sizeof(*b));
+	b->w          = px->width;
+	b->h          = px->height;
+	b->pixels     = ( uint8_t * ) malloc(( size_t ) px->width * px->height * 4u);
+	for (uint32_t y = 0; y < px->height; y++)
+		memcpy(b->pixels + ( size_t ) y * px->width * 4u, px->data + ( size_t ) y * px->stride, px->width * 4u);
+	stub.uploads++;
+	stub.live++;
+	return b;
+}
+
+static void stub_release(void *ctx, void *bitmap) {
+	( void ) ctx;
+	free((( StubBitmap * ) bitmap)->pixels);
+	free(bitmap);
+	stub.live--;
+}
+
+static bool stub_submit(void *ctx, FluxImageJobFn fn, void *job) {
+	( void ) ctx;
+	if (stub.refuse || stub.count == QUEUE_MAX) return false;
+	stub.fn [stub.count]  = fn;
+	stub.job [stub.count] = job;
+	stub.count++;
+	return true;
+}
+
+static void stub_lock(void *ctx) {
+	( void ) ctx;
+	stub.lock_depth++;
+}
+
+static void stub_unlock(void *ctx) {
+	( void ) ctx;
+	stub.lock_depth--;
+}
+
+/* The "worker": runs every queued job in submission order. */
+static void run_jobs(void) {
+	for (int i = 0; i < stub.count; i++) stub.fn [i](stub.job [i]);
+	stub.count = 0;
+}
+
+static FluxImageBackend const backend = {
+  .decode  = stub_decode,
+  .upload  = stub_upload,
+  .release = stub_release,
+  .submit  = stub_submit,
+  .lock    = stub_lock,
+  .unlock  = stub_unlock,
+};
+
+/* A mip pixel is the rounded mean of the 2x2 block above it. */
+static bool mip_matches(StubBitmap const *big, StubBitmap const *small, uint32_t x, uint32_t y, uint32_t c) {
+	uint32_t x1 = 2 * x + 1 < big->w ? 2 * x + 1 : 2 * x, y1 = 2 * y + 1 < big->h ? 2 * y + 1 : 2 * y;
+	uint32_t sum = 0;
+	sum += big->pixels [(2 * y * big->w + 2 * x) * 4 + c] + big->pixels [(2 * y * big->w + x1) * 4 + c];
+	sum += big->pixels [(y1 * big->w + 2 * x) * 4 + c] + big->pixels [(y1 * big->w + x1) * 4 + c];
+	return small->pixels [(y * small->w + x) * 4 + c] == (sum + 2) / 4;
+}
+
+int main(void) {
+	FluxImageStore     *s = flux_image_store_create(&backend, FLUX_IMAGE_STORE_BUDGET);
+	FluxImageStoreStats st;
+	FluxImageInfo       info;
+	uint32_t            w = 0, h = 0;
+	EXPECT(s, "store created");
+	EXPECT(!flux_image_store_create(&(FluxImageBackend) {.decode = stub_decode}, 0), "backend needs upload/release");
+
+	/* Decode-to-size: cover the box, keep the aspect, never scale up. */
+	flux_image_fit_size(4000, 3000, 64, 64, &w, &h);
+	EXPECT(w == 86 && h == 64, "landscape covers the box by height");
+	flux_image_fit_size(3000, 4000, 64, 0, &w, &h);
+	EXPECT(w == 64 && h == 86, "an open side is unconstrained");
+	flux_image_fit_size(100, 80, 512, 512, &w, &h);
+	EXPECT(w == 100 && h == 80, "no upscaling");
+	flux_image_fit_size(100, 80, 0, 0, &w, &h);
+	EXPECT(w == 100 && h == 80, "0 x 0 is the natural size");
+
+	/* Pending until the worker runs, then ready; the placeholder frame never blocks. */
+	EXPECT(!flux_image_store_acquire(s, "320x200.png", 0, 0, &info), "first acquire is a placeholder");
+	EXPECT(info.state == FLUX_IMAGE_PENDING && stub.count == 1 && stub.decodes == 0, "decode queued, not run");
+	EXPECT(!flux_image_store_acquire(s, "320x200.png", 0, 0, &info) && stub.count == 1, "queued once");
+	flux_image_store_stats(s, &st);
+	EXPECT(st.pending == 1, "one pending");
+	run_jobs();
+	StubBitmap *b = ( StubBitmap * ) flux_image_store_acquire(s, "320x200.png", 0, 0, &info);
+	EXPECT(b && info.state == FLUX_IMAGE_READY && info.width == 320 && info.natural_h == 200, "ready at natural size");
+	EXPECT(flux_image_store_acquire(s, "320x200.png", 0, 0, NULL) == b, "hit returns the same bitmap");
+
+	/* A failed decode is cached: no decode every frame. */
+	EXPECT(!flux_image_store_acquire(s, "missing.png", 0, 0, &info) && info.state == FLUX_IMAGE_PENDING, "queued");
+	run_jobs();
+	int decodes = stub.decodes;
+	for (int i = 0; i < 10; i++) flux_image_store_acquire(s, "missing.png", 0, 0, &info);
+	EXPECT(info.state == FLUX_IMAGE_FAILED && stub.decodes == decodes && stub.count == 0, "failure cached");
+	flux_image_store_stats(s, &st);
+	EXPECT(st.pending == 0 && st.decoded == 1 && st.failed == 1, "counters");
+
+	/* A 12 MP photo as a 40-DIP avatar at 150%: 60 px, bucket 64, plus two mips. */
+	StubBitmap *avatar = ( StubBitmap * ) flux_image_store_acquire(s, "4000x3000 photo.jpg", 60, 60, &info);
+	EXPECT(!avatar, "avatar pending");
+	run_jobs();
+	avatar = ( StubBitmap * ) flux_image_store_acquire(s, "4000x3000 photo.jpg", 60, 60, &info);
+	EXPECT(avatar && info.width == 86 && info.height == 64, "decoded to the bucket");
+	EXPECT(info.natural_w == 4000 && info.natural_h == 3000, "natural size reported for layout");
+	size_t avatar_bytes = ( size_t ) info.width * info.height * 4u;
+	flux_image_store_stats(s, &st);
+	EXPECT(st.mips == 2, "two halved levels landed");
+	decodes            = stub.decodes;
+	StubBitmap *half   = ( StubBitmap * ) flux_image_store_acquire(s, "4000x3000 photo.jpg", 30, 30, &info);
+	StubBitmap *fourth = ( StubBitmap * ) flux_image_store_acquire(s, "4000x3000 photo.jpg", 12, 12, &info);
+	EXPECT(half && half->w == 43 && half->h == 32 && fourth && fourth->w == 22 && fourth->h == 16, "mip sizes");
+	EXPECT(stub.decodes == decodes && stub.count == 0, "a shrinking thumbnail needs no decode");
+	for (uint32_t c = 0; c < 4; c++) {
+		EXPECT(mip_matches(avatar, half, 5, 7, c) && mip_matches(half, fourth, 21, 15, c), "box-filtered levels");
+	}
+
+	/* Growing: the next bucket decodes, and the ready one stands in meanwhile. */
+	EXPECT(flux_image_store_acquire(s, "4000x3000 photo.jpg", 120, 120, &info) == avatar, "stand-in while pending");
+	EXPECT(info.state == FLUX_IMAGE_PENDING && info.width == 86 && stub.count == 1, "larger bucket queued");
+	run_jobs();
+	EXPECT(flux_image_store_acquire(s, "4000x3000 photo.jpg", 120, 120, &info) && info.width == 171, "grown");
+	decodes = stub.decodes;
+	EXPECT(flux_image_store_acquire(s, "4000x3000 photo.jpg", 60, 60, &info) == avatar, "existing level kept");
+	EXPECT(stub.decodes == decodes, "still no decode");
+
+	/* Small sources decode at natural size and get no levels. */
+	flux_image_store_stats(s, &st);
+	uint64_t mips = st.mips;
+	flux_image_store_acquire(s, "40x30 icon.png", 256, 256, NULL);
+	run_jobs();
+	EXPECT(flux_image_store_acquire(s, "40x30 icon.png", 256, 256, &info) && info.width == 40, "not upscaled");
+	flux_image_store_stats(s, &st);
+	EXPECT(st.mips == mips, "natural-size decodes are not halved");
+
+	/* Evicted before the worker starts: the job is skipped. Evicted after it
+	 * finished but before the drain: the result is dropped without upload. */
+	flux_image_store_acquire(s, "10x10 a", 0, 0, NULL);
+	flux_image_store_set_budget(s, 0);
+	EXPECT(stub.live == 0, "ready bitmaps released on eviction");
+	decodes = stub.decodes;
+	run_jobs();
+	EXPECT(stub.decodes == decodes, "cancelled job not decoded");
+	flux_image_store_set_budget(s, FLUX_IMAGE_STORE_BUDGET);
+	flux_image_store_acquire(s, "10x10 b", 0, 0, NULL);
+	run_jobs();
+	int uploads = stub.uploads;
+	flux_image_store_set_budget(s, 0);
+	EXPECT(flux_image_store_drain(s) == 0 && stub.uploads == uploads, "finished but evicted result dropped");
+	flux_image_store_stats(s, &st);
+	EXPECT(st.pending == 0 && st.cache.entries == 0, "store empty");
+
+	/* A pool that refuses work falls back to decoding inline. */
+	flux_image_store_set_budget(s, FLUX_IMAGE_STORE_BUDGET);
+	stub.refuse = true;
+	EXPECT(flux_image_store_acquire(s, "8x8 inline", 0, 0, &info) && info.width == 8, "inline decode is ready at once");
+	stub.refuse = false;
+
+	/* Gallery: scroll a 12-wide window over 500 thumbnails with a 16-thumbnail budget. */
+	size_t budget = 16 * (THUMB_BYTES + 256);
+	flux_image_store_set_budget(s, budget);
+	int    shown  = 0;
+	size_t peak   = 0;
+	char   name [64];
+	for (int top = 0; top + GALLERY_VIEW <= GALLERY; top++) {
+		for (int pass = 0; pass < 2; pass++) { /* frame, worker, frame */
+			for (int i = top; i < top + GALLERY_VIEW; i++) {
+				snprintf(name, sizeof(name), "%dx%d photo%03d.jpg", THUMB, THUMB, i);
+				if (flux_image_store_acquire(s, name, 0, 0, &info) && i == top + GALLERY_VIEW - 1) shown++;
+				EXPECT(info.state != FLUX_IMAGE_FAILED, "gallery image loads");
+			}
+			run_jobs();
+			flux_image_store_stats(s, &st);
+			if (st.cache.bytes > peak) peak = st.cache.bytes;
+			EXPECT(st.cache.bytes <= budget, "gallery within budget");
+		}
+	}
+	EXPECT(shown == GALLERY - GALLERY_VIEW + 1, "every image past the old 64 cap is shown");
+	int live = stub.live;
+	EXPECT(live <= 16, "bitmaps beyond the budget released");
+	EXPECT(stub.lock_depth == 0, "lock balanced");
+
+	/* Destroyed with decodes queued: the jobs free themselves when they run. */
+	flux_image_store_acquire(s, "4x4 late", 0, 0, NULL);
+	EXPECT(stub.count == 1, "job in flight");
+	flux_image_store_destroy(s);
+	run_jobs();
+	EXPECT(stub.live == 0, "every bitmap released");
+	flux_image_store_destroy(NULL);
+
+	printf("12 MP photo as a 40-DIP avatar at 150%%: %zu bytes (natural: %u)\n", avatar_bytes, 4000u * 3000u * 4u);
+	printf("gallery of %d images: %d bitmaps live, peak %zu of %zu budget bytes\n", GALLERY, live, peak, budget);
+	printf("PASS: image store\n");
+	return 0;
+}
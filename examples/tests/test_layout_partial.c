@@ -0,0 +1,171 @@
+/**
+ * @file test_layout_partial.c
+ * @brief Headless test for relaying only dirty layout-boundary subtrees.
+ *
+ * A page of 30k text nodes carries two fixed-size cards, one at the page
+ * origin and one below it, each holding a text box away from the card's own
+ * origin. xent lays a root out at the origin, so only the first card can be
+ * relaid alone. Typing into its box relays the card on every keystroke and
+ * never the page. Typing into the second box lays the page out every time
+ * without first trying either boundary alone. Every rect stays where the full
+ * pass put it. A boundary that is queued and then destroyed is dropped, and a
+ * change outside any boundary still lays the page out once. The time per
+ * keystroke frame is compared with a full pass. No window or GPU.
+ */
+#include <fluxent/fluxent.h>
+#include "runtime/flux_time.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define PAGE_NODES 30000
+#define KEYSTROKES 24
+
+static size_t typed_len;
+
+static void   on_typed(void *ctx, char const *text) {
+	( void ) ctx;
+	typed_len = text ? strlen(text) : 0;
+}
+
+static bool rect_eq(XentContext *ctx, XentNodeId node, XentRect want) {
+	XentRect r = {0};
+	xent_get_layout_rect(ctx, node, &r);
+	return r.x == want.x && r.y == want.y && r.w == want.w && r.h == want.h;
+}
+
+static bool rects_kept(XentContext *ctx, XentNodeId const *nodes, XentRect const *rects, int count) {
+	for (int i = 0; i < count; i++)
+		if (!rect_eq(ctx, nodes [i], rects [i])) return false;
+	return true;
+}
+
+static double type_into(FluxInput *input, FluxNodeStore *store, XentNodeId root, XentNodeId box, float w, float h) {
+	double spent = 0.0;
+	flux_input_set_focus(input, box);
+	flux_node_store_layout(store, root, w, h);
+	/* Each keystroke arrives as a key down, its character and a key up. */
+	for (int k = 0; k < KEYSTROKES; k++) {
+		flux_input_key_down(input, 'A');
+		flux_input_char(input, ( wchar_t ) ('a' + k % 26));
+		flux_input_key_up(input, 'A');
+		int64_t t0 = flux_perf_now();
+		flux_node_store_layout(store, root, w, h);
+		spent += flux_perf_seconds(flux_perf_now() - t0);
+	}
+	return spent;
+}
+
+int main(void) {
+	XentConfig     config = {0};
+	XentContext   *ctx    = xent_create_context(&config);
+	FluxNodeStore *store  = flux_node_store_create(PAGE_NODES + 64);
+	EXPECT(ctx && store, "context/store creation");
+	flux_node_store_bind_context(store, ctx);
+
+	XentNodeId root = xent_create_node(ctx);
+	xent_set_protocol(ctx, root, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, root, XENT_FLEX_COLUMN);
+
+	/* The first card sits at the page origin, the second below it; each box
+	 * is the card's second child, inside the card's padding. */
+	XentNodeId cards [2], boxes [2], titles [2];
+	for (int c = 0; c < 2; c++) {
+		cards [c] = flux_create_card(&(FluxContainerCreateInfo) {ctx, store, root});
+		xent_set_protocol(ctx, cards [c], XENT_PROTOCOL_FLEX);
+		xent_set_flex_direction(ctx, cards [c], XENT_FLEX_COLUMN);
+		xent_set_size(ctx, cards [c], (XentSize) {320.0f, 120.0f});
+		flux_node_store_set_layout_boundary(store, cards [c], true);
+		titles [c] = flux_create_text(&(FluxTextCreateInfo) {ctx, store, cards [c], "Title", 14.0f});
+		boxes [c]  = flux_create_textbox(&(FluxTextBoxCreateInfo) {ctx, store, cards [c], "Search", on_typed, NULL});
+	}
+
+	XentNodeId first = XENT_NODE_INVALID, last = XENT_NODE_INVALID;
+	for (int i = 0; i < PAGE_NODES; i++) {
+		last = flux_create_text(&(FluxTextCreateInfo) {ctx, store, root, "Row", 14.0f});
+		if (i == 0) first = last;
+	}
+	EXPECT(boxes [1] != XENT_NODE_INVALID && last != XENT_NODE_INVALID, "page creation");
+
+	FluxInput *input = flux_input_create(ctx, store);
+	EXPECT(input, "input creation");
+
+	float   w = 800.0f, h = 600.0f;
+	int64_t t0 = flux_perf_now();
+	EXPECT(flux_node_store_layout(store, root, w, h), "first frame lays out");
+	double     full_s = flux_perf_seconds(flux_perf_now() - t0);
+	XentNodeId watched [] = {cards [0], boxes [0], titles [0], cards [1], boxes [1], titles [1], first, last};
+	int        n          = ( int ) (sizeof(watched) / sizeof(watched [0]));
+	XentRect   rects [sizeof(watched) / sizeof(watched [0])];
+	for (int i = 0; i < n; i++) xent_get_layout_rect(ctx, watched [i], &rects [i]);
+	EXPECT(rects [3].y > 0.0f && rects [4].y > rects [3].y, "the second card and its box sit off the origin");
+
+	/* Typing into the box in the origin card: the box sits inside the card's
+	 * padding, so the card is relaid instead. Only focusing the box lays the
+	 * page out. */
+	uint32_t full     = flux_node_store_layout_count(store);
+	uint32_t partial  = flux_node_store_partial_layout_count(store);
+	double   typing_s = type_into(input, store, root, boxes [0], w, h);
+	uint32_t fulls    = flux_node_store_layout_count(store) - full;
+	uint32_t partials = flux_node_store_partial_layout_count(store) - partial;
+	EXPECT(typed_len == KEYSTROKES, "every keystroke reached the box");
+	EXPECT(!flux_node_store_layout_pending(store), "nothing pending after typing");
+	EXPECT(fulls == 1, "only the focus change lays the page out");
+	EXPECT(partials == KEYSTROKES, "every keystroke relays the card alone");
+	EXPECT(rects_kept(ctx, watched, rects, n), "typing kept every rect");
+
+	/* Below the origin neither the box nor its card can be relaid in place:
+	 * each keystroke is a full pass, and no boundary is laid out first. */
+	full     = flux_node_store_layout_count(store);
+	partial  = flux_node_store_partial_layout_count(store);
+	type_into(input, store, root, boxes [1], w, h);
+	fulls    = flux_node_store_layout_count(store) - full;
+	partials = flux_node_store_partial_layout_count(store) - partial;
+	EXPECT(fulls == KEYSTROKES + 1, "focus and every keystroke lay the page out");
+	EXPECT(partials == 0, "an offset boundary is never laid out alone");
+	EXPECT(rects_kept(ctx, watched, rects, n), "typing off the origin kept every rect");
+
+	/* The origin card still relays alone after the offset one was passed over. */
+	full    = flux_node_store_layout_count(store);
+	partial = flux_node_store_partial_layout_count(store);
+	flux_text_set_content(store, titles [0], "A much longer title than before");
+	EXPECT(!flux_node_store_layout(store, root, w, h), "card content runs no full pass");
+	EXPECT(flux_node_store_partial_layout_count(store) == partial + 1, "the card is laid out");
+	EXPECT(flux_node_store_layout_count(store) == full, "the page is not");
+	EXPECT(rect_eq(ctx, cards [1], rects [3]) && rect_eq(ctx, last, rects [7]), "the card kept its place in the page");
+
+	/* A queued boundary destroyed before the next layout is not laid out. */
+	flux_text_set_content(store, titles [0], "Queued");
+	EXPECT(flux_node_store_layout_pending(store), "the card is queued");
+	flux_subtree_destroy(store, cards [0]);
+	EXPECT(flux_node_store_layout(store, root, w, h), "destroying the card lays the page out");
+	EXPECT(flux_node_store_layout_count(store) == full + 1, "one full pass");
+	EXPECT(flux_node_store_partial_layout_count(store) == partial + 1, "the dead card was dropped from the queue");
+	EXPECT(!flux_node_store_layout_pending(store), "nothing pending after the pass");
+
+	/* Outside any boundary the whole page is laid out once. */
+	full = flux_node_store_layout_count(store);
+	flux_text_set_content(store, first, "A row that grew");
+	EXPECT(flux_node_store_layout(store, root, w, h), "page content lays the page out");
+	EXPECT(!flux_node_store_layout(store, root, w, h), "and only once");
+	EXPECT(flux_node_store_layout_count(store) == full + 1, "one full pass");
+
+	printf(
+	  "%d-node page: %.3f ms full layout, %.4f ms per keystroke frame\n", PAGE_NODES, full_s * 1000.0,
+	  typing_s * 1000.0 / KEYSTROKES
+	);
+	flux_input_destroy(input);
+	flux_node_store_destroy(store);
+	xent_destroy_context(ctx);
+	printf("PASS: partial layout\n");
+	return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file test_layout_skip.c
+ * @brief Headless test for skipping layout on frames that change nothing.
+ *
+ * A row of buttons is hovered across for many frames: only interaction state
+ * changes, so after the first frame no layout pass may run. A click, a text
+ * change, a new node and a resize each lay the tree out exactly once more.
+ * A size set straight through xent is only picked up once the app invalidates.
+ * Frames are driven the way the app drives them (layout through the store,
+ * then collect). No window or GPU.
+ */
+#include <fluxent/fluxent.h>
+#include <stdio.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define BUTTONS     4
+#define HOVER_MOVES 60
+
+static int  clicks;
+
+static void count_click(void *ctx) {
+	( void ) ctx;
+	clicks++;
+}
+
+static void frame(FluxEngine *eng, FluxInput *input, FluxNodeStore *store, XentNodeId root, float w, float h) {
+	flux_node_store_layout(store, root, w, h);
+	flux_engine_collect(eng, flux_node_store_context(store), root);
+	flux_input_set_hit_index(input, flux_engine_hit_index(eng));
+}
+
+static void pointer(FluxInput *input, XentNodeId root, FluxPointerEventKind kind, float x, float y) {
+	FluxPointerEvent ev = {.kind = kind, .device = FLUX_POINTER_MOUSE, .x = x, .y = y};
+	if (kind == FLUX_POINTER_DOWN || kind == FLUX_POINTER_UP) ev.changed_button = FLUX_POINTER_BUTTON_LEFT;
+	if (kind == FLUX_POINTER_DOWN) ev.buttons = FLUX_POINTER_BUTTON_LEFT;
+	flux_input_dispatch(input, root, &ev);
+}
+
+int main(void) {
+	XentConfig           config   = {0};
+	XentContext         *ctx      = xent_create_context(&config);
+	FluxNodeStore       *store    = flux_node_store_create(64);
+	FluxControlRegistry *registry = flux_control_registry_create();
+	EXPECT(ctx && store && registry, "context/store/registry creation");
+	flux_node_store_bind_context(store, ctx);
+	flux_register_builtins(registry);
+
+	XentNodeId root = xent_create_node(ctx);
+	xent_set_protocol(ctx, root, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, root, XENT_FLEX_COLUMN);
+
+	XentNodeId row = flux_create_card(&(FluxContainerCreateInfo) {ctx, store, root});
+	xent_set_protocol(ctx, row, XENT_PROTOCOL_FLEX);
+	xent_set_flex_direction(ctx, row, XENT_FLEX_ROW);
+	xent_set_size(ctx, row, (XentSize) {400.0f, 40.0f});
+	XentNodeId buttons [BUTTONS];
+	for (int i = 0; i < BUTTONS; i++) {
+		buttons [i] = flux_create_button(&(FluxButtonCreateInfo) {ctx, store, row, "Item", count_click, NULL});
+		xent_set_size(ctx, buttons [i], (XentSize) {100.0f, 40.0f});
+	}
+	XentNodeId caption = flux_create_text(&(FluxTextCreateInfo) {ctx, store, root, "Caption", 14.0f});
+
+	FluxEngine *eng   = flux_engine_create(store, registry);
+	FluxInput  *input = flux_input_create(ctx, store);
+	EXPECT(eng && input, "engine/input creation");
+
+	float w = 400.0f, h = 300.0f;
+	frame(eng, input, store, root, w, h);
+	EXPECT(flux_node_store_layout_count(store) == 1, "first frame lays out");
+	EXPECT(!flux_node_store_layout_pending(store), "nothing pending after layout");
+	frame(eng, input, store, root, w, h);
+	EXPECT(flux_node_store_layout_count(store) == 1, "idle frame reuses the layout");
+
+	/* Sweep the pointer back and forth over the row, one frame per move. */
+	uint32_t gen     = flux_node_store_layout_generation(store);
+	int      hovered = 0;
+	for (int m = 0; m < HOVER_MOVES; m++) {
+		int   step = m % 40;
+		float x    = 5.0f + ( float ) (step < 20 ? step : 40 - step) * 19.5f;
+		pointer(input, root, FLUX_POINTER_MOVE, x, 20.0f);
+		frame(eng, input, store, root, w, h);
+		for (int i = 0; i < BUTTONS; i++) hovered |= flux_input_get_hovered(input) == buttons [i] ? 1 << i : 0;
+	}
+	EXPECT(hovered == (1 << BUTTONS) - 1, "the sweep hovered every button");
+	pointer(input, root, FLUX_POINTER_MOVE, 200.0f, 250.0f);
+	frame(eng, input, store, root, w, h);
+	EXPECT(flux_input_get_hovered(input) != buttons [0], "hover left the row");
+	EXPECT(flux_node_store_layout_generation(store) == gen, "hover does not invalidate layout");
+	EXPECT(flux_node_store_layout_count(store) == 1, "no layout during the hover sweep");
+
+	/* A click reaches a handler that could restyle anything. */
+	pointer(input, root, FLUX_POINTER_MOVE, 150.0f, 20.0f);
+	pointer(input, root, FLUX_POINTER_DOWN, 150.0f, 20.0f);
+	pointer(input, root, FLUX_POINTER_UP, 150.0f, 20.0f);
+	EXPECT(clicks == 1, "click delivered");
+	EXPECT(flux_node_store_layout_pending(store), "click invalidates layout");
+	frame(eng, input, store, root, w, h);
+	frame(eng, input, store, root, w, h);
+	EXPECT(flux_node_store_layout_count(store) == 2, "click lays out once");
+
+	flux_text_set_content(store, caption, "A longer caption");
+	frame(eng, input, store, root, w, h);
+	frame(eng, input, store, root, w, h);
+	EXPECT(flux_node_store_layout_count(store) == 3, "text change lays out once");
+
+	flux_create_button(&(FluxButtonCreateInfo) {ctx, store, root, "New", count_click, NULL});
+	frame(eng, input, store, root, w, h);
+	frame(eng, input, store, root, w, h);
+	EXPECT(flux_node_store_layout_count(store) == 4, "new node lays out once");
+
+	w = 500.0f;
+	frame(eng, input, store, root, w, h);
+	frame(eng, input, store, root, w, h);
+	EXPECT(flux_node_store_layout_count(store) == 5, "resize lays out once");
+
+	/* xent does not report its own mutations: a direct xent_set_size keeps the
+	 * old layout until the app invalidates. */
+	XentRect rect;
+	xent_set_size(ctx, buttons [0], (XentSize) {60.0f, 40.0f});
+	EXPECT(!flux_node_store_layout_pending(store), "direct xent change is not seen");
+	frame(eng, input, store, root, w, h);
+	EXPECT(flux_node_store_layout_count(store) == 5, "no layout without invalidation");
+	EXPECT(xent_get_layout_rect(ctx, buttons [0], &rect) && rect.w == 100.0f, "stale width is kept");
+	flux_node_store_invalidate_layout(store);
+	frame(eng, input, store, root, w, h);
+	EXPECT(flux_node_store_layout_count(store) == 6, "invalidation lays out once");
+	EXPECT(xent_get_layout_rect(ctx, buttons [0], &rect) && rect.w == 60.0f, "new width after invalidation");
+
+	flux_input_destroy(input);
+	flux_engine_destroy(eng);
+	flux_control_registry_destroy(registry);
+	flux_node_store_destroy(store);
+	xent_destroy_context(ctx);
+	printf("PASS: layout skip\n");
+	return 0;
+}
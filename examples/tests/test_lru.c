@@ -0,0 +1,124 @@
+/**
+ * @file test_lru.c
+ * @brief Headless test and microbenchmark of the byte-budgeted LRU behind
+ * the text and image caches: full-key verification, LRU order under a byte
+ * budget, replacement, release accounting, and the hit/miss/eviction
+ * counters. Keys are text labels and values plain tokens, so no DirectWrite
+ * objects are created; the timed loops measure the index and recency list
+ * alone.
+ */
+#include "runtime/flux_lru.h"
+#include "runtime/flux_time.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define LABELS      10000
+#define WORKING_SET 2000
+#define PASSES      50
+#define ENTRY_COST  1000u
+
+static int released;
+
+static void count_release(void *value) {
+	( void ) value;
+	released++;
+}
+
+static char labels [LABELS][24];
+
+static FluxLruKey label_key(int i) {
+	return (FluxLruKey) {
+	  .data = {labels [i]},
+	  .len  = {( uint32_t ) strlen(labels [i])},
+	};
+}
+
+static void *token(int i) { return ( void * ) ( intptr_t ) (i + 1); }
+
+static void *get_label(FluxLru *c, int i) {
+	FluxLruKey key = label_key(i);
+	return flux_lru_get(c, &key);
+}
+
+static bool put_label(FluxLru *c, int i) {
+	FluxLruKey key = label_key(i);
+	return flux_lru_put(c, &key, token(i), ENTRY_COST);
+}
+
+int main(void) {
+	for (int i = 0; i < LABELS; i++) snprintf(labels [i], sizeof(labels [i]), "Item label %05d", i);
+
+	/* Part boundaries are part of the key. */
+	FluxLru   *c     = flux_lru_create(1u << 20, count_release);
+	FluxLruKey ab_c  = {.data = {"ab", "c"}, .len = {2, 1}};
+	FluxLruKey a_bc  = {.data = {"a", "bc"}, .len = {1, 2}};
+	EXPECT(c, "cache creation");
+	EXPECT(flux_lru_put(c, &ab_c, token(1), ENTRY_COST), "insert");
+	EXPECT(flux_lru_get(c, &ab_c) == token(1), "hit returns the value");
+	EXPECT(flux_lru_get(c, &a_bc) == NULL, "same bytes, different parts miss");
+
+	/* Replacing releases the old value and keeps one entry. */
+	EXPECT(flux_lru_put(c, &ab_c, token(2), ENTRY_COST), "replace");
+	EXPECT(released == 1 && flux_lru_get(c, &ab_c) == token(2), "replace releases the old value");
+	FluxLruStats st;
+	flux_lru_stats(c, &st);
+	EXPECT(st.entries == 1 && st.hits == 2 && st.misses == 1, "counters after replace");
+	flux_lru_destroy(c);
+	EXPECT(released == 2, "destroy releases what is left");
+
+	/* Budget for exactly 8 entries: touching the oldest saves it, the next insert evicts the second. */
+	released = 0;
+	c        = flux_lru_create(0, count_release);
+	EXPECT(put_label(c, 0), "first insert");
+	flux_lru_stats(c, &st);
+	size_t per_entry = st.bytes; /* fixed-width labels all cost the same */
+	EXPECT(st.entries == 1, "the newest entry survives a zero budget");
+	flux_lru_set_budget(c, per_entry * 8);
+	for (int i = 1; i < 8; i++) put_label(c, i);
+	get_label(c, 0);
+	put_label(c, 8);
+	EXPECT(get_label(c, 0) == token(0), "recently used entry kept");
+	EXPECT(get_label(c, 1) == NULL, "least recently used entry evicted");
+	flux_lru_stats(c, &st);
+	EXPECT(st.entries == 8 && st.evictions == 1 && released == 1, "one eviction");
+	EXPECT(st.bytes <= st.budget, "within budget");
+	flux_lru_set_budget(c, 0);
+	flux_lru_stats(c, &st);
+	EXPECT(st.entries == 0 && st.bytes == 0 && released == 9, "zero budget empties the cache");
+	flux_lru_destroy(c);
+
+	/* Microbenchmark: a working set that fits, then a sweep that thrashes. */
+	c = flux_lru_create(per_entry * WORKING_SET * 2, NULL);
+	for (int i = 0; i < WORKING_SET; i++) put_label(c, i);
+
+	int64_t start = flux_perf_now();
+	for (int p = 0; p < PASSES; p++)
+		for (int i = 0; i < WORKING_SET; i++)
+			EXPECT(get_label(c, i) == token(i), "working set hits");
+	double hit_ns = flux_perf_seconds(flux_perf_now() - start) * 1e9 / (( double ) PASSES * WORKING_SET);
+
+	start = flux_perf_now();
+	for (int i = 0; i < LABELS; i++)
+		if (!get_label(c, i)) put_label(c, i);
+	double sweep_ns = flux_perf_seconds(flux_perf_now() - start) * 1e9 / LABELS;
+
+	flux_lru_stats(c, &st);
+	EXPECT(st.hits == ( uint64_t ) PASSES * WORKING_SET + WORKING_SET, "every working-set lookup hit");
+	EXPECT(st.misses == LABELS - WORKING_SET, "sweep misses past the working set");
+	EXPECT(st.bytes <= st.budget && st.evictions == LABELS - 2 * WORKING_SET, "sweep evicts down to budget");
+	flux_lru_destroy(c);
+
+	printf("lru: %.1f ns/hit, %.1f ns/sweep step (lookup + insert + evict)\n", hit_ns, sweep_ns);
+	printf("PASS: lru\n");
+	return 0;
+}
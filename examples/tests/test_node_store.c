@@ -0,0 +1,98 @@
+/**
+ * @file test_node_store.c
+ * @brief Headless test for the node store's slab layout and handles.
+ *
+ * Node data pointers (and the xent userdata copies of them, bound as each
+ * node enters the store) must survive the store growing by tens of thousands
+ * of nodes, handles must go stale when their node is destroyed even if the
+ * slot is recycled, and lookups stay O(1). Also reports mount/lookup time
+ * for a reconciler-sized batch.
+ */
+#include <fluxent/fluxent.h>
+#include "runtime/flux_time.h"
+
+#include <stdio.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define EARLY_NODES 16
+#define BULK_NODES  50000
+
+int main(void) {
+	XentConfig     config = {0};
+	XentContext   *ctx    = xent_create_context(&config);
+	FluxNodeStore *store  = flux_node_store_create(64);
+	EXPECT(ctx && store, "context/store creation");
+	flux_node_store_bind_context(store, ctx);
+
+	XentNodeId root = xent_create_node(ctx);
+	EXPECT(flux_node_store_get_or_create(store, root), "root data");
+
+	XentNodeId    early [EARLY_NODES];
+	FluxNodeData *early_data [EARLY_NODES];
+	for (int i = 0; i < EARLY_NODES; i++) {
+		early [i] = xent_create_node(ctx);
+		xent_append_child(ctx, root, early [i]);
+		early_data [i] = flux_node_store_get_or_create(store, early [i]);
+		EXPECT(early_data [i], "early node data");
+	}
+
+	int64_t start = flux_perf_now();
+	for (int i = 0; i < BULK_NODES; i++) {
+		XentNodeId n = xent_create_node(ctx);
+		xent_append_child(ctx, root, n);
+		FluxNodeData *nd = flux_node_store_get_or_create(store, n);
+		EXPECT(nd && nd->node_id == n, "bulk node data");
+		EXPECT(xent_get_userdata(ctx, n) == nd, "userdata bound on insert");
+	}
+	double mount = flux_perf_seconds(flux_perf_now() - start);
+	EXPECT(flux_node_store_count(store) == 1 + EARLY_NODES + BULK_NODES, "every node counted");
+
+	for (int i = 0; i < EARLY_NODES; i++) {
+		EXPECT(flux_node_store_get(store, early [i]) == early_data [i], "data did not move while the store grew");
+		EXPECT(xent_get_userdata(ctx, early [i]) == early_data [i], "userdata attached before growth still valid");
+	}
+
+	start = flux_perf_now();
+	for (int i = 0; i < BULK_NODES; i++) EXPECT(flux_node_store_get(store, early [i % EARLY_NODES]), "lookup");
+	double lookup = flux_perf_seconds(flux_perf_now() - start);
+	printf("node store: %d mounts in %.3f ms, %d lookups in %.3f ms\n", BULK_NODES, mount * 1000.0, BULK_NODES,
+	  lookup * 1000.0);
+
+	FluxNodeHandle handle = flux_node_store_handle(store, early [3]);
+	EXPECT(handle.slot != FLUX_NODE_HANDLE_NO_SLOT, "handle to a live node");
+	EXPECT(flux_node_store_resolve(store, handle) == early_data [3], "handle resolves to the node's data");
+
+	uint32_t before = flux_node_store_count(store);
+	xent_destroy_node(ctx, early [3]);
+	EXPECT(flux_node_store_count(store) == before - 1, "destroyed node left the store");
+	EXPECT(!flux_node_store_get(store, early [3]), "destroyed node has no data");
+	EXPECT(!flux_node_store_resolve(store, handle), "handle to a destroyed node is stale");
+	EXPECT(!flux_node_store_resolve(store, flux_node_store_handle(store, early [3])), "null handle resolves to NULL");
+
+	/* The freed slot is recycled by the next insert; the old handle must not
+	 * resolve to its new occupant. */
+	XentNodeId    reuse = xent_create_node(ctx);
+	FluxNodeData *rd    = flux_node_store_get_or_create(store, reuse);
+	EXPECT(rd && rd->node_id == reuse, "new node after a removal");
+	EXPECT(xent_get_userdata(ctx, reuse) == rd, "recycled slot bound to its new node");
+	EXPECT(!flux_node_store_resolve(store, handle), "stale handle stays stale after slot reuse");
+	EXPECT(flux_node_store_resolve(store, flux_node_store_handle(store, reuse)) == rd, "fresh handle resolves");
+
+	for (int i = 0; i < EARLY_NODES; i++) {
+		if (i == 3) continue;
+		EXPECT(flux_node_store_get(store, early [i]) == early_data [i], "survivors keep their data");
+	}
+
+	flux_node_store_destroy(store);
+	xent_destroy_context(ctx);
+	printf("PASS: node store\n");
+	return 0;
+}
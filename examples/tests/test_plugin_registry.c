@@ -0,0 +1,103 @@
+/**
+ * @file test_plugin_registry.c
+ * @brief Headless test for the renderer plugin registry.
+ *
+ * Registers more plugins than the old fixed table held, under names longer
+ * than its keys, and checks that every name interns to its own dense id,
+ * that lookups by name and by id agree, that re-registering and
+ * unregistering keep ids stable and run destroy callbacks, and that
+ * flux_plugin_update_all times each plugin's update. No window or GPU.
+ */
+#include <fluxent/fluxent.h>
+#include "runtime/flux_time.h"
+
+#include <stdio.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define PLUGINS 40
+
+static int  updated [PLUGINS + 1];
+static int  destroyed [PLUGINS + 1];
+
+static void on_update(float dt, void *userdata) {
+	( void ) dt;
+	int i = ( int ) ( intptr_t ) userdata;
+	updated [i]++;
+	if (i == 1) { /* one slow plugin */
+		int64_t t0 = flux_perf_now();
+		while (flux_perf_seconds(flux_perf_now() - t0) < 0.002) {}
+	}
+}
+
+static void on_destroy(void *userdata) { destroyed [( int ) ( intptr_t ) userdata]++; }
+
+static FluxPlugin plugin_for(int i) {
+	return (FluxPlugin) {.update = on_update, .destroy = on_destroy, .userdata = ( void * ) ( intptr_t ) i};
+}
+
+/* Names share a long prefix, so a key cut to 31 bytes would collide. */
+static void plugin_name(char *buf, size_t size, int i) {
+	snprintf(buf, size, "com.example.visualizations.spectrum.%d", i);
+}
+
+int main(void) {
+	FluxPluginRegistry *reg = flux_plugin_registry_create();
+	EXPECT(reg, "registry creation");
+	EXPECT(flux_plugin_get(reg, "missing") == NULL, "empty registry");
+	EXPECT(flux_plugin_get_id(reg, FLUX_PLUGIN_INVALID) == NULL, "invalid id");
+
+	FluxPluginId ids [PLUGINS + 1];
+	char         name [64];
+	for (int i = 1; i <= PLUGINS; i++) {
+		plugin_name(name, sizeof(name), i);
+		ids [i] = flux_plugin_register(reg, name, plugin_for(i));
+		EXPECT(ids [i] == ( FluxPluginId ) i, "ids are dense in registration order");
+	}
+	EXPECT(flux_plugin_id_limit(reg) == PLUGINS + 1, "id limit");
+	for (int i = 1; i <= PLUGINS; i++) {
+		plugin_name(name, sizeof(name), i);
+		EXPECT(flux_plugin_find(reg, name) == ids [i], "name finds its id");
+		EXPECT(flux_plugin_get(reg, name) == flux_plugin_get_id(reg, ids [i]), "name and id agree");
+		EXPECT(flux_plugin_get_id(reg, ids [i])->userdata == ( void * ) ( intptr_t ) i, "plugin kept");
+	}
+	plugin_name(name, sizeof(name), 7);
+	FluxPluginId again = flux_plugin_register(reg, name, plugin_for(7));
+	EXPECT(again == ids [7] && destroyed [7] == 1, "re-registering replaces under the same id");
+
+	flux_plugin_update_all(reg, 1.0f / 60.0f);
+	flux_plugin_update_all(reg, 1.0f / 60.0f);
+	FluxPluginStats slow, fast;
+	EXPECT(flux_plugin_get_stats(reg, ids [1], &slow) && flux_plugin_get_stats(reg, ids [2], &fast), "stats");
+	EXPECT(updated [1] == 2 && updated [PLUGINS] == 2, "every plugin updated each frame");
+	EXPECT(slow.updates == 2 && fast.updates == 2, "updates counted");
+	EXPECT(slow.last_seconds >= 0.002 && slow.total_seconds >= 0.004, "slow plugin timed");
+	EXPECT(slow.max_seconds > fast.max_seconds, "time lands on the plugin that spent it");
+	flux_plugin_reset_stats(reg);
+	EXPECT(flux_plugin_get_stats(reg, ids [1], &slow) && slow.updates == 0, "stats reset");
+
+	plugin_name(name, sizeof(name), 3);
+	flux_plugin_unregister(reg, name);
+	EXPECT(destroyed [3] == 1 && flux_plugin_get(reg, name) == NULL, "unregister destroys");
+	EXPECT(flux_plugin_find(reg, name) == ids [3], "the name keeps its id");
+	EXPECT(!flux_plugin_get_stats(reg, ids [3], &slow), "no stats without a plugin");
+	flux_plugin_update_all(reg, 1.0f / 60.0f);
+	EXPECT(updated [3] == 2 && updated [4] == 3, "unregistered plugin no longer updated");
+	EXPECT(flux_plugin_register(reg, name, plugin_for(3)) == ids [3], "registering again reuses the id");
+	EXPECT(flux_plugin_name(reg, ids [3]) && flux_plugin_find(reg, flux_plugin_name(reg, ids [3])) == ids [3], "name");
+
+	flux_plugin_registry_destroy(reg);
+	for (int i = 1; i <= PLUGINS; i++) {
+		int want = i == 3 || i == 7 ? 2 : 1;
+		EXPECT(destroyed [i] == want, "registry destroy destroys each plugin once");
+	}
+	printf("PASS: plugin registry\n");
+	return 0;
+}
@@ -88,8 +88,8 @@ int main(void) {
 	XentNodeId btn = flux_create_button(&(FluxButtonCreateInfo) {ctx, store, root, volatile_label, NULL, NULL});
 	memset(volatile_label, 'X', sizeof(volatile_label) - 1);
 
-	FluxNodeData   *bnd = flux_node_store_get(store, btn);
-	FluxButtonData *bd  = bnd ? ( FluxButtonData * ) bnd->component_data : NULL;
+	FluxNodeData const   *bnd = flux_node_store_get(store, btn);
+	FluxButtonData const *bd  = bnd ? ( FluxButtonData const * ) bnd->component_data : NULL;
 	EXPECT(bd && bd->label && strcmp(bd->label, "Transient 42") == 0, "control owns a copy of its label");
 	flux_subtree_destroy(store, btn);
 
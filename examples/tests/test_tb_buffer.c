@@ -0,0 +1,196 @@
+/**
+ * @file test_tb_buffer.c
+ * @brief Headless test of the TextBox text storage. Random edits are checked
+ * against a plain reference string, in the gap buffer (syncing the flat
+ * mirror at random points) and in the piece table, and span/range reads are
+ * checked across the gap and across pieces. Then a 16 MB log paste, which
+ * moves to the piece table, is edited the way a user would (typing at the
+ * end, typing and deleting in the middle), with the drawn window rebuilt
+ * after every keystroke as a frame does, and the per-keystroke cost is printed.
+ */
+#include "controls/textbox/tb_internal.h"
+#include "runtime/flux_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EXPECT(cond, msg)              \
+	do {                               \
+		if (!(cond)) {                 \
+			printf("FAIL: %s\n", msg); \
+			return 1;                  \
+		}                              \
+	}                                  \
+	while (0)
+
+#define FUZZ_STEPS 20000
+#define FUZZ_MAX   4096
+#define LOG_BYTES  (16u << 20)
+#define KEYSTROKES 2000
+
+static char     ref [FUZZ_MAX + 64];
+static uint32_t ref_len;
+
+static int check_mirror(FluxTextBoxInputData *tb) {
+	char const *flat = tb_sync_content(tb);
+	EXPECT(tb->buf_len == ref_len, "length matches the reference");
+	EXPECT(memcmp(flat, ref, ref_len) == 0 && flat [ref_len] == '\0', "mirror matches the reference");
+	EXPECT(tb->base.content == flat, "content points at the mirror");
+	return 0;
+}
+
+static int check_spans(FluxTextBoxInputData const *tb, uint32_t from, uint32_t to) {
+	TbTextSpan span;
+	uint32_t   off = from;
+	while (tb_text_span(tb, off, to, &span)) {
+		EXPECT(memcmp(span.data, ref + off, span.len) == 0, "span bytes match");
+		off += span.len;
+	}
+	EXPECT(off == (to > from ? to : from), "spans cover the range");
+
+	char copy [FUZZ_MAX + 64];
+	EXPECT(tb_copy_range(tb, from, to, copy) == off - from, "copy length");
+	EXPECT(memcmp(copy, ref + from, off - from) == 0, "copied bytes match");
+	return 0;
+}
+
+static int fuzz_pieces(void) {
+	TbPieceTable *pt = tb_piece_create();
+	EXPECT(pt, "piece table");
+	ref_len = 0;
+	for (int step = 0; step < FUZZ_STEPS; step++) {
+		uint32_t pos = ref_len ? ( uint32_t ) rand() % (ref_len + 1) : 0;
+		if (rand() % 3 && ref_len + 8 < FUZZ_MAX) {
+			char     ins [8];
+			uint32_t n = 1 + ( uint32_t ) rand() % 7;
+			for (uint32_t i = 0; i < n; i++) ins [i] = ( char ) ('a' + rand() % 26);
+			EXPECT(tb_piece_insert(pt, pos, ins, n), "piece insert");
+			memmove(ref + pos + n, ref + pos, ref_len - pos);
+			memcpy(ref + pos, ins, n);
+			ref_len += n;
+		} else if (ref_len) {
+			uint32_t to = pos + 1 + ( uint32_t ) rand() % 9;
+			if (to > ref_len) to = ref_len;
+			if (pos == to) continue;
+			EXPECT(tb_piece_delete(pt, pos, to), "piece delete");
+			memmove(ref + pos, ref + to, ref_len - to);
+			ref_len -= to - pos;
+		}
+		EXPECT(tb_piece_length(pt) == ref_len, "piece length matches the reference");
+		if (step % 16 == 0) {
+			TbTextSpan span;
+			uint32_t   off = 0;
+			while (tb_piece_span(pt, off, ref_len, &span)) {
+				EXPECT(memcmp(span.data, ref + off, span.len) == 0, "piece bytes match");
+				off += span.len;
+			}
+			EXPECT(off == ref_len, "pieces cover the text");
+		}
+	}
+	tb_piece_destroy(pt);
+	return 0;
+}
+
+/* A keystroke, then what the next frame reads: the window around the caret. */
+static double keystrokes(FluxTextBoxInputData *tb, uint32_t pos, bool backspace) {
+	tb_view_anchor(tb, pos - TB_VIEW_BYTES / 2);
+	int64_t start = flux_perf_now();
+	for (int i = 0; i < KEYSTROKES; i++) {
+		if (backspace) {
+			tb_delete_range(tb, pos - 1, pos);
+			pos--;
+		} else {
+			tb_insert_utf8(tb, pos++, "x", 1);
+		}
+		tb_view_text(tb);
+	}
+	return flux_perf_seconds(flux_perf_now() - start) * 1e6 / KEYSTROKES;
+}
+
+static void free_text(FluxTextBoxInputData *tb) {
+	free(tb->buffer);
+	free(tb->flat_buffer);
+	free(tb->view_buffer);
+	tb_piece_destroy(tb->pieces);
+	tb_free_undo_redo(tb);
+}
+
+int main(void) {
+	FluxTextBoxInputData tb = {0};
+	srand(7);
+
+	/* Random edits, syncing about one step in four. */
+	for (int step = 0; step < FUZZ_STEPS; step++) {
+		uint32_t pos = ref_len ? ( uint32_t ) rand() % (ref_len + 1) : 0;
+		if (rand() % 3 && ref_len + 8 < FUZZ_MAX) {
+			char     ins [8];
+			uint32_t n = 1 + ( uint32_t ) rand() % 7;
+			for (uint32_t i = 0; i < n; i++) ins [i] = ( char ) ('a' + rand() % 26);
+			tb_insert_utf8(&tb, pos, ins, n);
+			memmove(ref + pos + n, ref + pos, ref_len - pos);
+			memcpy(ref + pos, ins, n);
+			ref_len += n;
+		} else if (ref_len) {
+			uint32_t to = pos + ( uint32_t ) rand() % 9;
+			if (to > ref_len) to = ref_len;
+			tb_delete_range(&tb, pos, to);
+			memmove(ref + pos, ref + to, ref_len - to);
+			ref_len -= to - pos;
+		}
+		if (rand() % 4 == 0 && check_mirror(&tb)) return 1;
+		if (step % 64 == 0) {
+			uint32_t a = ref_len ? ( uint32_t ) rand() % (ref_len + 1) : 0;
+			uint32_t b = ref_len ? ( uint32_t ) rand() % (ref_len + 1) : 0;
+			if (check_spans(&tb, a < b ? a : b, a < b ? b : a)) return 1;
+		}
+	}
+	if (check_mirror(&tb)) return 1;
+	EXPECT(tb_replace_text(&tb, "fresh") && strcmp(tb_sync_content(&tb), "fresh") == 0, "replace resets the mirror");
+	free_text(&tb);
+	if (fuzz_pieces()) return 1;
+
+	/* A pasted log moves to the piece table; each keystroke then costs a tree
+	 * edit plus copying the window the frame draws, not the text. */
+	char *log = ( char * ) malloc(LOG_BYTES);
+	EXPECT(log, "allocation");
+	for (uint32_t i = 0; i < LOG_BYTES; i++) log [i] = (i % 80 == 79) ? '\n' : ( char ) ('0' + i % 10);
+	tb = (FluxTextBoxInputData) {0};
+	tb_insert_utf8(&tb, 0, log, LOG_BYTES);
+	EXPECT(tb.buf_len == LOG_BYTES && tb.pieces && !tb.buffer, "paste moves to the piece table");
+
+	double at_end    = keystrokes(&tb, tb.buf_len, false);
+	double in_middle = keystrokes(&tb, LOG_BYTES / 2, false);
+	EXPECT(tb_piece_count(tb.pieces) <= 4, "typing grows one piece");
+	char const *view = tb_view_text(&tb);
+	EXPECT(tb.view_len <= TB_VIEW_BYTES && tb.view_from < LOG_BYTES / 2, "the window holds the caret");
+	EXPECT(view [LOG_BYTES / 2 - tb.view_from] == 'x', "the window shows the typed text");
+	double backspace = keystrokes(&tb, LOG_BYTES / 2 + KEYSTROKES, true);
+
+	/* An accent typed apart from its base letter still joins it across pieces. */
+	tb_insert_utf8(&tb, 1000, "e", 1);
+	tb_insert_utf8(&tb, 5000, "y", 1);
+	tb_insert_utf8(&tb, 1001, "\xcc\x81", 2);
+	EXPECT(tb_piece_count(tb.pieces) >= 5, "edits split the pieces");
+	EXPECT(tb_grapheme_next(&tb, 1000) == 1003 && tb_grapheme_prev(&tb, 1003) == 1000, "cluster across pieces");
+	tb_delete_range(&tb, 5002, 5003);
+	tb_delete_range(&tb, 1000, 1003);
+
+	char const *flat = tb_sync_content(&tb);
+	EXPECT(tb.buf_len == LOG_BYTES + KEYSTROKES, "typed text kept");
+	EXPECT(memcmp(flat, log, LOG_BYTES) == 0, "middle edits undone by backspace");
+	EXPECT(flat [LOG_BYTES] == 'x' && flat [tb.buf_len - 1] == 'x', "typing at the end");
+
+	tb_delete_range(&tb, 1000, tb.buf_len);
+	EXPECT(!tb.pieces && tb.buffer && tb.buf_len == 1000, "a short text moves back to the gap buffer");
+	EXPECT(memcmp(tb_sync_content(&tb), log, 1000) == 0, "text kept across the move");
+	free_text(&tb);
+	free(log);
+
+	printf(
+	  "16 MB text, per keystroke + window: %.2f us at end, %.2f us in the middle, %.2f us backspace\n", at_end, in_middle,
+	  backspace
+	);
+	printf("PASS: textbox buffer\n");
+	return 0;
+}
@@ -42,7 +42,7 @@ typedef struct FluxExpanderData {
 	bool           expanded;                               /**< Logical expanded state (chevron/corner). */
 	bool           anim_active;                            /**< A slide animation is in progress. */
 	bool           anim_expanding;                         /**< Direction of the active animation. */
-	DWORD          anim_start;                             /**< GetTickCount at animation start. */
+	DWORD          anim_start;                             /**< flux_anim_now at animation start. */
 
 	void           (*on_toggle)(void *ctx, bool expanded); /**< Invoked on expand/collapse. */
 	void          *on_toggle_ctx;
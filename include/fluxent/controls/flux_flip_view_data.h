@@ -47,6 +47,8 @@ typedef struct FluxFlipViewData {
 
 	float          extent;    /**< Viewport length along the paging axis (last layout). */
 	float          cross;     /**< Viewport length across it. */
+	float          placed_offset; /**< Slide offset the pages host was last placed at. */
+	uint32_t       placed_pages;  /**< Digest of the page nodes last placed (0 = never). */
 
 	unsigned long  pointer_activity; /**< Tick of the last pointer move (3 s button fade). */
 	unsigned long  last_wheel;       /**< Tick of the last wheel flip (200 ms gate). */
@@ -7,18 +7,22 @@
  *
  *   root (flex column; control type LIST / LIST_BOX / GRID_VIEW / ITEMS_REPEATER)
  *   └── FLUX_CONTROL_SCROLL (viewport; full scroll machinery)
- *       └── items host (ABSOLUTE protocol; height = rows × item_height)
+ *       └── items host (ABSOLUTE protocol; height = realized rows' span)
  *           └── FLUX_CONTROL_LIST_ITEM × realized window (recycled)
  *
- * Cells are uniform and virtualized by the xtk reconciler: only the window
- * intersecting the viewport exists as nodes. The engine watches the scroll
- * offset (and grid column count) each frame and fires on_stale when the
- * viewport leaves the realized window.
+ * Cells are virtualized by the xtk reconciler: only the window intersecting
+ * the viewport exists as nodes. Grid cells are uniform; list rows default to
+ * item_height but may report measured heights, which stack through a
+ * prefix-sum index (unmeasured rows take the measured average). The engine
+ * watches the scroll offset (and grid column count) each frame and fires
+ * on_stale when the viewport leaves the realized window.
  *
  * Selection (WinUI ListViewBase semantics): Single mode is app-controlled
  * (desc.selected in, on_select out). Multiple/Extended selection sets are
  * control-retained as sorted, merged index ranges — the control applies the
  * Ctrl/Shift/anchor state machine and posts the lead index on every change.
+ * Membership is a binary search over the runs and the selected count is
+ * maintained, so fragmented selections stay cheap for realized cells.
  */
 #ifndef FLUX_LIST_VIEW_DATA_H
 #define FLUX_LIST_VIEW_DATA_H
@@ -42,6 +46,25 @@ typedef struct FluxListSelRange {
 	int last;
 } FluxListSelRange;
 
+/**
+ * @brief Measured row heights of a single-column list.
+ *
+ * Two Fenwick trees over the rows (1-based) hold the sum and the number of
+ * measured heights, so a row's offset is offset(i) = measured sum before i +
+ * unmeasured rows before i × estimate, in O(log n) both ways, and refining the
+ * estimate costs nothing. Arrays stay NULL until the first measurement.
+ */
+typedef struct FluxListRowHeights {
+	float  *measured;       /**< Per-row height, or < 0 while unmeasured. */
+	double *sum_tree;       /**< Fenwick: sum of measured heights. */
+	int    *count_tree;     /**< Fenwick: number of measured rows. */
+	int     count;          /**< Rows covered. */
+	int     capacity;       /**< Allocated rows (arrays hold capacity + 1 tree slots). */
+	int     measured_count;
+	double  measured_total;
+	float   fallback;       /**< Estimate while nothing is measured (item_height). */
+} FluxListRowHeights;
+
 /** @brief Retained state for a virtualized items-host root. */
 typedef struct FluxListViewData {
 	XentContext   *ctx;
@@ -55,11 +78,13 @@ typedef struct FluxListViewData {
 	XtkListSelMode sel_mode;
 
 	int            count;          /**< Total item count. */
-	float          item_height;    /**< Uniform cell height in DIPs. */
+	float          item_height;    /**< Grid cell height; default list row height, in DIPs. */
 	float          item_width;     /**< Grid cell width; 0 = full-width rows. */
 	int            columns;        /**< Explicit grid columns; 0 = auto from width. */
 	int            cols;           /**< Realized column count (≥1; reconciler-reported). */
 
+	FluxListRowHeights heights;    /**< Measured list row heights (single column only). */
+
 	int            selected;       /**< Single mode: app-controlled selected index, or -1. */
 
 	int            realized_first; /**< First realized index (0 when empty). */
@@ -75,6 +100,7 @@ typedef struct FluxListViewData {
 	FluxListSelRange *ranges;      /**< Multiple/Extended selection set (owned). */
 	int               range_count;
 	int               range_cap;
+	int               range_total; /**< Selected items across all runs (kept in step with edits). */
 
 	void (*on_select)(void *ctx, int index); /**< Lead-index report after every selection change. */
 	void  *on_select_ctx;
@@ -19,7 +19,7 @@ typedef struct FluxNavTween {
 	float current;
 	float start;
 	float target;
-	DWORD start_ms; /**< GetTickCount at the last target change. */
+	DWORD start_ms; /**< flux_anim_now at the last target change. */
 	float duration; /**< ms. */
 	bool  active;
 	bool  lead;     /**< Indicator edge uses the fast (leading) spline this run. */
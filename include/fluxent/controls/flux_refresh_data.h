@@ -98,8 +98,8 @@ typedef struct FluxRefreshData {
 	bool              pull_tracking;          /**< A press is being tracked for over-pull. */
 
 	/* Animation clocks. */
-	DWORD             spin_start_tick;        /**< GetTickCount when Refreshing began. */
-	DWORD             pop_start_tick;         /**< GetTickCount when Pending pop began. */
+	DWORD             spin_start_tick;        /**< flux_anim_now when Refreshing began. */
+	DWORD             pop_start_tick;         /**< flux_anim_now when Pending pop began. */
 	bool              anim_registered;        /**< Registered with the shared anim driver. */
 
 	void            (*on_refresh)(void *ud, int direction); /**< Fired when a pull refresh starts. */
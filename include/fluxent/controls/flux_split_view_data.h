@@ -55,6 +55,9 @@ typedef struct FluxSplitViewData {
 	bool           pane_open;
 	float          open_len;     /**< OpenPaneLength (DIP). */
 	float          compact_len;  /**< CompactPaneLength (DIP). */
+	float          placed [5];   /**< Content x/w, pane x/w and height last applied by the sync. */
+	XentNodeId     placed_content;
+	XentNodeId     placed_pane;
 } FluxSplitViewData;
 
 /** @brief Retained state for a FLUX_CONTROL_SPLIT_VIEW_PANE wrapper. */
@@ -77,7 +77,7 @@ typedef struct FluxTabViewItem {
 	DWORD            slide_start; /**< Reorder slide start tick. */
 	bool             sliding;     /**< Reorder slide running. */
 	float            close_w0;    /**< Width at the moment close started. */
-	DWORD            close_start; /**< GetTickCount when the close animation began. */
+	DWORD            close_start; /**< flux_anim_now when the close animation began. */
 } FluxTabViewItem;
 
 /**
@@ -23,7 +23,7 @@ extern "C"
  * composition, and callbacks for text changes and submission.
  */
 typedef struct FluxTextBoxData {
-	char const    *content;                                   /**< Current text content (UTF-8) */
+	char const    *content;                                   /**< Text (UTF-8) as last materialized; see flux_textbox_get_content */
 	char const    *placeholder;                               /**< Placeholder text when empty */
 	char const    *font_family;                               /**< Font family (NULL = default) */
 	float          font_size;                                 /**< Font size in DIPs */
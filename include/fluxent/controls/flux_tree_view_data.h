@@ -14,11 +14,14 @@
  * The control owns the retained node pool and the flattened array
  * (@ref FluxTreeViewData.flat — a node is present iff every ancestor is
  * expanded; order is the pre-order DFS of the expanded tree, matching
- * ViewModel.cpp). The inner LIST spine supplies the scroll viewport, the
- * host extent (flat_count × row pitch), and the per-frame staleness watch
- * (flux_list_view_update_window fires on_stale when scrolling leaves the
- * realized window); the TreeView answers on_stale by re-realizing its own
- * recycled TREE_ITEM rows — reconciler involvement ends at the root element.
+ * ViewModel.cpp), kept current by splicing runs in and out rather than
+ * re-flattening, with a lazily re-mapped handle → flat index map
+ * (@ref FluxTreeViewData.flat_of). The inner LIST spine supplies the scroll
+ * viewport, the host extent (flat_count × row pitch), and the per-frame
+ * staleness watch (flux_list_view_update_window fires on_stale when
+ * scrolling leaves the realized window); the TreeView answers on_stale by
+ * re-realizing its own recycled TREE_ITEM rows — reconciler involvement ends
+ * at the root element.
  *
  * Selection follows WinUI TreeView semantics: Single is one retained node
  * handle; Multiple is the tri-state cascade (setting a node Selected /
@@ -82,6 +85,26 @@ enum
 	FLUX_TREE_SEL_PARTIAL  = 2, /**< PartialSelected (some descendants selected). */
 };
 
+/**
+ * @brief Child supply state (FluxTreeNode.load) for provider-backed nodes.
+ *
+ * In a tree with a provider, a node declared with
+ * flux_tree_view_set_has_children() shows a chevron before it has children
+ * (without one it stays a leaf); its first expand adds a "Loading..."
+ * placeholder child and calls FluxTreeViewCreateInfo.on_populate, which may
+ * fetch off the UI thread but adds the children on it
+ * (flux_tree_view_add_node, then flux_tree_view_finish_children).
+ * flux_tree_view_evict_collapsed() returns long-collapsed READY subtrees to
+ * UNLOADED.
+ */
+enum
+{
+	FLUX_TREE_LOAD_NONE     = 0, /**< Children are whatever was added (eager model). */
+	FLUX_TREE_LOAD_UNLOADED = 1, /**< Has children the provider has not supplied yet (or evicted). */
+	FLUX_TREE_LOAD_PENDING  = 2, /**< Provider asked; the placeholder child is showing. */
+	FLUX_TREE_LOAD_READY    = 3, /**< Supplied by the provider; evictable once collapsed. */
+};
+
 /** @brief FluxTreeItemSnapshot.flags bits. */
 enum
 {
@@ -92,11 +115,14 @@ enum
 };
 
 /**
- * @brief One retained tree node (pool-allocated; handles are pool indices).
+ * @brief One retained tree node (pool-allocated).
  *
- * Children form an intrusive singly-linked chain; free slots are chained
- * through @ref next_sibling. depth is maintained eagerly at insertion
- * (parent.depth + 1; roots are 0 — the hidden origin of WinUI is implicit).
+ * Links between nodes are pool indices; the handles the public API hands out
+ * also carry the slot's @ref generation, so a handle to a removed or evicted
+ * node is rejected instead of naming whatever reuses its slot. Children form
+ * an intrusive singly-linked chain; free slots are chained through
+ * @ref next_sibling. depth is maintained eagerly at insertion (parent.depth +
+ * 1; roots are 0 — the hidden origin of WinUI is implicit).
  */
 typedef struct FluxTreeNode {
 	int         parent;       /**< Parent handle, or -1 for roots. */
@@ -107,9 +133,13 @@ typedef struct FluxTreeNode {
 	uint32_t    glyph;        /**< Resolved Segoe Fluent Icons codepoint (0 = none). */
 	int16_t     depth;        /**< 0 for roots; rows indent 16px per level. */
 	uint8_t     sel_state;    /**< FLUX_TREE_SEL_* (Multiple mode tri-state). */
+	uint8_t     load;         /**< FLUX_TREE_LOAD_* (provider-backed children). */
 	bool        expanded;     /**< Descendants visible (default false, WinUI). */
 	bool        disabled;
 	bool        in_use;       /**< Slot is allocated (false = on the free list). */
+	bool        placeholder;  /**< The "Loading..." row of a pending parent. */
+	uint16_t    generation;   /**< Bumped each time the slot is freed (handle staleness). */
+	DWORD       collapsed_at; /**< flux_anim_now at the last collapse (eviction age). */
 } FluxTreeNode;
 
 /** @brief TreeView runtime, owned by the root FLUX_CONTROL_TREE_VIEW node. */
@@ -132,6 +162,8 @@ typedef struct FluxTreeViewData {
 	int           *flat;        /**< flat[i] = visible node handle (THE ViewModel; owned). */
 	int            flat_count;
 	int            flat_cap;
+	int           *flat_of;     /**< Handle → flat index (node_cap entries; owned); exact below map_valid. */
+	int            map_valid;   /**< Splices re-map lazily: rows from here on may have moved. */
 
 	XtkTreeSelMode sel_mode;
 	int            selected;    /**< Single mode: selected node handle, or -1. */
@@ -148,15 +180,24 @@ typedef struct FluxTreeViewData {
 	/* Expand entrance: new rows fade in + slide up (collapse is instant). */
 	int            anim_first;  /**< First entering flat index. */
 	int            anim_count;  /**< Entering row count (0 = idle). */
-	DWORD          anim_start;  /**< GetTickCount at expand. */
+	DWORD          anim_start;  /**< flux_anim_now at expand. */
 	bool           realize_pending; /**< Stale watch fired mid-paint; realize on the next tick. */
 
 	void           (*on_invoke)(void *ctx, int flat_index);
 	void           (*on_expand)(void *ctx, int flat_index, bool expanded);
 	void           (*on_select)(void *ctx, int flat_index, bool selected);
+	void           (*on_populate)(void *ctx, int node); /**< Supply an UNLOADED node's children. */
 	void          *userdata;
 } FluxTreeViewData;
 
+/**
+ * @brief Show a chevron: real children, or children a provider has yet to
+ * supply. An UNLOADED node of a tree without on_populate is a leaf.
+ */
+static inline bool flux_tree_node_has_children(FluxTreeViewData const *d, FluxTreeNode const *n) {
+	return n->first_child >= 0 || (n->load == FLUX_TREE_LOAD_UNLOADED && d->on_populate);
+}
+
 /** @brief Retained state for one recycled FLUX_CONTROL_TREE_ITEM row. */
 typedef struct FluxTreeItemData {
 	FluxTreeViewData *owner;             /**< Owning TreeView (never NULL after create). */
@@ -110,6 +110,15 @@ void flux_text_set_weight(FluxNodeStore *store, XentNodeId id, FluxFontWeight we
 /** @brief Set the text content (UTF-8). Replaces existing text. */
 void flux_textbox_set_content(FluxNodeStore *store, XentNodeId id, char const *content);
 
+/**
+ * @brief Current text (UTF-8) of a TextBox, PasswordBox or NumberBox.
+ *
+ * Drawing only materializes the visible part of a long text, so the
+ * FluxTextBoxData::content mirror can lag behind edits; this brings it up to
+ * date first. Valid until the next edit. NULL if @p id is not a text input.
+ */
+char const *flux_textbox_get_content(FluxNodeStore *store, XentNodeId id);
+
 /** @brief Set the placeholder text shown when empty. */
 void flux_textbox_set_placeholder(FluxNodeStore *store, XentNodeId id, char const *placeholder);
 
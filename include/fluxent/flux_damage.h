@@ -0,0 +1,79 @@
+/**
+ * @file flux_damage.h
+ * @brief Screen-space damage regions for partial redraw.
+ *
+ * A FluxDamageRegion is a small, bounded set of axis-aligned rectangles in
+ * DIPs describing which parts of the window changed since the previous frame.
+ * The engine produces one per collect by diffing the recorded draw commands;
+ * the app repaints only those rectangles and hands them to the swap chain as
+ * present dirty rects.
+ *
+ * The rectangle list is capped at @ref FLUX_DAMAGE_MAX_RECTS. When a new
+ * rectangle does not fit, it is merged into the existing rectangle whose
+ * union grows the least, so the region always over-approximates the change.
+ */
+#ifndef FLUX_DAMAGE_H
+#define FLUX_DAMAGE_H
+
+#include "flux_types.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Maximum number of disjoint rectangles kept before merging. */
+#define FLUX_DAMAGE_MAX_RECTS 8
+
+/** @brief Bounded set of damaged rectangles (DIPs). */
+typedef struct FluxDamageRegion {
+	FluxRect rects [FLUX_DAMAGE_MAX_RECTS]; /**< Damaged rectangles; only the first @ref count are valid. */
+	uint32_t count;                         /**< Number of valid rectangles. */
+	bool     full;                          /**< Whole target is damaged; @ref rects is ignored. */
+} FluxDamageRegion;
+
+/** @brief Reset @p region to empty. */
+void  flux_damage_clear(FluxDamageRegion *region);
+
+/** @brief Mark the whole target as damaged. */
+void  flux_damage_set_full(FluxDamageRegion *region);
+
+/** @brief True when nothing is damaged. */
+bool  flux_damage_is_empty(FluxDamageRegion const *region);
+
+/**
+ * @brief Add @p rect to @p region.
+ *
+ * Empty rects are ignored; rects overlapping an existing entry are merged into
+ * it. Once the region holds FLUX_DAMAGE_MAX_RECTS entries, further rects are
+ * merged into the entry whose bounding box grows the least.
+ */
+void  flux_damage_add(FluxDamageRegion *region, FluxRect rect);
+
+/** @brief Add every rectangle of @p src to @p dst (propagates @c full). */
+void  flux_damage_union(FluxDamageRegion *dst, FluxDamageRegion const *src);
+
+/** @brief True if @p rect overlaps any damaged rectangle (always true when full). */
+bool  flux_damage_intersects(FluxDamageRegion const *region, FluxRect const *rect);
+
+/** @brief Sum of rectangle areas in DIP² (overlaps counted once per rect). */
+float flux_damage_area(FluxDamageRegion const *region);
+
+/**
+ * @brief Clip @p region to @p bounds and snap every rectangle outward to the
+ *        device pixel grid.
+ *
+ * @param region Region to adjust in place.
+ * @param bounds Target extent in DIPs.
+ * @param scale  DIP-to-pixel scale (dpi / 96).
+ */
+void  flux_damage_snap(FluxDamageRegion *region, FluxRect bounds, float scale);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -14,6 +14,31 @@
  *    - Call `flux_engine_execute(eng, rc)` to render all controls
  * 3. Destroy with `flux_engine_destroy(eng)`
  *
+ * ## Partial Redraw
+ *
+ * Each collect also diffs its draw commands against the previous collect
+ * (content hash + screen rect per command) and exposes the changed area via
+ * `flux_engine_get_damage()`. `flux_engine_execute_region()` then repaints
+ * only those rectangles. The first collect, and the first after
+ * `flux_engine_invalidate()`, reports full damage.
+ *
+ * ## Hit Testing
+ *
+ * Each collect also buckets its draws into a grid by screen rectangle
+ * (`flux_engine_hit_index()`), so pointer input resolves against what was
+ * last drawn without walking the layout tree.
+ *
+ * ## Retained Commands
+ *
+ * Collect keeps the previous frame's commands and, for each subtree, the
+ * range it emitted. A subtree whose root generation (FluxNodeData.generation)
+ * is unchanged and whose layout, structure and control state still match is
+ * copied over as-is, skipping its snapshots and sync hooks. Write node data
+ * through flux_node_store_edit() or call flux_node_store_touch() afterwards so
+ * the change is picked up; flux_node_store_get() is a plain read. Controls
+ * whose snapshot reads shared owner state (list/tree/nav items, tabs, text
+ * boxes) are always rebuilt.
+ *
  * ## Threading
  *
  * - Collection must happen on the main thread (accesses layout data)
@@ -23,7 +48,9 @@
  * ## Custom Renderers
  *
  * Use `flux_control_registry_register()` to bind custom draw functions to
- * control types. The engine dispatches through the registry during execution.
+ * control types. The engine dispatches through the registry during execution,
+ * and consults it during collection to decide which nodes need an overlay
+ * pass, so register renderers before the first collect.
  */
 #ifndef FLUX_ENGINE_H
 #define FLUX_ENGINE_H
@@ -31,6 +58,7 @@
 #include "flux_render_snapshot.h"
 #include "flux_node_store.h"
 #include "flux_control_registry.h"
+#include "flux_damage.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -39,6 +67,7 @@ extern "C"
 
 typedef struct FluxRenderContext FluxRenderContext;
 typedef struct FluxEngine        FluxEngine;
+typedef struct FluxHitIndex      FluxHitIndex;
 
 /**
  * @brief Simplified control state for rendering.
@@ -58,7 +87,9 @@ typedef struct FluxControlState {
  * @brief Render phase for layered drawing.
  *
  * Main phase draws backgrounds, content. Overlay phase draws decorations
- * that must appear on top (scrollbars, selection handles, etc.).
+ * that must appear on top (scrollbars, selection handles, etc.). Overlay
+ * commands are only collected for types whose registry entry has a
+ * @c draw_overlay callback.
  */
 typedef enum FluxCommandPhase
 {
@@ -78,27 +109,46 @@ typedef enum FluxClipAction
 	FLUX_CLIP_POP_TRANSFORM,  /**< Pop the transform + opacity layer (+ optional subtree clip) */
 } FluxClipAction;
 
+/** @brief Parameters of a FLUX_CLIP_PUSH command. */
+typedef struct FluxClipParams {
+	float scroll_x; /**< Horizontal scroll offset applied to the children */
+	float scroll_y; /**< Vertical scroll offset applied to the children */
+} FluxClipParams;
+
+/** @brief Parameters of a FLUX_CLIP_PUSH_TRANSFORM command. */
+typedef struct FluxTransformParams {
+	float scale;        /**< Subtree scale (1 = none) */
+	float pivot_x;      /**< Scale pivot X (absolute) */
+	float pivot_y;      /**< Scale pivot Y (absolute) */
+	float opacity;      /**< Subtree opacity (1 = opaque) */
+	float translate_x;  /**< Subtree X translate (0 = none) */
+	float translate_y;  /**< Subtree Y translate (0 = none) */
+	bool  clip_subtree; /**< Clip the subtree to the command bounds (slide animations) */
+} FluxTransformParams;
+
+/** @brief Payload offset of commands that carry no snapshot. */
+#define FLUX_RENDER_NO_PAYLOAD UINT32_MAX
+
 /**
  * @brief A single render command in the command list.
  *
- * Contains everything needed to render one control: its snapshot,
- * computed bounds, interaction state, and clipping information.
+ * A small fixed-size header. Clip and transform ops keep their parameters
+ * inline; draw commands reference their snapshot in a per-frame side arena
+ * that stores only the bytes the control type uses (base + its union arm,
+ * see flux_snapshot_payload_size()). A node's overlay command shares the
+ * payload of its main command. Use flux_engine_command_snapshot() to decode.
  */
 typedef struct FluxRenderCommand {
-	FluxRenderSnapshot snapshot;     /**< Control-specific render data */
-	FluxRect           bounds;       /**< Layout-computed bounding rect */
-	FluxControlState   state;        /**< Interaction state at collection time */
-	FluxCommandPhase   phase;        /**< Which pass to render in */
-	FluxClipAction     clip_action;  /**< Clip stack operation */
-	float              scroll_x;     /**< Horizontal scroll offset */
-	float              scroll_y;     /**< Vertical scroll offset */
-	float              scale;        /**< Subtree scale for FLUX_CLIP_PUSH_TRANSFORM (1 = none) */
-	float              pivot_x;      /**< Scale pivot X (absolute) */
-	float              pivot_y;      /**< Scale pivot Y (absolute) */
-	float              opacity;      /**< Subtree opacity for FLUX_CLIP_PUSH_TRANSFORM (1 = opaque) */
-	float              translate_x;  /**< Subtree X translate for FLUX_CLIP_PUSH_TRANSFORM (0 = none) */
-	float              translate_y;  /**< Subtree Y translate for FLUX_CLIP_PUSH_TRANSFORM (0 = none) */
-	bool               clip_subtree; /**< Clip the subtree to @ref bounds (slide animations) */
+	FluxRect         bounds;      /**< Layout-computed bounding rect */
+	FluxControlState state;       /**< Interaction state at collection time */
+	uint8_t          phase;       /**< FluxCommandPhase: which pass to render in */
+	uint8_t          clip_action; /**< FluxClipAction: clip stack operation */
+	uint32_t         payload;     /**< Arena offset of the snapshot, or FLUX_RENDER_NO_PAYLOAD */
+
+	union {
+		FluxClipParams      clip;      /**< FLUX_CLIP_PUSH */
+		FluxTransformParams transform; /**< FLUX_CLIP_PUSH_TRANSFORM */
+	} op;
 } FluxRenderCommand;
 
 /**
@@ -141,6 +191,48 @@ uint32_t                 flux_engine_command_count(FluxEngine const *eng);
  */
 FluxRenderCommand const *flux_engine_command_at(FluxEngine const *eng, uint32_t index);
 
+/**
+ * @brief Decode the snapshot of a draw command.
+ * @param eng Engine instance.
+ * @param index Command index (0 to count-1).
+ * @param out Receives the full snapshot (unused union bytes zeroed).
+ * @return false if out of range or the command carries no snapshot.
+ */
+bool                     flux_engine_command_snapshot(FluxEngine const *eng, uint32_t index, FluxRenderSnapshot *out);
+
+/**
+ * @brief Bytes produced by the last collect: command headers plus snapshot payloads.
+ * @param eng Engine instance.
+ * @return Byte count (0 for NULL).
+ */
+size_t                   flux_engine_frame_bytes(FluxEngine const *eng);
+
+/** @brief Per-collect counters, reset by every flux_engine_collect(). */
+typedef struct FluxEngineStats {
+	uint32_t commands;        /**< Commands in the stream. */
+	uint32_t reused_commands; /**< Commands copied from the previous collect. */
+	uint32_t snapshots_built; /**< Nodes whose snapshot was rebuilt. */
+} FluxEngineStats;
+
+/**
+ * @brief Get the counters of the most recent collect.
+ * @param eng Engine instance (NULL reports zeros).
+ * @param out Receives the counters.
+ */
+void                     flux_engine_get_stats(FluxEngine const *eng, FluxEngineStats *out);
+
+/**
+ * @brief Screen-space hit index over the last collect's draws.
+ *
+ * Rebuilt by every flux_engine_collect() with scroll offsets and ancestor
+ * clips resolved; hand it to flux_input_set_hit_index() so pointer hit tests
+ * are answered from it instead of walking the layout tree.
+ *
+ * @param eng Engine instance.
+ * @return Index owned by the engine, or NULL for a NULL engine.
+ */
+FluxHitIndex const      *flux_engine_hit_index(FluxEngine const *eng);
+
 /**
  * @brief Execute all collected render commands.
  *
@@ -152,6 +244,44 @@ FluxRenderCommand const *flux_engine_command_at(FluxEngine const *eng, uint32_t
  */
 void                     flux_engine_execute(FluxEngine const *eng, FluxRenderContext const *rc);
 
+/**
+ * @brief Repaint only the damaged part of the target.
+ *
+ * For each rectangle of @p region: clips to it, clears it to @p clear, and
+ * executes the commands whose screen rect overlaps it. A full region clears
+ * and executes everything. Must be called between flux_graphics_begin_draw()
+ * and flux_graphics_end_draw(), with the target holding the previous frame
+ * outside @p region.
+ *
+ * @param eng Engine instance.
+ * @param rc Render context with D2D resources.
+ * @param region Area to repaint, in DIPs (typically pixel-snapped).
+ * @param clear Background color painted under the repainted commands.
+ */
+void                     flux_engine_execute_region(
+  FluxEngine const *eng, FluxRenderContext const *rc, FluxDamageRegion const *region, FluxColor clear
+);
+
+/**
+ * @brief Get the screen area changed by the most recent collect.
+ *
+ * Covers commands that appeared, disappeared, moved, or changed content, plus
+ * commands whose renderer requested another animation frame when last
+ * executed.
+ *
+ * @param eng Engine instance (NULL reports full damage).
+ * @param out Receives the damaged region in DIPs.
+ */
+void                     flux_engine_get_damage(FluxEngine const *eng, FluxDamageRegion *out);
+
+/**
+ * @brief Force the next collect to report full damage and rebuild every command.
+ *
+ * Call when something the content hashes cannot see changes every pixel
+ * (theme palette, DPI, lost back buffer).
+ */
+void                     flux_engine_invalidate(FluxEngine *eng);
+
 /**
  * @brief Dispatch to the registered renderer for a control type.
  *
@@ -0,0 +1,118 @@
+/**
+ * @file flux_frame_stats.h
+ * @brief Per-frame timing ring for diagnosing slow frames.
+ *
+ * A FluxFrameStats keeps the most recent frames, each with the time spent in
+ * every phase of the frame loop (update, DirectManipulation tick, layout,
+ * scroll sync, collect, execute, present or composition) and the frame's
+ * work counters: commands
+ * and how many were reused, snapshot bytes, layout passes and text cache
+ * hits. The app records into one only while recording is switched on (see
+ * flux_app_set_frame_stats_enabled); the ring can be read back frame by frame
+ * or written out as a Chrome trace (chrome://tracing, Perfetto).
+ *
+ * Times are QueryPerformanceCounter ticks (see flux_time.h).
+ */
+#ifndef FLUX_FRAME_STATS_H
+#define FLUX_FRAME_STATS_H
+
+#include "flux_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Frames kept by an app's ring. */
+#define FLUX_FRAME_STATS_DEFAULT_CAPACITY 600
+
+/** @brief Phases of the frame loop, in frame order. */
+typedef enum FluxFramePhase {
+	FLUX_FRAME_PHASE_UPDATE,      /**< Frame callback: xtk message pump and reconcile. */
+	FLUX_FRAME_PHASE_DMANIP_TICK, /**< DirectManipulation tick (before layout). */
+	FLUX_FRAME_PHASE_LAYOUT,      /**< Layout (skipped or partial passes included). */
+	FLUX_FRAME_PHASE_DMANIP_SYNC, /**< Scroll-tree sync with DirectManipulation (after layout). */
+	FLUX_FRAME_PHASE_COLLECT,     /**< Command collection and hit index. */
+	FLUX_FRAME_PHASE_EXECUTE,     /**< Drawing the damaged region. */
+	FLUX_FRAME_PHASE_PRESENT,     /**< Swap chain present. */
+	FLUX_FRAME_PHASE_COMPOSE,     /**< Composition backend frame (instead of collect to present). */
+	FLUX_FRAME_PHASE_COUNT
+} FluxFramePhase;
+
+/** @brief One recorded frame. */
+typedef struct FluxFrameRecord {
+	uint64_t frame;                                /**< Sequence number, from 0 when the ring was created. */
+	int64_t  start;                                /**< Tick the frame began at. */
+	int64_t  duration;                             /**< Ticks from start to the end of the frame. */
+	int64_t  phase_start [FLUX_FRAME_PHASE_COUNT]; /**< Tick each phase began at. */
+	int64_t  phase_ticks [FLUX_FRAME_PHASE_COUNT]; /**< Ticks spent in each phase. */
+	uint32_t phase_mask;                           /**< Bit per phase that ran this frame. */
+	uint32_t commands;                             /**< Commands collected. */
+	uint32_t reused_commands;                      /**< Of those, copied from the previous frame. */
+	uint32_t snapshots_built;                      /**< Nodes whose snapshot was rebuilt. */
+	size_t   snapshot_bytes;                       /**< Command headers plus snapshot payloads. */
+	uint32_t layout_passes;                        /**< Full layout passes (0 or 1). */
+	uint32_t partial_layouts;                      /**< Layout-boundary subtrees laid out on their own. */
+	uint32_t text_hits;                            /**< Text layout/format cache hits. */
+	uint32_t text_misses;                          /**< Text layout/format cache misses. */
+	bool     presented;                            /**< Something was drawn and presented. */
+} FluxFrameRecord;
+
+typedef struct FluxFrameStats FluxFrameStats;
+
+/** @brief Create a ring that keeps the last @p capacity frames (0 picks the default). */
+XENT_NODISCARD FluxFrameStats *flux_frame_stats_create(uint32_t capacity);
+
+/** @brief Destroy a ring (NULL is safe). */
+void                           flux_frame_stats_destroy(FluxFrameStats *stats);
+
+/**
+ * @brief Open a record for a frame starting at @p now, overwriting the oldest once full.
+ * @return The open record to fill in; it joins the ring at flux_frame_stats_end.
+ */
+FluxFrameRecord               *flux_frame_stats_begin(FluxFrameStats *stats, int64_t now);
+
+/**
+ * @brief Add the span [@p begin, @p end] to @p phase of an open record (NULL is safe).
+ *
+ * Spans of one phase are summed and traced as a single event from the first
+ * span's start, so each phase should be one stretch of the frame; work on
+ * both sides of another phase gets a phase of its own.
+ */
+void flux_frame_stats_phase(FluxFrameRecord *record, FluxFramePhase phase, int64_t begin, int64_t end);
+
+/** @brief Close the open record at @p now. */
+void flux_frame_stats_end(FluxFrameStats *stats, int64_t now);
+
+/** @brief Number of closed frames held (at most the capacity). */
+uint32_t               flux_frame_stats_count(FluxFrameStats const *stats);
+
+/** @brief A closed frame: @p age 0 is the newest. NULL when @p age >= count. */
+FluxFrameRecord const *flux_frame_stats_get(FluxFrameStats const *stats, uint32_t age);
+
+/** @brief Drop every recorded frame (sequence numbers keep counting). */
+void                   flux_frame_stats_clear(FluxFrameStats *stats);
+
+/** @brief Name of a phase as it appears in traces ("layout", ...). */
+char const            *flux_frame_phase_name(FluxFramePhase phase);
+
+/**
+ * @brief Write the held frames to @p path as Chrome trace JSON.
+ *
+ * Each frame is a complete event with its counters as arguments, and each
+ * phase that ran a nested event; commands and snapshot bytes are also
+ * emitted as counter tracks.
+ *
+ * @return false if the file could not be written.
+ */
+bool                   flux_frame_stats_write_trace(FluxFrameStats const *stats, char const *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -41,6 +41,7 @@
 #define FLUX_GRAPHICS_H
 
 #include "flux_types.h"
+#include "flux_damage.h"
 
 #include <stdbool.h>
 
@@ -162,6 +163,33 @@ void                               flux_graphics_end_draw(FluxGraphics *gfx);
  */
 void                               flux_graphics_present(FluxGraphics *gfx, bool vsync);
 
+/**
+ * @brief Present only the damaged part of the frame.
+ *
+ * Passes @p region to DXGI as dirty rects (converted to pixels), so DWM only
+ * recomposes what changed. A full or NULL region behaves like
+ * flux_graphics_present(). Only valid when every pixel outside @p region
+ * matches the previously presented frame; see flux_graphics_buffer_age().
+ *
+ * @param gfx Graphics context.
+ * @param vsync true to wait for vertical blank, false for immediate.
+ * @param region Damaged area in DIPs.
+ */
+void     flux_graphics_present_region(FluxGraphics *gfx, bool vsync, FluxDamageRegion const *region);
+
+/**
+ * @brief Age of the back buffer about to be drawn, in frames.
+ *
+ * 0 means its contents are undefined (first frames, after a resize, DPI or
+ * device change, or a discard swap effect) and the frame must be redrawn in
+ * full. Otherwise the buffer holds the frame presented that many presents
+ * ago, so a partial redraw must cover the damage of every frame since.
+ *
+ * @param gfx Graphics context.
+ * @return Back-buffer age, or 0 when undefined.
+ */
+uint32_t flux_graphics_buffer_age(FluxGraphics const *gfx);
+
 /**
  * @brief Clear the render target to a solid color.
  * @param gfx Graphics context.
@@ -24,17 +24,28 @@ extern "C"
 typedef struct FluxHitResult {
 	XentNodeId    node;   /**< The hit node ID. */
 	FluxNodeData *data;   /**< Pointer to node data. */
-	FluxRect      bounds; /**< Node bounds in parent coords. */
-	FluxPoint     local;  /**< Hit point in node-local coords. */
+	FluxRect      bounds; /**< Node bounds as drawn (scrolls and render transforms applied). */
+	FluxPoint     local;  /**< Hit point in node-local layout coords (render scale divided out). */
 } FluxHitResult;
 
-typedef struct FluxInput FluxInput;
+typedef struct FluxInput    FluxInput;
+typedef struct FluxHitIndex FluxHitIndex;
 
 /** @brief Create an input router for a layout context and node store. */
 XENT_NODISCARD FluxInput *flux_input_create(XentContext *ctx, FluxNodeStore *store);
 /** @brief Destroy an input router. */
 void                     flux_input_destroy(FluxInput *input);
 
+/**
+ * @brief Answer hit tests from an engine's hit index (see flux_engine_hit_index()).
+ *
+ * Call after each flux_engine_collect(). Queries for the collected root are
+ * then resolved against the last drawn frame without walking the tree; other
+ * roots, and every query after a node is destroyed until the next call, fall
+ * back to the tree walk. NULL detaches the index.
+ */
+void                     flux_input_set_hit_index(FluxInput *input, FluxHitIndex const *index);
+
 /** @brief Hit-test a point in root-local DIPs. */
 FluxHitResult            flux_input_hit_test(FluxInput *input, XentNodeId root, float px, float py);
 
@@ -138,21 +138,18 @@ typedef struct FluxNodeBehavior {
  * @brief Complete metadata for a single UI node.
  *
  * Combines visual properties, interaction state, event handlers, and
- * control-specific data into one structure stored in FluxNodeStore.
+ * control-specific data for one node stored in FluxNodeStore. Fields read
+ * by every collect and hit-test come first; the event callbacks, which only
+ * input dispatch reads, live in a separate column of the store and are
+ * reached through @ref behavior, so walking the tree never pulls them into
+ * cache.
  */
 typedef struct FluxNodeData {
-	XentNodeId       node_id;        /**< Associated layout node ID */
-	FluxNodeVisuals  visuals;        /**< Appearance properties */
-	FluxNodeState    state;          /**< Interaction flags */
-	FluxNodeBehavior behavior;       /**< Event callbacks (embedded) */
-	FluxControlType  component_type; /**< Control type expected for component_data casts. */
-	void            *component_data; /**< Control-specific data; borrowed unless destroy_component_data is set. */
-	void             (*destroy_component_data)(void *component_data); /**< Optional owned component data destructor. */
-
-	float            hover_local_x; /**< Sub-element hover X in node-local coordinates. */
-	float            hover_local_y; /**< Sub-element hover Y in node-local coordinates. */
-
-	char const      *tooltip_text;  /**< Owned tooltip text copy, or NULL when unset. */
+	XentNodeId        node_id;        /**< Associated layout node ID */
+	FluxControlType   component_type; /**< Control type expected for component_data casts. */
+	void             *component_data; /**< Control-specific data; borrowed unless destroy_component_data is set. */
+	FluxNodeVisuals   visuals;        /**< Appearance properties */
+	FluxNodeState     state;          /**< Interaction flags */
 
 	/**
 	 * Transient render transform applied to this node's subtree (entrance/exit
@@ -161,20 +158,56 @@ typedef struct FluxNodeData {
 	 * differs from 1.0 (or render_translate_y is non-zero), so untouched nodes
 	 * incur no cost.
 	 */
-	float            render_scale;
-	float            render_opacity;
-	float            render_translate_x;  /**< Subtree X translate in px (0 = none); for drag visuals. */
-	float            render_translate_y;  /**< Subtree Y translate in px (0 = none); for slide animations. */
-	bool             render_clip_subtree; /**< Clip the subtree to this node's layout rect while transformed. */
-	bool             clips_children;      /**< Clip children to this node's rect (e.g. NavView's off-screen
-	                                       * Minimal pane), independent of any render transform. */
+	float             render_scale;
+	float             render_opacity;
+	float             render_translate_x;  /**< Subtree X translate in px (0 = none); for drag visuals. */
+	float             render_translate_y;  /**< Subtree Y translate in px (0 = none); for slide animations. */
+	bool              render_clip_subtree; /**< Clip the subtree to this node's layout rect while transformed. */
+	bool              clips_children;      /**< Clip children to this node's rect (e.g. NavView's off-screen
+	                                        * Minimal pane), independent of any render transform. */
+	bool              layout_boundary;     /**< Extent is pinned by the node's own size, so a change inside its
+	                                        * subtree is relaid from here (flux_node_store_invalidate_node_layout). */
+
+	/**
+	 * Subtree generation: restamped with a fresh store-wide value whenever this
+	 * node or any descendant is handed out for writing (see
+	 * flux_node_store_touch). The engine reuses a subtree's commands from the
+	 * previous frame while this is unchanged.
+	 */
+	uint32_t          generation;
+
+	float             hover_local_x; /**< Sub-element hover X in node-local coordinates. */
+	float             hover_local_y; /**< Sub-element hover Y in node-local coordinates. */
+	char const       *tooltip_text;  /**< Owned tooltip text copy, or NULL when unset. */
+
+	void              (*destroy_component_data)(void *component_data); /**< Optional owned component data destructor. */
+	FluxNodeBehavior *behavior; /**< Event callbacks in the store's cold column; never NULL, owned by the store. */
 } FluxNodeData;
 
 typedef struct FluxNodeStore FluxNodeStore;
 
+/**
+ * @brief Generational reference to a node's store slot.
+ *
+ * Unlike a raw FluxNodeData pointer, a handle notices when its node has been
+ * removed: once the slot is recycled for another node, flux_node_store_resolve
+ * returns NULL for it.
+ */
+typedef struct FluxNodeHandle {
+	uint32_t slot;       /**< Slot index, FLUX_NODE_HANDLE_NO_SLOT for a null handle. */
+	uint32_t generation; /**< Slot generation the handle was taken at. */
+} FluxNodeHandle;
+
+/** @brief Slot value of a handle that refers to nothing. */
+#define FLUX_NODE_HANDLE_NO_SLOT UINT32_MAX
+
 /**
  * @brief Create a new node store with the specified initial capacity.
- * @param initial_capacity Initial hash table capacity (will grow as needed).
+ *
+ * Node data is allocated in fixed-size chunks that never move, so pointers
+ * returned by the store stay valid until their node is removed.
+ *
+ * @param initial_capacity Nodes to reserve up front (will grow as needed).
  * @return New store, or NULL on allocation failure.
  */
 XENT_NODISCARD FluxNodeStore *flux_node_store_create(uint32_t initial_capacity);
@@ -184,7 +217,8 @@ XENT_NODISCARD FluxNodeStore *flux_node_store_create(uint32_t initial_capacity);
  *
  * Lets store-only APIs (e.g. flux_*_set_enabled) reach context-scoped node
  * properties such as semantic enabled. Set once, at scene creation, before the
- * tree is built. Safe to call again (idempotent).
+ * tree is built. Safe to call again (idempotent). From then on each node's
+ * data is attached as its xent userdata when the node enters the store.
  */
 void                         flux_node_store_bind_context(FluxNodeStore *store, XentContext *ctx);
 
@@ -199,20 +233,66 @@ void                         flux_node_store_destroy(FluxNodeStore *store);
 
 /**
  * @brief Look up node data by ID.
+ *
+ * A plain read: nothing is touched, so the data is handed back const. Use
+ * flux_node_store_edit to change it, which marks the node modified.
+ *
+ * @param store Store to search.
+ * @param id Node ID to find.
+ * @return Pointer to FluxNodeData, or NULL if not found.
+ */
+FluxNodeData const          *flux_node_store_get(FluxNodeStore const *store, XentNodeId id);
+
+/**
+ * @brief Look up node data by ID for writing.
+ *
+ * Like flux_node_store_get, but the lookup counts as a modification: the
+ * node and its ancestors are touched (see flux_node_store_touch).
+ *
  * @param store Store to search.
  * @param id Node ID to find.
  * @return Pointer to FluxNodeData, or NULL if not found.
  */
-FluxNodeData                *flux_node_store_get(FluxNodeStore *store, XentNodeId id);
+FluxNodeData                *flux_node_store_edit(FluxNodeStore *store, XentNodeId id);
 
 /**
- * @brief Get or create node data for the given ID.
+ * @brief Get or create node data for the given ID (touches it like flux_node_store_edit).
  * @param store Store to search/insert.
  * @param id Node ID.
  * @return Pointer to existing or newly-created FluxNodeData.
  */
 FluxNodeData                *flux_node_store_get_or_create(FluxNodeStore *store, XentNodeId id);
 
+/**
+ * @brief Mark a node as modified.
+ *
+ * Restamps the generation of @p id and of every ancestor with a new value so
+ * retained render commands covering them are rebuilt. flux_node_store_edit does
+ * this implicitly; call it after writing FluxNodeData (or its component data)
+ * reached some other way, such as xent userdata or a cached pointer.
+ * Ancestors are only reached once the store is bound to its context.
+ *
+ * @param store Store owning the node.
+ * @param id Node that changed.
+ */
+void                         flux_node_store_touch(FluxNodeStore *store, XentNodeId id);
+
+/**
+ * @brief Take a generational handle to a node's data.
+ * @param store Store to search.
+ * @param id Node ID.
+ * @return Handle, or a null handle (slot FLUX_NODE_HANDLE_NO_SLOT) if the node has no data.
+ */
+FluxNodeHandle               flux_node_store_handle(FluxNodeStore const *store, XentNodeId id);
+
+/**
+ * @brief Resolve a handle in O(1) (a plain read, like flux_node_store_get).
+ * @param store Store the handle was taken from.
+ * @param handle Handle from flux_node_store_handle.
+ * @return The node's data, or NULL if the node has since been removed.
+ */
+FluxNodeData const          *flux_node_store_resolve(FluxNodeStore const *store, FluxNodeHandle handle);
+
 /**
  * @brief Remove a node from the store.
  * @param store Store to modify.
@@ -255,13 +335,77 @@ uint32_t flux_node_store_count(FluxNodeStore const *store);
  * @brief Attach FluxNodeData pointers as userdata to all nodes in a context.
  *
  * After calling this, `xent_get_userdata(ctx, id)` returns the corresponding
- * FluxNodeData pointer for quick access during layout/render.
+ * FluxNodeData pointer for quick access during layout/render. A bound store
+ * (flux_node_store_bind_context) already does this as each node is added and
+ * node data never moves, so this is only needed to rebind a store's nodes to
+ * another context.
  *
  * @param store Store containing the node data.
  * @param ctx XentContext to attach userdata to.
  */
 void     flux_node_store_attach_userdata(FluxNodeStore *store, XentContext *ctx);
 
+/**
+ * @brief Note that the layout tree changed and the next layout must run.
+ *
+ * Bumps the store's layout generation. Node creation, reparenting and
+ * destruction do this by themselves, as do the bridge, the factory, control
+ * setters and input handlers. xent does not tell the store about style or
+ * content changes, so app code that calls xent directly (xent_set_size,
+ * xent_set_margin, xent_set_padding, xent_set_text or any other xent_set_*
+ * that feeds layout) must call this, or flux_node_store_invalidate_node_layout,
+ * afterwards. Otherwise flux_node_store_layout keeps the previous layout.
+ */
+void     flux_node_store_invalidate_layout(FluxNodeStore *store);
+
+/**
+ * @brief Note that the layout inside @p id's subtree changed.
+ *
+ * Finds the nearest layout boundary at or above @p id that can be laid out
+ * on its own and queues it, so the next flux_node_store_layout relays only
+ * that subtree instead of the whole tree. xent places a root it lays out at
+ * the origin, so only a boundary sitting at the origin qualifies. Pass the
+ * node whose content changed; when the node's own size may have changed, pass
+ * its parent. Falls back to flux_node_store_invalidate_layout when no such
+ * boundary is above @p id.
+ */
+void     flux_node_store_invalidate_node_layout(FluxNodeStore *store, XentNodeId id);
+
+/**
+ * @brief Mark @p id as a layout boundary (or clear it).
+ *
+ * Set this on containers whose width and height are both fixed: nothing
+ * below them can move anything outside them.
+ */
+void     flux_node_store_set_layout_boundary(FluxNodeStore *store, XentNodeId id, bool boundary);
+
+/** @brief Current layout generation (bumped by flux_node_store_invalidate_layout). */
+uint32_t flux_node_store_layout_generation(FluxNodeStore const *store);
+
+/**
+ * @brief Lay out @p root at the given size unless nothing has changed.
+ *
+ * Runs xent_layout on the bound context only when the layout generation,
+ * the root or the size differ from the last run. Otherwise only the dirty
+ * layout boundaries queued by flux_node_store_invalidate_node_layout are
+ * laid out, each at its current rect, and the rest of the layout stays.
+ * A queued boundary that has left the origin since is not laid out alone;
+ * the full pass runs instead. Direct xent mutations are not seen here; see
+ * flux_node_store_invalidate_layout.
+ *
+ * @return true if a full layout pass ran.
+ */
+bool     flux_node_store_layout(FluxNodeStore *store, XentNodeId root, float width, float height);
+
+/** @brief True when the generation moved or a boundary is dirty since the last layout. */
+bool     flux_node_store_layout_pending(FluxNodeStore const *store);
+
+/** @brief Number of layout passes flux_node_store_layout has run. */
+uint32_t flux_node_store_layout_count(FluxNodeStore const *store);
+
+/** @brief Number of boundary subtrees flux_node_store_layout has laid out on their own. */
+uint32_t flux_node_store_partial_layout_count(FluxNodeStore const *store);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,7 @@
 
 #include "flux_types.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -42,7 +43,26 @@ typedef struct FluxPlugin {
 	void *userdata;
 } FluxPlugin;
 
-/** @brief Registry mapping string type keys to renderer plugins. */
+/**
+ * @brief Interned plugin type.
+ *
+ * Registration turns a type name into a small id that indexes the registry
+ * directly. Ids are dense from 1, never reused for another name, and stay
+ * valid after the type is unregistered.
+ */
+typedef uint32_t FluxPluginId;
+
+#define FLUX_PLUGIN_INVALID 0u
+
+/** @brief Update timings of one plugin, accumulated by flux_plugin_update_all. */
+typedef struct FluxPluginStats {
+	uint32_t updates;       /**< Update callbacks run since registration or the last reset. */
+	double   last_seconds;  /**< Time spent in the most recent update. */
+	double   total_seconds; /**< Time spent in all counted updates. */
+	double   max_seconds;   /**< Slowest counted update. */
+} FluxPluginStats;
+
+/** @brief Registry mapping type names to renderer plugins. */
 typedef struct FluxPluginRegistry FluxPluginRegistry;
 
 /** @brief Create a plugin registry. */
@@ -50,18 +70,41 @@ XENT_NODISCARD FluxPluginRegistry *flux_plugin_registry_create(void);
 /** @brief Destroy a plugin registry and its registered plugins. */
 void                              flux_plugin_registry_destroy(FluxPluginRegistry *reg);
 
-/** @brief Register a plugin under a type key, replacing any existing plugin for that key. */
-void                              flux_plugin_register(FluxPluginRegistry *reg, char const *type, FluxPlugin plugin);
+/**
+ * @brief Register a plugin under a type name, replacing any existing plugin for that name.
+ * @return The type's id, or FLUX_PLUGIN_INVALID on allocation failure.
+ */
+FluxPluginId                      flux_plugin_register(FluxPluginRegistry *reg, char const *type, FluxPlugin plugin);
 
-/** @brief Remove a plugin by key. */
+/** @brief Remove a plugin by name. Its id stays reserved for the name. */
 void                              flux_plugin_unregister(FluxPluginRegistry *reg, char const *type);
 
-/** @brief Look up a plugin by key. */
+/** @brief Id of a type name registered before, or FLUX_PLUGIN_INVALID. */
+FluxPluginId                      flux_plugin_find(FluxPluginRegistry const *reg, char const *type);
+
+/** @brief Look up a plugin by name (hashes the name; prefer flux_plugin_get_id per frame). */
 FluxPlugin const                 *flux_plugin_get(FluxPluginRegistry const *reg, char const *type);
 
-/** @brief Call update callbacks on all registered plugins that define one. */
+/** @brief Look up a plugin by id, or NULL when none is registered under it. */
+FluxPlugin const                 *flux_plugin_get_id(FluxPluginRegistry const *reg, FluxPluginId id);
+
+/** @brief Type name of an id, or NULL for an unknown id. */
+char const                       *flux_plugin_name(FluxPluginRegistry const *reg, FluxPluginId id);
+
+/** @brief One past the highest id handed out, for tables indexed by FluxPluginId. */
+uint32_t                          flux_plugin_id_limit(FluxPluginRegistry const *reg);
+
+/** @brief Call update callbacks on all registered plugins that define one, timing each. */
 void                              flux_plugin_update_all(FluxPluginRegistry *reg, float dt);
 
+/** @brief Copy a registered plugin's update timings; false when none is registered under @p id. */
+bool                              flux_plugin_get_stats(
+  FluxPluginRegistry const *reg, FluxPluginId id, FluxPluginStats *out
+);
+
+/** @brief Zero the update timings of every plugin. */
+void                              flux_plugin_reset_stats(FluxPluginRegistry *reg);
+
 #ifdef __cplusplus
 }
 #endif
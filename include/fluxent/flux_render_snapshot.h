@@ -19,6 +19,8 @@
 #include "flux_component_data.h"
 #include "flux_node_store.h"
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -30,9 +32,9 @@ extern "C"
  * Carries caret, selection, and IME composition for the text-input renderers.
  */
 typedef struct FluxEditSnapshot {
-	uint32_t       cursor_position;                        /**< Caret index (UTF-8 code units). */
-	uint32_t       selection_start, selection_end;         /**< Selection range (code units). */
-	float          scroll_offset_x;                        /**< Horizontal text scroll (DIPs). */
+	uint32_t       cursor_position;                        /**< Caret index into the drawn text (UTF-8 code units). */
+	uint32_t       selection_start, selection_end;         /**< Selection range, clamped to the drawn text. */
+	float          scroll_offset_x;                        /**< Horizontal scroll from the drawn text's start (DIPs). */
 	wchar_t const *composition_text;                       /**< Active IME composition, or NULL. */
 	uint32_t       composition_length, composition_cursor; /**< IME composition extent + caret. */
 	FluxColor      selection_color;                        /**< Selection highlight fill. */
@@ -86,7 +88,7 @@ typedef struct FluxSliderSnapshot {
 
 /** @brief Text-input payload (TextBox / PasswordBox / NumberBox). */
 typedef struct FluxTextBoxSnapshot {
-	char const      *text_content;      /**< Current text (may be NULL). */
+	char const      *text_content;      /**< Text to draw: all of it, or a long text's window at the caret. */
 	char const      *placeholder;       /**< Placeholder text (may be NULL). */
 	char const      *font_family;       /**< Font family name. */
 	FluxColor        text_color;        /**< Text foreground. */
@@ -376,7 +378,26 @@ typedef struct FluxRenderSnapshot {
 } FluxRenderSnapshot;
 
 /** @brief Build an immutable render snapshot for one node. */
-void flux_snapshot_build(FluxRenderSnapshot *snap, XentContext const *ctx, XentNodeId node, FluxNodeData const *nd);
+void     flux_snapshot_build(FluxRenderSnapshot *snap, XentContext const *ctx, XentNodeId node, FluxNodeData const *nd);
+
+/**
+ * @brief Bytes of a @p type snapshot that carry data: the shared base plus
+ *        the union arm its builder writes. The rest of the union is zero.
+ *
+ * The engine stores only this prefix per draw command; see flux_engine.h.
+ */
+size_t   flux_snapshot_payload_size(FluxControlType type);
+
+/**
+ * @brief Content digest of a snapshot for change detection.
+ *
+ * Covers the payload bytes (see flux_snapshot_payload_size()) plus the contents of every string the active
+ * payload arm points at, so an in-place edit behind a stable pointer (TextBox
+ * buffer, reused label storage) still changes the digest. Equal digests mean
+ * the control would draw the same pixels given the same interaction state and
+ * render-cache tweens.
+ */
+uint64_t flux_snapshot_hash(FluxRenderSnapshot const *snap);
 
 #ifdef __cplusplus
 }
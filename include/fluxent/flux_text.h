@@ -23,7 +23,10 @@
  *
  * Use FluxTextStyle to specify font, size, weight, alignment, and color.
  * The renderer maintains a layout cache to avoid recreating DirectWrite
- * layouts for unchanged text/style combinations.
+ * layouts for unchanged text/style combinations. The cache is bounded by a
+ * memory budget (`flux_text_renderer_set_cache_budget()`), evicts least
+ * recently used layouts, and reports its counters through
+ * `flux_text_renderer_cache_stats()`.
  *
  * ## Thread Safety
  *
@@ -36,6 +39,8 @@
 #include "flux_component_data.h"
 #include <xent/xent.h>
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -97,6 +102,19 @@ typedef struct FluxTextClusterQuery {
 	uint32_t            index;
 } FluxTextClusterQuery;
 
+/** @brief Text cache counters (see flux_text_renderer_cache_stats). */
+typedef struct FluxTextCacheStats {
+	uint64_t hits;      /**< Lookups answered from the cache. */
+	uint64_t misses;    /**< Lookups that had to create the object. */
+	uint64_t evictions; /**< Entries dropped to stay within the budget. */
+	uint32_t entries;   /**< Entries currently cached. */
+	size_t   bytes;     /**< Estimated bytes held by the cached entries. */
+	size_t   budget;    /**< Byte budget the cache trims to. */
+} FluxTextCacheStats;
+
+/** @brief Default layout cache budget in bytes (estimated DirectWrite memory). */
+#define FLUX_TEXT_LAYOUT_CACHE_BUDGET (4u * 1024u * 1024u)
+
 /**
  * @brief Create a text renderer.
  *
@@ -124,6 +142,25 @@ void              flux_text_renderer_destroy(FluxTextRenderer *tr);
  */
 bool              flux_text_renderer_register(FluxTextRenderer *tr, XentContext *ctx);
 
+/**
+ * @brief Set the layout cache memory budget.
+ *
+ * Layouts are charged an estimate of their DirectWrite memory (growing with
+ * the text length); least recently used layouts are evicted past the budget.
+ *
+ * @param tr Text renderer (NULL is safe).
+ * @param bytes Budget in bytes (FLUX_TEXT_LAYOUT_CACHE_BUDGET by default).
+ */
+void              flux_text_renderer_set_cache_budget(FluxTextRenderer *tr, size_t bytes);
+
+/**
+ * @brief Read the hit/miss/eviction counters of the layout and format caches.
+ * @param tr Text renderer.
+ * @param layouts Receives the layout cache counters (may be NULL).
+ * @param formats Receives the text format cache counters (may be NULL).
+ */
+void flux_text_renderer_cache_stats(FluxTextRenderer const *tr, FluxTextCacheStats *layouts, FluxTextCacheStats *formats);
+
 /**
  * @brief Draw text to a D2D render target.
  *
@@ -29,6 +29,7 @@
 #include "flux_theme.h"
 #include "flux_controls.h"
 #include "flux_plugin.h"
+#include "flux_frame_stats.h"
 #include "flux_popup.h"
 #include "flux_tooltip.h"
 #include "flux_flyout.h"
@@ -478,6 +479,21 @@ FluxMenuFlyout   *flux_app_get_active_menu_flyout(FluxApp *app);
 /** @brief Native HWND for the application's primary window. */
 HWND              flux_app_get_hwnd(FluxApp *app);
 
+/**
+ * @brief Start or stop recording per-frame timings into the app's ring.
+ *
+ * Off by default, where it costs a branch per frame phase; setting
+ * FLUXENT_FRAME_STATS=1 in the environment starts it at launch. Stopping
+ * keeps the recorded frames for reading or writing out.
+ */
+void              flux_app_set_frame_stats_enabled(FluxApp *app, bool enabled);
+
+/** @brief The app's recorded frames, or NULL if recording was never enabled. */
+FluxFrameStats const *flux_app_get_frame_stats(FluxApp *app);
+
+/** @brief Write the recorded frames to @p path as Chrome trace JSON (see flux_frame_stats_write_trace). */
+bool              flux_app_write_frame_trace(FluxApp *app, char const *path);
+
 /** @brief Create a button node. */
 XentNodeId        flux_create_button(FluxButtonCreateInfo const *info);
 
@@ -743,7 +759,7 @@ XentNodeId flux_create_list_item(FluxListItemCreateInfo const *info);
 /** @brief The ABSOLUTE items host realized rows mount into. */
 XentNodeId flux_list_view_content_node(FluxNodeStore *store, XentNodeId list);
 
-/** @brief Set count/cell metrics/columns; resizes the scrollable extent. */
+/** @brief Set count/cell metrics/columns; resizes the scrollable extent and drops selection past the end. */
 void flux_list_view_set_extent(
   FluxNodeStore *store, XentNodeId list, int count, float item_height, float item_width, int columns
 );
@@ -760,6 +776,18 @@ bool flux_list_view_is_selected(FluxNodeStore *store, XentNodeId list, int index
 /** @brief Multiple/Extended: number of selected items. */
 int  flux_list_view_selection_count(FluxNodeStore *store, XentNodeId list);
 
+/* Bulk selection returns false, with the selection left as it was, when the
+ * list is not in Multiple/Extended mode or the run array could not grow. */
+
+/** @brief Multiple/Extended: select (or deselect) every index in [first, last]. */
+bool flux_list_view_select_range(FluxNodeStore *store, XentNodeId list, int first, int last, bool selected);
+
+/** @brief Multiple/Extended: select exactly the items that were not selected. */
+bool flux_list_view_invert_selection(FluxNodeStore *store, XentNodeId list);
+
+/** @brief Multiple/Extended: add every index @p pred accepts to the selection (one pass). */
+bool flux_list_view_select_where(FluxNodeStore *store, XentNodeId list, bool (*pred)(void *ctx, int index), void *ctx);
+
 /** @brief Record the realized window + column count (reconciler-reported). */
 void flux_list_view_set_realized(FluxNodeStore *store, XentNodeId list, int first, int last, int cols);
 
@@ -775,6 +803,18 @@ void flux_list_view_update_window(XentContext *ctx, XentNodeId list, struct Flux
 /** @brief Minimal-edge scroll to bring an index into view (WinUI Default alignment). */
 void flux_list_view_scroll_into_view(FluxNodeStore *store, XentNodeId list, int index);
 
+/**
+ * @brief Report a list row's measured height (single-column lists; grids stay uniform).
+ *
+ * Rows not yet measured take the average measured height (item_height until
+ * the first report). Offsets resolve in O(log n) and the first visible row
+ * keeps its screen position when rows above it change height.
+ */
+void  flux_list_view_set_row_height(FluxNodeStore *store, XentNodeId list, int index, float height);
+
+/** @brief Content-space top of an item's row in DIPs. */
+float flux_list_view_row_offset(FluxNodeStore *store, XentNodeId list, int index);
+
 /** @brief Update a recycled cell: index + content-space slot placement. */
 void flux_list_item_set_place(FluxNodeStore *store, XentNodeId item, int index, float x, float y);
 
@@ -796,14 +836,20 @@ typedef struct FluxTreeViewCreateInfo {
 	void           (*on_invoke)(void *ctx, int flat_index);
 	void           (*on_expand)(void *ctx, int flat_index, bool expanded);
 	void           (*on_select)(void *ctx, int flat_index, bool selected);
+	void           (*on_populate)(void *ctx, int node);
 	void          *userdata;
 } FluxTreeViewCreateInfo;
 
 XentNodeId flux_create_tree_view(FluxTreeViewCreateInfo const *info);
+/* Node handles (add_node, flat_node, on_populate) go stale once the node is
+ * removed, cleared or evicted; calls with a stale handle are ignored. */
 int  flux_tree_view_add_node(FluxNodeStore *store, XentNodeId tree, int parent, char const *text, char const *icon);
 void flux_tree_view_remove_node(FluxNodeStore *store, XentNodeId tree, int node);
 void flux_tree_view_clear(FluxNodeStore *store, XentNodeId tree);
 void flux_tree_view_set_expanded(FluxNodeStore *store, XentNodeId tree, int node, bool expanded);
+void flux_tree_view_set_has_children(FluxNodeStore *store, XentNodeId tree, int node, bool has_children);
+void flux_tree_view_finish_children(FluxNodeStore *store, XentNodeId tree, int node);
+int  flux_tree_view_evict_collapsed(FluxNodeStore *store, XentNodeId tree, unsigned long idle_ms);
 void flux_tree_view_set_node_disabled(FluxNodeStore *store, XentNodeId tree, int node, bool disabled);
 void flux_tree_view_set_selection_mode(FluxNodeStore *store, XentNodeId tree, XtkTreeSelMode mode);
 void flux_tree_view_set_selected(FluxNodeStore *store, XentNodeId tree, int node, bool selected);
@@ -812,6 +858,7 @@ bool flux_tree_view_is_expanded(FluxNodeStore *store, XentNodeId tree, int node)
 bool flux_tree_view_is_selected(FluxNodeStore *store, XentNodeId tree, int node);
 int  flux_tree_view_flat_count(FluxNodeStore *store, XentNodeId tree);
 int  flux_tree_view_flat_node(FluxNodeStore *store, XentNodeId tree, int flat_index);
+int  flux_tree_view_node_flat(FluxNodeStore *store, XentNodeId tree, int node);
 
 /* -------------------------------------------------------------------------
  * ItemsView (ItemsRepeater + Layout + SelectionModel; ItemContainer chrome)
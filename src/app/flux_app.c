@@ -3,6 +3,7 @@
 #include "fluxent/flux_graphics.h"
 #include "fluxent/flux_input.h"
 #include "fluxent/flux_text.h"
+#include "fluxent/flux_frame_stats.h"
 #include "input/flux_dmanip.h"
 #include "render/flux_render_internal.h"
 #include "fluxent/flux_theme.h"
@@ -10,6 +11,7 @@
 #include "fluxent/flux_tooltip.h"
 #include "app/flux_scene.h"
 #include "runtime/flux_time.h"
+#include "runtime/flux_anim_driver.h"
 #include "input/flux_dmanip_sync.h"
 #include "controls/behavior/flux_control_cursor.h"
 #include "controls/draw/flux_control_draw.h"
@@ -28,6 +30,12 @@
 #define FLUX_APP_RENDER_CACHE_CAPACITY  512
 #define FLUX_APP_SCENE_INITIAL_CAPACITY 512
 #define FLUX_APP_TOOLTIP_ANCHOR_H       20.0f
+#define FLUX_APP_DISABLE_PARTIAL_ENV_CAP 8
+#define FLUX_APP_FRAME_STATS_ENV_CAP    8
+/** @brief Repainted share of the window above which a partial frame redraws in full. */
+#define FLUX_APP_DAMAGE_FULL_RATIO      0.6f
+/** @brief Window timer that wakes the frame loop for a sleeping animator. */
+#define FLUX_APP_ANIM_TIMER             0xF2
 
 /** @brief Present the frame with vsync enabled (default FluxApp render path). */
 static bool const                kFluxAppPresentUseVsync = true;
@@ -46,6 +54,7 @@ struct FluxApp {
 
 	ID2D1SolidColorBrush    *shared_brush;
 	int64_t                  last_frame_ticks;
+	float                    layout_dpi;     /**< DPI the current layout was computed at. */
 	XentNodeId               last_uia_focus; /**< Last node reported to UIA as focused (focus-event de-dup). */
 
 	FluxTooltip             *tooltip;
@@ -55,8 +64,18 @@ struct FluxApp {
 	FluxComposeRender       *compose; /**< Retained-composition path (FLUX_USE_COMPOSITION). */
 	FluxRenderBackend const *backend; /**< Chosen render strategy (d2d or composition); set on first frame. */
 
+	FluxDamageRegion         prev_damage;    /**< Own damage of the last presented classic frame. */
+	uint64_t                 frame_env;      /**< Digest of theme/DPI/clear inputs the content hashes miss. */
+	bool                     partial_redraw; /**< Classic path repaints damaged rects only. */
+
 	void                     (*frame_cb)(void *ctx); /**< Runs at frame start, before layout (xtk message pump). */
 	void                    *frame_cb_ctx;
+
+	FluxFrameStats          *frame_stats;      /**< Frame timing ring; created when recording is first enabled. */
+	FluxFrameRecord         *frame_record;     /**< Frame being recorded; NULL when not recording. */
+	bool                     frame_stats_on;
+	uint64_t                 text_hits_seen;   /**< Text cache totals at the end of the last recorded frame. */
+	uint64_t                 text_misses_seen;
 };
 
 static XentContext   *app_ctx(FluxApp const *app) { return app ? flux_scene_context(app->scene) : NULL; }
@@ -104,6 +123,47 @@ static void app_init_dmanip(FluxApp *app) {
 	if (hwnd) ( void ) flux_dmanip_create(hwnd, &app->dmanip);
 }
 
+/* Partial redraw is on by default; FLUXENT_DISABLE_PARTIAL_REDRAW=1 forces
+ * full frames (diagnosing stale-pixel bugs in a renderer). */
+static void app_init_partial_redraw(FluxApp *app) {
+	char  val [FLUX_APP_DISABLE_PARTIAL_ENV_CAP] = {0};
+	DWORD n = GetEnvironmentVariableA("FLUXENT_DISABLE_PARTIAL_REDRAW", val, sizeof(val));
+	app->partial_redraw = !(n > 0 && val [0] == '1');
+}
+
+/* Frame timing costs one branch per phase while recording is off: the
+ * phase helpers only read the clock when a frame record is open. */
+static int64_t app_phase_begin(FluxApp const *app) { return app->frame_record ? flux_perf_now() : 0; }
+
+static void    app_phase_end(FluxApp *app, FluxFramePhase phase, int64_t begin) {
+	if (app->frame_record) flux_frame_stats_phase(app->frame_record, phase, begin, flux_perf_now());
+}
+
+static void app_seed_text_counters(FluxApp *app) {
+	FluxTextCacheStats layouts, formats;
+	flux_text_renderer_cache_stats(app->text, &layouts, &formats);
+	app->text_hits_seen   = layouts.hits + formats.hits;
+	app->text_misses_seen = layouts.misses + formats.misses;
+}
+
+static void app_frame_stats_finish(FluxApp *app) {
+	FluxFrameRecord *r = app->frame_record;
+	if (!r) return;
+	uint64_t hits = app->text_hits_seen, misses = app->text_misses_seen;
+	app_seed_text_counters(app);
+	r->text_hits      = ( uint32_t ) (app->text_hits_seen - hits);
+	r->text_misses    = ( uint32_t ) (app->text_misses_seen - misses);
+	app->frame_record = NULL;
+	flux_frame_stats_end(app->frame_stats, flux_perf_now());
+}
+
+/* FLUXENT_FRAME_STATS=1 records from the first frame, for field reports. */
+static void app_init_frame_stats(FluxApp *app) {
+	char  val [FLUX_APP_FRAME_STATS_ENV_CAP] = {0};
+	DWORD n                                  = GetEnvironmentVariableA("FLUXENT_FRAME_STATS", val, sizeof(val));
+	if (n > 0 && val [0] == '1') flux_app_set_frame_stats_enabled(app, true);
+}
+
 static bool app_focused_accepts_command(FluxApp *app) {
 	XentNodeId focused = flux_input_get_focused(app->input);
 	if (focused == XENT_NODE_INVALID || !app_ctx(app)) return false;
@@ -117,6 +177,56 @@ static void app_request_render(void *ctx) {
 	if (app) flux_app_request_render(app);
 }
 
+/* A sleeping animator's deadline is the only reason to wake an idle window,
+ * so a one-shot timer turns it into an ordinary paint request. */
+static void CALLBACK app_anim_timer_proc(HWND hwnd, UINT msg, UINT_PTR id, DWORD elapsed) {
+	( void ) msg;
+	( void ) elapsed;
+	KillTimer(hwnd, id);
+	InvalidateRect(hwnd, NULL, FALSE);
+}
+
+static void app_anim_wake(void *ctx, unsigned long delay_ms) {
+	FluxApp *app  = ( FluxApp * ) ctx;
+	HWND     hwnd = flux_app_get_hwnd(app);
+	if (delay_ms == 0) flux_app_request_render(app);
+	else if (hwnd) SetTimer(hwnd, FLUX_APP_ANIM_TIMER, ( UINT ) delay_ms, app_anim_timer_proc);
+}
+
+/* Step of the app's sleeper for rc->wake_at. The sleeper only puts the
+ * deadline in the driver's wheel, which arms app_anim_wake (a one-shot timer
+ * that invalidates the window) alongside any sleeping animators. By the time
+ * this runs, that frame is already painting, so there is nothing to step. */
+static bool app_wake_step(void *ctx, unsigned long now_ms) {
+	( void ) ctx;
+	( void ) now_ms;
+	return false;
+}
+
+/* Animators step with the frame's own clock, before layout, so the tree the
+ * frame lays out already holds this frame's animated values. */
+static bool app_tick_animations(int64_t now_ticks, unsigned long *now_ms) {
+	*now_ms = ( unsigned long ) flux_perf_millis(now_ticks);
+	return flux_anim_tick(*now_ms);
+}
+
+/* Asks for the next frame: at once while anything animates, else at the
+ * earliest time a renderer gave in rc->wake_at, else never. */
+static void app_schedule_next_frame(
+  FluxApp *app, bool anims_active, double now, double wake_at, unsigned long now_ms
+) {
+	if (anims_active) {
+		flux_app_request_render(app);
+		return;
+	}
+	if (!isfinite(wake_at)) {
+		flux_anim_unregister(app);
+		return;
+	}
+	double delay = ceil((wake_at - now) * 1000.0);
+	flux_anim_sleep_until(app, app_wake_step, now_ms + ( unsigned long ) (delay > 0.0 ? delay : 0.0));
+}
+
 static float    app_dpi_scale(FluxDpiInfo dpi) { return dpi.dpi_x / FLUX_DPI_BASE; }
 
 static FluxSize app_client_dips(FluxApp const *app, FluxDpiInfo dpi) {
@@ -139,10 +249,33 @@ static void app_prepare_layout_tree(FluxApp *app, FluxDpiInfo dpi) {
 	XentNodeId     root  = app_root(app);
 	float          scale = app_dpi_scale(dpi);
 
-	if (app->dmanip) flux_dmanip_tick(app->dmanip);
-	xent_layout(ctx, root, dips.w, dips.h);
-	if (app->dmanip) flux_dmanip_sync_tree(app->dmanip, ctx, store, root, scale);
-	if (store) flux_node_store_attach_userdata(store, ctx);
+	if (app->dmanip) {
+		int64_t t = app_phase_begin(app);
+		flux_dmanip_tick(app->dmanip);
+		app_phase_end(app, FLUX_FRAME_PHASE_DMANIP_TICK, t);
+	}
+	/* Hover-only frames leave the tree as it was; the store skips those, and
+	 * when only the inside of layout boundaries changed (typing in a text box)
+	 * it lays out just those subtrees instead of the window root. */
+	if (dpi.dpi_x != app->layout_dpi) {
+		app->layout_dpi = dpi.dpi_x;
+		flux_node_store_invalidate_layout(store);
+	}
+	int64_t  t       = app_phase_begin(app);
+	uint32_t partial = flux_node_store_partial_layout_count(store);
+	bool     full    = true;
+	if (store) full = flux_node_store_layout(store, root, dips.w, dips.h);
+	else xent_layout(ctx, root, dips.w, dips.h);
+	app_phase_end(app, FLUX_FRAME_PHASE_LAYOUT, t);
+	if (app->frame_record) {
+		app->frame_record->layout_passes   = full ? 1u : 0u;
+		app->frame_record->partial_layouts = flux_node_store_partial_layout_count(store) - partial;
+	}
+	if (app->dmanip) {
+		t = app_phase_begin(app);
+		flux_dmanip_sync_tree(app->dmanip, ctx, store, root, scale);
+		app_phase_end(app, FLUX_FRAME_PHASE_DMANIP_SYNC, t);
+	}
 }
 
 static FluxRenderContext app_render_context(FluxApp *app, FluxGraphics *gfx, FluxDpiInfo dpi, int64_t now_ticks) {
@@ -188,48 +321,134 @@ static void app_ensure_compose(FluxApp *app, FluxGraphics *gfx) {
  * paint each node into its own surface via the existing renderers. The swap
  * chain / immediate-mode execute path is bypassed entirely in this mode. */
 static void app_render_composition(FluxApp *app, FluxGraphics *gfx, FluxDpiInfo dpi) {
+	int64_t       now_ticks    = flux_perf_now();
+	unsigned long now_ms       = 0;
+	bool          anims_active = app_tick_animations(now_ticks, &now_ms);
+
 	app_prepare_layout_tree(app, dpi);
 	if (app->cache) flux_render_cache_begin_frame(app->cache);
+	if (flux_render_cache_advance(app->cache, flux_perf_seconds(now_ticks))) anims_active = true;
 	app_ensure_compose(app, gfx);
 	if (!app->compose) return;
 
-	int64_t           now_ticks = flux_perf_now();
-	FluxRenderContext rc        = app_render_context(app, gfx, dpi, now_ticks);
-	app->last_frame_ticks       = now_ticks;
+	FluxRenderContext rc  = app_render_context(app, gfx, dpi, now_ticks);
+	app->last_frame_ticks = now_ticks;
 
-	bool anims_active           = false;
-	rc.animations_active        = &anims_active;
+	double wake_at        = INFINITY;
+	rc.animations_active  = &anims_active;
+	rc.wake_at            = &wake_at;
 	app_sync_tooltip_theme(app, &rc);
 
+	int64_t t = app_phase_begin(app);
 	flux_compose_render_frame(app->compose, app_ctx(app), app_store(app), app_root(app), &rc);
+	app_phase_end(app, FLUX_FRAME_PHASE_COMPOSE, t);
+	if (flux_node_store_layout_pending(app_store(app))) anims_active = true;
 
-	if (anims_active) flux_app_request_render(app);
+	app_schedule_next_frame(app, anims_active, rc.now, wake_at, now_ms);
+}
+
+static uint64_t app_env_mix(uint64_t h, void const *bytes, size_t len) {
+	unsigned char const *p = ( unsigned char const * ) bytes;
+	for (size_t i = 0; i < len; i++) {
+		h ^= p [i];
+		h *= 0x100000001b3ull;
+	}
+	return h;
+}
+
+/* Renderers read the palette, DPI and clear color from the render context,
+ * not the snapshot, so a change there repaints everything. */
+static uint64_t app_frame_env(FluxRenderContext const *rc, FluxColor clear) {
+	uint64_t h = 0xcbf29ce484222325ull;
+	if (rc->theme) h = app_env_mix(h, rc->theme, sizeof(*rc->theme));
+	h = app_env_mix(h, &rc->is_dark, sizeof(rc->is_dark));
+	h = app_env_mix(h, &rc->dpi, sizeof(rc->dpi));
+	return app_env_mix(h, &clear, sizeof(clear));
+}
+
+/* Decides what the classic frame repaints. The back buffer holds the frame
+ * presented buffer-age presents ago (two with FLIP_SEQUENTIAL), so it must be
+ * brought forward by this frame's damage plus the previous frame's. Returns
+ * false when nothing changed and the frame can be skipped entirely. */
+static bool app_plan_repaint(
+  FluxApp *app, FluxGraphics *gfx, FluxRenderContext const *rc, FluxColor clear, FluxDamageRegion *out
+) {
+	FluxDamageRegion damage;
+	flux_engine_get_damage(app->engine, &damage);
+
+	uint64_t env = app_frame_env(rc, clear);
+	if (env != app->frame_env || !app->partial_redraw) flux_damage_set_full(&damage);
+	app->frame_env    = env;
+
+	FluxSize dips     = app_client_dips(app, rc->dpi);
+	FluxRect viewport = {0.0f, 0.0f, dips.w, dips.h};
+	flux_damage_snap(&damage, viewport, app_dpi_scale(rc->dpi));
+	if (flux_damage_is_empty(&damage)) return false;
+
+	*out = damage;
+	if (flux_graphics_buffer_age(gfx) == 0) flux_damage_set_full(out);
+	else flux_damage_union(out, &app->prev_damage);
+	if (flux_damage_area(out) > viewport.w * viewport.h * FLUX_APP_DAMAGE_FULL_RATIO) flux_damage_set_full(out);
+
+	app->prev_damage = damage;
+	return true;
+}
+
+static void app_record_collect(FluxApp *app) {
+	if (!app->frame_record) return;
+	FluxEngineStats es;
+	flux_engine_get_stats(app->engine, &es);
+	app->frame_record->commands        = es.commands;
+	app->frame_record->reused_commands = es.reused_commands;
+	app->frame_record->snapshots_built = es.snapshots_built;
+	app->frame_record->snapshot_bytes  = flux_engine_frame_bytes(app->engine);
 }
 
 /* Immediate-mode swapchain frame: collect the layout into a command list and
- * execute it into the D2D swap chain. The classic (default) render path. */
+ * execute it into the D2D swap chain. The classic (default) render path.
+ * Only the damaged rects are repainted and presented; an unchanged frame is
+ * not drawn at all. */
 static void app_render_classic(FluxApp *app, FluxGraphics *gfx, FluxDpiInfo dpi) {
+	int64_t       now_ticks    = flux_perf_now();
+	unsigned long now_ms       = 0;
+	bool          anims_active = app_tick_animations(now_ticks, &now_ms);
+
 	app_prepare_layout_tree(app, dpi);
 	if (app->cache) flux_render_cache_begin_frame(app->cache);
+	if (flux_render_cache_advance(app->cache, flux_perf_seconds(now_ticks))) anims_active = true;
 
+	int64_t t = app_phase_begin(app);
 	flux_engine_collect(app->engine, app_ctx(app), app_root(app));
+	flux_input_set_hit_index(app->input, flux_engine_hit_index(app->engine));
+	app_phase_end(app, FLUX_FRAME_PHASE_COLLECT, t);
+	app_record_collect(app);
 	app_ensure_shared_brush(app, gfx);
 
-	int64_t           now_ticks = flux_perf_now();
-	FluxRenderContext rc        = app_render_context(app, gfx, dpi, now_ticks);
-	app->last_frame_ticks       = now_ticks;
+	FluxRenderContext rc  = app_render_context(app, gfx, dpi, now_ticks);
+	app->last_frame_ticks = now_ticks;
 
-	bool anims_active           = false;
-	rc.animations_active        = &anims_active;
+	double wake_at        = INFINITY;
+	rc.animations_active  = &anims_active;
+	rc.wake_at            = &wake_at;
 	app_sync_tooltip_theme(app, &rc);
 
-	flux_graphics_begin_draw(gfx);
-	flux_graphics_clear(gfx, app_clear_color(app));
-	flux_engine_execute(app->engine, &rc);
-	flux_graphics_end_draw(gfx);
-	flux_graphics_present(gfx, kFluxAppPresentUseVsync);
+	FluxColor        clear = app_clear_color(app);
+	FluxDamageRegion repaint;
+	if (app_plan_repaint(app, gfx, &rc, clear, &repaint)) {
+		t = app_phase_begin(app);
+		flux_graphics_begin_draw(gfx);
+		flux_engine_execute_region(app->engine, &rc, &repaint, clear);
+		flux_graphics_end_draw(gfx);
+		app_phase_end(app, FLUX_FRAME_PHASE_EXECUTE, t);
+		t = app_phase_begin(app);
+		flux_graphics_present_region(gfx, kFluxAppPresentUseVsync, &repaint);
+		app_phase_end(app, FLUX_FRAME_PHASE_PRESENT, t);
+		if (app->frame_record) app->frame_record->presented = true;
+	}
+	/* A sync hook moved nodes after this frame's layout: lay them out next frame. */
+	if (flux_node_store_layout_pending(app_store(app))) anims_active = true;
 
-	if (anims_active) flux_app_request_render(app);
+	app_schedule_next_frame(app, anims_active, rc.now, wake_at, now_ms);
 }
 
 /* The render backend is the cohesive strategy chosen once by capability: the
@@ -267,7 +486,12 @@ static void app_render(void *ctx) {
 	FluxApp *app = ( FluxApp * ) ctx;
 	if (!app || !app_ctx(app) || app_root(app) == XENT_NODE_INVALID) return;
 
-	if (app->frame_cb) app->frame_cb(app->frame_cb_ctx);
+	if (app->frame_stats_on) app->frame_record = flux_frame_stats_begin(app->frame_stats, flux_perf_now());
+	if (app->frame_cb) {
+		int64_t t = app_phase_begin(app);
+		app->frame_cb(app->frame_cb_ctx);
+		app_phase_end(app, FLUX_FRAME_PHASE_UPDATE, t);
+	}
 	app_pump_uia_focus(app);
 
 	FluxGraphics *gfx = flux_app_get_graphics(app);
@@ -275,6 +499,7 @@ static void app_render(void *ctx) {
 
 	if (!app->backend) app->backend = app_select_backend(gfx);
 	app->backend->render_frame(app, gfx, dpi);
+	app_frame_stats_finish(app);
 }
 
 static void app_update_cursor_and_tooltip(FluxApp *app, float x, float y, bool is_touch) {
@@ -288,8 +513,8 @@ static void app_update_cursor_and_tooltip(FluxApp *app, float x, float y, bool i
 		return;
 	}
 
-	FluxNodeData *hover_nd      = (hovered != XENT_NODE_INVALID) ? flux_node_store_get(app_store(app), hovered) : NULL;
-	FluxRect      screen_bounds = {0};
+	FluxNodeData const *hover_nd = (hovered != XENT_NODE_INVALID) ? flux_node_store_get(app_store(app), hovered) : NULL;
+	FluxRect            screen_bounds = {0};
 	if (hovered != XENT_NODE_INVALID) {
 		HWND        hwnd   = flux_window_hwnd(app->window);
 		FluxDpiInfo tdpi   = flux_window_dpi(app->window);
@@ -467,7 +692,6 @@ static bool app_bind_scene_runtime(FluxApp *app) {
 	app->text   = flux_text_renderer_create();
 	if (app->text) flux_text_renderer_register(app->text, ctx);
 
-	flux_node_store_attach_userdata(store, ctx);
 	flux_node_store_set_remove_listener(store, app_on_node_removed, app);
 	if (app->tooltip && app->text) flux_tooltip_set_text_renderer(app->tooltip, app->text);
 
@@ -532,6 +756,8 @@ static void app_create_runtime_services(FluxApp *app) {
 	if (app->theme) flux_theme_set_mode(app->theme, FLUX_THEME_SYSTEM);
 	app->tooltip = flux_tooltip_create(app->window);
 	app_init_dmanip(app);
+	app_init_partial_redraw(app);
+	app_init_frame_stats(app);
 }
 
 static bool app_create_scene(FluxApp *app) {
@@ -549,6 +775,7 @@ FluxApp *flux_app_create(FluxAppConfig const *cfg) {
 	}
 
 	app_bind_window_callbacks(app);
+	flux_anim_set_wake(app_anim_wake, app);
 	app_create_runtime_services(app);
 	if (!app_create_scene(app)) {
 		flux_app_destroy(app);
@@ -591,11 +818,14 @@ static void app_destroy_input_state(FluxApp *app) {
 
 void flux_app_destroy(FluxApp *app) {
 	if (!app) return;
+	flux_anim_unregister(app);
+	flux_anim_clear_wake(app_anim_wake, app);
 	app_cleanup_dmanip(app);
 	app_destroy_input_state(app);
 	app_destroy_render_state(app);
 	flux_scene_destroy(app->scene);
 	if (app->window) flux_window_destroy(app->window);
+	flux_frame_stats_destroy(app->frame_stats);
 	free(app);
 }
 
@@ -652,3 +882,16 @@ FluxMenuFlyout *flux_app_get_active_menu_flyout(FluxApp *app) {
 }
 
 HWND flux_app_get_hwnd(FluxApp *app) { return app && app->window ? flux_window_hwnd(app->window) : NULL; }
+
+void flux_app_set_frame_stats_enabled(FluxApp *app, bool enabled) {
+	if (!app || app->frame_stats_on == enabled) return;
+	if (enabled && !app->frame_stats) app->frame_stats = flux_frame_stats_create(FLUX_FRAME_STATS_DEFAULT_CAPACITY);
+	app->frame_stats_on = enabled && app->frame_stats;
+	if (app->frame_stats_on) app_seed_text_counters(app);
+}
+
+FluxFrameStats const *flux_app_get_frame_stats(FluxApp *app) { return app ? app->frame_stats : NULL; }
+
+bool                  flux_app_write_frame_trace(FluxApp *app, char const *path) {
+	return app && flux_frame_stats_write_trace(app->frame_stats, path);
+}
@@ -176,11 +176,28 @@ static void flux_apply_grow(XentContext *ctx, XentNodeId id, XtkEl const *prev,
 	}
 }
 
+/* Text inputs never size to their text (see tb_factory), so they are layout
+ * boundaries whatever their element size says. */
+static bool flux_el_text_input(XtkEl const *el) {
+	return el->type == FLUX_CONTROL_TEXT_INPUT || el->type == FLUX_CONTROL_PASSWORD_BOX
+	    || el->type == FLUX_CONTROL_NUMBER_BOX;
+}
+
+/* True when the element's own box is placed as before, so the re-render can
+ * only have changed what lies inside it. */
+static bool flux_el_same_box(XtkEl const *prev, XtkEl const *el) {
+	return prev && flux_feq(prev->width, el->width) && flux_feq(prev->height, el->height) && prev->grow == el->grow
+	    && prev->align_self == el->align_self && flux_insets_eq(prev->margin, el->margin);
+}
+
 /* Diff width/height/tooltip/grow/align/margin against prev; skip unchanged. */
 static void flux_apply_common(FluxBackendCtx *rt, XentNodeId id, XtkEl const *prev, XtkEl const *el) {
 	XentContext *ctx = rt->ctx;
 	if (prev ? !flux_feq(prev->width, el->width) : !isnan(el->width)) xent_set_width(ctx, id, el->width);
 	if (prev ? !flux_feq(prev->height, el->height) : !isnan(el->height)) xent_set_height(ctx, id, el->height);
+	/* Both extents pinned: a fixed-size card lays out its content on its own. */
+	bool pinned = !isnan(el->width) && !isnan(el->height);
+	if (pinned || !flux_el_text_input(el)) flux_node_store_set_layout_boundary(rt->store, id, pinned);
 	if (prev ? !flux_streq(prev->tooltip, el->tooltip) : el->tooltip != NULL)
 		flux_node_set_tooltip(rt->store, id, el->tooltip);
 	flux_apply_grow(ctx, id, prev, el);
@@ -458,9 +475,7 @@ static void flux_pp_slider(FluxBackendCtx *rt, XtkNode *n, XtkEl const *prev, Xt
 /* Sync textbox content only when it differs from the live control state. */
 static void flux_sync_textbox_content(FluxNodeStore *store, XentNodeId id, XtkEl const *el, bool password) {
 	if (!el->textbox.content) return;
-	FluxNodeData *nd    = flux_node_store_get(store, id);
-	char const *current = nd && nd->component_data ? (( FluxTextBoxData * ) nd->component_data)->content : NULL;
-	if (flux_streq(current, el->textbox.content)) return;
+	if (flux_streq(flux_textbox_get_content(store, id), el->textbox.content)) return;
 	if (password) flux_password_set_content(store, id, el->textbox.content);
 	else flux_textbox_set_content(store, id, el->textbox.content);
 }
@@ -844,12 +859,21 @@ static FluxPropsFn const kPropsTable [FLUX_CONTROL_TYPE_MAX] = {
 };
 
 void flux_apply_props(FluxBackendCtx *rt, XtkNode *n, XtkEl const *prev, XtkEl const *el) {
+	/* A re-rendered element may have moved or resized; a text input that kept
+	 * its box has only new text or chrome inside it. */
+	if (flux_el_text_input(el) && flux_el_same_box(prev, el))
+		flux_node_store_invalidate_node_layout(rt->store, n->node);
+	else flux_node_store_invalidate_layout(rt->store);
 	flux_apply_bindings(n, el);
+	/* A list row's height comes from its list once rows are measured; the
+	 * element only carries item_height, so the placement goes last. */
+	bool row = el->type == FLUX_CONTROL_LIST_ITEM;
+	if (row) flux_apply_common(rt, n->node, prev, el);
 	if (el->type < FLUX_CONTROL_TYPE_MAX) {
 		FluxPropsFn fn = kPropsTable [el->type];
 		if (fn) fn(rt, n, prev, el);
 	}
-	flux_apply_common(rt, n->node, prev, el);
+	if (!row) flux_apply_common(rt, n->node, prev, el);
 }
 
 /* Controls that need an FluxBinding (event wiring) during mount. */
@@ -359,8 +359,8 @@ static void content_scroll_sync(
 	WUC_Visual  *holder = flux_visual_tree_node_scroll_holder(r->vt, node);
 	if (!holder) return;
 
-	FluxNodeData   *nd = flux_node_store_get(store, node);
-	FluxScrollData *sd = nd ? ( FluxScrollData * ) nd->component_data : NULL;
+	FluxNodeData const   *nd = flux_node_store_get(store, node);
+	FluxScrollData const *sd = nd ? ( FluxScrollData const * ) nd->component_data : NULL;
 	if (!sd) return;
 
 	/* Virtualized hosts scroll by UI-thread rebase (small residual offsets
@@ -376,8 +376,9 @@ static void content_scroll_sync(
 
 	float px = 0.0f, py = 0.0f;
 	if (flux_interaction_poll(cn->tracker, &px, &py)) {
-		sd->scroll_x = px / scale;
-		sd->scroll_y = py / scale;
+		FluxScrollData *moved = ( FluxScrollData * ) flux_node_store_edit(store, node)->component_data;
+		moved->scroll_x       = px / scale;
+		moved->scroll_y       = py / scale;
 		if (anim_active) *anim_active = true;
 		return;
 	}
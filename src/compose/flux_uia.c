@@ -171,7 +171,7 @@ static FluxUiaControlInfo uia_control_info(FluxUia const *self) {
 	return kFluxUiaControls [t];
 }
 
-static FluxNodeData *uia_node_data(FluxUia const *self) {
+static FluxNodeData const *uia_node_data(FluxUia const *self) {
 	return self->info.store ? flux_node_store_get(self->info.store, self->node) : NULL;
 }
 
@@ -269,7 +269,7 @@ static void variant_set_i4(VARIANT *out, int value) {
 }
 
 static bool uia_has_focus(FluxUia *self) {
-	FluxNodeData *nd = uia_node_data(self);
+	FluxNodeData const *nd = uia_node_data(self);
 	return nd && nd->state.focused && GetFocus() == self->info.hwnd;
 }
 
@@ -475,7 +475,7 @@ static HRESULT STDMETHODCALLTYPE r_from_point(
 }
 
 static XentNodeId uia_find_focused(FluxUia *self, XentNodeId node) {
-	FluxNodeData *nd = self->info.store ? flux_node_store_get(self->info.store, node) : NULL;
+	FluxNodeData const *nd = self->info.store ? flux_node_store_get(self->info.store, node) : NULL;
 	if (nd && nd->state.focused) return node;
 
 	for (XentNodeId c = xent_get_first_child(self->info.ctx, node); c != XENT_NODE_INVALID;
@@ -503,10 +503,10 @@ static IRawElementProviderFragmentRootVtbl const g_root_vtbl = {
 };
 
 static HRESULT uia_invoke_behavior(FluxUia *self) {
-	FluxNodeData *nd = uia_node_data(self);
-	if (!nd || !nd->behavior.on_click) return UIA_E_INVALIDOPERATION;
+	FluxNodeData const *nd = uia_node_data(self);
+	if (!nd || !nd->behavior->on_click) return UIA_E_INVALIDOPERATION;
 	if (!xent_get_semantic_enabled(self->info.ctx, self->node)) return UIA_E_ELEMENTNOTENABLED;
-	nd->behavior.on_click(nd->behavior.on_click_ctx);
+	nd->behavior->on_click(nd->behavior->on_click_ctx);
 	return S_OK;
 }
 
@@ -642,11 +642,10 @@ static ULONG STDMETHODCALLTYPE val_addref(IValueProvider *p) { return uia_addref
 static ULONG STDMETHODCALLTYPE val_release(IValueProvider *p) { return uia_release_impl(SELF_VALUE(p)); }
 
 static char const             *uia_text_content(FluxUia *self) {
-	FluxNodeData *nd = uia_node_data(self);
+	FluxNodeData const *nd = uia_node_data(self);
 	if (!nd || !nd->component_data) return NULL;
 	if (nd->component_type == FLUX_CONTROL_PASSWORD_BOX) return ""; /* never expose secret text */
-	FluxTextBoxData const *tb = ( FluxTextBoxData const * ) nd->component_data;
-	return tb->content;
+	return flux_textbox_get_content(self->info.store, self->node);
 }
 
 static HRESULT STDMETHODCALLTYPE val_set_value(IValueProvider *p, LPCWSTR value) {
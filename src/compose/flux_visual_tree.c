@@ -93,8 +93,8 @@ static void tree_node_scroll(FluxVisualTree const *vt, XentNodeId node, float *s
 	*sx = 0.0f;
 	*sy = 0.0f;
 	if (!vt->store || flux_get_control_type(vt->ctx, node) != FLUX_CONTROL_SCROLL) return;
-	FluxNodeData   *nd = flux_node_store_get(vt->store, node);
-	FluxScrollData *sd = nd ? ( FluxScrollData * ) nd->component_data : NULL;
+	FluxNodeData const   *nd = flux_node_store_get(vt->store, node);
+	FluxScrollData const *sd = nd ? ( FluxScrollData const * ) nd->component_data : NULL;
 	if (!sd) return;
 	*sx = flux_scroll_off_x(sd);
 	*sy = flux_scroll_off_y(sd);
@@ -88,16 +88,12 @@ typedef struct FluxAsbRuntime {
 } FluxAsbRuntime;
 
 static FluxAsbRuntime *asb_runtime(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_AUTO_SUGGEST || !nd->component_data) return NULL;
 	return ( FluxAsbRuntime * ) nd->component_data;
 }
 
-static char const *asb_box_text(FluxAsbRuntime const *rt) {
-	FluxNodeData *nd = flux_node_store_get(rt->store, rt->textbox);
-	if (!nd || !nd->component_data) return NULL;
-	return (( FluxTextBoxData * ) nd->component_data)->content;
-}
+static char const *asb_box_text(FluxAsbRuntime const *rt) { return flux_textbox_get_content(rt->store, rt->textbox); }
 
 static void asb_write_box(FluxAsbRuntime *rt, char const *text) {
 	rt->ignore_text = true;
@@ -145,7 +141,7 @@ static void asb_ensure_visible(FluxAsbRuntime *rt, int i) {
 
 	rt->scroll_from       = rt->scroll_y;
 	rt->scroll_to         = target;
-	rt->scroll_anim_start = GetTickCount();
+	rt->scroll_anim_start = flux_anim_now();
 	flux_anim_register(rt, asb_scroll_step);
 }
 
@@ -266,7 +262,7 @@ static void asb_paint(void *ctx, FluxPopup *popup) {
 	float row_alpha = 1.0f;
 	float slide     = 0.0f;
 	if (rt->rows_anim_start) {
-		float ms  = ( float ) (GetTickCount() - rt->rows_anim_start);
+		float ms  = ( float ) (flux_anim_now() - rt->rows_anim_start);
 		row_alpha = (ms - ASB_POPIN_FADE_IN) / ASB_POPIN_FADE_LEN; /* linear, 83 ms delay */
 		if (row_alpha < 0.0f) row_alpha = 0.0f;
 		if (row_alpha > 1.0f) row_alpha = 1.0f;
@@ -315,7 +311,7 @@ static void asb_open_if_ready(FluxAsbRuntime *rt) {
 		/* Already showing: re-anchor for the new height and fade the new
 		 * rows in — no re-show, no replayed flyout animation. */
 		flux_popup_update_position(rt->popup);
-		rt->rows_anim_start = GetTickCount();
+		rt->rows_anim_start = flux_anim_now();
 		flux_anim_register(rt, asb_rows_anim_step);
 		asb_repaint(rt);
 		return;
@@ -486,7 +482,7 @@ static void asb_make_query_button(FluxAsbRuntime *rt, FluxAutoSuggestCreateInfo
 	xent_set_size(info->ctx, rt->button, (XentSize) {32.0f, 28.0f});
 	xent_set_flex_align_self(info->ctx, rt->button, XENT_FLEX_ALIGN_CENTER);
 	xent_set_margin(info->ctx, rt->button, (XentInsets) {2.0f, 0.0f, 0.0f, 0.0f});
-	FluxNodeData   *bnd = flux_node_store_get(info->store, rt->button);
+	FluxNodeData   *bnd = flux_node_store_edit(info->store, rt->button);
 	FluxButtonData *bd  = bnd ? ( FluxButtonData * ) bnd->component_data : NULL;
 	if (bd) bd->font_size = 12.0f; /* AutoSuggestBoxIconFontSize */
 }
@@ -497,7 +493,7 @@ XentNodeId flux_create_auto_suggest(FluxAutoSuggestCreateInfo const *info) {
 	XentNodeId root = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_AUTO_SUGGEST);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData   *nd = flux_node_store_get(info->store, root);
+	FluxNodeData   *nd = flux_node_store_edit(info->store, root);
 	FluxAsbRuntime *rt = nd ? ( FluxAsbRuntime * ) calloc(1, sizeof(*rt)) : NULL;
 	if (!nd || !rt) {
 		free(rt);
@@ -534,16 +530,16 @@ XentNodeId flux_create_auto_suggest(FluxAutoSuggestCreateInfo const *info) {
 
 	/* Steal the textbox's key handler; ours filters the suggestion-list
 	 * keys and forwards everything else (caret movement, editing). */
-	FluxNodeData *tnd = flux_node_store_get(info->store, rt->textbox);
+	FluxNodeData *tnd = flux_node_store_edit(info->store, rt->textbox);
 	if (tnd) {
-		rt->tb_on_key             = tnd->behavior.on_key;
-		rt->tb_on_key_ctx         = tnd->behavior.on_key_ctx;
-		tnd->behavior.on_key      = asb_on_key;
-		tnd->behavior.on_key_ctx  = rt;
-		tnd->behavior.on_focus     = asb_focus;
-		tnd->behavior.on_focus_ctx = rt;
-		tnd->behavior.on_blur      = asb_blur;
-		tnd->behavior.on_blur_ctx  = rt;
+		rt->tb_on_key             = tnd->behavior->on_key;
+		rt->tb_on_key_ctx         = tnd->behavior->on_key_ctx;
+		tnd->behavior->on_key      = asb_on_key;
+		tnd->behavior->on_key_ctx  = rt;
+		tnd->behavior->on_focus     = asb_focus;
+		tnd->behavior->on_focus_ctx = rt;
+		tnd->behavior->on_blur      = asb_blur;
+		tnd->behavior->on_blur_ctx  = rt;
 	}
 
 	asb_make_query_button(rt, info, root);
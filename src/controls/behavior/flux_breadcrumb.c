@@ -24,7 +24,7 @@
  * Left/Right move focus with the WinUI ellipsis jump rules (no wrap). */
 
 static FluxBreadcrumbBarData *bc_data(FluxNodeStore *store, XentNodeId bar) {
-	FluxNodeData *nd = flux_node_store_get(store, bar);
+	FluxNodeData *nd = flux_node_store_edit(store, bar);
 	if (!nd || nd->component_type != FLUX_CONTROL_BREADCRUMB_BAR) return NULL;
 	return ( FluxBreadcrumbBarData * ) nd->component_data;
 }
@@ -152,6 +152,7 @@ void flux_breadcrumb_bar_sync(XentContext *ctx, XentNodeId bar, struct FluxNodeD
 	if (!d->arrange_dirty && rect.w == d->last_avail) return;
 	d->last_avail = rect.w;
 	bc_arrange(d, rect.w);
+	flux_node_store_invalidate_layout(d->store);
 	bc_repaint(d); /* newly shown/hidden crumbs land in the next layout pass */
 }
 
@@ -212,7 +213,7 @@ static void bc_invoke(FluxBreadcrumbItem *it, FluxMenuInputKind input) {
 static void bc_item_click(void *ctx) {
 	FluxBreadcrumbItem    *it = ( FluxBreadcrumbItem * ) ctx;
 	FluxBreadcrumbBarData *d  = it->bar;
-	FluxNodeData          *nd = flux_node_store_get(d->store, it->node);
+	FluxNodeData          *nd = flux_node_store_edit(d->store, it->node);
 	float content_w = d->widths [it->elem] - (it->elem == d->count ? 0.0f : d->chevron_cell_w);
 	if (nd && nd->hover_local_x >= 0.0f && nd->hover_local_x > content_w) return;
 	bc_invoke(it, FLUX_MENU_INPUT_MOUSE);
@@ -258,7 +259,7 @@ static XentNodeId bc_make_item(FluxBreadcrumbBarData *d, int elem) {
 	XentNodeId node = flux_factory_create_node(d->ctx, d->store, d->root, FLUX_CONTROL_BREADCRUMB_ITEM);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData       *ind = flux_node_store_get(d->store, node);
+	FluxNodeData       *ind = flux_node_store_edit(d->store, node);
 	FluxBreadcrumbItem *it  = ind ? ( FluxBreadcrumbItem * ) calloc(1, sizeof(*it)) : NULL;
 	if (!ind || !it) {
 		free(it);
@@ -270,10 +271,10 @@ static XentNodeId bc_make_item(FluxBreadcrumbBarData *d, int elem) {
 
 	ind->component_data         = it;
 	ind->destroy_component_data = free;
-	ind->behavior.on_click      = bc_item_click;
-	ind->behavior.on_click_ctx  = it;
-	ind->behavior.on_key        = bc_item_key;
-	ind->behavior.on_key_ctx    = it;
+	ind->behavior->on_click      = bc_item_click;
+	ind->behavior->on_click_ctx  = it;
+	ind->behavior->on_key        = bc_item_key;
+	ind->behavior->on_key_ctx    = it;
 
 	xent_set_semantic_role(d->ctx, node, XENT_SEMANTIC_BUTTON);
 	xent_set_semantic_label(d->ctx, node, elem > 0 ? d->labels [elem - 1] : "More");
@@ -351,7 +352,7 @@ XentNodeId flux_create_breadcrumb_bar(FluxBreadcrumbBarCreateInfo const *info) {
 	XentNodeId root = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_BREADCRUMB_BAR);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData          *nd = flux_node_store_get(info->store, root);
+	FluxNodeData          *nd = flux_node_store_edit(info->store, root);
 	FluxBreadcrumbBarData *d  = nd ? ( FluxBreadcrumbBarData * ) calloc(1, sizeof(*d)) : NULL;
 	if (!nd || !d) {
 		free(d);
@@ -238,6 +238,7 @@ static void combo_update_layout_text(FluxComboRuntime *rt) {
 	if (!text || !text[0])
 		text = rt->model.placeholder;
 	xent_set_text(rt->ctx, rt->node, text);
+	flux_node_store_invalidate_layout(rt->store);
 }
 
 static void combo_close(FluxComboRuntime *rt) {
@@ -276,7 +277,7 @@ static void combo_open(FluxComboRuntime *rt) {
 
 	/* WinUI grows drop-down items for touch (ComboBoxItemThemeTouchPadding). The
 	 * device that opened the box decides the item height for this session. */
-	FluxNodeData *nd    = flux_node_store_get(rt->store, rt->node);
+	FluxNodeData *nd    = flux_node_store_edit(rt->store, rt->node);
 	bool          touch = nd && nd->state.pointer_type == 1;
 	rt->row_h           = touch ? CB_ROW_H_TOUCH : CB_ROW_H;
 
@@ -513,7 +514,7 @@ static char const **combo_copy_items(char const *const *items, int count) {
 }
 
 static FluxComboRuntime *combo_runtime(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_COMBO_BOX || !nd->component_data) return NULL;
 	return ( FluxComboRuntime * ) nd->component_data;
 }
@@ -542,6 +543,7 @@ static void combo_apply_min_width(FluxComboRuntime *rt) {
 		if (iw > w) w = iw;
 	}
 	xent_set_min_size(rt->ctx, rt->node, (XentSize) {w, 32.0f});
+	flux_node_store_invalidate_layout(rt->store);
 }
 
 void flux_combo_box_set_items(FluxNodeStore *store, XentNodeId id, char const *const *items, int count) {
@@ -575,7 +577,7 @@ XentNodeId flux_create_combo_box(FluxComboBoxCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_COMBO_BOX);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData     *nd = flux_node_store_get(info->store, node);
+	FluxNodeData     *nd = flux_node_store_edit(info->store, node);
 	FluxComboRuntime *rt = nd ? ( FluxComboRuntime * ) calloc(1, sizeof(*rt)) : NULL;
 	if (!nd || !rt) {
 		free(rt);
@@ -607,12 +609,12 @@ XentNodeId flux_create_combo_box(FluxComboBoxCreateInfo const *info) {
 
 	nd->component_data         = &rt->model;
 	nd->destroy_component_data = combo_destroy;
-	nd->behavior.on_click      = combo_on_click;
-	nd->behavior.on_click_ctx  = rt;
-	nd->behavior.on_key        = combo_on_key;
-	nd->behavior.on_key_ctx    = rt;
-	nd->behavior.on_char       = combo_on_char;
-	nd->behavior.on_char_ctx   = rt;
+	nd->behavior->on_click      = combo_on_click;
+	nd->behavior->on_click_ctx  = rt;
+	nd->behavior->on_key        = combo_on_key;
+	nd->behavior->on_key_ctx    = rt;
+	nd->behavior->on_char       = combo_on_char;
+	nd->behavior->on_char_ctx   = rt;
 
 	xent_set_focusable(info->ctx, node, true);
 	xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_BUTTON);
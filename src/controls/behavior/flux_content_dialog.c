@@ -49,7 +49,7 @@ struct FluxDialogRuntime {
 	void             *on_result_ctx;
 	FluxDialogButton  buttons [3];
 	bool              open;
-	DWORD             anim_start; /**< Entrance animation start tick (GetTickCount). */
+	DWORD             anim_start; /**< Entrance animation start tick (flux_anim_now). */
 };
 
 /* Entrance animation (DialogShowing): card scale 1.05->1.0 over 250ms with a
@@ -59,11 +59,17 @@ struct FluxDialogRuntime {
 #define DLG_FADE_MS  83.0f
 
 static FluxDialogRuntime *dialog_runtime(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_CONTENT_DIALOG) return NULL;
 	return ( FluxDialogRuntime * ) nd->component_data;
 }
 
+static FluxDialogRuntime const *dialog_read(FluxNodeStore *store, XentNodeId id) {
+	FluxNodeData const *nd = flux_node_store_get(store, id);
+	if (!nd || nd->component_type != FLUX_CONTROL_CONTENT_DIALOG) return NULL;
+	return ( FluxDialogRuntime const * ) nd->component_data;
+}
+
 static void dialog_repaint(FluxDialogRuntime *rt) {
 	HWND h = flux_window_hwnd(rt->window);
 	if (h) InvalidateRect(h, NULL, FALSE);
@@ -75,8 +81,8 @@ static float dialog_clamp01(float v) { return v < 0.0f ? 0.0f : v > 1.0f ? 1.0f
  * LayoutRoot — i.e. the scrim fades in with the card, not just the card. So scale
  * goes on the card and opacity on the dialog root (whose subtree is scrim + card). */
 static void  dialog_set_card_transform(FluxDialogRuntime *rt, float scale, float opacity) {
-	FluxNodeData *card = flux_node_store_get(rt->store, rt->card);
-	FluxNodeData *root = flux_node_store_get(rt->store, rt->root);
+	FluxNodeData *card = flux_node_store_edit(rt->store, rt->card);
+	FluxNodeData *root = flux_node_store_edit(rt->store, rt->root);
 	if (card) card->render_scale = scale;
 	if (root) root->render_opacity = opacity;
 }
@@ -102,7 +108,7 @@ static bool dialog_step(void *ctx, unsigned long now) {
 
 static void dialog_anim_start(FluxDialogRuntime *rt) {
 	dialog_set_card_transform(rt, 1.05f, 0.0f);
-	rt->anim_start = GetTickCount();
+	rt->anim_start = flux_anim_now();
 	flux_anim_register(rt, dialog_step);
 }
 
@@ -237,7 +243,7 @@ XentNodeId flux_create_content_dialog(FluxContentDialogCreateInfo const *info) {
 	XentNodeId root = flux_factory_create_node(info->ctx, info->store, XENT_NODE_INVALID, FLUX_CONTROL_CONTENT_DIALOG);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData      *nd = flux_node_store_get(info->store, root);
+	FluxNodeData      *nd = flux_node_store_edit(info->store, root);
 	FluxDialogRuntime *rt = nd ? ( FluxDialogRuntime * ) calloc(1, sizeof(*rt)) : NULL;
 	if (!nd || !rt) {
 		free(rt);
@@ -292,6 +298,6 @@ void flux_content_dialog_hide(FluxNodeStore *store, XentNodeId dialog) {
 }
 
 XentNodeId flux_content_dialog_content_node(FluxNodeStore *store, XentNodeId dialog) {
-	FluxDialogRuntime *rt = dialog_runtime(store, dialog);
+	FluxDialogRuntime const *rt = dialog_read(store, dialog);
 	return rt ? rt->content : XENT_NODE_INVALID;
 }
@@ -1,28 +1,29 @@
 #include "flux_control_cursor.h"
 
+#include "controls/textbox/tb_internal.h"
 #include "controls/textbox/tb_metrics.h"
 #include "fluxent/flux_component_data.h"
 #include "fluxent/flux_window.h"
 
 static int text_input_cursor(XentContext *ctx, FluxNodeStore *store, XentNodeId node) {
-	FluxNodeData *nd = flux_node_store_get(store, node);
+	FluxNodeData const *nd = flux_node_store_get(store, node);
 	if (!nd || nd->hover_local_x < 0.0f || !nd->state.focused) return FLUX_CURSOR_IBEAM;
 
 	XentRect rect = {0};
 	xent_get_layout_rect(ctx, node, &rect);
 
-	FluxTextBoxData *td = ( FluxTextBoxData * ) nd->component_data;
-	if (!td || !td->content || !td->content [0] || td->readonly) return FLUX_CURSOR_IBEAM;
+	FluxTextBoxInputData const *td = ( FluxTextBoxInputData const * ) nd->component_data;
+	if (!td || td->buf_len == 0 || td->base.readonly) return FLUX_CURSOR_IBEAM;
 
 	return nd->hover_local_x >= rect.w - FLUX_TEXTBOX_ACTION_BUTTON_W ? FLUX_CURSOR_ARROW : FLUX_CURSOR_IBEAM;
 }
 
 static int password_cursor(XentContext *ctx, FluxNodeStore *store, XentNodeId node) {
-	FluxNodeData *nd = flux_node_store_get(store, node);
+	FluxNodeData const *nd = flux_node_store_get(store, node);
 	if (!nd || !nd->state.focused) return FLUX_CURSOR_IBEAM;
 
-	FluxPasswordBoxData *pd = ( FluxPasswordBoxData * ) nd->component_data;
-	if (!pd || !pd->content || !pd->content [0]) return FLUX_CURSOR_IBEAM;
+	FluxTextBoxInputData const *pd = ( FluxTextBoxInputData const * ) nd->component_data;
+	if (!pd || pd->buf_len == 0) return FLUX_CURSOR_IBEAM;
 
 	XentRect rect = {0};
 	xent_get_layout_rect(ctx, node, &rect);
@@ -30,7 +31,7 @@ static int password_cursor(XentContext *ctx, FluxNodeStore *store, XentNodeId no
 }
 
 static int number_cursor(XentContext *ctx, FluxNodeStore *store, XentNodeId node) {
-	FluxNodeData *nd = flux_node_store_get(store, node);
+	FluxNodeData const *nd = flux_node_store_get(store, node);
 	if (!nd || nd->hover_local_x < 0.0f) return FLUX_CURSOR_IBEAM;
 
 	XentRect rect = {0};
@@ -42,8 +43,8 @@ static int number_cursor(XentContext *ctx, FluxNodeStore *store, XentNodeId node
 
 	if (!nd->state.focused) return FLUX_CURSOR_IBEAM;
 
-	FluxTextBoxData *td = ( FluxTextBoxData * ) nd->component_data;
-	if (!td || !td->content || !td->content [0] || td->readonly) return FLUX_CURSOR_IBEAM;
+	FluxTextBoxInputData const *td = ( FluxTextBoxInputData const * ) nd->component_data;
+	if (!td || td->buf_len == 0 || td->base.readonly) return FLUX_CURSOR_IBEAM;
 
 	float del_start = rect.w - FLUX_NUMBER_BOX_DELETE_BTN_W - spin_w;
 	return nd->hover_local_x >= del_start && nd->hover_local_x < del_start + FLUX_NUMBER_BOX_DELETE_BTN_W
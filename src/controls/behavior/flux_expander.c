@@ -24,12 +24,19 @@
 #define EXP_COLLAPSE_MS 167.0f
 
 static FluxExpanderData *expander_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd) return NULL;
 	if (nd->component_type != FLUX_CONTROL_EXPANDER && nd->component_type != FLUX_CONTROL_EXPANDER_HEADER) return NULL;
 	return ( FluxExpanderData * ) nd->component_data;
 }
 
+static FluxExpanderData const *expander_read(FluxNodeStore *store, XentNodeId id) {
+	FluxNodeData const *nd = flux_node_store_get(store, id);
+	if (!nd) return NULL;
+	if (nd->component_type != FLUX_CONTROL_EXPANDER && nd->component_type != FLUX_CONTROL_EXPANDER_HEADER) return NULL;
+	return ( FluxExpanderData const * ) nd->component_data;
+}
+
 static void expander_repaint(FluxExpanderData *d) {
 	HWND h = flux_window_hwnd(d->window);
 	if (h) InvalidateRect(h, NULL, FALSE);
@@ -38,7 +45,7 @@ static void expander_repaint(FluxExpanderData *d) {
 static float expander_clamp01(float v) { return v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v; }
 
 static void  expander_set_translate(FluxExpanderData *d, float dy) {
-	FluxNodeData *nd = flux_node_store_get(d->store, d->content);
+	FluxNodeData *nd = flux_node_store_edit(d->store, d->content);
 	if (nd) nd->render_translate_y = dy;
 }
 
@@ -52,6 +59,7 @@ static void expander_pin_height(FluxExpanderData *d) {
 	if (d->width <= 0.0f) return;
 	xent_set_min_size(d->ctx, d->root, (XentSize) {d->width, h});
 	xent_set_max_size(d->ctx, d->root, (XentSize) {d->width, h});
+	flux_node_store_invalidate_layout(d->store);
 }
 
 static void expander_anim_remove(FluxExpanderData *d) {
@@ -87,7 +95,7 @@ static void expander_anim_start(FluxExpanderData *d, bool expanding) {
 	if (expanding) xent_append_child(d->ctx, d->root, d->content);
 	d->anim_active    = true;
 	d->anim_expanding = expanding;
-	d->anim_start     = GetTickCount();
+	d->anim_start     = flux_anim_now();
 	expander_pin_height(d); /* reserve full height up-front; content slides within it */
 	expander_set_translate(d, expanding ? -d->content_height : 0.0f);
 	expander_repaint(d);
@@ -148,8 +156,8 @@ static void expander_setup_content(FluxExpanderData *d) {
  * its toggle behavior and expanded-state snapshot read the same pointer). NULL on OOM. */
 static FluxExpanderData *
 expander_make_runtime(FluxExpanderCreateInfo const *info, XentNodeId root, XentNodeId header, XentNodeId content) {
-	FluxNodeData     *root_nd = flux_node_store_get(info->store, root);
-	FluxNodeData     *hdr_nd  = flux_node_store_get(info->store, header);
+	FluxNodeData     *root_nd = flux_node_store_edit(info->store, root);
+	FluxNodeData     *hdr_nd  = flux_node_store_edit(info->store, header);
 	FluxExpanderData *d       = root_nd ? ( FluxExpanderData * ) calloc(1, sizeof(*d)) : NULL;
 	if (!root_nd || !hdr_nd || !d) {
 		free(d);
@@ -170,13 +178,13 @@ expander_make_runtime(FluxExpanderCreateInfo const *info, XentNodeId root, XentN
 	root_nd->component_data         = d;
 	root_nd->destroy_component_data = expander_destroy;
 	hdr_nd->component_data          = d;
-	hdr_nd->behavior.on_click       = expander_toggle;
-	hdr_nd->behavior.on_click_ctx   = d;
+	hdr_nd->behavior->on_click       = expander_toggle;
+	hdr_nd->behavior->on_click_ctx   = d;
 	return d;
 }
 
 static void expander_finalize(FluxExpanderData *d, FluxExpanderCreateInfo const *info) {
-	FluxNodeData *content_nd = flux_node_store_get(info->store, d->content);
+	FluxNodeData *content_nd = flux_node_store_edit(info->store, d->content);
 	if (content_nd) content_nd->render_clip_subtree = true;
 
 	if (info->header) {
@@ -213,12 +221,12 @@ XentNodeId flux_create_expander(FluxExpanderCreateInfo const *info) {
 }
 
 XentNodeId flux_expander_content_node(FluxNodeStore *store, XentNodeId id) {
-	FluxExpanderData *d = expander_data(store, id);
+	FluxExpanderData const *d = expander_read(store, id);
 	return d ? d->content : XENT_NODE_INVALID;
 }
 
 XentNodeId flux_expander_header_node(FluxNodeStore *store, XentNodeId id) {
-	FluxExpanderData *d = expander_data(store, id);
+	FluxExpanderData const *d = expander_read(store, id);
 	return d ? d->header : XENT_NODE_INVALID;
 }
 
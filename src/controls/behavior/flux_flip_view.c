@@ -23,11 +23,17 @@
 #define FLIP_BTN_MARGIN      1.0f
 
 static FluxFlipViewData *flip_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_FLIP_VIEW || !nd->component_data) return NULL;
 	return ( FluxFlipViewData * ) nd->component_data;
 }
 
+static FluxFlipViewData const *flip_read(FluxNodeStore *store, XentNodeId id) {
+	FluxNodeData const *nd = flux_node_store_get(store, id);
+	if (!nd || nd->component_type != FLUX_CONTROL_FLIP_VIEW || !nd->component_data) return NULL;
+	return ( FluxFlipViewData const * ) nd->component_data;
+}
+
 static int flip_page_count(FluxFlipViewData const *fv) {
 	int n = 0;
 	for (XentNodeId c = xent_get_first_child(fv->ctx, fv->host); c != XENT_NODE_INVALID;
@@ -70,7 +76,7 @@ static void flip_go(FluxFlipViewData *fv, int index, bool from_user) {
 	if (adjacent && fv->extent > 0.0f) {
 		fv->anim_from  = fv->offset;
 		fv->anim_to    = target;
-		fv->anim_start = GetTickCount();
+		fv->anim_start = flux_anim_now();
 		fv->anim       = true;
 		flux_anim_register(fv, flip_step);
 	}
@@ -118,7 +124,7 @@ static void flip_pointer_move(void *ctx, float x, float y) {
 	( void ) x;
 	( void ) y;
 	FluxFlipViewData *fv = ( FluxFlipViewData * ) ctx;
-	fv->pointer_activity = GetTickCount();
+	fv->pointer_activity = flux_anim_now();
 }
 
 static void flip_pointer_down(void *ctx, float x, float y, int clicks) {
@@ -135,7 +141,7 @@ static void flip_click(void *ctx) {
 	int hit              = nd ? flip_hit_button(fv, nd->hover_local_x, nd->hover_local_y) : 0;
 	if (hit && hit == fv->pressed_btn) {
 		flip_go(fv, fv->selected + (hit == 2 ? 1 : -1), true);
-		fv->pointer_activity = GetTickCount();
+		fv->pointer_activity = flux_anim_now();
 	}
 	fv->pressed_btn = 0;
 }
@@ -147,7 +153,7 @@ static bool flip_key(void *ctx, unsigned int vk, bool down) {
 	FluxFlipViewData *fv   = ( FluxFlipViewData * ) ctx;
 	int               prev = fv->vertical ? VK_UP : VK_LEFT;
 	int               next = fv->vertical ? VK_DOWN : VK_RIGHT;
-	fv->pointer_activity   = GetTickCount(); /* keyboard shows the buttons too */
+	fv->pointer_activity   = flux_anim_now(); /* keyboard shows the buttons too */
 
 	if (( int ) vk == prev) { flip_go(fv, fv->selected - 1, true); return true; }
 	if (( int ) vk == next) { flip_go(fv, fv->selected + 1, true); return true; }
@@ -160,7 +166,7 @@ bool flux_flip_view_handle_wheel(FluxNodeStore *store, XentNodeId flip, float wh
 	FluxFlipViewData *fv = flip_data(store, flip);
 	if (!fv) return false;
 
-	unsigned long now  = GetTickCount();
+	unsigned long now  = flux_anim_now();
 	int           sign = wheel_y < 0.0f ? -1 : 1;
 	bool can_flip      = sign != fv->wheel_sign || now - fv->last_wheel >= FLIP_WHEEL_GATE_MS;
 	fv->wheel_sign     = sign;
@@ -184,15 +190,26 @@ void flux_flip_view_sync(XentContext *ctx, XentNodeId flip, struct FluxNodeData
 	XentRect          root = {0};
 	if (!fv || !xent_get_layout_rect(ctx, fv->root, &root) || root.w <= 0.0f || root.h <= 0.0f) return;
 
-	float extent = fv->vertical ? root.h : root.w;
-	float cross  = fv->vertical ? root.w : root.h;
-	if (extent != fv->extent || cross != fv->cross) {
+	float extent  = fv->vertical ? root.h : root.w;
+	float cross   = fv->vertical ? root.w : root.h;
+	bool  resized = extent != fv->extent || cross != fv->cross;
+	if (resized) {
 		fv->extent = extent;
 		fv->cross  = cross;
 		if (!fv->anim) fv->offset = ( float ) fv->selected * extent; /* keep the page put on resize */
 		else fv->anim_to = ( float ) fv->selected * extent;
 	}
 
+	/* Placing the pages invalidates layout, so only do it when something moved. */
+	uint32_t pages = 1;
+	for (XentNodeId page = xent_get_first_child(ctx, fv->host); page != XENT_NODE_INVALID;
+	  page               = xent_get_next_sibling(ctx, page))
+		pages = pages * 31u + ( uint32_t ) page;
+	if (!resized && pages == fv->placed_pages && fv->offset == fv->placed_offset) return;
+	fv->placed_pages  = pages;
+	fv->placed_offset = fv->offset;
+	flux_node_store_invalidate_layout(fv->store);
+
 	int i = 0;
 	for (XentNodeId page = xent_get_first_child(ctx, fv->host); page != XENT_NODE_INVALID;
 	  page               = xent_get_next_sibling(ctx, page), i++)
@@ -222,7 +239,7 @@ XentNodeId flux_create_flip_view(FluxFlipViewCreateInfo const *info) {
 	XentNodeId root = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_FLIP_VIEW);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData     *nd = flux_node_store_get(info->store, root);
+	FluxNodeData     *nd = flux_node_store_edit(info->store, root);
 	FluxFlipViewData *fv = nd ? ( FluxFlipViewData * ) calloc(1, sizeof(FluxFlipViewData)) : NULL;
 	XentNodeId        host
 	  = fv ? flux_factory_create_node(info->ctx, info->store, root, FLUX_CONTROL_CONTAINER) : XENT_NODE_INVALID;
@@ -247,16 +264,16 @@ XentNodeId flux_create_flip_view(FluxFlipViewCreateInfo const *info) {
 	nd->component_data          = fv;
 	nd->destroy_component_data  = free;
 	nd->clips_children          = true; /* only the current page shows */
-	nd->behavior.on_pointer_move     = flip_pointer_move;
-	nd->behavior.on_pointer_move_ctx = fv;
-	nd->behavior.on_pointer_down     = flip_pointer_down;
-	nd->behavior.on_pointer_down_ctx = fv;
-	nd->behavior.on_click            = flip_click;
-	nd->behavior.on_click_ctx        = fv;
-	nd->behavior.on_cancel           = flip_cancel;
-	nd->behavior.on_cancel_ctx       = fv;
-	nd->behavior.on_key              = flip_key;
-	nd->behavior.on_key_ctx          = fv;
+	nd->behavior->on_pointer_move     = flip_pointer_move;
+	nd->behavior->on_pointer_move_ctx = fv;
+	nd->behavior->on_pointer_down     = flip_pointer_down;
+	nd->behavior->on_pointer_down_ctx = fv;
+	nd->behavior->on_click            = flip_click;
+	nd->behavior->on_click_ctx        = fv;
+	nd->behavior->on_cancel           = flip_cancel;
+	nd->behavior->on_cancel_ctx       = fv;
+	nd->behavior->on_key              = flip_key;
+	nd->behavior->on_key_ctx          = fv;
 
 	xent_set_focusable(info->ctx, root, true);
 	xent_set_semantic_role(info->ctx, root, XENT_SEMANTIC_CONTAINER);
@@ -264,7 +281,7 @@ XentNodeId flux_create_flip_view(FluxFlipViewCreateInfo const *info) {
 }
 
 XentNodeId flux_flip_view_content_node(FluxNodeStore *store, XentNodeId flip) {
-	FluxFlipViewData *fv = flip_data(store, flip);
+	FluxFlipViewData const *fv = flip_read(store, flip);
 	return fv ? fv->host : XENT_NODE_INVALID;
 }
 
@@ -16,7 +16,7 @@ static void compute_scroll_offset(XentContext *ctx, FluxNodeStore *store, XentNo
 			continue;
 		}
 
-		FluxNodeData   *pnd = flux_node_store_get(store, p);
+		FluxNodeData   *pnd = flux_node_store_edit(store, p);
 		FluxScrollData *sd  = pnd ? ( FluxScrollData * ) pnd->component_data : NULL;
 		if (sd) {
 			*out_x += flux_scroll_off_x(sd);
@@ -104,7 +104,7 @@ void flux_node_set_flyout(FluxNodeStore *store, XentNodeId id, FluxFlyout *flyou
 
 void flux_node_set_flyout_ex(FluxFlyoutBindingInfo const *info) {
 	if (!info || !info->store || !info->flyout) return;
-	FluxNodeData *nd = flux_node_store_get(info->store, info->id);
+	FluxNodeData *nd = flux_node_store_edit(info->store, info->id);
 	if (!nd) return;
 
 	FluxFlyoutBinding *b = ( FluxFlyoutBinding * ) calloc(1, sizeof(*b));
@@ -117,10 +117,10 @@ void flux_node_set_flyout_ex(FluxFlyoutBindingInfo const *info) {
 	b->ctx                    = info->xctx;
 	b->window                 = info->window;
 
-	nd->behavior.on_click     = flyout_on_click;
-	nd->behavior.on_click_ctx = b;
-	nd->behavior.on_key       = flyout_on_key;
-	nd->behavior.on_key_ctx   = b;
+	nd->behavior->on_click     = flyout_on_click;
+	nd->behavior->on_click_ctx = b;
+	nd->behavior->on_key       = flyout_on_key;
+	nd->behavior->on_key_ctx   = b;
 }
 
 typedef struct FluxContextMenuBinding {
@@ -179,7 +179,7 @@ void flux_node_set_menu_flyout(FluxNodeStore *store, XentNodeId id, FluxMenuFlyo
 
 void flux_node_set_menu_flyout_ex(FluxContextFlyoutBindingInfo const *info) {
 	if (!info || !info->store || !info->menu) return;
-	FluxNodeData *nd = flux_node_store_get(info->store, info->id);
+	FluxNodeData *nd = flux_node_store_edit(info->store, info->id);
 	if (!nd) return;
 
 	FluxContextMenuBinding *b = ( FluxContextMenuBinding * ) calloc(1, sizeof(*b));
@@ -191,15 +191,15 @@ void flux_node_set_menu_flyout_ex(FluxContextFlyoutBindingInfo const *info) {
 	b->ctx                    = info->xctx;
 	b->window                 = info->window;
 
-	nd->behavior.on_click     = menu_flyout_on_click;
-	nd->behavior.on_click_ctx = b;
-	nd->behavior.on_key       = menu_flyout_on_key;
-	nd->behavior.on_key_ctx   = b;
+	nd->behavior->on_click     = menu_flyout_on_click;
+	nd->behavior->on_click_ctx = b;
+	nd->behavior->on_key       = menu_flyout_on_key;
+	nd->behavior->on_key_ctx   = b;
 }
 
 void flux_node_set_context_flyout_ex(FluxContextFlyoutBindingInfo const *info) {
 	if (!info || !info->store || !info->menu) return;
-	FluxNodeData *nd = flux_node_store_get(info->store, info->id);
+	FluxNodeData *nd = flux_node_store_edit(info->store, info->id);
 	if (!nd) return;
 
 	FluxContextMenuBinding *b = ( FluxContextMenuBinding * ) calloc(1, sizeof(*b));
@@ -211,6 +211,6 @@ void flux_node_set_context_flyout_ex(FluxContextFlyoutBindingInfo const *info) {
 	b->ctx                           = info->xctx;
 	b->window                        = info->window;
 
-	nd->behavior.on_context_menu     = context_menu_on_context_binding;
-	nd->behavior.on_context_menu_ctx = b;
+	nd->behavior->on_context_menu     = context_menu_on_context_binding;
+	nd->behavior->on_context_menu_ctx = b;
 }
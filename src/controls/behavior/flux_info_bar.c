@@ -25,7 +25,7 @@ typedef struct FluxInfoBarBinding {
 } FluxInfoBarBinding;
 
 static FluxInfoBarData *info_bar_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_INFO_BAR) return NULL;
 	return ( FluxInfoBarData * ) nd->component_data;
 }
@@ -91,7 +91,7 @@ XentNodeId flux_create_info_bar(FluxInfoBarCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_INFO_BAR);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData       *nd = flux_node_store_get(info->store, node);
+	FluxNodeData       *nd = flux_node_store_edit(info->store, node);
 	FluxInfoBarData    *d  = nd ? ( FluxInfoBarData * ) calloc(1, sizeof(FluxInfoBarData)) : NULL;
 	FluxInfoBarBinding *b  = nd ? ( FluxInfoBarBinding * ) calloc(1, sizeof(*b)) : NULL;
 	if (!nd || !d || !b) {
@@ -115,12 +115,12 @@ XentNodeId flux_create_info_bar(FluxInfoBarCreateInfo const *info) {
 
 	nd->component_data               = d;
 	nd->destroy_component_data       = info_bar_destroy;
-	nd->behavior.on_pointer_down     = info_bar_on_pointer_down;
-	nd->behavior.on_pointer_down_ctx = b;
-	nd->behavior.on_click            = info_bar_on_click;
-	nd->behavior.on_click_ctx        = b;
-	nd->behavior.on_key              = info_bar_on_key;
-	nd->behavior.on_key_ctx          = b;
+	nd->behavior->on_pointer_down     = info_bar_on_pointer_down;
+	nd->behavior->on_pointer_down_ctx = b;
+	nd->behavior->on_click            = info_bar_on_click;
+	nd->behavior->on_click_ctx        = b;
+	nd->behavior->on_key              = info_bar_on_key;
+	nd->behavior->on_key_ctx          = b;
 
 	xent_set_size(info->ctx, node, (XentSize) {NAN, NAN});
 	xent_set_min_size(info->ctx, node, (XentSize) {0.0f, IB_MIN_HEIGHT});
@@ -148,6 +148,7 @@ void flux_info_bar_set_title(FluxNodeStore *store, XentNodeId id, char const *ti
 	if (!d) return;
 	flux_str_replace(&d->title, title);
 	ib_set_layout_text(( XentContext * ) d->layout_ctx, ( XentNodeId ) d->layout_node, d->title, d->message);
+	flux_node_store_invalidate_layout(store);
 }
 
 void flux_info_bar_set_message(FluxNodeStore *store, XentNodeId id, char const *message) {
@@ -155,6 +156,7 @@ void flux_info_bar_set_message(FluxNodeStore *store, XentNodeId id, char const *
 	if (!d) return;
 	flux_str_replace(&d->message, message);
 	ib_set_layout_text(( XentContext * ) d->layout_ctx, ( XentNodeId ) d->layout_node, d->title, d->message);
+	flux_node_store_invalidate_layout(store);
 }
 
 void flux_info_bar_set_open(FluxNodeStore *store, XentNodeId id, bool open) {
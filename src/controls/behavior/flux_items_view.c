@@ -38,7 +38,7 @@ XentNodeId flux_create_items_view(FluxItemsViewCreateInfo const *info) {
 	XentNodeId root = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_ITEMS_VIEW);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData      *nd = flux_node_store_get(info->store, root);
+	FluxNodeData      *nd = flux_node_store_edit(info->store, root);
 	FluxItemsViewData *d  = nd ? ( FluxItemsViewData * ) calloc(1, sizeof(FluxItemsViewData)) : NULL;
 	if (!nd || !d) {
 		free(d);
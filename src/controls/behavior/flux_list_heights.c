@@ -0,0 +1,157 @@
+#include "flux_list_heights.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static int heights_lowbit(int i) { return i & -i; }
+
+static void heights_tree_add(FluxListRowHeights *h, int row, double height, int measured) {
+	for (int i = row + 1; i <= h->count; i += heights_lowbit(i)) {
+		h->sum_tree [i]   += height;
+		h->count_tree [i] += measured;
+	}
+}
+
+static void heights_prefix(FluxListRowHeights const *h, int rows, double *sum, int *known) {
+	*sum   = 0.0;
+	*known = 0;
+	for (int i = rows; i > 0; i -= heights_lowbit(i)) {
+		*sum   += h->sum_tree [i];
+		*known += h->count_tree [i];
+	}
+}
+
+/* Grows the arrays geometrically; new rows start unmeasured. The trees grow
+ * first, as their extra room goes unused until capacity moves. measured goes
+ * last, so a failure never leaves it grown with an uninitialized tail. */
+static bool heights_reserve(FluxListRowHeights *h, int count) {
+	int old = h->measured ? h->capacity : 0;
+	if (h->measured && count <= old) return true;
+	int cap = old * 2 > count ? old * 2 : count;
+	if (cap < 64) cap = 64;
+	double *sum_tree = ( double * ) realloc(h->sum_tree, sizeof(double) * (( size_t ) cap + 1));
+	if (!sum_tree) return false;
+	h->sum_tree     = sum_tree;
+	int *count_tree = ( int * ) realloc(h->count_tree, sizeof(int) * (( size_t ) cap + 1));
+	if (!count_tree) return false;
+	h->count_tree   = count_tree;
+	float *measured = ( float * ) realloc(h->measured, sizeof(float) * ( size_t ) cap);
+	if (!measured) return false;
+	for (int i = old; i < cap; i++) measured [i] = -1.0f;
+	if (old == 0) {
+		memset(h->sum_tree, 0, sizeof(double) * (( size_t ) h->count + 1));
+		memset(h->count_tree, 0, sizeof(int) * (( size_t ) h->count + 1));
+	}
+	h->measured = measured;
+	h->capacity = cap;
+	return true;
+}
+
+void flux_list_heights_free(FluxListRowHeights *h) {
+	if (!h) return;
+	free(h->measured);
+	free(h->sum_tree);
+	free(h->count_tree);
+	h->measured       = NULL;
+	h->sum_tree       = NULL;
+	h->count_tree     = NULL;
+	h->capacity       = 0;
+	h->measured_count = 0;
+	h->measured_total = 0.0;
+}
+
+/* Appended rows get their tree nodes from prefix sums (O(log n) each), so a
+ * growing log never rebuilds; dropped rows only leave the totals. */
+bool flux_list_heights_resize(FluxListRowHeights *h, int count) {
+	if (!h || count < 0) return false;
+	if (h->measured && count > h->count) {
+		if (!heights_reserve(h, count)) return false;
+		for (int i = h->count + 1; i <= count; i++) {
+			double sum = 0.0, below_sum = 0.0;
+			int    known = 0, below_known = 0;
+			heights_prefix(h, i - 1, &sum, &known);
+			heights_prefix(h, i - heights_lowbit(i), &below_sum, &below_known);
+			h->sum_tree [i]   = sum - below_sum;
+			h->count_tree [i] = known - below_known;
+		}
+	}
+	for (int i = count; h->measured && i < h->count; i++) {
+		if (h->measured [i] < 0.0f) continue;
+		h->measured_count--;
+		h->measured_total -= h->measured [i];
+		h->measured [i]    = -1.0f;
+	}
+	h->count = count;
+	return true;
+}
+
+bool flux_list_heights_measure(FluxListRowHeights *h, int row, float height) {
+	if (!h || row < 0 || row >= h->count || height < 0.0f) return false;
+	if (!h->measured && !heights_reserve(h, h->count)) return false;
+	float old = h->measured [row];
+	if (old == height) return false;
+
+	h->measured [row] = height;
+	if (old < 0.0f) {
+		heights_tree_add(h, row, height, 1);
+		h->measured_count++;
+		h->measured_total += height;
+	}
+	else {
+		heights_tree_add(h, row, ( double ) height - old, 0);
+		h->measured_total += ( double ) height - old;
+	}
+	return true;
+}
+
+float flux_list_heights_estimate(FluxListRowHeights const *h) {
+	if (!h) return 0.0f;
+	return h->measured_count > 0 ? ( float ) (h->measured_total / h->measured_count) : h->fallback;
+}
+
+float flux_list_heights_row(FluxListRowHeights const *h, int row) {
+	if (!h) return 0.0f;
+	if (h->measured && row >= 0 && row < h->count && h->measured [row] >= 0.0f) return h->measured [row];
+	return flux_list_heights_estimate(h);
+}
+
+double flux_list_heights_offset(FluxListRowHeights const *h, int row) {
+	if (!h || row <= 0) return 0.0;
+	if (row > h->count) row = h->count;
+	double estimate = flux_list_heights_estimate(h);
+	if (!h->measured) return ( double ) row * estimate;
+
+	double sum   = 0.0;
+	int    known = 0;
+	heights_prefix(h, row, &sum, &known);
+	return sum + ( double ) (row - known) * estimate;
+}
+
+/* Fenwick descent on offset(i), which is monotone in i: each step tests
+ * whether the row after the next power-of-two block still starts at or before y. */
+int flux_list_heights_row_at(FluxListRowHeights const *h, double y) {
+	if (!h || h->count <= 0 || y <= 0.0) return 0;
+	double estimate = flux_list_heights_estimate(h);
+	int    row      = 0;
+	if (!h->measured) {
+		double rows = estimate > 0.0 ? y / estimate : 0.0;
+		row         = rows < ( double ) h->count ? ( int ) rows : h->count;
+	}
+	else {
+		int    step  = 1;
+		double sum   = 0.0;
+		int    known = 0;
+		while (step * 2 <= h->count) step *= 2;
+		for (; step > 0; step /= 2) {
+			int next = row + step;
+			if (next > h->count) continue;
+			double s = sum + h->sum_tree [next];
+			int    k = known + h->count_tree [next];
+			if (s + ( double ) (next - k) * estimate > y) continue;
+			row   = next;
+			sum   = s;
+			known = k;
+		}
+	}
+	return row < h->count ? row : h->count - 1;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file flux_list_heights.h
+ * @brief Prefix-sum index over variable list row heights (FluxListRowHeights).
+ * @note This is an internal header; do not include from public API.
+ */
+#ifndef FLUX_LIST_HEIGHTS_H
+#define FLUX_LIST_HEIGHTS_H
+
+#include "fluxent/flux_node_store.h"
+#include "fluxent/controls/flux_list_view_data.h"
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Release the arrays (the struct itself is embedded). */
+void   flux_list_heights_free(FluxListRowHeights *h);
+
+/** @brief Cover @p count rows; measurements below @p count are kept. O(n) once measured. */
+bool   flux_list_heights_resize(FluxListRowHeights *h, int count);
+
+/** @brief Record a measured height; false when unchanged (or on allocation failure). */
+bool   flux_list_heights_measure(FluxListRowHeights *h, int row, float height);
+
+/** @brief Height assumed for unmeasured rows: the measured average, else the fallback. */
+float  flux_list_heights_estimate(FluxListRowHeights const *h);
+
+/** @brief Height of @p row (measured or estimated). */
+float  flux_list_heights_row(FluxListRowHeights const *h, int row);
+
+/** @brief Top of @p row, 0 <= row <= count (count gives the total extent). */
+double flux_list_heights_offset(FluxListRowHeights const *h, int row);
+
+/** @brief Row containing @p y: the last row whose top is <= y, clamped to [0, count - 1]. */
+int    flux_list_heights_row_at(FluxListRowHeights const *h, double y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -16,27 +16,38 @@
  * extends from the anchor (Ctrl+Shift keeps other ranges in Extended);
  * Ctrl+A toggles select-all in Multiple/Extended; Escape does not clear.
  */
+#include "flux_list_heights.h"
 #include "controls/factory/flux_factory.h"
 #include "fluxent/fluxent.h"
 #include "fluxent/flux_input.h"
 
+#include <limits.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <windows.h>
 
+static bool list_node_is_list(FluxNodeData const *nd) {
+	if (!nd || !nd->component_data) return false;
+	return nd->component_type == FLUX_CONTROL_LIST || nd->component_type == FLUX_CONTROL_LIST_BOX
+	    || nd->component_type == FLUX_CONTROL_GRID_VIEW || nd->component_type == FLUX_CONTROL_ITEMS_REPEATER
+	    || nd->component_type == FLUX_CONTROL_ITEMS_VIEW;
+}
+
+/* For mutators: the lookup marks the list changed so its commands rebuild. */
 static FluxListViewData *list_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
-	if (!nd || !nd->component_data) return NULL;
-	if (nd->component_type != FLUX_CONTROL_LIST && nd->component_type != FLUX_CONTROL_LIST_BOX
-	    && nd->component_type != FLUX_CONTROL_GRID_VIEW && nd->component_type != FLUX_CONTROL_ITEMS_REPEATER
-	    && nd->component_type != FLUX_CONTROL_ITEMS_VIEW)
-		return NULL;
-	return ( FluxListViewData * ) nd->component_data;
+	if (!list_node_is_list(flux_node_store_get(store, id))) return NULL;
+	return ( FluxListViewData * ) flux_node_store_edit(store, id)->component_data;
+}
+
+/* For queries: a plain read that leaves the list's recorded commands reusable. */
+static FluxListViewData const *list_read(FluxNodeStore *store, XentNodeId id) {
+	FluxNodeData const *nd = flux_node_store_get(store, id);
+	return list_node_is_list(nd) ? ( FluxListViewData const * ) nd->component_data : NULL;
 }
 
 static FluxListItemData *item_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_LIST_ITEM || !nd->component_data) return NULL;
 	return ( FluxListItemData * ) nd->component_data;
 }
@@ -54,7 +65,10 @@ static FluxControlType list_type_for_kind(XtkListKind kind) {
  * Selection ranges (sorted, inclusive, merged)
  * ---------------------------------------------------------------------- */
 
-static void ranges_clear(FluxListViewData *ld) { ld->range_count = 0; }
+static void ranges_clear(FluxListViewData *ld) {
+	ld->range_count = 0;
+	ld->range_total = 0;
+}
 
 static bool ranges_reserve(FluxListViewData *ld, int count) {
 	if (count <= ld->range_cap) return true;
@@ -67,62 +81,142 @@ static bool ranges_reserve(FluxListViewData *ld, int count) {
 	return true;
 }
 
+static int range_span(FluxListSelRange r) { return r.last - r.first + 1; }
+
+/* First run ending at or after index (range_count when none): the runs are
+ * sorted and disjoint, so their ends are strictly increasing. */
+static int ranges_lower_bound(FluxListViewData const *ld, int index) {
+	int lo = 0, hi = ld->range_count;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (ld->ranges [mid].last < index) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
 static bool ranges_contains(FluxListViewData const *ld, int index) {
-	for (int i = 0; i < ld->range_count; i++)
-		if (index >= ld->ranges [i].first && index <= ld->ranges [i].last) return true;
-	return false;
+	int i = ranges_lower_bound(ld, index);
+	return i < ld->range_count && ld->ranges [i].first <= index;
+}
+
+/* Append a run past the current last one (bulk builders emit in order). */
+static bool ranges_push(FluxListViewData *ld, int first, int last) {
+	if (ld->range_count > 0 && ld->ranges [ld->range_count - 1].last >= first - 1) {
+		FluxListSelRange *tail  = &ld->ranges [ld->range_count - 1];
+		ld->range_total        += last - tail->last;
+		tail->last              = last;
+		return true;
+	}
+	if (!ranges_reserve(ld, ld->range_count + 1)) return false;
+	ld->ranges [ld->range_count++]  = (FluxListSelRange) {first, last};
+	ld->range_total                += last - first + 1;
+	return true;
 }
 
 /* Insert [first,last] and merge overlapping/adjacent runs (list stays sorted). */
-static void ranges_add(FluxListViewData *ld, int first, int last) {
-	if (!ranges_reserve(ld, ld->range_count + 1)) return;
+static bool ranges_add(FluxListViewData *ld, int first, int last) {
+	if (!ranges_reserve(ld, ld->range_count + 1)) return false;
 
-	int pos = 0;
-	while (pos < ld->range_count && ld->ranges [pos].last < first - 1) pos++;
+	int pos = ranges_lower_bound(ld, first - 1);
 
 	int merged_first = first, merged_last = last;
-	int span = 0;
+	int span = 0, covered = 0;
 	while (pos + span < ld->range_count && ld->ranges [pos + span].first <= last + 1) {
 		if (ld->ranges [pos + span].first < merged_first) merged_first = ld->ranges [pos + span].first;
 		if (ld->ranges [pos + span].last > merged_last) merged_last = ld->ranges [pos + span].last;
+		covered += range_span(ld->ranges [pos + span]);
 		span++;
 	}
 
 	memmove(&ld->ranges [pos + 1], &ld->ranges [pos + span], sizeof(*ld->ranges) * ( size_t ) (ld->range_count - pos - span));
 	ld->ranges [pos]  = (FluxListSelRange) {merged_first, merged_last};
 	ld->range_count  += 1 - span;
+	ld->range_total  += merged_last - merged_first + 1 - covered;
+	return true;
 }
 
-/* Split the run at slot i in two around index (which sits strictly inside). */
-static void ranges_split(FluxListViewData *ld, int i, int index) {
-	if (!ranges_reserve(ld, ld->range_count + 1)) return;
-	memmove(&ld->ranges [i + 1], &ld->ranges [i], sizeof(*ld->ranges) * ( size_t ) (ld->range_count - i));
-	ld->ranges [i].last      = index - 1;
-	ld->ranges [i + 1].first = index + 1;
-	ld->range_count++;
+/* Remove [first,last] from the set: runs inside it drop out, runs straddling
+ * an end are trimmed, and a run enclosing it splits in two (the only case
+ * that allocates, so the only one that can fail). */
+static bool ranges_remove_span(FluxListViewData *ld, int first, int last) {
+	int i = ranges_lower_bound(ld, first);
+	if (i == ld->range_count || ld->ranges [i].first > last) return true;
+
+	FluxListSelRange *r = &ld->ranges [i];
+	if (r->first < first && r->last > last) {
+		if (!ranges_reserve(ld, ld->range_count + 1)) return false;
+		r = &ld->ranges [i];
+		memmove(&ld->ranges [i + 1], &ld->ranges [i], sizeof(*r) * ( size_t ) (ld->range_count - i));
+		ld->ranges [i].last      = first - 1;
+		ld->ranges [i + 1].first = last + 1;
+		ld->range_count++;
+		ld->range_total -= last - first + 1;
+		return true;
+	}
+	if (r->first < first) {
+		ld->range_total -= r->last - first + 1;
+		r->last          = first - 1;
+		i++;
+	}
+
+	int drop = 0;
+	while (i + drop < ld->range_count && ld->ranges [i + drop].last <= last) {
+		ld->range_total -= range_span(ld->ranges [i + drop]);
+		drop++;
+	}
+	if (i + drop < ld->range_count && ld->ranges [i + drop].first <= last) {
+		ld->range_total             -= last - ld->ranges [i + drop].first + 1;
+		ld->ranges [i + drop].first  = last + 1;
+	}
+	memmove(&ld->ranges [i], &ld->ranges [i + drop], sizeof(*r) * ( size_t ) (ld->range_count - i - drop));
+	ld->range_count -= drop;
+	return true;
 }
 
-/* Remove index from the set, splitting its run when it sits inside one. */
-static void ranges_remove(FluxListViewData *ld, int index) {
-	int i = 0;
-	while (i < ld->range_count && (index < ld->ranges [i].first || index > ld->ranges [i].last)) i++;
-	if (i == ld->range_count) return;
+static bool ranges_remove(FluxListViewData *ld, int index) { return ranges_remove_span(ld, index, index); }
 
-	FluxListSelRange *r = &ld->ranges [i];
-	if (r->first == r->last) {
-		memmove(&ld->ranges [i], &ld->ranges [i + 1], sizeof(*r) * ( size_t ) (ld->range_count - i - 1));
-		ld->range_count--;
-		return;
+/* Bulk builders rebuild the set from the old runs into a fresh array; on
+ * failure the old set is put back, so the selection is left unchanged. */
+typedef struct RangesSaved {
+	FluxListSelRange *ranges;
+	int               count;
+	int               cap;
+	int               total;
+} RangesSaved;
+
+static RangesSaved ranges_detach(FluxListViewData *ld) {
+	RangesSaved saved = {ld->ranges, ld->range_count, ld->range_cap, ld->range_total};
+	ld->ranges        = NULL;
+	ld->range_cap     = 0;
+	ranges_clear(ld);
+	return saved;
+}
+
+static bool ranges_finish(FluxListViewData *ld, RangesSaved *saved, bool ok) {
+	if (ok) {
+		free(saved->ranges);
+		return true;
 	}
-	if (index == r->first) { r->first++; return; }
-	if (index == r->last) { r->last--; return; }
-	ranges_split(ld, i, index);
+	free(ld->ranges);
+	ld->ranges      = saved->ranges;
+	ld->range_count = saved->count;
+	ld->range_cap   = saved->cap;
+	ld->range_total = saved->total;
+	return false;
 }
 
-static int ranges_total(FluxListViewData const *ld) {
-	int n = 0;
-	for (int i = 0; i < ld->range_count; i++) n += ld->ranges [i].last - ld->ranges [i].first + 1;
-	return n;
+/* Complement over [0, count): the gaps between runs become the new runs. */
+static bool ranges_invert(FluxListViewData *ld, int count) {
+	RangesSaved old  = ranges_detach(ld);
+	bool        ok   = true;
+	int         next = 0;
+	for (int i = 0; i < old.count && ok; i++) {
+		if (old.ranges [i].first > next) ok = ranges_push(ld, next, old.ranges [i].first - 1);
+		next = old.ranges [i].last + 1;
+	}
+	if (ok && next < count) ok = ranges_push(ld, next, count - 1);
+	return ranges_finish(ld, &old, ok);
 }
 
 /* -------------------------------------------------------------------------
@@ -226,12 +320,40 @@ static void list_gesture_secondary(FluxListViewData *ld, int index) {
  * Keyboard navigation + scroll-into-view
  * ---------------------------------------------------------------------- */
 
+/* Row geometry: list rows stack at their measured (or estimated) heights
+ * through the prefix-sum index; grid rows keep the uniform item_height pitch. */
+static float list_row_offset(FluxListViewData const *ld, int row) {
+	if (ld->cols > 1) return ( float ) row * ld->item_height;
+	return ( float ) flux_list_heights_offset(&ld->heights, row);
+}
+
+static float list_row_height(FluxListViewData const *ld, int row) {
+	return ld->cols > 1 ? ld->item_height : flux_list_heights_row(&ld->heights, row);
+}
+
+/* Row containing content offset y. */
+static int list_row_at(FluxListViewData const *ld, float y) {
+	if (ld->cols <= 1) return flux_list_heights_row_at(&ld->heights, y);
+	int row = ld->item_height > 0.0f ? ( int ) floorf(y / ld->item_height) : 0;
+	return row > 0 ? row : 0;
+}
+
+/* Last row starting before y: the row that begins exactly at a viewport's
+ * bottom edge is not visible. */
+static int list_row_before(FluxListViewData const *ld, float y) {
+	int row = list_row_at(ld, y);
+	if (row > 0 && list_row_offset(ld, row) >= y) row--;
+	return row;
+}
+
+static bool list_rows_varied(FluxListViewData const *ld) { return ld->cols <= 1 && ld->heights.measured_count > 0; }
+
 static bool list_viewport_metrics(FluxListViewData const *ld, float *offset, float *extent) {
-	FluxNodeData *snd  = flux_node_store_get(ld->store, ld->scroll);
-	XentRect      rect = {0};
+	FluxNodeData const *snd  = flux_node_store_get(ld->store, ld->scroll);
+	XentRect            rect = {0};
 	if (!snd || !snd->component_data || !xent_get_layout_rect(ld->ctx, ld->scroll, &rect) || rect.h <= 0.0f)
 		return false;
-	*offset = (( FluxScrollData * ) snd->component_data)->scroll_y;
+	*offset = (( FluxScrollData const * ) snd->component_data)->scroll_y;
 	*extent = rect.h;
 	return true;
 }
@@ -245,10 +367,11 @@ void flux_list_view_scroll_into_view(FluxNodeStore *store, XentNodeId list, int
 	if (!list_viewport_metrics(ld, &offset, &extent)) return;
 
 	int   cols  = ld->cols > 0 ? ld->cols : 1;
-	float y     = ( float ) (index / cols) * ld->item_height;
+	float y     = list_row_offset(ld, index / cols);
+	float h     = list_row_height(ld, index / cols);
 	float new_y = offset;
 	if (y < offset) new_y = y;
-	else if (y + ld->item_height > offset + extent) new_y = y + ld->item_height - extent;
+	else if (y + h > offset + extent) new_y = y + h - extent;
 	if (new_y != offset) flux_scroll_set_offset(store, ld->scroll, 0.0f, new_y);
 }
 
@@ -288,7 +411,8 @@ static int list_nav_target(FluxListViewData const *ld, int from, int vk) {
 	float extent = 0.0f, offset = 0.0f;
 	int   page_rows = 8;
 	if (list_viewport_metrics(ld, &offset, &extent) && ld->item_height > 0.0f)
-		page_rows = ( int ) (extent / ld->item_height);
+		page_rows = cols > 1 ? ( int ) (extent / ld->item_height)
+		                     : list_row_before(ld, offset + extent) - list_row_at(ld, offset) + 1;
 	if (page_rows < 1) page_rows = 1;
 
 	switch (vk) {
@@ -385,6 +509,7 @@ static void list_view_data_destroy(void *component_data) {
 	FluxListViewData *ld = ( FluxListViewData * ) component_data;
 	if (!ld) return;
 	free(ld->ranges);
+	flux_list_heights_free(&ld->heights);
 	free(ld);
 }
 
@@ -395,7 +520,7 @@ XentNodeId flux_create_list_view(FluxListViewCreateInfo const *info) {
 	XentNodeId      root = flux_factory_create_node(info->ctx, info->store, info->parent, type);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData     *nd = flux_node_store_get(info->store, root);
+	FluxNodeData     *nd = flux_node_store_edit(info->store, root);
 	FluxListViewData *ld = nd ? ( FluxListViewData * ) calloc(1, sizeof(FluxListViewData)) : NULL;
 	if (!nd || !ld) {
 		free(ld);
@@ -425,6 +550,9 @@ XentNodeId flux_create_list_view(FluxListViewCreateInfo const *info) {
 	xent_set_width_percent(info->ctx, host, 1.0f);
 	xent_set_height(info->ctx, host, 0.0f);
 	xent_set_flex_shrink(info->ctx, host, 0.0f);
+	/* Width from the scroll, height from list_place_realized: placing cells
+	 * inside it never moves anything outside. */
+	flux_node_store_set_layout_boundary(info->store, host, true);
 
 	ld->ctx                  = info->ctx;
 	ld->store                = info->store;
@@ -455,7 +583,7 @@ XentNodeId flux_create_list_item(FluxListItemCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_LIST_ITEM);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData     *nd = flux_node_store_get(info->store, node);
+	FluxNodeData     *nd = flux_node_store_edit(info->store, node);
 	FluxListItemData *it = nd ? ( FluxListItemData * ) calloc(1, sizeof(FluxListItemData)) : NULL;
 	if (!nd || !it) {
 		free(it);
@@ -473,10 +601,10 @@ XentNodeId flux_create_list_item(FluxListItemCreateInfo const *info) {
 
 	bool interactive = !it->owner || it->owner->kind != XTK_LIST_KIND_REPEATER;
 	if (interactive) {
-		nd->behavior.on_click     = list_item_on_click;
-		nd->behavior.on_click_ctx = it;
-		nd->behavior.on_key       = list_item_on_key;
-		nd->behavior.on_key_ctx   = it;
+		nd->behavior->on_click     = list_item_on_click;
+		nd->behavior->on_click_ctx = it;
+		nd->behavior->on_key       = list_item_on_key;
+		nd->behavior->on_key_ctx   = it;
 		xent_set_focusable(info->ctx, node, true);
 		xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_BUTTON);
 	}
@@ -508,19 +636,19 @@ XentNodeId flux_create_list_item(FluxListItemCreateInfo const *info) {
  * ---------------------------------------------------------------------- */
 
 XentNodeId flux_list_view_content_node(FluxNodeStore *store, XentNodeId list) {
-	FluxListViewData *ld = list_data(store, list);
+	FluxListViewData const *ld = list_read(store, list);
 	return ld ? ld->host : XENT_NODE_INVALID;
 }
 
 static FluxScrollData *list_scroll_data(FluxListViewData const *ld) {
-	FluxNodeData *snd = flux_node_store_get(ld->store, ld->scroll);
+	FluxNodeData *snd = flux_node_store_edit(ld->store, ld->scroll);
 	return snd ? ( FluxScrollData * ) snd->component_data : NULL;
 }
 
-/* Virtual extent: the rows × item_height content exists only as the scroll's
- * manual logical extent (scrollbar + clamping). The host stays a small
- * physical canvas spanning just the realized window (set_realized), so the
- * compositor / hit paths never see deep-scroll coordinates. */
+/* Virtual extent: the stacked rows exist only as the scroll's manual logical
+ * extent (scrollbar + clamping). The host stays a small physical canvas
+ * spanning just the realized window (set_realized), so the compositor / hit
+ * paths never see deep-scroll coordinates. */
 static void list_apply_host_extent(FluxListViewData *ld) {
 	int cols = ld->cols > 0 ? ld->cols : 1;
 	int rows = cols > 0 ? (ld->count + cols - 1) / cols : ld->count;
@@ -529,7 +657,7 @@ static void list_apply_host_extent(FluxListViewData *ld) {
 	sd->content_manual = 1;
 	sd->virtualized    = 1;
 	sd->content_w      = 0.0f;
-	sd->content_h      = ( float ) rows * ld->item_height;
+	sd->content_h      = list_row_offset(ld, rows);
 }
 
 void flux_list_view_set_extent(
@@ -542,11 +670,17 @@ void flux_list_view_set_extent(
 	if (ld->count == count && ld->item_height == item_height && ld->item_width == item_width
 	    && ld->columns == columns)
 		return;
-	ld->count       = count;
-	ld->item_height = item_height;
-	ld->item_width  = item_width;
-	ld->columns     = columns;
+	ld->count            = count;
+	ld->item_height      = item_height;
+	ld->item_width       = item_width;
+	ld->columns          = columns;
+	ld->heights.fallback = item_height;
+	/* Items past the new end can no longer be selected or anchor a range. */
+	ranges_remove_span(ld, count, INT_MAX);
+	if (ld->anchor >= count) ld->anchor_set = false;
+	flux_list_heights_resize(&ld->heights, count);
 	list_apply_host_extent(ld);
+	flux_node_store_invalidate_layout(store);
 }
 
 void flux_list_view_set_sel_mode(FluxNodeStore *store, XentNodeId list, XtkListSelMode mode) {
@@ -563,17 +697,104 @@ void flux_list_view_set_selected(FluxNodeStore *store, XentNodeId list, int sele
 }
 
 bool flux_list_view_is_selected(FluxNodeStore *store, XentNodeId list, int index) {
-	FluxListViewData *ld = list_data(store, list);
+	FluxListViewData const *ld = list_read(store, list);
 	if (!ld) return false;
 	if (ld->sel_mode == XTK_LIST_SELECT_SINGLE) return index == ld->selected;
 	return ranges_contains(ld, index);
 }
 
 int flux_list_view_selection_count(FluxNodeStore *store, XentNodeId list) {
-	FluxListViewData *ld = list_data(store, list);
+	FluxListViewData const *ld = list_read(store, list);
 	if (!ld) return 0;
 	if (ld->sel_mode == XTK_LIST_SELECT_SINGLE) return ld->selected >= 0 ? 1 : 0;
-	return ranges_total(ld);
+	return ld->range_total;
+}
+
+/* The reconciler lays rows out at index × item_height; with measured heights
+ * a row's slot comes from the prefix-sum index instead, and so does its size. */
+static void list_item_apply_row(FluxListViewData const *ld, XentNodeId item, FluxListItemData *it) {
+	if (!list_rows_varied(ld) || it->index < 0) return;
+	it->logical_y = list_row_offset(ld, it->index);
+	xent_set_height(ld->ctx, item, list_row_height(ld, it->index));
+}
+
+/* Rebase the physical window: origin = first realized row's logical y, host
+ * spans just the realized rows. Retained cells that kept their logical slot
+ * are re-anchored (the reconciler only re-places changed ones), so physical
+ * coordinates never grow with scroll depth. Measured heights move every
+ * realized row, so those are re-placed even when the origin holds. */
+static void list_place_realized(FluxListViewData *ld) {
+	int   c         = ld->cols > 0 ? ld->cols : 1;
+	int   first     = ld->realized_first;
+	int   last      = ld->realized_last;
+	int   row_first = first / c;
+	float origin    = list_row_offset(ld, row_first);
+	float span      = last >= first ? list_row_offset(ld, last / c + 1) - origin : 0.0f;
+	xent_set_height(ld->ctx, ld->host, span);
+	flux_node_store_invalidate_layout(ld->store);
+
+	FluxScrollData *sd = list_scroll_data(ld);
+	if (!sd || (sd->origin_y == origin && !list_rows_varied(ld))) return;
+	sd->origin_y = origin;
+	for (XentNodeId child = xent_get_first_child(ld->ctx, ld->host); child != XENT_NODE_INVALID;
+	  child               = xent_get_next_sibling(ld->ctx, child))
+	{
+		FluxListItemData *it = item_data(ld->store, child);
+		if (!it || it->index < 0) continue;
+		list_item_apply_row(ld, child, it);
+		xent_set_absolute_position(ld->ctx, child, (XentPoint) {it->logical_x - sd->origin_x, it->logical_y - origin});
+	}
+}
+
+/* Bulk selection (Multiple/Extended): one change report per call, with the
+ * last selected index as the lead (-1 when the set ends up empty). */
+static void list_report_bulk(FluxListViewData *ld) {
+	list_report(ld, ld->range_count ? ld->ranges [ld->range_count - 1].last : -1);
+}
+
+bool flux_list_view_select_range(FluxNodeStore *store, XentNodeId list, int first, int last, bool selected) {
+	FluxListViewData *ld = list_data(store, list);
+	if (!ld || !multi_mode(ld)) return false;
+	if (first < 0) first = 0;
+	if (last > ld->count - 1) last = ld->count - 1;
+	if (first > last) return true;
+	if (!(selected ? ranges_add(ld, first, last) : ranges_remove_span(ld, first, last))) return false;
+	list_report_bulk(ld);
+	return true;
+}
+
+bool flux_list_view_invert_selection(FluxNodeStore *store, XentNodeId list) {
+	FluxListViewData *ld = list_data(store, list);
+	if (!ld || !multi_mode(ld)) return false;
+	if (!ranges_invert(ld, ld->count)) return false;
+	list_report_bulk(ld);
+	return true;
+}
+
+/* One pass over the items, emitting runs in order, so the cost is O(count)
+ * whatever the shape of the result. Adds to the existing selection. */
+bool flux_list_view_select_where(
+  FluxNodeStore *store, XentNodeId list, bool (*pred)(void *ctx, int index), void *ctx
+) {
+	FluxListViewData *ld = list_data(store, list);
+	if (!ld || !pred || !multi_mode(ld)) return false;
+
+	RangesSaved old = ranges_detach(ld);
+	bool        ok  = true;
+	int         o = 0, run = -1;
+	for (int i = 0; i < ld->count && ok; i++) {
+		while (o < old.count && old.ranges [o].last < i) o++;
+		bool on = (o < old.count && old.ranges [o].first <= i) || pred(ctx, i);
+		if (on && run < 0) run = i;
+		if (!on && run >= 0) {
+			ok  = ranges_push(ld, run, i - 1);
+			run = -1;
+		}
+	}
+	if (ok && run >= 0) ok = ranges_push(ld, run, ld->count - 1);
+	if (!ranges_finish(ld, &old, ok)) return false;
+	list_report_bulk(ld);
+	return true;
 }
 
 void flux_list_view_set_realized(FluxNodeStore *store, XentNodeId list, int first, int last, int cols) {
@@ -586,29 +807,35 @@ void flux_list_view_set_realized(FluxNodeStore *store, XentNodeId list, int firs
 		ld->cols = cols;
 		list_apply_host_extent(ld);
 	}
+	list_place_realized(ld);
+}
 
-	/* Rebase the physical window: origin = first realized row's logical y, host
-	 * spans just the realized rows. Retained cells that kept their logical slot
-	 * are re-anchored (the reconciler only re-places changed ones), so physical
-	 * coordinates never grow with scroll depth. */
-	int   c         = ld->cols > 0 ? ld->cols : 1;
-	int   row_first = first / c;
-	float span      = last >= first ? ( float ) (last / c - row_first + 1) * ld->item_height : 0.0f;
-	float origin    = ( float ) row_first * ld->item_height;
-	xent_set_height(ld->ctx, ld->host, span);
+/* Measurements above the viewport shift everything below them; the first
+ * visible row keeps its screen position (scroll anchoring), so content the
+ * user is reading does not jump while estimates are refined. */
+void flux_list_view_set_row_height(FluxNodeStore *store, XentNodeId list, int index, float height) {
+	FluxListViewData *ld = list_data(store, list);
+	if (!ld || ld->cols > 1 || index < 0 || index >= ld->count) return;
 
-	FluxScrollData *sd = list_scroll_data(ld);
-	if (!sd || sd->origin_y == origin) return;
-	sd->origin_y = origin;
-	for (XentNodeId child = xent_get_first_child(ld->ctx, ld->host); child != XENT_NODE_INVALID;
-	  child               = xent_get_next_sibling(ld->ctx, child))
-	{
-		FluxListItemData *it = item_data(store, child);
-		if (it && it->index >= 0)
-			xent_set_absolute_position(
-			  ld->ctx, child, (XentPoint) {it->logical_x - sd->origin_x, it->logical_y - origin}
-			);
+	FluxScrollData *sd     = list_scroll_data(ld);
+	float           offset = sd ? sd->scroll_y : 0.0f;
+	int             anchor = list_row_at(ld, offset);
+	float           into   = offset - list_row_offset(ld, anchor);
+	if (!flux_list_heights_measure(&ld->heights, index, height)) return;
+
+	list_apply_host_extent(ld);
+	if (sd && offset > 0.0f) {
+		float anchor_h = list_row_height(ld, anchor);
+		flux_scroll_set_offset(store, ld->scroll, sd->scroll_x, list_row_offset(ld, anchor) + fminf(into, anchor_h));
 	}
+	if (ld->realized_last >= ld->realized_first) list_place_realized(ld);
+}
+
+float flux_list_view_row_offset(FluxNodeStore *store, XentNodeId list, int index) {
+	FluxListViewData const *ld = list_read(store, list);
+	if (!ld || index <= 0) return 0.0f;
+	int cols = ld->cols > 0 ? ld->cols : 1;
+	return list_row_offset(ld, index / cols);
 }
 
 void flux_list_view_set_stale_callback(FluxNodeStore *store, XentNodeId list, void (*on_stale)(void *), void *ctx) {
@@ -619,11 +846,23 @@ void flux_list_view_set_stale_callback(FluxNodeStore *store, XentNodeId list, vo
 }
 
 bool flux_list_view_viewport(FluxNodeStore *store, XentNodeId list, float *offset, float *extent, float *cross) {
-	FluxListViewData *ld = list_data(store, list);
+	FluxListViewData const *ld = list_read(store, list);
 	if (!ld) return false;
 	XentRect rect = {0};
 	if (!list_viewport_metrics(ld, offset, extent)) return false;
 	*cross = xent_get_layout_rect(ld->ctx, ld->scroll, &rect) ? rect.w : 0.0f;
+
+	/* The reconciler sizes its window in uniform item_height rows; express a
+	 * viewport over measured rows in those units so it realizes the rows that
+	 * are actually visible. */
+	if (list_rows_varied(ld)) {
+		int   first = list_row_at(ld, *offset);
+		int   last  = list_row_before(ld, *offset + *extent);
+		float h     = list_row_height(ld, first);
+		float into  = h > 0.0f ? (*offset - list_row_offset(ld, first)) / h : 0.0f;
+		*offset     = (( float ) first + into) * ld->item_height;
+		*extent     = (( float ) (last - first + 1) - into) * ld->item_height;
+	}
 	return true;
 }
 
@@ -644,8 +883,8 @@ void flux_list_view_update_window(XentContext *ctx, XentNodeId list, struct Flux
 
 	int  cols       = xtk_list_auto_columns(rect.w, ld->item_width, ld->columns);
 	int  total_rows = (ld->count + cols - 1) / cols;
-	int  row_first  = ( int ) floorf(offset / ld->item_height);
-	int  row_last   = ( int ) ceilf((offset + rect.h) / ld->item_height) - 1;
+	int  row_first  = list_row_at(ld, offset);
+	int  row_last   = list_row_before(ld, offset + rect.h);
 	if (row_first < 0) row_first = 0;
 	if (row_last > total_rows - 1) row_last = total_rows - 1;
 
@@ -665,11 +904,13 @@ void flux_list_item_set_place(FluxNodeStore *store, XentNodeId item, int index,
 	it->index     = index;
 	it->logical_x = x;
 	it->logical_y = y;
+	if (it->owner) list_item_apply_row(it->owner, item, it);
 	FluxScrollData *sd = it->owner ? list_scroll_data(it->owner) : NULL;
 	xent_set_absolute_position(
 	  flux_node_store_context(store), item,
-	  (XentPoint) {x - (sd ? sd->origin_x : 0.0f), y - (sd ? sd->origin_y : 0.0f)}
+	  (XentPoint) {x - (sd ? sd->origin_x : 0.0f), it->logical_y - (sd ? sd->origin_y : 0.0f)}
 	);
+	flux_node_store_invalidate_node_layout(store, item);
 
 	/* Complete a keyboard focus move that targeted a not-yet-realized cell. */
 	FluxListViewData *ld = it->owner;
@@ -691,6 +932,7 @@ void flux_list_item_set_state(FluxNodeStore *store, XentNodeId item, bool select
 			XentInsets pad = multi ? (XentInsets) {16.0f + 28.0f, 0.0f, 12.0f, 0.0f}
 			                       : (XentInsets) {16.0f, 0.0f, 12.0f, 0.0f};
 			xent_set_padding(flux_node_store_context(store), item, pad);
+			flux_node_store_invalidate_node_layout(store, item);
 		}
 	}
 }
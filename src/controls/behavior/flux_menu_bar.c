@@ -20,7 +20,7 @@
  * sibling focus navigation, matching the bar's XYFocus arrangement. */
 
 static FluxMenuBarData *menu_bar_data(FluxNodeStore *store, XentNodeId bar) {
-	FluxNodeData *nd = flux_node_store_get(store, bar);
+	FluxNodeData *nd = flux_node_store_edit(store, bar);
 	if (!nd || nd->component_type != FLUX_CONTROL_MENU_BAR) return NULL;
 	return ( FluxMenuBarData * ) nd->component_data;
 }
@@ -97,7 +97,7 @@ XentNodeId flux_create_menu_bar(FluxMenuBarCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_MENU_BAR);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData    *nd = flux_node_store_get(info->store, node);
+	FluxNodeData    *nd = flux_node_store_edit(info->store, node);
 	FluxMenuBarData *d  = nd ? ( FluxMenuBarData * ) calloc(1, sizeof(*d)) : NULL;
 	if (!nd || !d) {
 		free(d);
@@ -131,7 +131,7 @@ FluxMenuFlyout *flux_menu_bar_add_menu(FluxNodeStore *store, XentNodeId bar, cha
 	if (item == XENT_NODE_INVALID) return NULL;
 
 	FluxMenuFlyout *flyout = flux_menu_flyout_create(d->window);
-	FluxNodeData   *ind    = flux_node_store_get(d->store, item);
+	FluxNodeData   *ind    = flux_node_store_edit(d->store, item);
 	if (!flyout || !ind) {
 		if (flyout) flux_menu_flyout_destroy(flyout);
 		return NULL;
@@ -154,12 +154,12 @@ FluxMenuFlyout *flux_menu_bar_add_menu(FluxNodeStore *store, XentNodeId bar, cha
 	slot->index                       = d->count;
 
 	ind->component_data               = slot;
-	ind->behavior.on_click            = menu_bar_item_click;
-	ind->behavior.on_click_ctx        = slot;
-	ind->behavior.on_pointer_move     = menu_bar_item_hover;
-	ind->behavior.on_pointer_move_ctx = slot;
-	ind->behavior.on_key              = menu_bar_item_key;
-	ind->behavior.on_key_ctx          = slot;
+	ind->behavior->on_click            = menu_bar_item_click;
+	ind->behavior->on_click_ctx        = slot;
+	ind->behavior->on_pointer_move     = menu_bar_item_hover;
+	ind->behavior->on_pointer_move_ctx = slot;
+	ind->behavior->on_key              = menu_bar_item_key;
+	ind->behavior->on_key_ctx          = slot;
 
 	flux_menu_flyout_set_dismiss_callback(flyout, menu_bar_item_dismissed, slot);
 
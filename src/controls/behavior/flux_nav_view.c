@@ -59,7 +59,7 @@ static void nav_tween_to(FluxNavTween *tw, float target, float duration_ms) {
 	if (fabsf(target - tw->target) < 0.01f) return;
 	tw->start    = tw->current;
 	tw->target   = target;
-	tw->start_ms = GetTickCount();
+	tw->start_ms = flux_anim_now();
 	tw->duration = duration_ms;
 	tw->active   = true;
 }
@@ -82,11 +82,17 @@ static bool nav_tween_tick(FluxNavTween *tw, DWORD now, float (*ease)(float)) {
 }
 
 static FluxNavViewData *nav_data(FluxNodeStore *store, XentNodeId nav) {
-	FluxNodeData *nd = flux_node_store_get(store, nav);
+	FluxNodeData *nd = flux_node_store_edit(store, nav);
 	if (!nd || nd->component_type != FLUX_CONTROL_NAV_VIEW) return NULL;
 	return ( FluxNavViewData * ) nd->component_data;
 }
 
+static FluxNavViewData const *nav_read(FluxNodeStore *store, XentNodeId nav) {
+	FluxNodeData const *nd = flux_node_store_get(store, nav);
+	if (!nd || nd->component_type != FLUX_CONTROL_NAV_VIEW) return NULL;
+	return ( FluxNavViewData const * ) nd->component_data;
+}
+
 static void nav_repaint(FluxNavViewData *d) {
 	HWND h = flux_window_hwnd(d->window);
 	if (h) InvalidateRect(h, NULL, FALSE);
@@ -114,7 +120,7 @@ static void nav_sync_header_heights(FluxNavViewData *d) {
 }
 
 static void nav_set_scrim_alpha(FluxNavViewData *d, int alpha) {
-	FluxNodeData *sn = flux_node_store_get(d->store, d->scrim);
+	FluxNodeData *sn = flux_node_store_edit(d->store, d->scrim);
 	if (sn) sn->visuals.background = flux_color_rgba(0, 0, 0, alpha);
 }
 
@@ -265,6 +271,7 @@ static bool nav_tick_one(FluxNavViewData *d, DWORD now) {
 static bool nav_step(void *ctx, unsigned long now) {
 	FluxNavViewData *d      = ( FluxNavViewData * ) ctx;
 	bool             active = nav_tick_one(d, ( DWORD ) now);
+	flux_node_store_invalidate_layout(d->store); /* nav_apply_geometry moved the pane */
 	nav_repaint(d);
 	if (!active) d->anim_active = false;
 	return active;
@@ -421,7 +428,7 @@ static void nav_make_children_host(FluxNavViewData *d, FluxNavViewItem *par) {
 	xent_set_gap(d->ctx, par->children_host, FLUX_NAV_ITEM_GAP);
 	xent_set_flex_shrink(d->ctx, par->children_host, 0.0f);
 	xent_set_size(d->ctx, par->children_host, (XentSize) {NAN, 0.0f});
-	FluxNodeData *hn = flux_node_store_get(d->store, par->children_host);
+	FluxNodeData *hn = flux_node_store_edit(d->store, par->children_host);
 	if (hn) hn->clips_children = true; /* the reveal animation clips children */
 	nav_tween_init(&par->expand_t, 0.0f);
 	nav_items_restack(d);
@@ -696,7 +703,7 @@ static void nav_setup_pane(FluxNavViewData *d) {
 	xent_set_flex_grow(d->ctx, d->items_scroll, 1.0f);
 	xent_set_flex_basis(d->ctx, d->items_scroll, 0.0f);
 	xent_set_flex_shrink(d->ctx, d->items_scroll, 0.0f);
-	FluxNodeData *sn     = flux_node_store_get(d->store, d->items_scroll);
+	FluxNodeData *sn     = flux_node_store_edit(d->store, d->items_scroll);
 	d->items_scroll_data = sn ? ( struct FluxScrollData * ) sn->component_data : NULL;
 
 	d->items_host        = flux_factory_create_node(d->ctx, d->store, d->items_scroll, FLUX_CONTROL_CONTAINER);
@@ -726,14 +733,14 @@ static void nav_make_toggle(FluxNavViewData *d) {
 	xent_set_absolute_position(d->ctx, d->toggle, (XentPoint) {FLUX_NAV_ITEM_MARGIN_H, FLUX_NAV_PANE_TOP_PAD});
 	xent_set_size(d->ctx, d->toggle, (XentSize) {FLUX_NAV_TOGGLE_W, FLUX_NAV_TOGGLE_H});
 
-	FluxNodeData *tn = flux_node_store_get(d->store, d->toggle);
+	FluxNodeData *tn = flux_node_store_edit(d->store, d->toggle);
 	if (tn) {
 		d->toggle_item            = (FluxNavViewItem) {d, d->toggle, NULL, "GlobalNavButton", FLUX_NAV_ITEM_TOGGLE, -1};
 		tn->component_data        = &d->toggle_item;
-		tn->behavior.on_click     = nav_toggle_click;
-		tn->behavior.on_click_ctx = d;
-		tn->behavior.on_key       = nav_escape_key;
-		tn->behavior.on_key_ctx   = d;
+		tn->behavior->on_click     = nav_toggle_click;
+		tn->behavior->on_click_ctx = d;
+		tn->behavior->on_key       = nav_escape_key;
+		tn->behavior->on_key_ctx   = d;
 	}
 	xent_set_focusable(d->ctx, d->toggle, true);
 }
@@ -775,17 +782,17 @@ static void nav_build_tree(FluxNavViewData *d) {
 	d->content        = flux_factory_create_node(d->ctx, d->store, d->root, FLUX_CONTROL_CONTAINER);
 
 	d->scrim          = flux_factory_create_node(d->ctx, d->store, d->root, FLUX_CONTROL_CONTAINER);
-	FluxNodeData *scn = flux_node_store_get(d->store, d->scrim);
+	FluxNodeData *scn = flux_node_store_edit(d->store, d->scrim);
 	if (scn) {
-		scn->behavior.on_click     = nav_scrim_click;
-		scn->behavior.on_click_ctx = d;
+		scn->behavior->on_click     = nav_scrim_click;
+		scn->behavior->on_click_ctx = d;
 	}
 
 	d->pane          = flux_factory_create_node(d->ctx, d->store, d->root, FLUX_CONTROL_NAV_VIEW);
 	/* Borrowed (root owns d's lifetime): lets the selection-indicator snapshot run on
 	 * the pane, so the pill tracks the pane and slides off-screen with it in Minimal
 	 * instead of being drawn at the always-on-screen root's left edge. */
-	FluxNodeData *pn = flux_node_store_get(d->store, d->pane);
+	FluxNodeData *pn = flux_node_store_edit(d->store, d->pane);
 	if (pn) pn->component_data = d;
 	nav_setup_pane(d);
 	nav_make_toggle(d); /* last root child: floats above pane + content in every mode */
@@ -828,7 +835,7 @@ XentNodeId flux_create_nav_view(FluxNavViewCreateInfo const *info) {
 	XentNodeId root = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_NAV_VIEW);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData    *nd = flux_node_store_get(info->store, root);
+	FluxNodeData    *nd = flux_node_store_edit(info->store, root);
 	FluxNavViewData *d  = nd ? ( FluxNavViewData * ) calloc(1, sizeof(*d)) : NULL;
 	if (!nd || !d) {
 		free(d);
@@ -869,16 +876,16 @@ static int nav_add(FluxNavViewData *d, XentNodeId host, char const *icon, char c
 	slot->parent          = -1;
 	slot->children_host   = XENT_NODE_INVALID;
 
-	FluxNodeData *in      = flux_node_store_get(d->store, node);
+	FluxNodeData *in      = flux_node_store_edit(d->store, node);
 	bool          inert   = (kind == FLUX_NAV_ITEM_SEPARATOR || kind == FLUX_NAV_ITEM_HEADER);
 	if (in && !inert) {
 		in->component_data               = slot;
-		in->behavior.on_click            = nav_item_click;
-		in->behavior.on_click_ctx        = slot;
-		in->behavior.on_pointer_down     = nav_item_down;
-		in->behavior.on_pointer_down_ctx = slot;
-		in->behavior.on_key              = nav_escape_key;
-		in->behavior.on_key_ctx          = d;
+		in->behavior->on_click            = nav_item_click;
+		in->behavior->on_click_ctx        = slot;
+		in->behavior->on_pointer_down     = nav_item_down;
+		in->behavior->on_pointer_down_ctx = slot;
+		in->behavior->on_key              = nav_escape_key;
+		in->behavior->on_key_ctx          = d;
 	}
 	else if (in) in->component_data = slot;
 	if (!inert) {
@@ -944,7 +951,7 @@ void flux_nav_view_select(FluxNodeStore *store, XentNodeId nav, int index) {
 }
 
 XentNodeId flux_nav_view_content_node(FluxNodeStore *store, XentNodeId nav) {
-	FluxNavViewData *d = nav_data(store, nav);
+	FluxNavViewData const *d = nav_read(store, nav);
 	return d ? d->content : XENT_NODE_INVALID;
 }
 
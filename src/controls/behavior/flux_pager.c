@@ -14,7 +14,7 @@
 #include <windows.h>
 
 static FluxPagerData *pager_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_PAGER || !nd->component_data) return NULL;
 	return ( FluxPagerData * ) nd->component_data;
 }
@@ -37,6 +37,7 @@ static void pager_apply_size(FluxPagerData *d) {
 	float         tw = 0.0f;
 	pager_elems(d, elems, &tw);
 	xent_set_size(d->ctx, d->node, (XentSize) {tw, FLUX_PAGER_HEIGHT});
+	flux_node_store_invalidate_layout(d->store);
 }
 
 /* Element index under a node-local point, or -1. */
@@ -133,7 +134,7 @@ XentNodeId flux_create_pager(FluxPagerCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_PAGER);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData  *nd = flux_node_store_get(info->store, node);
+	FluxNodeData  *nd = flux_node_store_edit(info->store, node);
 	FluxPagerData *d  = nd ? ( FluxPagerData * ) calloc(1, sizeof(*d)) : NULL;
 	if (!nd || !d) {
 		free(d);
@@ -160,14 +161,14 @@ XentNodeId flux_create_pager(FluxPagerCreateInfo const *info) {
 
 	nd->component_data               = d;
 	nd->destroy_component_data       = pager_destroy;
-	nd->behavior.on_pointer_down     = pager_pointer_down;
-	nd->behavior.on_pointer_down_ctx = d;
-	nd->behavior.on_click            = pager_click;
-	nd->behavior.on_click_ctx        = d;
-	nd->behavior.on_cancel           = pager_cancel;
-	nd->behavior.on_cancel_ctx       = d;
-	nd->behavior.on_key              = pager_key;
-	nd->behavior.on_key_ctx          = d;
+	nd->behavior->on_pointer_down     = pager_pointer_down;
+	nd->behavior->on_pointer_down_ctx = d;
+	nd->behavior->on_click            = pager_click;
+	nd->behavior->on_click_ctx        = d;
+	nd->behavior->on_cancel           = pager_cancel;
+	nd->behavior->on_cancel_ctx       = d;
+	nd->behavior->on_key              = pager_key;
+	nd->behavior->on_key_ctx          = d;
 
 	xent_set_focusable(info->ctx, node, true);
 	xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_CONTAINER);
@@ -17,7 +17,7 @@
 #include <string.h>
 
 static FluxPersonPictureData *pp_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_PERSON_PICTURE || !nd->component_data) return NULL;
 	return ( FluxPersonPictureData * ) nd->component_data;
 }
@@ -109,7 +109,7 @@ XentNodeId flux_create_person_picture(FluxPersonPictureCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_PERSON_PICTURE);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData          *nd = flux_node_store_get(info->store, node);
+	FluxNodeData          *nd = flux_node_store_edit(info->store, node);
 	FluxPersonPictureData *d  = nd ? ( FluxPersonPictureData * ) calloc(1, sizeof(*d)) : NULL;
 	if (!nd || !d) {
 		free(d);
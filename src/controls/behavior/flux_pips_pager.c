@@ -18,7 +18,7 @@
 #define PIP_NAV   24.0f
 
 static FluxPipsPagerData *pips_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_PIPS_PAGER || !nd->component_data) return NULL;
 	return ( FluxPipsPagerData * ) nd->component_data;
 }
@@ -49,6 +49,7 @@ static void pips_apply_size(FluxPipsPagerData *pd) {
 	float main  = ( float ) pips_visible(pd) * PIP_CROSS + (pips_nav_shown(pd) ? 2.0f * PIP_NAV : 0.0f);
 	float cross = PIP_MAIN;
 	xent_set_size(pd->ctx, pd->node, pd->vertical ? (XentSize) {cross, main} : (XentSize) {main, cross});
+	flux_node_store_invalidate_layout(pd->store);
 }
 
 /* Hit zones in node-local coordinates: nav prev, pip i, nav next; -2 = prev,
@@ -124,7 +125,7 @@ XentNodeId flux_create_pips_pager(FluxPipsPagerCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_PIPS_PAGER);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData      *nd = flux_node_store_get(info->store, node);
+	FluxNodeData      *nd = flux_node_store_edit(info->store, node);
 	FluxPipsPagerData *pd = nd ? ( FluxPipsPagerData * ) calloc(1, sizeof(FluxPipsPagerData)) : NULL;
 	if (!nd || !pd) {
 		free(pd);
@@ -142,14 +143,14 @@ XentNodeId flux_create_pips_pager(FluxPipsPagerCreateInfo const *info) {
 
 	nd->component_data               = pd;
 	nd->destroy_component_data       = free;
-	nd->behavior.on_pointer_down     = pips_pointer_down;
-	nd->behavior.on_pointer_down_ctx = pd;
-	nd->behavior.on_click            = pips_click;
-	nd->behavior.on_click_ctx        = pd;
-	nd->behavior.on_cancel           = pips_cancel;
-	nd->behavior.on_cancel_ctx       = pd;
-	nd->behavior.on_key              = pips_key;
-	nd->behavior.on_key_ctx          = pd;
+	nd->behavior->on_pointer_down     = pips_pointer_down;
+	nd->behavior->on_pointer_down_ctx = pd;
+	nd->behavior->on_click            = pips_click;
+	nd->behavior->on_click_ctx        = pd;
+	nd->behavior->on_cancel           = pips_cancel;
+	nd->behavior->on_cancel_ctx       = pd;
+	nd->behavior->on_key              = pips_key;
+	nd->behavior->on_key_ctx          = pd;
 
 	xent_set_focusable(info->ctx, node, true);
 	xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_CONTAINER);
@@ -25,7 +25,7 @@
 #define RB_HEADER_GAP     8.0f
 
 static FluxRadioButtonsData *rb_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_RADIO_BUTTONS || !nd->component_data) return NULL;
 	return ( FluxRadioButtonsData * ) nd->component_data;
 }
@@ -135,12 +135,12 @@ static void rb_make_item(
 	g->items [idx]    = radio;
 	g->item_ctx [idx] = (FluxRadioItemCtx) {g, idx};
 
-	FluxNodeData *rnd = flux_node_store_get(info->store, radio);
+	FluxNodeData *rnd = flux_node_store_edit(info->store, radio);
 	if (rnd) {
-		rnd->behavior.on_click     = rb_item_click;
-		rnd->behavior.on_click_ctx = &g->item_ctx [idx];
-		rnd->behavior.on_key       = rb_item_key;
-		rnd->behavior.on_key_ctx   = &g->item_ctx [idx];
+		rnd->behavior->on_click     = rb_item_click;
+		rnd->behavior->on_click_ctx = &g->item_ctx [idx];
+		rnd->behavior->on_key       = rb_item_key;
+		rnd->behavior->on_key_ctx   = &g->item_ctx [idx];
 	}
 	if (info->items && info->items [idx].disabled) flux_checkbox_set_enabled(info->store, radio, false);
 }
@@ -174,7 +174,7 @@ XentNodeId flux_create_radio_buttons(FluxRadioButtonsCreateInfo const *info) {
 	XentNodeId root = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_RADIO_BUTTONS);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData         *nd = flux_node_store_get(info->store, root);
+	FluxNodeData         *nd = flux_node_store_edit(info->store, root);
 	FluxRadioButtonsData *g  = nd ? ( FluxRadioButtonsData * ) calloc(1, sizeof(*g)) : NULL;
 	XentNodeId           *items = count ? ( XentNodeId * ) calloc(( size_t ) count, sizeof(XentNodeId)) : NULL;
 	FluxRadioItemCtx     *ictx  = count ? ( FluxRadioItemCtx * ) calloc(( size_t ) count, sizeof(FluxRadioItemCtx)) : NULL;
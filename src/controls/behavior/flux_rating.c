@@ -26,7 +26,7 @@ static void rating_data_destroy(void *component_data) {
 }
 
 static FluxRatingData *rating_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_RATING || !nd->component_data) return NULL;
 	return ( FluxRatingData * ) nd->component_data;
 }
@@ -154,7 +154,7 @@ XentNodeId flux_create_rating(FluxRatingCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_RATING);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData   *nd = flux_node_store_get(info->store, node);
+	FluxNodeData   *nd = flux_node_store_edit(info->store, node);
 	FluxRatingData *r  = nd ? ( FluxRatingData * ) calloc(1, sizeof(*r)) : NULL;
 	if (!nd || !r) {
 		free(r);
@@ -178,18 +178,18 @@ XentNodeId flux_create_rating(FluxRatingCreateInfo const *info) {
 	nd->component_data         = r;
 	nd->destroy_component_data = rating_data_destroy;
 	if (!r->is_read_only) {
-		nd->behavior.on_pointer_move     = rating_pointer_move;
-		nd->behavior.on_pointer_move_ctx = r;
-		nd->behavior.on_pointer_down     = rating_pointer_down;
-		nd->behavior.on_pointer_down_ctx = r;
-		nd->behavior.on_click            = rating_click;
-		nd->behavior.on_click_ctx        = r;
-		nd->behavior.on_hover_changed    = rating_hover_changed;
-		nd->behavior.on_hover_changed_ctx = r;
-		nd->behavior.on_cancel           = rating_cancel;
-		nd->behavior.on_cancel_ctx       = r;
-		nd->behavior.on_key              = rating_key;
-		nd->behavior.on_key_ctx          = r;
+		nd->behavior->on_pointer_move     = rating_pointer_move;
+		nd->behavior->on_pointer_move_ctx = r;
+		nd->behavior->on_pointer_down     = rating_pointer_down;
+		nd->behavior->on_pointer_down_ctx = r;
+		nd->behavior->on_click            = rating_click;
+		nd->behavior->on_click_ctx        = r;
+		nd->behavior->on_hover_changed    = rating_hover_changed;
+		nd->behavior->on_hover_changed_ctx = r;
+		nd->behavior->on_cancel           = rating_cancel;
+		nd->behavior->on_cancel_ctx       = r;
+		nd->behavior->on_key              = rating_key;
+		nd->behavior->on_key_ctx          = r;
 		xent_set_focusable(info->ctx, node, true);
 	}
 	xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_BUTTON);
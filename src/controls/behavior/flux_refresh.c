@@ -29,11 +29,17 @@
 #endif
 
 static FluxRefreshData *refresh_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_REFRESH) return NULL;
 	return ( FluxRefreshData * ) nd->component_data;
 }
 
+static FluxRefreshData const *refresh_read(FluxNodeStore *store, XentNodeId id) {
+	FluxNodeData const *nd = flux_node_store_get(store, id);
+	if (!nd || nd->component_type != FLUX_CONTROL_REFRESH) return NULL;
+	return ( FluxRefreshData const * ) nd->component_data;
+}
+
 static void refresh_repaint(FluxRefreshData *d) {
 	HWND h = d->window ? flux_window_hwnd(d->window) : NULL;
 	if (h) InvalidateRect(h, NULL, FALSE);
@@ -89,11 +95,11 @@ static void refresh_enter_state(FluxRefreshData *d, int state) {
 	if (d->state == state) return;
 	d->state = state;
 	if (state == FLUX_REFRESH_PENDING) {
-		d->pop_start_tick = GetTickCount();
+		d->pop_start_tick = flux_anim_now();
 		refresh_anim_start(d);
 	}
 	else if (state == FLUX_REFRESH_REFRESHING) {
-		d->spin_start_tick = GetTickCount();
+		d->spin_start_tick = flux_anim_now();
 		refresh_anim_start(d);
 	}
 	refresh_repaint(d);
@@ -168,7 +174,7 @@ static float refresh_pull_distance(FluxRefreshData const *d, float x, float y) {
 
 /* IsWithinOffsetThreshold: the scroller sits within 1 DIP of its pull edge. */
 static bool refresh_within_offset_threshold(FluxRefreshData const *d) {
-	FluxNodeData *nd = flux_node_store_get(d->store, d->scroll_child);
+	FluxNodeData *nd = flux_node_store_edit(d->store, d->scroll_child);
 	if (!nd || !nd->component_data) return true;
 	FluxScrollData const *sd = ( FluxScrollData const * ) nd->component_data;
 
@@ -224,7 +230,7 @@ static void refresh_setup_root(XentContext *ctx, XentNodeId root) {
 
 static FluxRefreshData *
 refresh_make_runtime(FluxRefreshContainerCreateInfo const *info, XentNodeId root, XentNodeId scroll) {
-	FluxNodeData    *root_nd = flux_node_store_get(info->store, root);
+	FluxNodeData    *root_nd = flux_node_store_edit(info->store, root);
 	FluxRefreshData *d       = root_nd ? ( FluxRefreshData * ) calloc(1, sizeof(*d)) : NULL;
 	if (!root_nd || !d) {
 		free(d);
@@ -249,14 +255,14 @@ refresh_make_runtime(FluxRefreshContainerCreateInfo const *info, XentNodeId root
 	root_nd->component_data          = d;
 	root_nd->destroy_component_data  = refresh_destroy;
 	root_nd->clips_children          = true; /* root inset clip: glyph reveals from behind the edge */
-	root_nd->behavior.on_pointer_down    = refresh_on_pointer_down;
-	root_nd->behavior.on_pointer_down_ctx = d;
-	root_nd->behavior.on_pointer_move    = refresh_on_pointer_move;
-	root_nd->behavior.on_pointer_move_ctx = d;
-	root_nd->behavior.on_click           = refresh_on_release;
-	root_nd->behavior.on_click_ctx       = d;
-	root_nd->behavior.on_cancel          = refresh_on_release; /* touch-pan promotion aborts the press */
-	root_nd->behavior.on_cancel_ctx      = d;
+	root_nd->behavior->on_pointer_down    = refresh_on_pointer_down;
+	root_nd->behavior->on_pointer_down_ctx = d;
+	root_nd->behavior->on_pointer_move    = refresh_on_pointer_move;
+	root_nd->behavior->on_pointer_move_ctx = d;
+	root_nd->behavior->on_click           = refresh_on_release;
+	root_nd->behavior->on_click_ctx       = d;
+	root_nd->behavior->on_cancel          = refresh_on_release; /* touch-pan promotion aborts the press */
+	root_nd->behavior->on_cancel_ctx      = d;
 	return d;
 }
 
@@ -280,7 +286,7 @@ XentNodeId flux_create_refresh(FluxRefreshContainerCreateInfo const *info) {
 }
 
 XentNodeId flux_refresh_content_node(FluxNodeStore *store, XentNodeId id) {
-	FluxRefreshData *d = refresh_data(store, id);
+	FluxRefreshData const *d = refresh_read(store, id);
 	return d ? d->scroll_child : XENT_NODE_INVALID;
 }
 
@@ -159,7 +159,7 @@ XentNodeId flux_create_repeat_button(FluxButtonCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_REPEAT_BUTTON);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData              *nd = flux_node_store_get(info->store, node);
+	FluxNodeData              *nd = flux_node_store_edit(info->store, node);
 	FluxRepeatButtonInputData *rb = nd ? ( FluxRepeatButtonInputData * ) calloc(1, sizeof(*rb)) : NULL;
 	if (!nd || !rb) {
 		free(rb);
@@ -178,18 +178,18 @@ XentNodeId flux_create_repeat_button(FluxButtonCreateInfo const *info) {
 
 	nd->component_data               = &rb->base;
 	nd->destroy_component_data       = repeat_destroy;
-	nd->behavior.on_click            = repeat_on_pointer_up;
-	nd->behavior.on_click_ctx        = rb;
-	nd->behavior.on_pointer_down     = repeat_on_pointer_down;
-	nd->behavior.on_pointer_down_ctx = rb;
-	nd->behavior.on_pointer_move     = repeat_on_pointer_move;
-	nd->behavior.on_pointer_move_ctx = rb;
-	nd->behavior.on_cancel           = repeat_on_pointer_up;
-	nd->behavior.on_cancel_ctx       = rb;
-	nd->behavior.on_blur             = repeat_on_blur;
-	nd->behavior.on_blur_ctx         = rb;
-	nd->behavior.on_key              = repeat_on_key;
-	nd->behavior.on_key_ctx          = rb;
+	nd->behavior->on_click            = repeat_on_pointer_up;
+	nd->behavior->on_click_ctx        = rb;
+	nd->behavior->on_pointer_down     = repeat_on_pointer_down;
+	nd->behavior->on_pointer_down_ctx = rb;
+	nd->behavior->on_pointer_move     = repeat_on_pointer_move;
+	nd->behavior->on_pointer_move_ctx = rb;
+	nd->behavior->on_cancel           = repeat_on_pointer_up;
+	nd->behavior->on_cancel_ctx       = rb;
+	nd->behavior->on_blur             = repeat_on_blur;
+	nd->behavior->on_blur_ctx         = rb;
+	nd->behavior->on_key              = repeat_on_key;
+	nd->behavior->on_key_ctx          = rb;
 
 	xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_BUTTON);
 	if (info->label) xent_set_semantic_label(info->ctx, node, info->label);
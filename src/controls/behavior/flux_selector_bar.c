@@ -20,7 +20,7 @@
 #define SB_ANIM_MS 167.0f
 
 static FluxSelectorBarData *sb_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_SELECTOR_BAR || !nd->component_data) return NULL;
 	return ( FluxSelectorBarData * ) nd->component_data;
 }
@@ -57,7 +57,7 @@ static void sb_select(FluxSelectorBarData *b, int idx, bool notify) {
 	if (idx >= 0) {
 		b->item_data [idx]->pill_t = 0.0f;
 		b->anim_item               = idx;
-		b->anim_start              = GetTickCount();
+		b->anim_start              = flux_anim_now();
 		flux_anim_register(b, sb_anim_step);
 	}
 	if (notify && idx >= 0 && b->on_select) b->on_select(b->on_select_ctx, idx);
@@ -113,7 +113,7 @@ XentNodeId flux_create_selector_bar(FluxSelectorBarCreateInfo const *info) {
 	XentNodeId root = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_SELECTOR_BAR);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData        *nd    = flux_node_store_get(info->store, root);
+	FluxNodeData        *nd    = flux_node_store_edit(info->store, root);
 	FluxSelectorBarData *b     = nd ? ( FluxSelectorBarData * ) calloc(1, sizeof(*b)) : NULL;
 	XentNodeId          *items = count ? ( XentNodeId * ) calloc(( size_t ) count, sizeof(XentNodeId)) : NULL;
 	FluxSelectorBarItemData **idata
@@ -139,7 +139,7 @@ XentNodeId flux_create_selector_bar(FluxSelectorBarCreateInfo const *info) {
 
 	for (int i = 0; i < count; i++) {
 		XentNodeId       node = flux_factory_create_node(info->ctx, info->store, root, FLUX_CONTROL_SELECTOR_BAR_ITEM);
-		FluxNodeData    *ind  = flux_node_store_get(info->store, node);
+		FluxNodeData    *ind  = flux_node_store_edit(info->store, node);
 		FluxSelectorBarItemData *it = ind ? ( FluxSelectorBarItemData * ) calloc(1, sizeof(*it)) : NULL;
 		if (!it) continue;
 		it->bar   = b;
@@ -149,10 +149,10 @@ XentNodeId flux_create_selector_bar(FluxSelectorBarCreateInfo const *info) {
 
 		ind->component_data         = it;
 		ind->destroy_component_data = sb_item_destroy;
-		ind->behavior.on_click      = sb_item_click;
-		ind->behavior.on_click_ctx  = it;
-		ind->behavior.on_key        = sb_item_key;
-		ind->behavior.on_key_ctx    = it;
+		ind->behavior->on_click      = sb_item_click;
+		ind->behavior->on_click_ctx  = it;
+		ind->behavior->on_key        = sb_item_key;
+		ind->behavior->on_key_ctx    = it;
 		xent_set_focusable(info->ctx, node, true);
 		xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_BUTTON);
 		xent_set_size(info->ctx, node, (XentSize) {NAN, NAN});
@@ -188,6 +188,7 @@ void flux_selector_bar_set_item(
 	xent_set_font_size(ctx, b->items [i], 14.0f);
 	xent_set_padding(ctx, b->items [i], (XentInsets) {lead, 10.0f, 12.0f, 10.0f});
 	xent_set_semantic_enabled(ctx, b->items [i], !disabled);
+	flux_node_store_invalidate_layout(store);
 }
 
 void flux_selector_bar_set_selected(FluxNodeStore *store, XentNodeId bar, int index) {
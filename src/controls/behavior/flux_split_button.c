@@ -33,7 +33,7 @@ static bool split_secondary_zone(FluxSplitButtonBinding const *b, float local_x)
 }
 
 static void split_invoke_primary(FluxSplitButtonBinding const *b) {
-	FluxNodeData   *nd = flux_node_store_get(b->store, b->node);
+	FluxNodeData   *nd = flux_node_store_edit(b->store, b->node);
 	FluxButtonData *bd = nd ? ( FluxButtonData * ) nd->component_data : NULL;
 	if (!bd) return;
 	/* ToggleSplitButton (ToggleSplitButton.cpp OnClickPrimary): flip IsChecked
@@ -115,7 +115,7 @@ XentNodeId flux_create_split_button(FluxSplitButtonCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_SPLIT_BUTTON);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData           *nd = flux_node_store_get(info->store, node);
+	FluxNodeData           *nd = flux_node_store_edit(info->store, node);
 	FluxButtonData         *bd = nd ? ( FluxButtonData * ) calloc(1, sizeof(FluxButtonData)) : NULL;
 	FluxSplitButtonBinding *b  = nd ? ( FluxSplitButtonBinding * ) calloc(1, sizeof(*b)) : NULL;
 	if (!nd || !bd || !b) {
@@ -137,12 +137,12 @@ XentNodeId flux_create_split_button(FluxSplitButtonCreateInfo const *info) {
 
 	nd->component_data               = bd;
 	nd->destroy_component_data       = flux_button_data_destroy;
-	nd->behavior.on_pointer_down     = split_on_pointer_down;
-	nd->behavior.on_pointer_down_ctx = b;
-	nd->behavior.on_click            = split_on_click;
-	nd->behavior.on_click_ctx        = b;
-	nd->behavior.on_key              = split_on_key;
-	nd->behavior.on_key_ctx          = b;
+	nd->behavior->on_pointer_down     = split_on_pointer_down;
+	nd->behavior->on_pointer_down_ctx = b;
+	nd->behavior->on_click            = split_on_click;
+	nd->behavior->on_click_ctx        = b;
+	nd->behavior->on_key              = split_on_key;
+	nd->behavior->on_key_ctx          = b;
 
 	xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_BUTTON);
 	if (info->label) xent_set_semantic_label(info->ctx, node, info->label);
@@ -168,7 +168,7 @@ XentNodeId flux_create_toggle_split_button(FluxToggleSplitButtonCreateInfo const
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_TOGGLE_SPLIT_BUTTON);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData           *nd = flux_node_store_get(info->store, node);
+	FluxNodeData           *nd = flux_node_store_edit(info->store, node);
 	FluxButtonData         *bd = nd ? ( FluxButtonData * ) calloc(1, sizeof(FluxButtonData)) : NULL;
 	FluxSplitButtonBinding *b  = nd ? ( FluxSplitButtonBinding * ) calloc(1, sizeof(*b)) : NULL;
 	if (!nd || !bd || !b) {
@@ -192,12 +192,12 @@ XentNodeId flux_create_toggle_split_button(FluxToggleSplitButtonCreateInfo const
 
 	nd->component_data               = bd;
 	nd->destroy_component_data       = flux_button_data_destroy;
-	nd->behavior.on_pointer_down     = split_on_pointer_down;
-	nd->behavior.on_pointer_down_ctx = b;
-	nd->behavior.on_click            = split_on_click;
-	nd->behavior.on_click_ctx        = b;
-	nd->behavior.on_key              = split_on_key;
-	nd->behavior.on_key_ctx          = b;
+	nd->behavior->on_pointer_down     = split_on_pointer_down;
+	nd->behavior->on_pointer_down_ctx = b;
+	nd->behavior->on_click            = split_on_click;
+	nd->behavior->on_click_ctx        = b;
+	nd->behavior->on_key              = split_on_key;
+	nd->behavior->on_key_ctx          = b;
 
 	xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_BUTTON);
 	if (info->label) xent_set_semantic_label(info->ctx, node, info->label);
@@ -213,17 +213,17 @@ XentNodeId flux_create_toggle_split_button(FluxToggleSplitButtonCreateInfo const
 }
 
 void flux_toggle_split_button_set_checked(FluxNodeStore *store, XentNodeId id, bool checked) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (nd && nd->component_type == FLUX_CONTROL_TOGGLE_SPLIT_BUTTON && nd->component_data)
 		(( FluxButtonData * ) nd->component_data)->is_checked = checked;
 }
 
 void flux_split_button_set_flyout_ex(FluxFlyoutBindingInfo const *info) {
 	if (!info || !info->store || !info->flyout) return;
-	FluxNodeData *nd = flux_node_store_get(info->store, info->id);
-	if (!nd || nd->behavior.on_pointer_down != split_on_pointer_down) return;
+	FluxNodeData *nd = flux_node_store_edit(info->store, info->id);
+	if (!nd || nd->behavior->on_pointer_down != split_on_pointer_down) return;
 
-	FluxSplitButtonBinding *b = ( FluxSplitButtonBinding * ) nd->behavior.on_pointer_down_ctx;
+	FluxSplitButtonBinding *b = ( FluxSplitButtonBinding * ) nd->behavior->on_pointer_down_ctx;
 	if (!b) return;
 	b->flyout    = info->flyout;
 	b->placement = info->placement;
@@ -233,10 +233,10 @@ void flux_split_button_set_flyout_ex(FluxFlyoutBindingInfo const *info) {
 
 void flux_split_button_set_menu_flyout_ex(FluxContextFlyoutBindingInfo const *info) {
 	if (!info || !info->store || !info->menu) return;
-	FluxNodeData *nd = flux_node_store_get(info->store, info->id);
-	if (!nd || nd->behavior.on_pointer_down != split_on_pointer_down) return;
+	FluxNodeData *nd = flux_node_store_edit(info->store, info->id);
+	if (!nd || nd->behavior->on_pointer_down != split_on_pointer_down) return;
 
-	FluxSplitButtonBinding *b = ( FluxSplitButtonBinding * ) nd->behavior.on_pointer_down_ctx;
+	FluxSplitButtonBinding *b = ( FluxSplitButtonBinding * ) nd->behavior->on_pointer_down_ctx;
 	if (!b) return;
 	b->menu   = info->menu;
 	b->window = info->window;
@@ -9,9 +9,10 @@
 #include "fluxent/fluxent.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 static FluxSplitViewData *split_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_SPLIT_VIEW || !nd->component_data) return NULL;
 	return ( FluxSplitViewData * ) nd->component_data;
 }
@@ -33,7 +34,7 @@ XentNodeId flux_create_split_view_pane(XentContext *ctx, FluxNodeStore *store, X
 	XentNodeId n = flux_factory_create_node(ctx, store, parent, FLUX_CONTROL_SPLIT_VIEW_PANE);
 	if (n == XENT_NODE_INVALID) return n;
 
-	FluxNodeData      *nd = flux_node_store_get(store, n);
+	FluxNodeData      *nd = flux_node_store_edit(store, n);
 	FluxSplitPaneData *pd = nd ? ( FluxSplitPaneData * ) calloc(1, sizeof(*pd)) : NULL;
 	if (!nd || !pd) {
 		free(pd);
@@ -52,7 +53,7 @@ XentNodeId flux_create_split_view(FluxSplitViewCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_SPLIT_VIEW);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData      *nd = flux_node_store_get(info->store, node);
+	FluxNodeData      *nd = flux_node_store_edit(info->store, node);
 	FluxSplitViewData *d  = nd ? ( FluxSplitViewData * ) calloc(1, sizeof(*d)) : NULL;
 	if (!nd || !d) {
 		free(d);
@@ -107,20 +108,33 @@ void flux_split_view_sync(XentContext *ctx, XentNodeId node, struct FluxNodeData
 	}
 	if (content_w < 0.0f) content_w = 0.0f;
 
+	/* Runs every frame: the pane is only touched when its look changes. */
+	FluxNodeData const *pnd = pane != XENT_NODE_INVALID ? flux_node_store_get(d->store, pane) : NULL;
+	if (pnd && pnd->component_data) {
+		FluxSplitPaneData const *cur     = ( FluxSplitPaneData const * ) pnd->component_data;
+		bool                     divider = pane_w > 0.5f;
+		if (cur->overlay != overlay || cur->placement != d->placement || cur->divider != divider) {
+			FluxSplitPaneData *pd = ( FluxSplitPaneData * ) flux_node_store_edit(d->store, pane)->component_data;
+			pd->overlay           = overlay;
+			pd->placement         = d->placement;
+			pd->divider           = divider;
+		}
+	}
+
+	/* Re-placing the children invalidates layout, so only do it on a change. */
+	float placed [5] = {content_x, content_w, pane_x, pane_w, r.h};
+	if (content == d->placed_content && pane == d->placed_pane && !memcmp(placed, d->placed, sizeof(placed))) return;
+	memcpy(d->placed, placed, sizeof(placed));
+	d->placed_content = content;
+	d->placed_pane    = pane;
+	flux_node_store_invalidate_layout(d->store);
+
 	xent_set_absolute_position(ctx, content, (XentPoint) {content_x, 0.0f});
 	xent_set_size(ctx, content, (XentSize) {content_w, r.h});
 
 	if (pane != XENT_NODE_INVALID) {
 		xent_set_absolute_position(ctx, pane, (XentPoint) {pane_x, 0.0f});
 		xent_set_size(ctx, pane, (XentSize) {pane_w, r.h});
-
-		FluxNodeData *pnd = flux_node_store_get(d->store, pane);
-		if (pnd && pnd->component_data) {
-			FluxSplitPaneData *pd = ( FluxSplitPaneData * ) pnd->component_data;
-			pd->overlay           = overlay;
-			pd->placement         = d->placement;
-			pd->divider           = pane_w > 0.5f;
-		}
 	}
 }
 
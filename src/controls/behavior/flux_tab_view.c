@@ -35,7 +35,7 @@
 #define TAB_SCROLL_RESERVE  (2.0f * (FLUX_TAB_SCROLL_W + FLUX_TAB_SCROLL_PAD_OUT + FLUX_TAB_SCROLL_PAD_IN))
 
 static FluxTabViewData *tv_data(FluxNodeStore *store, XentNodeId node) {
-	FluxNodeData *nd = flux_node_store_get(store, node);
+	FluxNodeData *nd = flux_node_store_edit(store, node);
 	if (!nd || nd->component_type != FLUX_CONTROL_TAB_VIEW) return NULL;
 	return ( FluxTabViewData * ) nd->component_data;
 }
@@ -63,7 +63,7 @@ static int tv_open_from(FluxTabViewData const *tv, int pos, int dir) {
 }
 
 static FluxScrollData *tv_scroll(FluxTabViewData const *tv) {
-	FluxNodeData *nd = flux_node_store_get(tv->store, tv->tabs_host);
+	FluxNodeData *nd = flux_node_store_edit(tv->store, tv->tabs_host);
 	return nd ? ( FluxScrollData * ) nd->component_data : NULL;
 }
 
@@ -161,13 +161,13 @@ static void tv_animate_width(FluxTabViewData *tv, FluxTabViewItem *it, bool anim
 		return;
 	}
 	it->w_from  = it->disp_w;
-	it->w_start = GetTickCount();
+	it->w_start = flux_anim_now();
 	it->w_anim  = true;
 	tv_anim_start(tv);
 }
 
 static bool tv_node_hot(FluxTabViewData *tv, XentNodeId node) {
-	FluxNodeData *nd = flux_node_store_get(tv->store, node);
+	FluxNodeData *nd = flux_node_store_edit(tv->store, node);
 	return nd && (nd->state.hovered || nd->state.pressed);
 }
 
@@ -283,7 +283,7 @@ static void tv_update_widths(FluxTabViewData *tv, bool animate) {
 static bool tv_strip_hovered(FluxTabViewData *tv) {
 	XentNodeId nodes [4] = {tv->strip, tv->tabs_host, tv->add_node, XENT_NODE_INVALID};
 	for (int i = 0; i < 3; i++) {
-		FluxNodeData *nd = flux_node_store_get(tv->store, nodes [i]);
+		FluxNodeData *nd = flux_node_store_edit(tv->store, nodes [i]);
 		if (nd && nd->state.hovered) return true;
 	}
 	for (int i = 0; i < tv->count; i++) {
@@ -341,7 +341,7 @@ static void tv_begin_close(FluxTabViewData *tv, int idx) {
 	xent_get_layout_rect(tv->ctx, tv->tabs [idx].tab_node, &r);
 	tv->tabs [idx].w_anim      = false;
 	tv->tabs [idx].close_w0    = r.w > 0.0f ? r.w : tv->tabs [idx].disp_w;
-	tv->tabs [idx].close_start = GetTickCount();
+	tv->tabs [idx].close_start = flux_anim_now();
 	tv->tabs [idx].closing     = true;
 	tv_sync_close(tv, &tv->tabs [idx]);
 	tv_anim_start(tv);
@@ -355,7 +355,7 @@ static void tv_scroll_to(FluxTabViewData *tv, float target) {
 	float avail       = tv_avail_base(tv) - (tv->scroll_visible ? TAB_SCROLL_RESERVE : 0.0f);
 	tv->scroll_target = flux_clampf(target, 0.0f, flux_maxf(0.0f, sd->content_w - avail));
 	tv->scroll_from   = sd->scroll_x;
-	tv->scroll_start  = GetTickCount();
+	tv->scroll_start  = flux_anim_now();
 	tv->scroll_anim   = true;
 	tv_sync_scroll_enabled(tv);
 	tv_anim_start(tv);
@@ -376,7 +376,7 @@ static void tv_scroll_btn_down(void *ctx, float x, float y, int clicks) {
 	int              d  = (it->kind == FLUX_TAB_KIND_SCROLL_DEC) ? -1 : +1;
 	tv_scroll_by(tv, ( float ) d * FLUX_TAB_SCROLL_AMOUNT);
 	tv->scroll_held = d;
-	tv->scroll_next = GetTickCount() + TAB_REPEAT_DELAY_MS;
+	tv->scroll_next = flux_anim_now() + TAB_REPEAT_DELAY_MS;
 	tv_anim_start(tv);
 }
 
@@ -419,7 +419,7 @@ static float tv_drag_reorder_step(FluxTabViewData *tv, FluxTabViewItem *it, floa
 		 * slide from its old spot (ReorderThemeTransition). */
 		FluxTabViewItem *nb  = &tv->tabs [neighbor];
 		nb->slide_x0         = (dx > 0.0f) ? it->disp_w : -it->disp_w;
-		nb->slide_start      = GetTickCount();
+		nb->slide_start      = flux_anim_now();
 		nb->sliding          = true;
 		tv->drag_press_x    += ( float ) ((dx > 0.0f) ? nw : -nw);
 		dx                  -= ( float ) ((dx > 0.0f) ? nw : -nw);
@@ -428,7 +428,7 @@ static float tv_drag_reorder_step(FluxTabViewData *tv, FluxTabViewItem *it, floa
 
 static void tv_drag_end(FluxTabViewData *tv) {
 	if (tv->drag_slot >= 0) {
-		FluxNodeData *nd = flux_node_store_get(tv->store, tv->tabs [tv->drag_slot].tab_node);
+		FluxNodeData *nd = flux_node_store_edit(tv->store, tv->tabs [tv->drag_slot].tab_node);
 		if (nd) nd->render_translate_x = 0.0f;
 	}
 	tv->drag_slot   = -1;
@@ -448,7 +448,7 @@ static void tv_item_move(void *ctx, float x, float y) {
 		tv->drag_active = true;
 	}
 	dx               = tv_drag_reorder_step(tv, it, dx);
-	FluxNodeData *nd = flux_node_store_get(tv->store, it->tab_node);
+	FluxNodeData *nd = flux_node_store_edit(tv->store, it->tab_node);
 	if (nd) nd->render_translate_x = dx;
 	tv_repaint(tv);
 }
@@ -572,7 +572,7 @@ static bool tv_tick_slides(FluxTabViewData *tv, DWORD now) {
 	for (int i = 0; i < tv->count; i++) {
 		FluxTabViewItem *it = &tv->tabs [i];
 		if (!tv_slot_open(tv, i) || !it->sliding) continue;
-		FluxNodeData *nd = flux_node_store_get(tv->store, it->tab_node);
+		FluxNodeData *nd = flux_node_store_edit(tv->store, it->tab_node);
 		float         t  = ( float ) (now - it->slide_start) / TAB_SLIDE_MS;
 		if (t >= 1.0f || tv->drag_slot == i) it->sliding = false;
 		if (nd && tv->drag_slot != i)
@@ -637,6 +637,7 @@ static bool tv_tick_one(FluxTabViewData *tv, DWORD now) {
 static bool tv_step(void *ctx, unsigned long now) {
 	FluxTabViewData *tv     = ( FluxTabViewData * ) ctx;
 	bool             active = tv_tick_one(tv, ( DWORD ) now);
+	flux_node_store_invalidate_layout(tv->store); /* tab widths and scroll buttons follow the tweens */
 	tv_repaint(tv);
 	if (!active) tv->anim_active = false;
 	return active;
@@ -664,25 +665,25 @@ static void tv_destroy(void *component_data) {
 
 static void tv_make_strip_item(FluxTabViewData *tv, FluxTabViewItem *slot, XentNodeId node, FluxTabKind kind) {
 	*slot            = (FluxTabViewItem) {.tv = tv, .tab_node = node, .kind = kind, .index = -1};
-	FluxNodeData *nd = flux_node_store_get(tv->store, node);
+	FluxNodeData *nd = flux_node_store_edit(tv->store, node);
 	if (!nd) return;
 	nd->component_data        = slot;
-	nd->behavior.on_click     = tv_item_click;
-	nd->behavior.on_click_ctx = slot;
+	nd->behavior->on_click     = tv_item_click;
+	nd->behavior->on_click_ctx = slot;
 }
 
 static void tv_make_scroll_button(FluxTabViewData *tv, XentNodeId *out, FluxTabViewItem *slot, FluxTabKind kind) {
 	*out = flux_factory_create_node(tv->ctx, tv->store, tv->strip, FLUX_CONTROL_TAB_VIEW_ITEM);
 	xent_set_size(tv->ctx, *out, (XentSize) {0.0f, 0.0f}); /* hidden until overflow */
 	tv_make_strip_item(tv, slot, *out, kind);
-	FluxNodeData *nd = flux_node_store_get(tv->store, *out);
+	FluxNodeData *nd = flux_node_store_edit(tv->store, *out);
 	if (nd) {
-		nd->behavior.on_pointer_down     = tv_scroll_btn_down;
-		nd->behavior.on_pointer_down_ctx = slot;
-		nd->behavior.on_click            = tv_scroll_btn_release; /* repeat ends on release */
-		nd->behavior.on_click_ctx        = slot;
-		nd->behavior.on_cancel           = tv_scroll_btn_release;
-		nd->behavior.on_cancel_ctx       = slot;
+		nd->behavior->on_pointer_down     = tv_scroll_btn_down;
+		nd->behavior->on_pointer_down_ctx = slot;
+		nd->behavior->on_click            = tv_scroll_btn_release; /* repeat ends on release */
+		nd->behavior->on_click_ctx        = slot;
+		nd->behavior->on_cancel           = tv_scroll_btn_release;
+		nd->behavior->on_cancel_ctx       = slot;
 	}
 }
 
@@ -694,7 +695,7 @@ static void tv_make_tabs_host(FluxTabViewData *tv) {
 	xent_set_flex_grow(tv->ctx, tv->tabs_host, 1.0f);
 	xent_set_size(tv->ctx, tv->tabs_host, (XentSize) {NAN, FLUX_TAB_MIN_H});
 
-	FluxNodeData   *nd = flux_node_store_get(tv->store, tv->tabs_host);
+	FluxNodeData   *nd = flux_node_store_edit(tv->store, tv->tabs_host);
 	FluxScrollData *sd = ( FluxScrollData * ) calloc(1, sizeof(*sd));
 	if (!nd || !sd) {
 		free(sd);
@@ -747,7 +748,7 @@ XentNodeId flux_create_tab_view(FluxTabViewCreateInfo const *info) {
 	XentNodeId root = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_TAB_VIEW);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData    *nd = flux_node_store_get(info->store, root);
+	FluxNodeData    *nd = flux_node_store_edit(info->store, root);
 	FluxTabViewData *tv = nd ? ( FluxTabViewData * ) calloc(1, sizeof(*tv)) : NULL;
 	if (!nd || !tv) {
 		free(tv);
@@ -791,7 +792,7 @@ static void tv_close_click(void *ctx) {
 static void tv_make_close_button(FluxTabViewData *tv, FluxTabViewItem *slot) {
 	slot->close_node = flux_factory_create_node(tv->ctx, tv->store, slot->tab_node, FLUX_CONTROL_TAB_VIEW_ITEM);
 	xent_set_size(tv->ctx, slot->close_node, (XentSize) {0.0f, 0.0f});
-	FluxNodeData    *cn = flux_node_store_get(tv->store, slot->close_node);
+	FluxNodeData    *cn = flux_node_store_edit(tv->store, slot->close_node);
 	FluxTabViewItem *ci = &tv->close_items [slot->index];
 	if (!cn) return;
 	*ci = (FluxTabViewItem) {
@@ -801,30 +802,30 @@ static void tv_make_close_button(FluxTabViewData *tv, FluxTabViewItem *slot) {
 	  .kind       = FLUX_TAB_KIND_CLOSE,
 	  .index      = slot->index};
 	cn->component_data                = ci;
-	cn->behavior.on_click             = tv_close_click;
-	cn->behavior.on_click_ctx         = ci;
-	cn->behavior.on_hover_changed     = tv_hover_changed;
-	cn->behavior.on_hover_changed_ctx = slot;
+	cn->behavior->on_click             = tv_close_click;
+	cn->behavior->on_click_ctx         = ci;
+	cn->behavior->on_hover_changed     = tv_hover_changed;
+	cn->behavior->on_hover_changed_ctx = slot;
 }
 
 static void tv_bind_tab_node(FluxTabViewData *tv, FluxTabViewItem *slot, XentNodeId tab, char const *label) {
-	FluxNodeData *tn = flux_node_store_get(tv->store, tab);
+	FluxNodeData *tn = flux_node_store_edit(tv->store, tab);
 	if (tn) {
 		tn->component_data                = slot;
-		tn->behavior.on_click             = tv_item_click;
-		tn->behavior.on_click_ctx         = slot;
-		tn->behavior.on_pointer_down      = tv_item_down;
-		tn->behavior.on_pointer_down_ctx  = slot;
-		tn->behavior.on_pointer_move      = tv_item_move;
-		tn->behavior.on_pointer_move_ctx  = slot;
-		tn->behavior.on_cancel            = tv_item_cancel;
-		tn->behavior.on_cancel_ctx        = slot;
-		tn->behavior.on_middle_click      = tv_item_middle_click;
-		tn->behavior.on_middle_click_ctx  = slot;
-		tn->behavior.on_hover_changed     = tv_hover_changed;
-		tn->behavior.on_hover_changed_ctx = slot;
-		tn->behavior.on_key               = tv_item_key;
-		tn->behavior.on_key_ctx           = slot;
+		tn->behavior->on_click             = tv_item_click;
+		tn->behavior->on_click_ctx         = slot;
+		tn->behavior->on_pointer_down      = tv_item_down;
+		tn->behavior->on_pointer_down_ctx  = slot;
+		tn->behavior->on_pointer_move      = tv_item_move;
+		tn->behavior->on_pointer_move_ctx  = slot;
+		tn->behavior->on_cancel            = tv_item_cancel;
+		tn->behavior->on_cancel_ctx        = slot;
+		tn->behavior->on_middle_click      = tv_item_middle_click;
+		tn->behavior->on_middle_click_ctx  = slot;
+		tn->behavior->on_hover_changed     = tv_hover_changed;
+		tn->behavior->on_hover_changed_ctx = slot;
+		tn->behavior->on_key               = tv_item_key;
+		tn->behavior->on_key_ctx           = slot;
 	}
 	xent_set_focusable(tv->ctx, tab, true);
 	xent_set_semantic_role(tv->ctx, tab, XENT_SEMANTIC_BUTTON);
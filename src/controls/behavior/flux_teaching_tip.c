@@ -72,7 +72,7 @@ typedef struct FluxTipRuntime {
 
 	bool                  anim_expand;
 	bool                  anim_contract;
-	DWORD                 anim_start;           /**< GetTickCount at animation start. */
+	DWORD                 anim_start;           /**< flux_anim_now at animation start. */
 	float                 from_sx, from_sy;
 	float                 to_sx, to_sy;
 	float                 cur_sx, cur_sy;
@@ -88,11 +88,17 @@ static void tip_open(FluxTipRuntime *rt);
 static void tip_close(FluxTipRuntime *rt, FluxTeachingTipCloseReason reason);
 
 static FluxTipRuntime *tip_runtime(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_TEACHING_TIP || !nd->component_data) return NULL;
 	return ( FluxTipRuntime * ) nd->component_data;
 }
 
+static FluxTipRuntime const *tip_read(FluxNodeStore *store, XentNodeId id) {
+	FluxNodeData const *nd = flux_node_store_get(store, id);
+	if (!nd || nd->component_type != FLUX_CONTROL_TEACHING_TIP || !nd->component_data) return NULL;
+	return ( FluxTipRuntime const * ) nd->component_data;
+}
+
 static void tip_repaint_owner(FluxTipRuntime *rt) {
 	HWND h = flux_window_hwnd(rt->window);
 	if (h) InvalidateRect(h, NULL, FALSE);
@@ -574,7 +580,7 @@ static bool tip_anim_step(void *ctx, unsigned long now) {
 static void tip_anim_start(FluxTipRuntime *rt, bool expand) {
 	rt->anim_expand   = expand;
 	rt->anim_contract = !expand;
-	rt->anim_start    = GetTickCount();
+	rt->anim_start    = flux_anim_now();
 	if (expand) {
 		rt->from_sx = flux_minf(0.01f, 20.0f / rt->tip_w);
 		rt->from_sy = flux_minf(0.01f, 20.0f / rt->tip_h);
@@ -828,7 +834,7 @@ XentNodeId flux_create_teaching_tip(FluxTeachingTipCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_TEACHING_TIP);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData   *nd = flux_node_store_get(info->store, node);
+	FluxNodeData   *nd = flux_node_store_edit(info->store, node);
 	FluxTipRuntime *rt = nd ? ( FluxTipRuntime * ) calloc(1, sizeof(*rt)) : NULL;
 	if (!nd || !rt) {
 		free(rt);
@@ -847,8 +853,8 @@ XentNodeId flux_create_teaching_tip(FluxTeachingTipCreateInfo const *info) {
 
 	nd->component_data         = &rt->model;
 	nd->destroy_component_data = tip_destroy;
-	nd->behavior.on_key        = tip_on_key;
-	nd->behavior.on_key_ctx    = rt;
+	nd->behavior->on_key        = tip_on_key;
+	nd->behavior->on_key_ctx    = rt;
 
 	/* Zero-size absolute stub: the anchor's layout stays untouched; the node
 	 * only carries focus (Esc/F6) and owns the retained popup. Destroying the
@@ -870,7 +876,7 @@ void flux_teaching_tip_hide(FluxNodeStore *store, XentNodeId tip) {
 }
 
 bool flux_teaching_tip_is_open(FluxNodeStore *store, XentNodeId tip) {
-	FluxTipRuntime *rt = tip_runtime(store, tip);
+	FluxTipRuntime const *rt = tip_read(store, tip);
 	return rt && rt->model.open;
 }
 
@@ -17,7 +17,7 @@
 #include <string.h>
 
 static FluxTitleBarData *titlebar_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_TITLE_BAR || !nd->component_data) return NULL;
 	return ( FluxTitleBarData * ) nd->component_data;
 }
@@ -126,7 +126,7 @@ XentNodeId flux_create_title_bar(FluxTitleBarCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_TITLE_BAR);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData     *nd = flux_node_store_get(info->store, node);
+	FluxNodeData     *nd = flux_node_store_edit(info->store, node);
 	FluxTitleBarData *d  = nd ? ( FluxTitleBarData * ) calloc(1, sizeof(*d)) : NULL;
 	if (!nd || !d) {
 		free(d);
@@ -153,14 +153,14 @@ XentNodeId flux_create_title_bar(FluxTitleBarCreateInfo const *info) {
 
 	nd->component_data               = d;
 	nd->destroy_component_data       = titlebar_destroy;
-	nd->behavior.on_pointer_down     = titlebar_pointer_down;
-	nd->behavior.on_pointer_down_ctx = d;
-	nd->behavior.on_click            = titlebar_click;
-	nd->behavior.on_click_ctx        = d;
-	nd->behavior.tooltip_at          = titlebar_tooltip_at;
-	nd->behavior.tooltip_at_ctx      = d;
-	nd->behavior.on_cancel           = titlebar_cancel;
-	nd->behavior.on_cancel_ctx       = d;
+	nd->behavior->on_pointer_down     = titlebar_pointer_down;
+	nd->behavior->on_pointer_down_ctx = d;
+	nd->behavior->on_click            = titlebar_click;
+	nd->behavior->on_click_ctx        = d;
+	nd->behavior->tooltip_at          = titlebar_tooltip_at;
+	nd->behavior->tooltip_at_ctx      = d;
+	nd->behavior->on_cancel           = titlebar_cancel;
+	nd->behavior->on_cancel_ctx       = d;
 
 	xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_CONTAINER);
 	/* Fixed compact height; stretch across the container's width (a definite
@@ -37,14 +37,39 @@
 
 #define TREE_OVERSCAN      4  /* extra rows realized beyond the viewport (xtk list default) */
 #define TREE_FALLBACK_ROWS 32 /* first window before layout has produced a viewport */
+#define TREE_PLACEHOLDER_TEXT "Loading..."
 
+/* Public handles pack the pool index with the slot's generation, so a handle
+ * kept across a removal or an eviction no longer names the slot's next node. */
+#define TREE_HANDLE_INDEX_BITS 20
+#define TREE_HANDLE_INDEX_MASK ((1 << TREE_HANDLE_INDEX_BITS) - 1)
+#define TREE_HANDLE_GEN_MASK   0x7FF /* keeps packed handles positive */
+
+/* Mutators only: the lookup touches the tree and its ancestors. */
 static FluxTreeViewData *tree_data(FluxNodeStore *store, XentNodeId id) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData const *nd = flux_node_store_get(store, id);
+	if (!nd || nd->component_type != FLUX_CONTROL_TREE_VIEW || !nd->component_data) return NULL;
+	return ( FluxTreeViewData * ) flux_node_store_edit(store, id)->component_data;
+}
+
+/* Queries: no touch, so a frame that only asks keeps its retained commands. */
+static FluxTreeViewData const *tree_read(FluxNodeStore *store, XentNodeId id) {
+	FluxNodeData const *nd = flux_node_store_get(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_TREE_VIEW || !nd->component_data) return NULL;
-	return ( FluxTreeViewData * ) nd->component_data;
+	return ( FluxTreeViewData const * ) nd->component_data;
 }
 
-static bool tree_valid(FluxTreeViewData const *d, int h) { return h >= 0 && h < d->node_count && d->nodes [h].in_use; }
+static int tree_handle(FluxTreeViewData const *d, int h) {
+	return h < 0 ? -1 : ( int ) d->nodes [h].generation << TREE_HANDLE_INDEX_BITS | h;
+}
+
+/* Pool index of a public handle, or -1 if it is stale or was never issued. */
+static int tree_resolve(FluxTreeViewData const *d, int handle) {
+	if (handle < 0) return -1;
+	int h = handle & TREE_HANDLE_INDEX_MASK;
+	if (h >= d->node_count || !d->nodes [h].in_use) return -1;
+	return d->nodes [h].generation == (handle >> TREE_HANDLE_INDEX_BITS) ? h : -1;
+}
 
 static bool tree_multi(FluxTreeViewData const *d) { return d->sel_mode == XTK_TREE_SELECT_MULTIPLE; }
 
@@ -62,13 +87,16 @@ static void tree_repaint(FluxTreeViewData *d) {
  * Node pool (handles are pool indices; free slots chain through next_sibling)
  * ---------------------------------------------------------------------- */
 
-/* Grow the pool when full; false = allocation failure. */
+/* Grow the pool (and the handle→flat map with it) when full; false = allocation failure. */
 static bool tree_pool_reserve(FluxTreeViewData *d) {
 	if (d->node_count < d->node_cap) return true;
+	if (d->node_cap > TREE_HANDLE_INDEX_MASK) return false;
 	int           cap = d->node_cap ? d->node_cap * 2 : 32;
 	FluxTreeNode *n   = ( FluxTreeNode * ) realloc(d->nodes, sizeof(*n) * ( size_t ) cap);
-	if (!n) return false;
-	d->nodes    = n;
+	if (n) d->nodes = n;
+	int *map = ( int * ) realloc(d->flat_of, sizeof(*map) * ( size_t ) cap);
+	if (map) d->flat_of = map;
+	if (!n || !map) return false;
 	d->node_cap = cap;
 	return true;
 }
@@ -79,48 +107,82 @@ static int tree_node_alloc(FluxTreeViewData *d) {
 	else {
 		if (!tree_pool_reserve(d)) return -1;
 		h = d->node_count++;
+		d->nodes [h].generation = 0;
 	}
+	uint16_t gen = d->nodes [h].generation;
 	memset(&d->nodes [h], 0, sizeof(d->nodes [h]));
+	d->nodes [h].generation   = gen;
 	d->nodes [h].parent       = -1;
 	d->nodes [h].first_child  = -1;
 	d->nodes [h].next_sibling = -1;
 	d->nodes [h].in_use       = true;
+	d->flat_of [h]            = -1;
 	return h;
 }
 
+static void tree_node_release(FluxTreeViewData *d, int h) {
+	flux_str_free(d->nodes [h].text);
+	flux_str_free(d->nodes [h].icon_name);
+	d->nodes [h].in_use       = false;
+	d->nodes [h].generation   = ( uint16_t ) ((d->nodes [h].generation + 1) & TREE_HANDLE_GEN_MASK);
+	d->nodes [h].next_sibling = d->free_head;
+	d->free_head              = h;
+}
+
 /* -------------------------------------------------------------------------
  * Flatten (ViewModel.cpp): a node is visible iff every ancestor is expanded;
- * the flat list is the pre-order DFS of the expanded tree.
+ * the flat list is the pre-order DFS of the expanded tree. Expand, collapse,
+ * add and remove splice only the affected run; every walk follows parent
+ * links instead of recursing, so tree depth never reaches the C stack.
  * ---------------------------------------------------------------------- */
 
-static bool tree_flat_push(FluxTreeViewData *d, int h) {
-	if (d->flat_count == d->flat_cap) {
-		int  cap = d->flat_cap ? d->flat_cap * 2 : 64;
-		int *f   = ( int * ) realloc(d->flat, sizeof(*f) * ( size_t ) cap);
-		if (!f) return false;
-		d->flat     = f;
-		d->flat_cap = cap;
-	}
-	d->flat [d->flat_count++] = h;
+/* Pre-order successor of @p h inside the subtree rooted at @p top (-1 = the
+ * whole forest); @p visible_only skips the children of collapsed nodes. */
+static int tree_next(FluxTreeViewData const *d, int h, int top, bool visible_only) {
+	FluxTreeNode const *n = &d->nodes [h];
+	if (n->first_child >= 0 && (n->expanded || !visible_only)) return n->first_child;
+	for (; h != top; h = d->nodes [h].parent)
+		if (d->nodes [h].next_sibling >= 0) return d->nodes [h].next_sibling;
+	return -1;
+}
+
+static bool tree_flat_reserve(FluxTreeViewData *d, int count) {
+	if (count <= d->flat_cap) return true;
+	int cap = d->flat_cap ? d->flat_cap * 2 : 64;
+	if (cap < count) cap = count;
+	int *f = ( int * ) realloc(d->flat, sizeof(*f) * ( size_t ) cap);
+	if (!f) return false;
+	d->flat     = f;
+	d->flat_cap = cap;
 	return true;
 }
 
-static void tree_flatten_chain(FluxTreeViewData *d, int first) {
-	for (int c = first; c >= 0; c = d->nodes [c].next_sibling) {
-		if (!tree_flat_push(d, c)) return;
-		if (d->nodes [c].expanded && d->nodes [c].first_child >= 0) tree_flatten_chain(d, d->nodes [c].first_child);
-	}
+/* Open @p n rows at @p pos; rows from pos on move, so their map entries go stale. */
+static bool tree_flat_open(FluxTreeViewData *d, int pos, int n) {
+	if (!tree_flat_reserve(d, d->flat_count + n)) return false;
+	memmove(d->flat + pos + n, d->flat + pos, sizeof(int) * ( size_t ) (d->flat_count - pos));
+	d->flat_count += n;
+	if (d->map_valid > pos) d->map_valid = pos;
+	return true;
 }
 
-static void tree_rebuild_flat(FluxTreeViewData *d) {
-	d->flat_count = 0;
-	tree_flatten_chain(d, d->first_root);
-	if (d->focused_flat > d->flat_count - 1) d->focused_flat = d->flat_count - 1;
+static void tree_flat_close(FluxTreeViewData *d, int pos, int n) {
+	memmove(d->flat + pos, d->flat + pos + n, sizeof(int) * ( size_t ) (d->flat_count - pos - n));
+	d->flat_count -= n;
+	if (d->map_valid > pos) d->map_valid = pos;
 }
 
-static int tree_flat_of(FluxTreeViewData const *d, int h) {
-	for (int i = 0; i < d->flat_count; i++)
-		if (d->flat [i] == h) return i;
+/* Flat index of a node, or -1 when an ancestor is collapsed. Rows below
+ * map_valid are mapped exactly; the first lookup after a splice re-maps the tail. */
+static int tree_flat_of(FluxTreeViewData *d, int h) {
+	int i = d->flat_of [h];
+	if (i >= 0 && i < d->map_valid && d->flat [i] == h) return i;
+	if (d->map_valid < d->flat_count) {
+		for (int j = d->map_valid; j < d->flat_count; j++) d->flat_of [d->flat [j]] = j;
+		d->map_valid = d->flat_count;
+		i            = d->flat_of [h];
+		if (i >= 0 && i < d->flat_count && d->flat [i] == h) return i;
+	}
 	return -1;
 }
 
@@ -132,13 +194,71 @@ static int tree_visible_descendants(FluxTreeViewData const *d, int flat_index) {
 	return n;
 }
 
+/* Splice the visible run under the (now expanded) node at @p flat in after it;
+ * returns the row count inserted. */
+static int tree_flat_expand(FluxTreeViewData *d, int flat) {
+	int h = d->flat [flat];
+	int n = 0;
+	for (int c = tree_next(d, h, h, true); c >= 0; c = tree_next(d, c, h, true)) n++;
+	if (n == 0 || !tree_flat_open(d, flat + 1, n)) return 0;
+	int i = flat + 1;
+	for (int c = tree_next(d, h, h, true); c >= 0; c = tree_next(d, c, h, true)) d->flat [i++] = c;
+	return n;
+}
+
+/* Drop the visible run under the (now collapsed) node at @p flat. */
+static void tree_flat_collapse(FluxTreeViewData *d, int flat) {
+	int n = tree_visible_descendants(d, flat);
+	if (n > 0) tree_flat_close(d, flat + 1, n);
+}
+
+/* Append @p h as the last child of @p parent (or the last root). */
+static void tree_link(FluxTreeViewData *d, int h, int parent) {
+	int *link = parent >= 0 ? &d->nodes [parent].first_child : &d->first_root;
+	while (*link >= 0) link = &d->nodes [*link].next_sibling;
+	*link = h;
+}
+
+/* "Loading..." child shown while a provider fetches @p h's children; it is
+ * disabled so it never selects or invokes. */
+static bool tree_add_placeholder(FluxTreeViewData *d, int h) {
+	int c = tree_node_alloc(d);
+	if (c < 0) return false;
+	FluxTreeNode *n = &d->nodes [c];
+	n->parent       = h;
+	n->text         = flux_str_dup(TREE_PLACEHOLDER_TEXT);
+	n->depth        = ( int16_t ) (d->nodes [h].depth + 1);
+	n->sel_state    = d->nodes [h].sel_state == FLUX_TREE_SEL_SELECTED ? FLUX_TREE_SEL_SELECTED : FLUX_TREE_SEL_NONE;
+	n->disabled     = true;
+	n->placeholder  = true;
+	tree_link(d, c, h);
+	d->nodes [h].load = FLUX_TREE_LOAD_PENDING;
+	return true;
+}
+
+/* Change a node's expansion, splicing its run when the node is on screen.
+ * The first expand of a node with unsupplied children shows the placeholder
+ * and asks the provider; collapses are stamped for eviction. */
+static void tree_apply_expanded(FluxTreeViewData *d, int h, bool expanded) {
+	bool fetch = expanded && d->nodes [h].load == FLUX_TREE_LOAD_UNLOADED && d->on_populate
+	          && tree_add_placeholder(d, h);
+	d->nodes [h].expanded = expanded;
+	if (!expanded) d->nodes [h].collapsed_at = flux_anim_now();
+
+	int flat = d->nodes [h].first_child >= 0 ? tree_flat_of(d, h) : -1;
+	if (flat >= 0) {
+		if (expanded) tree_flat_expand(d, flat);
+		else tree_flat_collapse(d, flat);
+	}
+	if (fetch) d->on_populate(d->userdata, tree_handle(d, h));
+}
+
 /* -------------------------------------------------------------------------
  * Tri-state cascade selection (ViewModel.cpp UpdateSelection)
  * ---------------------------------------------------------------------- */
 
 static void tree_cascade_down(FluxTreeViewData *d, int h, uint8_t state) {
-	d->nodes [h].sel_state = state;
-	for (int c = d->nodes [h].first_child; c >= 0; c = d->nodes [c].next_sibling) tree_cascade_down(d, c, state);
+	for (int c = h; c >= 0; c = tree_next(d, c, h, false)) d->nodes [c].sel_state = state;
 }
 
 /* Any Partial child, or a mix of Selected + UnSelected → Partial; else
@@ -181,7 +301,7 @@ static XentNodeId tree_make_row(FluxTreeViewData *d) {
 	XentNodeId node = flux_factory_create_node(d->ctx, d->store, d->host, FLUX_CONTROL_TREE_ITEM);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData     *nd = flux_node_store_get(d->store, node);
+	FluxNodeData     *nd = flux_node_store_edit(d->store, node);
 	FluxTreeItemData *it = nd ? ( FluxTreeItemData * ) calloc(1, sizeof(FluxTreeItemData)) : NULL;
 	if (!nd || !it) {
 		free(it);
@@ -192,12 +312,12 @@ static XentNodeId tree_make_row(FluxTreeViewData *d) {
 
 	nd->component_data               = it;
 	nd->destroy_component_data       = free;
-	nd->behavior.on_click            = tree_item_click;
-	nd->behavior.on_click_ctx        = it;
-	nd->behavior.on_pointer_down     = tree_item_down;
-	nd->behavior.on_pointer_down_ctx = it;
-	nd->behavior.on_key              = tree_item_key;
-	nd->behavior.on_key_ctx          = it;
+	nd->behavior->on_click            = tree_item_click;
+	nd->behavior->on_click_ctx        = it;
+	nd->behavior->on_pointer_down     = tree_item_down;
+	nd->behavior->on_pointer_down_ctx = it;
+	nd->behavior->on_key              = tree_item_key;
+	nd->behavior->on_key_ctx          = it;
 
 	xent_set_focusable(d->ctx, node, true);
 	xent_set_semantic_role(d->ctx, node, XENT_SEMANTIC_BUTTON);
@@ -253,7 +373,7 @@ static void tree_realize(FluxTreeViewData *d) {
 	float pitch = tree_pitch(d);
 	for (int i = 0; i < d->row_count; i++) {
 		int           flat = first + i;
-		FluxNodeData *nd   = flux_node_store_get(d->store, d->rows [i]);
+		FluxNodeData *nd   = flux_node_store_edit(d->store, d->rows [i]);
 		if (!nd || !nd->component_data) continue;
 		FluxTreeItemData *it   = ( FluxTreeItemData * ) nd->component_data;
 		FluxTreeNode const *n  = &d->nodes [d->flat [flat]];
@@ -266,6 +386,7 @@ static void tree_realize(FluxTreeViewData *d) {
 		xent_set_semantic_enabled(d->ctx, d->rows [i], !n->disabled);
 		if (n->text) xent_set_semantic_label(d->ctx, d->rows [i], n->text);
 	}
+	flux_node_store_invalidate_layout(d->store);
 	d->win_first = first;
 	d->win_count = d->row_count;
 	flux_list_view_set_realized(d->store, d->list, first, first + d->row_count - 1, 1);
@@ -276,9 +397,9 @@ static XentNodeId tree_row_for_flat(FluxTreeViewData const *d, int flat) {
 	return d->rows [flat - d->win_first];
 }
 
-/* Model changed: rebuild the flat list, resize the host extent, re-realize. */
+/* Flat list changed: resize the host extent, keep focus in range, re-realize. */
 static void tree_sync_flat(FluxTreeViewData *d) {
-	tree_rebuild_flat(d);
+	if (d->focused_flat > d->flat_count - 1) d->focused_flat = d->flat_count - 1;
 	flux_list_view_set_extent(d->store, d->list, d->flat_count, tree_pitch(d), 0.0f, 1);
 	tree_realize(d);
 }
@@ -298,7 +419,7 @@ static bool tree_tick_entrance(FluxTreeViewData *d, DWORD now) {
 	float p = flux_cubic_bezier(t, 0.0f, 0.0f, 0.0f, 1.0f);
 
 	for (int i = 0; i < d->row_count; i++) {
-		FluxNodeData *nd = flux_node_store_get(d->store, d->rows [i]);
+		FluxNodeData *nd = flux_node_store_edit(d->store, d->rows [i]);
 		if (!nd) continue;
 		int  flat              = d->win_first + i;
 		bool entering          = flat >= d->anim_first && flat < d->anim_first + d->anim_count;
@@ -338,22 +459,22 @@ static void tree_on_stale(void *ctx) {
 
 static void tree_toggle_expand(FluxTreeViewData *d, int flat) {
 	int           h = d->flat [flat];
-	FluxTreeNode *n = &d->nodes [h];
-	if (n->first_child < 0) return;
-	n->expanded = !n->expanded;
+	if (!flux_tree_node_has_children(d, &d->nodes [h])) return;
+	bool expanded = !d->nodes [h].expanded;
+	tree_apply_expanded(d, h, expanded); /* a provider may grow the pool here */
 	tree_sync_flat(d);
 
 	d->anim_count = 0;
-	if (n->expanded && d->window) {
+	if (expanded && d->window) {
 		d->anim_first = flat + 1;
 		d->anim_count = tree_visible_descendants(d, flat);
-		d->anim_start = GetTickCount();
+		d->anim_start = flux_anim_now();
 		if (d->anim_count > 0) {
 			flux_anim_register(d, tree_step);
 			tree_tick_entrance(d, d->anim_start); /* first painted frame starts faded */
 		}
 	}
-	if (d->on_expand) d->on_expand(d->userdata, flat, n->expanded);
+	if (d->on_expand) d->on_expand(d->userdata, flat, expanded);
 	tree_repaint(d);
 }
 
@@ -424,7 +545,7 @@ static bool tree_key_nav(FluxTreeViewData *d, int flat, unsigned int vk) {
 
 /* LTR Right: expand a collapsed parent, else hop to the first child. */
 static bool tree_key_right(FluxTreeViewData *d, FluxTreeNode const *n, int flat) {
-	if (n->first_child < 0) return false;
+	if (!flux_tree_node_has_children(d, n)) return false;
 	if (!n->expanded) {
 		tree_toggle_expand(d, flat);
 		return true;
@@ -514,7 +635,7 @@ static void tree_item_down(void *ctx, float x, float y, int clicks) {
 	}
 	else chevron = x >= ix && x < ix + FLUX_TREE_CHEVRON_ZONE;
 
-	if (chevron && n->first_child >= 0) { /* leaf zone presses fall through to the row */
+	if (chevron && flux_tree_node_has_children(d, n)) { /* leaf zone presses fall through to the row */
 		it->press_on_chevron = true;
 		tree_toggle_expand(d, flat);
 	}
@@ -559,6 +680,7 @@ static void tree_destroy(void *component_data) {
 	/* Row nodes are subtree children — the store tears them down. */
 	free(d->nodes);
 	free(d->flat);
+	free(d->flat_of);
 	free(d->rows);
 	free(d);
 }
@@ -569,7 +691,7 @@ XentNodeId flux_create_tree_view(FluxTreeViewCreateInfo const *info) {
 	XentNodeId root = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_TREE_VIEW);
 	if (root == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData     *nd = flux_node_store_get(info->store, root);
+	FluxNodeData     *nd = flux_node_store_edit(info->store, root);
 	FluxTreeViewData *d  = nd ? ( FluxTreeViewData * ) calloc(1, sizeof(*d)) : NULL;
 	if (!nd || !d) {
 		free(d);
@@ -607,6 +729,7 @@ XentNodeId flux_create_tree_view(FluxTreeViewCreateInfo const *info) {
 	d->on_invoke    = info->on_invoke;
 	d->on_expand    = info->on_expand;
 	d->on_select    = info->on_select;
+	d->on_populate  = info->on_populate;
 	d->userdata     = info->userdata;
 
 	nd->component_data         = d;
@@ -624,7 +747,7 @@ XentNodeId flux_create_tree_view(FluxTreeViewCreateInfo const *info) {
 int flux_tree_view_add_node(FluxNodeStore *store, XentNodeId tree, int parent, char const *text, char const *icon) {
 	FluxTreeViewData *d = tree_data(store, tree);
 	if (!d) return -1;
-	if (parent >= 0 && !tree_valid(d, parent)) return -1;
+	if (parent >= 0 && (parent = tree_resolve(d, parent)) < 0) return -1;
 	int h = tree_node_alloc(d);
 	if (h < 0) return -1;
 
@@ -639,27 +762,48 @@ int flux_tree_view_add_node(FluxNodeStore *store, XentNodeId tree, int parent, c
 	if (tree_multi(d) && parent >= 0 && d->nodes [parent].sel_state == FLUX_TREE_SEL_SELECTED)
 		n->sel_state = FLUX_TREE_SEL_SELECTED;
 
-	int *link = parent >= 0 ? &d->nodes [parent].first_child : &d->first_root;
-	while (*link >= 0) link = &d->nodes [*link].next_sibling;
-	*link = h;
+	/* A visible new node lands at the end of its parent's run. */
+	int pos = d->flat_count;
+	if (parent >= 0) {
+		int pf = d->nodes [parent].expanded ? tree_flat_of(d, parent) : -1;
+		pos    = pf >= 0 ? pf + 1 + tree_visible_descendants(d, pf) : -1;
+	}
+	if (pos >= 0) {
+		if (!tree_flat_open(d, pos, 1)) {
+			tree_node_release(d, h);
+			return -1;
+		}
+		d->flat [pos]  = h;
+		d->flat_of [h] = pos;
+		if (pos == d->flat_count - 1 && d->map_valid == pos) d->map_valid = d->flat_count; /* appends stay mapped */
+	}
 
+	tree_link(d, h, parent);
+	if (parent >= 0 && d->nodes [parent].load == FLUX_TREE_LOAD_UNLOADED) d->nodes [parent].load = FLUX_TREE_LOAD_READY;
 	tree_sync_flat(d);
 	tree_repaint(d);
-	return h;
-}
-
-static void tree_free_subtree(FluxTreeViewData *d, int h) {
-	for (int c = d->nodes [h].first_child; c >= 0;) {
-		int next = d->nodes [c].next_sibling;
-		tree_free_subtree(d, c);
-		c = next;
+	return tree_handle(d, h);
+}
+
+/* Post-order without a stack: detach the first child and descend into it;
+ * a node is released once it has no children left. Returns the nodes freed. */
+static int tree_free_subtree(FluxTreeViewData *d, int h) {
+	int c     = h;
+	int freed = 0;
+	for (;;) {
+		int child = d->nodes [c].first_child;
+		if (child >= 0) {
+			d->nodes [c].first_child = d->nodes [child].next_sibling;
+			c                        = child;
+			continue;
+		}
+		int parent = d->nodes [c].parent;
+		if (d->selected == c) d->selected = -1;
+		tree_node_release(d, c);
+		freed++;
+		if (c == h) return freed;
+		c = parent;
 	}
-	if (d->selected == h) d->selected = -1;
-	flux_str_free(d->nodes [h].text);
-	flux_str_free(d->nodes [h].icon_name);
-	d->nodes [h].in_use       = false;
-	d->nodes [h].next_sibling = d->free_head;
-	d->free_head              = h;
 }
 
 static void tree_unlink(FluxTreeViewData *d, int h) {
@@ -669,10 +813,10 @@ static void tree_unlink(FluxTreeViewData *d, int h) {
 	if (*link == h) *link = d->nodes [h].next_sibling;
 }
 
-void flux_tree_view_remove_node(FluxNodeStore *store, XentNodeId tree, int node) {
-	FluxTreeViewData *d = tree_data(store, tree);
-	if (!d || !tree_valid(d, node)) return;
+static void tree_remove(FluxTreeViewData *d, int node) {
 	int parent = d->nodes [node].parent;
+	int flat   = tree_flat_of(d, node);
+	if (flat >= 0) tree_flat_close(d, flat, 1 + tree_visible_descendants(d, flat));
 	tree_unlink(d, node);
 	tree_free_subtree(d, node);
 	/* Removal can flip an ancestor between Partial/Selected/UnSelected. */
@@ -684,6 +828,12 @@ void flux_tree_view_remove_node(FluxNodeStore *store, XentNodeId tree, int node)
 	tree_repaint(d);
 }
 
+void flux_tree_view_remove_node(FluxNodeStore *store, XentNodeId tree, int node) {
+	FluxTreeViewData *d = tree_data(store, tree);
+	if (!d || (node = tree_resolve(d, node)) < 0) return;
+	tree_remove(d, node);
+}
+
 void flux_tree_view_clear(FluxNodeStore *store, XentNodeId tree) {
 	FluxTreeViewData *d = tree_data(store, tree);
 	if (!d) return;
@@ -692,22 +842,84 @@ void flux_tree_view_clear(FluxNodeStore *store, XentNodeId tree) {
 		d->first_root = d->nodes [r].next_sibling;
 		tree_free_subtree(d, r);
 	}
-	d->selected = -1;
+	d->selected   = -1;
+	d->flat_count = 0;
+	d->map_valid  = 0;
 	tree_sync_flat(d);
 	tree_repaint(d);
 }
 
+/* on_populate is a data request, not an event: it still runs here, or a
+ * programmatically expanded lazy node would never get its children. */
 void flux_tree_view_set_expanded(FluxNodeStore *store, XentNodeId tree, int node, bool expanded) {
 	FluxTreeViewData *d = tree_data(store, tree);
-	if (!d || !tree_valid(d, node) || d->nodes [node].expanded == expanded) return;
-	d->nodes [node].expanded = expanded;
+	if (!d || (node = tree_resolve(d, node)) < 0 || d->nodes [node].expanded == expanded) return;
+	tree_apply_expanded(d, node, expanded);
 	tree_sync_flat(d);
 	tree_repaint(d);
 }
 
+void flux_tree_view_set_has_children(FluxNodeStore *store, XentNodeId tree, int node, bool has_children) {
+	FluxTreeViewData *d = tree_data(store, tree);
+	if (!d || (node = tree_resolve(d, node)) < 0 || d->nodes [node].load == FLUX_TREE_LOAD_PENDING) return;
+	FluxTreeNode *n = &d->nodes [node];
+	if (!has_children) n->load = FLUX_TREE_LOAD_NONE;
+	else n->load = n->first_child >= 0 ? FLUX_TREE_LOAD_READY : FLUX_TREE_LOAD_UNLOADED;
+	n->collapsed_at = flux_anim_now();
+	tree_realize(d); /* chevron */
+	tree_repaint(d);
+}
+
+/* Children arrived (added through flux_tree_view_add_node while pending):
+ * drop the placeholder. A node left without children becomes a leaf. */
+void flux_tree_view_finish_children(FluxNodeStore *store, XentNodeId tree, int node) {
+	FluxTreeViewData *d = tree_data(store, tree);
+	if (!d || (node = tree_resolve(d, node)) < 0 || d->nodes [node].load != FLUX_TREE_LOAD_PENDING) return;
+	d->nodes [node].load = FLUX_TREE_LOAD_READY;
+	for (int c = d->nodes [node].first_child; c >= 0; c = d->nodes [c].next_sibling) {
+		if (!d->nodes [c].placeholder) continue;
+		tree_remove(d, c);
+		return;
+	}
+	tree_realize(d);
+	tree_repaint(d);
+}
+
+static bool tree_is_ancestor(FluxTreeViewData const *d, int ancestor, int h) {
+	for (int p = h >= 0 ? d->nodes [h].parent : -1; p >= 0; p = d->nodes [p].parent)
+		if (p == ancestor) return true;
+	return false;
+}
+
+/* Collapsed runs are off the flat list, so freeing them never splices; the
+ * node falls back to UNLOADED and its next expand asks the provider again.
+ * Subtrees holding the Single selection or a Partial state are kept, since
+ * a re-fetch could not restore them; without a provider nothing is. Freed
+ * slots are reissued under a new generation, so the provider's old handles
+ * stop resolving. */
+int flux_tree_view_evict_collapsed(FluxNodeStore *store, XentNodeId tree, unsigned long idle_ms) {
+	FluxTreeViewData *d = tree_data(store, tree);
+	if (!d || !d->on_populate) return 0;
+	DWORD now   = flux_anim_now();
+	int   freed = 0;
+	for (int h = 0; h < d->node_count; h++) {
+		FluxTreeNode *n = &d->nodes [h];
+		if (!n->in_use || n->load != FLUX_TREE_LOAD_READY || n->expanded || n->first_child < 0) continue;
+		if (now - n->collapsed_at < idle_ms || n->sel_state == FLUX_TREE_SEL_PARTIAL) continue;
+		if (d->sel_mode == XTK_TREE_SELECT_SINGLE && tree_is_ancestor(d, h, d->selected)) continue;
+		while (n->first_child >= 0) {
+			int c          = n->first_child;
+			n->first_child = d->nodes [c].next_sibling;
+			freed         += tree_free_subtree(d, c);
+		}
+		n->load = FLUX_TREE_LOAD_UNLOADED;
+	}
+	return freed;
+}
+
 void flux_tree_view_set_node_disabled(FluxNodeStore *store, XentNodeId tree, int node, bool disabled) {
 	FluxTreeViewData *d = tree_data(store, tree);
-	if (!d || !tree_valid(d, node)) return;
+	if (!d || (node = tree_resolve(d, node)) < 0) return;
 	d->nodes [node].disabled = disabled;
 	tree_realize(d); /* refresh row semantics */
 	tree_repaint(d);
@@ -725,7 +937,7 @@ void flux_tree_view_set_selection_mode(FluxNodeStore *store, XentNodeId tree, Xt
 
 void flux_tree_view_set_selected(FluxNodeStore *store, XentNodeId tree, int node, bool selected) {
 	FluxTreeViewData *d = tree_data(store, tree);
-	if (!d || !tree_valid(d, node)) return;
+	if (!d || (node = tree_resolve(d, node)) < 0) return;
 	if (d->sel_mode == XTK_TREE_SELECT_SINGLE) d->selected = selected ? node : (d->selected == node ? -1 : d->selected);
 	else if (tree_multi(d)) tree_set_selected_multi(d, node, selected);
 	tree_repaint(d);
@@ -743,24 +955,30 @@ void flux_tree_view_select_all(FluxNodeStore *store, XentNodeId tree) {
  * ---------------------------------------------------------------------- */
 
 bool flux_tree_view_is_expanded(FluxNodeStore *store, XentNodeId tree, int node) {
-	FluxTreeViewData *d = tree_data(store, tree);
-	return d && tree_valid(d, node) && d->nodes [node].expanded;
+	FluxTreeViewData const *d = tree_read(store, tree);
+	return d && (node = tree_resolve(d, node)) >= 0 && d->nodes [node].expanded;
 }
 
 bool flux_tree_view_is_selected(FluxNodeStore *store, XentNodeId tree, int node) {
-	FluxTreeViewData *d = tree_data(store, tree);
-	if (!d || !tree_valid(d, node)) return false;
+	FluxTreeViewData const *d = tree_read(store, tree);
+	if (!d || (node = tree_resolve(d, node)) < 0) return false;
 	if (d->sel_mode == XTK_TREE_SELECT_SINGLE) return d->selected == node;
 	return d->nodes [node].sel_state == FLUX_TREE_SEL_SELECTED;
 }
 
 int flux_tree_view_flat_count(FluxNodeStore *store, XentNodeId tree) {
-	FluxTreeViewData *d = tree_data(store, tree);
+	FluxTreeViewData const *d = tree_read(store, tree);
 	return d ? d->flat_count : 0;
 }
 
 int flux_tree_view_flat_node(FluxNodeStore *store, XentNodeId tree, int flat_index) {
-	FluxTreeViewData *d = tree_data(store, tree);
+	FluxTreeViewData const *d = tree_read(store, tree);
 	if (!d || flat_index < 0 || flat_index >= d->flat_count) return -1;
-	return d->flat [flat_index];
+	return tree_handle(d, d->flat [flat_index]);
+}
+
+int flux_tree_view_node_flat(FluxNodeStore *store, XentNodeId tree, int node) {
+	FluxTreeViewData const *d = tree_read(store, tree);
+	if (!d || (node = tree_resolve(d, node)) < 0) return -1;
+	return tree_flat_of(( FluxTreeViewData * ) d, node); /* re-mapping only refreshes a lookup cache */
 }
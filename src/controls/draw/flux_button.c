@@ -270,14 +270,13 @@ static void button_update_animation(
 	FluxCacheEntry *ce = rc->cache ? flux_render_cache_get_or_create(rc->cache, snap->id) : NULL;
 	if (!ce) return;
 
-	FluxTweenChannels channels  = {&ce->hover_anim, &ce->press_anim, &ce->focus_anim, &ce->check_anim};
-	FluxTweenTargets  targets   = {state->hovered, state->pressed, state->focused, false};
-	bool              animating = flux_tween_update_states(&channels, targets, rc->now);
+	FluxTweenTargets targets   = {state->hovered, state->pressed, state->focused, false};
+	bool             animating = flux_tween_update_states(rc->cache, ce, targets, rc->now);
 	if (animating && rc->animations_active) *rc->animations_active = true;
 
 	FluxColor tweened_fill;
 	bool      color_active
-	  = flux_color_tween_update(&ce->color_anim, colors->fill, FLUX_ANIM_DURATION_FAST, rc->now, &tweened_fill);
+	  = flux_render_cache_color_tween(rc->cache, ce, colors->fill, FLUX_ANIM_DURATION_FAST, rc->now, &tweened_fill);
 	colors->fill = tweened_fill;
 	if (color_active && rc->animations_active) *rc->animations_active = true;
 }
@@ -19,9 +19,8 @@ static void hyperlink_update_animation(
 	float           press_t = state->pressed ? 1.0f : 0.0f;
 
 	if (ce) {
-		FluxTweenChannels channels  = {&ce->hover_anim, &ce->press_anim, &ce->focus_anim, &ce->check_anim};
-		FluxTweenTargets  targets   = {state->hovered, state->pressed, state->focused, false};
-		bool              animating = flux_tween_update_states(&channels, targets, rc->now);
+		FluxTweenTargets targets   = {state->hovered, state->pressed, state->focused, false};
+		bool             animating = flux_tween_update_states(rc->cache, ce, targets, rc->now);
 		if (animating && rc->animations_active) *rc->animations_active = true;
 		hover_t = ce->hover_anim.current;
 		press_t = ce->press_anim.current;
@@ -1,6 +1,8 @@
 #include "render/flux_fluent.h"
 #include "render/flux_image_cache.h"
 
+#include <math.h>
+
 static FluxRect image_dest(FluxRect const *b, float nw, float nh, FluxImageStretch stretch) {
 	if (nw <= 0.0f || nh <= 0.0f || stretch == FLUX_IMAGE_FILL) return *b;
 	if (stretch == FLUX_IMAGE_NONE) return (FluxRect) {b->x + (b->w - nw) * 0.5f, b->y + (b->h - nh) * 0.5f, nw, nh};
@@ -19,12 +21,19 @@ void flux_draw_image(
 	( void ) state;
 	if (!snap->u.image.text_content || !rc->d2d) return;
 
-	float nw = 0.0f, nh = 0.0f;
-	void *bmp = flux_image_cache_acquire(rc->d2d, snap->u.image.text_content, &nw, &nh);
+	/* Decode to the device pixels the bounds cover; Stretch=None draws the natural size. */
+	FluxRect      sb    = flux_snap_bounds(bounds, 1.0f, 1.0f);
+	float         scale = rc->dpi.dpi_x > 0.0f ? rc->dpi.dpi_x / FLUX_DPI_BASE : 1.0f;
+	bool          none  = snap->u.image.stretch == FLUX_IMAGE_NONE;
+	uint32_t      ww    = none ? 0u : ( uint32_t ) ceilf(sb.w * scale);
+	uint32_t      wh    = none ? 0u : ( uint32_t ) ceilf(sb.h * scale);
+	FluxImageInfo info;
+	void         *bmp = flux_image_cache_acquire(rc->d2d, snap->u.image.text_content, ww, wh, &info);
+	/* Left empty (or drawn from another size) while decoding; keep frames coming until it lands. */
+	if (info.state == FLUX_IMAGE_PENDING && rc->animations_active) *rc->animations_active = true;
 	if (!bmp) return;
 
-	FluxRect    sb   = flux_snap_bounds(bounds, 1.0f, 1.0f);
-	FluxRect    dest = image_dest(&sb, nw, nh, snap->u.image.stretch);
+	FluxRect dest = image_dest(&sb, ( float ) info.natural_w, ( float ) info.natural_h, snap->u.image.stretch);
 
 	D2D1_RECT_F clip = flux_d2d_rect(&sb);
 	ID2D1RenderTarget_PushAxisAlignedClip(FLUX_RT(rc), &clip, D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
@@ -128,7 +128,7 @@ static void nb_draw_chrome(NbDrawContext const *dc, bool chrome_hovered) {
 	FluxCacheEntry        *ce   = dc->rc->cache ? flux_render_cache_get_or_create(dc->rc->cache, dc->snap->id) : NULL;
 	if (ce) {
 		FluxColor tweened;
-		bool      a = flux_color_tween_update(&ce->color_anim, fill, FLUX_ANIM_DURATION_FAST, dc->rc->now, &tweened);
+		bool      a = flux_render_cache_color_tween(dc->rc->cache, ce, fill, FLUX_ANIM_DURATION_FAST, dc->rc->now, &tweened);
 		fill        = tweened;
 		if (a && dc->rc->animations_active) *dc->rc->animations_active = true;
 	}
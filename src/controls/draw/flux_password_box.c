@@ -29,7 +29,7 @@ static void pb_draw_chrome(
 	FluxCacheEntry        *ce   = rc->cache ? flux_render_cache_get_or_create(rc->cache, snap->id) : NULL;
 	if (ce) {
 		FluxColor tweened;
-		bool      a = flux_color_tween_update(&ce->color_anim, fill, FLUX_ANIM_DURATION_FAST, rc->now, &tweened);
+		bool      a = flux_render_cache_color_tween(rc->cache, ce, fill, FLUX_ANIM_DURATION_FAST, rc->now, &tweened);
 		fill        = tweened;
 		if (a && rc->animations_active) *rc->animations_active = true;
 	}
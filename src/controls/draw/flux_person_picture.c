@@ -18,19 +18,27 @@
 
 #include "fluxent/controls/flux_person_picture_data.h"
 
+#include <math.h>
 #include <stdio.h>
 
 /* Draw the profile photo clipped to the circle via a UniformToFill bitmap
  * brush filling the ellipse. */
 static bool person_draw_photo(FluxRenderContext const *rc, FluxRect const *box, char const *path, float cx, float cy, float r) {
 	if (!path || !rc->d2d) return false;
-	float nw = 0.0f, nh = 0.0f;
-	void *bmp = flux_image_cache_acquire(rc->d2d, path, &nw, &nh);
-	if (!bmp || nw <= 0.0f || nh <= 0.0f) return false;
-
-	float s  = flux_maxf(box->w / nw, box->h / nh);
-	float tx = box->x + (box->w - nw * s) * 0.5f;
-	float ty = box->y + (box->h - nh * s) * 0.5f;
+	/* Decode to the circle's device pixels, not the photo's natural size. */
+	float         scale = rc->dpi.dpi_x > 0.0f ? rc->dpi.dpi_x / FLUX_DPI_BASE : 1.0f;
+	uint32_t      want  = ( uint32_t ) ceilf(box->w * scale);
+	FluxImageInfo info;
+	void         *bmp = flux_image_cache_acquire(rc->d2d, path, want, want, &info);
+	/* Initials or the glyph stand in while the photo decodes. */
+	if (info.state == FLUX_IMAGE_PENDING && rc->animations_active) *rc->animations_active = true;
+	if (!bmp || !info.width || !info.height) return false;
+
+	/* The brush maps bitmap DIPs (96 DPI, so its pixel size) onto the box, UniformToFill. */
+	float bw = ( float ) info.width, bh = ( float ) info.height;
+	float s  = flux_maxf(box->w / bw, box->h / bh);
+	float tx = box->x + (box->w - bw * s) * 0.5f;
+	float ty = box->y + (box->h - bh * s) * 0.5f;
 
 	D2D1_BITMAP_BRUSH_PROPERTIES bbp = {
 	  D2D1_EXTEND_MODE_CLAMP, D2D1_EXTEND_MODE_CLAMP, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR};
@@ -39,11 +39,10 @@ static float scroll_edge_hover(float distance, float edge) {
 static float scroll_hover_expansion(FluxRenderSnapshot const *snap, FluxRect const *bounds) {
 	if (!snap->u.scroll.mouse_over) return 0.0f;
 
-	float const EDGE = 24.0f;
-	float       dx   = bounds->w - snap->u.scroll.mouse_local_x;
-	float       dy   = bounds->h - snap->u.scroll.mouse_local_y;
-	float       hx   = scroll_edge_hover(dx, EDGE);
-	float       hy   = scroll_edge_hover(dy, EDGE);
+	float dx = bounds->w - snap->u.scroll.mouse_local_x;
+	float dy = bounds->h - snap->u.scroll.mouse_local_y;
+	float hx = scroll_edge_hover(dx, FLUX_SCROLLBAR_HOVER_EDGE);
+	float hy = scroll_edge_hover(dy, FLUX_SCROLLBAR_HOVER_EDGE);
 	return hx > hy ? hx : hy;
 }
 
@@ -41,9 +41,8 @@ static void slider_update_animation(
 	float           press_t = state->pressed ? 1.0f : 0.0f;
 
 	if (ce) {
-		FluxTweenChannels channels  = {&ce->hover_anim, &ce->press_anim, &ce->focus_anim, &ce->check_anim};
-		FluxTweenTargets  targets   = {state->hovered, state->pressed, state->focused, false};
-		bool              animating = flux_tween_update_states(&channels, targets, rc->now);
+		FluxTweenTargets targets   = {state->hovered, state->pressed, state->focused, false};
+		bool             animating = flux_tween_update_states(rc->cache, ce, targets, rc->now);
 		if (animating && rc->animations_active) *rc->animations_active = true;
 		hover_t = ce->hover_anim.current;
 		press_t = ce->press_anim.current;
@@ -173,8 +172,9 @@ slider_thumb_scale(FluxRenderContext const *rc, FluxControlState const *state, S
 	if (!anim->cache) return target_scale;
 
 	float scale = 0.0f;
-	bool  active
-	  = flux_tween_update(&anim->cache->slider_anim, target_scale, FLUX_ANIM_DURATION_SLIDER, rc->now, &scale);
+	bool  active = flux_render_cache_tween(
+	  rc->cache, anim->cache, FLUX_TWEEN_SLIDER, target_scale, FLUX_ANIM_DURATION_SLIDER, rc->now, &scale
+	);
 	if (active && rc->animations_active) *rc->animations_active = true;
 	return scale;
 }
@@ -21,9 +21,8 @@ static SwitchAnim switch_update_anim(
 	FluxCacheEntry *ce = rc->cache ? flux_render_cache_get_or_create(rc->cache, snap->id) : NULL;
 	if (!ce) return (SwitchAnim) {on ? 1.0f : 0.0f, state->hovered ? 1.0f : 0.0f, state->pressed ? 1.0f : 0.0f};
 
-	FluxTweenChannels channels  = {&ce->hover_anim, &ce->press_anim, &ce->focus_anim, &ce->check_anim};
-	FluxTweenTargets  targets   = {state->hovered, state->pressed, state->focused, on};
-	bool              animating = flux_tween_update_states(&channels, targets, rc->now);
+	FluxTweenTargets targets   = {state->hovered, state->pressed, state->focused, on};
+	bool             animating = flux_tween_update_states(rc->cache, ce, targets, rc->now);
 	if (animating && rc->animations_active) *rc->animations_active = true;
 	return (SwitchAnim) {ce->check_anim.current, ce->hover_anim.current, ce->press_anim.current};
 }
@@ -347,13 +347,15 @@ static bool textbox_caret_visible(FluxRenderContext const *rc, FluxRenderSnapsho
 	}
 	double elapsed = rc->now - ce->focus_anim.start_time;
 	int    phase   = ( int ) (elapsed / 0.5);
-	if (rc->animations_active) *rc->animations_active = true;
+	/* Nothing moves between phase flips, so ask for the next flip, not every frame. */
+	double flip    = ce->focus_anim.start_time + (phase + 1) * 0.5;
+	if (rc->wake_at && flip < *rc->wake_at) *rc->wake_at = flip;
+	else if (!rc->wake_at && rc->animations_active) *rc->animations_active = true;
 	return (phase % 2) == 0;
 }
 
 static bool textbox_should_draw_caret(TextboxContentDrawContext const *dc) {
 	if (!dc->state->focused) return false;
-	if (dc->rc->animations_active) *dc->rc->animations_active = true;
 	if (dc->snap->u.textbox.edit.readonly) return false;
 	return dc->content->has_composition || dc->snap->u.textbox.edit.selection_start == dc->snap->u.textbox.edit.selection_end;
 }
@@ -445,7 +447,7 @@ static void textbox_draw_fill(
 	FluxCacheEntry *ce_fill = rc->cache ? flux_render_cache_get_or_create(rc->cache, snap->id) : NULL;
 	if (ce_fill) {
 		FluxColor tweened;
-		bool active = flux_color_tween_update(&ce_fill->color_anim, fill, FLUX_ANIM_DURATION_FAST, rc->now, &tweened);
+		bool active = flux_render_cache_color_tween(rc->cache, ce_fill, fill, FLUX_ANIM_DURATION_FAST, rc->now, &tweened);
 		fill        = tweened;
 		if (active && rc->animations_active) *rc->animations_active = true;
 	}
@@ -104,7 +104,7 @@ XentNodeId flux_create_button(FluxButtonCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_BUTTON);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData   *nd = flux_node_store_get(info->store, node);
+	FluxNodeData   *nd = flux_node_store_edit(info->store, node);
 	FluxButtonData *bd = nd ? ( FluxButtonData * ) calloc(1, sizeof(FluxButtonData)) : NULL;
 	if (!nd || !bd) {
 		free(bd);
@@ -118,8 +118,8 @@ XentNodeId flux_create_button(FluxButtonCreateInfo const *info) {
 
 	nd->component_data         = bd;
 	nd->destroy_component_data = flux_button_data_destroy;
-	nd->behavior.on_click      = info->on_click;
-	nd->behavior.on_click_ctx  = info->userdata;
+	nd->behavior->on_click      = info->on_click;
+	nd->behavior->on_click_ctx  = info->userdata;
 
 	xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_BUTTON);
 	if (info->label) xent_set_semantic_label(info->ctx, node, info->label);
@@ -140,7 +140,7 @@ XentNodeId flux_create_dropdown_button(FluxDropDownButtonCreateInfo const *info)
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_DROPDOWN_BUTTON);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData   *nd = flux_node_store_get(info->store, node);
+	FluxNodeData   *nd = flux_node_store_edit(info->store, node);
 	FluxButtonData *bd = nd ? ( FluxButtonData * ) calloc(1, sizeof(FluxButtonData)) : NULL;
 	if (!nd || !bd) {
 		free(bd);
@@ -179,7 +179,7 @@ XentNodeId flux_create_text(FluxTextCreateInfo const *info) {
 	xent_set_font_weight(info->ctx, node, flux_font_weight_numeric(FLUX_FONT_REGULAR));
 	xent_set_text_line_break_policy(info->ctx, node, XENT_LINE_BREAK_WORD_WRAP);
 
-	FluxNodeData *nd = flux_node_store_get(info->store, node);
+	FluxNodeData *nd = flux_node_store_edit(info->store, node);
 	FluxTextData *td = nd ? ( FluxTextData * ) calloc(1, sizeof(FluxTextData)) : NULL;
 	if (!nd || !td) {
 		free(td);
@@ -306,7 +306,7 @@ XentNodeId flux_create_slider(FluxSliderCreateInfo const *info) {
 
 	xent_set_semantic_value(info->ctx, node, info->value, info->min, info->max);
 
-	FluxNodeData        *nd  = flux_node_store_get(info->store, node);
+	FluxNodeData        *nd  = flux_node_store_edit(info->store, node);
 	FluxSliderInputData *sid = nd ? ( FluxSliderInputData * ) calloc(1, sizeof(FluxSliderInputData)) : NULL;
 	if (!nd || !sid) {
 		free(sid);
@@ -332,10 +332,10 @@ XentNodeId flux_create_slider(FluxSliderCreateInfo const *info) {
 
 	nd->component_data               = &sid->base;
 	nd->destroy_component_data       = free;
-	nd->behavior.on_pointer_move     = slider_move_trampoline;
-	nd->behavior.on_pointer_move_ctx = sid;
-	nd->behavior.on_key              = slider_on_key;
-	nd->behavior.on_key_ctx          = sid;
+	nd->behavior->on_pointer_move     = slider_move_trampoline;
+	nd->behavior->on_pointer_move_ctx = sid;
+	nd->behavior->on_key              = slider_on_key;
+	nd->behavior->on_key_ctx          = sid;
 
 	xent_set_focusable(info->ctx, node, true);
 	xent_set_size(info->ctx, node, (XentSize) {NAN, 32.0f});
@@ -376,7 +376,7 @@ static XentNodeId create_toggle_node(FluxToggleCreateInfo const *info, FluxContr
 	xent_set_semantic_checked(info->ctx, node, info->checked ? 1 : 0);
 	toggle_default_metrics(info, node, type);
 
-	FluxNodeData     *nd = flux_node_store_get(info->store, node);
+	FluxNodeData     *nd = flux_node_store_edit(info->store, node);
 	FluxCheckboxData *cd = nd ? ( FluxCheckboxData * ) calloc(1, sizeof(FluxCheckboxData)) : NULL;
 	if (!nd || !cd) {
 		free(cd);
@@ -389,8 +389,8 @@ static XentNodeId create_toggle_node(FluxToggleCreateInfo const *info, FluxContr
 
 	nd->component_data         = cd;
 	nd->destroy_component_data = checkbox_data_destroy;
-	nd->behavior.on_click      = checkbox_click_trampoline;
-	nd->behavior.on_click_ctx  = cd;
+	nd->behavior->on_click      = checkbox_click_trampoline;
+	nd->behavior->on_click_ctx  = cd;
 
 	if (info->label) xent_set_semantic_label(info->ctx, node, info->label);
 	xent_set_focusable(info->ctx, node, true);
@@ -421,7 +421,7 @@ XentNodeId flux_create_progress(FluxProgressCreateInfo const *info) {
 
 	xent_set_semantic_value(info->ctx, node, info->value, 0.0f, info->max_value);
 
-	FluxNodeData     *nd = flux_node_store_get(info->store, node);
+	FluxNodeData     *nd = flux_node_store_edit(info->store, node);
 	FluxProgressData *pd = nd ? ( FluxProgressData * ) calloc(1, sizeof(FluxProgressData)) : NULL;
 	if (!nd || !pd) {
 		free(pd);
@@ -446,7 +446,7 @@ XentNodeId flux_create_progress_ring(FluxProgressCreateInfo const *info) {
 
 	xent_set_semantic_value(info->ctx, node, info->value, 0.0f, info->max_value);
 
-	FluxNodeData         *nd = flux_node_store_get(info->store, node);
+	FluxNodeData         *nd = flux_node_store_edit(info->store, node);
 	FluxProgressRingData *pd = nd ? ( FluxProgressRingData * ) calloc(1, sizeof(FluxProgressRingData)) : NULL;
 	if (!nd || !pd) {
 		free(pd);
@@ -497,7 +497,7 @@ XentNodeId flux_create_hyperlink(FluxHyperlinkCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_HYPERLINK);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData      *nd = flux_node_store_get(info->store, node);
+	FluxNodeData      *nd = flux_node_store_edit(info->store, node);
 	FluxHyperlinkData *hd = nd ? ( FluxHyperlinkData * ) calloc(1, sizeof(FluxHyperlinkData)) : NULL;
 	if (!nd || !hd) {
 		free(hd);
@@ -511,8 +511,8 @@ XentNodeId flux_create_hyperlink(FluxHyperlinkCreateInfo const *info) {
 
 	nd->component_data         = hd;
 	nd->destroy_component_data = hyperlink_data_destroy;
-	nd->behavior.on_click      = hyperlink_on_click;
-	nd->behavior.on_click_ctx  = hd;
+	nd->behavior->on_click      = hyperlink_on_click;
+	nd->behavior->on_click_ctx  = hd;
 
 	xent_set_semantic_role(info->ctx, node, XENT_SEMANTIC_BUTTON);
 	if (info->label) xent_set_semantic_label(info->ctx, node, info->label);
@@ -544,7 +544,7 @@ XentNodeId flux_create_image(FluxImageCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_IMAGE);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData  *nd = flux_node_store_get(info->store, node);
+	FluxNodeData  *nd = flux_node_store_edit(info->store, node);
 	FluxImageData *im = nd ? ( FluxImageData * ) calloc(1, sizeof(FluxImageData)) : NULL;
 	if (!nd || !im) {
 		free(im);
@@ -561,13 +561,13 @@ XentNodeId flux_create_image(FluxImageCreateInfo const *info) {
 }
 
 void flux_image_set_source(FluxNodeStore *store, XentNodeId id, char const *source) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_IMAGE) return;
 	flux_str_replace(&(( FluxImageData * ) nd->component_data)->source, source);
 }
 
 void flux_image_set_stretch(FluxNodeStore *store, XentNodeId id, FluxImageStretch stretch) {
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || nd->component_type != FLUX_CONTROL_IMAGE) return;
 	(( FluxImageData * ) nd->component_data)->stretch = stretch;
 }
@@ -578,7 +578,7 @@ XentNodeId flux_create_scroll(FluxContainerCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_SCROLL);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData   *nd = flux_node_store_get(info->store, node);
+	FluxNodeData   *nd = flux_node_store_edit(info->store, node);
 	FluxScrollData *sd = nd ? ( FluxScrollData * ) calloc(1, sizeof(FluxScrollData)) : NULL;
 	if (!nd || !sd) {
 		free(sd);
@@ -607,7 +607,7 @@ XentNodeId flux_create_info_badge(FluxInfoBadgeCreateInfo const *info) {
 	XentNodeId node = flux_factory_create_node(info->ctx, info->store, info->parent, FLUX_CONTROL_INFO_BADGE);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData      *nd = flux_node_store_get(info->store, node);
+	FluxNodeData      *nd = flux_node_store_edit(info->store, node);
 	FluxInfoBadgeData *bd = nd ? ( FluxInfoBadgeData * ) calloc(1, sizeof(FluxInfoBadgeData)) : NULL;
 	if (!nd || !bd) {
 		free(bd);
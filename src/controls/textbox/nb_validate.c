@@ -211,7 +211,7 @@ static bool nb_parse(char const *s, double *out) {
 }
 
 void nb_validate_input(FluxTextBoxInputData *tb) {
-	if (!tb->buffer || tb->buf_len == 0) {
+	if (tb->buf_len == 0) {
 		nb_set_value(tb, NAN);
 		return;
 	}
@@ -1,4 +1,5 @@
 #include "tb_internal.h"
+#include "text/flux_grapheme.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -77,12 +78,15 @@ static uint32_t tb_physical_pos(FluxTextBoxInputData const *tb, uint32_t pos) {
 	return pos < tb->gap_start ? pos : pos + tb_gap_size(tb);
 }
 
+static bool tb_stored(FluxTextBoxInputData const *tb) { return tb && (tb->buffer || tb->pieces); }
+
 static uint8_t tb_buffer_byte_at(FluxTextBoxInputData const *tb, uint32_t pos) {
+	if (tb->pieces) return tb_piece_byte_at(tb->pieces, pos);
 	return ( uint8_t ) tb->buffer [tb_physical_pos(tb, pos)];
 }
 
 static uint32_t tb_buffer_utf8_char_len_bounded(FluxTextBoxInputData const *tb, uint32_t pos, uint32_t *cp_out) {
-	if (!tb || !tb->buffer || pos >= tb->buf_len) return 0;
+	if (!tb_stored(tb) || pos >= tb->buf_len) return 0;
 
 	uint8_t    c0   = tb_buffer_byte_at(tb, pos);
 	TbUtf8Head head = tb_utf8_head(c0);
@@ -99,7 +103,7 @@ static uint32_t tb_buffer_utf8_char_len_bounded(FluxTextBoxInputData const *tb,
 }
 
 static uint32_t tb_buffer_utf8_scalar_prev(FluxTextBoxInputData const *tb, uint32_t pos) {
-	if (!tb || !tb->buffer || pos == 0) return 0;
+	if (!tb_stored(tb) || pos == 0) return 0;
 	if (pos > tb->buf_len) pos = tb->buf_len;
 
 	uint32_t p = pos - 1;
@@ -123,13 +127,57 @@ static void tb_move_gap_to(FluxTextBoxInputData *tb, uint32_t pos) {
 	tb->gap_end   += move_len;
 }
 
-static void tb_mark_content_dirty(FluxTextBoxInputData *tb) {
+/* Text before @p from is untouched, so the flat mirror stays valid up to there. */
+static void tb_mark_content_dirty(FluxTextBoxInputData *tb, uint32_t from) {
 	tb->flat_dirty   = true;
+	tb->view_dirty   = true;
 	tb->base.content = tb->flat_buffer ? tb->flat_buffer : "";
+	if (from < tb->flat_valid) tb->flat_valid = from;
 }
 
-bool tb_ensure_cap(FluxTextBoxInputData *tb, uint32_t needed) {
-	if (!tb) return false;
+static void tb_drop_gap_buffer(FluxTextBoxInputData *tb) {
+	free(tb->buffer);
+	tb->buffer    = NULL;
+	tb->buf_cap   = 0;
+	tb->gap_start = 0;
+	tb->gap_end   = 0;
+}
+
+/* Moves the text into a piece table with room for @p extra more bytes. The
+ * two sides of the gap land back to back in the add buffer: one piece. */
+static bool tb_use_pieces(FluxTextBoxInputData *tb, uint32_t extra) {
+	TbPieceTable *pt = tb_piece_create();
+	if (!pt || !tb_piece_reserve(pt, tb->buf_len + extra)) {
+		tb_piece_destroy(pt);
+		return false;
+	}
+
+	uint32_t suffix = tb->buf_cap - tb->gap_end;
+	if (tb->gap_start > 0) tb_piece_insert(pt, 0, tb->buffer, tb->gap_start);
+	if (suffix > 0) tb_piece_insert(pt, tb->gap_start, tb->buffer + tb->gap_end, suffix);
+	tb_drop_gap_buffer(tb);
+	tb->pieces = pt;
+	return true;
+}
+
+/* Deletes that leave a piece-table text well under the threshold move it back
+ * to a gap buffer; the margin keeps an edit at the boundary from flipping it. */
+static void tb_use_gap(FluxTextBoxInputData *tb) {
+	uint32_t cap = FLUX_TEXTBOX_INITIAL_CAP;
+	while (cap < tb->buf_len + 1) cap *= TB_BUFFER_GROWTH_FACTOR;
+	char *buf = ( char * ) malloc(cap);
+	if (!buf) return;
+
+	tb_copy_range(tb, 0, tb->buf_len, buf);
+	tb_piece_destroy(tb->pieces);
+	tb->pieces    = NULL;
+	tb->buffer    = buf;
+	tb->buf_cap   = cap;
+	tb->gap_start = tb->buf_len;
+	tb->gap_end   = cap;
+}
+
+static bool tb_gap_reserve(FluxTextBoxInputData *tb, uint32_t needed) {
 	if (needed <= tb->buf_cap) return true;
 
 	uint32_t cap = tb->buf_cap ? tb->buf_cap : FLUX_TEXTBOX_INITIAL_CAP;
@@ -152,6 +200,13 @@ bool tb_ensure_cap(FluxTextBoxInputData *tb, uint32_t needed) {
 	return true;
 }
 
+bool tb_ensure_cap(FluxTextBoxInputData *tb, uint32_t needed) {
+	if (!tb) return false;
+	if (tb->pieces) return tb_piece_reserve(tb->pieces, needed > tb->buf_len ? needed - tb->buf_len : 0);
+	if (needed > TB_PIECE_THRESHOLD) return tb_use_pieces(tb, needed - tb->buf_len);
+	return tb_gap_reserve(tb, needed);
+}
+
 void tb_realize(FluxTextBoxInputData *tb) {
 	if (!tb || !tb->buffer) return;
 
@@ -173,21 +228,92 @@ char const *tb_sync_content(FluxTextBoxInputData *tb) {
 
 	uint32_t needed = tb->buf_len + 1;
 	if (needed > tb->flat_cap) {
-		char *next = ( char * ) realloc(tb->flat_buffer, needed);
+		uint32_t cap
+		  = tb->flat_cap > UINT32_MAX / TB_BUFFER_GROWTH_FACTOR ? needed : tb->flat_cap * TB_BUFFER_GROWTH_FACTOR;
+		if (cap < needed) cap = needed;
+		char *next = ( char * ) realloc(tb->flat_buffer, cap);
 		if (!next) return tb->flat_buffer ? tb->flat_buffer : "";
 		tb->flat_buffer = next;
-		tb->flat_cap    = needed;
+		tb->flat_cap    = cap;
 	}
 
-	if (tb->gap_start > 0) memcpy(tb->flat_buffer, tb->buffer, tb->gap_start);
-	uint32_t suffix = tb->buf_cap - tb->gap_end;
-	if (suffix > 0) memcpy(tb->flat_buffer + tb->gap_start, tb->buffer + tb->gap_end, suffix);
+	/* Only the part from the first edited byte onward has moved. That is still
+	 * the whole tail for an edit mid-document, which is why drawing reads the
+	 * window from tb_view_text instead. */
+	uint32_t from = tb->flat_valid < tb->buf_len ? tb->flat_valid : tb->buf_len;
+	tb_copy_range(tb, from, tb->buf_len, tb->flat_buffer + from);
 	tb->flat_buffer [tb->buf_len] = '\0';
+	tb->flat_valid                = tb->buf_len;
 	tb->flat_dirty                = false;
 	tb->base.content              = tb->flat_buffer;
 	return tb->flat_buffer;
 }
 
+uint32_t tb_text_span(FluxTextBoxInputData const *tb, uint32_t pos, uint32_t to, TbTextSpan *out) {
+	if (tb && tb->pieces) return tb_piece_span(tb->pieces, pos, to, out);
+	if (!tb || !tb->buffer) return 0;
+	if (to > tb->buf_len) to = tb->buf_len;
+	if (pos >= to) return 0;
+
+	uint32_t end = pos < tb->gap_start && to > tb->gap_start ? tb->gap_start : to;
+	*out         = (TbTextSpan) {tb->buffer + tb_physical_pos(tb, pos), end - pos};
+	return out->len;
+}
+
+uint32_t tb_copy_range(FluxTextBoxInputData const *tb, uint32_t from, uint32_t to, char *dst) {
+	TbTextSpan span;
+	uint32_t   out = 0;
+	for (uint32_t pos = from; tb_text_span(tb, pos, to, &span); pos += span.len) {
+		memcpy(dst + out, span.data, span.len);
+		out += span.len;
+	}
+	return out;
+}
+
+/* Back to the start of the code point holding @p pos, so a window never opens mid-sequence. */
+static uint32_t tb_code_point_start(FluxTextBoxInputData const *tb, uint32_t pos) {
+	for (int i = 0; i < 3 && pos > 0 && pos < tb->buf_len && tb_utf8_is_cont(tb_buffer_byte_at(tb, pos)); i++) pos--;
+	return pos;
+}
+
+char const *tb_view_text(FluxTextBoxInputData *tb) {
+	if (!tb) return "";
+	if (tb->buf_len <= TB_VIEW_BYTES) {
+		tb->view_from = 0;
+		tb->view_len  = tb->buf_len;
+		return tb_sync_content(tb);
+	}
+	if (!tb->view_dirty && tb->view_buffer) return tb->view_buffer;
+
+	if (!tb->view_buffer) {
+		tb->view_buffer = ( char * ) malloc(TB_VIEW_BYTES + 1);
+		if (!tb->view_buffer) return "";
+		tb->view_cap = TB_VIEW_BYTES + 1;
+	}
+
+	/* Copied out of the stored spans: the cost is the window, whatever the text size. */
+	uint32_t last = tb->buf_len - TB_VIEW_BYTES;
+	uint32_t from = tb_code_point_start(tb, tb->view_from < last ? tb->view_from : last);
+	uint32_t to   = tb_code_point_start(tb, from + TB_VIEW_BYTES);
+	tb_copy_range(tb, from, to, tb->view_buffer);
+	tb->view_buffer [to - from] = '\0';
+	tb->view_from               = from;
+	tb->view_len                = to - from;
+	tb->view_dirty              = false;
+	return tb->view_buffer;
+}
+
+void tb_view_anchor(FluxTextBoxInputData *tb, uint32_t from) {
+	if (!tb || from == tb->view_from) return;
+	tb->view_from  = from;
+	tb->view_dirty = true;
+}
+
+uint32_t tb_view_offset(FluxTextBoxInputData const *tb, uint32_t pos) {
+	if (pos <= tb->view_from) return 0;
+	return pos - tb->view_from < tb->view_len ? pos - tb->view_from : tb->view_len;
+}
+
 uint32_t tb_utf8_char_len(char const *s, uint32_t len, uint32_t pos) {
 	return tb_utf8_char_len_bounded(s, len, pos, NULL);
 }
@@ -210,48 +336,36 @@ uint32_t tb_utf8_next(char const *s, uint32_t len, uint32_t pos) {
 }
 
 uint32_t tb_buffer_utf8_prev(FluxTextBoxInputData const *tb, uint32_t pos) {
-	if (!tb || !tb->buffer || pos == 0) return 0;
+	if (!tb_stored(tb) || pos == 0) return 0;
 	return tb_buffer_utf8_scalar_prev(tb, pos);
 }
 
 uint32_t tb_buffer_utf8_next(FluxTextBoxInputData const *tb, uint32_t pos) {
-	if (!tb || !tb->buffer) return 0;
+	if (!tb_stored(tb)) return 0;
 	if (pos >= tb->buf_len) return tb->buf_len;
 
 	uint32_t clen = tb_buffer_utf8_char_len_bounded(tb, pos, NULL);
 	return pos + (clen ? clen : 1);
 }
 
-static FluxTextClusterQuery tb_cluster_query(FluxTextBoxInputData *tb, FluxTextRenderer *tr, FluxTextStyle *style) {
-	char const *s              = tb_sync_content(tb);
-	*style                     = tb_make_style(tb);
-	FluxTextLayoutQuery layout = {tr, s, style, 0.0f};
-	return (FluxTextClusterQuery) {layout, 0};
-}
-
-uint32_t tb_grapheme_next(FluxTextBoxInputData *tb, uint32_t pos) {
-	if (!tb || !tb->buffer) return 0;
-	if (pos >= tb->buf_len) return tb->buf_len;
+static uint8_t tb_piece_reader(void *source, uint32_t pos) { return tb_piece_byte_at(( TbPieceTable * ) source, pos); }
 
-	FluxTextRenderer *tr = flux_app_get_text_renderer(tb->app);
-	if (!tr) return tb_buffer_utf8_next(tb, pos);
-
-	FluxTextStyle        style;
-	FluxTextClusterQuery q = tb_cluster_query(tb, tr, &style);
-	q.index                = tb_byte_to_utf16_offset(q.layout.text, tb->buf_len, pos);
-	return tb_utf16_to_byte_offset(q.layout.text, tb->buf_len, flux_text_cluster_next(&q));
+/* Both sides of the gap, or the pieces through a byte reader, so segmentation reads the text in place. */
+static FluxGraphemeText tb_grapheme_text(FluxTextBoxInputData const *tb) {
+	if (tb->pieces) return (FluxGraphemeText) {NULL, tb->buf_len, NULL, 0, tb_piece_reader, tb->pieces};
+	return (FluxGraphemeText) {tb->buffer, tb->gap_start, tb->buffer + tb->gap_end, tb->buf_cap - tb->gap_end};
 }
 
-uint32_t tb_grapheme_prev(FluxTextBoxInputData *tb, uint32_t pos) {
-	if (!tb || !tb->buffer || pos == 0) return 0;
-
-	FluxTextRenderer *tr = flux_app_get_text_renderer(tb->app);
-	if (!tr) return tb_buffer_utf8_prev(tb, pos);
+uint32_t tb_grapheme_next(FluxTextBoxInputData const *tb, uint32_t pos) {
+	if (!tb_stored(tb)) return 0;
+	FluxGraphemeText text = tb_grapheme_text(tb);
+	return flux_grapheme_next(&text, pos);
+}
 
-	FluxTextStyle        style;
-	FluxTextClusterQuery q = tb_cluster_query(tb, tr, &style);
-	q.index                = tb_byte_to_utf16_offset(q.layout.text, tb->buf_len, pos);
-	return tb_utf16_to_byte_offset(q.layout.text, tb->buf_len, flux_text_cluster_prev(&q));
+uint32_t tb_grapheme_prev(FluxTextBoxInputData const *tb, uint32_t pos) {
+	if (!tb_stored(tb)) return 0;
+	FluxGraphemeText text = tb_grapheme_text(tb);
+	return flux_grapheme_prev(&text, pos);
 }
 
 uint32_t tb_utf16_to_byte_offset(char const *s, uint32_t len, uint32_t utf16_pos) {
@@ -279,11 +393,18 @@ uint32_t tb_byte_to_utf16_offset(char const *s, uint32_t len, uint32_t byte_pos)
 void tb_delete_range(FluxTextBoxInputData *tb, uint32_t from, uint32_t to) {
 	if (!tb) return;
 	if (from >= to || to > tb->buf_len) return;
-
-	tb_move_gap_to(tb, from);
-	tb->gap_end += (to - from);
-	tb->buf_len  = tb->gap_start + (tb->buf_cap - tb->gap_end);
-	tb_mark_content_dirty(tb);
+	if (tb->pieces && !tb_piece_reserve(tb->pieces, 0)) return;
+
+	tb_undo_record(tb, from, to - from, NULL, 0);
+	if (tb->pieces) {
+		tb_piece_delete(tb->pieces, from, to);
+	} else {
+		tb_move_gap_to(tb, from);
+		tb->gap_end += to - from;
+	}
+	tb->buf_len -= to - from;
+	tb_mark_content_dirty(tb, from);
+	if (tb->pieces && tb->buf_len < TB_PIECE_THRESHOLD / 4) tb_use_gap(tb);
 }
 
 void tb_insert_utf8(FluxTextBoxInputData *tb, uint32_t pos, char const *s, uint32_t slen) {
@@ -292,29 +413,51 @@ void tb_insert_utf8(FluxTextBoxInputData *tb, uint32_t pos, char const *s, uint3
 	if (slen > UINT32_MAX - tb->buf_len - 1) return;
 	if (!tb_ensure_cap(tb, tb->buf_len + slen + 1)) return;
 
-	tb_move_gap_to(tb, pos);
-	memcpy(tb->buffer + tb->gap_start, s, slen);
-	tb->gap_start += slen;
-	tb->buf_len    = tb->gap_start + (tb->buf_cap - tb->gap_end);
-	tb_mark_content_dirty(tb);
+	tb_undo_record(tb, pos, 0, s, slen);
+	if (tb->pieces) {
+		tb_piece_insert(tb->pieces, pos, s, slen);
+	} else {
+		tb_move_gap_to(tb, pos);
+		memcpy(tb->buffer + tb->gap_start, s, slen);
+		tb->gap_start += slen;
+	}
+	tb->buf_len += slen;
+	tb_mark_content_dirty(tb, pos);
 }
 
 bool tb_replace_text(FluxTextBoxInputData *tb, char const *text) {
 	if (!tb) return false;
 	if (!text) text = "";
 
-	uint32_t len = ( uint32_t ) strlen(text);
-	if (!tb_ensure_cap(tb, len + 1)) return false;
+	uint32_t      len    = ( uint32_t ) strlen(text);
+	TbPieceTable *pieces = NULL;
+	if (len + 1 > TB_PIECE_THRESHOLD) {
+		pieces = tb_piece_create();
+		if (!pieces || !tb_piece_insert(pieces, 0, text, len)) {
+			tb_piece_destroy(pieces);
+			return false;
+		}
+	} else if (!tb_gap_reserve(tb, len + 1)) {
+		return false;
+	}
 
-	memcpy(tb->buffer, text, ( size_t ) len);
-	tb->gap_start            = len;
-	tb->gap_end              = tb->buf_cap;
-	tb->buffer [len]         = '\0';
+	tb_undo_record(tb, 0, tb->buf_len, text, len);
+	tb_piece_destroy(tb->pieces);
+	tb->pieces = pieces;
+	if (pieces) {
+		tb_drop_gap_buffer(tb);
+	} else {
+		memcpy(tb->buffer, text, ( size_t ) len);
+		tb->gap_start    = len;
+		tb->gap_end      = tb->buf_cap;
+		tb->buffer [len] = '\0';
+	}
 	tb->buf_len              = len;
+	tb->view_from            = 0;
 	tb->base.cursor_position = len;
 	tb->base.selection_start = len;
 	tb->base.selection_end   = len;
-	tb_mark_content_dirty(tb);
+	tb_mark_content_dirty(tb, 0);
 	( void ) tb_sync_content(tb);
 	return true;
 }
@@ -367,7 +510,7 @@ uint32_t tb_word_end(char const *s, uint32_t len, uint32_t pos) {
 }
 
 uint32_t tb_buffer_word_start(FluxTextBoxInputData const *tb, uint32_t pos) {
-	if (!tb || !tb->buffer || pos == 0) return 0;
+	if (!tb_stored(tb) || pos == 0) return 0;
 	if (pos > tb->buf_len) pos = tb->buf_len;
 
 	uint32_t p = pos;
@@ -389,7 +532,7 @@ uint32_t tb_buffer_word_start(FluxTextBoxInputData const *tb, uint32_t pos) {
 }
 
 uint32_t tb_buffer_word_end(FluxTextBoxInputData const *tb, uint32_t pos) {
-	if (!tb || !tb->buffer || pos >= tb->buf_len) return tb ? tb->buf_len : 0;
+	if (!tb_stored(tb) || pos >= tb->buf_len) return tb ? tb->buf_len : 0;
 
 	TbWordClass target = tb_word_class(tb_buffer_byte_at(tb, pos));
 	uint32_t    p      = pos;
@@ -49,8 +49,14 @@ void tb_perform_copy(FluxTextBoxInputData *tb) {
 	uint32_t start = 0;
 	uint32_t len   = 0;
 	if (!tb_copy_selection_range(tb, &start, &len)) return;
-	char const *content = tb_sync_content(tb);
-	tb_set_clipboard_utf16(content + start, len);
+
+	/* Materialize just the selection, straight from the gap buffer. */
+	char  u8_stack [512];
+	char *u8buf = len > sizeof(u8_stack) ? ( char * ) malloc(len) : u8_stack;
+	if (!u8buf) return;
+	tb_copy_range(tb, start, start + len, u8buf);
+	tb_set_clipboard_utf16(u8buf, len);
+	if (u8buf != u8_stack) free(u8buf);
 }
 
 static wchar_t const *tb_filtered_clip_text(
@@ -61,7 +61,10 @@ tb_create_node_with_parent(XentContext *ctx, FluxNodeStore *store, XentNodeId pa
 	if (parent != XENT_NODE_INVALID) xent_append_child(ctx, parent, node);
 
 	FluxNodeData *nd = flux_node_store_get_or_create(store, node);
-	if (nd) nd->component_type = type;
+	if (nd) {
+		nd->component_type  = type;
+		nd->layout_boundary = true; /* xent never sees the text: typing cannot resize the box */
+	}
 	xent_set_userdata(ctx, node, nd);
 	xent_set_focusable(ctx, node, true);
 	xent_set_size(ctx, node, (XentSize) {NAN, 32.0f});
@@ -72,30 +75,30 @@ tb_create_node_with_parent(XentContext *ctx, FluxNodeStore *store, XentNodeId pa
 static void tb_wire_behaviors(FluxNodeData *nd, FluxTextBoxInputData *tb) {
 	nd->component_data                  = &tb->base;
 	nd->destroy_component_data          = tb_destroy;
-	nd->behavior.on_pointer_move        = tb_on_pointer_move;
-	nd->behavior.on_pointer_move_ctx    = tb;
-	nd->behavior.on_focus               = tb_on_focus;
-	nd->behavior.on_focus_ctx           = tb;
-	nd->behavior.on_blur                = tb_on_blur;
-	nd->behavior.on_blur_ctx            = tb;
-	nd->behavior.on_key                 = tb_on_key;
-	nd->behavior.on_key_ctx             = tb;
-	nd->behavior.on_char                = tb_on_char;
-	nd->behavior.on_char_ctx            = tb;
-	nd->behavior.on_pointer_down        = tb_on_pointer_down;
-	nd->behavior.on_pointer_down_ctx    = tb;
-	nd->behavior.on_click               = tb_on_pointer_finish;
-	nd->behavior.on_click_ctx           = tb;
-	nd->behavior.on_cancel              = tb_on_pointer_finish;
-	nd->behavior.on_cancel_ctx          = tb;
-	nd->behavior.on_ime_composition     = tb_on_ime_composition;
-	nd->behavior.on_ime_composition_ctx = tb;
-	nd->behavior.on_context_menu        = tb_on_context_menu;
-	nd->behavior.on_context_menu_ctx    = tb;
+	nd->behavior->on_pointer_move        = tb_on_pointer_move;
+	nd->behavior->on_pointer_move_ctx    = tb;
+	nd->behavior->on_focus               = tb_on_focus;
+	nd->behavior->on_focus_ctx           = tb;
+	nd->behavior->on_blur                = tb_on_blur;
+	nd->behavior->on_blur_ctx            = tb;
+	nd->behavior->on_key                 = tb_on_key;
+	nd->behavior->on_key_ctx             = tb;
+	nd->behavior->on_char                = tb_on_char;
+	nd->behavior->on_char_ctx            = tb;
+	nd->behavior->on_pointer_down        = tb_on_pointer_down;
+	nd->behavior->on_pointer_down_ctx    = tb;
+	nd->behavior->on_click               = tb_on_pointer_finish;
+	nd->behavior->on_click_ctx           = tb;
+	nd->behavior->on_cancel              = tb_on_pointer_finish;
+	nd->behavior->on_cancel_ctx          = tb;
+	nd->behavior->on_ime_composition     = tb_on_ime_composition;
+	nd->behavior->on_ime_composition_ctx = tb;
+	nd->behavior->on_context_menu        = tb_on_context_menu;
+	nd->behavior->on_context_menu_ctx    = tb;
 }
 
 static void tb_attach_app(FluxNodeStore *store, XentNodeId node, FluxApp *app) {
-	FluxNodeData *nd = flux_node_store_get(store, node);
+	FluxNodeData *nd = flux_node_store_edit(store, node);
 	if (nd && nd->component_data) (( FluxTextBoxInputData * ) nd->component_data)->app = app;
 }
 
@@ -108,6 +111,8 @@ void tb_destroy(void *component_data) {
 	flux_str_free(tb->base.font_family);
 	free(tb->buffer);
 	free(tb->flat_buffer);
+	tb_piece_destroy(tb->pieces);
+	free(tb->view_buffer);
 	free(tb->ime_buf);
 	free(tb->nb);
 	free(tb);
@@ -153,7 +158,7 @@ static XentNodeId tb_create_text_control(TbTextControlSpec const *spec) {
 	XentNodeId node = tb_create_node_with_parent(spec->ctx, spec->store, spec->parent, spec->type);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData *nd         = flux_node_store_get(spec->store, node);
+	FluxNodeData *nd         = flux_node_store_edit(spec->store, node);
 	TbBaseSpec    base_spec  = {spec->ctx, node, spec->store, spec->placeholder, spec->on_change, spec->userdata};
 	FluxTextBoxInputData *tb = nd ? tb_alloc_base(&base_spec) : NULL;
 	if (nd && tb) tb_wire_behaviors(nd, tb);
@@ -256,7 +261,7 @@ XentNodeId flux_create_number_box(FluxNumberBoxCreateInfo const *info) {
 	XentNodeId node = tb_create_node_with_parent(info->ctx, info->store, info->parent, FLUX_CONTROL_NUMBER_BOX);
 	if (node == XENT_NODE_INVALID) return XENT_NODE_INVALID;
 
-	FluxNodeData         *nd        = flux_node_store_get(info->store, node);
+	FluxNodeData         *nd        = flux_node_store_edit(info->store, node);
 	TbBaseSpec            base_spec = {info->ctx, node, info->store, NULL, NULL, NULL};
 	FluxTextBoxInputData *tb        = nd ? tb_alloc_base(&base_spec) : NULL;
 	if (tb) {
@@ -69,7 +69,7 @@ static float tb_calc_text_max_w(FluxTextBoxInputData *tb, FluxControlType ct) {
 	XentRect rect = {0};
 	xent_get_layout_rect(tb->ctx, tb->node, &rect);
 
-	FluxNodeData *nd       = flux_node_store_get(tb->store, tb->node);
+	FluxNodeData *nd       = flux_node_store_edit(tb->store, tb->node);
 	float         reserved = tb_reserved_trailing_w(tb, ct, nd);
 	return rect.w - reserved - FLUX_TEXTBOX_PAD_L - FLUX_TEXTBOX_PAD_R;
 }
@@ -197,44 +197,46 @@ static bool tb_use_password_mask(FluxTextBoxInputData *tb, FluxControlType ct) {
 	return ct == FLUX_CONTROL_PASSWORD_BOX && tb->buf_len > 0 && !xent_get_semantic_checked(tb->ctx, tb->node);
 }
 
-static char const *tb_password_mask_text(FluxTextBoxInputData *tb, char stack [TB_MASK_STACK_BYTES], char **heap) {
+static char const *
+tb_password_mask_text(char const *content, uint32_t len, char stack [TB_MASK_STACK_BYTES], char **heap) {
 	*heap = NULL;
-	if (tb->buf_len > (UINT32_MAX - 1u) / 3u) return "";
-	size_t bytes = ( size_t ) tb->buf_len * 3u + 1u;
+	if (len > (UINT32_MAX - 1u) / 3u) return "";
+	size_t bytes = ( size_t ) len * 3u + 1u;
 	char  *dst   = bytes <= TB_MASK_STACK_BYTES ? stack : ( char * ) malloc(bytes);
 	if (!dst) return "";
 
-	char const *content = tb_sync_content(tb);
-	pb_build_mask(content, tb->buf_len, dst, ( uint32_t ) bytes);
+	pb_build_mask(content, len, dst, ( uint32_t ) bytes);
 	if (dst != stack) *heap = dst;
 	return dst;
 }
 
+/* Hit-tests the drawn window, so the result is offset by its start. */
 static uint32_t
 tb_hit_test_byte_pos(FluxTextBoxInputData *tb, FluxTextRenderer *tr, FluxControlType ct, float local_x) {
 	float         max_w    = tb_calc_text_max_w(tb, ct);
 	float         text_x   = local_x - FLUX_TEXTBOX_PAD_L + tb->base.scroll_offset_x;
 	FluxTextStyle ts       = tb_make_style(tb);
-	char const   *content  = tb_sync_content(tb);
+	char const   *content  = tb_view_text(tb);
+	uint32_t      len      = tb->view_len;
 
 	bool          use_mask = tb_use_password_mask(tb, ct);
 	char          mask_buf [TB_MASK_STACK_BYTES];
 	char         *mask_heap = NULL;
 	char const   *hit_text  = content;
-	if (use_mask) hit_text = tb_password_mask_text(tb, mask_buf, &mask_heap);
+	if (use_mask) hit_text = tb_password_mask_text(content, len, mask_buf, &mask_heap);
 
 	FluxTextHitTestQuery query = {
 	  {tr, hit_text, &ts, max_w + tb->base.scroll_offset_x},
       text_x, 0.0f
     };
 	int u16_pos = flux_text_hit_test(&query);
-	if (!use_mask) return tb_utf16_to_byte_offset(content, tb->buf_len, ( uint32_t ) u16_pos);
+	if (!use_mask) return tb->view_from + tb_utf16_to_byte_offset(content, len, ( uint32_t ) u16_pos);
 
 	uint32_t mask_len  = ( uint32_t ) strlen(hit_text);
 	uint32_t mask_byte = tb_utf16_to_byte_offset(hit_text, mask_len, ( uint32_t ) u16_pos);
-	uint32_t original  = pb_mask_offset_to_original(content, tb->buf_len, mask_byte);
+	uint32_t original  = pb_mask_offset_to_original(content, len, mask_byte);
 	free(mask_heap);
-	return original;
+	return tb->view_from + original;
 }
 
 static void tb_apply_pointer_position(FluxTextBoxInputData *tb, uint32_t byte_pos) {
@@ -262,8 +264,8 @@ static bool tb_handle_delete_button(FluxTextBoxInputData *tb, FluxControlType ct
 	float del_w = (ct == FLUX_CONTROL_NUMBER_BOX) ? FLUX_NUMBER_BOX_DELETE_BTN_W : FLUX_TEXTBOX_ACTION_BUTTON_W;
 	float del_right_offset
 	  = (ct == FLUX_CONTROL_NUMBER_BOX && tb->nb->spin_placement == 2) ? FLUX_NUMBER_BOX_SPIN_W : 0.0f;
-	FluxNodeData *nd       = flux_node_store_get(tb->store, tb->node);
-	bool          show_del = tb->buffer && tb->buf_len > 0 && nd && nd->state.focused && !tb->base.readonly;
+	FluxNodeData *nd       = flux_node_store_edit(tb->store, tb->node);
+	bool          show_del = tb->buf_len > 0 && nd && nd->state.focused && !tb->base.readonly;
 	if (!show_del) return false;
 
 	XentRect rect = {0};
@@ -280,8 +282,8 @@ static bool tb_handle_password_reveal(FluxTextBoxInputData *tb, FluxControlType
 
 	XentRect rect = {0};
 	xent_get_layout_rect(tb->ctx, tb->node, &rect);
-	FluxNodeData *nd       = flux_node_store_get(tb->store, tb->node);
-	bool          show_rev = tb->buffer && tb->buf_len > 0 && nd && nd->state.focused;
+	FluxNodeData *nd       = flux_node_store_edit(tb->store, tb->node);
+	bool          show_rev = tb->buf_len > 0 && nd && nd->state.focused;
 	if (!show_rev || local_x < rect.w - FLUX_PASSWORD_REVEAL_BTN_W) return false;
 
 	xent_set_semantic_checked(tb->ctx, tb->node, 1);
@@ -577,7 +579,7 @@ void tb_on_context_menu(void *ctx, float x, float y) {
 
 void tb_on_focus(void *ctx) {
 	FluxTextBoxInputData *tb = ( FluxTextBoxInputData * ) ctx;
-	FluxNodeData         *nd = flux_node_store_get(tb->store, tb->node);
+	FluxNodeData         *nd = flux_node_store_edit(tb->store, tb->node);
 	if (nd) nd->state.focused = 1;
 	tb_update_ime_position(tb);
 
@@ -599,7 +601,7 @@ void tb_on_focus(void *ctx) {
 
 void tb_on_blur(void *ctx) {
 	FluxTextBoxInputData *tb = ( FluxTextBoxInputData * ) ctx;
-	FluxNodeData         *nd = flux_node_store_get(tb->store, tb->node);
+	FluxNodeData         *nd = flux_node_store_edit(tb->store, tb->node);
 	if (nd) nd->state.focused = 0;
 	tb->base.selection_start    = tb->base.cursor_position;
 	tb->base.selection_end      = tb->base.cursor_position;
@@ -19,30 +19,34 @@ extern "C"
 
 #define FLUX_TEXTBOX_INITIAL_CAP 128
 #define TB_BUFFER_GROWTH_FACTOR  2u
-#define TB_UNDO_MAX              50
+#define TB_UNDO_BUDGET           (4u << 20) /* undo + redo bytes; the newest entry is kept regardless */
 #define TB_TYPING_MERGE_MS       1000
+#define TB_PIECE_THRESHOLD       (1u << 20)  /* text past this many bytes moves from the gap buffer to a piece table */
+#define TB_VIEW_BYTES            (64u << 10) /* text laid out at once; longer text is drawn from a window at the caret */
 
-/** @brief Undo/redo history entry. */
-typedef struct TbEditHistory {
-	char    *deleted;
-	char    *inserted;
-	uint32_t pos;
-	uint32_t deleted_len;
-	uint32_t inserted_len;
-	uint32_t before_sel_start;
-	uint32_t before_sel_end;
-	uint32_t after_sel_start;
-	uint32_t after_sel_end;
-} TbEditHistory;
-
-/** @brief Transient pre-edit snapshot used only to derive compact undo deltas. */
-typedef struct TbPendingEdit {
-	char    *text;
-	uint32_t len;
-	uint32_t sel_start;
+/**
+ * @brief Undo/redo history recorded from the edit ops themselves.
+ *
+ * Entries (one per edit group, each a list of pos/deleted/inserted ops) lie
+ * back to back in one arena, oldest first: [head, cursor) can be undone,
+ * [cursor, tail) redone. The group being recorded is built at [tail, end) and
+ * only replaces the redo entries when it is committed with a change in it.
+ */
+typedef struct TbUndoLog {
+	uint8_t *bytes;
+	uint32_t cap;
+	uint32_t budget;    /**< Byte budget; 0 = TB_UNDO_BUDGET. */
+	uint32_t head;
+	uint32_t cursor;
+	uint32_t tail;
+	uint32_t end;
+	uint32_t last_op;   /**< Newest op of the open group, the one typing extends. */
+	uint32_t op_count;  /**< Ops in the open group. */
+	uint32_t sel_start; /**< Selection before the open group. */
 	uint32_t sel_end;
-	bool     active;
-} TbPendingEdit;
+	bool     open;
+	bool     implicit;  /**< The open group was opened by an edit made outside any group. */
+} TbUndoLog;
 
 /** @brief NumberBox-specific runtime state. Allocated only for FLUX_CONTROL_NUMBER_BOX nodes. */
 typedef struct FluxNBExt {
@@ -64,6 +68,15 @@ typedef struct FluxNBExt {
 
 struct FluxApp;
 
+/** @brief A run of text as stored: one side of the gap, or part of one piece. */
+typedef struct TbTextSpan {
+	char const *data;
+	uint32_t    len;
+} TbTextSpan;
+
+/** @brief Piece-table text storage (tb_piece.c): pieces of an append-only buffer in a balanced tree. */
+typedef struct TbPieceTable TbPieceTable;
+
 /** @brief Extended runtime data for TextBox/PasswordBox/NumberBox. */
 typedef struct FluxTextBoxInputData {
 	FluxTextBoxData base;        /* must be first — renderer casts to FluxTextBoxData* */
@@ -71,22 +84,23 @@ typedef struct FluxTextBoxInputData {
 	char           *flat_buffer; /**< Contiguous text snapshot used by rendering and callbacks. */
 	uint32_t        buf_cap;     /**< Total storage capacity in bytes (text + gap). */
 	uint32_t        flat_cap;    /**< Total storage capacity for @ref flat_buffer. */
-	uint32_t        buf_len;     /**< Logical text length in bytes; equals gap_start + (buf_cap - gap_end). */
+	uint32_t        buf_len;     /**< Logical text length in bytes; in the gap buffer, gap_start + (buf_cap - gap_end). */
 	uint32_t        gap_start;   /**< Byte offset where the gap begins in @ref buffer. */
 	uint32_t        gap_end; /**< Byte offset just past the gap; storage at [gap_end, buf_cap) is the post-gap text. */
-	bool            flat_dirty; /**< True when @ref flat_buffer no longer mirrors the gap buffer. */
+	bool            flat_dirty; /**< True when @ref flat_buffer no longer mirrors the text. */
+	uint32_t        flat_valid; /**< Leading bytes of @ref flat_buffer still equal to the text; sync copies the rest. */
+	TbPieceTable   *pieces;     /**< Storage once the text outgrows TB_PIECE_THRESHOLD; NULL while @ref buffer holds it. */
+	char           *view_buffer; /**< The drawn window of a text longer than TB_VIEW_BYTES. */
+	uint32_t        view_cap;
+	uint32_t        view_from;  /**< First byte of the window; scroll_offset_x is measured from it. */
+	uint32_t        view_len;
+	bool            view_dirty; /**< True when @ref view_buffer no longer matches the window. */
 	XentContext    *ctx;
 	XentNodeId      node;
 	FluxNodeStore  *store;
 	struct FluxApp *app;
 
-	TbEditHistory   undo_stack [TB_UNDO_MAX];
-	int             undo_top; /* -1 = empty */
-	int             undo_start;
-	TbEditHistory   redo_stack [TB_UNDO_MAX];
-	int             redo_top; /* -1 = empty */
-	int             redo_start;
-	TbPendingEdit   pending_edit;
+	TbUndoLog       undo;
 	bool            applying_history;
 
 	ULONGLONG       last_typing_time;
@@ -103,28 +117,59 @@ typedef struct FluxTextBoxInputData {
 	FluxNBExt      *nb;             /**< NumberBox extension; NULL for TextBox and PasswordBox. */
 } FluxTextBoxInputData;
 
-/** @brief Grows @p tb->buffer to at least @p needed bytes; preserves gap structure. */
+/** @brief Makes room for @p needed bytes of text; past TB_PIECE_THRESHOLD the text moves to a piece table. */
 bool          tb_ensure_cap(FluxTextBoxInputData *tb, uint32_t needed);
 /** @brief Closes the gap so @p tb->buffer is contiguous and null-terminated; cost is O(distance from gap to end). */
 void          tb_realize(FluxTextBoxInputData *tb);
-/** @brief Updates the contiguous flat view without moving the gap. */
+/** @brief Materializes the whole text into the flat mirror, copying from the first edited byte to the end.
+ *  Only for readers that need all of it (on_change, flux_textbox_get_content); drawing uses @ref tb_view_text. */
 char const   *tb_sync_content(FluxTextBoxInputData *tb);
+/** @brief The stored run at @p pos, clipped to @p to, read in place; returns its length (0 once @p pos reaches @p to). */
+uint32_t      tb_text_span(FluxTextBoxInputData const *tb, uint32_t pos, uint32_t to, TbTextSpan *out);
+/** @brief Copies bytes [@p from, @p to) into @p dst (not terminated); returns the bytes written. */
+uint32_t      tb_copy_range(FluxTextBoxInputData const *tb, uint32_t from, uint32_t to, char *dst);
+/** @brief The text to lay out: all of it, or for a text longer than TB_VIEW_BYTES the window at view_from. */
+char const   *tb_view_text(FluxTextBoxInputData *tb);
+/** @brief Moves the window to start near @p from (on a code point boundary); takes effect on the next @ref tb_view_text. */
+void          tb_view_anchor(FluxTextBoxInputData *tb, uint32_t from);
+/** @brief Maps text offset @p pos into the window, clamped to its ends. */
+uint32_t      tb_view_offset(FluxTextBoxInputData const *tb, uint32_t pos);
+
+/** @brief Creates an empty piece table. */
+TbPieceTable *tb_piece_create(void);
+/** @brief Frees a piece table and its text. */
+void          tb_piece_destroy(TbPieceTable *pt);
+/** @brief Text length in bytes. */
+uint32_t      tb_piece_length(TbPieceTable const *pt);
+/** @brief Number of pieces the text is split into. */
+uint32_t      tb_piece_count(TbPieceTable const *pt);
+/** @brief Makes room for @p bytes more text and one edit's pieces, so the next insert or delete cannot fail. */
+bool          tb_piece_reserve(TbPieceTable *pt, uint32_t bytes);
+/** @brief Inserts @p len bytes at @p pos in O(log n); typing right after the last insert grows its piece. */
+bool          tb_piece_insert(TbPieceTable *pt, uint32_t pos, char const *s, uint32_t len);
+/** @brief Removes bytes [@p from, @p to) in O(log n). */
+bool          tb_piece_delete(TbPieceTable *pt, uint32_t from, uint32_t to);
+/** @brief The piece run at @p pos, clipped to @p to; returns its length. Repeated reads in one piece skip the lookup. */
+uint32_t      tb_piece_span(TbPieceTable *pt, uint32_t pos, uint32_t to, TbTextSpan *out);
+/** @brief The byte at @p pos. */
+uint8_t       tb_piece_byte_at(TbPieceTable *pt, uint32_t pos);
+
 /** @brief Returns the byte length of the UTF-8 code unit starting at @p pos. */
 uint32_t      tb_utf8_char_len(char const *s, uint32_t len, uint32_t pos);
 /** @brief Returns the byte offset of the previous UTF-8 codepoint before @p pos. */
 uint32_t      tb_utf8_prev(char const *s, uint32_t len, uint32_t pos);
 /** @brief Returns the byte offset of the next UTF-8 codepoint after @p pos. */
 uint32_t      tb_utf8_next(char const *s, uint32_t len, uint32_t pos);
-/** @brief Gap-aware variant of @ref tb_utf8_prev for textbox buffers. */
+/** @brief In-place variant of @ref tb_utf8_prev for textbox buffers. */
 uint32_t      tb_buffer_utf8_prev(FluxTextBoxInputData const *tb, uint32_t pos);
-/** @brief Gap-aware variant of @ref tb_utf8_next for textbox buffers. */
+/** @brief In-place variant of @ref tb_utf8_next for textbox buffers. */
 uint32_t      tb_buffer_utf8_next(FluxTextBoxInputData const *tb, uint32_t pos);
-/** @brief Byte offset of the next grapheme cluster after @p pos, via DirectWrite
- *  cluster analysis. Falls back to a single code point when no renderer is bound. */
-uint32_t      tb_grapheme_next(FluxTextBoxInputData *tb, uint32_t pos);
-/** @brief Byte offset of the previous grapheme cluster before @p pos, via DirectWrite
- *  cluster analysis. Falls back to a single code point when no renderer is bound. */
-uint32_t      tb_grapheme_prev(FluxTextBoxInputData *tb, uint32_t pos);
+/** @brief Byte offset of the next grapheme cluster boundary after @p pos (UAX #29).
+ *  Segments the stored text in place; cost is the cluster length, not the text length. */
+uint32_t      tb_grapheme_next(FluxTextBoxInputData const *tb, uint32_t pos);
+/** @brief Byte offset of the previous grapheme cluster boundary before @p pos (UAX #29).
+ *  Segments the stored text in place; cost is the cluster length, not the text length. */
+uint32_t      tb_grapheme_prev(FluxTextBoxInputData const *tb, uint32_t pos);
 /** @brief Converts a UTF-16 unit index to a UTF-8 byte offset in @p s. */
 uint32_t      tb_utf16_to_byte_offset(char const *s, uint32_t len, uint32_t utf16_pos);
 /** @brief Converts a UTF-8 byte offset to a UTF-16 unit index in @p s. */
@@ -143,20 +188,23 @@ bool          tb_has_selection(FluxTextBoxInputData const *tb);
 uint32_t      tb_word_start(char const *s, uint32_t len, uint32_t pos);
 /** @brief Returns the byte offset of the end of the word containing @p pos. */
 uint32_t      tb_word_end(char const *s, uint32_t len, uint32_t pos);
-/** @brief Gap-aware variant of @ref tb_word_start for textbox buffers. */
+/** @brief In-place variant of @ref tb_word_start for textbox buffers. */
 uint32_t      tb_buffer_word_start(FluxTextBoxInputData const *tb, uint32_t pos);
-/** @brief Gap-aware variant of @ref tb_word_end for textbox buffers. */
+/** @brief In-place variant of @ref tb_word_end for textbox buffers. */
 uint32_t      tb_buffer_word_end(FluxTextBoxInputData const *tb, uint32_t pos);
 
-/** @brief Pushes the current buffer and selection onto the undo stack. */
+/** @brief Opens an undo group (committing the previous one); edits until the next commit join it. */
 void          tb_push_undo(FluxTextBoxInputData *tb);
-/** @brief Commits a pending undo capture after an edit has changed the buffer. */
+/** @brief Closes the open undo group; a group that left the text unchanged is dropped. */
 void          tb_commit_pending_undo(FluxTextBoxInputData *tb);
+/** @brief Records an edit about to replace @p remove_len bytes at @p pos with @p slen bytes from @p s.
+ *  Called by the buffer primitives; an edit with no open group becomes an entry of its own. */
+void          tb_undo_record(FluxTextBoxInputData *tb, uint32_t pos, uint32_t remove_len, char const *s, uint32_t slen);
 /** @brief Reverts to the previous undo state. */
 void          tb_undo(FluxTextBoxInputData *tb);
 /** @brief Reapplies the next redo state. */
 void          tb_redo(FluxTextBoxInputData *tb);
-/** @brief Frees all heap-allocated entries in the undo and redo stacks. */
+/** @brief Frees the undo/redo arena. */
 void          tb_free_undo_redo(FluxTextBoxInputData *tb);
 /** @brief Releases TextBox/PasswordBox/NumberBox component data. */
 void          tb_destroy(void *component_data);
@@ -0,0 +1,241 @@
+#include "tb_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TB_PIECE_NODE_RESERVE 4u /* an edit splits at most twice and adds one piece */
+
+/* One run of the add buffer. Pieces form a treap ordered by text position,
+ * so a byte offset is found, split at or spliced into in O(log n). */
+typedef struct TbPiece {
+	uint32_t start; /**< Offset of the run in the add buffer. */
+	uint32_t len;
+	uint32_t sum;   /**< Bytes in this subtree. */
+	uint32_t prio;
+	uint32_t left;  /**< Node index; 0 = none. On the free list, the next free node. */
+	uint32_t right;
+} TbPiece;
+
+struct TbPieceTable {
+	char       *add; /**< Append-only text store; pieces never move once written. */
+	uint32_t    add_len;
+	uint32_t    add_cap;
+	TbPiece    *nodes; /**< Node 0 is the null node. */
+	uint32_t    node_count;
+	uint32_t    node_cap;
+	uint32_t    free_list;
+	uint32_t    live; /**< Pieces in the tree. */
+	uint32_t    root;
+	uint32_t    seed;
+	uint32_t    hit_from; /**< Last piece looked up, so sequential reads skip the descent. */
+	uint32_t    hit_len;
+	char const *hit_data;
+};
+
+static uint32_t tb_piece_sum(TbPieceTable const *pt, uint32_t n) { return n ? pt->nodes [n].sum : 0; }
+
+static void tb_piece_pull(TbPieceTable *pt, uint32_t n) {
+	TbPiece *p = &pt->nodes [n];
+	p->sum     = tb_piece_sum(pt, p->left) + p->len + tb_piece_sum(pt, p->right);
+}
+
+static uint32_t tb_piece_rand(TbPieceTable *pt) {
+	uint32_t x  = pt->seed;
+	x          ^= x << 13;
+	x          ^= x >> 17;
+	x          ^= x << 5;
+	pt->seed    = x;
+	return x;
+}
+
+/* Never grows the pool: edits reserve nodes first, so pointers into it stay valid mid-edit. */
+static uint32_t tb_piece_alloc(TbPieceTable *pt) {
+	uint32_t n = pt->free_list;
+	if (n) pt->free_list = pt->nodes [n].left;
+	else n = pt->node_count++;
+	pt->nodes [n] = (TbPiece) {0};
+	pt->live++;
+	return n;
+}
+
+static void tb_piece_free_tree(TbPieceTable *pt, uint32_t n) {
+	if (!n) return;
+	tb_piece_free_tree(pt, pt->nodes [n].left);
+	tb_piece_free_tree(pt, pt->nodes [n].right);
+	pt->nodes [n].left = pt->free_list;
+	pt->free_list      = n;
+	pt->live--;
+}
+
+static uint32_t tb_piece_merge(TbPieceTable *pt, uint32_t a, uint32_t b) {
+	if (!a) return b;
+	if (!b) return a;
+	if (pt->nodes [a].prio >= pt->nodes [b].prio) {
+		pt->nodes [a].right = tb_piece_merge(pt, pt->nodes [a].right, b);
+		tb_piece_pull(pt, a);
+		return a;
+	}
+	pt->nodes [b].left = tb_piece_merge(pt, a, pt->nodes [b].left);
+	tb_piece_pull(pt, b);
+	return b;
+}
+
+/* Splits @p n into its first @p pos bytes and the rest. A cut inside a piece
+ * moves the piece's tail into a new node that roots the right side, taking the
+ * piece's priority so the heap order holds. */
+static void tb_piece_split(TbPieceTable *pt, uint32_t n, uint32_t pos, uint32_t *l, uint32_t *r) {
+	if (!n) {
+		*l = 0;
+		*r = 0;
+		return;
+	}
+
+	TbPiece *p    = &pt->nodes [n];
+	uint32_t lsum = tb_piece_sum(pt, p->left);
+	if (pos <= lsum) {
+		tb_piece_split(pt, p->left, pos, l, &p->left);
+		tb_piece_pull(pt, n);
+		*r = n;
+		return;
+	}
+	if (pos >= lsum + p->len) {
+		tb_piece_split(pt, p->right, pos - lsum - p->len, &p->right, r);
+		tb_piece_pull(pt, n);
+		*l = n;
+		return;
+	}
+
+	uint32_t cut  = pos - lsum;
+	uint32_t tail = tb_piece_alloc(pt);
+	pt->nodes [tail] = (TbPiece) {p->start + cut, p->len - cut, 0, p->prio, 0, p->right};
+	p->len           = cut;
+	p->right         = 0;
+	tb_piece_pull(pt, tail);
+	tb_piece_pull(pt, n);
+	*l = n;
+	*r = tail;
+}
+
+/* Typing appends to the add buffer right after the previous keystroke, so the
+ * piece ending at @p pos usually just grows instead of a new piece being split in. */
+static bool tb_piece_extend(TbPieceTable *pt, uint32_t n, uint32_t pos, uint32_t len) {
+	if (!n) return false;
+
+	TbPiece *p     = &pt->nodes [n];
+	uint32_t lsum  = tb_piece_sum(pt, p->left);
+	bool     grown = false;
+	if (pos <= lsum) grown = tb_piece_extend(pt, p->left, pos, len);
+	else if (pos > lsum + p->len) grown = tb_piece_extend(pt, p->right, pos - lsum - p->len, len);
+	else if (pos == lsum + p->len && p->start + p->len == pt->add_len) {
+		p->len += len;
+		grown   = true;
+	}
+	if (grown) p->sum += len;
+	return grown;
+}
+
+TbPieceTable *tb_piece_create(void) {
+	TbPieceTable *pt = ( TbPieceTable * ) calloc(1, sizeof(TbPieceTable));
+	if (!pt) return NULL;
+	pt->node_count = 1;
+	pt->seed       = 0x9e3779b9u;
+	return pt;
+}
+
+void tb_piece_destroy(TbPieceTable *pt) {
+	if (!pt) return;
+	free(pt->add);
+	free(pt->nodes);
+	free(pt);
+}
+
+uint32_t tb_piece_length(TbPieceTable const *pt) { return pt ? tb_piece_sum(pt, pt->root) : 0; }
+
+bool tb_piece_reserve(TbPieceTable *pt, uint32_t bytes) {
+	if (!pt) return false;
+	if (bytes > UINT32_MAX - pt->add_len) return false;
+	if (pt->add_len + bytes > pt->add_cap) {
+		uint32_t needed = pt->add_len + bytes;
+		uint32_t cap    = pt->add_cap ? pt->add_cap : FLUX_TEXTBOX_INITIAL_CAP;
+		while (cap < needed) cap = cap > UINT32_MAX / TB_BUFFER_GROWTH_FACTOR ? needed : cap * TB_BUFFER_GROWTH_FACTOR;
+		char *add = ( char * ) realloc(pt->add, cap);
+		if (!add) return false;
+		pt->add     = add;
+		pt->add_cap = cap;
+		pt->hit_len = 0;
+	}
+	if (pt->node_count + TB_PIECE_NODE_RESERVE > pt->node_cap) {
+		uint32_t cap   = pt->node_cap ? pt->node_cap * TB_BUFFER_GROWTH_FACTOR : 64u;
+		TbPiece *nodes = ( TbPiece * ) realloc(pt->nodes, ( size_t ) cap * sizeof(TbPiece));
+		if (!nodes) return false;
+		pt->nodes    = nodes;
+		pt->node_cap = cap;
+	}
+	return true;
+}
+
+bool tb_piece_insert(TbPieceTable *pt, uint32_t pos, char const *s, uint32_t len) {
+	if (!pt || !s || len == 0 || pos > tb_piece_length(pt)) return false;
+	if (!tb_piece_reserve(pt, len)) return false;
+
+	pt->hit_len = 0;
+	if (!tb_piece_extend(pt, pt->root, pos, len)) {
+		uint32_t n     = tb_piece_alloc(pt);
+		pt->nodes [n] = (TbPiece) {pt->add_len, len, len, tb_piece_rand(pt), 0, 0};
+		uint32_t l, r;
+		tb_piece_split(pt, pt->root, pos, &l, &r);
+		pt->root = tb_piece_merge(pt, tb_piece_merge(pt, l, n), r);
+	}
+	memcpy(pt->add + pt->add_len, s, len);
+	pt->add_len += len;
+	return true;
+}
+
+bool tb_piece_delete(TbPieceTable *pt, uint32_t from, uint32_t to) {
+	if (!pt || from >= to || to > tb_piece_length(pt)) return false;
+	if (!tb_piece_reserve(pt, 0)) return false;
+
+	uint32_t l, m, r;
+	pt->hit_len = 0;
+	tb_piece_split(pt, pt->root, from, &l, &m);
+	tb_piece_split(pt, m, to - from, &m, &r);
+	tb_piece_free_tree(pt, m);
+	pt->root = tb_piece_merge(pt, l, r);
+	return true;
+}
+
+uint32_t tb_piece_span(TbPieceTable *pt, uint32_t pos, uint32_t to, TbTextSpan *out) {
+	uint32_t len = tb_piece_length(pt);
+	if (to > len) to = len;
+	if (pos >= to) return 0;
+
+	if (pos < pt->hit_from || pos >= pt->hit_from + pt->hit_len) {
+		uint32_t n    = pt->root;
+		uint32_t base = 0;
+		while (n) {
+			TbPiece const *p    = &pt->nodes [n];
+			uint32_t       lsum = tb_piece_sum(pt, p->left);
+			if (pos < base + lsum) {
+				n = p->left;
+			} else if (pos < base + lsum + p->len) {
+				pt->hit_from = base + lsum;
+				pt->hit_len  = p->len;
+				pt->hit_data = pt->add + p->start;
+				break;
+			} else {
+				base += lsum + p->len;
+				n     = p->right;
+			}
+		}
+	}
+
+	uint32_t end = pt->hit_from + pt->hit_len < to ? pt->hit_from + pt->hit_len : to;
+	*out         = (TbTextSpan) {pt->hit_data + (pos - pt->hit_from), end - pos};
+	return out->len;
+}
+
+uint8_t tb_piece_byte_at(TbPieceTable *pt, uint32_t pos) {
+	TbTextSpan span;
+	return tb_piece_span(pt, pos, pos + 1, &span) ? ( uint8_t ) span.data [0] : 0;
+}
+
+uint32_t tb_piece_count(TbPieceTable const *pt) { return pt ? pt->live : 0; }
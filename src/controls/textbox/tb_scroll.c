@@ -54,7 +54,7 @@ static float tb_text_reserved_width(FluxTextBoxInputData const *tb, FluxControlT
 
 static float tb_visible_text_width(FluxTextBoxInputData *tb, XentRect const *rect) {
 	FluxControlType ct       = flux_get_control_type(tb->ctx, tb->node);
-	FluxNodeData   *nd       = flux_node_store_get(tb->store, tb->node);
+	FluxNodeData   *nd       = flux_node_store_edit(tb->store, tb->node);
 	float           reserved = tb_text_reserved_width(tb, ct, nd);
 	return rect->w - reserved - FLUX_TEXTBOX_PAD_L - FLUX_TEXTBOX_PAD_R;
 }
@@ -64,7 +64,7 @@ static void tb_apply_parent_scroll_offsets(FluxTextBoxInputData *tb, XentRect *r
 
 	while (parent != XENT_NODE_INVALID) {
 		FluxNodeData   *nd = flux_get_control_type(tb->ctx, parent) == FLUX_CONTROL_SCROLL
-		                     ? flux_node_store_get(tb->store, parent)
+		                     ? flux_node_store_edit(tb->store, parent)
 		                     : NULL;
 		FluxScrollData *sd = nd ? ( FluxScrollData * ) nd->component_data : NULL;
 		if (sd) {
@@ -91,19 +91,20 @@ static bool tb_uses_password_mask(FluxTextBoxInputData *tb) {
 static bool tb_display_text_init(FluxTextBoxInputData *tb, TbDisplayText *display) {
 	memset(display, 0, sizeof(*display));
 
-	char const *content = tb_sync_content(tb);
+	char const *content = tb_view_text(tb);
+	uint32_t    len     = tb->view_len;
 	display->text       = content;
-	display->len        = tb->buf_len;
-	display->cursor     = tb->base.cursor_position;
+	display->len        = len;
+	display->cursor     = tb_view_offset(tb, tb->base.cursor_position);
 	if (!tb_uses_password_mask(tb)) return true;
 
-	if (tb->buf_len > (UINT32_MAX - 1u) / 3u) return false;
-	size_t bytes = ( size_t ) tb->buf_len * 3u + 1u;
+	if (len > (UINT32_MAX - 1u) / 3u) return false;
+	size_t bytes = ( size_t ) len * 3u + 1u;
 	char  *dst   = bytes <= sizeof(display->stack) ? display->stack : ( char * ) malloc(bytes);
 	if (!dst) return false;
 
-	display->len    = pb_build_mask(content, tb->buf_len, dst, ( uint32_t ) bytes);
-	display->cursor = pb_original_offset_to_mask(content, tb->buf_len, tb->base.cursor_position);
+	display->len    = pb_build_mask(content, len, dst, ( uint32_t ) bytes);
+	display->cursor = pb_original_offset_to_mask(content, len, display->cursor);
 	display->text   = dst;
 	if (dst != display->stack) display->heap = dst;
 	return true;
@@ -242,6 +243,31 @@ static float tb_measure_active_text_width(FluxTextBoxInputData *tb, FluxTextRend
 	return size.w;
 }
 
+/* A text longer than TB_VIEW_BYTES is laid out a window at a time. When the
+ * caret nears the window's edge, the window is re-centred on it and the
+ * scroll offset moves with it, so the caret stays put on screen. A caret that
+ * jumped out of the window starts at the left edge and is scrolled in below. */
+static void
+tb_view_follow_caret(FluxTextBoxInputData *tb, FluxTextRenderer *tr, FluxTextStyle const *ts, float visible_w) {
+	( void ) tb_view_text(tb);
+	if (tb->buf_len <= TB_VIEW_BYTES) return;
+
+	uint32_t cur    = tb->base.cursor_position;
+	uint32_t margin = TB_VIEW_BYTES / 4;
+	uint32_t lo     = tb->view_from;
+	uint32_t hi     = tb->view_from + tb->view_len;
+	bool     inside = cur >= lo && cur <= hi;
+	if (inside && (lo == 0 || cur - lo >= margin) && (hi == tb->buf_len || hi - cur >= margin)) return;
+
+	float      width    = visible_w + tb->base.scroll_offset_x;
+	float      screen_x = 0.0f;
+	TbImeCaret caret    = {0.0f, 0.0f, 0.0f};
+	if (inside && tb_measure_active_caret(tb, tr, ts, width, &caret)) screen_x = caret.x - tb->base.scroll_offset_x;
+
+	tb_view_anchor(tb, cur > TB_VIEW_BYTES / 2 ? cur - TB_VIEW_BYTES / 2 : 0);
+	if (tb_measure_active_caret(tb, tr, ts, width, &caret)) tb->base.scroll_offset_x = caret.x - screen_x;
+}
+
 FluxTextStyle tb_make_style(FluxTextBoxInputData const *tb) {
 	FluxTextStyle ts;
 	memset(&ts, 0, sizeof(ts));
@@ -265,6 +291,7 @@ void tb_update_scroll(FluxTextBoxInputData *tb) {
 
 	FluxTextStyle ts    = tb_make_style(tb);
 	TbImeCaret    caret = {0.0f, 0.0f, 0.0f};
+	tb_view_follow_caret(tb, tr, &ts, visible_w);
 	if (!tb_measure_active_caret(tb, tr, &ts, visible_w + tb->base.scroll_offset_x, &caret)) return;
 	float cx = caret.x;
 
@@ -295,8 +322,7 @@ void tb_clamp_scroll(FluxTextBoxInputData *tb) {
 
 void tb_notify_change(FluxTextBoxInputData *tb) {
 	if (!tb->last_op_was_typing) tb_commit_pending_undo(tb);
-	char const *content = tb_sync_content(tb);
-	if (tb->base.on_change) tb->base.on_change(tb->base.on_change_ctx, content);
+	if (tb->base.on_change) tb->base.on_change(tb->base.on_change_ctx, tb_sync_content(tb));
 }
 
 void tb_update_ime_position(FluxTextBoxInputData *tb) {
@@ -2,100 +2,210 @@
 #include <stdlib.h>
 #include <string.h>
 
-static void tb_history_free(TbEditHistory *h) {
-	free(h->deleted);
-	free(h->inserted);
-	memset(h, 0, sizeof(*h));
+/* Arena layout, all fields native uint32_t accessed through memcpy (no padding):
+ *   entry: size, op_count, before_sel_start, before_sel_end, after_sel_start, after_sel_end, ops..., size
+ *   op:    pos, deleted_len, inserted_len, deleted bytes, inserted bytes
+ * The trailing size lets undo step back from the cursor without an index. */
+#define TB_UNDO_ENTRY_HEAD (6u * sizeof(uint32_t))
+#define TB_UNDO_ENTRY_FOOT sizeof(uint32_t)
+#define TB_UNDO_OP_HEAD    (3u * sizeof(uint32_t))
+
+typedef struct TbUndoOp {
+	uint32_t pos;
+	uint32_t deleted_len;
+	uint32_t inserted_len;
+} TbUndoOp;
+
+static uint32_t tb_undo_u32(TbUndoLog const *log, uint32_t off) {
+	uint32_t v;
+	memcpy(&v, log->bytes + off, sizeof(v));
+	return v;
 }
 
-static void tb_pending_free(TbPendingEdit *p) {
-	free(p->text);
-	memset(p, 0, sizeof(*p));
-}
+static void tb_undo_put_u32(TbUndoLog *log, uint32_t off, uint32_t v) { memcpy(log->bytes + off, &v, sizeof(v)); }
 
-static TbEditHistory *tb_history_at(TbEditHistory *stack, int start, int index) {
-	return &stack [(start + index) % TB_UNDO_MAX];
+static TbUndoOp tb_undo_op(TbUndoLog const *log, uint32_t off) {
+	TbUndoOp op;
+	memcpy(&op, log->bytes + off, sizeof(op));
+	return op;
 }
 
-static void tb_history_clear(TbEditHistory *stack, int *start, int *top) {
-	for (int i = 0; i < *top; i++) tb_history_free(tb_history_at(stack, *start, i));
-	*start = 0;
-	*top   = 0;
-}
+static void     tb_undo_put_op(TbUndoLog *log, uint32_t off, TbUndoOp op) { memcpy(log->bytes + off, &op, sizeof(op)); }
+
+static uint32_t tb_undo_budget(TbUndoLog const *log) { return log->budget ? log->budget : TB_UNDO_BUDGET; }
 
-static bool tb_copy_span(char **dst, char const *src, uint32_t len) {
-	*dst = NULL;
-	if (len == 0) return true;
+/* Forget every entry and any open group; the arena is kept for reuse. */
+static void tb_undo_reset(TbUndoLog *log) {
+	log->head     = 0;
+	log->cursor   = 0;
+	log->tail     = 0;
+	log->end      = 0;
+	log->op_count = 0;
+	log->open     = false;
+	log->implicit = false;
+}
 
-	*dst = ( char * ) malloc(( size_t ) len);
-	if (!*dst) return false;
+/* Make room for @p extra bytes after @p log->end. Dropped entries before
+ * head are compacted away first; the arena only grows when that is not enough. */
+static bool tb_undo_reserve(TbUndoLog *log, uint32_t extra) {
+	if (extra > UINT32_MAX - log->end) return false;
+	if (log->end + extra <= log->cap) return true;
+
+	if (log->head > 0) {
+		uint32_t shift = log->head;
+		memmove(log->bytes, log->bytes + shift, log->end - shift);
+		log->head     = 0;
+		log->cursor  -= shift;
+		log->tail    -= shift;
+		log->end     -= shift;
+		log->last_op -= shift < log->last_op ? shift : log->last_op;
+		if (log->end + extra <= log->cap) return true;
+	}
 
-	memcpy(*dst, src, len);
+	uint32_t needed = log->end + extra;
+	uint32_t cap    = log->cap ? log->cap : FLUX_TEXTBOX_INITIAL_CAP;
+	while (cap < needed) cap = cap > UINT32_MAX / TB_BUFFER_GROWTH_FACTOR ? needed : cap * TB_BUFFER_GROWTH_FACTOR;
+	uint8_t *bytes = ( uint8_t * ) realloc(log->bytes, cap);
+	if (!bytes) return false;
+	log->bytes = bytes;
+	log->cap   = cap;
 	return true;
 }
 
-static uint32_t tb_common_prefix(char const *a, uint32_t alen, char const *b, uint32_t blen) {
-	uint32_t limit = alen < blen ? alen : blen;
-	uint32_t pos   = 0;
-	while (pos < limit && a [pos] == b [pos]) pos++;
-	return pos;
+/* Fold an edit into the newest op when it continues it: typing on, backspacing
+ * over just-typed text, or a Backspace/Delete run. Returns false when it does not. */
+static bool tb_undo_coalesce(
+  FluxTextBoxInputData *tb, uint32_t pos, uint32_t remove_len, char const *insert, uint32_t insert_len
+) {
+	TbUndoLog *log = &tb->undo;
+	if (log->op_count == 0) return false;
+
+	TbUndoOp last     = tb_undo_op(log, log->last_op);
+	uint32_t ins_off  = log->end - last.inserted_len;
+	uint32_t last_end = last.pos + last.inserted_len;
+
+	if (remove_len == 0 && pos == last_end) {
+		if (!tb_undo_reserve(log, insert_len)) return false;
+		memcpy(log->bytes + log->end, insert, insert_len);
+		log->end          += insert_len;
+		last.inserted_len += insert_len;
+	} else if (insert_len == 0 && pos >= last.pos && pos + remove_len <= last_end) {
+		uint32_t at = ins_off + (pos - last.pos);
+		memmove(log->bytes + at, log->bytes + at + remove_len, log->end - at - remove_len);
+		log->end          -= remove_len;
+		last.inserted_len -= remove_len;
+	} else if (insert_len == 0 && last.inserted_len == 0 && pos + remove_len == last.pos) {
+		if (!tb_undo_reserve(log, remove_len)) return false;
+		uint32_t del_off = log->last_op + TB_UNDO_OP_HEAD;
+		memmove(log->bytes + del_off + remove_len, log->bytes + del_off, last.deleted_len);
+		tb_copy_range(tb, pos, pos + remove_len, ( char * ) log->bytes + del_off);
+		log->end         += remove_len;
+		last.pos          = pos;
+		last.deleted_len += remove_len;
+	} else if (insert_len == 0 && last.inserted_len == 0 && pos == last.pos) {
+		if (!tb_undo_reserve(log, remove_len)) return false;
+		tb_copy_range(tb, pos, pos + remove_len, ( char * ) log->bytes + log->end);
+		log->end         += remove_len;
+		last.deleted_len += remove_len;
+	} else {
+		return false;
+	}
+	tb_undo_put_op(log, log->last_op, last);
+	return true;
 }
 
-static uint32_t tb_common_suffix(char const *a, uint32_t alen, char const *b, uint32_t blen, uint32_t prefix) {
-	uint32_t suffix = 0;
-	while (suffix + prefix < alen && suffix + prefix < blen) {
-		if (a [alen - suffix - 1] != b [blen - suffix - 1]) break;
-		suffix++;
+void tb_undo_record(FluxTextBoxInputData *tb, uint32_t pos, uint32_t remove_len, char const *s, uint32_t slen) {
+	if (!tb || tb->applying_history) return;
+	TbUndoLog *log = &tb->undo;
+	if (remove_len == 0 && slen == 0) return;
+	/* An edit outside any group (set_content, a validator rewriting the text)
+	 * gets a group of its own, committed by whatever comes next so it picks
+	 * up the selection the caller leaves behind. */
+	if (!log->open || log->implicit) {
+		tb_push_undo(tb);
+		if (!log->open) {
+			tb_undo_reset(log);
+			return;
+		}
+		log->implicit          = true;
+		tb->last_op_was_typing = false;
 	}
-	return suffix;
-}
-
-static bool tb_history_from_pending(TbEditHistory *out, FluxTextBoxInputData *tb) {
-	memset(out, 0, sizeof(*out));
-	TbPendingEdit const *p            = &tb->pending_edit;
-
-	char const          *content      = tb_sync_content(tb);
-	uint32_t             prefix       = tb_common_prefix(p->text, p->len, content, tb->buf_len);
-	uint32_t             suffix       = tb_common_suffix(p->text, p->len, content, tb->buf_len, prefix);
-	uint32_t             deleted_len  = p->len - prefix - suffix;
-	uint32_t             inserted_len = tb->buf_len - prefix - suffix;
-	if (deleted_len == 0 && inserted_len == 0) return false;
-
-	out->pos              = prefix;
-	out->deleted_len      = deleted_len;
-	out->inserted_len     = inserted_len;
-	out->before_sel_start = p->sel_start;
-	out->before_sel_end   = p->sel_end;
-	out->after_sel_start  = tb->base.selection_start;
-	out->after_sel_end    = tb->base.selection_end;
-
-	if (!tb_copy_span(&out->deleted, p->text + prefix, deleted_len)) return false;
-	if (!tb_copy_span(&out->inserted, content + prefix, inserted_len)) {
-		tb_history_free(out);
-		return false;
+	if (tb_undo_coalesce(tb, pos, remove_len, s, slen)) return;
+
+	uint32_t size = TB_UNDO_OP_HEAD + remove_len + slen;
+	if (size < remove_len || !tb_undo_reserve(log, size)) {
+		tb_undo_reset(log);
+		return;
 	}
-	return true;
+	uint32_t off = log->end;
+	tb_undo_put_op(log, off, (TbUndoOp) {pos, remove_len, slen});
+	tb_copy_range(tb, pos, pos + remove_len, ( char * ) log->bytes + off + TB_UNDO_OP_HEAD);
+	if (slen) memcpy(log->bytes + off + TB_UNDO_OP_HEAD + remove_len, s, slen);
+	log->end     += size;
+	log->last_op  = off;
+	log->op_count++;
 }
 
-static bool tb_history_push_entry(TbEditHistory *stack, int *start, int *top, TbEditHistory *entry) {
-	if (*top >= TB_UNDO_MAX) {
-		tb_history_free(tb_history_at(stack, *start, 0));
-		*start = (*start + 1) % TB_UNDO_MAX;
-		*top   = TB_UNDO_MAX - 1;
+/* True when the open group changes the text (typing then erasing it leaves empty ops). */
+static bool tb_undo_group_changes(TbUndoLog const *log) {
+	uint32_t off = log->tail + TB_UNDO_ENTRY_HEAD;
+	for (uint32_t i = 0; i < log->op_count; i++) {
+		TbUndoOp op = tb_undo_op(log, off);
+		if (op.deleted_len || op.inserted_len) return true;
+		off += TB_UNDO_OP_HEAD + op.deleted_len + op.inserted_len;
 	}
-	*tb_history_at(stack, *start, *top) = *entry;
-	memset(entry, 0, sizeof(*entry));
-	(*top)++;
-	return true;
+	return false;
 }
 
-static bool tb_history_pop(TbEditHistory *stack, int start, int *top, TbEditHistory *out) {
-	if (*top <= 0) return false;
+/* Drop the oldest entries until the log fits its budget; the newest always stays. */
+static void tb_undo_trim(TbUndoLog *log) {
+	while (log->head < log->cursor && log->tail - log->head > tb_undo_budget(log)) {
+		uint32_t size = tb_undo_u32(log, log->head);
+		if (log->head + size >= log->cursor) break;
+		log->head += size;
+	}
+}
 
-	TbEditHistory *src = tb_history_at(stack, start, --(*top));
-	*out               = *src;
-	memset(src, 0, sizeof(*src));
-	return true;
+void tb_push_undo(FluxTextBoxInputData *tb) {
+	if (!tb || tb->applying_history) return;
+
+	tb_commit_pending_undo(tb);
+	TbUndoLog *log = &tb->undo;
+	if (!tb_undo_reserve(log, TB_UNDO_ENTRY_HEAD)) return;
+	log->end       = log->tail + TB_UNDO_ENTRY_HEAD;
+	log->op_count  = 0;
+	log->sel_start = tb->base.selection_start;
+	log->sel_end   = tb->base.selection_end;
+	log->open      = true;
+}
+
+void tb_commit_pending_undo(FluxTextBoxInputData *tb) {
+	if (!tb || tb->applying_history || !tb->undo.open) return;
+
+	TbUndoLog *log = &tb->undo;
+	log->open      = false;
+	log->implicit  = false;
+	if (!tb_undo_group_changes(log)) {
+		log->end = log->tail;
+		return;
+	}
+	if (!tb_undo_reserve(log, TB_UNDO_ENTRY_FOOT)) {
+		tb_undo_reset(log);
+		return;
+	}
+
+	uint32_t size = log->end + TB_UNDO_ENTRY_FOOT - log->tail;
+	uint32_t head [6]
+	  = {size, log->op_count, log->sel_start, log->sel_end, tb->base.selection_start, tb->base.selection_end};
+	memcpy(log->bytes + log->tail, head, sizeof(head));
+	tb_undo_put_u32(log, log->end, size);
+
+	/* A new edit discards the redo entries: slide the group down over them. */
+	if (log->cursor < log->tail) memmove(log->bytes + log->cursor, log->bytes + log->tail, size);
+	log->tail   = log->cursor + size;
+	log->cursor = log->tail;
+	log->end    = log->tail;
+	tb_undo_trim(log);
 }
 
 static bool
@@ -117,74 +227,68 @@ static void tb_set_restored_selection(FluxTextBoxInputData *tb, uint32_t start,
 	tb->base.cursor_position = end;
 }
 
-static void tb_history_apply(FluxTextBoxInputData *tb, TbEditHistory *entry, bool redo) {
-	uint32_t remove_len  = redo ? entry->deleted_len : entry->inserted_len;
-	char    *insert      = redo ? entry->inserted : entry->deleted;
-	uint32_t insert_len  = redo ? entry->inserted_len : entry->deleted_len;
+/* Redo replays the ops in order; undo reverts them newest first, so their
+ * offsets are gathered up front. */
+static void tb_undo_apply(FluxTextBoxInputData *tb, uint32_t entry, bool redo) {
+	TbUndoLog *log   = &tb->undo;
+	uint32_t   count = tb_undo_u32(log, entry + sizeof(uint32_t));
+	uint32_t   stack [64];
+	uint32_t  *ops   = count <= 64 ? stack : ( uint32_t * ) malloc(count * sizeof(uint32_t));
+	if (!ops) return;
+
+	uint32_t off = entry + TB_UNDO_ENTRY_HEAD;
+	for (uint32_t i = 0; i < count; i++) {
+		TbUndoOp op  = tb_undo_op(log, off);
+		ops [i]      = off;
+		off         += TB_UNDO_OP_HEAD + op.deleted_len + op.inserted_len;
+	}
 
 	tb->applying_history = true;
-	if (tb_replace_span(tb, entry->pos, remove_len, insert, insert_len)) {
-		if (redo) tb_set_restored_selection(tb, entry->after_sel_start, entry->after_sel_end);
-		else tb_set_restored_selection(tb, entry->before_sel_start, entry->before_sel_end);
+	bool ok              = true;
+	for (uint32_t i = 0; i < count && ok; i++) {
+		uint32_t    at       = ops [redo ? i : count - 1 - i];
+		TbUndoOp    op       = tb_undo_op(log, at);
+		char const *deleted  = ( char const * ) log->bytes + at + TB_UNDO_OP_HEAD;
+		char const *inserted = deleted + op.deleted_len;
+		if (redo) ok = tb_replace_span(tb, op.pos, op.deleted_len, inserted, op.inserted_len);
+		else ok = tb_replace_span(tb, op.pos, op.inserted_len, deleted, op.deleted_len);
+	}
+	if (ok) {
+		uint32_t sel = entry + (redo ? 4u : 2u) * sizeof(uint32_t);
+		tb_set_restored_selection(tb, tb_undo_u32(log, sel), tb_undo_u32(log, sel + sizeof(uint32_t)));
 		tb_update_scroll(tb);
 		tb_notify_change(tb);
 	}
 	tb->applying_history = false;
-}
-
-void tb_push_undo(FluxTextBoxInputData *tb) {
-	if (!tb || tb->applying_history) return;
-
-	tb_commit_pending_undo(tb);
-	tb_pending_free(&tb->pending_edit);
-
-	char const *content   = tb_sync_content(tb);
-	tb->pending_edit.text = ( char * ) malloc(( size_t ) tb->buf_len + 1u);
-	if (!tb->pending_edit.text) return;
-
-	memcpy(tb->pending_edit.text, content, ( size_t ) tb->buf_len + 1u);
-	tb->pending_edit.len       = tb->buf_len;
-	tb->pending_edit.sel_start = tb->base.selection_start;
-	tb->pending_edit.sel_end   = tb->base.selection_end;
-	tb->pending_edit.active    = true;
-}
-
-void tb_commit_pending_undo(FluxTextBoxInputData *tb) {
-	if (!tb || tb->applying_history || !tb->pending_edit.active) return;
-
-	TbEditHistory entry;
-	if (tb_history_from_pending(&entry, tb)) {
-		tb_history_push_entry(tb->undo_stack, &tb->undo_start, &tb->undo_top, &entry);
-		tb_history_clear(tb->redo_stack, &tb->redo_start, &tb->redo_top);
-	}
-	tb_pending_free(&tb->pending_edit);
+	if (ops != stack) free(ops);
+	if (!ok) tb_undo_reset(log);
 }
 
 void tb_undo(FluxTextBoxInputData *tb) {
 	if (!tb) return;
 	tb_commit_pending_undo(tb);
-	if (tb->undo_top <= 0) return;
+	TbUndoLog *log = &tb->undo;
+	if (log->cursor <= log->head) return;
 
-	TbEditHistory entry;
-	if (!tb_history_pop(tb->undo_stack, tb->undo_start, &tb->undo_top, &entry)) return;
-	tb_history_apply(tb, &entry, false);
-	tb_history_push_entry(tb->redo_stack, &tb->redo_start, &tb->redo_top, &entry);
+	log->cursor -= tb_undo_u32(log, log->cursor - TB_UNDO_ENTRY_FOOT);
+	tb_undo_apply(tb, log->cursor, false);
 }
 
 void tb_redo(FluxTextBoxInputData *tb) {
 	if (!tb) return;
 	tb_commit_pending_undo(tb);
-	if (tb->redo_top <= 0) return;
+	TbUndoLog *log = &tb->undo;
+	if (log->cursor >= log->tail) return;
 
-	TbEditHistory entry;
-	if (!tb_history_pop(tb->redo_stack, tb->redo_start, &tb->redo_top, &entry)) return;
-	tb_history_apply(tb, &entry, true);
-	tb_history_push_entry(tb->undo_stack, &tb->undo_start, &tb->undo_top, &entry);
+	uint32_t entry  = log->cursor;
+	log->cursor    += tb_undo_u32(log, entry);
+	tb_undo_apply(tb, entry, true);
 }
 
 void tb_free_undo_redo(FluxTextBoxInputData *tb) {
 	if (!tb) return;
-	tb_pending_free(&tb->pending_edit);
-	tb_history_clear(tb->undo_stack, &tb->undo_start, &tb->undo_top);
-	tb_history_clear(tb->redo_stack, &tb->redo_start, &tb->redo_top);
+	free(tb->undo.bytes);
+	tb->undo.bytes = NULL;
+	tb->undo.cap   = 0;
+	tb_undo_reset(&tb->undo);
 }
@@ -17,7 +17,7 @@
 
 static FluxNodeData *flux_component_node(FluxNodeStore *store, XentNodeId id) {
 	if (!store) return NULL;
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	if (!nd || !nd->component_data) return NULL;
 	return nd;
 }
@@ -45,6 +45,7 @@ static void flux_label_sync(FluxNodeStore *store, XentNodeId id, char const *val
 	XentContext *ctx = flux_node_store_context(store);
 	xent_set_text(ctx, id, value ? value : "");
 	xent_set_semantic_label(ctx, id, value ? value : "");
+	flux_node_store_invalidate_node_layout(store, id);
 }
 
 /* Enabled is a single source of truth: xent's semantic enabled. Rendering, focus,
@@ -99,6 +100,7 @@ static void flux_button_reserve_icon_pad(
 	float        pad_r    = dropdown ? 31.0f : split ? 47.0f : 11.0f;
 	xent_set_padding(ctx, id, (XentInsets) {11.0f + reserve, 5.0f, pad_r, 6.0f});
 	if (iconed && !labeled && !dropdown && !split) xent_set_size(ctx, id, (XentSize) {40.0f, 32.0f});
+	flux_node_store_invalidate_layout(store);
 }
 
 void flux_button_set_icon(FluxNodeStore *store, XentNodeId id, char const *icon_name) {
@@ -151,6 +153,7 @@ void flux_text_set_content(FluxNodeStore *store, XentNodeId id, char const *cont
 	if (!nd || !FLUX_EXPECT_TYPE(nd, FLUX_CONTROL_TEXT)) return;
 	flux_str_replace(&(( FluxTextData * ) nd->component_data)->content, content);
 	xent_set_text(flux_node_store_context(store), id, content ? content : "");
+	flux_node_store_invalidate_node_layout(store, id);
 }
 
 /* Font size also feeds xent's text measurement, so re-mirror it. */
@@ -159,6 +162,7 @@ void flux_text_set_font_size(FluxNodeStore *store, XentNodeId id, float size) {
 	if (!nd || !FLUX_EXPECT_TYPE(nd, FLUX_CONTROL_TEXT)) return;
 	(( FluxTextData * ) nd->component_data)->font_size = size;
 	xent_set_font_size(flux_node_store_context(store), id, size);
+	flux_node_store_invalidate_node_layout(store, id);
 }
 
 /* Font weight also feeds xent's text measurement, so re-mirror it. */
@@ -167,6 +171,7 @@ void flux_text_set_font_weight(FluxNodeStore *store, XentNodeId id, FluxFontWeig
 	if (!nd || !FLUX_EXPECT_TYPE(nd, FLUX_CONTROL_TEXT)) return;
 	(( FluxTextData * ) nd->component_data)->font_weight = weight;
 	xent_set_font_weight(flux_node_store_context(store), id, flux_font_weight_numeric(weight));
+	flux_node_store_invalidate_node_layout(store, id);
 }
 
 FLUX_SETTER(flux_text, FluxTextData, text_color, FluxColor, FLUX_EXPECT_TYPE(nd, FLUX_CONTROL_TEXT))
@@ -201,6 +206,16 @@ void flux_textbox_set_content(FluxNodeStore *store, XentNodeId id, char const *c
 	if (tb) tb_replace_text(tb, content);
 }
 
+char const *flux_textbox_get_content(FluxNodeStore *store, XentNodeId id) {
+	FluxNodeData const *nd = store ? flux_node_store_get(store, id) : NULL;
+	if (!nd || !nd->component_data) return NULL;
+	if (nd->component_type != FLUX_CONTROL_TEXT_INPUT
+	    && nd->component_type != FLUX_CONTROL_PASSWORD_BOX
+	    && nd->component_type != FLUX_CONTROL_NUMBER_BOX)
+		return NULL;
+	return tb_sync_content(( FluxTextBoxInputData * ) nd->component_data);
+}
+
 void flux_textbox_set_placeholder(FluxNodeStore *store, XentNodeId id, char const *placeholder) {
 	FluxTextBoxInputData *tb = flux_text_input_data(store, id, FLUX_CONTROL_TEXT_INPUT);
 	if (tb) flux_str_replace(&tb->base.placeholder, placeholder);
@@ -224,7 +239,7 @@ FLUX_SETTER_2(
 
 static FluxNodeData *flux_node_for_visual_setter(FluxNodeStore *store, XentNodeId id) {
 	if (!store) return NULL;
-	FluxNodeData *nd = flux_node_store_get(store, id);
+	FluxNodeData *nd = flux_node_store_edit(store, id);
 	return nd;
 }
 
@@ -5,6 +5,7 @@
 
 #include "fluxent/flux_graphics.h"
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -18,7 +19,9 @@
 #include "compose/flux_compose.h"
 #include "compose/flux_effect.h"
 
-#define MIN_SURFACE_SIZE 1
+#define MIN_SURFACE_SIZE    1
+#define SWAP_BUFFER_COUNT   2
+#define PRESENT_DIRTY_MAX   FLUX_DAMAGE_MAX_RECTS
 
 struct FluxGraphics {
 	HWND                           hwnd;
@@ -46,6 +49,8 @@ struct FluxGraphics {
 	bool                           composition_mode; /**< Retained-tree path (FLUX_USE_COMPOSITION). */
 	bool                           popup_presented;  /**< Swap chain hosted in a content child (popup windows). */
 	bool                           window_acrylic;   /**< Host-backdrop acrylic backplate active (popup windows). */
+	bool                           retains_buffers;  /**< Swap effect keeps back-buffer contents (FLIP_SEQUENTIAL). */
+	uint32_t                       presents;         /**< Presents since the buffers were (re)created. */
 	HRESULT                        last_hr;
 
 	FluxRedrawCallback             redraw_cb;
@@ -104,6 +109,7 @@ static void release_window_resources(FluxGraphics *gfx) {
 	gfx->window_target  = NULL;
 	gfx->popup_presented = false; /* target gone; re-establish on next enable call */
 	gfx->window_acrylic  = false;
+	gfx->presents        = 0;
 	FLUX_RELEASE(gfx->d2d_target);
 	FLUX_RELEASE(gfx->swap_chain);
 }
@@ -125,7 +131,7 @@ static DXGI_SWAP_CHAIN_DESC1 graphics_swap_desc(UINT w, UINT h, DXGI_SWAP_EFFECT
 	desc.Format           = DXGI_FORMAT_B8G8R8A8_UNORM;
 	desc.SampleDesc.Count = 1;
 	desc.BufferUsage      = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-	desc.BufferCount      = 2;
+	desc.BufferCount      = SWAP_BUFFER_COUNT;
 	desc.Scaling          = DXGI_SCALING_STRETCH;
 	desc.SwapEffect       = effect;
 	desc.AlphaMode        = DXGI_ALPHA_MODE_PREMULTIPLIED;
@@ -158,8 +164,13 @@ static HRESULT graphics_create_d2d_target(FluxGraphics *gfx) {
 	return S_OK;
 }
 
+/* The classic path redraws only damaged rects, which needs the back buffer to
+ * keep its last contents: FLIP_SEQUENTIAL does, FLIP_DISCARD does not. The
+ * retained-composition path repaints per-node surfaces and keeps DISCARD. */
 static HRESULT graphics_create_composition_swap_chain(FluxGraphics *gfx, UINT w, UINT h) {
-	DXGI_SWAP_CHAIN_DESC1 desc = graphics_swap_desc(w, h, DXGI_SWAP_EFFECT_FLIP_DISCARD);
+	DXGI_SWAP_EFFECT      effect = gfx->composition_mode ? DXGI_SWAP_EFFECT_FLIP_DISCARD : DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;
+	DXGI_SWAP_CHAIN_DESC1 desc   = graphics_swap_desc(w, h, effect);
+	gfx->retains_buffers         = effect == DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;
 	return IDXGIFactory2_CreateSwapChainForComposition(
 	  gfx->dxgi_factory, ( IUnknown * ) gfx->d3d_device, &desc, NULL, &gfx->swap_chain
 	);
@@ -273,6 +284,7 @@ static HRESULT create_hwnd_window_resources(FluxGraphics *gfx) {
 	graphics_client_size(gfx, &w, &h);
 
 	DXGI_SWAP_CHAIN_DESC1 desc = graphics_swap_desc(w, h, DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL);
+	gfx->retains_buffers       = true;
 	HRESULT               hr   = IDXGIFactory2_CreateSwapChainForHwnd(
 	  gfx->dxgi_factory, ( IUnknown * ) gfx->d3d_device, gfx->hwnd, &desc, NULL, NULL, &gfx->swap_chain
 	);
@@ -299,6 +311,7 @@ HRESULT flux_graphics_resize(FluxGraphics *gfx, int width, int height) {
 	ID2D1DeviceContext_SetTarget(gfx->d2d_context, NULL);
 	ID2D1RenderTarget_Flush(( ID2D1RenderTarget * ) gfx->d2d_context, NULL, NULL);
 	FLUX_RELEASE(gfx->d2d_target);
+	gfx->presents = 0;
 
 	HRESULT hr
 	  = IDXGISwapChain1_ResizeBuffers(gfx->swap_chain, 0, ( UINT ) width, ( UINT ) height, DXGI_FORMAT_UNKNOWN, 0);
@@ -315,7 +328,8 @@ HRESULT flux_graphics_resize(FluxGraphics *gfx, int width, int height) {
 
 void flux_graphics_set_dpi(FluxGraphics *gfx, FluxDpiInfo dpi) {
 	if (!gfx) return;
-	gfx->dpi = dpi;
+	gfx->dpi      = dpi;
+	gfx->presents = 0;
 	if (gfx->d2d_context) ID2D1RenderTarget_SetDpi(( ID2D1RenderTarget * ) gfx->d2d_context, dpi.dpi_x, dpi.dpi_y);
 }
 
@@ -335,13 +349,67 @@ void flux_graphics_end_draw(FluxGraphics *gfx) {
 	else if (FAILED(hr)) gfx->last_hr = hr;
 }
 
+static void graphics_note_present(FluxGraphics *gfx, HRESULT hr) {
+	if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
+		( void ) flux_graphics_handle_device_change(gfx);
+	else if (FAILED(hr)) {
+		gfx->last_hr  = hr;
+		gfx->presents = 0;
+	}
+	else gfx->presents++;
+}
+
 void flux_graphics_present(FluxGraphics *gfx, bool vsync) {
 	if (!gfx || !gfx->swap_chain) return;
 	/* SyncInterval 1 blocks for vblank (vsync on); 0 presents immediately. */
 	HRESULT hr = IDXGISwapChain_Present(( IDXGISwapChain * ) gfx->swap_chain, vsync ? 1u : 0u, 0);
-	if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
-		( void ) flux_graphics_handle_device_change(gfx);
-	else if (FAILED(hr)) gfx->last_hr = hr;
+	graphics_note_present(gfx, hr);
+}
+
+static UINT graphics_dirty_rects(FluxGraphics const *gfx, FluxDamageRegion const *region, RECT *out) {
+	UINT  w, h;
+	float scale = gfx->dpi.dpi_x / FLUX_DPI_BASE;
+	graphics_client_size(( FluxGraphics * ) gfx, &w, &h);
+
+	UINT n = 0;
+	for (uint32_t i = 0; i < region->count && n < PRESENT_DIRTY_MAX; i++) {
+		FluxRect const *r = &region->rects [i];
+		LONG            l = ( LONG ) floorf(r->x * scale);
+		LONG            t = ( LONG ) floorf(r->y * scale);
+		LONG            u = ( LONG ) ceilf((r->x + r->w) * scale);
+		LONG            b = ( LONG ) ceilf((r->y + r->h) * scale);
+		if (l < 0) l = 0;
+		if (t < 0) t = 0;
+		if (u > ( LONG ) w) u = ( LONG ) w;
+		if (b > ( LONG ) h) b = ( LONG ) h;
+		if (u <= l || b <= t) continue;
+		out [n++] = (RECT) {l, t, u, b};
+	}
+	return n;
+}
+
+void flux_graphics_present_region(FluxGraphics *gfx, bool vsync, FluxDamageRegion const *region) {
+	if (!gfx || !gfx->swap_chain) return;
+	/* DXGI requires the first present after (re)creation to cover the whole
+	 * buffer; a discard swap effect never retains enough for dirty rects. */
+	if (!region || region->full || !gfx->retains_buffers || gfx->presents == 0) {
+		flux_graphics_present(gfx, vsync);
+		return;
+	}
+
+	RECT                    rects [PRESENT_DIRTY_MAX];
+	DXGI_PRESENT_PARAMETERS params;
+	memset(&params, 0, sizeof(params));
+	params.DirtyRectsCount = graphics_dirty_rects(gfx, region, rects);
+	params.pDirtyRects     = params.DirtyRectsCount ? rects : NULL;
+
+	HRESULT hr             = IDXGISwapChain1_Present1(gfx->swap_chain, vsync ? 1u : 0u, 0, &params);
+	graphics_note_present(gfx, hr);
+}
+
+uint32_t flux_graphics_buffer_age(FluxGraphics const *gfx) {
+	if (!gfx || !gfx->swap_chain || !gfx->retains_buffers) return 0;
+	return gfx->presents >= SWAP_BUFFER_COUNT ? SWAP_BUFFER_COUNT : 0;
 }
 
 void flux_graphics_clear(FluxGraphics *gfx, FluxColor color) {
@@ -36,10 +36,9 @@ static FluxDManipViewport *ensure_scroll_viewport(FluxDManip *dmanip, FluxScroll
 	return vp;
 }
 
-static void sync_scroll_viewport(DManipSyncContext const *sync, FluxScrollData *sd, FluxRect const *viewport) {
-	FluxDManipViewport *vp = ensure_scroll_viewport(sync->dmanip, sd);
-	if (!vp) return;
-
+static void sync_scroll_viewport(
+  DManipSyncContext const *sync, FluxDManipViewport *vp, FluxScrollData const *sd, FluxRect const *viewport
+) {
 	flux_dmanip_viewport_set_dpi_scale(vp, sync->scale);
 
 	int px = ( int ) (viewport->x * sync->scale + 0.5f);
@@ -60,11 +59,17 @@ static void sync_scroll_viewport(DManipSyncContext const *sync, FluxScrollData *
 static void sync_scroll_node(DManipSyncContext const *sync, DManipNodeState *state) {
 	if (flux_get_control_type(sync->ctx, state->node) != FLUX_CONTROL_SCROLL) return;
 
-	FluxNodeData   *nd = flux_node_store_get(sync->store, state->node);
-	FluxScrollData *sd = nd ? ( FluxScrollData * ) nd->component_data : NULL;
+	FluxNodeData const   *nd = flux_node_store_get(sync->store, state->node);
+	FluxScrollData const *sd = nd ? ( FluxScrollData const * ) nd->component_data : NULL;
 	if (!sd) return;
 
-	sync_scroll_viewport(sync, sd, &state->viewport);
+	/* Only the first sync writes (it attaches the viewport); later ones read. */
+	FluxDManipViewport *vp = ( FluxDManipViewport * ) sd->dmanip_viewport;
+	if (!vp)
+		vp = ensure_scroll_viewport(
+		  sync->dmanip, ( FluxScrollData * ) flux_node_store_edit(sync->store, state->node)->component_data
+		);
+	if (vp) sync_scroll_viewport(sync, vp, sd, &state->viewport);
 	state->child_ax -= flux_scroll_off_x(sd);
 	state->child_ay -= flux_scroll_off_y(sd);
 }
@@ -101,7 +106,7 @@ dmanip_viewport_for_input_pan(FluxInput *input, FluxNodeStore *store, FluxScroll
 	XentNodeId target = flux_input_get_touch_pan_target(input);
 	if (target == XENT_NODE_INVALID) return NULL;
 
-	FluxNodeData   *nd = flux_node_store_get(store, target);
+	FluxNodeData   *nd = flux_node_store_edit(store, target);
 	FluxScrollData *sd = nd ? ( FluxScrollData * ) nd->component_data : NULL;
 	*out_sd            = sd;
 	return sd ? ( FluxDManipViewport * ) sd->dmanip_viewport : NULL;
@@ -125,7 +130,7 @@ bool flux_dmanip_handoff_touch_pan(FluxDManip *dmanip, FluxInput *input, FluxNod
 static void cleanup_scroll_node(XentContext *ctx, FluxNodeStore *store, XentNodeId node) {
 	if (flux_get_control_type(ctx, node) != FLUX_CONTROL_SCROLL) return;
 
-	FluxNodeData   *nd = flux_node_store_get(store, node);
+	FluxNodeData   *nd = flux_node_store_edit(store, node);
 	FluxScrollData *sd = nd ? ( FluxScrollData * ) nd->component_data : NULL;
 	if (!sd || !sd->dmanip_viewport) return;
 
@@ -151,7 +156,7 @@ void flux_dmanip_cleanup_tree(XentContext *ctx, FluxNodeStore *store, XentNodeId
 }
 
 void flux_dmanip_release_node_viewport(FluxNodeStore *store, XentNodeId node) {
-	FluxNodeData *nd = flux_node_store_get(store, node);
+	FluxNodeData *nd = flux_node_store_edit(store, node);
 	if (!nd || nd->component_type != FLUX_CONTROL_SCROLL || !nd->component_data) return;
 
 	FluxScrollData *sd = ( FluxScrollData * ) nd->component_data;
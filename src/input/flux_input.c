@@ -6,13 +6,6 @@
 #include <math.h>
 #include <windows.h>
 
-typedef struct InputHitQuery {
-	XentContext *ctx;
-	XentNodeId   node;
-	FluxPoint    point;
-	FluxPoint    scroll;
-} InputHitQuery;
-
 typedef struct InputScrollEvent {
 	FluxInput *input;
 	XentNodeId root;
@@ -20,109 +13,192 @@ typedef struct InputScrollEvent {
 	FluxPoint  wheel;
 } InputScrollEvent;
 
-typedef struct HitChildList {
-	XentNodeId *items;
-	uint32_t    count;
-	uint32_t    cap;
-} HitChildList;
-
-static FluxPoint hit_test_child_scroll_offset(InputHitQuery const *query, FluxNodeData *nd) {
-	FluxPoint scroll = query->scroll;
-	if (!nd || flux_get_control_type(query->ctx, query->node) != FLUX_CONTROL_SCROLL) return scroll;
-
-	FluxScrollData *sd = ( FluxScrollData * ) nd->component_data;
-	if (!sd) return scroll;
-
-	scroll.x += flux_scroll_off_x(sd);
-	scroll.y += flux_scroll_off_y(sd);
-	return scroll;
-}
-
-static bool hit_rect_contains(XentRect const *rect, FluxPoint point, FluxPoint scroll) {
-	float ax = rect->x - scroll.x;
-	float ay = rect->y - scroll.y;
-	return point.x >= ax && point.x < ax + rect->w && point.y >= ay && point.y < ay + rect->h;
-}
-
-static bool hit_child_list_append(HitChildList *children, XentNodeId child) {
-	if (children->count == children->cap) {
-		uint32_t    cap   = children->cap ? children->cap * 2u : 16u;
-		XentNodeId *items = ( XentNodeId * ) realloc(children->items, sizeof(*items) * cap);
-		if (!items) return false;
-		children->items = items;
-		children->cap   = cap;
-	}
-
-	children->items [children->count++] = child;
+/* Offset a node applies to its children's layout rects (scroll viewers only). */
+static FluxPoint hit_child_scroll_offset(XentContext *ctx, XentNodeId node, FluxNodeData const *nd) {
+	if (!nd || flux_get_control_type(ctx, node) != FLUX_CONTROL_SCROLL) return (FluxPoint) {0.0f, 0.0f};
+
+	FluxScrollData const *sd = ( FluxScrollData const * ) nd->component_data;
+	if (!sd) return (FluxPoint) {0.0f, 0.0f};
+	return (FluxPoint) {flux_scroll_off_x(sd), flux_scroll_off_y(sd)};
+}
+
+/* The render transform the engine pushes for @p nd (same condition and pivot
+ * as the collect), so the walk resolves the geometry that was drawn. */
+static bool hit_node_transform(FluxNodeData const *nd, XentRect const *rect, FluxHitTransform *xf) {
+	if (!nd
+	    || (nd->render_scale == 1.0f && nd->render_opacity >= 1.0f && nd->render_translate_y == 0.0f
+	        && nd->render_translate_x == 0.0f))
+		return false;
+	xf->bounds       = (FluxRect) {rect->x, rect->y, rect->w, rect->h};
+	xf->scale        = nd->render_scale;
+	xf->pivot_x      = rect->x + rect->w * 0.5f;
+	xf->pivot_y      = rect->y + rect->h * 0.5f;
+	xf->translate_x  = nd->render_translate_x;
+	xf->translate_y  = nd->render_translate_y;
+	xf->clip_subtree = nd->render_clip_subtree;
 	return true;
 }
 
-static HitChildList hit_collect_children(XentContext *ctx, XentNodeId node) {
-	HitChildList children = {0};
-	XentNodeId   child    = xent_get_first_child(ctx, node);
-	while (child != XENT_NODE_INVALID) {
-		if (!hit_child_list_append(&children, child)) break;
-		child = xent_get_next_sibling(ctx, child);
-	}
-	return children;
+static bool hit_rect_contains(FluxRect const *rect, FluxPoint point) {
+	return point.x >= rect->x && point.x < rect->x + rect->w && point.y >= rect->y && point.y < rect->y + rect->h;
 }
 
-static FluxHitResult hit_test_recursive(InputHitQuery const *query);
-
 /* A node that participates in pointer interaction (press/click/hover/focus/tooltip). */
 static bool hit_node_interactive(XentContext *ctx, XentNodeId node, FluxNodeData const *nd) {
 	if (xent_get_focusable(ctx, node)) return true;
 	if (!nd) return false;
-	FluxNodeBehavior const *b = &nd->behavior;
+	FluxNodeBehavior const *b = nd->behavior;
 	return b->on_click || b->on_pointer_down || b->on_middle_click || b->on_hover_changed || nd->tooltip_text;
 }
 
-static FluxHitResult
-hit_test_children(InputHitQuery const *query, HitChildList const *children, FluxPoint child_scroll) {
-	for (uint32_t i = children->count; i > 0; i--) {
-		InputHitQuery child_query = *query;
-		child_query.node          = children->items [i - 1u];
-		child_query.scroll        = child_scroll;
-		FluxHitResult r           = hit_test_recursive(&child_query);
-		if (r.node != XENT_NODE_INVALID) return r;
+/* An empty, non-interactive node (e.g. the overlay layer with no modal) is
+ * transparent to the pointer so clicks fall through to the content beneath. */
+static bool hit_leaf_takes_pointer(XentContext *ctx, XentNodeId node) {
+	return hit_node_interactive(ctx, node, ( FluxNodeData const * ) xent_get_userdata(ctx, node));
+}
+
+/* Whether @p point is on @p node as drawn under @p parent (its parent's child
+ * mapping); @p own receives the node's own mapping. */
+static bool hit_node_contains(
+  FluxNodeData const *nd, XentRect const *rect, FluxHitMapping parent, FluxPoint point, FluxHitMapping *own
+) {
+	FluxRect         layout = {rect->x, rect->y, rect->w, rect->h};
+	FluxHitTransform xf;
+	*own = parent;
+	if (hit_node_transform(nd, rect, &xf)) {
+		*own = flux_hit_mapping_transform(parent, &xf);
+		if (xf.clip_subtree) {
+			FluxRect clip = flux_hit_mapping_rect(parent, xf.bounds);
+			if (!hit_rect_contains(&clip, point)) return false;
+		}
 	}
-	return (FluxHitResult) {0};
+	FluxRect drawn = flux_hit_mapping_rect(*own, layout);
+	return hit_rect_contains(&drawn, point);
 }
 
-static FluxHitResult hit_test_recursive(InputHitQuery const *query) {
-	XentRect rect = {0};
-	xent_get_layout_rect(query->ctx, query->node, &rect);
-	if (!hit_rect_contains(&rect, query->point, query->scroll)) return (FluxHitResult) {0};
-
-	FluxNodeData *nd           = ( FluxNodeData * ) xent_get_userdata(query->ctx, query->node);
-	FluxPoint     child_scroll = hit_test_child_scroll_offset(query, nd);
-	HitChildList  children     = hit_collect_children(query->ctx, query->node);
-	FluxHitResult child_hit    = hit_test_children(query, &children, child_scroll);
-	free(children.items);
-	if (child_hit.node != XENT_NODE_INVALID) return child_hit;
-
-	/* An empty, non-interactive node (e.g. the overlay layer with no modal) is
-	 * transparent to the pointer so clicks fall through to the content beneath. */
-	if (children.count == 0 && !hit_node_interactive(query->ctx, query->node, nd)) return (FluxHitResult) {0};
-
-	float ax = rect.x - query->scroll.x;
-	float ay = rect.y - query->scroll.y;
+/* Mapping @p node applies to its children: its own plus its scroll offset. */
+static FluxHitMapping hit_child_mapping(XentContext *ctx, XentNodeId node, FluxNodeData const *nd, FluxHitMapping own) {
+	FluxPoint offset = hit_child_scroll_offset(ctx, node, nd);
+	return flux_hit_mapping_scroll(own, offset.x, offset.y);
+}
+
+/* outer(inner(p)). */
+static FluxHitMapping hit_mapping_compose(FluxHitMapping outer, FluxHitMapping inner) {
+	return (FluxHitMapping) {
+	  outer.scale * inner.scale,
+	  inner.x * outer.scale + outer.x,
+	  inner.y * outer.scale + outer.y,
+	};
+}
+
+/* Child mapping of @p node rebuilt from its ancestors, for paths deeper than
+ * the walk keeps. */
+static FluxHitMapping hit_child_mapping_of(XentContext *ctx, XentNodeId root, XentNodeId node) {
+	FluxHitMapping m = flux_hit_mapping_identity();
+	for (XentNodeId n = node; n != XENT_NODE_INVALID; n = xent_get_parent(ctx, n)) {
+		FluxNodeData const *nd   = ( FluxNodeData const * ) xent_get_userdata(ctx, n);
+		XentRect            rect = {0};
+		FluxHitTransform    xf;
+		xent_get_layout_rect(ctx, n, &rect);
+		FluxHitMapping own = flux_hit_mapping_identity();
+		if (hit_node_transform(nd, &rect, &xf)) own = flux_hit_mapping_transform(own, &xf);
+		m = hit_mapping_compose(hit_child_mapping(ctx, n, nd, own), m);
+		if (n == root) break;
+	}
+	return m;
+}
+
+static FluxHitResult hit_result(XentNodeId node, FluxNodeData *nd, FluxRect bounds, float scale, FluxPoint point) {
 	return (FluxHitResult) {
-	  .node   = query->node,
+	  .node   = node,
 	  .data   = nd,
-	  .bounds = {ax, ay, rect.w, rect.h},
-	  .local  = {query->point.x - ax, query->point.y - ay},
+	  .bounds = bounds,
+	  .local  = {(point.x - bounds.x) / scale, (point.y - bounds.y) / scale},
 	};
 }
 
+/* Child mappings along the walk's current path; deeper levels are rebuilt
+ * from the ancestors on the way back up. */
+#define HIT_WALK_MAX_DEPTH 64
+
+typedef struct HitWalk {
+	XentContext   *ctx;
+	XentNodeId     root;
+	uint32_t       depth;  /**< Depth of the current node (root = 0). */
+	FluxHitMapping parent; /**< Child mapping of the current node's parent. */
+	FluxHitMapping path [HIT_WALK_MAX_DEPTH];
+} HitWalk;
+
+static void hit_walk_descend(HitWalk *walk, FluxHitMapping child_mapping) {
+	if (walk->depth < HIT_WALK_MAX_DEPTH) walk->path [walk->depth] = child_mapping;
+	walk->depth++;
+	walk->parent = child_mapping;
+}
+
+/* Next sibling of @p node or of its nearest ancestor below the root, restoring
+ * the parent mapping on the way up. */
+static XentNodeId hit_walk_next(HitWalk *walk, XentNodeId node) {
+	while (node != walk->root) {
+		XentNodeId next = xent_get_next_sibling(walk->ctx, node);
+		if (next != XENT_NODE_INVALID) return next;
+		node = xent_get_parent(walk->ctx, node);
+		if (node == XENT_NODE_INVALID || walk->depth == 0) break;
+
+		walk->depth--;
+		if (walk->depth == 0) walk->parent = flux_hit_mapping_identity();
+		else if (walk->depth <= HIT_WALK_MAX_DEPTH) walk->parent = walk->path [walk->depth - 1];
+		else walk->parent = hit_child_mapping_of(walk->ctx, walk->root, xent_get_parent(walk->ctx, node));
+	}
+	return XENT_NODE_INVALID;
+}
+
+/* Tree walk used when no hit index covers the root: pre-order, descending only
+ * into nodes that contain the point. Later siblings and children paint over
+ * earlier ones, so the last node that takes the point is the topmost; that
+ * needs no child list and allocates nothing. */
+static FluxHitResult hit_test_walk(XentContext *ctx, XentNodeId root, FluxPoint point) {
+	FluxHitResult best = {0};
+	HitWalk       walk = {.ctx = ctx, .root = root, .parent = flux_hit_mapping_identity()};
+	XentNodeId    node = root;
+	while (node != XENT_NODE_INVALID) {
+		XentRect       rect = {0};
+		FluxHitMapping own;
+		FluxNodeData  *nd = ( FluxNodeData * ) xent_get_userdata(ctx, node);
+		xent_get_layout_rect(ctx, node, &rect);
+		if (!hit_node_contains(nd, &rect, walk.parent, point, &own)) {
+			node = hit_walk_next(&walk, node);
+			continue;
+		}
+
+		XentNodeId child = xent_get_first_child(ctx, node);
+		if (child != XENT_NODE_INVALID || hit_node_interactive(ctx, node, nd)) {
+			FluxRect bounds = flux_hit_mapping_rect(own, (FluxRect) {rect.x, rect.y, rect.w, rect.h});
+			best            = hit_result(node, nd, bounds, own.scale, point);
+		}
+		if (child == XENT_NODE_INVALID) {
+			node = hit_walk_next(&walk, node);
+			continue;
+		}
+
+		hit_walk_descend(&walk, hit_child_mapping(ctx, node, nd, own));
+		node = child;
+	}
+	return best;
+}
+
+/* Answered from the engine's hit index (what was last drawn) when one covers
+ * @p root and no node has been destroyed since it was built. */
 static FluxHitResult input_hit_test_root(FluxInput *input, XentNodeId root, float px, float py) {
-	InputHitQuery query = {
-	  .ctx    = input->ctx,
-	  .node   = root,
-	  .point  = {px,   py  },
-	  .scroll = {0.0f, 0.0f},
-	};
-	return hit_test_recursive(&query);
+	FluxPoint           point = {px, py};
+	FluxHitEntry const *entry = NULL;
+	if (!input->hit_index_stale
+	    && flux_hit_index_query(input->hit_index, root, px, py, hit_leaf_takes_pointer, &entry))
+	{
+		if (!entry) return (FluxHitResult) {0};
+		FluxNodeData *nd = ( FluxNodeData * ) xent_get_userdata(input->ctx, entry->node);
+		return hit_result(entry->node, nd, entry->bounds, entry->scale, point);
+	}
+	return hit_test_walk(input->ctx, root, point);
 }
 
 /* A node that participates in pointer interaction: it handles presses,
@@ -133,16 +209,19 @@ static bool input_node_interactive(FluxInput *input, XentNodeId node, FluxNodeDa
 }
 
 /* Re-base a hit onto ancestor `node`, shifting bounds/local by the layout-rect
- * delta (shared scroll offsets cancel out, so the delta is scroll-correct). */
+ * delta (shared scroll offsets cancel out, so the delta is scroll-correct).
+ * Bounds are on screen, so the delta is scaled by the transform the hit was
+ * drawn under; local points stay in layout units. */
 static FluxHitResult input_rebase_hit(FluxInput *input, FluxHitResult const *hit, XentNodeId node, FluxNodeData *nd) {
 	XentRect from = {0}, to = {0};
 	xent_get_layout_rect(input->ctx, hit->node, &from);
 	xent_get_layout_rect(input->ctx, node, &to);
 	float dx = to.x - from.x, dy = to.y - from.y;
+	float s  = from.w > 0.0f ? hit->bounds.w / from.w : 1.0f;
 	return (FluxHitResult) {
 	  .node   = node,
 	  .data   = nd,
-	  .bounds = {hit->bounds.x + dx, hit->bounds.y + dy, to.w, to.h},
+	  .bounds = {hit->bounds.x + dx * s, hit->bounds.y + dy * s, to.w * s, to.h * s},
 	  .local  = {hit->local.x - dx, hit->local.y - dy},
 	};
 }
@@ -152,7 +231,7 @@ static FluxHitResult input_rebase_hit(FluxInput *input, FluxHitResult const *hit
  * belongs to the row. Resolve the hit to the nearest interactive ancestor. */
 static FluxHitResult input_resolve_interactive(FluxInput *input, FluxHitResult const *hit) {
 	for (XentNodeId node = hit->node; node != XENT_NODE_INVALID; node = xent_get_parent(input->ctx, node)) {
-		FluxNodeData *nd = flux_node_store_get(input->store, node);
+		FluxNodeData *nd = ( FluxNodeData * ) xent_get_userdata(input->ctx, node);
 		if (!input_node_interactive(input, node, nd)) continue;
 		return node == hit->node ? *hit : input_rebase_hit(input, hit, node, nd);
 	}
@@ -175,13 +254,14 @@ void input_clear_node_hover(FluxNodeData *nd) {
 	nd->state.hovered = 0;
 	nd->hover_local_x = -1.0f;
 	nd->hover_local_y = -1.0f;
-	if (was && nd->behavior.on_hover_changed) nd->behavior.on_hover_changed(nd->behavior.on_hover_changed_ctx, false);
+	if (was && nd->behavior->on_hover_changed) nd->behavior->on_hover_changed(nd->behavior->on_hover_changed_ctx, false);
 }
 
 void input_clear_hovered(FluxInput *input) {
 	if (input->hovered == XENT_NODE_INVALID) return;
 
-	FluxNodeData *old = flux_node_store_get(input->store, input->hovered);
+	FluxNodeData *old = flux_node_store_edit(input->store, input->hovered);
+	if (old && old->state.hovered && old->behavior->on_hover_changed) flux_node_store_invalidate_layout(input->store);
 	input_clear_node_hover(old);
 	input->hovered = XENT_NODE_INVALID;
 }
@@ -193,7 +273,10 @@ static void input_set_hovered_node(FluxInput *input, XentNodeId node, FluxNodeDa
 	if (node != XENT_NODE_INVALID && nd) {
 		nd->state.hovered      = 1;
 		nd->state.pointer_type = ( uint8_t ) input->pointer_type;
-		if (nd->behavior.on_hover_changed) nd->behavior.on_hover_changed(nd->behavior.on_hover_changed_ctx, true);
+		if (nd->behavior->on_hover_changed) {
+			flux_node_store_invalidate_layout(input->store); /* e.g. a tab's close button shows */
+			nd->behavior->on_hover_changed(nd->behavior->on_hover_changed_ctx, true);
+		}
 	}
 	input->hovered = node;
 }
@@ -201,14 +284,21 @@ static void input_set_hovered_node(FluxInput *input, XentNodeId node, FluxNodeDa
 static void input_update_hover_local(FluxInput *input, float px, float py) {
 	if (input->hovered == XENT_NODE_INVALID) return;
 
-	FluxNodeData *hnd = flux_node_store_get(input->store, input->hovered);
-	if (!hnd) return;
+	FluxNodeData const *cur = flux_node_store_get(input->store, input->hovered);
+	if (!cur) return;
 
+	/* Several controls draw from the hover point (split button zones, rating
+	 * stars), so a move touches the node, but only when the point changed. */
 	XentRect hrect = {0};
 	xent_get_layout_rect(input->ctx, input->hovered, &hrect);
-	hnd->hover_local_x      = px - hrect.x;
-	hnd->hover_local_y      = py - hrect.y;
-	hnd->state.pointer_type = ( uint8_t ) input->pointer_type;
+	float   lx   = px - hrect.x;
+	float   ly   = py - hrect.y;
+	uint8_t type = ( uint8_t ) input->pointer_type;
+	if (cur->hover_local_x == lx && cur->hover_local_y == ly && cur->state.pointer_type == type) return;
+	FluxNodeData *hnd       = flux_node_store_edit(input->store, input->hovered);
+	hnd->hover_local_x      = lx;
+	hnd->hover_local_y      = ly;
+	hnd->state.pointer_type = type;
 }
 
 static void input_update_hover_from_hit(FluxInput *input, FluxHitResult const *hit, float px, float py) {
@@ -222,12 +312,13 @@ static void input_update_hover_from_hit(FluxInput *input, FluxHitResult const *h
 static void input_forward_pressed_move(FluxInput *input, float px, float py) {
 	if (input->pressed == XENT_NODE_INVALID) return;
 
-	FluxNodeData *nd = flux_node_store_get(input->store, input->pressed);
-	if (!nd || !nd->behavior.on_pointer_move) return;
+	FluxNodeData *nd = flux_node_store_edit(input->store, input->pressed);
+	if (!nd || !nd->behavior->on_pointer_move) return;
 
 	float local_x = px - input->pressed_bounds.x;
 	float local_y = py - input->pressed_bounds.y;
-	nd->behavior.on_pointer_move(nd->behavior.on_pointer_move_ctx, local_x, local_y);
+	flux_node_store_invalidate_layout(input->store); /* drags may reorder or resize */
+	nd->behavior->on_pointer_move(nd->behavior->on_pointer_move_ctx, local_x, local_y);
 }
 
 static bool input_press_number_box_spin(FluxInput *input, FluxHitResult const *hit) {
@@ -241,9 +332,9 @@ static bool input_press_number_box_spin(FluxInput *input, FluxHitResult const *h
 	float spin_start = rect.w - 76.0f;
 	if (hit->local.x < spin_start) return false;
 
-	if (hit->data->behavior.on_key) {
+	if (hit->data->behavior->on_key) {
 		bool up = hit->local.x < spin_start + 40.0f;
-		hit->data->behavior.on_key(hit->data->behavior.on_key_ctx, up ? VK_UP : VK_DOWN, true);
+		hit->data->behavior->on_key(hit->data->behavior->on_key_ctx, up ? VK_UP : VK_DOWN, true);
 	}
 	return true;
 }
@@ -295,22 +386,23 @@ static void input_press_hit(FluxInput *input, FluxHitResult const *hit) {
 
 	input_set_touch_press_hover(input, hit);
 
-	if (hit->data->behavior.on_pointer_move)
-		hit->data->behavior.on_pointer_move(hit->data->behavior.on_pointer_move_ctx, hit->local.x, hit->local.y);
-	if (hit->data->behavior.on_pointer_down)
-		hit->data->behavior.on_pointer_down(
-		  hit->data->behavior.on_pointer_down_ctx, hit->local.x, hit->local.y, input->click_count
+	if (hit->data->behavior->on_pointer_move)
+		hit->data->behavior->on_pointer_move(hit->data->behavior->on_pointer_move_ctx, hit->local.x, hit->local.y);
+	if (hit->data->behavior->on_pointer_down)
+		hit->data->behavior->on_pointer_down(
+		  hit->data->behavior->on_pointer_down_ctx, hit->local.x, hit->local.y, input->click_count
 		);
 }
 
 void input_blur_focused(FluxInput *input) {
 	if (input->focused == XENT_NODE_INVALID) return;
 
-	FluxNodeData *old = flux_node_store_get(input->store, input->focused);
+	FluxNodeData *old = flux_node_store_edit(input->store, input->focused);
 	if (!old) return;
 
 	old->state.focused = 0;
-	if (old->behavior.on_blur) old->behavior.on_blur(old->behavior.on_blur_ctx);
+	flux_node_store_invalidate_layout(input->store);
+	if (old->behavior->on_blur) old->behavior->on_blur(old->behavior->on_blur_ctx);
 }
 
 static void input_focus_hit(FluxInput *input, FluxHitResult const *hit) {
@@ -318,7 +410,7 @@ static void input_focus_hit(FluxInput *input, FluxHitResult const *hit) {
 
 	FluxControlType ct = flux_get_control_type(input->ctx, hit->node);
 	if (ct == FLUX_CONTROL_TEXT_INPUT) hit->data->state.focused = 1;
-	if (hit->data->behavior.on_focus) hit->data->behavior.on_focus(hit->data->behavior.on_focus_ctx);
+	if (hit->data->behavior->on_focus) hit->data->behavior->on_focus(hit->data->behavior->on_focus_ctx);
 }
 
 static void input_update_focus_from_hit(FluxInput *input, FluxHitResult const *hit) {
@@ -333,7 +425,7 @@ static void input_cancel_pressed_node(FluxInput *input, FluxNodeData *nd) {
 	if (!nd) return;
 
 	nd->state.pressed = 0;
-	if (nd->behavior.on_cancel) nd->behavior.on_cancel(nd->behavior.on_cancel_ctx);
+	if (nd->behavior->on_cancel) nd->behavior->on_cancel(nd->behavior->on_cancel_ctx);
 	if (input->hovered == input->pressed) {
 		input_clear_node_hover(nd);
 		input->hovered = XENT_NODE_INVALID;
@@ -343,7 +435,7 @@ static void input_cancel_pressed_node(FluxInput *input, FluxNodeData *nd) {
 static void input_cancel_pressed(FluxInput *input) {
 	if (input->pressed == XENT_NODE_INVALID) return;
 
-	FluxNodeData *nd = flux_node_store_get(input->store, input->pressed);
+	FluxNodeData *nd = flux_node_store_edit(input->store, input->pressed);
 	input_cancel_pressed_node(input, nd);
 	input->pressed = XENT_NODE_INVALID;
 }
@@ -361,17 +453,17 @@ static void input_release_pressed_node(FluxInput *input, FluxNodeData *nd, XentN
 	FluxHitResult hit    = input_hit_test_root(input, root, px, py);
 	FluxHitResult target = input_resolve_interactive(input, &hit);
 	if (target.node == input->pressed) {
-		if (nd->behavior.on_click) nd->behavior.on_click(nd->behavior.on_click_ctx);
+		if (nd->behavior->on_click) nd->behavior->on_click(nd->behavior->on_click_ctx);
 		return;
 	}
 
-	if (nd->behavior.on_cancel) nd->behavior.on_cancel(nd->behavior.on_cancel_ctx);
+	if (nd->behavior->on_cancel) nd->behavior->on_cancel(nd->behavior->on_cancel_ctx);
 }
 
 static void input_release_pressed(FluxInput *input, XentNodeId root, float px, float py) {
 	if (input->pressed == XENT_NODE_INVALID) return;
 
-	FluxNodeData *nd = flux_node_store_get(input->store, input->pressed);
+	FluxNodeData *nd = flux_node_store_edit(input->store, input->pressed);
 	input_release_pressed_node(input, nd, root, px, py);
 	input->pressed = XENT_NODE_INVALID;
 }
@@ -396,11 +488,11 @@ static FluxPoint input_context_local_point(FluxInput *input, FluxHitResult const
 }
 
 static bool input_dispatch_context_menu_node(FluxInput *input, FluxHitResult const *hit, XentNodeId node) {
-	FluxNodeData *nd = flux_node_store_get(input->store, node);
-	if (!nd || !nd->behavior.on_context_menu) return false;
+	FluxNodeData *nd = flux_node_store_edit(input->store, node);
+	if (!nd || !nd->behavior->on_context_menu) return false;
 
 	FluxPoint local = input_context_local_point(input, hit, node);
-	nd->behavior.on_context_menu(nd->behavior.on_context_menu_ctx, local.x, local.y);
+	nd->behavior->on_context_menu(nd->behavior->on_context_menu_ctx, local.x, local.y);
 	return true;
 }
 
@@ -424,6 +516,12 @@ FluxInput *flux_input_create(XentContext *ctx, FluxNodeStore *store) {
 
 void          flux_input_destroy(FluxInput *input) { free(input); }
 
+void flux_input_set_hit_index(FluxInput *input, FluxHitIndex const *index) {
+	if (!input) return;
+	input->hit_index       = index;
+	input->hit_index_stale = false;
+}
+
 FluxHitResult flux_input_hit_test(FluxInput *input, XentNodeId root, float px, float py) {
 	if (!input || root == XENT_NODE_INVALID) return (FluxHitResult) {0};
 	return input_hit_test_root(input, root, px, py);
@@ -451,9 +549,9 @@ static void input_dispatch_middle_button(FluxInput *input, XentNodeId root, Flux
 	if (ev->kind != FLUX_POINTER_UP) return;
 	FluxHitResult raw = input_hit_test_root(input, root, ev->x, ev->y);
 	FluxHitResult hit = input_resolve_interactive(input, &raw);
-	if (!hit.data || !hit.data->behavior.on_middle_click) return;
+	if (!hit.data || !hit.data->behavior->on_middle_click) return;
 	if (!xent_get_semantic_enabled(input->ctx, hit.node)) return;
-	hit.data->behavior.on_middle_click(hit.data->behavior.on_middle_click_ctx);
+	hit.data->behavior->on_middle_click(hit.data->behavior->on_middle_click_ctx);
 }
 
 static void input_dispatch_button(FluxInput *input, XentNodeId root, FluxPointerEvent const *ev) {
@@ -476,6 +574,9 @@ void flux_input_dispatch(FluxInput *input, XentNodeId root, FluxPointerEvent con
 
 	input->pointer_type = ev->device;
 	input->pointer_id   = ev->pointer_id;
+	/* Anything past a plain move reaches handlers free to restyle or rebuild
+	 * the tree; moves invalidate only where a handler runs (see below). */
+	if (ev->kind != FLUX_POINTER_MOVE) flux_node_store_invalidate_layout(input->store);
 
 	switch (ev->kind) {
 	case FLUX_POINTER_DOWN         : input_dispatch_button(input, root, ev); break;
@@ -539,6 +640,7 @@ void flux_input_node_destroyed(FluxInput *input, XentNodeId node) {
 	if (!input || node == XENT_NODE_INVALID) return;
 
 	flux_dmanip_release_node_viewport(input->store, node);
+	input->hit_index_stale = true;
 
 	if (input->hovered == node) input->hovered = XENT_NODE_INVALID;
 	if (input->pressed == node) input->pressed = XENT_NODE_INVALID;
@@ -583,39 +685,54 @@ bool flux_input_take_pan_promoted(FluxInput *input) {
 	return v;
 }
 
+/* Keys reach the focused control only. One that is a layout boundary (a text
+ * box) edits inside itself, so only its subtree is laid out again; anything
+ * else may restyle its surroundings. */
+static void fi_invalidate_focused(FluxInput *input, FluxNodeData const *nd) {
+	if (nd->layout_boundary) flux_node_store_invalidate_node_layout(input->store, input->focused);
+	else flux_node_store_invalidate_layout(input->store);
+}
+
 bool flux_input_key_down(FluxInput *input, unsigned int vk) {
 	if (!input || input->focused == XENT_NODE_INVALID) return false;
-	FluxNodeData *nd = flux_node_store_get(input->store, input->focused);
-	if (!nd || !nd->behavior.on_key) return false;
-	return nd->behavior.on_key(nd->behavior.on_key_ctx, vk, true);
+	FluxNodeData *nd = flux_node_store_edit(input->store, input->focused);
+	if (!nd || !nd->behavior->on_key) return false;
+	fi_invalidate_focused(input, nd);
+	return nd->behavior->on_key(nd->behavior->on_key_ctx, vk, true);
 }
 
 void flux_input_key_up(FluxInput *input, unsigned int vk) {
 	if (!input || input->focused == XENT_NODE_INVALID) return;
-	FluxNodeData *nd = flux_node_store_get(input->store, input->focused);
-	if (nd && nd->behavior.on_key) nd->behavior.on_key(nd->behavior.on_key_ctx, vk, false);
+	FluxNodeData *nd = flux_node_store_edit(input->store, input->focused);
+	if (!nd || !nd->behavior->on_key) return;
+	fi_invalidate_focused(input, nd);
+	nd->behavior->on_key(nd->behavior->on_key_ctx, vk, false);
 }
 
 void flux_input_char(FluxInput *input, wchar_t ch) {
 	if (!input || input->focused == XENT_NODE_INVALID) return;
-	FluxNodeData *nd = flux_node_store_get(input->store, input->focused);
-	if (nd && nd->behavior.on_char) nd->behavior.on_char(nd->behavior.on_char_ctx, ch);
+	FluxNodeData *nd = flux_node_store_edit(input->store, input->focused);
+	if (!nd || !nd->behavior->on_char) return;
+	fi_invalidate_focused(input, nd);
+	nd->behavior->on_char(nd->behavior->on_char_ctx, ch);
 }
 
 int  flux_input_get_click_count(FluxInput const *input) { return input ? input->click_count : 1; }
 
 void flux_input_ime_composition(FluxInput *input, wchar_t const *text, uint32_t length, uint32_t cursor) {
 	if (!input || input->focused == XENT_NODE_INVALID) return;
-	FluxNodeData *nd = flux_node_store_get(input->store, input->focused);
-	if (nd && nd->behavior.on_ime_composition)
-		nd->behavior.on_ime_composition(nd->behavior.on_ime_composition_ctx, text, length, cursor);
+	FluxNodeData *nd = flux_node_store_edit(input->store, input->focused);
+	if (!nd || !nd->behavior->on_ime_composition) return;
+	fi_invalidate_focused(input, nd);
+	nd->behavior->on_ime_composition(nd->behavior->on_ime_composition_ctx, text, length, cursor);
 }
 
 void flux_input_ime_end(FluxInput *input) {
 	if (!input || input->focused == XENT_NODE_INVALID) return;
-	FluxNodeData *nd = flux_node_store_get(input->store, input->focused);
-	if (nd && nd->behavior.on_ime_composition)
-		nd->behavior.on_ime_composition(nd->behavior.on_ime_composition_ctx, NULL, 0, 0);
+	FluxNodeData *nd = flux_node_store_edit(input->store, input->focused);
+	if (!nd || !nd->behavior->on_ime_composition) return;
+	fi_invalidate_focused(input, nd);
+	nd->behavior->on_ime_composition(nd->behavior->on_ime_composition_ctx, NULL, 0, 0);
 }
 
 static void fi_context_menu(FluxInput *input, XentNodeId root, float px, float py) {
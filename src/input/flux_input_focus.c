@@ -65,11 +65,12 @@ static int input_next_tab_index(int current_idx, uint32_t tab_count, bool shift)
 static void input_focus_node(FluxInput *input, XentNodeId node) {
 	if (node == XENT_NODE_INVALID) return;
 
-	FluxNodeData *nd = flux_node_store_get(input->store, node);
+	FluxNodeData *nd = flux_node_store_edit(input->store, node);
 	if (!nd) return;
 
 	nd->state.focused = 1;
-	if (nd->behavior.on_focus) nd->behavior.on_focus(nd->behavior.on_focus_ctx);
+	flux_node_store_invalidate_layout(input->store);
+	if (nd->behavior->on_focus) nd->behavior->on_focus(nd->behavior->on_focus_ctx);
 }
 
 static void input_move_focus(FluxInput *input, XentNodeId node) {
@@ -145,14 +146,17 @@ void flux_input_arrow(FluxInput *input, XentNodeId root, int direction) {
 void flux_input_activate(FluxInput *input) {
 	if (!input || input->focused == XENT_NODE_INVALID) return;
 
-	FluxNodeData *nd = flux_node_store_get(input->store, input->focused);
-	if (nd && nd->behavior.on_click) nd->behavior.on_click(nd->behavior.on_click_ctx);
+	FluxNodeData *nd = flux_node_store_edit(input->store, input->focused);
+	if (!nd || !nd->behavior->on_click) return;
+	flux_node_store_invalidate_layout(input->store);
+	nd->behavior->on_click(nd->behavior->on_click_ctx);
 }
 
 void flux_input_escape(FluxInput *input) {
 	if (!input) return;
 
 	if (input->modal_root != XENT_NODE_INVALID && input->modal_escape) {
+		flux_node_store_invalidate_layout(input->store);
 		input->modal_escape(input->modal_escape_ctx);
 		return;
 	}
@@ -174,8 +178,9 @@ void flux_input_set_focus(FluxInput *input, XentNodeId node) {
 	if (input->focused != node) input_blur_focused(input);
 	input->focused   = node;
 
-	FluxNodeData *nd = flux_node_store_get(input->store, node);
+	FluxNodeData *nd = flux_node_store_edit(input->store, node);
 	if (!nd) return;
 	if (flux_get_control_type(input->ctx, node) == FLUX_CONTROL_TEXT_INPUT) nd->state.focused = 1;
-	if (nd->behavior.on_focus) nd->behavior.on_focus(nd->behavior.on_focus_ctx);
+	flux_node_store_invalidate_layout(input->store);
+	if (nd->behavior->on_focus) nd->behavior->on_focus(nd->behavior->on_focus_ctx);
 }
@@ -2,6 +2,7 @@
 #define FLUX_INPUT_INTERNAL_H
 
 #include "fluxent/flux_input.h"
+#include "render/flux_hit_index.h"
 #include "render/flux_scroll_geom.h"
 
 /** @brief Mouse scrollbar thumb-drag session (active when axis != 0). */
@@ -40,28 +41,30 @@ typedef enum FluxScrollPhase
 } FluxScrollPhase;
 
 struct FluxInput {
-	XentContext    *ctx;
-	FluxNodeStore  *store;
-	XentNodeId      hovered;
-	XentNodeId      pressed;
-	XentNodeId      focused;
-	FluxRect        pressed_bounds;
-	int             click_count;
-	ULONGLONG       last_click_time;
-	float           last_click_x;
-	float           last_click_y;
-	XentNodeId      last_click_node;
-	FluxPointerType pointer_type;
-	uint32_t        pointer_id;
-	FluxScrollDrag  scroll_drag;         /**< Mouse scrollbar thumb-drag session. */
-	FluxTouchPan    touch;               /**< Touch content-pan session. */
-	XentNodeId      scroll_hover_target; /**< Scroll node currently under the pointer. */
+	XentContext        *ctx;
+	FluxNodeStore      *store;
+	XentNodeId          hovered;
+	XentNodeId          pressed;
+	XentNodeId          focused;
+	FluxRect            pressed_bounds;
+	int                 click_count;
+	ULONGLONG           last_click_time;
+	float               last_click_x;
+	float               last_click_y;
+	XentNodeId          last_click_node;
+	FluxPointerType     pointer_type;
+	uint32_t            pointer_id;
+	FluxScrollDrag      scroll_drag;         /**< Mouse scrollbar thumb-drag session. */
+	FluxTouchPan        touch;               /**< Touch content-pan session. */
+	XentNodeId          scroll_hover_target; /**< Scroll node currently under the pointer. */
+	FluxHitIndex const *hit_index;           /**< Engine's index of the last collect, or NULL. */
+	bool                hit_index_stale;     /**< A node was destroyed since the index was set. */
 
 	/* Modal focus trap (ContentDialog): when modal_root is set, Tab navigation is
 	 * confined to its subtree and Escape invokes modal_escape instead of blurring. */
-	XentNodeId      modal_root;
-	void            (*modal_escape)(void *ctx);
-	void           *modal_escape_ctx;
+	XentNodeId          modal_root;
+	void                (*modal_escape)(void *ctx);
+	void               *modal_escape_ctx;
 };
 
 void            input_blur_focused(FluxInput *input);
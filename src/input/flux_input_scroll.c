@@ -50,7 +50,7 @@ static float input_clampf(float value, float min_value, float max_value) {
 }
 
 static FluxScrollData *input_scroll_data(FluxInput *input, XentNodeId node) {
-	FluxNodeData *nd = flux_node_store_get(input->store, node);
+	FluxNodeData *nd = flux_node_store_edit(input->store, node);
 	if (!nd || !nd->component_data) return NULL;
 	return ( FluxScrollData * ) nd->component_data;
 }
@@ -164,11 +164,12 @@ bool input_update_scroll_drag(FluxInput *input, float px, float py) {
 static void input_clear_pressed_for_pan(FluxInput *input) {
 	if (input->pressed == XENT_NODE_INVALID) return;
 
-	FluxNodeData *pnd = flux_node_store_get(input->store, input->pressed);
+	FluxNodeData *pnd = flux_node_store_edit(input->store, input->pressed);
 	if (pnd) {
 		pnd->state.pressed = 0;
 		input_clear_node_hover(pnd);
 	}
+	flux_node_store_invalidate_layout(input->store);
 
 	if (input->hovered == input->pressed) input->hovered = XENT_NODE_INVALID;
 	input->pressed = XENT_NODE_INVALID;
@@ -400,15 +401,15 @@ bool input_finish_touch_pan(FluxInput *input) {
 }
 
 static void input_dispatch_number_box_wheel(FluxNodeData *nd, float delta_y) {
-	if (!nd || !nd->state.focused || !nd->behavior.on_key) return;
-	if (delta_y > 0.0f) nd->behavior.on_key(nd->behavior.on_key_ctx, VK_UP, true);
-	if (delta_y < 0.0f) nd->behavior.on_key(nd->behavior.on_key_ctx, VK_DOWN, true);
+	if (!nd || !nd->state.focused || !nd->behavior->on_key) return;
+	if (delta_y > 0.0f) nd->behavior->on_key(nd->behavior->on_key_ctx, VK_UP, true);
+	if (delta_y < 0.0f) nd->behavior->on_key(nd->behavior->on_key_ctx, VK_DOWN, true);
 }
 
 bool input_handle_number_box_wheel(FluxInput *input, XentNodeId node, float delta_y) {
 	if (flux_get_control_type(input->ctx, node) != FLUX_CONTROL_NUMBER_BOX) return false;
 
-	FluxNodeData *nd = flux_node_store_get(input->store, node);
+	FluxNodeData *nd = flux_node_store_edit(input->store, node);
 	input_dispatch_number_box_wheel(nd, delta_y);
 	return true;
 }
@@ -1,6 +1,7 @@
 #include "fluxent/flux_tooltip.h"
 #include "fluxent/flux_graphics.h"
 #include "render/flux_render_internal.h"
+#include "runtime/flux_anim_driver.h"
 #include "runtime/flux_str.h"
 
 #include <stdlib.h>
@@ -19,16 +20,15 @@ struct FluxTooltip {
 	XentNodeId             hovered_node;
 	char const            *tooltip_text;
 	FluxRect               anchor_screen;
-	UINT_PTR               timer_id;
+	bool                   show_pending; /**< Asleep in the animation driver until the show delay passes. */
 	bool                   is_visible;
 	ULONGLONG              last_dismiss_tick;
 };
 
 static void          tooltip_show(FluxTooltip *tt);
 static void          tooltip_hide(FluxTooltip *tt);
-static void          tooltip_start_timer(FluxTooltip *tt, UINT delay_ms);
+static void          tooltip_start_timer(FluxTooltip *tt, unsigned long delay_ms);
 static void          tooltip_kill_timer(FluxTooltip *tt);
-static void CALLBACK tooltip_timer_proc(HWND hwnd, UINT msg, UINT_PTR id, DWORD elapsed);
 static void          tooltip_paint(void *ctx, FluxPopup *popup);
 
 FluxTooltip         *flux_tooltip_create(FluxWindow *owner) {
@@ -115,8 +115,8 @@ void flux_tooltip_on_hover(FluxTooltip *tt, XentNodeId hovered, FluxNodeData con
 	 * sub-region and re-evaluate on every hover update; plain nodes use tooltip_text. */
 	char const *new_text = NULL;
 	if (nd) {
-		if (nd->behavior.tooltip_at)
-			new_text = nd->behavior.tooltip_at(nd->behavior.tooltip_at_ctx, nd->hover_local_x, nd->hover_local_y);
+		if (nd->behavior->tooltip_at)
+			new_text = nd->behavior->tooltip_at(nd->behavior->tooltip_at_ctx, nd->hover_local_x, nd->hover_local_y);
 		else if (nd->tooltip_text && nd->tooltip_text [0])
 			new_text = nd->tooltip_text;
 	}
@@ -191,29 +191,26 @@ static void tooltip_hide(FluxTooltip *tt) {
 	tt->last_dismiss_tick = GetTickCount64();
 }
 
-static void tooltip_start_timer(FluxTooltip *tt, UINT delay_ms) {
-	tooltip_kill_timer(tt);
-	HWND hwnd = flux_window_hwnd(tt->owner);
-	if (!hwnd) return;
-	tt->timer_id = SetTimer(hwnd, ( UINT_PTR ) tt, delay_ms, tooltip_timer_proc);
+/* The show delay sleeps in the animation driver, so a pending tooltip costs
+ * no frames and shows on the first frame after the delay. */
+static bool tooltip_show_step(void *ctx, unsigned long now_ms) {
+	( void ) now_ms;
+	FluxTooltip *tt  = ( FluxTooltip * ) ctx;
+	tt->show_pending = false;
+	if (tt->tooltip_text && !tt->is_visible) tooltip_show(tt);
+	return false;
 }
 
-static void tooltip_kill_timer(FluxTooltip *tt) {
-	if (!tt->timer_id) return;
-	HWND hwnd = flux_window_hwnd(tt->owner);
-	if (hwnd) KillTimer(hwnd, tt->timer_id);
-	tt->timer_id = 0;
+static void tooltip_start_timer(FluxTooltip *tt, unsigned long delay_ms) {
+	tooltip_kill_timer(tt);
+	tt->show_pending = true;
+	flux_anim_sleep_until(tt, tooltip_show_step, flux_anim_now() + delay_ms);
 }
 
-static void CALLBACK tooltip_timer_proc(HWND hwnd, UINT msg, UINT_PTR id, DWORD elapsed) {
-	( void ) hwnd;
-	( void ) msg;
-	( void ) elapsed;
-
-	FluxTooltip *tt = ( FluxTooltip * ) id;
-	if (!tt || tt->timer_id != id) return;
-	tooltip_kill_timer(tt);
-	if (tt->tooltip_text && !tt->is_visible) tooltip_show(tt);
+static void tooltip_kill_timer(FluxTooltip *tt) {
+	if (!tt->show_pending) return;
+	flux_anim_unregister(tt);
+	tt->show_pending = false;
 }
 
 static void tooltip_ensure_brush(FluxTooltip *tt, ID2D1DeviceContext *d2d) {
@@ -229,13 +229,6 @@ static bool inline flux_color_tween_update(
 	return tw->active;
 }
 
-typedef struct FluxTweenChannels {
-	FluxTween *hover;
-	FluxTween *press;
-	FluxTween *focus;
-	FluxTween *check;
-} FluxTweenChannels;
-
 typedef struct FluxTweenTargets {
 	bool hover;
 	bool press;
@@ -243,19 +236,40 @@ typedef struct FluxTweenTargets {
 	bool check;
 } FluxTweenTargets;
 
+/* A channel at rest on its target is the common case; it skips the call. */
+static bool inline flux_tween_update_channel(
+  FluxRenderCache *cache, FluxCacheEntry *ce, FluxTweenProp prop, FluxTween const *tw, float target, double duration,
+  double now
+) {
+	if (tw->initialized && !tw->active && fabsf(target - tw->target) <= FLUX_ANIM_EPS) return false;
+	float v;
+	return flux_render_cache_tween(cache, ce, prop, target, duration, now, &v);
+}
+
 /**
- * @brief Update the four standard animation channels for a control.
+ * @brief Update the four standard animation channels of a cache entry.
  *
- * Each channel honors its `easing` field; when unset the per-channel
- * default (ease-out-quad) is used by `flux_tween_update`.
+ * Goes through flux_render_cache_tween(), so channels in flight are read as
+ * this frame's batched pass left them. Each channel honors its `easing`
+ * field; when unset the default (ease-out-quad) is used.
  */
-static bool inline flux_tween_update_states(FluxTweenChannels const *channels, FluxTweenTargets targets, double now) {
-	bool  active = false;
-	float v;
-	active |= flux_tween_update(channels->hover, targets.hover ? 1.0f : 0.0f, FLUX_ANIM_DURATION_NORMAL, now, &v);
-	active |= flux_tween_update(channels->press, targets.press ? 1.0f : 0.0f, FLUX_ANIM_DURATION_PRESS, now, &v);
-	active |= flux_tween_update(channels->focus, targets.focus ? 1.0f : 0.0f, FLUX_ANIM_DURATION_NORMAL, now, &v);
-	active |= flux_tween_update(channels->check, targets.check ? 1.0f : 0.0f, FLUX_ANIM_DURATION_FAST, now, &v);
+static bool inline flux_tween_update_states(
+  FluxRenderCache *cache, FluxCacheEntry *ce, FluxTweenTargets targets, double now
+) {
+	if (!ce) return false;
+	bool active = false;
+	active |= flux_tween_update_channel(
+	  cache, ce, FLUX_TWEEN_HOVER, &ce->hover_anim, targets.hover ? 1.0f : 0.0f, FLUX_ANIM_DURATION_NORMAL, now
+	);
+	active |= flux_tween_update_channel(
+	  cache, ce, FLUX_TWEEN_PRESS, &ce->press_anim, targets.press ? 1.0f : 0.0f, FLUX_ANIM_DURATION_PRESS, now
+	);
+	active |= flux_tween_update_channel(
+	  cache, ce, FLUX_TWEEN_FOCUS, &ce->focus_anim, targets.focus ? 1.0f : 0.0f, FLUX_ANIM_DURATION_NORMAL, now
+	);
+	active |= flux_tween_update_channel(
+	  cache, ce, FLUX_TWEEN_CHECK, &ce->check_anim, targets.check ? 1.0f : 0.0f, FLUX_ANIM_DURATION_FAST, now
+	);
 	return active;
 }
 
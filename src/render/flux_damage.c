@@ -0,0 +1,407 @@
+#include "fluxent/flux_damage.h"
+#include "flux_damage_tracker.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static float damage_minf(float a, float b) { return a < b ? a : b; }
+
+static float damage_maxf(float a, float b) { return a > b ? a : b; }
+
+static bool  damage_rect_empty(FluxRect const *r) { return !(r->w > 0.0f) || !(r->h > 0.0f); }
+
+static bool  damage_rect_overlaps(FluxRect const *a, FluxRect const *b) {
+	return a->x < b->x + b->w && b->x < a->x + a->w && a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+static bool damage_rect_contains(FluxRect const *outer, FluxRect const *inner) {
+	return inner->x >= outer->x && inner->y >= outer->y && inner->x + inner->w <= outer->x + outer->w
+	    && inner->y + inner->h <= outer->y + outer->h;
+}
+
+static FluxRect damage_rect_union(FluxRect const *a, FluxRect const *b) {
+	float l = damage_minf(a->x, b->x);
+	float t = damage_minf(a->y, b->y);
+	float r = damage_maxf(a->x + a->w, b->x + b->w);
+	float u = damage_maxf(a->y + a->h, b->y + b->h);
+	return (FluxRect) {l, t, r - l, u - t};
+}
+
+static FluxRect damage_rect_intersect(FluxRect const *a, FluxRect const *b) {
+	float l = damage_maxf(a->x, b->x);
+	float t = damage_maxf(a->y, b->y);
+	float r = damage_minf(a->x + a->w, b->x + b->w);
+	float u = damage_minf(a->y + a->h, b->y + b->h);
+	if (r <= l || u <= t) return (FluxRect) {0};
+	return (FluxRect) {l, t, r - l, u - t};
+}
+
+void flux_damage_clear(FluxDamageRegion *region) {
+	if (!region) return;
+	region->count = 0;
+	region->full  = false;
+}
+
+void flux_damage_set_full(FluxDamageRegion *region) {
+	if (!region) return;
+	region->count = 0;
+	region->full  = true;
+}
+
+bool flux_damage_is_empty(FluxDamageRegion const *region) { return !region || (!region->full && region->count == 0); }
+
+/* Folding a rect into an entry can make that entry overlap others; keep
+ * merging until the list is pairwise disjoint again. */
+static void damage_coalesce(FluxDamageRegion *region, uint32_t grown) {
+	for (uint32_t i = 0; i < region->count;) {
+		if (i == grown || !damage_rect_overlaps(&region->rects [i], &region->rects [grown])) {
+			i++;
+			continue;
+		}
+		region->rects [grown] = damage_rect_union(&region->rects [grown], &region->rects [i]);
+		region->rects [i]     = region->rects [--region->count];
+		if (grown == region->count) grown = i;
+		i = 0;
+	}
+}
+
+static uint32_t damage_cheapest_merge(FluxDamageRegion const *region, FluxRect const *rect) {
+	uint32_t best      = 0;
+	float    best_cost = INFINITY;
+	for (uint32_t i = 0; i < region->count; i++) {
+		FluxRect const *r    = &region->rects [i];
+		FluxRect        u    = damage_rect_union(r, rect);
+		float           cost = u.w * u.h - r->w * r->h;
+		if (cost < best_cost) {
+			best_cost = cost;
+			best      = i;
+		}
+	}
+	return best;
+}
+
+void flux_damage_add(FluxDamageRegion *region, FluxRect rect) {
+	if (!region || region->full || damage_rect_empty(&rect)) return;
+
+	for (uint32_t i = 0; i < region->count; i++) {
+		if (damage_rect_contains(&region->rects [i], &rect)) return;
+		if (!damage_rect_overlaps(&region->rects [i], &rect)) continue;
+		region->rects [i] = damage_rect_union(&region->rects [i], &rect);
+		damage_coalesce(region, i);
+		return;
+	}
+
+	if (region->count < FLUX_DAMAGE_MAX_RECTS) {
+		region->rects [region->count++] = rect;
+		return;
+	}
+
+	uint32_t target        = damage_cheapest_merge(region, &rect);
+	region->rects [target] = damage_rect_union(&region->rects [target], &rect);
+	damage_coalesce(region, target);
+}
+
+void flux_damage_union(FluxDamageRegion *dst, FluxDamageRegion const *src) {
+	if (!dst || !src) return;
+	if (src->full) {
+		flux_damage_set_full(dst);
+		return;
+	}
+	for (uint32_t i = 0; i < src->count; i++) flux_damage_add(dst, src->rects [i]);
+}
+
+bool flux_damage_intersects(FluxDamageRegion const *region, FluxRect const *rect) {
+	if (!region || !rect) return false;
+	if (region->full) return true;
+	for (uint32_t i = 0; i < region->count; i++)
+		if (damage_rect_overlaps(&region->rects [i], rect)) return true;
+	return false;
+}
+
+float flux_damage_area(FluxDamageRegion const *region) {
+	if (!region) return 0.0f;
+	float area = 0.0f;
+	for (uint32_t i = 0; i < region->count; i++) area += region->rects [i].w * region->rects [i].h;
+	return area;
+}
+
+void flux_damage_snap(FluxDamageRegion *region, FluxRect bounds, float scale) {
+	if (!region || region->full || scale <= 0.0f) return;
+
+	FluxDamageRegion snapped;
+	flux_damage_clear(&snapped);
+	for (uint32_t i = 0; i < region->count; i++) {
+		FluxRect r = damage_rect_intersect(&region->rects [i], &bounds);
+		if (damage_rect_empty(&r)) continue;
+		float l = floorf(r.x * scale) / scale;
+		float t = floorf(r.y * scale) / scale;
+		float u = ceilf((r.x + r.w) * scale) / scale;
+		float b = ceilf((r.y + r.h) * scale) / scale;
+		flux_damage_add(&snapped, (FluxRect) {l, t, u - l, b - t});
+	}
+	*region = snapped;
+}
+
+/* ---- tracker ---------------------------------------------------------- */
+
+typedef struct DamageItem {
+	uint64_t key;
+	uint64_t hash;
+	FluxRect rect;
+	bool     animating;
+} DamageItem;
+
+typedef struct DamageItemList {
+	DamageItem *items;
+	uint32_t    count;
+	uint32_t    capacity;
+} DamageItemList;
+
+/* Affine state is a uniform scale plus translation: every transform the
+ * engine emits (scroll translate, pivot scale, slide translate) composes
+ * into that shape, so a full 3x2 matrix is unnecessary. */
+typedef struct DamageFrame {
+	float    scale;
+	float    tx;
+	float    ty;
+	float    opacity;
+	FluxRect clip;
+} DamageFrame;
+
+struct FluxDamageTracker {
+	DamageItemList cur;
+	DamageItemList prev;
+	DamageFrame    stack [FLUX_DAMAGE_MAX_DEPTH];
+	uint32_t       top;
+	uint32_t       clamped; /**< Pushes past FLUX_DAMAGE_MAX_DEPTH folded into the top frame. */
+	uint32_t      *index;      /**< Open-addressed key → prev item slot (UINT32_MAX = empty). */
+	uint32_t       index_cap;  /**< Slots allocated; may exceed the slots in use. */
+	uint32_t       index_mask; /**< Slots in use this frame, minus one; build and lookup share it. */
+	bool          *matched;
+	uint32_t       matched_cap;
+	bool           prev_valid;
+};
+
+#define DAMAGE_INDEX_EMPTY UINT32_MAX
+
+static DamageFrame damage_root_frame(void) {
+	DamageFrame f;
+	f.scale   = 1.0f;
+	f.tx      = 0.0f;
+	f.ty      = 0.0f;
+	f.opacity = 1.0f;
+	f.clip    = (FluxRect) {-1.0e9f, -1.0e9f, 2.0e9f, 2.0e9f};
+	return f;
+}
+
+static FluxRect damage_map(DamageFrame const *f, FluxRect const *r) {
+	return (FluxRect) {r->x * f->scale + f->tx, r->y * f->scale + f->ty, r->w * f->scale, r->h * f->scale};
+}
+
+FluxDamageTracker *flux_damage_tracker_create(void) {
+	FluxDamageTracker *t = ( FluxDamageTracker * ) calloc(1, sizeof(*t));
+	if (!t) return NULL;
+	t->stack [0] = damage_root_frame();
+	return t;
+}
+
+void flux_damage_tracker_destroy(FluxDamageTracker *t) {
+	if (!t) return;
+	free(t->cur.items);
+	free(t->prev.items);
+	free(t->index);
+	free(t->matched);
+	free(t);
+}
+
+void flux_damage_tracker_invalidate(FluxDamageTracker *t) {
+	if (t) t->prev_valid = false;
+}
+
+void flux_damage_tracker_begin(FluxDamageTracker *t) {
+	if (!t) return;
+	DamageItemList swap = t->prev;
+	t->prev             = t->cur;
+	t->cur              = swap;
+	t->cur.count        = 0;
+	t->top              = 0;
+	t->clamped          = 0;
+	t->stack [0]        = damage_root_frame();
+}
+
+static DamageFrame *damage_push(FluxDamageTracker *t) {
+	if (t->top + 1 >= FLUX_DAMAGE_MAX_DEPTH) {
+		t->clamped++;
+		return NULL;
+	}
+	t->stack [t->top + 1] = t->stack [t->top];
+	return &t->stack [++t->top];
+}
+
+void flux_damage_tracker_push_clip(FluxDamageTracker *t, FluxRect bounds, float scroll_x, float scroll_y) {
+	if (!t) return;
+	DamageFrame *f = damage_push(t);
+	if (!f) return;
+	FluxRect screen  = damage_map(f, &bounds);
+	f->clip          = damage_rect_intersect(&f->clip, &screen);
+	f->tx           -= scroll_x * f->scale;
+	f->ty           -= scroll_y * f->scale;
+}
+
+void flux_damage_tracker_push_transform(FluxDamageTracker *t, FluxDamageTransform const *xf) {
+	if (!t || !xf) return;
+	DamageFrame *f = damage_push(t);
+	if (!f) return;
+	if (xf->clip_subtree) {
+		FluxRect screen = damage_map(f, &xf->bounds);
+		f->clip         = damage_rect_intersect(&f->clip, &screen);
+	}
+	/* x' = x * s + pivot * (1 - s) + translate, then the parent's mapping. */
+	float s     = xf->scale;
+	float cx    = xf->pivot_x * (1.0f - s) + xf->translate_x;
+	float cy    = xf->pivot_y * (1.0f - s) + xf->translate_y;
+	f->tx       = cx * f->scale + f->tx;
+	f->ty       = cy * f->scale + f->ty;
+	f->scale   *= s;
+	f->opacity *= xf->opacity;
+}
+
+void flux_damage_tracker_pop(FluxDamageTracker *t) {
+	if (!t) return;
+	if (t->clamped > 0) t->clamped--;
+	else if (t->top > 0) t->top--;
+}
+
+static bool damage_list_reserve(DamageItemList *list, uint32_t needed) {
+	if (needed <= list->capacity) return true;
+	uint32_t new_cap = list->capacity ? list->capacity : 256;
+	while (new_cap < needed) new_cap *= 2;
+	DamageItem *items = ( DamageItem * ) realloc(list->items, sizeof(DamageItem) * new_cap);
+	if (!items) return false;
+	list->items    = items;
+	list->capacity = new_cap;
+	return true;
+}
+
+void flux_damage_tracker_record(FluxDamageTracker *t, uint64_t key, uint64_t hash, FluxRect bounds) {
+	if (!t) return;
+	if (!damage_list_reserve(&t->cur, t->cur.count + 1)) {
+		/* Losing an item would leave stale pixels; fall back to a full redraw. */
+		t->prev_valid = false;
+		return;
+	}
+
+	DamageFrame const *f      = &t->stack [t->top];
+	FluxRect           screen = damage_map(f, &bounds);
+	screen.x                 -= FLUX_DAMAGE_BLEED;
+	screen.y                 -= FLUX_DAMAGE_BLEED;
+	screen.w                 += FLUX_DAMAGE_BLEED * 2.0f;
+	screen.h                 += FLUX_DAMAGE_BLEED * 2.0f;
+
+	uint32_t opacity_bits;
+	memcpy(&opacity_bits, &f->opacity, sizeof(opacity_bits));
+
+	DamageItem *item = &t->cur.items [t->cur.count++];
+	item->key        = key;
+	item->hash       = (hash ^ opacity_bits) * 0x100000001b3ull;
+	item->rect       = damage_rect_intersect(&screen, &f->clip);
+	item->animating  = false;
+}
+
+static uint32_t damage_hash_key(uint64_t key) {
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdull;
+	key ^= key >> 33;
+	return ( uint32_t ) key;
+}
+
+static bool damage_build_index(FluxDamageTracker *t) {
+	uint32_t need = 16;
+	while (need < t->prev.count * 2) need *= 2;
+	if (need > t->index_cap) {
+		uint32_t *index = ( uint32_t * ) realloc(t->index, sizeof(uint32_t) * need);
+		if (!index) return false;
+		t->index     = index;
+		t->index_cap = need;
+	}
+	if (t->prev.count > t->matched_cap) {
+		bool *matched = ( bool * ) realloc(t->matched, sizeof(bool) * t->prev.count);
+		if (!matched) return false;
+		t->matched     = matched;
+		t->matched_cap = t->prev.count;
+	}
+
+	/* The table is sized for this frame's items, not the allocation, so a
+	 * shrinking frame never probes slots it did not clear. */
+	memset(t->index, 0xff, sizeof(uint32_t) * need);
+	if (t->prev.count) memset(t->matched, 0, sizeof(bool) * t->prev.count);
+	uint32_t mask = need - 1;
+	t->index_mask = mask;
+	for (uint32_t i = 0; i < t->prev.count; i++) {
+		uint32_t slot = damage_hash_key(t->prev.items [i].key) & mask;
+		while (t->index [slot] != DAMAGE_INDEX_EMPTY) slot = (slot + 1) & mask;
+		t->index [slot] = i;
+	}
+	return true;
+}
+
+static DamageItem const *damage_find_prev(FluxDamageTracker *t, uint64_t key, uint32_t *out_index) {
+	uint32_t mask = t->index_mask;
+	uint32_t slot = damage_hash_key(key) & mask;
+	for (uint32_t probe = 0; probe <= mask; probe++) {
+		uint32_t i = t->index [slot];
+		if (i == DAMAGE_INDEX_EMPTY) return NULL;
+		if (t->prev.items [i].key == key) {
+			*out_index = i;
+			return &t->prev.items [i];
+		}
+		slot = (slot + 1) & mask;
+	}
+	return NULL;
+}
+
+static bool damage_rect_equal(FluxRect const *a, FluxRect const *b) {
+	return a->x == b->x && a->y == b->y && a->w == b->w && a->h == b->h;
+}
+
+static void damage_diff_item(FluxDamageTracker *t, DamageItem const *item, FluxDamageRegion *out) {
+	uint32_t          pi   = 0;
+	DamageItem const *prev = damage_find_prev(t, item->key, &pi);
+	if (!prev) {
+		flux_damage_add(out, item->rect);
+		return;
+	}
+	t->matched [pi] = true;
+	if (prev->hash == item->hash && damage_rect_equal(&prev->rect, &item->rect) && !prev->animating) return;
+	flux_damage_add(out, prev->rect);
+	flux_damage_add(out, item->rect);
+}
+
+void flux_damage_tracker_finish(FluxDamageTracker *t, FluxDamageRegion *out) {
+	if (!out) return;
+	flux_damage_clear(out);
+	if (!t) return;
+
+	bool valid    = t->prev_valid;
+	t->prev_valid = true;
+	if (!valid || !damage_build_index(t)) {
+		flux_damage_set_full(out);
+		return;
+	}
+
+	for (uint32_t i = 0; i < t->cur.count && !out->full; i++) damage_diff_item(t, &t->cur.items [i], out);
+	for (uint32_t i = 0; i < t->prev.count && !out->full; i++)
+		if (!t->matched [i]) flux_damage_add(out, t->prev.items [i].rect);
+}
+
+uint32_t flux_damage_tracker_count(FluxDamageTracker const *t) { return t ? t->cur.count : 0; }
+
+FluxRect flux_damage_tracker_item_rect(FluxDamageTracker const *t, uint32_t index) {
+	if (!t || index >= t->cur.count) return (FluxRect) {0};
+	return t->cur.items [index].rect;
+}
+
+void flux_damage_tracker_mark_animating(FluxDamageTracker *t, uint32_t index) {
+	if (t && index < t->cur.count) t->cur.items [index].animating = true;
+}
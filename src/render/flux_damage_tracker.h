@@ -0,0 +1,104 @@
+/**
+ * @file flux_damage_tracker.h
+ * @brief Per-frame draw record and frame-to-frame diff for partial redraw.
+ *
+ * During collect the engine mirrors its clip/transform pushes into the tracker
+ * and records one item per draw command: a stable key, a content hash, and
+ * the command's screen-space rectangle (after scroll, scale, translate and
+ * clip). Finishing the frame diffs the items against the previous frame's by
+ * key and yields the damaged region:
+ *
+ * - new or removed items damage their rectangle;
+ * - items whose hash or rectangle changed damage both old and new rectangles;
+ * - items that requested animation frames when last drawn are re-damaged,
+ *   since their tween state lives in the render cache, not in the hash.
+ *
+ * Platform-neutral; no D2D dependency.
+ * @note This is an internal header; do not include from public API.
+ */
+#ifndef FLUX_DAMAGE_TRACKER_H
+#define FLUX_DAMAGE_TRACKER_H
+
+#include "fluxent/flux_damage.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Maximum clip/transform nesting mirrored by the tracker; deeper pushes coalesce. */
+#define FLUX_DAMAGE_MAX_DEPTH 64
+
+/**
+ * @brief Extra DIPs added around every recorded rectangle.
+ *
+ * Renderers may paint slightly outside their layout bounds (focus rings,
+ * pressed-state borders, antialiased edges); the bleed keeps those pixels
+ * inside the damaged area.
+ */
+#define FLUX_DAMAGE_BLEED     4.0f
+
+typedef struct FluxDamageTracker FluxDamageTracker;
+
+/** @brief Create an empty tracker; the first finished frame reports full damage. */
+XENT_NODISCARD FluxDamageTracker *flux_damage_tracker_create(void);
+
+/** @brief Destroy a tracker (NULL is safe). */
+void                              flux_damage_tracker_destroy(FluxDamageTracker *t);
+
+/** @brief Force the next finished frame to report full damage. */
+void                              flux_damage_tracker_invalidate(FluxDamageTracker *t);
+
+/** @brief Start recording a frame; the previous frame's items become the diff baseline. */
+void                              flux_damage_tracker_begin(FluxDamageTracker *t);
+
+/** @brief Mirror a scroll/clip push: clip to @p bounds, then translate by (-scroll_x, -scroll_y). */
+void flux_damage_tracker_push_clip(FluxDamageTracker *t, FluxRect bounds, float scroll_x, float scroll_y);
+
+/** @brief Parameters of a mirrored render-transform push (see FluxRenderCommand). */
+typedef struct FluxDamageTransform {
+	FluxRect bounds;       /**< Node bounds in parent space. */
+	float    scale;        /**< Uniform scale about (pivot_x, pivot_y). */
+	float    pivot_x;      /**< Scale pivot X. */
+	float    pivot_y;      /**< Scale pivot Y. */
+	float    translate_x;  /**< Post-scale X translate. */
+	float    translate_y;  /**< Post-scale Y translate. */
+	float    opacity;      /**< Layer opacity (folded into descendants' hashes). */
+	bool     clip_subtree; /**< Clip descendants to @ref bounds. */
+} FluxDamageTransform;
+
+/** @brief Mirror a render-transform push. */
+void     flux_damage_tracker_push_transform(FluxDamageTracker *t, FluxDamageTransform const *xf);
+
+/** @brief Mirror a clip or transform pop. */
+void     flux_damage_tracker_pop(FluxDamageTracker *t);
+
+/**
+ * @brief Record one draw command.
+ *
+ * Items are recorded in command order, one per draw command, so an item's
+ * index doubles as the draw ordinal used by flux_damage_tracker_item_rect().
+ *
+ * @param key    Stable identity across frames (unique within a frame).
+ * @param hash   Digest of everything the command draws from.
+ * @param bounds Command bounds in the current (pre-transform) space.
+ */
+void     flux_damage_tracker_record(FluxDamageTracker *t, uint64_t key, uint64_t hash, FluxRect bounds);
+
+/** @brief Diff the recorded frame against the previous one into @p out. */
+void     flux_damage_tracker_finish(FluxDamageTracker *t, FluxDamageRegion *out);
+
+/** @brief Number of items recorded this frame. */
+uint32_t flux_damage_tracker_count(FluxDamageTracker const *t);
+
+/** @brief Screen rectangle of item @p index (empty rect when clipped away or out of range). */
+FluxRect flux_damage_tracker_item_rect(FluxDamageTracker const *t, uint32_t index);
+
+/** @brief Note that item @p index requested another animation frame when drawn. */
+void     flux_damage_tracker_mark_animating(FluxDamageTracker *t, uint32_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,38 +2,127 @@
 #include "fluxent/fluxent.h" /* flux_list_view_update_window */
 #include "flux_fluent.h"
 #include "flux_render_internal.h"
+#include "flux_damage_tracker.h"
+#include "flux_hit_index.h"
+#include "flux_retain.h"
+#include "flux_scroll_geom.h"
 
 #include <assert.h>
+#include <math.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <windows.h>
 
 typedef struct FluxCommandBuffer {
 	FluxRenderCommand *cmds;
+	uint64_t          *hashes; /**< Content hash per command (draws only), replayed into the damage tracker. */
 	uint32_t           count;
 	uint32_t           capacity;
 } FluxCommandBuffer;
 
+/* Side arena for draw payloads: each snapshot is stored trimmed to its base
+ * plus the union arm its type uses, so a Text node costs a fraction of the
+ * full FluxRenderSnapshot. Reset (not freed) every collect. */
+typedef struct FluxPayloadArena {
+	unsigned char *bytes;
+	uint32_t       used;
+	uint32_t       capacity;
+} FluxPayloadArena;
+
+/* Commands, payloads and subtree ranges are double-buffered: collect swaps
+ * the last frame into prev_* and splices still-valid subtrees out of it. */
 struct FluxEngine {
 	FluxNodeStore             *store;
 	FluxControlRegistry const *registry;
 	FluxCommandBuffer          commands;
+	FluxPayloadArena           payloads;
+	FluxRetainMap              retained;
+	FluxCommandBuffer          prev_commands;
+	FluxPayloadArena           prev_payloads;
+	FluxRetainMap              prev_retained;
+	XentContext               *retained_ctx;   /**< Context the retained ranges were collected from. */
+	bool                       retained_valid; /**< Cleared by flux_engine_invalidate. */
+	FluxEngineStats            stats;
+	FluxDamageTracker         *damage;                    /**< Draw records of this and the previous collect. */
+	FluxDamageRegion           frame_damage;              /**< Screen area changed by the last collect. */
+	FluxHitIndex              *hit_index;                 /**< Pointer lookup over the last collect's draws. */
 	uint32_t                   transform_overflow_count;  /**< Bumped each time a clip/transform push is clamped. */
 	uint32_t                   transform_overflow_logged; /**< Non-zero after first OutputDebugStringA notice. */
 };
 
-static bool flux_command_buffer_push(FluxCommandBuffer *buf, FluxRenderCommand const *cmd) {
-	if (buf->count == buf->capacity) {
-		uint32_t           new_cap  = buf->capacity ? buf->capacity * 2 : FLUX_RENDER_COMMAND_INITIAL_CAPACITY;
-		FluxRenderCommand *new_cmds = ( FluxRenderCommand * ) realloc(buf->cmds, sizeof(FluxRenderCommand) * new_cap);
-		if (!new_cmds) return false;
-		buf->cmds     = new_cmds;
-		buf->capacity = new_cap;
-	}
+static bool flux_command_buffer_reserve(FluxCommandBuffer *buf, uint32_t extra) {
+	if (buf->count + extra <= buf->capacity) return true;
+	uint32_t new_cap = buf->capacity ? buf->capacity : FLUX_RENDER_COMMAND_INITIAL_CAPACITY;
+	while (new_cap < buf->count + extra) new_cap *= 2;
+	FluxRenderCommand *new_cmds = ( FluxRenderCommand * ) realloc(buf->cmds, sizeof(FluxRenderCommand) * new_cap);
+	if (!new_cmds) return false;
+	buf->cmds          = new_cmds;
+	uint64_t *new_hash = ( uint64_t * ) realloc(buf->hashes, sizeof(uint64_t) * new_cap);
+	if (!new_hash) return false;
+	buf->hashes   = new_hash;
+	buf->capacity = new_cap;
+	return true;
+}
+
+static bool flux_command_buffer_push(FluxCommandBuffer *buf, FluxRenderCommand const *cmd, uint64_t hash) {
+	if (!flux_command_buffer_reserve(buf, 1)) return false;
+	buf->hashes [buf->count] = hash;
 	buf->cmds [buf->count++] = *cmd;
 	return true;
 }
 
+static void flux_command_buffer_free(FluxCommandBuffer *buf) {
+	free(buf->cmds);
+	free(buf->hashes);
+}
+
+static uint32_t flux_payload_align(uint32_t offset) {
+	return (offset + FLUX_RENDER_PAYLOAD_ALIGN - 1) & ~(FLUX_RENDER_PAYLOAD_ALIGN - 1);
+}
+
+static bool flux_payload_arena_reserve(FluxPayloadArena *arena, uint32_t end) {
+	if (end <= arena->capacity) return true;
+	uint32_t new_cap = arena->capacity ? arena->capacity : FLUX_RENDER_PAYLOAD_INITIAL_CAPACITY;
+	while (new_cap < end) new_cap *= 2;
+	unsigned char *new_bytes = ( unsigned char * ) realloc(arena->bytes, new_cap);
+	if (!new_bytes) return false;
+	arena->bytes    = new_bytes;
+	arena->capacity = new_cap;
+	return true;
+}
+
+static uint32_t flux_payload_arena_push(FluxPayloadArena *arena, FluxRenderSnapshot const *snap) {
+	uint32_t size   = ( uint32_t ) flux_snapshot_payload_size(snap->type);
+	uint32_t offset = flux_payload_align(arena->used);
+	if (!flux_payload_arena_reserve(arena, offset + size)) return FLUX_RENDER_NO_PAYLOAD;
+	memcpy(arena->bytes + offset, snap, size);
+	arena->used = offset + size;
+	return offset;
+}
+
+/* Node id of a payload (the snapshot's leading field) without a full decode. */
+static XentNodeId flux_payload_arena_node(FluxPayloadArena const *arena, uint32_t offset) {
+	if (offset == FLUX_RENDER_NO_PAYLOAD || offset >= arena->used) return XENT_NODE_INVALID;
+	uint64_t id;
+	memcpy(&id, arena->bytes + offset + offsetof(FluxRenderSnapshot, id), sizeof(id));
+	return ( XentNodeId ) id;
+}
+
+/* Expands a trimmed payload back into a full snapshot. The bytes past the
+ * type's arm are zeroed, so a renderer that strays outside its arm reads
+ * zeros rather than a previous frame's stack. */
+static bool flux_payload_arena_decode(FluxPayloadArena const *arena, uint32_t offset, FluxRenderSnapshot *out) {
+	if (offset == FLUX_RENDER_NO_PAYLOAD || offset >= arena->used) return false;
+	FluxControlType type;
+	memcpy(&type, arena->bytes + offset + offsetof(FluxRenderSnapshot, type), sizeof(type));
+	size_t size = flux_snapshot_payload_size(type);
+	if (size > arena->used - offset) return false;
+	memcpy(out, arena->bytes + offset, size);
+	memset(( unsigned char * ) out + size, 0, sizeof(*out) - size);
+	return true;
+}
+
 static FluxControlState flux_compute_control_state(XentContext *ctx, XentNodeId node, FluxNodeData const *nd) {
 	FluxControlState s = {0};
 	s.enabled          = xent_get_semantic_enabled(ctx, node);
@@ -47,6 +136,10 @@ static FluxControlState flux_compute_control_state(XentContext *ctx, XentNodeId
 
 typedef struct CollectFrame {
 	XentNodeId         node;
+	uint32_t           cmd_start;  /**< First command of this subtree. */
+	uint32_t           generation; /**< Node's subtree generation before its hooks ran. */
+	bool               has_data;   /**< Node has store data (a generation), so its range can be retained. */
+	bool               pinned;     /**< Subtree contains a volatile node; never retained. */
 	float              abs_x;
 	float              abs_y;
 	bool               main_emitted;
@@ -57,7 +150,9 @@ typedef struct CollectFrame {
 	float              viewport_w;
 	float              viewport_h;
 	FluxRenderSnapshot snapshot;
+	uint32_t           payload; /**< Arena offset of @ref snapshot, shared by the main and overlay commands. */
 	FluxControlState   state;
+	uint64_t           content_hash; /**< Snapshot + state digest shared by the main and overlay records. */
 	XentNodeId         current_child;
 	bool               has_transform; /**< Subtree wrapped in a render transform (scale/opacity). */
 } CollectFrame;
@@ -74,7 +169,7 @@ static FluxRenderCommand
 collect_make_draw_command(CollectFrame const *frame, XentRect const *rect, FluxCommandPhase phase) {
 	FluxRenderCommand cmd;
 	memset(&cmd, 0, sizeof(cmd));
-	cmd.snapshot    = frame->snapshot;
+	cmd.payload     = frame->payload;
 	cmd.bounds.x    = frame->abs_x;
 	cmd.bounds.y    = frame->abs_y;
 	cmd.bounds.w    = rect->w;
@@ -85,25 +180,59 @@ collect_make_draw_command(CollectFrame const *frame, XentRect const *rect, FluxC
 	return cmd;
 }
 
+/* Every draw command gets exactly one damage record, in command order, so
+ * execute can walk records alongside commands without an explicit index. */
+static void collect_record_draw(FluxEngine *eng, XentNodeId node, uint64_t hash, FluxRenderCommand const *cmd) {
+	uint64_t key = (( uint64_t ) node << 1) | (cmd->phase == FLUX_PHASE_OVERLAY ? 1u : 0u);
+	flux_damage_tracker_record(eng->damage, key, hash, cmd->bounds);
+}
+
+/* The scroll overlay only reacts to the pointer near its bars, but its record
+ * spans the whole viewport; drop the position elsewhere so moving the mouse
+ * across page content does not damage the entire page. */
+static uint64_t collect_snapshot_hash(FluxRenderSnapshot const *snap, XentRect const *rect) {
+	if (snap->type != FLUX_CONTROL_SCROLL) return flux_snapshot_hash(snap);
+	float dx = rect->w - snap->u.scroll.mouse_local_x;
+	float dy = rect->h - snap->u.scroll.mouse_local_y;
+	bool  near_bar = dx < FLUX_SCROLLBAR_HOVER_EDGE || dy < FLUX_SCROLLBAR_HOVER_EDGE;
+	if (snap->u.scroll.mouse_over && near_bar) return flux_snapshot_hash(snap);
+
+	FluxRenderSnapshot far;
+	memcpy(&far, snap, sizeof(far)); /* byte copy: padding feeds the hash too */
+	far.u.scroll.mouse_local_x = -1.0f;
+	far.u.scroll.mouse_local_y = -1.0f;
+	return flux_snapshot_hash(&far);
+}
+
+static uint64_t collect_content_hash(CollectFrame const *frame, XentRect const *rect) {
+	uint64_t h = collect_snapshot_hash(&frame->snapshot, rect);
+	h         ^= ( uint64_t ) frame->state.hovered | (( uint64_t ) frame->state.pressed << 8)
+	     | (( uint64_t ) frame->state.focused << 16) | (( uint64_t ) frame->state.enabled << 24)
+	     | (( uint64_t ) frame->state.pointer_type << 32);
+	return h * 0x100000001b3ull;
+}
+
 static void collect_emit_scroll_clip(FluxEngine *eng, CollectFrame *frame, XentRect const *rect) {
 	FluxRenderCommand cmd;
 	memset(&cmd, 0, sizeof(cmd));
-	cmd.bounds.x        = frame->abs_x;
-	cmd.bounds.y        = frame->abs_y;
-	cmd.bounds.w        = rect->w;
-	cmd.bounds.h        = rect->h;
-	cmd.phase           = FLUX_PHASE_MAIN;
-	cmd.clip_action     = FLUX_CLIP_PUSH;
+	cmd.bounds.x         = frame->abs_x;
+	cmd.bounds.y         = frame->abs_y;
+	cmd.bounds.w         = rect->w;
+	cmd.bounds.h         = rect->h;
+	cmd.phase            = FLUX_PHASE_MAIN;
+	cmd.clip_action      = FLUX_CLIP_PUSH;
+	cmd.payload          = FLUX_RENDER_NO_PAYLOAD;
 	/* Children are laid out in rebased physical space; translate and cull by
 	 * the residual, not the logical position (virtualized rebase; origin=0
 	 * for plain scrolls). */
-	cmd.scroll_x        = frame->snapshot.u.scroll.x - frame->snapshot.u.scroll.origin_x;
-	cmd.scroll_y        = frame->snapshot.u.scroll.y - frame->snapshot.u.scroll.origin_y;
-	frame->scroll_off_x = cmd.scroll_x;
-	frame->scroll_off_y = cmd.scroll_y;
-	frame->viewport_w   = rect->w;
-	frame->viewport_h   = rect->h;
-	flux_command_buffer_push(&eng->commands, &cmd);
+	cmd.op.clip.scroll_x = frame->snapshot.u.scroll.x - frame->snapshot.u.scroll.origin_x;
+	cmd.op.clip.scroll_y = frame->snapshot.u.scroll.y - frame->snapshot.u.scroll.origin_y;
+	frame->scroll_off_x  = cmd.op.clip.scroll_x;
+	frame->scroll_off_y  = cmd.op.clip.scroll_y;
+	frame->viewport_w    = rect->w;
+	frame->viewport_h    = rect->h;
+	flux_command_buffer_push(&eng->commands, &cmd, 0);
+	flux_damage_tracker_push_clip(eng->damage, cmd.bounds, cmd.op.clip.scroll_x, cmd.op.clip.scroll_y);
 }
 
 /* Plain axis-aligned clip of a node's children to its rect (no scroll translate,
@@ -114,25 +243,79 @@ static void collect_emit_clip(FluxEngine *eng, CollectFrame const *frame, XentRe
 	memset(&cmd, 0, sizeof(cmd));
 	cmd.phase       = FLUX_PHASE_MAIN;
 	cmd.clip_action = FLUX_CLIP_PUSH;
+	cmd.payload     = FLUX_RENDER_NO_PAYLOAD;
 	cmd.bounds      = (FluxRect) {frame->abs_x, frame->abs_y, rect->w, rect->h};
-	flux_command_buffer_push(&eng->commands, &cmd);
+	flux_command_buffer_push(&eng->commands, &cmd, 0);
+	flux_damage_tracker_push_clip(eng->damage, cmd.bounds, 0.0f, 0.0f);
+}
+
+static void collect_track_transform(FluxEngine *eng, FluxRenderCommand const *cmd) {
+	FluxTransformParams const *tp = &cmd->op.transform;
+	FluxDamageTransform        xf;
+	xf.bounds       = cmd->bounds;
+	xf.scale        = tp->scale;
+	xf.pivot_x      = tp->pivot_x;
+	xf.pivot_y      = tp->pivot_y;
+	xf.translate_x  = tp->translate_x;
+	xf.translate_y  = tp->translate_y;
+	xf.opacity      = tp->opacity;
+	xf.clip_subtree = tp->clip_subtree;
+	flux_damage_tracker_push_transform(eng->damage, &xf);
+}
+
+static bool collect_has_transform(FluxNodeData const *nd) {
+	return nd
+	    && (nd->render_scale != 1.0f || nd->render_opacity < 1.0f || nd->render_translate_y != 0.0f
+	        || nd->render_translate_x != 0.0f);
+}
+
+/* Types whose snapshot reads state outside their own node (owner data, shared
+ * selection, sibling hover, text-buffer sync) or that run a sync hook every
+ * collect. They are rebuilt every frame, and so is every ancestor, since an
+ * ancestor's range contains them. */
+static bool collect_type_volatile(FluxControlType type) {
+	switch (type) {
+	case FLUX_CONTROL_SCROLL            :
+	case FLUX_CONTROL_FLIP_VIEW         :
+	case FLUX_CONTROL_BREADCRUMB_BAR    :
+	case FLUX_CONTROL_BREADCRUMB_ITEM   :
+	case FLUX_CONTROL_SPLIT_VIEW        :
+	case FLUX_CONTROL_TITLE_BAR         :
+	case FLUX_CONTROL_NAV_VIEW          :
+	case FLUX_CONTROL_NAV_VIEW_ITEM     :
+	case FLUX_CONTROL_TAB_VIEW_ITEM     :
+	case FLUX_CONTROL_MENU_BAR_ITEM     :
+	case FLUX_CONTROL_LIST_ITEM         :
+	case FLUX_CONTROL_TREE_ITEM         :
+	case FLUX_CONTROL_SELECTOR_BAR_ITEM :
+	case FLUX_CONTROL_TEXT_INPUT        :
+	case FLUX_CONTROL_PASSWORD_BOX      :
+	case FLUX_CONTROL_NUMBER_BOX        :
+	case FLUX_CONTROL_AUTO_SUGGEST      :
+	case FLUX_CONTROL_CUSTOM            :
+		return true;
+	default                             :
+		return xtk_is_list_type(( XtkControlType ) type);
+	}
 }
 
 static void
 collect_emit_transform_push(FluxEngine *eng, CollectFrame const *frame, XentRect const *rect, FluxNodeData const *nd) {
 	FluxRenderCommand cmd;
 	memset(&cmd, 0, sizeof(cmd));
-	cmd.phase        = FLUX_PHASE_MAIN;
-	cmd.clip_action  = FLUX_CLIP_PUSH_TRANSFORM;
-	cmd.scale        = nd->render_scale;
-	cmd.opacity      = nd->render_opacity;
-	cmd.translate_x  = nd->render_translate_x;
-	cmd.translate_y  = nd->render_translate_y;
-	cmd.pivot_x      = frame->abs_x + rect->w * 0.5f;
-	cmd.pivot_y      = frame->abs_y + rect->h * 0.5f;
-	cmd.clip_subtree = nd->render_clip_subtree;
-	cmd.bounds       = (FluxRect) {frame->abs_x, frame->abs_y, rect->w, rect->h};
-	flux_command_buffer_push(&eng->commands, &cmd);
+	cmd.phase                     = FLUX_PHASE_MAIN;
+	cmd.clip_action               = FLUX_CLIP_PUSH_TRANSFORM;
+	cmd.payload                   = FLUX_RENDER_NO_PAYLOAD;
+	cmd.op.transform.scale        = nd->render_scale;
+	cmd.op.transform.opacity      = nd->render_opacity;
+	cmd.op.transform.translate_x  = nd->render_translate_x;
+	cmd.op.transform.translate_y  = nd->render_translate_y;
+	cmd.op.transform.pivot_x      = frame->abs_x + rect->w * 0.5f;
+	cmd.op.transform.pivot_y      = frame->abs_y + rect->h * 0.5f;
+	cmd.op.transform.clip_subtree = nd->render_clip_subtree;
+	cmd.bounds                    = (FluxRect) {frame->abs_x, frame->abs_y, rect->w, rect->h};
+	flux_command_buffer_push(&eng->commands, &cmd, 0);
+	collect_track_transform(eng, &cmd);
 }
 
 /* Auto-derived scroll extent: the content size is the children's laid-out
@@ -167,7 +350,10 @@ static void collect_emit_main(FluxEngine *eng, XentContext *ctx, CollectFrame *f
 	frame->abs_x     = rect.x;
 	frame->abs_y     = rect.y;
 
-	FluxNodeData *nd = ( FluxNodeData * ) xent_get_userdata(ctx, frame->node);
+	FluxNodeData *nd  = ( FluxNodeData * ) xent_get_userdata(ctx, frame->node);
+	frame->cmd_start  = eng->commands.count;
+	frame->has_data   = nd != NULL;
+	frame->generation = nd ? nd->generation : 0;
 	collect_update_scroll_extent(ctx, frame->node, nd, &rect);
 	/* Virtualized lists: fire the re-realize hook when scrolling (or a grid
 	 * column-count change) has moved the viewport outside the realized cell
@@ -188,16 +374,19 @@ static void collect_emit_main(FluxEngine *eng, XentContext *ctx, CollectFrame *f
 		flux_title_bar_sync(ctx, frame->node, nd);
 	flux_snapshot_build(&frame->snapshot, ctx, frame->node, nd);
 	frame->state          = flux_compute_control_state(ctx, frame->node, nd);
+	frame->content_hash   = collect_content_hash(frame, &rect);
+	frame->payload        = flux_payload_arena_push(&eng->payloads, &frame->snapshot);
 	frame->is_scroll      = frame->snapshot.type == FLUX_CONTROL_SCROLL;
 	frame->clips_children = nd && nd->clips_children;
+	frame->pinned = frame->pinned || collect_type_volatile(frame->snapshot.type) || frame->payload == FLUX_RENDER_NO_PAYLOAD;
+	eng->stats.snapshots_built++;
 
-	frame->has_transform
-	  = nd
-	 && (nd->render_scale != 1.0f || nd->render_opacity < 1.0f || nd->render_translate_y != 0.0f || nd->render_translate_x != 0.0f);
+	frame->has_transform = collect_has_transform(nd);
 	if (frame->has_transform) collect_emit_transform_push(eng, frame, &rect, nd);
 
 	FluxRenderCommand cmd = collect_make_draw_command(frame, &rect, FLUX_PHASE_MAIN);
-	flux_command_buffer_push(&eng->commands, &cmd);
+	flux_command_buffer_push(&eng->commands, &cmd, frame->content_hash);
+	collect_record_draw(eng, frame->node, frame->content_hash, &cmd);
 	if (frame->is_scroll) collect_emit_scroll_clip(eng, frame, &rect);
 	else if (frame->clips_children) collect_emit_clip(eng, frame, &rect);
 
@@ -249,29 +438,197 @@ static bool collect_visit_child(CollectFrame **stack, uint32_t *stack_top, uint3
 	return true;
 }
 
+/* Only a handful of types draw above their children (scrollbars, nav pane,
+ * flip arrows, refresh indicator); everything else would emit an overlay
+ * command that dispatches to nothing. */
+static bool collect_has_overlay(FluxEngine const *eng, FluxControlType type) {
+	FluxControlRenderer const *renderer = flux_control_registry_get(eng->registry, type);
+	return renderer && renderer->draw_overlay;
+}
+
 static void collect_emit_finish(FluxEngine *eng, XentContext *ctx, CollectFrame const *frame) {
 	if (frame->is_scroll || frame->clips_children) {
 		FluxRenderCommand pop_cmd;
 		memset(&pop_cmd, 0, sizeof(pop_cmd));
 		pop_cmd.phase       = FLUX_PHASE_MAIN;
 		pop_cmd.clip_action = FLUX_CLIP_POP;
-		flux_command_buffer_push(&eng->commands, &pop_cmd);
+		pop_cmd.payload     = FLUX_RENDER_NO_PAYLOAD;
+		flux_command_buffer_push(&eng->commands, &pop_cmd, 0);
+		flux_damage_tracker_pop(eng->damage);
 	}
 
-	XentRect rect = {0};
-	xent_get_layout_rect(ctx, frame->node, &rect);
-	FluxRenderCommand overlay_cmd = collect_make_draw_command(frame, &rect, FLUX_PHASE_OVERLAY);
-	flux_command_buffer_push(&eng->commands, &overlay_cmd);
+	if (collect_has_overlay(eng, frame->snapshot.type)) {
+		XentRect rect = {0};
+		xent_get_layout_rect(ctx, frame->node, &rect);
+		FluxRenderCommand overlay_cmd = collect_make_draw_command(frame, &rect, FLUX_PHASE_OVERLAY);
+		flux_command_buffer_push(&eng->commands, &overlay_cmd, frame->content_hash);
+		collect_record_draw(eng, frame->node, frame->content_hash, &overlay_cmd);
+	}
 
 	if (frame->has_transform) {
 		FluxRenderCommand pop_cmd;
 		memset(&pop_cmd, 0, sizeof(pop_cmd));
 		pop_cmd.phase       = FLUX_PHASE_MAIN;
 		pop_cmd.clip_action = FLUX_CLIP_POP_TRANSFORM;
-		flux_command_buffer_push(&eng->commands, &pop_cmd);
+		pop_cmd.payload     = FLUX_RENDER_NO_PAYLOAD;
+		flux_command_buffer_push(&eng->commands, &pop_cmd, 0);
+		flux_damage_tracker_pop(eng->damage);
+	}
+}
+
+/* Next node after @p node in a pre-order walk confined to @p root's subtree. */
+static XentNodeId collect_next_preorder(XentContext *ctx, XentNodeId root, XentNodeId node) {
+	XentNodeId child = xent_get_first_child(ctx, node);
+	if (child != XENT_NODE_INVALID) return child;
+	for (; node != root && node != XENT_NODE_INVALID; node = xent_get_parent(ctx, node)) {
+		XentNodeId next = xent_get_next_sibling(ctx, node);
+		if (next != XENT_NODE_INVALID) return next;
+	}
+	return XENT_NODE_INVALID;
+}
+
+static bool collect_transform_matches(FluxTransformParams const *tp, FluxNodeData const *nd) {
+	return tp->scale == nd->render_scale && tp->opacity == nd->render_opacity
+	    && tp->translate_x == nd->render_translate_x && tp->translate_y == nd->render_translate_y
+	    && tp->clip_subtree == nd->render_clip_subtree;
+}
+
+/* Checks one retained main draw against the live tree: same node, same layout
+ * rect, same control state, and the same transform / clip wrapping. These can
+ * all change without going through the store, so the generation alone does
+ * not cover them. */
+static bool collect_draw_matches(FluxEngine const *eng, XentContext *ctx, XentNodeId node, uint32_t index) {
+	FluxCommandBuffer const *prev = &eng->prev_commands;
+	FluxRenderCommand const *cmd  = &prev->cmds [index];
+	if (flux_payload_arena_node(&eng->prev_payloads, cmd->payload) != node) return false;
+
+	XentRect rect = {0};
+	xent_get_layout_rect(ctx, node, &rect);
+	if (rect.x != cmd->bounds.x || rect.y != cmd->bounds.y || rect.w != cmd->bounds.w || rect.h != cmd->bounds.h)
+		return false;
+
+	FluxNodeData const *nd    = ( FluxNodeData const * ) xent_get_userdata(ctx, node);
+	FluxControlState    state = flux_compute_control_state(ctx, node, nd);
+	if (memcmp(&state, &cmd->state, sizeof(state)) != 0) return false;
+
+	/* A transform push always directly precedes its node's main draw, and a
+	 * clip push directly follows it (retained ranges hold no scroll clips). */
+	bool transformed = index > 0 && prev->cmds [index - 1].clip_action == FLUX_CLIP_PUSH_TRANSFORM;
+	if (transformed != collect_has_transform(nd)) return false;
+	if (transformed && !collect_transform_matches(&prev->cmds [index - 1].op.transform, nd)) return false;
+	bool clipped = index + 1 < prev->count && prev->cmds [index + 1].clip_action == FLUX_CLIP_PUSH;
+	return clipped == (nd && nd->clips_children);
+}
+
+/* Walks the live subtree in emission order alongside the retained main draws;
+ * any added, removed, reordered or moved node ends the walk early. */
+static bool collect_retained_matches(FluxEngine const *eng, XentContext *ctx, FluxRetainEntry const *entry) {
+	XentNodeId node = XENT_NODE_INVALID;
+	for (uint32_t i = entry->cmd_start; i < entry->cmd_start + entry->cmd_count; i++) {
+		FluxRenderCommand const *cmd = &eng->prev_commands.cmds [i];
+		if (cmd->clip_action != FLUX_CLIP_NONE || cmd->phase != FLUX_PHASE_MAIN) continue;
+		node = node == XENT_NODE_INVALID ? entry->node : collect_next_preorder(ctx, entry->node, node);
+		if (node == XENT_NODE_INVALID || !collect_draw_matches(eng, ctx, node, i)) return false;
+	}
+	return node != XENT_NODE_INVALID && collect_next_preorder(ctx, entry->node, node) == XENT_NODE_INVALID;
+}
+
+/* Spliced commands feed the damage tracker exactly as freshly collected ones
+ * would, so the frame diff and execute's record indices stay in step. */
+static void collect_replay_damage(FluxEngine *eng, uint32_t first, uint32_t count) {
+	for (uint32_t i = first; i < first + count; i++) {
+		FluxRenderCommand const *cmd = &eng->commands.cmds [i];
+		switch (cmd->clip_action) {
+		case FLUX_CLIP_PUSH           :
+			flux_damage_tracker_push_clip(eng->damage, cmd->bounds, cmd->op.clip.scroll_x, cmd->op.clip.scroll_y);
+			break;
+		case FLUX_CLIP_PUSH_TRANSFORM :
+			collect_track_transform(eng, cmd);
+			break;
+		case FLUX_CLIP_POP            :
+		case FLUX_CLIP_POP_TRANSFORM  :
+			flux_damage_tracker_pop(eng->damage);
+			break;
+		default                       :
+			collect_record_draw(
+			  eng, flux_payload_arena_node(&eng->payloads, cmd->payload), eng->commands.hashes [i], cmd
+			);
+			break;
+		}
+	}
+}
+
+/* Re-registers the ranges nested in a spliced one at their new offsets so a
+ * later change to the root alone still lets its children be reused. */
+static void collect_carry_entries(FluxEngine *eng, FluxRetainEntry const *entry, uint32_t cmd_delta, uint32_t payload_delta) {
+	uint32_t end = entry->cmd_start + entry->cmd_count;
+	for (uint32_t i = entry->cmd_start; i < end; i++) {
+		FluxRenderCommand const *cmd = &eng->prev_commands.cmds [i];
+		if (cmd->clip_action != FLUX_CLIP_NONE || cmd->phase != FLUX_PHASE_MAIN) continue;
+		XentNodeId             node  = flux_payload_arena_node(&eng->prev_payloads, cmd->payload);
+		FluxRetainEntry const *inner = flux_retain_map_find(&eng->prev_retained, node);
+		if (!inner || inner->cmd_start < entry->cmd_start || inner->cmd_start + inner->cmd_count > end) continue;
+
+		FluxRetainEntry moved  = *inner;
+		moved.cmd_start       += cmd_delta;
+		moved.payload_start   += payload_delta;
+		moved.payload_end     += payload_delta;
+		flux_retain_map_put(&eng->retained, &moved);
 	}
 }
 
+static bool collect_splice(FluxEngine *eng, FluxRetainEntry const *entry) {
+	FluxCommandBuffer *cmds     = &eng->commands;
+	FluxPayloadArena  *payloads = &eng->payloads;
+	uint32_t           dst      = flux_payload_align(payloads->used);
+	uint32_t           size     = entry->payload_end - entry->payload_start;
+	if (!flux_command_buffer_reserve(cmds, entry->cmd_count)) return false;
+	if (!flux_payload_arena_reserve(payloads, dst + size)) return false;
+
+	/* Both offsets are payload-aligned, so the block keeps its internal layout
+	 * and every payload moves by the same delta. */
+	memcpy(payloads->bytes + dst, eng->prev_payloads.bytes + entry->payload_start, size);
+	payloads->used = dst + size;
+
+	uint32_t first         = cmds->count;
+	uint32_t payload_delta = dst - entry->payload_start;
+	memcpy(cmds->cmds + first, eng->prev_commands.cmds + entry->cmd_start, sizeof(FluxRenderCommand) * entry->cmd_count);
+	memcpy(cmds->hashes + first, eng->prev_commands.hashes + entry->cmd_start, sizeof(uint64_t) * entry->cmd_count);
+	for (uint32_t i = first; i < first + entry->cmd_count; i++)
+		if (cmds->cmds [i].payload != FLUX_RENDER_NO_PAYLOAD) cmds->cmds [i].payload += payload_delta;
+	cmds->count += entry->cmd_count;
+
+	collect_replay_damage(eng, first, entry->cmd_count);
+	collect_carry_entries(eng, entry, first - entry->cmd_start, payload_delta);
+	eng->stats.reused_commands += entry->cmd_count;
+	return true;
+}
+
+/* Copies @p node's whole subtree from the previous collect when its generation
+ * and the live tree still match what was emitted. */
+static bool collect_try_reuse(FluxEngine *eng, XentContext *ctx, XentNodeId node) {
+	if (!eng->retained_valid) return false;
+	FluxRetainEntry const *entry = flux_retain_map_find(&eng->prev_retained, node);
+	if (!entry) return false;
+	FluxNodeData const *nd = ( FluxNodeData const * ) xent_get_userdata(ctx, node);
+	if (!nd || nd->generation != entry->generation) return false;
+	if (!collect_retained_matches(eng, ctx, entry)) return false;
+	return collect_splice(eng, entry);
+}
+
+static void collect_retain_frame(FluxEngine *eng, CollectFrame const *frame) {
+	if (frame->pinned || !frame->has_data) return;
+	FluxRetainEntry entry = {
+	  .node          = frame->node,
+	  .generation    = frame->generation,
+	  .cmd_start     = frame->cmd_start,
+	  .cmd_count     = eng->commands.count - frame->cmd_start,
+	  .payload_start = frame->payload,
+	  .payload_end   = eng->payloads.used,
+	};
+	flux_retain_map_put(&eng->retained, &entry);
+}
+
 static void collect_commands(FluxEngine *eng, XentContext *ctx, XentNodeId root) {
 	uint32_t      stack_cap = 64;
 	uint32_t      stack_top = 0;
@@ -282,11 +639,14 @@ static void collect_commands(FluxEngine *eng, XentContext *ctx, XentNodeId root)
 	while (stack_top > 0) {
 		CollectFrame *frame = &stack [stack_top - 1];
 		if (!frame->main_emitted) {
-			collect_emit_main(eng, ctx, frame);
+			if (collect_try_reuse(eng, ctx, frame->node)) stack_top--;
+			else collect_emit_main(eng, ctx, frame);
 			continue;
 		}
 		if (collect_visit_child(&stack, &stack_top, &stack_cap, ctx)) continue;
 		collect_emit_finish(eng, ctx, frame);
+		collect_retain_frame(eng, frame);
+		if (frame->pinned && stack_top > 1) stack [stack_top - 2].pinned = true;
 		stack_top--;
 	}
 
@@ -299,21 +659,119 @@ FluxEngine *flux_engine_create(FluxNodeStore *store, FluxControlRegistry const *
 	if (!eng) return NULL;
 	eng->store    = store;
 	eng->registry = registry;
+	eng->damage    = flux_damage_tracker_create();
+	eng->hit_index = flux_hit_index_create();
+	if (!eng->damage || !eng->hit_index) {
+		flux_engine_destroy(eng);
+		return NULL;
+	}
 	return eng;
 }
 
 void flux_engine_destroy(FluxEngine *eng) {
 	if (!eng) return;
-	free(eng->commands.cmds);
+	flux_damage_tracker_destroy(eng->damage);
+	flux_hit_index_destroy(eng->hit_index);
+	flux_command_buffer_free(&eng->commands);
+	flux_command_buffer_free(&eng->prev_commands);
+	free(eng->payloads.bytes);
+	free(eng->prev_payloads.bytes);
+	flux_retain_map_free(&eng->retained);
+	flux_retain_map_free(&eng->prev_retained);
 	free(eng);
 }
 
+static void collect_index_transform(FluxEngine *eng, FluxRenderCommand const *cmd) {
+	FluxTransformParams const *tp = &cmd->op.transform;
+	FluxHitTransform           xf;
+	xf.bounds       = cmd->bounds;
+	xf.scale        = tp->scale;
+	xf.pivot_x      = tp->pivot_x;
+	xf.pivot_y      = tp->pivot_y;
+	xf.translate_x  = tp->translate_x;
+	xf.translate_y  = tp->translate_y;
+	xf.clip_subtree = tp->clip_subtree;
+	flux_hit_index_transform(eng->hit_index, &xf);
+}
+
+/* Replays the finished stream's main draws (spliced ones included) into the
+ * hit index. A transform push directly precedes its node's draw and a scroll
+ * clip directly follows it, so both attach to the right node. */
+static void collect_build_hit_index(FluxEngine *eng, XentContext *ctx, XentNodeId root) {
+	flux_hit_index_begin(eng->hit_index, ctx, root);
+	for (uint32_t i = 0; i < eng->commands.count; i++) {
+		FluxRenderCommand const *cmd = &eng->commands.cmds [i];
+		if (cmd->clip_action == FLUX_CLIP_PUSH)
+			flux_hit_index_scroll(eng->hit_index, cmd->op.clip.scroll_x, cmd->op.clip.scroll_y);
+		if (cmd->clip_action == FLUX_CLIP_PUSH_TRANSFORM) collect_index_transform(eng, cmd);
+		if (cmd->clip_action != FLUX_CLIP_NONE || cmd->phase != FLUX_PHASE_MAIN) continue;
+		if (cmd->payload == FLUX_RENDER_NO_PAYLOAD) continue;
+		flux_hit_index_add(eng->hit_index, flux_payload_arena_node(&eng->payloads, cmd->payload), cmd->bounds);
+	}
+	flux_hit_index_finish(eng->hit_index);
+}
+
+/* The last frame becomes the splice source; the current buffers are reset
+ * (not freed) for the new one. */
+static void collect_swap_frames(FluxEngine *eng) {
+	FluxCommandBuffer commands = eng->prev_commands;
+	eng->prev_commands         = eng->commands;
+	eng->commands              = commands;
+	eng->commands.count        = 0;
+
+	FluxPayloadArena payloads = eng->prev_payloads;
+	eng->prev_payloads        = eng->payloads;
+	eng->payloads             = payloads;
+	eng->payloads.used        = 0;
+
+	FluxRetainMap retained = eng->prev_retained;
+	eng->prev_retained     = eng->retained;
+	eng->retained          = retained;
+	flux_retain_map_clear(&eng->retained);
+}
+
 void flux_engine_collect(FluxEngine *eng, XentContext *ctx, XentNodeId root) {
 	if (!eng || !ctx || root == XENT_NODE_INVALID) return;
-	eng->commands.count = 0;
+	collect_swap_frames(eng);
+	if (eng->retained_ctx != ctx) eng->retained_valid = false;
+	memset(&eng->stats, 0, sizeof(eng->stats));
+
+	flux_damage_tracker_begin(eng->damage);
 	collect_commands(eng, ctx, root);
+	flux_damage_tracker_finish(eng->damage, &eng->frame_damage);
+	collect_build_hit_index(eng, ctx, root);
+
+	eng->stats.commands = eng->commands.count;
+	eng->retained_ctx   = ctx;
+	eng->retained_valid = true;
+}
+
+void flux_engine_get_damage(FluxEngine const *eng, FluxDamageRegion *out) {
+	if (!out) return;
+	if (!eng) {
+		flux_damage_set_full(out);
+		return;
+	}
+	*out = eng->frame_damage;
+}
+
+void flux_engine_invalidate(FluxEngine *eng) {
+	if (!eng) return;
+	flux_damage_tracker_invalidate(eng->damage);
+	eng->retained_valid = false;
 }
 
+void flux_engine_get_stats(FluxEngine const *eng, FluxEngineStats *out) {
+	if (!out) return;
+	if (!eng) {
+		memset(out, 0, sizeof(*out));
+		return;
+	}
+	*out = eng->stats;
+}
+
+FluxHitIndex const      *flux_engine_hit_index(FluxEngine const *eng) { return eng ? eng->hit_index : NULL; }
+
 uint32_t                 flux_engine_command_count(FluxEngine const *eng) { return eng ? eng->commands.count : 0; }
 
 FluxRenderCommand const *flux_engine_command_at(FluxEngine const *eng, uint32_t index) {
@@ -321,6 +779,16 @@ FluxRenderCommand const *flux_engine_command_at(FluxEngine const *eng, uint32_t
 	return &eng->commands.cmds [index];
 }
 
+bool flux_engine_command_snapshot(FluxEngine const *eng, uint32_t index, FluxRenderSnapshot *out) {
+	if (!eng || !out || index >= eng->commands.count) return false;
+	return flux_payload_arena_decode(&eng->payloads, eng->commands.cmds [index].payload, out);
+}
+
+size_t flux_engine_frame_bytes(FluxEngine const *eng) {
+	if (!eng) return 0;
+	return ( size_t ) eng->commands.count * sizeof(FluxRenderCommand) + eng->payloads.used;
+}
+
 static D2D1_MATRIX_3X2_F flux_identity_matrix(void) {
 	D2D1_MATRIX_3X2_F m;
 	m._11 = 1.0f;
@@ -386,7 +854,7 @@ static void execute_clip_push(
 	D2D1_RECT_F clip = {cmd->bounds.x, cmd->bounds.y, cmd->bounds.x + cmd->bounds.w, cmd->bounds.y + cmd->bounds.h};
 	ID2D1RenderTarget_PushAxisAlignedClip(FLUX_RT(rc), &clip, D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
 
-	D2D1_MATRIX_3X2_F translate = flux_translate_matrix(-cmd->scroll_x, -cmd->scroll_y);
+	D2D1_MATRIX_3X2_F translate = flux_translate_matrix(-cmd->op.clip.scroll_x, -cmd->op.clip.scroll_y);
 	D2D1_MATRIX_3X2_F combined  = flux_matrix_multiply(&translate, &current);
 	ID2D1RenderTarget_SetTransform(FLUX_RT(rc), &combined);
 }
@@ -406,12 +874,13 @@ static void execute_clip_pop(FluxRenderContext const *rc, FluxTransformStack *st
 static void execute_transform_push(
   FluxEngine *eng, FluxRenderContext const *rc, FluxRenderCommand const *cmd, FluxTransformStack *stack
 ) {
-	D2D1_LAYER_PARAMETERS lp;
+	FluxTransformParams const *tp = &cmd->op.transform;
+	D2D1_LAYER_PARAMETERS      lp;
 	lp.contentBounds     = (D2D1_RECT_F) {-1.0e9f, -1.0e9f, 1.0e9f, 1.0e9f};
 	lp.geometricMask     = NULL;
 	lp.maskAntialiasMode = D2D1_ANTIALIAS_MODE_PER_PRIMITIVE;
 	lp.maskTransform     = flux_identity_matrix();
-	lp.opacity           = cmd->opacity;
+	lp.opacity           = tp->opacity;
 	lp.opacityBrush      = NULL;
 	lp.layerOptions      = D2D1_LAYER_OPTIONS_NONE;
 	ID2D1RenderTarget_PushLayer(FLUX_RT(rc), &lp, NULL);
@@ -428,21 +897,21 @@ static void execute_transform_push(
 	/* Optional subtree clip, recorded in the parent (pre-transform) space so a
 	 * slid child is clipped to its own layout rect — content sliding out from
 	 * behind the Expander header never overdraws the header. */
-	stack->clipped [stack->top] = cmd->clip_subtree;
-	if (cmd->clip_subtree) {
+	stack->clipped [stack->top] = tp->clip_subtree;
+	if (tp->clip_subtree) {
 		D2D1_RECT_F clip = {cmd->bounds.x, cmd->bounds.y, cmd->bounds.x + cmd->bounds.w, cmd->bounds.y + cmd->bounds.h};
 		ID2D1RenderTarget_PushAxisAlignedClip(FLUX_RT(rc), &clip, D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
 	}
 	stack->top++;
 
-	float             s = cmd->scale;
+	float             s = tp->scale;
 	D2D1_MATRIX_3X2_F scale;
 	scale._11                  = s;
 	scale._12                  = 0.0f;
 	scale._21                  = 0.0f;
 	scale._22                  = s;
-	scale._31                  = cmd->pivot_x * (1.0f - s) + cmd->translate_x;
-	scale._32                  = cmd->pivot_y * (1.0f - s) + cmd->translate_y;
+	scale._31                  = tp->pivot_x * (1.0f - s) + tp->translate_x;
+	scale._32                  = tp->pivot_y * (1.0f - s) + tp->translate_y;
 	D2D1_MATRIX_3X2_F combined = flux_matrix_multiply(&scale, &current);
 	ID2D1RenderTarget_SetTransform(FLUX_RT(rc), &combined);
 }
@@ -460,21 +929,49 @@ static void execute_transform_pop(FluxRenderContext const *rc, FluxTransformStac
 }
 
 static void execute_draw(FluxEngine const *eng, FluxRenderContext const *rc, FluxRenderCommand const *cmd) {
+	FluxRenderSnapshot snap;
+	if (!flux_payload_arena_decode(&eng->payloads, cmd->payload, &snap)) return;
 	if (cmd->phase == FLUX_PHASE_MAIN)
-		flux_engine_dispatch_render(eng->registry, rc, &cmd->snapshot, &cmd->bounds, &cmd->state);
-	else flux_engine_dispatch_render_overlay(eng->registry, rc, &cmd->snapshot, &cmd->bounds);
+		flux_engine_dispatch_render(eng->registry, rc, &snap, &cmd->bounds, &cmd->state);
+	else flux_engine_dispatch_render_overlay(eng->registry, rc, &snap, &cmd->bounds);
 }
 
-void flux_engine_execute(FluxEngine const *eng, FluxRenderContext const *rc) {
-	if (!eng || !rc) return;
+/* Draws one command with a private animation flag so a renderer that asks for
+ * another frame is remembered on its damage record: its tween lives in the
+ * render cache, invisible to the content hash, so the next collect must
+ * repaint it even though nothing it was built from changed. A renderer that
+ * only asks to be redrawn later (wake_at) is remembered the same way, for
+ * whichever frame comes next. */
+static void execute_draw_tracked(
+  FluxEngine *eng, FluxRenderContext const *rc, FluxRenderCommand const *cmd, uint32_t record
+) {
+	bool              animating = false;
+	double            wake_at   = INFINITY;
+	FluxRenderContext local     = *rc;
+	local.animations_active     = &animating;
+	local.wake_at               = &wake_at;
+	execute_draw(eng, &local, cmd);
+	if (isfinite(wake_at) && rc->wake_at && wake_at < *rc->wake_at) *rc->wake_at = wake_at;
+	if (!animating && !isfinite(wake_at)) return;
+	if (animating && rc->animations_active) *rc->animations_active = true;
+	flux_damage_tracker_mark_animating(eng->damage, record);
+}
+
+static bool execute_rect_overlaps(FluxRect const *a, FluxRect const *b) {
+	return a->x < b->x + b->w && b->x < a->x + a->w && a->y < b->y + b->h && b->y < a->y + a->h;
+}
 
-	FluxTransformStack stack = {0};
-	FluxEngine        *mut   = ( FluxEngine * ) eng;
+/* Runs the command list; with @p cull set, draw commands whose recorded screen
+ * rect misses it are skipped. Clip and transform ops always run so the D2D
+ * state stack stays balanced. */
+static void execute_commands(FluxEngine *eng, FluxRenderContext const *rc, FluxRect const *cull) {
+	FluxTransformStack stack  = {0};
+	uint32_t           record = 0;
 
 	for (uint32_t i = 0; i < eng->commands.count; i++) {
 		FluxRenderCommand const *cmd = &eng->commands.cmds [i];
 		if (cmd->clip_action == FLUX_CLIP_PUSH) {
-			execute_clip_push(mut, rc, cmd, &stack);
+			execute_clip_push(eng, rc, cmd, &stack);
 			continue;
 		}
 		if (cmd->clip_action == FLUX_CLIP_POP) {
@@ -482,13 +979,49 @@ void flux_engine_execute(FluxEngine const *eng, FluxRenderContext const *rc) {
 			continue;
 		}
 		if (cmd->clip_action == FLUX_CLIP_PUSH_TRANSFORM) {
-			execute_transform_push(mut, rc, cmd, &stack);
+			execute_transform_push(eng, rc, cmd, &stack);
 			continue;
 		}
 		if (cmd->clip_action == FLUX_CLIP_POP_TRANSFORM) {
 			execute_transform_pop(rc, &stack);
 			continue;
 		}
-		execute_draw(eng, rc, cmd);
+
+		uint32_t index = record++;
+		if (cull) {
+			FluxRect screen = flux_damage_tracker_item_rect(eng->damage, index);
+			if (!execute_rect_overlaps(&screen, cull)) continue;
+		}
+		execute_draw_tracked(eng, rc, cmd, index);
+	}
+}
+
+void flux_engine_execute(FluxEngine const *eng, FluxRenderContext const *rc) {
+	if (!eng || !rc) return;
+	execute_commands(( FluxEngine * ) eng, rc, NULL);
+}
+
+void flux_engine_execute_region(
+  FluxEngine const *eng, FluxRenderContext const *rc, FluxDamageRegion const *region, FluxColor clear
+) {
+	if (!eng || !rc || !region) return;
+	FluxEngine  *mut = ( FluxEngine * ) eng;
+	D2D1_COLOR_F bg  = flux_d2d_color(clear);
+
+	if (region->full) {
+		ID2D1RenderTarget_Clear(FLUX_RT(rc), &bg);
+		execute_commands(mut, rc, NULL);
+		return;
+	}
+
+	/* One pass per rect: the aliased clip keeps each pass inside its
+	 * pixel-snapped rect, so nothing outside the damage is touched. */
+	for (uint32_t i = 0; i < region->count; i++) {
+		FluxRect const *r    = &region->rects [i];
+		D2D1_RECT_F     clip = flux_d2d_rect(r);
+		ID2D1RenderTarget_PushAxisAlignedClip(FLUX_RT(rc), &clip, D2D1_ANTIALIAS_MODE_ALIASED);
+		ID2D1RenderTarget_Clear(FLUX_RT(rc), &bg);
+		execute_commands(mut, rc, r);
+		ID2D1RenderTarget_PopAxisAlignedClip(FLUX_RT(rc));
 	}
 }
@@ -0,0 +1,225 @@
+#include "flux_hit_index.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Ancestor chain of the entry added last: the parent of the next entry is
+ * always on it, since entries arrive in pre-order. */
+typedef struct HitIndexFrame {
+	XentNodeId     node;
+	FluxRect       hit;     /**< Clip the node's children inherit. */
+	FluxHitMapping mapping; /**< Layout-to-screen mapping of the node's children. */
+} HitIndexFrame;
+
+struct FluxHitIndex {
+	XentContext     *ctx;
+	XentNodeId       root;
+	bool             ready;
+	bool             failed;     /**< An add ran out of memory; the rebuild is unusable. */
+	bool             has_pending;
+	FluxHitTransform pending;    /**< Transform announced for the next add. */
+	FluxHitEntry    *entries;
+	uint32_t         count;
+	uint32_t         capacity;
+	HitIndexFrame   *stack;
+	uint32_t         depth;
+	uint32_t         stack_capacity;
+	FluxRect         extent;     /**< Root rectangle; nothing outside it can be hit. */
+	float            cell_w;
+	float            cell_h;
+	uint32_t         cols;
+	uint32_t         rows;
+	uint32_t        *cell_start; /**< cols * rows + 1 offsets into cell_items. */
+	uint32_t         cell_start_capacity;
+	uint32_t        *cell_items; /**< Entry indices per cell, ascending (paint order). */
+	uint32_t         cell_items_capacity;
+};
+
+/* Returns @p items grown to hold @p needed elements (unchanged when it already
+ * does), or NULL on failure with @p items left intact. */
+static void *hit_index_reserve(void *items, uint32_t *capacity, uint32_t needed, size_t item_size) {
+	if (needed <= *capacity) return items;
+	uint32_t new_cap = *capacity ? *capacity : 64;
+	while (new_cap < needed) new_cap *= 2;
+	void *grown = realloc(items, item_size * new_cap);
+	if (grown) *capacity = new_cap;
+	return grown;
+}
+
+static FluxRect hit_rect_intersect(FluxRect a, FluxRect b) {
+	float x0 = fmaxf(a.x, b.x);
+	float y0 = fmaxf(a.y, b.y);
+	float x1 = fminf(a.x + a.w, b.x + b.w);
+	float y1 = fminf(a.y + a.h, b.y + b.h);
+	return (FluxRect) {x0, y0, fmaxf(x1 - x0, 0.0f), fmaxf(y1 - y0, 0.0f)};
+}
+
+static bool hit_rect_contains(FluxRect const *r, float px, float py) {
+	return px >= r->x && px < r->x + r->w && py >= r->y && py < r->y + r->h;
+}
+
+FluxHitIndex *flux_hit_index_create(void) { return ( FluxHitIndex * ) calloc(1, sizeof(FluxHitIndex)); }
+
+void flux_hit_index_destroy(FluxHitIndex *index) {
+	if (!index) return;
+	free(index->entries);
+	free(index->stack);
+	free(index->cell_start);
+	free(index->cell_items);
+	free(index);
+}
+
+void flux_hit_index_begin(FluxHitIndex *index, XentContext *ctx, XentNodeId root) {
+	if (!index) return;
+	index->ctx         = ctx;
+	index->root        = root;
+	index->ready       = false;
+	index->failed      = false;
+	index->has_pending = false;
+	index->count       = 0;
+	index->depth       = 0;
+}
+
+void flux_hit_index_add(FluxHitIndex *index, XentNodeId node, FluxRect bounds) {
+	if (!index || !index->ctx || index->failed) return;
+	FluxHitEntry *entries
+	  = ( FluxHitEntry * ) hit_index_reserve(index->entries, &index->capacity, index->count + 1, sizeof(FluxHitEntry));
+	if (entries) index->entries = entries;
+	HitIndexFrame *stack = ( HitIndexFrame * ) hit_index_reserve(
+	  index->stack, &index->stack_capacity, index->depth + 1, sizeof(HitIndexFrame)
+	);
+	if (stack) index->stack = stack;
+	if (!entries || !stack) {
+		index->failed = true;
+		return;
+	}
+
+	XentNodeId parent = xent_get_parent(index->ctx, node);
+	while (index->depth > 0 && index->stack [index->depth - 1].node != parent) index->depth--;
+
+	HitIndexFrame inherited = {XENT_NODE_INVALID, bounds, flux_hit_mapping_identity()};
+	if (index->depth > 0) inherited = index->stack [index->depth - 1];
+	if (index->has_pending) {
+		FluxHitTransform const *xf = &index->pending;
+		if (xf->clip_subtree)
+			inherited.hit = hit_rect_intersect(flux_hit_mapping_rect(inherited.mapping, xf->bounds), inherited.hit);
+		inherited.mapping  = flux_hit_mapping_transform(inherited.mapping, xf);
+		index->has_pending = false;
+	}
+
+	FluxHitEntry *e = &index->entries [index->count++];
+	e->node         = node;
+	e->leaf         = xent_get_first_child(index->ctx, node) == XENT_NODE_INVALID;
+	e->scale        = inherited.mapping.scale;
+	e->bounds       = flux_hit_mapping_rect(inherited.mapping, bounds);
+	e->hit          = hit_rect_intersect(e->bounds, inherited.hit);
+
+	index->stack [index->depth++] = (HitIndexFrame) {node, e->hit, inherited.mapping};
+}
+
+void flux_hit_index_scroll(FluxHitIndex *index, float scroll_x, float scroll_y) {
+	if (!index || index->depth == 0) return;
+	HitIndexFrame *top = &index->stack [index->depth - 1];
+	top->mapping       = flux_hit_mapping_scroll(top->mapping, scroll_x, scroll_y);
+}
+
+void flux_hit_index_transform(FluxHitIndex *index, FluxHitTransform const *xf) {
+	if (!index || !xf) return;
+	index->pending     = *xf;
+	index->has_pending = true;
+}
+
+static uint32_t hit_index_axis_cells(float extent, float *cell) {
+	uint32_t cells = extent > 0.0f ? ( uint32_t ) ceilf(extent / FLUX_HIT_INDEX_CELL) : 1u;
+	if (cells < 1u) cells = 1u;
+	if (cells > FLUX_HIT_INDEX_MAX_CELLS) cells = FLUX_HIT_INDEX_MAX_CELLS;
+	*cell = extent > 0.0f ? extent / ( float ) cells : 1.0f;
+	return cells;
+}
+
+static uint32_t hit_index_cell_of(float v, float origin, float cell, uint32_t cells) {
+	float c = floorf((v - origin) / cell);
+	if (c < 0.0f) return 0;
+	if (c >= ( float ) cells) return cells - 1u;
+	return ( uint32_t ) c;
+}
+
+typedef struct HitCellRange {
+	uint32_t x0, x1, y0, y1;
+} HitCellRange;
+
+static HitCellRange hit_index_cells(FluxHitIndex const *index, FluxRect const *r) {
+	return (HitCellRange) {
+	  hit_index_cell_of(r->x, index->extent.x, index->cell_w, index->cols),
+	  hit_index_cell_of(r->x + r->w, index->extent.x, index->cell_w, index->cols),
+	  hit_index_cell_of(r->y, index->extent.y, index->cell_h, index->rows),
+	  hit_index_cell_of(r->y + r->h, index->extent.y, index->cell_h, index->rows),
+	};
+}
+
+static bool hit_entry_empty(FluxHitEntry const *e) { return e->hit.w <= 0.0f || e->hit.h <= 0.0f; }
+
+/* Counting sort into cells. Filling from the last entry backwards leaves each
+ * cell's list in ascending (paint) order and its start offset in place. */
+bool flux_hit_index_finish(FluxHitIndex *index) {
+	if (!index || index->failed || index->count == 0) return false;
+	index->extent = index->entries [0].hit;
+	index->cols   = hit_index_axis_cells(index->extent.w, &index->cell_w);
+	index->rows   = hit_index_axis_cells(index->extent.h, &index->cell_h);
+
+	uint32_t  cells = index->cols * index->rows;
+	uint32_t *start
+	  = ( uint32_t * ) hit_index_reserve(index->cell_start, &index->cell_start_capacity, cells + 1, sizeof(uint32_t));
+	if (!start) return false;
+	index->cell_start = start;
+	memset(index->cell_start, 0, sizeof(uint32_t) * (cells + 1));
+
+	uint32_t total = 0;
+	for (uint32_t i = 0; i < index->count; i++) {
+		if (hit_entry_empty(&index->entries [i])) continue;
+		HitCellRange r = hit_index_cells(index, &index->entries [i].hit);
+		for (uint32_t y = r.y0; y <= r.y1; y++)
+			for (uint32_t x = r.x0; x <= r.x1; x++) index->cell_start [y * index->cols + x]++;
+		total += (r.x1 - r.x0 + 1u) * (r.y1 - r.y0 + 1u);
+	}
+	uint32_t *items
+	  = ( uint32_t * ) hit_index_reserve(index->cell_items, &index->cell_items_capacity, total, sizeof(uint32_t));
+	if (!items) return false;
+	index->cell_items = items;
+
+	for (uint32_t c = 1; c < cells; c++) index->cell_start [c] += index->cell_start [c - 1];
+	index->cell_start [cells] = total;
+	for (uint32_t i = index->count; i > 0; i--) {
+		if (hit_entry_empty(&index->entries [i - 1u])) continue;
+		HitCellRange r = hit_index_cells(index, &index->entries [i - 1u].hit);
+		for (uint32_t y = r.y0; y <= r.y1; y++)
+			for (uint32_t x = r.x0; x <= r.x1; x++) items [--index->cell_start [y * index->cols + x]] = i - 1u;
+	}
+
+	index->ready = true;
+	return true;
+}
+
+bool flux_hit_index_query(
+  FluxHitIndex const *index, XentNodeId root, float px, float py, FluxHitLeafFilter leaf_filter,
+  FluxHitEntry const **out
+) {
+	if (!index || !index->ready || index->root != root || !out) return false;
+	*out = NULL;
+	if (!hit_rect_contains(&index->extent, px, py)) return true;
+
+	uint32_t cx   = hit_index_cell_of(px, index->extent.x, index->cell_w, index->cols);
+	uint32_t cy   = hit_index_cell_of(py, index->extent.y, index->cell_h, index->rows);
+	uint32_t cell = cy * index->cols + cx;
+	for (uint32_t i = index->cell_start [cell + 1]; i > index->cell_start [cell]; i--) {
+		FluxHitEntry const *e = &index->entries [index->cell_items [i - 1u]];
+		if (!hit_rect_contains(&e->hit, px, py)) continue;
+		if (e->leaf && leaf_filter && !leaf_filter(index->ctx, e->node)) continue;
+		*out = e;
+		return true;
+	}
+	return true;
+}
+
+uint32_t flux_hit_index_count(FluxHitIndex const *index) { return index && index->ready ? index->count : 0; }
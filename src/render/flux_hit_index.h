@@ -0,0 +1,134 @@
+/**
+ * @file flux_hit_index.h
+ * @brief Screen-space hit index built from the collected command stream.
+ *
+ * After each collect the engine replays its main draws into the index in
+ * paint order. Every node gets its rectangle mapped to the screen through the
+ * enclosing scroll offsets and render transforms (the same uniform scale +
+ * offset the renderer applies) and its hit area clipped by every ancestor's
+ * mapped rectangle and any subtree clip, the containment the tree walk
+ * enforces. Entries are bucketed into a uniform grid; a query scans one cell
+ * from the top of the paint order down and stops at the first entry that
+ * accepts the point, so it allocates nothing and touches no layout data beyond
+ * the filter callback.
+ *
+ * Platform-neutral; no D2D dependency.
+ * @note This is an internal header; do not include from public API.
+ */
+#ifndef FLUX_HIT_INDEX_H
+#define FLUX_HIT_INDEX_H
+
+#include "fluxent/flux_types.h"
+#include <xent/xent.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Target grid cell edge in DIPs; the grid is coarsened past FLUX_HIT_INDEX_MAX_CELLS per axis. */
+#define FLUX_HIT_INDEX_CELL      64.0f
+#define FLUX_HIT_INDEX_MAX_CELLS 128u
+
+typedef struct FluxHitIndex FluxHitIndex;
+
+/** @brief Layout-to-screen mapping under scrolls and render transforms: screen = layout * scale + (x, y). */
+typedef struct FluxHitMapping {
+	float scale;
+	float x;
+	float y;
+} FluxHitMapping;
+
+/** @brief Render transform of a subtree, as pushed by the engine (see FluxTransformParams). */
+typedef struct FluxHitTransform {
+	FluxRect bounds;       /**< Node layout rect; the subtree clip when @ref clip_subtree is set. */
+	float    scale;        /**< Uniform scale about (pivot_x, pivot_y). */
+	float    pivot_x;      /**< Scale pivot X (layout coordinates). */
+	float    pivot_y;      /**< Scale pivot Y (layout coordinates). */
+	float    translate_x;  /**< Post-scale X translate. */
+	float    translate_y;  /**< Post-scale Y translate. */
+	bool     clip_subtree; /**< Clip the subtree to @ref bounds, in the parent's space. */
+} FluxHitTransform;
+
+static inline FluxHitMapping flux_hit_mapping_identity(void) { return (FluxHitMapping) {1.0f, 0.0f, 0.0f}; }
+
+/** @brief Children of a scroll viewer are drawn shifted by (-scroll_x, -scroll_y). */
+static inline FluxHitMapping flux_hit_mapping_scroll(FluxHitMapping m, float scroll_x, float scroll_y) {
+	return (FluxHitMapping) {m.scale, m.x - scroll_x * m.scale, m.y - scroll_y * m.scale};
+}
+
+/** @brief x' = x * s + pivot * (1 - s) + translate, then @p m. */
+static inline FluxHitMapping flux_hit_mapping_transform(FluxHitMapping m, FluxHitTransform const *xf) {
+	float cx = xf->pivot_x * (1.0f - xf->scale) + xf->translate_x;
+	float cy = xf->pivot_y * (1.0f - xf->scale) + xf->translate_y;
+	return (FluxHitMapping) {m.scale * xf->scale, cx * m.scale + m.x, cy * m.scale + m.y};
+}
+
+static inline FluxRect flux_hit_mapping_rect(FluxHitMapping m, FluxRect r) {
+	return (FluxRect) {r.x * m.scale + m.x, r.y * m.scale + m.y, r.w * m.scale, r.h * m.scale};
+}
+
+/** @brief One indexed node. */
+typedef struct FluxHitEntry {
+	XentNodeId node;   /**< Layout node. */
+	bool       leaf;   /**< No layout children: only hit if the filter accepts it. */
+	float      scale;  /**< Screen DIPs per layout DIP; node-local = (point - bounds origin) / scale. */
+	FluxRect   bounds; /**< Node rectangle on screen (scrolls and transforms applied). */
+	FluxRect   hit;    /**< @ref bounds clipped by every ancestor and subtree clip. */
+} FluxHitEntry;
+
+/** @brief Decides whether a leaf entry takes the pointer (false = transparent). */
+typedef bool (*FluxHitLeafFilter)(XentContext *ctx, XentNodeId node);
+
+/** @brief Create an empty index. */
+XENT_NODISCARD FluxHitIndex *flux_hit_index_create(void);
+
+/** @brief Destroy an index (NULL is safe). */
+void                         flux_hit_index_destroy(FluxHitIndex *index);
+
+/** @brief Start a rebuild for @p root; queries fail until flux_hit_index_finish(). */
+void                         flux_hit_index_begin(FluxHitIndex *index, XentContext *ctx, XentNodeId root);
+
+/**
+ * @brief Add the next node in paint order.
+ *
+ * @p bounds is the node's layout rectangle as collected. The parent must
+ * already have been added; its mapping and clip apply, along with a transform
+ * announced by flux_hit_index_transform() just before.
+ */
+void                         flux_hit_index_add(FluxHitIndex *index, XentNodeId node, FluxRect bounds);
+
+/** @brief The node added last scrolls its children by (scroll_x, scroll_y). */
+void                         flux_hit_index_scroll(FluxHitIndex *index, float scroll_x, float scroll_y);
+
+/** @brief The node added next, and its subtree, are drawn under @p xf. */
+void                         flux_hit_index_transform(FluxHitIndex *index, FluxHitTransform const *xf);
+
+/** @brief Bucket the added entries; false (and an unusable index) on allocation failure. */
+bool                         flux_hit_index_finish(FluxHitIndex *index);
+
+/**
+ * @brief Topmost entry under a point.
+ * @param index Index (NULL is safe).
+ * @param root Root the query is for; must match the root the index was built from.
+ * @param px,py Point in root coordinates.
+ * @param leaf_filter Consulted for leaf entries only (NULL treats every leaf as solid).
+ * @param out Receives the entry, or NULL when nothing takes the point.
+ * @return false if the index cannot answer (not built, or for another root).
+ */
+bool flux_hit_index_query(
+  FluxHitIndex const *index, XentNodeId root, float px, float py, FluxHitLeafFilter leaf_filter,
+  FluxHitEntry const **out
+);
+
+/** @brief Number of indexed entries. */
+uint32_t flux_hit_index_count(FluxHitIndex const *index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
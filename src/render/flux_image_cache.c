@@ -1,7 +1,10 @@
-/* Decodes images with WIC and uploads them to Direct2D bitmaps. Uses cd2d.h for
- * the Direct2D side (same COM type system as the renderer) and <wincodec.h> for
- * decoding. The public interface speaks void* so flux_image_cache.h stays free of
- * platform headers. */
+/* WIC + Direct2D backend of the image store. Decodes run on the Windows thread
+ * pool (each in its own MTA with its own WIC factory), scale the frame down to
+ * the requested bucket with a Fant scaler, and produce premultiplied BGRA
+ * pixels; the render thread uploads them into Direct2D bitmaps. Uses cd2d.h
+ * for the Direct2D side (same COM type system as the renderer) and <wincodec.h>
+ * for decoding. The public interface speaks void* so flux_image_cache.h stays
+ * free of platform headers. */
 #ifndef COBJMACROS
   #define COBJMACROS
 #endif
@@ -11,125 +14,192 @@
 #include <wincodec.h>
 
 #include "render/flux_image_cache.h"
+#include "render/flux_image_store.h"
 
 #include <stdlib.h>
 #include <string.h>
 
-#define FLUX_IMAGE_CACHE_CAP 64
-
-typedef struct FluxImageEntry {
-	char         *source;
-	ID2D1Bitmap1 *bitmap;
-	float         w;
-	float         h;
-} FluxImageEntry;
-
-static IWICImagingFactory *g_wic;
-static void               *g_device_context;
-static FluxImageEntry      g_entries [FLUX_IMAGE_CACHE_CAP];
-static int                 g_count;
-
-static IWICImagingFactory *image_wic_factory(void) {
-	if (g_wic) return g_wic;
-	HRESULT hr = CoCreateInstance(
-	  &CLSID_WICImagingFactory, NULL, CLSCTX_INPROC_SERVER, &IID_IWICImagingFactory, ( void ** ) &g_wic
-	);
-	if (hr == CO_E_NOTINITIALIZED) {
-		CoInitializeEx(NULL, COINIT_APARTMENTTHREADED);
-		hr = CoCreateInstance(
-		  &CLSID_WICImagingFactory, NULL, CLSCTX_INPROC_SERVER, &IID_IWICImagingFactory, ( void ** ) &g_wic
-		);
+/* Largest decoded image accepted (bytes of 32bpp pixels). */
+#define FLUX_IMAGE_MAX_BYTES (256u * 1024u * 1024u)
+
+typedef struct ImagePoolWork {
+	FluxImageJobFn fn;
+	void          *job;
+} ImagePoolWork;
+
+static SRWLOCK         g_lock = SRWLOCK_INIT;
+static FluxImageStore *g_store;
+static void           *g_device_context;
+
+static bool image_copy_pixels(IWICFormatConverter *conv, FluxImagePixels *out) {
+	UINT w = 0, h = 0;
+	if (FAILED(IWICFormatConverter_GetSize(conv, &w, &h)) || !w || !h) return false;
+	if (( uint64_t ) w * h * 4u > FLUX_IMAGE_MAX_BYTES) return false;
+
+	uint32_t stride = w * 4u;
+	uint8_t *data   = ( uint8_t * ) malloc(( size_t ) stride * h);
+	if (!data) return false;
+	if (FAILED(IWICFormatConverter_CopyPixels(conv, NULL, stride, stride * h, data))) {
+		free(data);
+		return false;
 	}
-	return SUCCEEDED(hr) ? g_wic : NULL;
+	out->data   = data;
+	out->width  = w;
+	out->height = h;
+	out->stride = stride;
+	return true;
 }
 
-static ID2D1Bitmap1 *
-image_bitmap_from_converter(ID2D1DeviceContext *dc, IWICFormatConverter *conv, float *out_w, float *out_h) {
-	UINT uw = 0, uh = 0;
-	IWICFormatConverter_GetSize(conv, &uw, &uh);
-	D2D1_BITMAP_PROPERTIES1 props = {
-	  {DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED},
-      96.0f, 96.0f, D2D1_BITMAP_OPTIONS_NONE, NULL
-    };
-	ID2D1Bitmap1 *bitmap = NULL;
-	if (FAILED(ID2D1DeviceContext_CreateBitmapFromWicBitmap1(dc, ( IWICBitmapSource * ) conv, &props, &bitmap)))
-		return NULL;
-	if (out_w) *out_w = ( float ) uw;
-	if (out_h) *out_h = ( float ) uh;
-	return bitmap;
-}
+/* The scaler sits between the frame and the converter, so the converter only
+ * touches the pixels that are kept. */
+static bool image_convert(
+  IWICImagingFactory *wic, IWICBitmapSource *src, uint32_t box_w, uint32_t box_h, FluxImagePixels *out,
+  uint32_t *natural_w, uint32_t *natural_h
+) {
+	UINT nw = 0, nh = 0;
+	if (FAILED(IWICBitmapSource_GetSize(src, &nw, &nh)) || !nw || !nh) return false;
+	*natural_w = nw;
+	*natural_h = nh;
+	uint32_t w, h;
+	flux_image_fit_size(nw, nh, box_w, box_h, &w, &h);
+
+	IWICBitmapScaler    *scaler = NULL;
+	IWICFormatConverter *conv   = NULL;
+	bool                 ok     = false;
+	if (w != nw || h != nh) {
+		if (FAILED(IWICImagingFactory_CreateBitmapScaler(wic, &scaler))
+			|| FAILED(IWICBitmapScaler_Initialize(scaler, src, w, h, WICBitmapInterpolationModeFant))) {
+			if (scaler) IWICBitmapScaler_Release(scaler);
+			return false;
+		}
+		src = ( IWICBitmapSource * ) scaler;
+	}
+	if (SUCCEEDED(IWICImagingFactory_CreateFormatConverter(wic, &conv))
+		&& SUCCEEDED(IWICFormatConverter_Initialize(
+		  conv, src, &GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone, NULL, 0.0, WICBitmapPaletteTypeMedianCut
+		)))
+		ok = image_copy_pixels(conv, out);
 
-static ID2D1Bitmap1 *image_decode(ID2D1DeviceContext *dc, char const *source, float *out_w, float *out_h) {
-	IWICImagingFactory *wic = image_wic_factory();
-	if (!wic) return NULL;
+	if (conv) IWICFormatConverter_Release(conv);
+	if (scaler) IWICBitmapScaler_Release(scaler);
+	return ok;
+}
 
+static bool image_decode_wic(
+  IWICImagingFactory *wic, char const *source, uint32_t box_w, uint32_t box_h, FluxImagePixels *out,
+  uint32_t *natural_w, uint32_t *natural_h
+) {
 	wchar_t wpath [MAX_PATH];
-	if (MultiByteToWideChar(CP_UTF8, 0, source, -1, wpath, MAX_PATH) == 0) return NULL;
+	if (MultiByteToWideChar(CP_UTF8, 0, source, -1, wpath, MAX_PATH) == 0) return false;
 
 	IWICBitmapDecoder *decoder = NULL;
 	if (FAILED(IWICImagingFactory_CreateDecoderFromFilename(
 		  wic, wpath, NULL, GENERIC_READ, WICDecodeMetadataCacheOnLoad, &decoder
 		)))
-		return NULL;
+		return false;
 
-	IWICBitmapFrameDecode *frame  = NULL;
-	IWICFormatConverter   *conv   = NULL;
-	ID2D1Bitmap1          *bitmap = NULL;
-	if (SUCCEEDED(IWICBitmapDecoder_GetFrame(decoder, 0, &frame))
-		&& SUCCEEDED(IWICImagingFactory_CreateFormatConverter(wic, &conv))
-		&& SUCCEEDED(IWICFormatConverter_Initialize(
-		  conv, ( IWICBitmapSource * ) frame, &GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone, NULL, 0.0,
-		  WICBitmapPaletteTypeMedianCut
-		)))
-		bitmap = image_bitmap_from_converter(dc, conv, out_w, out_h);
+	IWICBitmapFrameDecode *frame = NULL;
+	bool                   ok    = false;
+	if (SUCCEEDED(IWICBitmapDecoder_GetFrame(decoder, 0, &frame)))
+		ok = image_convert(wic, ( IWICBitmapSource * ) frame, box_w, box_h, out, natural_w, natural_h);
 
-	if (conv) IWICFormatConverter_Release(conv);
 	if (frame) IWICBitmapFrameDecode_Release(frame);
 	IWICBitmapDecoder_Release(decoder);
+	return ok;
+}
+
+/* Runs on a pool thread, which image_pool_callback has put in the MTA. */
+static bool image_decode(
+  void *ctx, char const *source, uint32_t box_w, uint32_t box_h, FluxImagePixels *out, uint32_t *natural_w,
+  uint32_t *natural_h
+) {
+	( void ) ctx;
+	IWICImagingFactory *wic = NULL;
+	if (FAILED(CoCreateInstance(
+		  &CLSID_WICImagingFactory, NULL, CLSCTX_INPROC_SERVER, &IID_IWICImagingFactory, ( void ** ) &wic
+		)))
+		return false;
+	bool ok = image_decode_wic(wic, source, box_w, box_h, out, natural_w, natural_h);
+	IWICImagingFactory_Release(wic);
+	return ok;
+}
+
+static void *image_upload(void *ctx, FluxImagePixels const *px) {
+	( void ) ctx;
+	D2D1_BITMAP_PROPERTIES1 props = {
+	  {DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED},
+      96.0f, 96.0f, D2D1_BITMAP_OPTIONS_NONE, NULL
+    };
+	D2D1_SIZE_U   size   = {px->width, px->height};
+	ID2D1Bitmap1 *bitmap = NULL;
+	if (FAILED(ID2D1DeviceContext_CreateBitmap1(
+		  ( ID2D1DeviceContext * ) g_device_context, size, px->data, px->stride, &props, &bitmap
+		)))
+		return NULL;
 	return bitmap;
 }
 
-static FluxImageEntry *image_find(char const *source) {
-	for (int i = 0; i < g_count; i++)
-		if (strcmp(g_entries [i].source, source) == 0) return &g_entries [i];
-	return NULL;
+static void image_release(void *ctx, void *bitmap) {
+	( void ) ctx;
+	ID2D1Bitmap1_Release(( ID2D1Bitmap1 * ) bitmap);
+}
+
+static VOID CALLBACK image_pool_callback(PTP_CALLBACK_INSTANCE instance, PVOID param) {
+	( void ) instance;
+	ImagePoolWork work = *( ImagePoolWork * ) param;
+	free(param);
+	HRESULT hr = CoInitializeEx(NULL, COINIT_MULTITHREADED);
+	work.fn(work.job);
+	if (SUCCEEDED(hr)) CoUninitialize();
 }
 
+static bool image_submit(void *ctx, FluxImageJobFn fn, void *job) {
+	( void ) ctx;
+	ImagePoolWork *work = ( ImagePoolWork * ) malloc(sizeof(*work));
+	if (!work) return false;
+	work->fn  = fn;
+	work->job = job;
+	if (TrySubmitThreadpoolCallback(image_pool_callback, work, NULL)) return true;
+	free(work);
+	return false;
+}
+
+static void image_lock(void *ctx) {
+	( void ) ctx;
+	AcquireSRWLockExclusive(&g_lock);
+}
+
+static void image_unlock(void *ctx) {
+	( void ) ctx;
+	ReleaseSRWLockExclusive(&g_lock);
+}
+
+static FluxImageBackend const g_backend = {
+  .decode  = image_decode,
+  .upload  = image_upload,
+  .release = image_release,
+  .submit  = image_submit,
+  .lock    = image_lock,
+  .unlock  = image_unlock,
+};
+
 void flux_image_cache_release_all(void) {
-	for (int i = 0; i < g_count; i++) {
-		if (g_entries [i].bitmap) ID2D1Bitmap1_Release(g_entries [i].bitmap);
-		free(g_entries [i].source);
-	}
-	g_count          = 0;
+	flux_image_store_destroy(g_store);
+	g_store          = NULL;
 	g_device_context = NULL;
 }
 
-void *flux_image_cache_acquire(void *device_context, char const *source, float *out_w, float *out_h) {
+void *flux_image_cache_acquire(
+  void *device_context, char const *source, uint32_t want_w, uint32_t want_h, FluxImageInfo *out
+) {
+	if (out) *out = (FluxImageInfo) {.state = FLUX_IMAGE_FAILED};
 	if (!device_context || !source || !source [0]) return NULL;
 
+	/* Bitmaps belong to the device context that created them. */
 	if (device_context != g_device_context) {
 		flux_image_cache_release_all();
 		g_device_context = device_context;
 	}
-
-	FluxImageEntry *hit = image_find(source);
-	if (hit) {
-		if (out_w) *out_w = hit->w;
-		if (out_h) *out_h = hit->h;
-		return hit->bitmap;
-	}
-	if (g_count >= FLUX_IMAGE_CACHE_CAP) return NULL;
-
-	float         w = 0.0f, h = 0.0f;
-	ID2D1Bitmap1 *bmp = image_decode(( ID2D1DeviceContext * ) device_context, source, &w, &h);
-	if (!bmp) return NULL;
-
-	FluxImageEntry *e = &g_entries [g_count++];
-	e->source         = _strdup(source);
-	e->bitmap         = bmp;
-	e->w              = w;
-	e->h              = h;
-	if (out_w) *out_w = w;
-	if (out_h) *out_h = h;
-	return bmp;
+	if (!g_store) g_store = flux_image_store_create(&g_backend, FLUX_IMAGE_STORE_BUDGET);
+	return flux_image_store_acquire(g_store, source, want_w, want_h, out);
 }
@@ -2,6 +2,11 @@
  * @file flux_image_cache.h
  * @brief WIC-backed decode + Direct2D bitmap cache for the Image control.
  *
+ * Decodes run on the thread pool at the size the image is drawn at; see
+ * flux_image_store.h for the budgeted, platform-neutral cache underneath. A
+ * source is drawn as a placeholder (the caller's choice) while pending, and
+ * the caller asks for another frame.
+ *
  * Isolated from cd2d.h: the implementation includes the real Windows
  * Direct2D/WIC headers, so this interface speaks only in void* COM pointers.
  * The returned bitmap is a Direct2D bitmap (ID2D1Bitmap1) usable anywhere an
@@ -10,23 +15,35 @@
 #ifndef FLUX_IMAGE_CACHE_H
 #define FLUX_IMAGE_CACHE_H
 
+#include "render/flux_image_store.h"
+
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
 /**
- * @brief Get (decoding and caching on first use) the Direct2D bitmap for a source.
+ * @brief Get the Direct2D bitmap for a source, queueing its decode on first use.
+ *
+ * The image is decoded to cover @p want_w x @p want_h device pixels (rounded
+ * up to a size bucket, never above the natural size); 0 x 0 asks for the
+ * natural size. Draw the returned bitmap scaled to its destination: its pixel
+ * size is in @p out, next to the natural size layout should use.
  *
  * @param device_context  The active ID2D1DeviceContext (passed as void*).
  * @param source          UTF-8 file path / URI; NULL or empty returns NULL.
- * @param out_w           Receives natural pixel width (may be NULL).
- * @param out_h           Receives natural pixel height (may be NULL).
- * @return Borrowed ID2D1Bitmap1* (owned by the cache), or NULL on failure.
+ * @param out             Receives the state and sizes (may be NULL). While the
+ *                        state is pending the caller should request another frame.
+ * @return Borrowed ID2D1Bitmap1* (owned by the cache); NULL on failure or while
+ *         pending, unless another size of the same source can stand in.
  */
-void *flux_image_cache_acquire(void *device_context, char const *source, float *out_w, float *out_h);
+void *flux_image_cache_acquire(
+  void *device_context, char const *source, uint32_t want_w, uint32_t want_h, FluxImageInfo *out
+);
 
-/** @brief Release every cached bitmap and the WIC factory (call on shutdown / device loss). */
+/** @brief Release every cached bitmap and cancel pending decodes (call on shutdown / device loss). */
 void  flux_image_cache_release_all(void);
 
 #ifdef __cplusplus
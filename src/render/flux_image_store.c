@@ -0,0 +1,399 @@
+#include "flux_image_store.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct ImageJob ImageJob;
+
+typedef struct ImageEntry {
+	FluxImageStore *store;
+	ImageJob       *job;    /**< Decode in flight; NULL once its result has landed. */
+	void           *bitmap;
+	uint32_t        width;
+	uint32_t        height;
+	uint32_t        natural_w;
+	uint32_t        natural_h;
+	FluxImageState  state;
+} ImageEntry;
+
+/* A decode request. The worker owns it until it is published on the finished
+ * list; @c entry is cleared (under the lock) when the entry goes away, which
+ * cancels the job and makes whoever holds it last free it. */
+struct ImageJob {
+	FluxImageBackend backend; /**< Copy: the job may outlive its store. */
+	FluxImageStore  *store;   /**< Valid while @c entry is set. */
+	ImageEntry      *entry;
+	ImageJob        *next;    /**< Finished list link. */
+	uint32_t         bucket [2];
+	FluxImagePixels  levels [FLUX_IMAGE_MIP_LEVELS];
+	uint32_t         level_count; /**< Levels decoded; 0 on failure. */
+	uint32_t         natural_w;
+	uint32_t         natural_h;
+	uint32_t         source_len;
+	char             source [];
+};
+
+struct FluxImageStore {
+	FluxImageBackend backend;
+	FluxLru         *cache;
+	ImageJob        *finished; /**< Published by workers, drained by the owner; guarded by the lock. */
+	uint32_t         pending;
+	uint64_t         decoded;
+	uint64_t         mips;
+	uint64_t         failed;
+};
+
+static void image_lock(FluxImageBackend const *b) {
+	if (b->lock) b->lock(b->ctx);
+}
+
+static void image_unlock(FluxImageBackend const *b) {
+	if (b->unlock) b->unlock(b->ctx);
+}
+
+static FluxLruKey image_key(char const *source, uint32_t len, uint32_t const bucket [2]) {
+	FluxLruKey key = {0};
+	key.data [0]   = source;
+	key.len [0]    = len;
+	key.data [1]   = bucket;
+	key.len [1]    = 2 * sizeof(uint32_t);
+	return key;
+}
+
+static uint32_t image_bucket(uint32_t v) {
+	if (!v) return 0;
+	uint32_t b = FLUX_IMAGE_MIN_BUCKET;
+	while (b < v && b < FLUX_IMAGE_MAX_BUCKET) b <<= 1;
+	return b;
+}
+
+static void image_job_free(ImageJob *job) {
+	for (uint32_t k = 0; k < FLUX_IMAGE_MIP_LEVELS; k++) free(job->levels [k].data);
+	free(job);
+}
+
+/* 2x2 box filter; premultiplied channels average without fringes. An odd last
+ * row or column is averaged with itself. */
+static bool image_halve(FluxImagePixels const *src, FluxImagePixels *dst) {
+	uint32_t w    = (src->width + 1) / 2;
+	uint32_t h    = (src->height + 1) / 2;
+	uint8_t *data = ( uint8_t * ) malloc(( size_t ) w * h * 4u);
+	if (!data) return false;
+	for (uint32_t y = 0; y < h; y++) {
+		uint8_t const *r0  = src->data + ( size_t ) (2 * y) * src->stride;
+		uint8_t const *r1  = 2 * y + 1 < src->height ? r0 + src->stride : r0;
+		uint8_t       *out = data + ( size_t ) y * w * 4u;
+		for (uint32_t x = 0; x < w; x++) {
+			uint32_t x0 = 2 * x * 4u;
+			uint32_t x1 = 2 * x + 1 < src->width ? x0 + 4u : x0;
+			for (uint32_t c = 0; c < 4; c++)
+				out [x * 4u + c] = ( uint8_t ) ((r0 [x0 + c] + r0 [x1 + c] + r1 [x0 + c] + r1 [x1 + c] + 2u) >> 2);
+		}
+	}
+	dst->data   = data;
+	dst->width  = w;
+	dst->height = h;
+	dst->stride = w * 4u;
+	return true;
+}
+
+/* Worker side: decode the bucket, then halve while each halving is exactly
+ * what the next smaller bucket would decode to. That holds only when the
+ * decode scaled down; a natural-size decode gets no levels. */
+static void image_job_decode(ImageJob *job) {
+	FluxImagePixels *px = &job->levels [0];
+	if (!job->backend.decode(
+		  job->backend.ctx, job->source, job->bucket [0], job->bucket [1], px, &job->natural_w, &job->natural_h
+		))
+		return;
+	if (!px->data || !px->width || !px->height || px->stride < px->width * 4u) return;
+	job->level_count = 1;
+
+	for (uint32_t k = 1; k < FLUX_IMAGE_MIP_LEVELS; k++) {
+		uint32_t bw = job->bucket [0] >> k, bh = job->bucket [1] >> k;
+		if ((bw && bw < FLUX_IMAGE_MIN_BUCKET) || (bh && bh < FLUX_IMAGE_MIN_BUCKET)) break;
+		uint32_t fw, fh;
+		flux_image_fit_size(job->natural_w, job->natural_h, bw, bh, &fw, &fh);
+		FluxImagePixels const *prev = &job->levels [k - 1];
+		if (fw != (prev->width + 1) / 2 || fh != (prev->height + 1) / 2) break;
+		if (!image_halve(prev, &job->levels [k])) break;
+		job->level_count++;
+	}
+}
+
+/* Worker side. A job cancelled before it starts is not decoded at all. */
+static void image_job_run(void *arg) {
+	ImageJob        *job = ( ImageJob * ) arg;
+	FluxImageBackend b   = job->backend;
+
+	image_lock(&b);
+	bool cancelled = !job->entry;
+	image_unlock(&b);
+	if (!cancelled) image_job_decode(job);
+
+	image_lock(&b);
+	cancelled = !job->entry;
+	if (!cancelled) {
+		job->next            = job->store->finished;
+		job->store->finished = job;
+	}
+	image_unlock(&b);
+	if (cancelled) image_job_free(job);
+}
+
+/* Cache release callback: evicted, or the store is being destroyed. */
+static void image_entry_release(void *value) {
+	ImageEntry     *e = ( ImageEntry * ) value;
+	FluxImageStore *s = e->store;
+	if (e->job) {
+		image_lock(&s->backend);
+		e->job->entry = NULL;
+		image_unlock(&s->backend);
+		s->pending--;
+	}
+	if (e->bitmap) s->backend.release(s->backend.ctx, e->bitmap);
+	free(e);
+}
+
+/* Detach a pending entry from its job, which is then cancelled. */
+static void image_cancel(FluxImageStore *s, ImageEntry *e) {
+	image_lock(&s->backend);
+	e->job->entry = NULL;
+	image_unlock(&s->backend);
+	e->job = NULL;
+	s->pending--;
+}
+
+/* Hand level @p k's upload (NULL when it failed) to @p e; returns the bytes to charge. */
+static size_t image_fill(FluxImageStore *s, ImageEntry *e, ImageJob const *job, uint32_t k, void *bitmap) {
+	if (!bitmap) {
+		e->state = FLUX_IMAGE_FAILED;
+		s->failed++;
+		return 0;
+	}
+	e->bitmap    = bitmap;
+	e->width     = job->levels [k].width;
+	e->height    = job->levels [k].height;
+	e->natural_w = job->natural_w;
+	e->natural_h = job->natural_h;
+	e->state     = FLUX_IMAGE_READY;
+	return ( size_t ) e->width * e->height * 4u;
+}
+
+static void *image_upload(FluxImageStore *s, ImageJob const *job, uint32_t k) {
+	return k < job->level_count ? s->backend.upload(s->backend.ctx, &job->levels [k]) : NULL;
+}
+
+/* A halved level becomes the entry of its bucket unless that one is already
+ * decoded; a pending one is completed here and its own decode cancelled. A
+ * level that fails to upload is skipped: its bucket can still decode. */
+static void image_land_level(FluxImageStore *s, ImageJob *job, uint32_t k) {
+	uint32_t    bucket [2] = {job->bucket [0] >> k, job->bucket [1] >> k};
+	FluxLruKey  key        = image_key(job->source, job->source_len, bucket);
+	ImageEntry *e          = ( ImageEntry * ) flux_lru_get(s->cache, &key);
+	if (e && e->state != FLUX_IMAGE_PENDING) return;
+	ImageEntry *fresh = e ? NULL : ( ImageEntry * ) calloc(1, sizeof(*e));
+	if (!e && !fresh) return;
+	void *bitmap = image_upload(s, job, k);
+	if (!bitmap) {
+		free(fresh);
+		return;
+	}
+	if (e) {
+		image_cancel(s, e);
+	} else {
+		e        = fresh;
+		e->store = s;
+	}
+	size_t cost = image_fill(s, e, job, k, bitmap);
+	s->mips++;
+	flux_lru_put(s->cache, &key, e, cost);
+}
+
+/* Owner side: upload the result and re-charge the entry at its pixel size.
+ * Levels land smallest first so the requested bucket ends up most recent and
+ * is the one the trim spares; if a level's trim evicted it, the job was
+ * cancelled and only the levels remain. */
+static void image_land(FluxImageStore *s, ImageJob *job) {
+	for (uint32_t k = job->level_count; k-- > 1;) image_land_level(s, job, k);
+	ImageEntry *e = job->entry;
+	if (!e) return;
+	e->job = NULL;
+	s->pending--;
+
+	size_t cost = image_fill(s, e, job, 0, image_upload(s, job, 0));
+	if (e->state == FLUX_IMAGE_READY) s->decoded++;
+	FluxLruKey key = image_key(job->source, job->source_len, job->bucket);
+	flux_lru_put(s->cache, &key, e, cost);
+}
+
+static ImageEntry *
+image_queue(FluxImageStore *s, char const *source, uint32_t len, uint32_t const bucket [2], FluxLruKey const *key) {
+	ImageEntry *e   = ( ImageEntry * ) calloc(1, sizeof(*e));
+	ImageJob   *job = ( ImageJob * ) calloc(1, sizeof(*job) + len + 1u);
+	if (!e || !job) {
+		free(e);
+		free(job);
+		return NULL;
+	}
+	job->backend    = s->backend;
+	job->store      = s;
+	job->entry      = e;
+	job->source_len = len;
+	job->bucket [0] = bucket [0];
+	job->bucket [1] = bucket [1];
+	memcpy(job->source, source, len + 1u);
+	e->store = s;
+	e->job   = job;
+	e->state = FLUX_IMAGE_PENDING;
+
+	s->pending++;
+	if (!flux_lru_put(s->cache, key, e, 0)) { /* released e, which cancelled the job */
+		image_job_free(job);
+		return NULL;
+	}
+
+	/* Without a worker (or when the pool refuses) decode here rather than fail the image. */
+	if (!s->backend.submit || !s->backend.submit(s->backend.ctx, image_job_run, job)) {
+		image_job_decode(job);
+		image_land(s, job);
+		e = job->entry;
+		image_job_free(job);
+	}
+	return e;
+}
+
+/* While a bucket decodes, a larger ready bucket (sharp) or a smaller one
+ * (soft) of the same source is better than an empty placeholder. */
+static ImageEntry *
+image_stand_in(FluxImageStore *s, char const *source, uint32_t len, uint32_t const bucket [2]) {
+	static int const shifts [] = {1, 2, -1, -2};
+	for (size_t i = 0; i < sizeof(shifts) / sizeof(shifts [0]); i++) {
+		uint32_t side [2];
+		bool     valid = true;
+		for (int d = 0; d < 2; d++) {
+			side [d] = shifts [i] > 0 ? bucket [d] << shifts [i] : bucket [d] >> -shifts [i];
+			if (side [d] && (side [d] < FLUX_IMAGE_MIN_BUCKET || side [d] > FLUX_IMAGE_MAX_BUCKET)) valid = false;
+		}
+		if (!valid || (!side [0] && !side [1])) continue;
+		FluxLruKey  key = image_key(source, len, side);
+		ImageEntry *e   = ( ImageEntry * ) flux_lru_get(s->cache, &key);
+		if (e && e->state == FLUX_IMAGE_READY) return e;
+	}
+	return NULL;
+}
+
+FluxImageStore *flux_image_store_create(FluxImageBackend const *backend, size_t budget) {
+	if (!backend || !backend->decode || !backend->upload || !backend->release) return NULL;
+	FluxImageStore *s = ( FluxImageStore * ) calloc(1, sizeof(*s));
+	if (!s) return NULL;
+	s->backend = *backend;
+	s->cache   = flux_lru_create(budget, image_entry_release);
+	if (!s->cache) {
+		free(s);
+		return NULL;
+	}
+	return s;
+}
+
+void flux_image_store_destroy(FluxImageStore *store) {
+	if (!store) return;
+	flux_lru_destroy(store->cache);
+
+	image_lock(&store->backend);
+	ImageJob *job   = store->finished;
+	store->finished = NULL;
+	image_unlock(&store->backend);
+	while (job) {
+		ImageJob *next = job->next;
+		image_job_free(job);
+		job = next;
+	}
+	free(store);
+}
+
+uint32_t flux_image_store_drain(FluxImageStore *store) {
+	if (!store) return 0;
+	image_lock(&store->backend);
+	ImageJob *job   = store->finished;
+	store->finished = NULL;
+	image_unlock(&store->backend);
+
+	/* Only this thread clears job->entry, so it can be read without the lock. */
+	uint32_t landed = 0;
+	while (job) {
+		ImageJob *next = job->next;
+		if (job->entry) {
+			image_land(store, job);
+			landed++;
+		}
+		image_job_free(job);
+		job = next;
+	}
+	return landed;
+}
+
+void flux_image_fit_size(
+  uint32_t natural_w, uint32_t natural_h, uint32_t box_w, uint32_t box_h, uint32_t *out_w, uint32_t *out_h
+) {
+	uint64_t w = natural_w, h = natural_h;
+	if ((box_w || box_h) && natural_w && natural_h) {
+		/* Cover: the side with the larger scale is pinned to the box, the other rounds up. */
+		if (( uint64_t ) box_w * natural_h >= ( uint64_t ) box_h * natural_w) {
+			w = box_w;
+			h = (( uint64_t ) natural_h * box_w + natural_w - 1) / natural_w;
+		} else {
+			h = box_h;
+			w = (( uint64_t ) natural_w * box_h + natural_h - 1) / natural_h;
+		}
+		if (w > natural_w || h > natural_h) {
+			w = natural_w;
+			h = natural_h;
+		}
+	}
+	if (out_w) *out_w = w ? ( uint32_t ) w : 1u;
+	if (out_h) *out_h = h ? ( uint32_t ) h : 1u;
+}
+
+void *flux_image_store_acquire(
+  FluxImageStore *store, char const *source, uint32_t want_w, uint32_t want_h, FluxImageInfo *out
+) {
+	if (out) *out = (FluxImageInfo) {.state = FLUX_IMAGE_FAILED};
+	if (!store || !source || !source [0]) return NULL;
+	flux_image_store_drain(store);
+
+	size_t len = strlen(source);
+	if (len > UINT32_MAX) return NULL;
+	uint32_t    bucket [2] = {image_bucket(want_w), image_bucket(want_h)};
+	FluxLruKey  key        = image_key(source, ( uint32_t ) len, bucket);
+	ImageEntry *e          = ( ImageEntry * ) flux_lru_get(store->cache, &key);
+	if (!e) e = image_queue(store, source, ( uint32_t ) len, bucket, &key);
+	if (!e) return NULL;
+
+	FluxImageState state = e->state;
+	if (state == FLUX_IMAGE_PENDING) e = image_stand_in(store, source, ( uint32_t ) len, bucket);
+	if (out) out->state = state;
+	if (!e || e->state != FLUX_IMAGE_READY) return NULL;
+	if (out) {
+		out->width     = e->width;
+		out->height    = e->height;
+		out->natural_w = e->natural_w;
+		out->natural_h = e->natural_h;
+	}
+	return e->bitmap;
+}
+
+void flux_image_store_set_budget(FluxImageStore *store, size_t budget) {
+	if (store) flux_lru_set_budget(store->cache, budget);
+}
+
+void flux_image_store_stats(FluxImageStore const *store, FluxImageStoreStats *out) {
+	if (!out) return;
+	memset(out, 0, sizeof(*out));
+	if (!store) return;
+	flux_lru_stats(store->cache, &out->cache);
+	out->pending = store->pending;
+	out->decoded = store->decoded;
+	out->mips    = store->mips;
+	out->failed  = store->failed;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file flux_image_store.h
+ * @brief Asynchronous, byte-budgeted image cache behind a pluggable backend.
+ *
+ * Platform-neutral: decoding, GPU upload and threading all go through a
+ * FluxImageBackend, so the cache logic runs (and is tested) without WIC or
+ * Direct2D. Decodes run on the backend's workers and produce CPU pixels; the
+ * owner thread drains finished decodes, uploads them, and hands out the
+ * uploaded bitmaps. Until then a lookup reports the image as pending so the
+ * caller can draw a placeholder and ask for another frame.
+ *
+ * Images are decoded to the size they are drawn at, not their natural size.
+ * A request names the device-pixel box the image must cover; the box is
+ * rounded up to power-of-two buckets and the entry is keyed on (source,
+ * bucket). A decode that had to scale down also box-filters up to
+ * FLUX_IMAGE_MIP_LEVELS - 1 halved levels, which land as the entries of the
+ * smaller buckets, so a shrinking thumbnail needs no new decode. While a
+ * bucket is pending, a ready neighbouring bucket of the same source is drawn
+ * in its place.
+ *
+ * Entries live in a FluxLru (hashed keys, intrusive LRU): a ready image
+ * is charged its pixel bytes, and the least recently used images are released
+ * once the budget is exceeded. Failed decodes are cached too, so a broken
+ * source is not decoded again every frame.
+ *
+ * Only FluxImageBackend::decode runs off the owner thread. An entry evicted
+ * while its decode is in flight cancels the job: the worker skips it if it
+ * has not started and drops the result otherwise.
+ * @note This is an internal header; do not include from public API.
+ */
+#ifndef FLUX_IMAGE_STORE_H
+#define FLUX_IMAGE_STORE_H
+
+#include "runtime/flux_lru.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Default byte budget of the image cache (uploaded pixel bytes). */
+#define FLUX_IMAGE_STORE_BUDGET     (64u * 1024u * 1024u)
+
+/** @brief Levels kept per decode: the decoded size plus this many minus one halvings. */
+#define FLUX_IMAGE_MIP_LEVELS       3u
+
+/** @brief Smallest bucket side; requests below it share one bucket. */
+#define FLUX_IMAGE_MIN_BUCKET       16u
+
+/** @brief Largest bucket side; larger requests use this bucket. */
+#define FLUX_IMAGE_MAX_BUCKET       8192u
+
+typedef struct FluxImageStore FluxImageStore;
+
+/** @brief Decoded image: 32bpp premultiplied BGRA rows, @p stride bytes apart. */
+typedef struct FluxImagePixels {
+	uint8_t *data; /**< malloc'd by the decoder; the store frees it after upload. */
+	uint32_t width;
+	uint32_t height;
+	uint32_t stride;
+} FluxImagePixels;
+
+/** @brief Where a source stands in the cache. */
+typedef enum FluxImageState
+{
+	FLUX_IMAGE_PENDING = 0, /**< Decode queued or running; draw a placeholder. */
+	FLUX_IMAGE_READY,       /**< Bitmap uploaded. */
+	FLUX_IMAGE_FAILED,      /**< Decode or upload failed; not retried while cached. */
+} FluxImageState;
+
+/** @brief Runs @p job on a worker thread. */
+typedef void (*FluxImageJobFn)(void *job);
+
+/**
+ * @brief Platform hooks of a store. Every hook receives @c ctx.
+ *
+ * @c decode is called on a worker; the rest on the owner thread, except
+ * @c lock / @c unlock, which guard the hand-off between the two. The backend
+ * must outlive the store and any decode still running after its destruction.
+ */
+typedef struct FluxImageBackend {
+	void *ctx;
+	/**
+	 * Decode @p source into @p out at the size flux_image_fit_size gives for
+	 * (@p box_w, @p box_h), and report its natural size; false on failure.
+	 */
+	bool (*decode)(
+	  void *ctx, char const *source, uint32_t box_w, uint32_t box_h, FluxImagePixels *out, uint32_t *natural_w,
+	  uint32_t *natural_h
+	);
+	/** Create a GPU bitmap from @p pixels (owner thread); NULL on failure. */
+	void *(*upload)(void *ctx, FluxImagePixels const *pixels);
+	/** Release a bitmap returned by @c upload. */
+	void (*release)(void *ctx, void *bitmap);
+	/** Queue @p fn (@p job) on a worker; false if it could not be queued. NULL decodes inline. */
+	bool (*submit)(void *ctx, FluxImageJobFn fn, void *job);
+	void (*lock)(void *ctx);   /**< May be NULL with an inline or single-threaded @c submit. */
+	void (*unlock)(void *ctx); /**< May be NULL with an inline or single-threaded @c submit. */
+} FluxImageBackend;
+
+/** @brief What an acquire returned. */
+typedef struct FluxImageInfo {
+	FluxImageState state;     /**< State of the requested bucket. */
+	uint32_t       width;     /**< Pixel size of the returned bitmap (0 when NULL). */
+	uint32_t       height;
+	uint32_t       natural_w; /**< Natural size of the source (0 until decoded). */
+	uint32_t       natural_h;
+} FluxImageInfo;
+
+/** @brief Store counters (zeroed for NULL). */
+typedef struct FluxImageStoreStats {
+	FluxLruStats cache;   /**< Entry LRU: hits, misses, evictions and bytes against the budget. */
+	uint32_t     pending; /**< Decodes submitted whose result has not been drained. */
+	uint64_t     decoded; /**< Decodes uploaded. */
+	uint64_t     mips;    /**< Halved levels uploaded from those decodes. */
+	uint64_t     failed;  /**< Decodes or uploads that failed. */
+} FluxImageStoreStats;
+
+/** @brief Create an empty store over @p backend (copied); NULL if @p backend lacks decode/upload/release. */
+XENT_NODISCARD FluxImageStore *flux_image_store_create(FluxImageBackend const *backend, size_t budget);
+
+/** @brief Release every bitmap, cancel decodes in flight and free the store (NULL is safe). */
+void                           flux_image_store_destroy(FluxImageStore *store);
+
+/**
+ * @brief Size a decode of a @p natural_w x @p natural_h image takes for a box.
+ *
+ * Scales to cover @p box_w x @p box_h with the aspect ratio kept (a zero side
+ * is unconstrained, 0 x 0 keeps the natural size) and never scales up.
+ */
+void  flux_image_fit_size(
+  uint32_t natural_w, uint32_t natural_h, uint32_t box_w, uint32_t box_h, uint32_t *out_w, uint32_t *out_h
+);
+
+/**
+ * @brief Bitmap covering @p want_w x @p want_h device pixels for @p source.
+ *
+ * Drains finished decodes first and queues the bucket's decode on first use.
+ * While the bucket is pending a ready neighbouring bucket may be returned,
+ * with @c out->state still FLUX_IMAGE_PENDING; otherwise NULL until ready.
+ * A want of 0 x 0 asks for the natural size.
+ *
+ * @param out Receives the state and sizes (may be NULL).
+ * @return Borrowed bitmap, or NULL.
+ */
+void *flux_image_store_acquire(
+  FluxImageStore *store, char const *source, uint32_t want_w, uint32_t want_h, FluxImageInfo *out
+);
+
+/** @brief Upload every finished decode; returns how many entries left the pending state. */
+uint32_t flux_image_store_drain(FluxImageStore *store);
+
+/** @brief Change the budget, releasing least recently used images until it holds. */
+void     flux_image_store_set_budget(FluxImageStore *store, size_t budget);
+
+/** @brief Counters and occupancy. */
+void     flux_image_store_stats(FluxImageStore const *store, FluxImageStoreStats *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -4,8 +4,10 @@
 
 #include <cd2d.h>
 #include "flux_render_cache.h"
+#include "flux_anim.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -22,6 +24,21 @@ typedef struct FluxCacheSlot {
 	FluxCacheEntry entry;
 } FluxCacheSlot;
 
+/* Tweens of one property in flight, as parallel arrays so the frame pass is a
+ * straight loop the compiler can vectorize. Element i belongs to the entry in
+ * slots [slot [i]], whose tween records i + 1 in its lane field. */
+typedef struct FluxTweenLane {
+	uint32_t *slot;
+	double   *start;
+	double   *duration;
+	float    *from;
+	float    *delta;
+	double   *progress; /* pass output: clamped linear progress */
+	float    *value;    /* pass output: eased value (eased progress for color) */
+	uint32_t  count;
+	uint32_t  cap;
+} FluxTweenLane;
+
 struct FluxRenderCache {
 	FluxCacheSlot *slots;
 	uint32_t       capacity;
@@ -29,8 +46,108 @@ struct FluxRenderCache {
 	uint32_t       tombstones;
 	uint32_t       max_entries;
 	uint64_t       frame;
+	FluxTweenLane  lanes [FLUX_TWEEN_PROP_COUNT];
+	double         advanced_at; /* now of the last advance */
+	bool           advanced;
+};
+
+static size_t const k_tween_offset [FLUX_TWEEN_COLOR] = {
+  offsetof(FluxCacheEntry, hover_anim),  offsetof(FluxCacheEntry, press_anim),
+  offsetof(FluxCacheEntry, focus_anim),  offsetof(FluxCacheEntry, check_anim),
+  offsetof(FluxCacheEntry, slider_anim), offsetof(FluxCacheEntry, progress_anim),
 };
 
+static FluxTween *rc_tween(FluxCacheEntry *e, FluxTweenProp prop) {
+	return ( FluxTween * ) (( char * ) e + k_tween_offset [prop]);
+}
+
+static uint32_t *rc_lane_ref(FluxCacheEntry *e, FluxTweenProp prop) {
+	return prop == FLUX_TWEEN_COLOR ? &e->color_anim.lane : &rc_tween(e, prop)->lane;
+}
+
+static uint32_t rc_slot_index(FluxRenderCache const *cache, FluxCacheEntry const *e) {
+	FluxCacheSlot const *s = ( FluxCacheSlot const * ) (( char const * ) e - offsetof(FluxCacheSlot, entry));
+	return ( uint32_t ) (s - cache->slots);
+}
+
+static bool rc_grow_array(void **arr, uint32_t cap, size_t elem) {
+	void *grown = realloc(*arr, ( size_t ) cap * elem);
+	if (!grown) return false;
+	*arr = grown;
+	return true;
+}
+
+static bool rc_lane_reserve(FluxTweenLane *l) {
+	if (l->count < l->cap) return true;
+	uint32_t cap = l->cap ? l->cap * 2 : 64;
+	if (!rc_grow_array(( void ** ) &l->slot, cap, sizeof(*l->slot))
+		|| !rc_grow_array(( void ** ) &l->start, cap, sizeof(*l->start))
+		|| !rc_grow_array(( void ** ) &l->duration, cap, sizeof(*l->duration))
+		|| !rc_grow_array(( void ** ) &l->from, cap, sizeof(*l->from))
+		|| !rc_grow_array(( void ** ) &l->delta, cap, sizeof(*l->delta))
+		|| !rc_grow_array(( void ** ) &l->progress, cap, sizeof(*l->progress))
+		|| !rc_grow_array(( void ** ) &l->value, cap, sizeof(*l->value)))
+		return false;
+	l->cap = cap;
+	return true;
+}
+
+/* Enrolls (or re-times) one tween. On allocation failure it stays out of the
+ * lane and flux_render_cache_tween evaluates it on the spot instead. */
+static void rc_lane_set(
+  FluxRenderCache *cache, FluxCacheEntry *e, FluxTweenProp prop, double start, double duration, float from, float delta
+) {
+	FluxTweenLane *l    = &cache->lanes [prop];
+	uint32_t      *lane = rc_lane_ref(e, prop);
+	if (*lane == 0) {
+		if (!rc_lane_reserve(l)) return;
+		*lane = ++l->count;
+	}
+	uint32_t i      = *lane - 1;
+	l->slot [i]     = rc_slot_index(cache, e);
+	l->start [i]    = start;
+	l->duration [i] = duration > 0.0 ? duration : 1.0;
+	l->from [i]     = from;
+	l->delta [i]    = delta;
+	l->progress [i] = 0.0;
+	l->value [i]    = from;
+}
+
+static void rc_lane_remove(FluxRenderCache *cache, FluxCacheEntry *e, FluxTweenProp prop) {
+	FluxTweenLane *l    = &cache->lanes [prop];
+	uint32_t      *lane = rc_lane_ref(e, prop);
+	if (*lane == 0) return;
+	uint32_t i    = *lane - 1;
+	uint32_t last = --l->count;
+	*lane         = 0;
+	if (i == last) return;
+	l->slot [i]     = l->slot [last];
+	l->start [i]    = l->start [last];
+	l->duration [i] = l->duration [last];
+	l->from [i]     = l->from [last];
+	l->delta [i]    = l->delta [last];
+	l->progress [i] = l->progress [last];
+	l->value [i]    = l->value [last];
+	*rc_lane_ref(&cache->slots [l->slot [i]].entry, prop) = i + 1;
+}
+
+static void rc_lanes_withdraw(FluxRenderCache *cache, FluxCacheEntry *e) {
+	for (int p = 0; p < FLUX_TWEEN_PROP_COUNT; p++) rc_lane_remove(cache, e, ( FluxTweenProp ) p);
+}
+
+static void rc_lanes_free(FluxRenderCache *cache) {
+	for (int p = 0; p < FLUX_TWEEN_PROP_COUNT; p++) {
+		FluxTweenLane *l = &cache->lanes [p];
+		free(l->slot);
+		free(l->start);
+		free(l->duration);
+		free(l->from);
+		free(l->delta);
+		free(l->progress);
+		free(l->value);
+	}
+}
+
 static uint32_t rc_hash(uint64_t key, uint32_t cap) {
 	uint64_t h  = key;
 	h          ^= h >> 33;
@@ -79,6 +196,15 @@ static bool rc_grow(FluxRenderCache *cache) {
 	cache->slots      = new_slots;
 	cache->capacity   = new_cap;
 	cache->tombstones = 0;
+
+	/* Entries moved; point their lane elements at the new slots. */
+	for (uint32_t i = 0; i < new_cap; i++) {
+		if (new_slots [i].tag != FLUX_RC_OCCUPIED) continue;
+		for (int p = 0; p < FLUX_TWEEN_PROP_COUNT; p++) {
+			uint32_t lane = *rc_lane_ref(&new_slots [i].entry, ( FluxTweenProp ) p);
+			if (lane) cache->lanes [p].slot [lane - 1] = i;
+		}
+	}
 	return true;
 }
 
@@ -113,6 +239,7 @@ void flux_render_cache_destroy(FluxRenderCache *cache) {
 	if (!cache) return;
 	for (uint32_t i = 0; i < cache->capacity; i++)
 		if (cache->slots [i].tag == FLUX_RC_OCCUPIED) release_entry_resources(&cache->slots [i].entry);
+	rc_lanes_free(cache);
 	free(cache->slots);
 	free(cache);
 }
@@ -174,6 +301,7 @@ void flux_render_cache_remove(FluxRenderCache *cache, uint64_t node_id) {
 	FluxCacheSlot *s = rc_find(cache, node_id);
 	if (!s) return;
 	release_entry_resources(&s->entry);
+	rc_lanes_withdraw(cache, &s->entry);
 	s->tag = FLUX_RC_DELETED;
 	cache->count--;
 	cache->tombstones++;
@@ -185,6 +313,7 @@ void flux_render_cache_clear(FluxRenderCache *cache) {
 		if (cache->slots [i].tag == FLUX_RC_OCCUPIED) release_entry_resources(&cache->slots [i].entry);
 		cache->slots [i].tag = FLUX_RC_EMPTY;
 	}
+	for (int p = 0; p < FLUX_TWEEN_PROP_COUNT; p++) cache->lanes [p].count = 0;
 	cache->count      = 0;
 	cache->tombstones = 0;
 }
@@ -193,6 +322,7 @@ uint32_t    flux_render_cache_count(FluxRenderCache const *cache) { return cache
 
 static void rc_delete_slot(FluxRenderCache *cache, uint32_t idx) {
 	release_entry_resources(&cache->slots [idx].entry);
+	rc_lanes_withdraw(cache, &cache->slots [idx].entry);
 	cache->slots [idx].tag = FLUX_RC_DELETED;
 	cache->count--;
 	cache->tombstones++;
@@ -229,6 +359,137 @@ void flux_render_cache_evict_lru(FluxRenderCache *cache, uint64_t age_threshold)
 	}
 }
 
+/* The vectorizable half of the pass: progress and eased value for every
+ * element, with the default ease-out-quad inlined (lanes hold no custom
+ * easing). No branches on the element and no stores outside the lane. */
+static void rc_lane_evaluate(FluxTweenLane *l, double now) {
+	uint32_t const n                = l->count;
+	double const *restrict start    = l->start;
+	double const *restrict duration = l->duration;
+	float const *restrict  from     = l->from;
+	float const *restrict  delta    = l->delta;
+	double *restrict       progress = l->progress;
+	float *restrict        value    = l->value;
+	for (uint32_t i = 0; i < n; i++) {
+		/* Same arithmetic as flux_tween_update, so both end on the same frame. */
+		double t     = (now - start [i]) / duration [i];
+		t            = t < 0.0 ? 0.0 : t;
+		t            = t > 1.0 ? 1.0 : t;
+		float  f     = ( float ) t;
+		progress [i] = t;
+		value [i]    = from [i] + delta [i] * (f * (2.0f - f));
+	}
+}
+
+/* Settles the entry of finished element @p i. Elements still running are left
+ * in the lane; the renderer picks their value up when it draws the entry, so
+ * the pass touches no entry that is still moving. */
+static void rc_lane_finish(FluxRenderCache *cache, FluxTweenLane const *l, FluxTweenProp prop, uint32_t i) {
+	FluxCacheEntry *e = &cache->slots [l->slot [i]].entry;
+	if (prop == FLUX_TWEEN_COLOR) {
+		e->color_anim.current_rgba = e->color_anim.target_rgba;
+		e->color_anim.active       = false;
+	}
+	else {
+		FluxTween *tw = rc_tween(e, prop);
+		tw->current   = tw->target;
+		tw->active    = false;
+	}
+	e->tween_mask &= ~(1u << prop);
+	rc_lane_remove(cache, e, prop);
+}
+
+uint32_t flux_render_cache_advance(FluxRenderCache *cache, double now) {
+	if (!cache) return 0;
+	cache->advanced_at = now;
+	cache->advanced    = true;
+
+	uint32_t moving    = 0;
+	for (int p = 0; p < FLUX_TWEEN_PROP_COUNT; p++) {
+		FluxTweenLane *l = &cache->lanes [p];
+		if (l->count == 0) continue;
+		rc_lane_evaluate(l, now);
+		/* Backwards, so a finished element swapped in from the end is already done with. */
+		for (uint32_t i = l->count; i-- > 0;)
+			if (l->progress [i] >= 1.0) rc_lane_finish(cache, l, ( FluxTweenProp ) p, i);
+		if (l->count) moving |= 1u << p;
+	}
+	return moving;
+}
+
+/* True when this frame's pass already put @p lane's tween at @p now. */
+static bool rc_lane_current(FluxRenderCache const *cache, uint32_t lane, double now) {
+	return lane != 0 && cache->advanced && cache->advanced_at == now;
+}
+
+bool flux_render_cache_tween(
+  FluxRenderCache *cache, FluxCacheEntry *ce, FluxTweenProp prop, float target, double duration, double now, float *out
+) {
+	if (!ce || prop >= FLUX_TWEEN_COLOR) {
+		*out = target;
+		return false;
+	}
+	FluxTween *tw = rc_tween(ce, prop);
+	if (!cache || tw->easing || !tw->initialized) return flux_tween_update(tw, target, duration, now, out);
+
+	bool const current = rc_lane_current(cache, tw->lane, now);
+	if (current) tw->current = cache->lanes [prop].value [tw->lane - 1];
+	if (fabsf(target - tw->target) > FLUX_ANIM_EPS) {
+		tw->start_val   = tw->current;
+		tw->target      = target;
+		tw->start_time  = now;
+		tw->duration    = duration;
+		tw->active      = true;
+		ce->tween_mask |= 1u << prop;
+		rc_lane_set(cache, ce, prop, now, duration, tw->start_val, target - tw->start_val);
+	}
+	else if (tw->active && !current) {
+		flux_tween_update(tw, target, duration, now, out);
+		if (!tw->active) {
+			rc_lane_remove(cache, ce, prop);
+			ce->tween_mask &= ~(1u << prop);
+		}
+	}
+	*out = tw->current;
+	return tw->active;
+}
+
+bool flux_render_cache_color_tween(
+  FluxRenderCache *cache, FluxCacheEntry *ce, FluxColor target, double duration, double now, FluxColor *out
+) {
+	if (!ce) {
+		*out = target;
+		return false;
+	}
+	FluxColorTween *tw = &ce->color_anim;
+	if (!cache || tw->easing || !tw->initialized) return flux_color_tween_update(tw, target, duration, now, out);
+
+	uint32_t const bit     = 1u << FLUX_TWEEN_COLOR;
+	bool const     current = rc_lane_current(cache, tw->lane, now);
+	if (current) {
+		float eased      = cache->lanes [FLUX_TWEEN_COLOR].value [tw->lane - 1];
+		tw->current_rgba = flux_anim_lerp_color((FluxColor) {tw->start_rgba}, (FluxColor) {tw->target_rgba}, eased).rgba;
+	}
+	if (tw->target_rgba != target.rgba) {
+		tw->start_rgba   = tw->current_rgba;
+		tw->target_rgba  = target.rgba;
+		tw->start_time   = now;
+		tw->duration     = duration;
+		tw->active       = true;
+		ce->tween_mask  |= bit;
+		rc_lane_set(cache, ce, FLUX_TWEEN_COLOR, now, duration, 0.0f, 1.0f);
+	}
+	else if (tw->active && !current) {
+		flux_color_tween_update(tw, target, duration, now, out);
+		if (!tw->active) {
+			rc_lane_remove(cache, ce, FLUX_TWEEN_COLOR);
+			ce->tween_mask &= ~bit;
+		}
+	}
+	*out = (FluxColor) {tw->current_rgba};
+	return tw->active;
+}
+
 ID2D1SolidColorBrush *flux_render_cache_brush(FluxRenderBrushRequest const *request) {
 	if (!request || !request->cache || !request->dc || !request->cached_rgba || !request->slot) return NULL;
 
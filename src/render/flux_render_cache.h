@@ -18,8 +18,16 @@
  * ## Animation Tweens
  *
  * Each cache entry contains FluxTween and FluxColorTween structs for
- * animating common properties. Renderers update these tweens each frame
- * to interpolate between current and target values.
+ * animating common properties. Renderers retarget them each frame through
+ * `flux_render_cache_tween()` and read the interpolated value back.
+ *
+ * Tweens in flight with the default easing are also enrolled in packed
+ * per-property lanes (start, duration, from, delta as parallel arrays).
+ * `flux_render_cache_advance()` evaluates every lane in one branch-free pass
+ * at frame start and returns which properties are still moving. It touches
+ * an entry only to settle a finished tween; a renderer picks the precomputed
+ * value up when it draws the entry instead of evaluating it. Scroll offsets are
+ * smoothed per frame rather than tweened and stay out of the lanes.
  *
  * ## Thread Safety
  *
@@ -47,6 +55,19 @@ extern "C"
 typedef struct ID2D1DeviceContext   ID2D1DeviceContext;
 typedef struct ID2D1SolidColorBrush ID2D1SolidColorBrush;
 
+/** @brief Tweened properties of a cache entry that have a packed lane. */
+typedef enum FluxTweenProp
+{
+	FLUX_TWEEN_HOVER = 0, /**< hover_anim */
+	FLUX_TWEEN_PRESS,     /**< press_anim */
+	FLUX_TWEEN_FOCUS,     /**< focus_anim */
+	FLUX_TWEEN_CHECK,     /**< check_anim */
+	FLUX_TWEEN_SLIDER,    /**< slider_anim */
+	FLUX_TWEEN_PROGRESS,  /**< progress_anim */
+	FLUX_TWEEN_COLOR,     /**< color_anim */
+	FLUX_TWEEN_PROP_COUNT
+} FluxTweenProp;
+
 /**
  * @brief Single-value animation tween.
  *
@@ -58,14 +79,15 @@ typedef struct ID2D1SolidColorBrush ID2D1SolidColorBrush;
  * is the standard WinUI-style short transition curve.
  */
 typedef struct FluxTween {
-	float  current;          /**< Current interpolated value (read this) */
-	float  target;           /**< Target value to animate toward */
-	float  start_val;        /**< Value at animation start */
-	double start_time;       /**< Monotonic time when animation began */
-	double duration;         /**< Animation duration in seconds */
-	bool   active;           /**< Animation is in progress */
-	bool   initialized;      /**< Tween has been set up at least once */
-	float  (*easing)(float); /**< Optional easing; NULL => ease-out-quad default */
+	float    current;          /**< Current interpolated value (read this) */
+	float    target;           /**< Target value to animate toward */
+	float    start_val;        /**< Value at animation start */
+	double   start_time;       /**< Monotonic time when animation began */
+	double   duration;         /**< Animation duration in seconds */
+	bool     active;           /**< Animation is in progress */
+	bool     initialized;      /**< Tween has been set up at least once */
+	float    (*easing)(float); /**< Optional easing; NULL => ease-out-quad default */
+	uint32_t lane;             /**< 1 + index in the cache's lane while enrolled; 0 otherwise */
 } FluxTween;
 
 /**
@@ -83,6 +105,7 @@ typedef struct FluxColorTween {
 	bool     active;
 	bool     initialized;
 	float    (*easing)(float); /**< Optional easing; NULL => ease-out-quad default */
+	uint32_t lane;             /**< 1 + index in the cache's lane while enrolled; 0 otherwise */
 } FluxColorTween;
 
 /**
@@ -111,6 +134,7 @@ typedef struct FluxCacheEntry {
 	FluxTween             scroll_anim_x; /**< Horizontal scroll position */
 	FluxTween             scroll_anim_y; /**< Vertical scroll position */
 	FluxColorTween        color_anim;    /**< Generic color transition */
+	uint32_t              tween_mask;    /**< Bit per FluxTweenProp still moving after the last advance */
 } FluxCacheEntry;
 
 typedef struct FluxRenderCache FluxRenderCache;
@@ -203,6 +227,44 @@ uint32_t              flux_render_cache_count(FluxRenderCache const *cache);
  */
 void                  flux_render_cache_evict_lru(FluxRenderCache *cache, uint64_t age_threshold);
 
+/**
+ * @brief Advance every enrolled tween to @p now in one pass over the lanes.
+ *
+ * Call once per frame, after flux_render_cache_begin_frame() and before
+ * drawing. Finished tweens land on their target and leave their lane.
+ *
+ * @param cache Cache instance (NULL is safe).
+ * @param now   Frame time in seconds (the render context's @c now).
+ * @return Bit per FluxTweenProp with a tween still moving; 0 when all are at rest.
+ */
+uint32_t              flux_render_cache_advance(FluxRenderCache *cache, double now);
+
+/**
+ * @brief Retarget a float tween of @p ce and read its value for this frame.
+ *
+ * Same contract as flux_tween_update(): a new target restarts the tween from
+ * its current value. A running tween is read as advanced by this frame's
+ * flux_render_cache_advance(); one the pass did not cover (custom easing, or
+ * no advance at @p now) is evaluated on the spot.
+ *
+ * @param cache    Cache owning @p ce.
+ * @param ce       Entry returned by this cache.
+ * @param prop     Float property (not FLUX_TWEEN_COLOR).
+ * @param target   Value to animate towards.
+ * @param duration Seconds a restart takes.
+ * @param now      Frame time in seconds.
+ * @param out      Receives the value.
+ * @return true while the tween is still moving.
+ */
+bool flux_render_cache_tween(
+  FluxRenderCache *cache, FluxCacheEntry *ce, FluxTweenProp prop, float target, double duration, double now, float *out
+);
+
+/** @brief flux_render_cache_tween() for @c color_anim. */
+bool flux_render_cache_color_tween(
+  FluxRenderCache *cache, FluxCacheEntry *ce, FluxColor target, double duration, double now, FluxColor *out
+);
+
 /**
  * @brief Get or create a solid color brush.
  *
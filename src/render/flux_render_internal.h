@@ -36,6 +36,12 @@
 /** @brief Initial capacity (commands) for the engine's command buffer. */
 #define FLUX_RENDER_COMMAND_INITIAL_CAPACITY 256
 
+/** @brief Initial capacity (bytes) for the engine's snapshot payload arena. */
+#define FLUX_RENDER_PAYLOAD_INITIAL_CAPACITY 16384u
+
+/** @brief Alignment of each payload in the arena. */
+#define FLUX_RENDER_PAYLOAD_ALIGN            8u
+
 /** @brief Render context passed to all control render functions. */
 /**
  * @brief Lets a control defer its solid background fill to the compositor.
@@ -61,6 +67,7 @@ struct FluxRenderContext {
 	double                 now;               /**< Monotonic time in seconds. */
 	float                  dt;                /**< Seconds since last frame. */
 	bool                  *animations_active; /**< Writable animation flag owned by the caller. */
+	double                *wake_at;           /**< Earliest @c now to redraw at; set by timed content (caret). */
 	bool                   is_dark;           /**< Current theme is dark. */
 	FluxFillSink          *fill_sink;         /**< Compositor-animated fill target, or NULL (classic path). */
 };
@@ -1,5 +1,6 @@
 #include "fluxent/flux_render_snapshot.h"
 #include "controls/textbox/tb_internal.h"
+#include "runtime/flux_anim_driver.h"
 
 #include <windows.h>
 #include "fluxent/controls/flux_menu_bar_data.h"
@@ -9,6 +10,7 @@
 #include "fluxent/controls/flux_tree_view_data.h"
 #include "fluxent/controls/flux_breadcrumb_data.h"
 
+#include <stddef.h>
 #include <string.h>
 
 typedef struct SnapshotContext {
@@ -70,15 +72,17 @@ static void snapshot_button(FluxRenderSnapshot *snap, FluxButtonData const *b) {
 	snap->u.button.is_checked = b->is_checked;
 }
 
-static void snapshot_textbox(FluxRenderSnapshot *snap, FluxTextBoxData const *tb) {
-	snap->font_size                    = tb->font_size;
-	snap->u.textbox.text_content            = tb->content;
+/* Only the window the box draws is materialized; caret and selection are moved into it. */
+static void snapshot_textbox(FluxRenderSnapshot *snap, FluxTextBoxInputData *input) {
+	FluxTextBoxData const *tb               = &input->base;
+	snap->font_size                         = tb->font_size;
+	snap->u.textbox.text_content            = tb_view_text(input);
 	snap->u.textbox.placeholder             = tb->placeholder;
 	snap->u.textbox.font_family             = tb->font_family;
 	snap->u.textbox.text_color              = tb->text_color;
-	snap->u.textbox.edit.cursor_position    = tb->cursor_position;
-	snap->u.textbox.edit.selection_start    = tb->selection_start;
-	snap->u.textbox.edit.selection_end      = tb->selection_end;
+	snap->u.textbox.edit.cursor_position    = tb_view_offset(input, tb->cursor_position);
+	snap->u.textbox.edit.selection_start    = tb_view_offset(input, tb->selection_start);
+	snap->u.textbox.edit.selection_end      = tb_view_offset(input, tb->selection_end);
 	snap->u.textbox.edit.scroll_offset_x    = tb->scroll_offset_x;
 	snap->u.textbox.edit.composition_text   = tb->composition_text;
 	snap->u.textbox.edit.composition_length = tb->composition_length;
@@ -284,7 +288,9 @@ static void snapshot_handle_nav_view_item(SnapshotContext const *ctx) {
  * the divider on it and on its left-adjacent neighbour (TabViewItem.cpp
  * HideLeftAdjacentTabSeparator). */
 static bool snapshot_tab_node_hot(FluxNodeStore *store, XentNodeId node) {
-	FluxNodeData const *nd = flux_node_store_get(store, node);
+	/* Read through userdata: flux_node_store_get would touch the node mid-collect. */
+	XentContext        *ctx = flux_node_store_context(store);
+	FluxNodeData const *nd  = ctx ? ( FluxNodeData const * ) xent_get_userdata(ctx, node) : NULL;
 	return nd && (nd->state.hovered || nd->state.pressed);
 }
 
@@ -346,8 +352,7 @@ static void snapshot_handle_slider(SnapshotContext const *ctx) {
 }
 
 static void snapshot_handle_textbox(SnapshotContext const *ctx) {
-	tb_sync_content(( FluxTextBoxInputData * ) ctx->data);
-	snapshot_textbox(ctx->snap, ( FluxTextBoxData const * ) ctx->data);
+	snapshot_textbox(ctx->snap, ( FluxTextBoxInputData * ) ctx->data);
 }
 
 static void snapshot_handle_scroll(SnapshotContext const *ctx) {
@@ -360,14 +365,12 @@ static void snapshot_handle_progress(SnapshotContext const *ctx) {
 
 static void snapshot_handle_password_box(SnapshotContext const *ctx) {
 	FluxTextBoxInputData *tb = ( FluxTextBoxInputData * ) ctx->data;
-	tb_sync_content(tb);
-	snapshot_textbox(ctx->snap, ( FluxTextBoxData const * ) ctx->data);
+	snapshot_textbox(ctx->snap, tb);
 	ctx->snap->u.textbox.is_checked = tb->password_show_plain || xent_get_semantic_checked(ctx->ctx, ctx->node) != 0;
 }
 
 static void snapshot_handle_number_box(SnapshotContext const *ctx) {
-	tb_sync_content(( FluxTextBoxInputData * ) ctx->data);
-	snapshot_textbox(ctx->snap, ( FluxTextBoxData const * ) ctx->data);
+	snapshot_textbox(ctx->snap, ( FluxTextBoxInputData * ) ctx->data);
 	snapshot_number_box_spin(ctx->snap, ctx->ctx, ctx->node);
 }
 
@@ -449,7 +452,7 @@ static void snapshot_handle_tree_item(SnapshotContext const *ctx) {
 	ctx->snap->u.tree_item.sel_state = d->sel_mode == XTK_TREE_SELECT_SINGLE
 	    ? ( uint8_t ) (d->selected == h ? FLUX_TREE_SEL_SELECTED : FLUX_TREE_SEL_NONE)
 	    : n->sel_state;
-	ctx->snap->u.tree_item.flags = ( uint8_t ) ((n->first_child >= 0 ? FLUX_TREE_ROW_HAS_CHILDREN : 0)
+	ctx->snap->u.tree_item.flags = ( uint8_t ) ((flux_tree_node_has_children(d, n) ? FLUX_TREE_ROW_HAS_CHILDREN : 0)
 	    | (n->expanded ? FLUX_TREE_ROW_EXPANDED : 0)
 	    | (d->sel_mode == XTK_TREE_SELECT_MULTIPLE ? FLUX_TREE_ROW_MULTI : 0)
 	    | (n->disabled ? FLUX_TREE_ROW_DISABLED : 0));
@@ -464,7 +467,7 @@ static void snapshot_handle_flip_view(SnapshotContext const *ctx) {
 	ctx->snap->u.flip.vertical      = fv->vertical;
 	ctx->snap->u.flip.prev_enabled  = fv->selected > 0 && count > 1;
 	ctx->snap->u.flip.next_enabled  = fv->selected < count - 1 && count > 1;
-	ctx->snap->u.flip.buttons_alive = GetTickCount() - fv->pointer_activity < 3000;
+	ctx->snap->u.flip.buttons_alive = flux_anim_now() - fv->pointer_activity < 3000;
 	ctx->snap->u.flip.pressed_btn   = fv->pressed_btn;
 }
 
@@ -484,7 +487,7 @@ static void snapshot_handle_pips_pager(SnapshotContext const *ctx) {
 static void snapshot_handle_refresh(SnapshotContext const *ctx) {
 	FluxRefreshData const *d   = ( FluxRefreshData const * ) ctx->data;
 	FluxRefreshSnapshot   *r   = &ctx->snap->u.refresh;
-	unsigned long          now = GetTickCount();
+	unsigned long          now = flux_anim_now();
 	float const            two_pi = 6.28318530718f;
 	float                  thr    = d->threshold_ratio > 0.0f ? d->threshold_ratio : FLUX_REFRESH_EXECUTION_RATIO;
 
@@ -610,6 +613,57 @@ static SnapshotHandler const SNAPSHOT_HANDLERS [FLUX_CONTROL_CUSTOM + 1] = {
   [FLUX_CONTROL_TITLE_BAR]       = snapshot_handle_title_bar,
 };
 
+#define SNAPSHOT_ARM(arm) (( uint16_t ) sizeof((( FluxRenderSnapshot * ) 0)->u.arm))
+
+/* Union arm written by each handler above; types without a handler carry
+ * only the base. Keep in step with SNAPSHOT_HANDLERS. */
+static uint16_t const SNAPSHOT_ARM_SIZES [FLUX_CONTROL_CUSTOM + 1] = {
+  [FLUX_CONTROL_TEXT]                = SNAPSHOT_ARM(text),
+  [FLUX_CONTROL_BUTTON]              = SNAPSHOT_ARM(button),
+  [FLUX_CONTROL_TOGGLE_BUTTON]       = SNAPSHOT_ARM(button),
+  [FLUX_CONTROL_DROPDOWN_BUTTON]     = SNAPSHOT_ARM(button),
+  [FLUX_CONTROL_SPLIT_BUTTON]        = SNAPSHOT_ARM(button),
+  [FLUX_CONTROL_TOGGLE_SPLIT_BUTTON] = SNAPSHOT_ARM(button),
+  [FLUX_CONTROL_RATING]              = SNAPSHOT_ARM(rating),
+  [FLUX_CONTROL_SELECTOR_BAR_ITEM]   = SNAPSHOT_ARM(selector),
+  [FLUX_CONTROL_BREADCRUMB_ITEM]     = SNAPSHOT_ARM(breadcrumb),
+  [FLUX_CONTROL_CHECKBOX]            = SNAPSHOT_ARM(check),
+  [FLUX_CONTROL_RADIO]               = SNAPSHOT_ARM(check),
+  [FLUX_CONTROL_SWITCH]              = SNAPSHOT_ARM(sw),
+  [FLUX_CONTROL_SLIDER]              = SNAPSHOT_ARM(slider),
+  [FLUX_CONTROL_TEXT_INPUT]          = SNAPSHOT_ARM(textbox),
+  [FLUX_CONTROL_SCROLL]              = SNAPSHOT_ARM(scroll),
+  [FLUX_CONTROL_PROGRESS]            = SNAPSHOT_ARM(progress),
+  [FLUX_CONTROL_PASSWORD_BOX]        = SNAPSHOT_ARM(textbox),
+  [FLUX_CONTROL_NUMBER_BOX]          = SNAPSHOT_ARM(textbox),
+  [FLUX_CONTROL_HYPERLINK]           = SNAPSHOT_ARM(button),
+  [FLUX_CONTROL_REPEAT_BUTTON]       = SNAPSHOT_ARM(button),
+  [FLUX_CONTROL_PROGRESS_RING]       = SNAPSHOT_ARM(progress),
+  [FLUX_CONTROL_INFO_BADGE]          = SNAPSHOT_ARM(info_badge),
+  [FLUX_CONTROL_INFO_BAR]            = SNAPSHOT_ARM(info_bar),
+  [FLUX_CONTROL_EXPANDER_HEADER]     = SNAPSHOT_ARM(expander),
+  [FLUX_CONTROL_IMAGE]               = SNAPSHOT_ARM(image),
+  [FLUX_CONTROL_COMBO_BOX]           = SNAPSHOT_ARM(combo),
+  [FLUX_CONTROL_MENU_BAR_ITEM]       = SNAPSHOT_ARM(menu),
+  [FLUX_CONTROL_NAV_VIEW]            = SNAPSHOT_ARM(nav),
+  [FLUX_CONTROL_NAV_VIEW_ITEM]       = SNAPSHOT_ARM(nav),
+  [FLUX_CONTROL_TAB_VIEW_ITEM]       = SNAPSHOT_ARM(tab),
+  [FLUX_CONTROL_LIST_ITEM]           = SNAPSHOT_ARM(list_item),
+  [FLUX_CONTROL_TREE_ITEM]           = SNAPSHOT_ARM(tree_item),
+  [FLUX_CONTROL_FLIP_VIEW]           = SNAPSHOT_ARM(flip),
+  [FLUX_CONTROL_PIPS_PAGER]          = SNAPSHOT_ARM(pips),
+  [FLUX_CONTROL_REFRESH]             = SNAPSHOT_ARM(refresh),
+  [FLUX_CONTROL_PERSON_PICTURE]      = SNAPSHOT_ARM(person),
+  [FLUX_CONTROL_PAGER]               = SNAPSHOT_ARM(pager),
+  [FLUX_CONTROL_SPLIT_VIEW_PANE]     = SNAPSHOT_ARM(split_pane),
+  [FLUX_CONTROL_TITLE_BAR]           = SNAPSHOT_ARM(title_bar),
+};
+
+size_t flux_snapshot_payload_size(FluxControlType type) {
+	size_t base = offsetof(FluxRenderSnapshot, u);
+	return type <= FLUX_CONTROL_CUSTOM ? base + SNAPSHOT_ARM_SIZES [type] : base;
+}
+
 void flux_snapshot_build(FluxRenderSnapshot *snap, XentContext const *ctx, XentNodeId node, FluxNodeData const *nd) {
 	snapshot_base(snap, ctx, node, nd);
 	if (!nd || !nd->component_data) return;
@@ -620,3 +674,109 @@ void flux_snapshot_build(FluxRenderSnapshot *snap, XentContext const *ctx, XentN
 	SnapshotContext build = {snap, ctx, node, nd->component_data};
 	handler(&build);
 }
+
+/* ---- digest ----------------------------------------------------------- */
+
+#define SNAPSHOT_HASH_MAX_STRINGS 4
+#define SNAPSHOT_FNV_OFFSET       0xcbf29ce484222325ull
+#define SNAPSHOT_FNV_PRIME        0x100000001b3ull
+
+static uint64_t snapshot_fnv(uint64_t h, void const *bytes, size_t len) {
+	unsigned char const *p = ( unsigned char const * ) bytes;
+	for (size_t i = 0; i < len; i++) {
+		h ^= p [i];
+		h *= SNAPSHOT_FNV_PRIME;
+	}
+	return h;
+}
+
+/* String fields of the active union arm. The raw bytes only see the pointer,
+ * which stays put when the text behind it is edited in place. */
+static uint32_t snapshot_strings(FluxRenderSnapshot const *s, char const **out) {
+	switch (s->type) {
+	case FLUX_CONTROL_TEXT :
+		out [0] = s->u.text.text_content;
+		out [1] = s->u.text.font_family;
+		return 2;
+	case FLUX_CONTROL_BUTTON              :
+	case FLUX_CONTROL_TOGGLE_BUTTON       :
+	case FLUX_CONTROL_DROPDOWN_BUTTON     :
+	case FLUX_CONTROL_SPLIT_BUTTON        :
+	case FLUX_CONTROL_TOGGLE_SPLIT_BUTTON :
+	case FLUX_CONTROL_HYPERLINK           :
+	case FLUX_CONTROL_REPEAT_BUTTON       :
+		out [0] = s->u.button.label;
+		out [1] = s->u.button.text_content;
+		out [2] = s->u.button.icon_name;
+		return 3;
+	case FLUX_CONTROL_CHECKBOX :
+	case FLUX_CONTROL_RADIO    : out [0] = s->u.check.label; return 1;
+	case FLUX_CONTROL_SWITCH   : out [0] = s->u.sw.label; return 1;
+	case FLUX_CONTROL_TEXT_INPUT   :
+	case FLUX_CONTROL_PASSWORD_BOX :
+	case FLUX_CONTROL_NUMBER_BOX   :
+		out [0] = s->u.textbox.text_content;
+		out [1] = s->u.textbox.placeholder;
+		out [2] = s->u.textbox.font_family;
+		return 3;
+	case FLUX_CONTROL_IMAGE      : out [0] = s->u.image.text_content; return 1;
+	case FLUX_CONTROL_INFO_BADGE : out [0] = s->u.info_badge.icon_name; return 1;
+	case FLUX_CONTROL_INFO_BAR   :
+		out [0] = s->u.info_bar.label;
+		out [1] = s->u.info_bar.text_content;
+		return 2;
+	case FLUX_CONTROL_COMBO_BOX :
+		out [0] = s->u.combo.text_content;
+		out [1] = s->u.combo.placeholder;
+		return 2;
+	case FLUX_CONTROL_TAB_VIEW_ITEM :
+		out [0] = s->u.tab.label;
+		out [1] = s->u.tab.icon_name;
+		return 2;
+	case FLUX_CONTROL_NAV_VIEW      :
+	case FLUX_CONTROL_NAV_VIEW_ITEM :
+		out [0] = s->u.nav.label;
+		out [1] = s->u.nav.icon_name;
+		return 2;
+	case FLUX_CONTROL_MENU_BAR_ITEM     : out [0] = s->u.menu.label; return 1;
+	case FLUX_CONTROL_SELECTOR_BAR_ITEM : out [0] = s->u.selector.text; return 1;
+	case FLUX_CONTROL_BREADCRUMB_ITEM   : out [0] = s->u.breadcrumb.label; return 1;
+	case FLUX_CONTROL_RATING            : out [0] = s->u.rating.caption; return 1;
+	case FLUX_CONTROL_TREE_ITEM         : out [0] = s->u.tree_item.label; return 1;
+	case FLUX_CONTROL_PERSON_PICTURE    :
+		out [0] = s->u.person.initials;
+		out [1] = s->u.person.image_path;
+		out [2] = s->u.person.badge_glyph;
+		return 3;
+	case FLUX_CONTROL_PAGER :
+		out [0] = s->u.pager.prefix;
+		out [1] = s->u.pager.suffix;
+		return 2;
+	case FLUX_CONTROL_TITLE_BAR :
+		out [0] = s->u.title_bar.title;
+		out [1] = s->u.title_bar.subtitle;
+		out [2] = s->u.title_bar.icon_glyph;
+		return 3;
+	default : return 0;
+	}
+}
+
+uint64_t flux_snapshot_hash(FluxRenderSnapshot const *snap) {
+	if (!snap) return 0;
+	uint64_t    h = snapshot_fnv(SNAPSHOT_FNV_OFFSET, snap, flux_snapshot_payload_size(snap->type));
+
+	char const *strings [SNAPSHOT_HASH_MAX_STRINGS];
+	uint32_t    n = snapshot_strings(snap, strings);
+	for (uint32_t i = 0; i < n; i++) {
+		char const *str = strings [i];
+		/* Fold a separator per field so "ab"+"c" and "a"+"bc" differ. */
+		h               = snapshot_fnv(h, str ? str : "", str ? strlen(str) + 1 : 1);
+	}
+
+	FluxEditSnapshot const *edit = &snap->u.textbox.edit;
+	bool is_edit = snap->type == FLUX_CONTROL_TEXT_INPUT || snap->type == FLUX_CONTROL_PASSWORD_BOX
+	            || snap->type == FLUX_CONTROL_NUMBER_BOX;
+	if (is_edit && edit->composition_text)
+		h = snapshot_fnv(h, edit->composition_text, edit->composition_length * sizeof(wchar_t));
+	return h;
+}
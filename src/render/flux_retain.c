@@ -0,0 +1,68 @@
+#include "flux_retain.h"
+
+#include <stdlib.h>
+
+#define RETAIN_MIN_CAPACITY 64u
+
+static uint32_t retain_slot(XentNodeId node, uint32_t cap) {
+	uint32_t h  = node;
+	h          ^= h >> 16;
+	h          *= 0x45d9f3b;
+	h          ^= h >> 16;
+	return h & (cap - 1);
+}
+
+static void retain_insert(FluxRetainEntry *entries, uint32_t cap, FluxRetainEntry const *entry) {
+	uint32_t idx = retain_slot(entry->node, cap);
+	while (entries [idx].node != XENT_NODE_INVALID && entries [idx].node != entry->node) idx = (idx + 1) & (cap - 1);
+	entries [idx] = *entry;
+}
+
+static bool retain_grow(FluxRetainMap *map) {
+	uint32_t         new_cap = map->capacity ? map->capacity * 2 : RETAIN_MIN_CAPACITY;
+	FluxRetainEntry *entries = ( FluxRetainEntry * ) malloc(sizeof(FluxRetainEntry) * new_cap);
+	if (!entries) return false;
+	for (uint32_t i = 0; i < new_cap; i++) entries [i].node = XENT_NODE_INVALID;
+	for (uint32_t i = 0; i < map->capacity; i++)
+		if (map->entries [i].node != XENT_NODE_INVALID) retain_insert(entries, new_cap, &map->entries [i]);
+	free(map->entries);
+	map->entries  = entries;
+	map->capacity = new_cap;
+	return true;
+}
+
+void flux_retain_map_clear(FluxRetainMap *map) {
+	if (!map || map->count == 0) return;
+	for (uint32_t i = 0; i < map->capacity; i++) map->entries [i].node = XENT_NODE_INVALID;
+	map->count = 0;
+}
+
+void flux_retain_map_free(FluxRetainMap *map) {
+	if (!map) return;
+	free(map->entries);
+	map->entries  = NULL;
+	map->count    = 0;
+	map->capacity = 0;
+}
+
+bool flux_retain_map_put(FluxRetainMap *map, FluxRetainEntry const *entry) {
+	if (!map || !entry || entry->node == XENT_NODE_INVALID) return false;
+	if ((map->count + 1) * 4 > map->capacity * 3 && !retain_grow(map)) return false;
+
+	uint32_t idx = retain_slot(entry->node, map->capacity);
+	while (map->entries [idx].node != XENT_NODE_INVALID && map->entries [idx].node != entry->node)
+		idx = (idx + 1) & (map->capacity - 1);
+	if (map->entries [idx].node == XENT_NODE_INVALID) map->count++;
+	map->entries [idx] = *entry;
+	return true;
+}
+
+FluxRetainEntry const *flux_retain_map_find(FluxRetainMap const *map, XentNodeId node) {
+	if (!map || map->count == 0 || node == XENT_NODE_INVALID) return NULL;
+	uint32_t idx = retain_slot(node, map->capacity);
+	while (map->entries [idx].node != XENT_NODE_INVALID) {
+		if (map->entries [idx].node == node) return &map->entries [idx];
+		idx = (idx + 1) & (map->capacity - 1);
+	}
+	return NULL;
+}
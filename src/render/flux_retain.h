@@ -0,0 +1,60 @@
+/**
+ * @file flux_retain.h
+ * @brief Node → command-range map for retained subtree reuse across collects.
+ *
+ * Each collect records, for every subtree that can be replayed verbatim, the
+ * range of commands and payload bytes it emitted together with the subtree
+ * generation of its root (FluxNodeData.generation). The next collect looks
+ * a node up here and, when the generation still matches and the layout and
+ * structure check out, splices the old range instead of walking the subtree.
+ *
+ * Platform-neutral; no D2D dependency.
+ * @note This is an internal header; do not include from public API.
+ */
+#ifndef FLUX_RETAIN_H
+#define FLUX_RETAIN_H
+
+#include "fluxent/flux_types.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Command and payload range one subtree emitted in a collect. */
+typedef struct FluxRetainEntry {
+	XentNodeId node;          /**< Subtree root. */
+	uint32_t   generation;    /**< Root's FluxNodeData.generation when collected. */
+	uint32_t   cmd_start;     /**< First command (transform push or main draw). */
+	uint32_t   cmd_count;     /**< Commands through the closing pop / overlay. */
+	uint32_t   payload_start; /**< Arena offset of the root's snapshot (first of the subtree). */
+	uint32_t   payload_end;   /**< One past the subtree's last payload byte. */
+} FluxRetainEntry;
+
+/** @brief Open-addressed map keyed by node id; empty slots hold XENT_NODE_INVALID. */
+typedef struct FluxRetainMap {
+	FluxRetainEntry *entries;
+	uint32_t         count;
+	uint32_t         capacity;
+} FluxRetainMap;
+
+/** @brief Drop every entry, keeping the storage. */
+void                   flux_retain_map_clear(FluxRetainMap *map);
+
+/** @brief Release the storage. */
+void                   flux_retain_map_free(FluxRetainMap *map);
+
+/** @brief Insert or replace the entry for @p entry->node; false on allocation failure. */
+bool                   flux_retain_map_put(FluxRetainMap *map, FluxRetainEntry const *entry);
+
+/** @brief Entry for @p node, or NULL. */
+FluxRetainEntry const *flux_retain_map_find(FluxRetainMap const *map, XentNodeId node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
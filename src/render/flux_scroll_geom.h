@@ -15,6 +15,8 @@
 #define FLUX_SCROLLBAR_BUTTON_SIZE  12.0f
 #define FLUX_SCROLLBAR_MIN_THUMB    30.0f
 #define FLUX_SCROLLBAR_SMALL_CHANGE 48.0f
+/** @brief Pointer distance from the right/bottom edge within which the bars expand. */
+#define FLUX_SCROLLBAR_HOVER_EDGE   24.0f
 
 /** @brief Computed rectangles for a ScrollView overlay scrollbar pair. */
 typedef struct FluxScrollBarGeom {
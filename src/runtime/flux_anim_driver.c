@@ -1,70 +1,294 @@
 #include "runtime/flux_anim_driver.h"
+#include "runtime/flux_time.h"
 
-#include <windows.h>
 #include <stdlib.h>
 
-/* Single shared registry of active animators. Behaviour matches the per-control
- * timers it replaces (one WM_TIMER at ~16ms, GetTickCount sampled once per tick,
- * swap-remove, timer killed when empty) — only the fixed cap is gone. */
+/* Awake animators sit on one list that every tick walks. Sleepers sit in a
+ * hashed timer wheel of ANIM_SLOTS slots, ANIM_SLOT_MS wide: a tick only sweeps
+ * the slots that time has passed, and a sleeper further out than one turn just
+ * stays in its slot until the turn that reaches it. Entries live in one array
+ * (indices stay valid across growth), linked by index, with a free list. */
+#define ANIM_SLOT_MS 16u
+#define ANIM_SLOTS   64u
+#define ANIM_NIL     (-1)
+
+typedef enum FluxAnimWhere
+{
+	ANIM_FREE = 0,
+	ANIM_AWAKE,
+	ANIM_ASLEEP,
+} FluxAnimWhere;
+
 typedef struct FluxAnimEntry {
-	void        *ctx;
-	FluxAnimStep step;
+	void         *ctx;
+	FluxAnimStep  step;
+	unsigned long deadline; /* asleep: first tick time that steps it */
+	unsigned      epoch;    /* g_epoch when it woke; a tick steps it only from the next epoch */
+	int           prev;
+	int           next;
+	FluxAnimWhere where;
 } FluxAnimEntry;
 
 static FluxAnimEntry *g_entries;
-static int            g_count;
+static int            g_count; /* high-water mark; free slots below it are on g_free */
 static int            g_cap;
-static UINT_PTR       g_timer;
-
-static void CALLBACK flux_anim_timer_proc(HWND hwnd, UINT msg, UINT_PTR id, DWORD systime) {
-	(void) hwnd;
-	(void) msg;
-	(void) id;
-	(void) systime;
-
-	unsigned long now = GetTickCount();
-	/* Iterate downward so a step that unregisters itself (swap-from-end) is safe;
-	 * a step that registers a new animator appends past the current index. */
-	for (int i = g_count - 1; i >= 0; i--) {
-		FluxAnimEntry e = g_entries [i];
-		if (!e.step(e.ctx, now)) flux_anim_unregister(e.ctx);
-	}
+static int            g_free = ANIM_NIL;
+static int            g_awake = ANIM_NIL;
+static int            g_slots [ANIM_SLOTS];
+static int            g_sleepers;
+static bool           g_ready;
+static unsigned long  g_wheel_ms; /* start of the oldest slot not fully swept */
+static unsigned       g_epoch;
+static bool           g_ticking;
+static int           *g_run; /* snapshot of the awake list a tick steps */
+static int            g_run_cap;
+static bool           g_armed; /* host asked to wake at g_armed_ms */
+static unsigned long  g_armed_ms;
+static FluxAnimClock  g_clock;
+static void          *g_clock_ctx;
+static FluxAnimWake   g_wake;
+static void          *g_wake_ctx;
+
+static bool           anim_before(unsigned long a, unsigned long b) { return ( long ) (a - b) < 0; }
+
+static void           anim_init(void) {
+	if (g_ready) return;
+	for (unsigned i = 0; i < ANIM_SLOTS; i++) g_slots [i] = ANIM_NIL;
+	g_ready = true;
 }
 
-void flux_anim_register(void *ctx, FluxAnimStep step) {
-	if (!ctx || !step) return;
+static int *anim_head(FluxAnimEntry const *e) {
+	if (e->where == ANIM_AWAKE) return &g_awake;
+	return &g_slots [(e->deadline / ANIM_SLOT_MS) % ANIM_SLOTS];
+}
 
-	for (int i = 0; i < g_count; i++) {
-		if (g_entries [i].ctx == ctx) {
-			g_entries [i].step = step;
-			return;
+static void anim_link(int idx, FluxAnimWhere where) {
+	FluxAnimEntry *e = &g_entries [idx];
+	e->where         = where;
+	int *head        = anim_head(e);
+	e->prev          = ANIM_NIL;
+	e->next          = *head;
+	if (*head != ANIM_NIL) g_entries [*head].prev = idx;
+	*head = idx;
+	if (where == ANIM_ASLEEP) g_sleepers++;
+}
+
+static void anim_unlink(int idx) {
+	FluxAnimEntry *e = &g_entries [idx];
+	if (e->prev != ANIM_NIL) g_entries [e->prev].next = e->next;
+	else *anim_head(e) = e->next;
+	if (e->next != ANIM_NIL) g_entries [e->next].prev = e->prev;
+	if (e->where == ANIM_ASLEEP) g_sleepers--;
+	e->where = ANIM_FREE;
+}
+
+static int anim_find(void const *ctx) {
+	for (int i = 0; i < g_count; i++)
+		if (g_entries [i].where != ANIM_FREE && g_entries [i].ctx == ctx) return i;
+	return ANIM_NIL;
+}
+
+static int anim_alloc(void *ctx, FluxAnimStep step) {
+	int idx = g_free;
+	if (idx != ANIM_NIL) g_free = g_entries [idx].next;
+	else {
+		if (g_count == g_cap) {
+			int            ncap  = g_cap ? g_cap * 2 : 8;
+			FluxAnimEntry *grown = ( FluxAnimEntry * ) realloc(g_entries, ( size_t ) ncap * sizeof(*grown));
+			if (!grown) return ANIM_NIL; /* drop the registration rather than corrupt the live lists */
+			g_entries = grown;
+			g_cap     = ncap;
 		}
+		idx = g_count++;
 	}
+	g_entries [idx] = (FluxAnimEntry) {.ctx = ctx, .step = step, .where = ANIM_FREE};
+	return idx;
+}
+
+static void anim_release(int idx) {
+	anim_unlink(idx);
+	g_entries [idx].ctx  = NULL;
+	g_entries [idx].next = g_free;
+	g_free               = idx;
+}
+
+/* Existing entry for @p ctx, unlinked and ready to be relinked, or a new one. */
+static int anim_take(void *ctx, FluxAnimStep step) {
+	anim_init();
+	int idx = anim_find(ctx);
+	if (idx == ANIM_NIL) return anim_alloc(ctx, step);
+	anim_unlink(idx);
+	g_entries [idx].step = step;
+	return idx;
+}
+
+static void anim_wake_host(unsigned long delay_ms) {
+	if (g_wake) g_wake(g_wake_ctx, delay_ms);
+}
+
+static void anim_make_awake(int idx) {
+	g_entries [idx].epoch = g_epoch;
+	anim_link(idx, ANIM_AWAKE);
+}
 
-	if (g_count == g_cap) {
-		int            ncap = g_cap ? g_cap * 2 : 8;
-		FluxAnimEntry *grown = ( FluxAnimEntry * ) realloc(g_entries, ( size_t ) ncap * sizeof(*grown));
-		if (!grown) return; /* drop the registration rather than corrupt the live list */
-		g_entries = grown;
-		g_cap     = ncap;
+/* Moves the sleepers of every slot whose start @p now has reached, and that
+ * are due, to the awake list. The slot holding @p now is left unswept so its
+ * later deadlines are seen by the next tick. */
+static void anim_sweep(unsigned long now) {
+	unsigned long current = now - now % ANIM_SLOT_MS;
+	if (!g_sleepers || anim_before(now, g_wheel_ms)) {
+		if (!g_sleepers) g_wheel_ms = current;
+		return;
 	}
+	unsigned long slots = (now - g_wheel_ms) / ANIM_SLOT_MS + 1u;
+	if (slots > ANIM_SLOTS) slots = ANIM_SLOTS;
+	unsigned long first = g_wheel_ms / ANIM_SLOT_MS;
+	for (unsigned long k = 0; k < slots && g_sleepers; k++) {
+		int idx = g_slots [(first + k) % ANIM_SLOTS];
+		while (idx != ANIM_NIL) {
+			int next = g_entries [idx].next;
+			if (!anim_before(now, g_entries [idx].deadline)) {
+				anim_unlink(idx);
+				anim_make_awake(idx);
+			}
+			idx = next;
+		}
+	}
+	g_wheel_ms = current;
+}
 
-	g_entries [g_count].ctx  = ctx;
-	g_entries [g_count].step = step;
-	g_count++;
+static void anim_arm(unsigned long now, unsigned long deadline) {
+	if (g_armed && !anim_before(deadline, g_armed_ms)) return;
+	g_armed    = true;
+	g_armed_ms = deadline;
+	anim_wake_host(anim_before(now, deadline) ? deadline - now : 0u);
+}
 
-	if (!g_timer) g_timer = SetTimer(NULL, 0, 16, flux_anim_timer_proc);
+static unsigned long anim_default_clock(void *ctx) {
+	( void ) ctx;
+	return ( unsigned long ) flux_perf_millis(flux_perf_now());
+}
+
+unsigned long flux_anim_now(void) { return g_clock ? g_clock(g_clock_ctx) : anim_default_clock(NULL); }
+
+void          flux_anim_set_clock(FluxAnimClock clock, void *ctx) {
+	g_clock     = clock;
+	g_clock_ctx = ctx;
+}
+
+void flux_anim_set_wake(FluxAnimWake wake, void *ctx) {
+	g_wake     = wake;
+	g_wake_ctx = ctx;
+	g_armed    = false;
+}
+
+void flux_anim_clear_wake(FluxAnimWake wake, void *ctx) {
+	if (g_wake == wake && g_wake_ctx == ctx) flux_anim_set_wake(NULL, NULL);
+}
+
+void flux_anim_register(void *ctx, FluxAnimStep step) {
+	if (!ctx || !step) return;
+	int idx = anim_take(ctx, step);
+	if (idx == ANIM_NIL) return;
+	anim_make_awake(idx);
+	if (!g_ticking) anim_wake_host(0u);
+}
+
+void flux_anim_sleep_until(void *ctx, FluxAnimStep step, unsigned long deadline_ms) {
+	if (!ctx || !step) return;
+	unsigned long now = flux_anim_now();
+	if (!g_sleepers && !g_ticking) g_wheel_ms = now - now % ANIM_SLOT_MS;
+	int idx = anim_take(ctx, step);
+	if (idx == ANIM_NIL) return;
+	if (!anim_before(now, deadline_ms)) { /* already due: a slot behind the cursor would wait a whole turn */
+		anim_make_awake(idx);
+		if (!g_ticking) anim_wake_host(0u);
+		return;
+	}
+	g_entries [idx].deadline = deadline_ms;
+	anim_link(idx, ANIM_ASLEEP);
+	/* A tick re-arms for the earliest sleeper when it finishes; between ticks
+	 * the host only needs a new wake if this deadline comes first. */
+	if (!g_ticking && g_awake == ANIM_NIL) anim_arm(now, deadline_ms);
 }
 
 void flux_anim_unregister(void *ctx) {
+	if (!ctx) return;
+	int idx = anim_find(ctx);
+	if (idx != ANIM_NIL) anim_release(idx);
+}
+
+bool flux_anim_next_deadline(unsigned long *out_ms) {
+	if (!g_sleepers) return false;
+	/* Slot k of the turn starting at the cursor covers [k, k + 1) slot widths
+	 * past it; the first slot holding a deadline of this turn holds the minimum. */
+	unsigned long first = g_wheel_ms / ANIM_SLOT_MS;
+	for (unsigned long k = 0; k < ANIM_SLOTS; k++) {
+		bool          found = false;
+		unsigned long best  = 0;
+		for (int idx = g_slots [(first + k) % ANIM_SLOTS]; idx != ANIM_NIL; idx = g_entries [idx].next) {
+			unsigned long d = g_entries [idx].deadline;
+			if (( long ) (d - g_wheel_ms) >= ( long ) ((k + 1u) * ANIM_SLOT_MS)) continue;
+			if (!found || anim_before(d, best)) best = d;
+			found = true;
+		}
+		if (found) {
+			if (out_ms) *out_ms = best;
+			return true;
+		}
+	}
+	/* Nothing within one turn: take the minimum over every sleeper. */
+	bool          found = false;
+	unsigned long best  = 0;
 	for (int i = 0; i < g_count; i++) {
-		if (g_entries [i].ctx != ctx) continue;
-		g_entries [i] = g_entries [--g_count];
-		break;
+		if (g_entries [i].where != ANIM_ASLEEP) continue;
+		if (!found || anim_before(g_entries [i].deadline, best)) best = g_entries [i].deadline;
+		found = true;
 	}
+	if (out_ms) *out_ms = best;
+	return found;
+}
 
-	if (g_count == 0 && g_timer) {
-		KillTimer(NULL, g_timer);
-		g_timer = 0;
+static bool anim_snapshot_awake(int *out_count) {
+	int n = 0;
+	for (int idx = g_awake; idx != ANIM_NIL; idx = g_entries [idx].next) n++;
+	if (n > g_run_cap) {
+		int *grown = ( int * ) realloc(g_run, ( size_t ) n * sizeof(*grown));
+		if (!grown) return false;
+		g_run     = grown;
+		g_run_cap = n;
 	}
+	n = 0;
+	for (int idx = g_awake; idx != ANIM_NIL; idx = g_entries [idx].next) g_run [n++] = idx;
+	*out_count = n;
+	return true;
+}
+
+bool flux_anim_tick(unsigned long now_ms) {
+	if (g_ticking) return g_awake != ANIM_NIL;
+	anim_init();
+	g_ticking = true;
+	g_armed   = false; /* this is the frame any pending wake asked for */
+
+	anim_sweep(now_ms);
+	g_epoch++;
+	int n = 0;
+	if (anim_snapshot_awake(&n)) {
+		/* Steps may register, sleep or unregister anything, themselves included;
+		 * the epoch skips entries that woke during this tick, and the ctx check
+		 * skips a slot that was released and reused. */
+		for (int i = 0; i < n; i++) {
+			int           idx = g_run [i];
+			FluxAnimEntry e   = g_entries [idx];
+			if (e.where != ANIM_AWAKE || e.epoch == g_epoch) continue;
+			if (e.step(e.ctx, now_ms)) continue;
+			if (g_entries [idx].where != ANIM_FREE && g_entries [idx].ctx == e.ctx) anim_release(idx);
+		}
+	}
+	g_ticking = false;
+
+	if (g_awake != ANIM_NIL) return true;
+	unsigned long next;
+	if (flux_anim_next_deadline(&next)) anim_arm(now_ms, next);
+	return false;
 }
@@ -1,6 +1,6 @@
 /**
  * @file flux_anim_driver.h
- * @brief Shared animation driver: one ~60Hz timer ticking all active animators.
+ * @brief Shared animation driver, ticked by the frame clock.
  *
  * Controls used to each carry their own fixed-cap global array + WM_TIMER plumbing
  * (g_nav_anim/g_tab_anim/...), duplicating the same start/remove/tick machinery and
@@ -8,6 +8,19 @@
  * owner of that concern (Doctrine #6): register a per-frame step keyed by an opaque
  * ctx, and it is ticked until the step reports it is done. The registry grows as
  * needed, so there is no silent cap.
+ *
+ * The driver owns no timer. The app calls flux_anim_tick once per frame, just
+ * before layout, with the frame's own clock, so every animator advances in step
+ * with the frame that draws it, at whatever rate the display presents.
+ *
+ * An animator is either awake (stepped every frame) or asleep until a deadline
+ * (flux_anim_sleep_until). Sleepers sit in a timer wheel and cost nothing until
+ * their slot comes round, so a pending tooltip or a blinking caret does not
+ * keep frames coming. Whenever the driver needs a frame it asks the host wake
+ * hook once: now for an awake animator, after a delay for the earliest sleeper.
+ *
+ * Platform-neutral and single-threaded (the UI thread); the clock is injectable
+ * so the driver runs headless under a fake clock in tests.
  */
 #ifndef FLUX_ANIM_DRIVER_H
 #define FLUX_ANIM_DRIVER_H
@@ -22,22 +35,66 @@ extern "C"
 /**
  * @brief Per-frame animation step.
  * @param ctx     The opaque token passed to flux_anim_register.
- * @param now_ms  GetTickCount() sampled once per tick (shared by all steps this frame).
+ * @param now_ms  Frame time in ms (flux_anim_now's clock), shared by all steps this frame.
  * @return true while still animating; false to auto-unregister this animator.
+ *         A step that put itself back to sleep with flux_anim_sleep_until returns true.
+ */
+typedef bool          (*FluxAnimStep)(void *ctx, unsigned long now_ms);
+
+/** @brief Millisecond clock; wraps like GetTickCount, so compare times by difference. */
+typedef unsigned long (*FluxAnimClock)(void *ctx);
+
+/**
+ * @brief Host hook asking for a frame @p delay_ms from now (0 = as soon as possible).
+ *        A later call supersedes an earlier one that has not fired yet.
+ */
+typedef void          (*FluxAnimWake)(void *ctx, unsigned long delay_ms);
+
+/**
+ * @brief Register @p ctx to be stepped every frame. Idempotent per ctx (updates the
+ *        step if already registered, and wakes it if asleep). Asks the host for a frame.
+ */
+void          flux_anim_register(void *ctx, FluxAnimStep step);
+
+/**
+ * @brief Put @p ctx to sleep until @p deadline_ms (flux_anim_now's clock); it is stepped
+ *        by the first frame at or after the deadline. Registers @p ctx if needed.
  */
-typedef bool (*FluxAnimStep)(void *ctx, unsigned long now_ms);
+void          flux_anim_sleep_until(void *ctx, FluxAnimStep step, unsigned long deadline_ms);
 
 /**
- * @brief Register @p ctx to be ticked at ~60Hz. Idempotent per ctx (updates the
- *        step if already registered). Starts the shared timer on the first animator.
+ * @brief Stop ticking @p ctx. Safe to call if not registered, including from a step.
+ *        Call from a control's destroy path.
  */
-void flux_anim_register(void *ctx, FluxAnimStep step);
+void          flux_anim_unregister(void *ctx);
+
+/**
+ * @brief Step every awake animator and every sleeper due at @p now_ms.
+ *
+ * Animators registered by a step are first stepped by the next tick. If only
+ * sleepers remain, the host is asked to wake for the earliest one.
+ *
+ * @return true if an animator is awake, i.e. the caller should render another frame.
+ */
+bool          flux_anim_tick(unsigned long now_ms);
+
+/** @brief Earliest sleeper deadline; false when nothing sleeps. */
+bool          flux_anim_next_deadline(unsigned long *out_ms);
+
+/** @brief Current time of the driver's clock in ms. */
+unsigned long flux_anim_now(void);
+
+/** @brief Replace the clock (NULL restores the default performance-counter clock). */
+void          flux_anim_set_clock(FluxAnimClock clock, void *ctx);
+
+/** @brief Install the host wake hook (NULL: nobody is woken; the caller ticks by hand). */
+void          flux_anim_set_wake(FluxAnimWake wake, void *ctx);
 
 /**
- * @brief Stop ticking @p ctx. Safe to call if not registered. Stops the shared timer
- *        once the last animator is gone. Call from a control's destroy path.
+ * @brief Uninstall the wake hook if it is still @p wake with @p ctx; a hook
+ *        installed since by another host is left alone.
  */
-void flux_anim_unregister(void *ctx);
+void          flux_anim_clear_wake(FluxAnimWake wake, void *ctx);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,132 @@
+#include "fluxent/flux_frame_stats.h"
+#include "runtime/flux_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The open record lives in the slot it will occupy, so closing it is just
+ * advancing the head; readers only ever see closed frames. */
+struct FluxFrameStats {
+	FluxFrameRecord *records;
+	uint32_t         capacity;
+	uint32_t         head;  /**< Slot of the next (or open) record. */
+	uint32_t         count; /**< Closed records held. */
+	uint64_t         next_frame;
+	bool             open;
+};
+
+static char const *const kPhaseNames [FLUX_FRAME_PHASE_COUNT] = {
+  [FLUX_FRAME_PHASE_UPDATE]      = "update",
+  [FLUX_FRAME_PHASE_DMANIP_TICK] = "dmanip_tick",
+  [FLUX_FRAME_PHASE_LAYOUT]      = "layout",
+  [FLUX_FRAME_PHASE_DMANIP_SYNC] = "dmanip_sync",
+  [FLUX_FRAME_PHASE_COLLECT]     = "collect",
+  [FLUX_FRAME_PHASE_EXECUTE]     = "execute",
+  [FLUX_FRAME_PHASE_PRESENT]     = "present",
+  [FLUX_FRAME_PHASE_COMPOSE]     = "compose",
+};
+
+FluxFrameStats *flux_frame_stats_create(uint32_t capacity) {
+	FluxFrameStats *stats = ( FluxFrameStats * ) calloc(1, sizeof(*stats));
+	if (!stats) return NULL;
+	stats->capacity = capacity ? capacity : FLUX_FRAME_STATS_DEFAULT_CAPACITY;
+	stats->records  = ( FluxFrameRecord * ) calloc(stats->capacity, sizeof(FluxFrameRecord));
+	if (!stats->records) {
+		free(stats);
+		return NULL;
+	}
+	return stats;
+}
+
+void flux_frame_stats_destroy(FluxFrameStats *stats) {
+	if (!stats) return;
+	free(stats->records);
+	free(stats);
+}
+
+FluxFrameRecord *flux_frame_stats_begin(FluxFrameStats *stats, int64_t now) {
+	if (!stats) return NULL;
+	FluxFrameRecord *r = &stats->records [stats->head];
+	memset(r, 0, sizeof(*r));
+	r->frame    = stats->next_frame++;
+	r->start    = now;
+	stats->open = true;
+	return r;
+}
+
+void flux_frame_stats_phase(FluxFrameRecord *record, FluxFramePhase phase, int64_t begin, int64_t end) {
+	if (!record || ( uint32_t ) phase >= FLUX_FRAME_PHASE_COUNT) return;
+	if (!(record->phase_mask & (1u << phase))) record->phase_start [phase] = begin;
+	record->phase_ticks [phase] += end - begin;
+	record->phase_mask          |= 1u << phase;
+}
+
+void flux_frame_stats_end(FluxFrameStats *stats, int64_t now) {
+	if (!stats || !stats->open) return;
+	FluxFrameRecord *r = &stats->records [stats->head];
+	r->duration        = now - r->start;
+	stats->open        = false;
+	stats->head        = (stats->head + 1) % stats->capacity;
+	if (stats->count < stats->capacity) stats->count++;
+}
+
+uint32_t flux_frame_stats_count(FluxFrameStats const *stats) { return stats ? stats->count : 0; }
+
+FluxFrameRecord const *flux_frame_stats_get(FluxFrameStats const *stats, uint32_t age) {
+	if (!stats || age >= stats->count) return NULL;
+	return &stats->records [(stats->head + stats->capacity - 1 - age) % stats->capacity];
+}
+
+void flux_frame_stats_clear(FluxFrameStats *stats) {
+	if (!stats) return;
+	stats->count = 0;
+	stats->open  = false;
+}
+
+char const *flux_frame_phase_name(FluxFramePhase phase) {
+	return ( uint32_t ) phase < FLUX_FRAME_PHASE_COUNT ? kPhaseNames [phase] : "unknown";
+}
+
+static double frame_stats_us(int64_t ticks) { return flux_perf_seconds(ticks) * 1e6; }
+
+static void frame_stats_write_frame(FILE *f, FluxFrameRecord const *r, bool first) {
+	fprintf(
+	  f,
+	  "%s{\"name\":\"frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,"
+	  "\"args\":{\"frame\":%llu,\"commands\":%u,\"reused_commands\":%u,\"snapshots_built\":%u,"
+	  "\"snapshot_bytes\":%zu,\"layout_passes\":%u,\"partial_layouts\":%u,\"text_hits\":%u,"
+	  "\"text_misses\":%u,\"presented\":%s}}",
+	  first ? "" : ",\n", frame_stats_us(r->start), frame_stats_us(r->duration), ( unsigned long long ) r->frame,
+	  r->commands, r->reused_commands, r->snapshots_built, r->snapshot_bytes, r->layout_passes, r->partial_layouts,
+	  r->text_hits, r->text_misses, r->presented ? "true" : "false"
+	);
+	for (int p = 0; p < FLUX_FRAME_PHASE_COUNT; p++) {
+		if (!(r->phase_mask & (1u << p))) continue;
+		fprintf(
+		  f, ",\n{\"name\":\"%s\",\"cat\":\"phase\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+		  kPhaseNames [p], frame_stats_us(r->phase_start [p]), frame_stats_us(r->phase_ticks [p])
+		);
+	}
+	fprintf(
+	  f,
+	  ",\n{\"name\":\"commands\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"built\":%u,\"reused\":%u}}"
+	  ",\n{\"name\":\"snapshot_bytes\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"bytes\":%zu}}",
+	  frame_stats_us(r->start), r->commands - r->reused_commands, r->reused_commands, frame_stats_us(r->start),
+	  r->snapshot_bytes
+	);
+}
+
+bool flux_frame_stats_write_trace(FluxFrameStats const *stats, char const *path) {
+	if (!stats || !path) return false;
+	FILE *f = fopen(path, "wb");
+	if (!f) return false;
+
+	fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+	for (uint32_t age = stats->count; age-- > 0;)
+		frame_stats_write_frame(f, flux_frame_stats_get(stats, age), age == stats->count - 1);
+	fputs("\n]}\n", f);
+
+	bool ok = !ferror(f);
+	return fclose(f) == 0 && ok;
+}
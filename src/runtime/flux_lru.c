@@ -0,0 +1,270 @@
+#include "flux_lru.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LRU_NONE (-1)
+
+typedef struct LruEntry {
+	uint64_t hash;
+	uint8_t *key;                              /**< Parts back to back (owned). */
+	uint32_t len [FLUX_LRU_KEY_PARTS];
+	void    *value;
+	size_t   cost;                             /**< Charged bytes: caller cost + key + entry. */
+	int32_t  prev;                             /**< Toward the most recent; free-list link when unused. */
+	int32_t  next;                             /**< Toward the least recent. */
+} LruEntry;
+
+struct FluxLru {
+	LruEntry      *entries;
+	int32_t              entry_cap;
+	int32_t              free_head;
+	uint32_t            *slots;     /**< Entry index + 1 per slot; 0 = empty. */
+	uint32_t             slot_mask; /**< Slot count - 1 (a power of two). */
+	int32_t              newest;
+	int32_t              oldest;
+	uint32_t             count;
+	size_t               bytes;
+	size_t               budget;
+	uint64_t             hits;
+	uint64_t             misses;
+	uint64_t             evictions;
+	FluxLruRelease release;
+};
+
+/* FNV-1a over the parts, each followed by its length so part boundaries count. */
+static uint64_t lru_hash(FluxLruKey const *key) {
+	uint64_t h = 0xcbf29ce484222325ull;
+	for (int p = 0; p < FLUX_LRU_KEY_PARTS; p++) {
+		uint8_t const *b = ( uint8_t const * ) key->data [p];
+		for (uint32_t i = 0; i < key->len [p]; i++) {
+			h ^= b [i];
+			h *= 0x100000001b3ull;
+		}
+		h ^= key->len [p];
+		h *= 0x100000001b3ull;
+	}
+	return h;
+}
+
+static size_t lru_key_size(FluxLruKey const *key) {
+	size_t n = 0;
+	for (int p = 0; p < FLUX_LRU_KEY_PARTS; p++) n += key->len [p];
+	return n;
+}
+
+static bool lru_key_equal(LruEntry const *e, uint64_t hash, FluxLruKey const *key) {
+	if (e->hash != hash) return false;
+	uint8_t const *k = e->key;
+	for (int p = 0; p < FLUX_LRU_KEY_PARTS; p++) {
+		if (e->len [p] != key->len [p]) return false;
+		if (key->len [p] && memcmp(k, key->data [p], key->len [p]) != 0) return false;
+		k += key->len [p];
+	}
+	return true;
+}
+
+/* Slot holding @p key, or the empty slot where it would go. */
+static uint32_t lru_probe(FluxLru const *c, uint64_t hash, FluxLruKey const *key) {
+	uint32_t i = ( uint32_t ) hash & c->slot_mask;
+	while (c->slots [i] && !lru_key_equal(&c->entries [c->slots [i] - 1], hash, key)) i = (i + 1) & c->slot_mask;
+	return i;
+}
+
+static uint32_t lru_slot_of(FluxLru const *c, int32_t index) {
+	uint32_t i = ( uint32_t ) c->entries [index].hash & c->slot_mask;
+	while (c->slots [i] != ( uint32_t ) index + 1) i = (i + 1) & c->slot_mask;
+	return i;
+}
+
+/* Backward-shift delete: pull later members of the probe run into the hole
+ * unless their home slot lies cyclically in (hole, j]. No tombstones. */
+static void lru_slot_remove(FluxLru *c, uint32_t hole) {
+	for (uint32_t j = (hole + 1) & c->slot_mask; c->slots [j]; j = (j + 1) & c->slot_mask) {
+		uint32_t home    = ( uint32_t ) c->entries [c->slots [j] - 1].hash & c->slot_mask;
+		bool     in_run  = hole <= j ? (home > hole && home <= j) : (home > hole || home <= j);
+		if (in_run) continue;
+		c->slots [hole] = c->slots [j];
+		hole            = j;
+	}
+	c->slots [hole] = 0;
+}
+
+/* Keep the load factor at or below 3/4; rehashing only reads stored hashes. */
+static bool lru_slots_reserve(FluxLru *c, uint32_t count) {
+	uint32_t slots = c->slots ? c->slot_mask + 1 : 0;
+	if (( uint64_t ) count * 4 <= ( uint64_t ) slots * 3) return true;
+	uint32_t grown = slots ? slots * 2 : 64;
+	while (( uint64_t ) count * 4 > ( uint64_t ) grown * 3) grown *= 2;
+	uint32_t *s = ( uint32_t * ) calloc(grown, sizeof(uint32_t));
+	if (!s) return false;
+	for (uint32_t i = 0; i < slots; i++) {
+		if (!c->slots [i]) continue;
+		uint32_t j = ( uint32_t ) c->entries [c->slots [i] - 1].hash & (grown - 1);
+		while (s [j]) j = (j + 1) & (grown - 1);
+		s [j] = c->slots [i];
+	}
+	free(c->slots);
+	c->slots     = s;
+	c->slot_mask = grown - 1;
+	return true;
+}
+
+static int32_t lru_entry_alloc(FluxLru *c) {
+	if (c->free_head == LRU_NONE) {
+		int32_t         cap = c->entry_cap ? c->entry_cap * 2 : 64;
+		LruEntry *e   = ( LruEntry * ) realloc(c->entries, sizeof(*e) * ( size_t ) cap);
+		if (!e) return LRU_NONE;
+		for (int32_t i = cap - 1; i >= c->entry_cap; i--) {
+			e [i].prev   = c->free_head;
+			c->free_head = i;
+		}
+		c->entries   = e;
+		c->entry_cap = cap;
+	}
+	int32_t i    = c->free_head;
+	c->free_head = c->entries [i].prev;
+	return i;
+}
+
+static void lru_unlink(FluxLru *c, int32_t i) {
+	LruEntry *e = &c->entries [i];
+	if (e->prev != LRU_NONE) c->entries [e->prev].next = e->next;
+	else c->newest = e->next;
+	if (e->next != LRU_NONE) c->entries [e->next].prev = e->prev;
+	else c->oldest = e->prev;
+}
+
+static void lru_push_newest(FluxLru *c, int32_t i) {
+	LruEntry *e = &c->entries [i];
+	e->prev           = LRU_NONE;
+	e->next           = c->newest;
+	if (c->newest != LRU_NONE) c->entries [c->newest].prev = i;
+	else c->oldest = i;
+	c->newest = i;
+}
+
+static void lru_evict(FluxLru *c, int32_t i) {
+	LruEntry *e = &c->entries [i];
+	lru_slot_remove(c, lru_slot_of(c, i));
+	lru_unlink(c, i);
+	if (c->release && e->value) c->release(e->value);
+	free(e->key);
+	c->bytes    -= e->cost;
+	c->count--;
+	c->evictions++;
+	e->prev      = c->free_head;
+	c->free_head = i;
+}
+
+/* Evict from the cold end until the budget holds, sparing @p keep. */
+static void lru_trim(FluxLru *c, int32_t keep) {
+	while (c->bytes > c->budget && c->oldest != LRU_NONE && c->oldest != keep) lru_evict(c, c->oldest);
+}
+
+FluxLru *flux_lru_create(size_t budget, FluxLruRelease release) {
+	FluxLru *c = ( FluxLru * ) calloc(1, sizeof(*c));
+	if (!c) return NULL;
+	c->free_head = LRU_NONE;
+	c->newest    = LRU_NONE;
+	c->oldest    = LRU_NONE;
+	c->budget    = budget;
+	c->release   = release;
+	return c;
+}
+
+void flux_lru_destroy(FluxLru *cache) {
+	if (!cache) return;
+	for (int32_t i = cache->newest; i != LRU_NONE; i = cache->entries [i].next) {
+		if (cache->release && cache->entries [i].value) cache->release(cache->entries [i].value);
+		free(cache->entries [i].key);
+	}
+	free(cache->entries);
+	free(cache->slots);
+	free(cache);
+}
+
+void *flux_lru_get(FluxLru *cache, FluxLruKey const *key) {
+	if (!cache || !key) return NULL;
+	if (!cache->slots) {
+		cache->misses++;
+		return NULL;
+	}
+	uint32_t slot = lru_probe(cache, lru_hash(key), key);
+	if (!cache->slots [slot]) {
+		cache->misses++;
+		return NULL;
+	}
+	int32_t i = ( int32_t ) cache->slots [slot] - 1;
+	if (cache->newest != i) {
+		lru_unlink(cache, i);
+		lru_push_newest(cache, i);
+	}
+	cache->hits++;
+	return cache->entries [i].value;
+}
+
+bool flux_lru_put(FluxLru *cache, FluxLruKey const *key, void *value, size_t cost) {
+	if (!cache || !key) return false;
+	uint64_t hash     = lru_hash(key);
+	size_t   key_size = lru_key_size(key);
+	cost             += key_size + sizeof(LruEntry);
+
+	if (cache->slots) {
+		uint32_t slot = lru_probe(cache, hash, key);
+		if (cache->slots [slot]) { /* replace in place */
+			int32_t         i = ( int32_t ) cache->slots [slot] - 1;
+			LruEntry *e = &cache->entries [i];
+			if (cache->release && e->value && e->value != value) cache->release(e->value);
+			cache->bytes += cost - e->cost;
+			e->value      = value;
+			e->cost       = cost;
+			lru_unlink(cache, i);
+			lru_push_newest(cache, i);
+			lru_trim(cache, i);
+			return true;
+		}
+	}
+
+	uint8_t *copy = ( uint8_t * ) malloc(key_size ? key_size : 1);
+	int32_t  i    = copy && lru_slots_reserve(cache, cache->count + 1) ? lru_entry_alloc(cache) : LRU_NONE;
+	if (i == LRU_NONE) {
+		free(copy);
+		if (cache->release && value) cache->release(value);
+		return false;
+	}
+	LruEntry *e = &cache->entries [i];
+	e->hash           = hash;
+	e->key            = copy;
+	e->value          = value;
+	e->cost           = cost;
+	for (int p = 0; p < FLUX_LRU_KEY_PARTS; p++) {
+		e->len [p] = key->len [p];
+		if (key->len [p]) memcpy(copy, key->data [p], key->len [p]);
+		copy += key->len [p];
+	}
+	cache->slots [lru_probe(cache, hash, key)] = ( uint32_t ) i + 1;
+	lru_push_newest(cache, i);
+	cache->count++;
+	cache->bytes += cost;
+	lru_trim(cache, i);
+	return true;
+}
+
+void flux_lru_set_budget(FluxLru *cache, size_t budget) {
+	if (!cache) return;
+	cache->budget = budget;
+	lru_trim(cache, LRU_NONE);
+}
+
+void flux_lru_stats(FluxLru const *cache, FluxLruStats *out) {
+	if (!out) return;
+	memset(out, 0, sizeof(*out));
+	if (!cache) return;
+	out->hits      = cache->hits;
+	out->misses    = cache->misses;
+	out->evictions = cache->evictions;
+	out->entries   = cache->count;
+	out->bytes     = cache->bytes;
+	out->budget    = cache->budget;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file flux_lru.h
+ * @brief Byte-budgeted LRU cache keyed on byte strings.
+ *
+ * Keys are stored in full and compared byte for byte, so a hash collision
+ * costs a probe, never a wrong layout. Lookups go through an open-addressed
+ * (linear probing, backward-shift delete) index; recency is an intrusive
+ * doubly-linked list, so hits, inserts and evictions are O(1). Each entry is
+ * charged a caller-estimated cost plus its key; inserts evict from the cold
+ * end until the total fits the budget again (the newest entry always stays).
+ *
+ * Platform-neutral: values are opaque and released through a callback. The
+ * text renderer keeps its DirectWrite formats and layouts in one, the image
+ * store its decoded bitmaps.
+ * @note This is an internal header; do not include from public API.
+ */
+#ifndef FLUX_LRU_H
+#define FLUX_LRU_H
+
+#include <xent/xent_types.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define FLUX_LRU_KEY_PARTS 3
+
+typedef struct FluxLru FluxLru;
+
+/** @brief Releases a value the cache owns (evicted, replaced or destroyed). */
+typedef void (*FluxLruRelease)(void *value);
+
+/**
+ * @brief A key made of up to FLUX_LRU_KEY_PARTS byte ranges (unused parts have len 0).
+ *
+ * Parts are compared separately, so ("ab", "c") and ("a", "bc") differ.
+ */
+typedef struct FluxLruKey {
+	void const *data [FLUX_LRU_KEY_PARTS];
+	uint32_t    len [FLUX_LRU_KEY_PARTS];
+} FluxLruKey;
+
+/** @brief Cache counters and occupancy. */
+typedef struct FluxLruStats {
+	uint64_t hits;      /**< Lookups answered from the cache. */
+	uint64_t misses;    /**< Lookups that found nothing. */
+	uint64_t evictions; /**< Entries dropped to stay within the budget. */
+	uint32_t entries;   /**< Entries currently cached. */
+	size_t   bytes;     /**< Bytes charged for the cached entries. */
+	size_t   budget;    /**< Byte budget the cache trims to. */
+} FluxLruStats;
+
+/** @brief Create an empty cache; @p release may be NULL. */
+XENT_NODISCARD FluxLru *flux_lru_create(size_t budget, FluxLruRelease release);
+
+/** @brief Release every value and free the cache (NULL is safe). */
+void                    flux_lru_destroy(FluxLru *cache);
+
+/** @brief Cached value for @p key (now the most recent), or NULL; counts a hit or a miss. */
+void                   *flux_lru_get(FluxLru *cache, FluxLruKey const *key);
+
+/**
+ * @brief Insert (or replace) the value for @p key, charged @p cost bytes.
+ *
+ * The cache owns @p value from here on, also on failure (it is released).
+ * Older entries are evicted until the budget holds.
+ */
+bool                    flux_lru_put(FluxLru *cache, FluxLruKey const *key, void *value, size_t cost);
+
+/** @brief Change the budget, evicting least recently used entries until it holds. */
+void                    flux_lru_set_budget(FluxLru *cache, size_t budget);
+
+/** @brief Counters and occupancy (zeroed for NULL). */
+void                    flux_lru_stats(FluxLru const *cache, FluxLruStats *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
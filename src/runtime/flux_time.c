@@ -24,6 +24,12 @@ double flux_perf_seconds(int64_t ticks) {
 	return ( double ) ticks / ( double ) freq;
 }
 
+uint64_t flux_perf_millis(int64_t ticks) {
+	int64_t freq = flux_perf_freq();
+	if (freq == 0 || ticks < 0) return 0;
+	return ( uint64_t ) (ticks / freq) * 1000u + ( uint64_t ) (ticks % freq) * 1000u / ( uint64_t ) freq;
+}
+
 float flux_compute_dt(int64_t prev, int64_t now) {
 	if (prev == 0) return 0.0f;
 	int64_t freq = flux_perf_freq();
@@ -27,20 +27,27 @@ extern "C"
  * @brief Get the QPC frequency (ticks per second).
  * @return Frequency (cached after first call).
  */
-int64_t flux_perf_freq(void);
+int64_t  flux_perf_freq(void);
 
 /**
  * @brief Get the current QPC tick count.
  * @return Current ticks.
  */
-int64_t flux_perf_now(void);
+int64_t  flux_perf_now(void);
 
 /**
  * @brief Convert ticks to seconds.
  * @param ticks QPC tick count.
  * @return Seconds (monotonic time since boot).
  */
-double  flux_perf_seconds(int64_t ticks);
+double   flux_perf_seconds(int64_t ticks);
+
+/**
+ * @brief Convert ticks to whole milliseconds (without the precision loss of a double).
+ * @param ticks QPC tick count.
+ * @return Milliseconds since boot.
+ */
+uint64_t flux_perf_millis(int64_t ticks);
 
 /**
  * @brief Compute delta time between two tick values.
@@ -52,7 +59,7 @@ double  flux_perf_seconds(int64_t ticks);
  * @param now Current frame's tick count.
  * @return Delta time in seconds.
  */
-float   flux_compute_dt(int64_t prev, int64_t now);
+float    flux_compute_dt(int64_t prev, int64_t now);
 
 #ifdef __cplusplus
 }
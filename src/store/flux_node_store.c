@@ -4,80 +4,113 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define FLUX_NS_EMPTY    0
-#define FLUX_NS_OCCUPIED 1
-#define FLUX_NS_DELETED  2
+/* Node data lives in fixed-size chunks that are never reallocated, so the
+ * FluxNodeData pointers handed out (and stashed in xent userdata) stay valid
+ * for the node's lifetime however far the store grows. XentNodeIds are dense
+ * indices, so a flat id -> slot table replaces hashing; live slots are also
+ * listed densely for iteration, and freed slots are recycled through a free
+ * list with their generation bumped so stale handles resolve to NULL.
+ *
+ * Each chunk keeps the event callbacks in a column of its own: traversals
+ * (collect, hit testing, the touch walk) only read the slot column, so the
+ * thirteen callback/context pairs no node visit needs stay out of cache. */
+#define FLUX_NS_CHUNK_SHIFT 8u
+#define FLUX_NS_CHUNK_SIZE  (1u << FLUX_NS_CHUNK_SHIFT)
+#define FLUX_NS_NO_SLOT     UINT32_MAX
+#define FLUX_NS_MAX_DIRTY   64u /* more dirty boundaries than this and a full pass is cheaper */
 
 typedef struct FluxNodeSlot {
-	uint8_t      tag;
-	XentNodeId   key;
 	FluxNodeData data;
+	XentNodeId   key;         /**< Owning node, XENT_NODE_INVALID while free. */
+	uint32_t     generation;  /**< Bumped each time the slot is freed. */
+	uint32_t     link;        /**< Position in live[] while occupied; next free slot while free. */
+	bool         moves_alone; /**< Laid out on its own the boundary still left its place; relay around it. */
 } FluxNodeSlot;
 
+typedef struct FluxNodeChunk {
+	FluxNodeSlot     slots [FLUX_NS_CHUNK_SIZE];    /**< Hot column, walked by traversals. */
+	FluxNodeBehavior behavior [FLUX_NS_CHUNK_SIZE]; /**< Cold column, reached through FluxNodeData.behavior. */
+} FluxNodeChunk;
+
 struct FluxNodeStore {
-	FluxNodeSlot     *slots;
-	uint32_t          capacity;
+	FluxNodeChunk   **chunks;
+	uint32_t          chunk_count;
+	uint32_t          slot_count; /**< Slots handed out so far (occupied or on the free list). */
+	uint32_t          free_head;  /**< First recycled slot, FLUX_NS_NO_SLOT when empty. */
+	uint32_t         *index;      /**< XentNodeId -> slot + 1; 0 when the node has no data. */
+	uint32_t          index_capacity;
+	uint32_t         *live;       /**< Occupied slots, densely packed. */
+	uint32_t          live_capacity;
 	uint32_t          count;
-	uint32_t          tombstones;
 	XentContext      *ctx;        /**< Context the nodes live in; bound at scene creation. */
+	uint32_t          generation; /**< Last value handed out by flux_node_store_touch. */
 	FluxNodeRemovedFn removed_fn; /**< Notified before a destroyed node's data is freed. */
 	void             *removed_userdata;
+	uint32_t          layout_generation; /**< Bumped whenever layout inputs may have changed. */
+	uint32_t          laid_out_generation;
+	XentNodeId        laid_out_root;
+	float             laid_out_w;
+	float             laid_out_h;
+	uint32_t          layout_count;
+	XentNodeId        dirty_roots [FLUX_NS_MAX_DIRTY]; /**< Boundaries to relay on the next layout. */
+	uint32_t          dirty_count;
+	uint32_t          partial_count;
 };
 
-static uint32_t flux_ns_hash(XentNodeId id, uint32_t cap) {
-	uint32_t h  = id;
-	h          ^= h >> 16;
-	h          *= 0x45d9f3b;
-	h          ^= h >> 16;
-	return h & (cap - 1);
-}
-
-static bool flux_ns_needs_grow(FluxNodeStore const *store) {
-	return (store->count + store->tombstones) * 4 >= store->capacity * 3;
+static FluxNodeSlot *flux_ns_slot(FluxNodeStore const *store, uint32_t slot) {
+	return &store->chunks [slot >> FLUX_NS_CHUNK_SHIFT]->slots [slot & (FLUX_NS_CHUNK_SIZE - 1)];
 }
 
-static bool flux_ns_needs_rehash(FluxNodeStore const *store) {
-	return store->tombstones > store->count && store->tombstones > 16;
+static FluxNodeBehavior *flux_ns_behavior(FluxNodeStore const *store, uint32_t slot) {
+	return &store->chunks [slot >> FLUX_NS_CHUNK_SHIFT]->behavior [slot & (FLUX_NS_CHUNK_SIZE - 1)];
 }
 
-static void flux_ns_probe_next(uint32_t *idx, uint32_t *step, uint32_t cap) {
-	(*step)++;
-	*idx = (*idx + *step) & (cap - 1);
+static bool flux_ns_reserve_index(FluxNodeStore *store, XentNodeId id) {
+	if (id < store->index_capacity) return true;
+	uint32_t new_cap = store->index_capacity ? store->index_capacity : 64;
+	while (new_cap <= id) new_cap *= 2;
+	uint32_t *index = ( uint32_t * ) realloc(store->index, ( size_t ) new_cap * sizeof(*index));
+	if (!index) return false;
+	memset(index + store->index_capacity, 0, ( size_t ) (new_cap - store->index_capacity) * sizeof(*index));
+	store->index          = index;
+	store->index_capacity = new_cap;
+	return true;
 }
 
-static void flux_ns_insert_rehashed_slot(FluxNodeSlot *slots, uint32_t cap, FluxNodeSlot const *src) {
-	uint32_t idx  = flux_ns_hash(src->key, cap);
-	uint32_t step = 0;
-	while (slots [idx].tag != FLUX_NS_EMPTY) flux_ns_probe_next(&idx, &step, cap);
-
-	slots [idx].tag  = FLUX_NS_OCCUPIED;
-	slots [idx].key  = src->key;
-	slots [idx].data = src->data;
+static bool flux_ns_reserve_live(FluxNodeStore *store, uint32_t count) {
+	if (count <= store->live_capacity) return true;
+	uint32_t new_cap = store->live_capacity ? store->live_capacity : 64;
+	while (new_cap < count) new_cap *= 2;
+	uint32_t *live = ( uint32_t * ) realloc(store->live, ( size_t ) new_cap * sizeof(*live));
+	if (!live) return false;
+	store->live          = live;
+	store->live_capacity = new_cap;
+	return true;
 }
 
-static bool flux_ns_rehash(FluxNodeStore *store, uint32_t new_cap) {
-	if (new_cap < 64) new_cap = 64;
-
-	FluxNodeSlot *new_slots = ( FluxNodeSlot * ) calloc(new_cap, sizeof(FluxNodeSlot));
-	if (!new_slots) return false;
-
-	for (uint32_t i = 0; i < store->capacity; i++)
-		if (store->slots [i].tag == FLUX_NS_OCCUPIED)
-			flux_ns_insert_rehashed_slot(new_slots, new_cap, &store->slots [i]);
-
-	free(store->slots);
-	store->slots      = new_slots;
-	store->capacity   = new_cap;
-	store->tombstones = 0;
+/* Adds one chunk; only the chunk table moves, never the slots. */
+static bool flux_ns_add_chunk(FluxNodeStore *store) {
+	FluxNodeChunk **chunks
+	  = ( FluxNodeChunk ** ) realloc(store->chunks, ( size_t ) (store->chunk_count + 1) * sizeof(*chunks));
+	if (!chunks) return false;
+	store->chunks = chunks;
+
+	FluxNodeChunk *chunk = ( FluxNodeChunk * ) calloc(1, sizeof(FluxNodeChunk));
+	if (!chunk) return false;
+	for (uint32_t i = 0; i < FLUX_NS_CHUNK_SIZE; i++) chunk->slots [i].key = XENT_NODE_INVALID;
+	store->chunks [store->chunk_count++] = chunk;
 	return true;
 }
 
-static bool flux_ns_grow(FluxNodeStore *store) { return flux_ns_rehash(store, store->capacity * 2); }
-
-static bool flux_ns_prepare_insert(FluxNodeStore *store) {
-	if (flux_ns_needs_grow(store)) return flux_ns_grow(store);
-	if (flux_ns_needs_rehash(store)) return flux_ns_rehash(store, store->capacity);
-	return true;
+static uint32_t flux_ns_alloc_slot(FluxNodeStore *store) {
+	if (store->free_head != FLUX_NS_NO_SLOT) {
+		uint32_t slot    = store->free_head;
+		store->free_head = flux_ns_slot(store, slot)->link;
+		return slot;
+	}
+	if (store->slot_count == store->chunk_count * FLUX_NS_CHUNK_SIZE && !flux_ns_add_chunk(store))
+		return FLUX_NS_NO_SLOT;
+	return store->slot_count++;
 }
 
 static void flux_node_data_destroy_component(FluxNodeData *d) {
@@ -95,20 +128,16 @@ static void flux_node_data_destroy_component(FluxNodeData *d) {
 	d->component_type         = FLUX_CONTROL_CONTAINER;
 }
 
-static FluxNodeSlot *flux_ns_find(FluxNodeStore *store, XentNodeId id) {
-	uint32_t idx  = flux_ns_hash(id, store->capacity);
-	uint32_t step = 0;
-	for (;;) {
-		FluxNodeSlot *s = &store->slots [idx];
-		if (s->tag == FLUX_NS_EMPTY) return NULL;
-		if (s->tag == FLUX_NS_OCCUPIED && s->key == id) return s;
-		flux_ns_probe_next(&idx, &step, store->capacity);
-	}
+static FluxNodeSlot *flux_ns_find(FluxNodeStore const *store, XentNodeId id) {
+	if (id >= store->index_capacity || !store->index [id]) return NULL;
+	return flux_ns_slot(store, store->index [id] - 1);
 }
 
-static void flux_node_data_init(FluxNodeData *d, XentNodeId id) {
+static void flux_node_data_init(FluxNodeData *d, FluxNodeBehavior *behavior, XentNodeId id) {
 	memset(d, 0, sizeof(*d));
+	memset(behavior, 0, sizeof(*behavior));
 	d->node_id         = id;
+	d->behavior        = behavior;
 	d->visuals.opacity = 1.0f;
 	d->render_scale    = 1.0f;
 	d->render_opacity  = 1.0f;
@@ -116,72 +145,93 @@ static void flux_node_data_init(FluxNodeData *d, XentNodeId id) {
 	d->component_type  = FLUX_CONTROL_CONTAINER;
 }
 
-static FluxNodeSlot *flux_ns_find_insert_slot(FluxNodeStore *store, XentNodeId id, bool *was_tombstone) {
-	uint32_t      idx        = flux_ns_hash(id, store->capacity);
-	uint32_t      step       = 0;
-	FluxNodeSlot *first_dead = NULL;
-	for (;;) {
-		FluxNodeSlot *s = &store->slots [idx];
-		if (s->tag == FLUX_NS_DELETED && !first_dead) first_dead = s;
-		if (s->tag == FLUX_NS_EMPTY) {
-			FluxNodeSlot *dst = first_dead ? first_dead : s;
-			*was_tombstone    = dst->tag == FLUX_NS_DELETED;
-			return dst;
-		}
-		flux_ns_probe_next(&idx, &step, store->capacity);
-	}
-}
-
-static FluxNodeData *flux_ns_occupy_slot(FluxNodeStore *store, FluxNodeSlot *slot, XentNodeId id, bool was_tombstone) {
-	slot->tag = FLUX_NS_OCCUPIED;
-	slot->key = id;
-	flux_node_data_init(&slot->data, id);
-	store->count++;
-	if (was_tombstone) store->tombstones--;
-	return &slot->data;
+static FluxNodeSlot *flux_ns_insert(FluxNodeStore *store, XentNodeId id) {
+	if (!flux_ns_reserve_index(store, id) || !flux_ns_reserve_live(store, store->count + 1)) return NULL;
+	uint32_t slot = flux_ns_alloc_slot(store);
+	if (slot == FLUX_NS_NO_SLOT) return NULL;
+
+	FluxNodeSlot *s = flux_ns_slot(store, slot);
+	s->key          = id;
+	s->link         = store->count;
+	s->moves_alone  = false;
+	flux_node_data_init(&s->data, flux_ns_behavior(store, slot), id);
+	store->live [store->count++] = slot;
+	store->index [id]            = slot + 1;
+	/* Slots never move (chunks are not reallocated), so binding once is enough. */
+	if (store->ctx) xent_set_userdata(store->ctx, id, &s->data);
+	return s;
 }
 
 FluxNodeStore *flux_node_store_create(uint32_t initial_capacity) {
 	FluxNodeStore *store = ( FluxNodeStore * ) calloc(1, sizeof(*store));
 	if (!store) return NULL;
-
-	uint32_t cap = 64;
-	while (cap < initial_capacity) cap *= 2;
-
-	store->slots = ( FluxNodeSlot * ) calloc(cap, sizeof(FluxNodeSlot));
-	if (!store->slots) {
-		free(store);
+	store->free_head         = FLUX_NS_NO_SLOT;
+	store->layout_generation = 1; /* laid_out_generation starts at 0: the first layout runs */
+
+	uint32_t cap = initial_capacity < 64 ? 64 : initial_capacity;
+	bool     ok  = flux_ns_reserve_index(store, cap - 1) && flux_ns_reserve_live(store, cap);
+	while (ok && store->chunk_count * FLUX_NS_CHUNK_SIZE < cap) ok = flux_ns_add_chunk(store);
+	if (!ok) {
+		flux_node_store_destroy(store);
 		return NULL;
 	}
-	store->capacity = cap;
 	return store;
 }
 
 void flux_node_store_destroy(FluxNodeStore *store) {
 	if (!store) return;
 	if (store->ctx) xent_set_node_lifecycle_callback(store->ctx, NULL, NULL);
-	for (uint32_t i = 0; i < store->capacity; i++)
-		if (store->slots [i].tag == FLUX_NS_OCCUPIED) flux_node_data_destroy_component(&store->slots [i].data);
-	free(store->slots);
+	for (uint32_t i = 0; i < store->count; i++)
+		flux_node_data_destroy_component(&flux_ns_slot(store, store->live [i])->data);
+	for (uint32_t i = 0; i < store->chunk_count; i++) free(store->chunks [i]);
+	free(store->chunks);
+	free(store->index);
+	free(store->live);
 	free(store);
 }
 
-FluxNodeData *flux_node_store_get(FluxNodeStore *store, XentNodeId id) {
+/* Stamps the node and every ancestor that has store data; plain layout
+ * nodes in between are walked through but carry no generation. */
+static void flux_ns_touch_from(FluxNodeStore *store, FluxNodeSlot *slot) {
+	uint32_t gen          = ++store->generation;
+	slot->data.generation = gen;
+	if (!store->ctx) return;
+	for (XentNodeId n = xent_get_parent(store->ctx, slot->key); n != XENT_NODE_INVALID;
+	  n               = xent_get_parent(store->ctx, n))
+	{
+		FluxNodeSlot *s = flux_ns_find(store, n);
+		if (s) s->data.generation = gen;
+	}
+}
+
+FluxNodeData const *flux_node_store_get(FluxNodeStore const *store, XentNodeId id) {
 	if (!store || id == XENT_NODE_INVALID) return NULL;
 	FluxNodeSlot *s = flux_ns_find(store, id);
 	return s ? &s->data : NULL;
 }
 
+FluxNodeData *flux_node_store_edit(FluxNodeStore *store, XentNodeId id) {
+	if (!store || id == XENT_NODE_INVALID) return NULL;
+	FluxNodeSlot *s = flux_ns_find(store, id);
+	if (!s) return NULL;
+	flux_ns_touch_from(store, s);
+	return &s->data;
+}
+
 FluxNodeData *flux_node_store_get_or_create(FluxNodeStore *store, XentNodeId id) {
 	if (!store || id == XENT_NODE_INVALID) return NULL;
 
-	FluxNodeSlot *existing = flux_ns_find(store, id);
-	if (existing) return &existing->data;
-	if (!flux_ns_prepare_insert(store)) return NULL;
+	FluxNodeSlot *s = flux_ns_find(store, id);
+	if (!s) s = flux_ns_insert(store, id);
+	if (!s) return NULL;
+	flux_ns_touch_from(store, s);
+	return &s->data;
+}
 
-	bool          was_tombstone = false;
-	FluxNodeSlot *slot          = flux_ns_find_insert_slot(store, id, &was_tombstone);
-	return flux_ns_occupy_slot(store, slot, id, was_tombstone);
+void flux_node_store_touch(FluxNodeStore *store, XentNodeId id) {
+	if (!store || id == XENT_NODE_INVALID) return;
+	FluxNodeSlot *s = flux_ns_find(store, id);
+	if (s) flux_ns_touch_from(store, s);
 }
 
 void flux_node_store_remove(FluxNodeStore *store, XentNodeId id) {
@@ -189,9 +239,38 @@ void flux_node_store_remove(FluxNodeStore *store, XentNodeId id) {
 	FluxNodeSlot *s = flux_ns_find(store, id);
 	if (!s) return;
 	flux_node_data_destroy_component(&s->data);
-	s->tag = FLUX_NS_DELETED;
-	store->count--;
-	store->tombstones++;
+	for (uint32_t i = 0; i < store->dirty_count; i++)
+		if (store->dirty_roots [i] == id) store->dirty_roots [i--] = store->dirty_roots [--store->dirty_count];
+
+	/* Swap-remove from the dense list, then recycle the slot. The memory stays
+	 * put, so a stale pointer reads a dead slot rather than freed memory. */
+	uint32_t slot                   = store->index [id] - 1;
+	uint32_t last                   = store->live [--store->count];
+	store->live [s->link]           = last;
+	flux_ns_slot(store, last)->link = s->link;
+	store->index [id]               = 0;
+
+	s->key           = XENT_NODE_INVALID;
+	s->link          = store->free_head;
+	store->free_head = slot;
+	s->generation++;
+}
+
+FluxNodeHandle flux_node_store_handle(FluxNodeStore const *store, XentNodeId id) {
+	FluxNodeHandle handle = {FLUX_NODE_HANDLE_NO_SLOT, 0};
+	if (!store || id == XENT_NODE_INVALID) return handle;
+	FluxNodeSlot const *s = flux_ns_find(store, id);
+	if (!s) return handle;
+	handle.slot       = store->index [id] - 1;
+	handle.generation = s->generation;
+	return handle;
+}
+
+FluxNodeData const *flux_node_store_resolve(FluxNodeStore const *store, FluxNodeHandle handle) {
+	if (!store || handle.slot >= store->slot_count) return NULL;
+	FluxNodeSlot *s = flux_ns_slot(store, handle.slot);
+	if (s->key == XENT_NODE_INVALID || s->generation != handle.generation) return NULL;
+	return &s->data;
 }
 
 uint32_t    flux_node_store_count(FluxNodeStore const *store) { return store ? store->count : 0; }
@@ -208,9 +287,10 @@ static void flux_ns_on_node_lifecycle(
 	( void ) ctx;
 	( void ) old_parent;
 	( void ) new_parent;
+	FluxNodeStore *store = ( FluxNodeStore * ) userdata;
+	store->layout_generation++;
 	if (event != XENT_NODE_EVENT_DESTROY) return;
 
-	FluxNodeStore *store = ( FluxNodeStore * ) userdata;
 	if (store->removed_fn) store->removed_fn(store->removed_userdata, node);
 	flux_node_store_remove(store, node);
 }
@@ -218,7 +298,10 @@ static void flux_ns_on_node_lifecycle(
 void flux_node_store_bind_context(FluxNodeStore *store, XentContext *ctx) {
 	if (!store) return;
 	store->ctx = ctx;
-	if (ctx) xent_set_node_lifecycle_callback(ctx, flux_ns_on_node_lifecycle, store);
+	store->layout_generation++;
+	if (!ctx) return;
+	xent_set_node_lifecycle_callback(ctx, flux_ns_on_node_lifecycle, store);
+	flux_node_store_attach_userdata(store, ctx); /* nodes added before binding */
 }
 
 void flux_node_store_set_remove_listener(FluxNodeStore *store, FluxNodeRemovedFn fn, void *userdata) {
@@ -238,9 +321,114 @@ XentContext *flux_node_store_context(FluxNodeStore const *store) { return store
 void         flux_node_store_attach_userdata(FluxNodeStore *store, XentContext *ctx) {
 	if (!store || !ctx) return;
 	store->ctx = ctx;
-	for (uint32_t i = 0; i < store->capacity; i++) {
-		if (store->slots [i].tag != FLUX_NS_OCCUPIED) continue;
-		FluxNodeData *d = &store->slots [i].data;
+	for (uint32_t i = 0; i < store->count; i++) {
+		FluxNodeData *d = &flux_ns_slot(store, store->live [i])->data;
 		xent_set_userdata(ctx, d->node_id, d);
 	}
 }
+
+void flux_node_store_invalidate_layout(FluxNodeStore *store) {
+	if (store) store->layout_generation++;
+}
+
+uint32_t flux_node_store_layout_generation(FluxNodeStore const *store) { return store ? store->layout_generation : 0; }
+
+/* xent only lays out from a root, and places the root at the origin. A
+ * boundary's extent is its own, so laid out as a root it comes back unchanged
+ * as long as it already sits at the origin; anywhere else it would move, and
+ * xent offers no way to place a root or shift a laid-out subtree. Such a
+ * boundary is passed over before any work is done: the change goes to the
+ * next boundary out, or to the full pass. */
+static bool flux_ns_relays_alone(FluxNodeStore const *store, XentNodeId node, XentRect *rect) {
+	FluxNodeSlot const *s = flux_ns_find(store, node);
+	if (!s || !s->data.layout_boundary || s->moves_alone) return false;
+	return xent_get_layout_rect(store->ctx, node, rect) && rect->x == 0.0f && rect->y == 0.0f;
+}
+
+void flux_node_store_invalidate_node_layout(FluxNodeStore *store, XentNodeId id) {
+	if (!store) return;
+	XentNodeId boundary = XENT_NODE_INVALID;
+	if (store->ctx) {
+		for (XentNodeId n = id; n != XENT_NODE_INVALID; n = xent_get_parent(store->ctx, n)) {
+			XentRect rect;
+			if (flux_ns_relays_alone(store, n, &rect)) {
+				boundary = n;
+				break;
+			}
+		}
+	}
+	if (boundary == XENT_NODE_INVALID || store->dirty_count == FLUX_NS_MAX_DIRTY) {
+		store->layout_generation++;
+		return;
+	}
+	for (uint32_t i = 0; i < store->dirty_count; i++)
+		if (store->dirty_roots [i] == boundary) return;
+	store->dirty_roots [store->dirty_count++] = boundary;
+}
+
+void flux_node_store_set_layout_boundary(FluxNodeStore *store, XentNodeId id, bool boundary) {
+	FluxNodeSlot *s = store ? flux_ns_find(store, id) : NULL;
+	if (!s) return;
+	s->data.layout_boundary = boundary;
+	s->moves_alone          = false;
+}
+
+/* The origin is checked again here, since a full pass may have moved the
+ * boundary since it was queued. Should xent still place it elsewhere, it is
+ * relaid by the full pass this frame and passed over from then on. */
+static bool flux_ns_layout_boundary(FluxNodeStore *store, XentNodeId node) {
+	XentRect before, after;
+	if (!flux_ns_relays_alone(store, node, &before)) return false;
+	xent_layout(store->ctx, node, before.w, before.h);
+	store->partial_count++;
+	if (!xent_get_layout_rect(store->ctx, node, &after)) return false;
+	if (after.x != before.x || after.y != before.y) {
+		flux_ns_find(store, node)->moves_alone = true;
+		return false;
+	}
+	return after.w == before.w && after.h == before.h;
+}
+
+/* Queued ids are raw XentNodeIds: drop any whose node was destroyed (or whose
+ * id now names a node that is not a boundary) before laying them out. */
+static void flux_ns_prune_dirty(FluxNodeStore *store) {
+	uint32_t kept = 0;
+	for (uint32_t i = 0; i < store->dirty_count; i++) {
+		XentNodeId          n = store->dirty_roots [i];
+		FluxNodeSlot const *s = flux_ns_find(store, n);
+		if (s && s->data.layout_boundary && xent_is_valid_node(store->ctx, n)) store->dirty_roots [kept++] = n;
+	}
+	store->dirty_count = kept;
+}
+
+bool flux_node_store_layout(FluxNodeStore *store, XentNodeId root, float width, float height) {
+	if (!store || !store->ctx || root == XENT_NODE_INVALID) return false;
+	bool full = store->laid_out_generation != store->layout_generation || store->laid_out_root != root
+	         || store->laid_out_w != width || store->laid_out_h != height;
+	if (!full && store->dirty_count == 0) return false;
+
+	flux_ns_prune_dirty(store);
+	uint32_t dirty     = store->dirty_count;
+	store->dirty_count = 0;
+	for (uint32_t i = 0; i < dirty && !full; i++)
+		full = !flux_ns_layout_boundary(store, store->dirty_roots [i]);
+	if (!full) return false;
+
+	/* Stamp before laying out: the lifecycle callback does not fire from inside
+	 * xent_layout, so anything bumped later belongs to the next pass. */
+	store->laid_out_generation = store->layout_generation;
+	store->laid_out_root       = root;
+	store->laid_out_w          = width;
+	store->laid_out_h          = height;
+	store->layout_count++;
+	xent_layout(store->ctx, root, width, height);
+	return true;
+}
+
+bool flux_node_store_layout_pending(FluxNodeStore const *store) {
+	return store && (store->laid_out_generation != store->layout_generation || store->dirty_count > 0);
+}
+
+uint32_t flux_node_store_layout_count(FluxNodeStore const *store) { return store ? store->layout_count : 0; }
+
+uint32_t flux_node_store_partial_layout_count(FluxNodeStore const *store) { return store ? store->partial_count : 0; }
@@ -1,96 +1,199 @@
 #include "fluxent/flux_plugin.h"
+#include "runtime/flux_str.h"
+#include "runtime/flux_time.h"
+
 #include <stdlib.h>
 #include <string.h>
 
-#define FLUX_MAX_PLUGINS 16
-#define FLUX_KEY_MAX     32
+/* Type names are interned on registration: each gets a small id that indexes
+ * the slot array, so dispatch by id never compares strings. Names resolve
+ * through an open-addressed table of ids. Ids outlive unregistration, so an id
+ * cached by the caller stays valid and a type registered again gets its old
+ * id back. */
+#define FLUX_PLUGIN_MIN_SLOTS 16u
 
 typedef struct FluxPluginSlot {
-	char       key [FLUX_KEY_MAX];
-	FluxPlugin plugin;
-	bool       occupied;
+	char const     *key; /**< Owned copy of the type name. */
+	uint32_t        hash;
+	bool            occupied; /**< A plugin is registered under the name. */
+	FluxPlugin      plugin;
+	FluxPluginStats stats;
 } FluxPluginSlot;
 
 struct FluxPluginRegistry {
-	FluxPluginSlot slots [FLUX_MAX_PLUGINS];
+	FluxPluginSlot *slots; /**< Indexed by id; slot 0 stands for FLUX_PLUGIN_INVALID. */
+	uint32_t        count; /**< Ids handed out, plus the invalid one. */
+	uint32_t        capacity;
+	uint32_t       *index; /**< Open-addressed ids, 0 when empty; power-of-two size. */
+	uint32_t        index_capacity;
 };
 
-FluxPluginRegistry *flux_plugin_registry_create(void) {
-	FluxPluginRegistry *reg = calloc(1, sizeof(FluxPluginRegistry));
-	return reg;
+static uint32_t plugin_hash(char const *s) {
+	uint32_t h = 2166136261u; /* FNV-1a */
+	for (; *s; s++) h = (h ^ ( uint8_t ) *s) * 16777619u;
+	return h;
 }
 
-void flux_plugin_registry_destroy(FluxPluginRegistry *reg) {
-	if (!reg) return;
+static FluxPluginId plugin_lookup(FluxPluginRegistry const *reg, char const *type, uint32_t hash) {
+	uint32_t mask = reg->index_capacity - 1;
+	for (uint32_t i = hash & mask; reg->index [i]; i = (i + 1) & mask) {
+		FluxPluginSlot const *slot = &reg->slots [reg->index [i]];
+		if (slot->hash == hash && strcmp(slot->key, type) == 0) return reg->index [i];
+	}
+	return FLUX_PLUGIN_INVALID;
+}
 
-	for (int i = 0; i < FLUX_MAX_PLUGINS; ++i) {
-		FluxPluginSlot *slot = &reg->slots [i];
-		if (slot->occupied && slot->plugin.destroy) slot->plugin.destroy(slot->plugin.userdata);
+static void plugin_index_put(uint32_t *index, uint32_t capacity, uint32_t hash, FluxPluginId id) {
+	uint32_t i = hash & (capacity - 1);
+	while (index [i]) i = (i + 1) & (capacity - 1);
+	index [i] = id;
+}
+
+/* Both arrays grow by doubling; the index stays at most half full. */
+static bool plugin_reserve(FluxPluginRegistry *reg) {
+	if (reg->count == reg->capacity) {
+		uint32_t        cap   = reg->capacity * 2;
+		FluxPluginSlot *slots = ( FluxPluginSlot * ) realloc(reg->slots, cap * sizeof(*slots));
+		if (!slots) return false;
+		memset(slots + reg->capacity, 0, (cap - reg->capacity) * sizeof(*slots));
+		reg->slots    = slots;
+		reg->capacity = cap;
 	}
-	free(reg);
+	if (reg->count * 2 >= reg->index_capacity) {
+		uint32_t  cap   = reg->index_capacity * 2;
+		uint32_t *index = ( uint32_t * ) calloc(cap, sizeof(*index));
+		if (!index) return false;
+		for (uint32_t id = 1; id < reg->count; id++) plugin_index_put(index, cap, reg->slots [id].hash, id);
+		free(reg->index);
+		reg->index          = index;
+		reg->index_capacity = cap;
+	}
+	return true;
 }
 
-static bool plugin_key_matches(FluxPluginSlot const *slot, char const *type) {
-	return slot->occupied && strncmp(slot->key, type, FLUX_KEY_MAX - 1) == 0;
+static FluxPluginId plugin_intern(FluxPluginRegistry *reg, char const *type) {
+	uint32_t     hash = plugin_hash(type);
+	FluxPluginId id   = plugin_lookup(reg, type, hash);
+	if (id != FLUX_PLUGIN_INVALID) return id;
+
+	char const *key = flux_str_dup(type);
+	if (!key || !plugin_reserve(reg)) {
+		flux_str_free(key);
+		return FLUX_PLUGIN_INVALID;
+	}
+	id                   = reg->count++;
+	reg->slots [id].key  = key;
+	reg->slots [id].hash = hash;
+	plugin_index_put(reg->index, reg->index_capacity, hash, id);
+	return id;
 }
 
-static void plugin_destroy_slot(FluxPluginSlot *slot) {
-	if (slot->occupied && slot->plugin.destroy) slot->plugin.destroy(slot->plugin.userdata);
+static FluxPluginSlot *plugin_slot(FluxPluginRegistry const *reg, FluxPluginId id) {
+	return reg && id != FLUX_PLUGIN_INVALID && id < reg->count ? &reg->slots [id] : NULL;
 }
 
-static int plugin_find_index(FluxPluginRegistry const *reg, char const *type, int *empty) {
-	if (empty) *empty = -1;
-	for (int i = 0; i < FLUX_MAX_PLUGINS; ++i) {
-		FluxPluginSlot const *slot = &reg->slots [i];
-		if (plugin_key_matches(slot, type)) return i;
-		if (empty && !slot->occupied && *empty < 0) *empty = i;
+FluxPluginRegistry *flux_plugin_registry_create(void) {
+	FluxPluginRegistry *reg = ( FluxPluginRegistry * ) calloc(1, sizeof(FluxPluginRegistry));
+	if (!reg) return NULL;
+	reg->capacity       = FLUX_PLUGIN_MIN_SLOTS;
+	reg->index_capacity = FLUX_PLUGIN_MIN_SLOTS * 2;
+	reg->slots          = ( FluxPluginSlot * ) calloc(reg->capacity, sizeof(FluxPluginSlot));
+	reg->index          = ( uint32_t * ) calloc(reg->index_capacity, sizeof(uint32_t));
+	reg->count          = 1;
+	if (!reg->slots || !reg->index) {
+		flux_plugin_registry_destroy(reg);
+		return NULL;
 	}
-	return -1;
+	return reg;
 }
 
-void flux_plugin_register(FluxPluginRegistry *reg, char const *type, FluxPlugin plugin) {
-	if (!reg || !type) return;
+void flux_plugin_registry_destroy(FluxPluginRegistry *reg) {
+	if (!reg) return;
 
-	int empty = -1;
-	int found = plugin_find_index(reg, type, &empty);
-	if (found >= 0) {
-		FluxPluginSlot *slot = &reg->slots [found];
-		plugin_destroy_slot(slot);
-		slot->plugin = plugin;
-		return;
+	for (uint32_t id = 1; id < reg->count; id++) {
+		FluxPluginSlot *slot = &reg->slots [id];
+		if (slot->occupied && slot->plugin.destroy) slot->plugin.destroy(slot->plugin.userdata);
+		flux_str_free(slot->key);
 	}
+	free(reg->slots);
+	free(reg->index);
+	free(reg);
+}
 
-	if (empty < 0) return;
+FluxPluginId flux_plugin_register(FluxPluginRegistry *reg, char const *type, FluxPlugin plugin) {
+	if (!reg || !type) return FLUX_PLUGIN_INVALID;
 
-	FluxPluginSlot *slot = &reg->slots [empty];
-	strncpy_s(slot->key, FLUX_KEY_MAX, type, _TRUNCATE);
+	FluxPluginId id = plugin_intern(reg, type);
+	if (id == FLUX_PLUGIN_INVALID) return id;
+	FluxPluginSlot *slot = &reg->slots [id];
+	if (slot->occupied && slot->plugin.destroy) slot->plugin.destroy(slot->plugin.userdata);
+	slot = &reg->slots [id]; /* the destroy callback may have registered more */
 	slot->plugin   = plugin;
 	slot->occupied = true;
+	slot->stats    = (FluxPluginStats) {0};
+	return id;
 }
 
 void flux_plugin_unregister(FluxPluginRegistry *reg, char const *type) {
-	if (!reg || !type) return;
+	FluxPluginSlot *slot = plugin_slot(reg, flux_plugin_find(reg, type));
+	if (!slot || !slot->occupied) return;
 
-	int found = plugin_find_index(reg, type, NULL);
-	if (found < 0) return;
+	FluxPlugin plugin = slot->plugin;
+	slot->occupied    = false;
+	slot->plugin      = (FluxPlugin) {0};
+	if (plugin.destroy) plugin.destroy(plugin.userdata);
+}
 
-	FluxPluginSlot *slot = &reg->slots [found];
-	plugin_destroy_slot(slot);
-	memset(slot, 0, sizeof(FluxPluginSlot));
+FluxPluginId flux_plugin_find(FluxPluginRegistry const *reg, char const *type) {
+	if (!reg || !type) return FLUX_PLUGIN_INVALID;
+	return plugin_lookup(reg, type, plugin_hash(type));
 }
 
 FluxPlugin const *flux_plugin_get(FluxPluginRegistry const *reg, char const *type) {
-	if (!reg || !type) return NULL;
+	return flux_plugin_get_id(reg, flux_plugin_find(reg, type));
+}
+
+FluxPlugin const *flux_plugin_get_id(FluxPluginRegistry const *reg, FluxPluginId id) {
+	FluxPluginSlot const *slot = plugin_slot(reg, id);
+	return slot && slot->occupied ? &slot->plugin : NULL;
+}
 
-	int found = plugin_find_index(reg, type, NULL);
-	return found >= 0 ? &reg->slots [found].plugin : NULL;
+char const *flux_plugin_name(FluxPluginRegistry const *reg, FluxPluginId id) {
+	FluxPluginSlot const *slot = plugin_slot(reg, id);
+	return slot ? slot->key : NULL;
 }
 
+uint32_t flux_plugin_id_limit(FluxPluginRegistry const *reg) { return reg ? reg->count : 0; }
+
+/* Each update is timed on its own; the slot is looked up again afterwards
+ * because an update may register plugins and move the slot array. */
 void flux_plugin_update_all(FluxPluginRegistry *reg, float dt) {
 	if (!reg) return;
 
-	for (int i = 0; i < FLUX_MAX_PLUGINS; ++i) {
-		FluxPluginSlot *slot = &reg->slots [i];
-		if (slot->occupied && slot->plugin.update) slot->plugin.update(dt, slot->plugin.userdata);
+	for (FluxPluginId id = 1; id < reg->count; id++) {
+		FluxPlugin plugin = reg->slots [id].plugin;
+		if (!reg->slots [id].occupied || !plugin.update) continue;
+
+		int64_t t0 = flux_perf_now();
+		plugin.update(dt, plugin.userdata);
+		double spent = flux_perf_seconds(flux_perf_now() - t0);
+
+		FluxPluginStats *stats = &reg->slots [id].stats;
+		stats->updates++;
+		stats->last_seconds   = spent;
+		stats->total_seconds += spent;
+		if (spent > stats->max_seconds) stats->max_seconds = spent;
 	}
 }
+
+bool flux_plugin_get_stats(FluxPluginRegistry const *reg, FluxPluginId id, FluxPluginStats *out) {
+	FluxPluginSlot const *slot = plugin_slot(reg, id);
+	if (!slot || !slot->occupied || !out) return false;
+	*out = slot->stats;
+	return true;
+}
+
+void flux_plugin_reset_stats(FluxPluginRegistry *reg) {
+	if (!reg) return;
+	for (FluxPluginId id = 1; id < reg->count; id++) reg->slots [id].stats = (FluxPluginStats) {0};
+}
@@ -0,0 +1,438 @@
+#include "flux_grapheme.h"
+
+#include <stddef.h>
+
+#define GB(cp, prop) ((( uint32_t ) (cp) << 4) | FLUX_GB_##prop)
+
+#define GB_HANGUL_FIRST 0xac00u
+#define GB_HANGUL_LAST  0xd7a3u
+#define GB_HANGUL_T     28u
+
+/* Code points scanned backwards for the GB11-GB13 context, so a lookup
+ * never rescans a whole run: a longer Extend or Regional_Indicator run is
+ * judged from its last GB_LOOKBACK code points. flux_grapheme_next carries
+ * the context forward from a boundary instead and is exact. */
+#define GB_LOOKBACK 64u
+
+/* Property runs above ASCII: each entry starts a run that lasts until the next
+ * one. Derived from GraphemeBreakProperty.txt and the Extended_Pictographic
+ * column of emoji-data.txt (Unicode 15.0); the precomposed Hangul block is
+ * left as Other here and classified in flux_grapheme_property. */
+static uint32_t const gb_runs [] = {
+	GB(0x00080, CONTROL), GB(0x000A0, OTHER), GB(0x000A9, EXT_PICT), GB(0x000AA, OTHER), GB(0x000AD, CONTROL),
+	GB(0x000AE, EXT_PICT), GB(0x000AF, OTHER), GB(0x00300, EXTEND), GB(0x00370, OTHER), GB(0x00483, EXTEND),
+	GB(0x0048A, OTHER), GB(0x00591, EXTEND), GB(0x005BE, OTHER), GB(0x005BF, EXTEND), GB(0x005C0, OTHER),
+	GB(0x005C1, EXTEND), GB(0x005C3, OTHER), GB(0x005C4, EXTEND), GB(0x005C6, OTHER), GB(0x005C7, EXTEND),
+	GB(0x005C8, OTHER), GB(0x00600, PREPEND), GB(0x00606, OTHER), GB(0x00610, EXTEND), GB(0x0061B, OTHER),
+	GB(0x0061C, CONTROL), GB(0x0061D, OTHER), GB(0x0064B, EXTEND), GB(0x00660, OTHER), GB(0x00670, EXTEND),
+	GB(0x00671, OTHER), GB(0x006D6, EXTEND), GB(0x006DD, PREPEND), GB(0x006DE, OTHER), GB(0x006DF, EXTEND),
+	GB(0x006E5, OTHER), GB(0x006E7, EXTEND), GB(0x006E9, OTHER), GB(0x006EA, EXTEND), GB(0x006EE, OTHER),
+	GB(0x0070F, PREPEND), GB(0x00710, OTHER), GB(0x00711, EXTEND), GB(0x00712, OTHER), GB(0x00730, EXTEND),
+	GB(0x0074B, OTHER), GB(0x007A6, EXTEND), GB(0x007B1, OTHER), GB(0x007EB, EXTEND), GB(0x007F4, OTHER),
+	GB(0x007FD, EXTEND), GB(0x007FE, OTHER), GB(0x00816, EXTEND), GB(0x0081A, OTHER), GB(0x0081B, EXTEND),
+	GB(0x00824, OTHER), GB(0x00825, EXTEND), GB(0x00828, OTHER), GB(0x00829, EXTEND), GB(0x0082E, OTHER),
+	GB(0x00859, EXTEND), GB(0x0085C, OTHER), GB(0x00890, PREPEND), GB(0x00892, OTHER), GB(0x00898, EXTEND),
+	GB(0x008A0, OTHER), GB(0x008CA, EXTEND), GB(0x008E2, PREPEND), GB(0x008E3, EXTEND), GB(0x00903, SPACING_MARK),
+	GB(0x00904, OTHER), GB(0x0093A, EXTEND), GB(0x0093B, SPACING_MARK), GB(0x0093C, EXTEND), GB(0x0093D, OTHER),
+	GB(0x0093E, SPACING_MARK), GB(0x00941, EXTEND), GB(0x00949, SPACING_MARK), GB(0x0094D, EXTEND),
+	GB(0x0094E, SPACING_MARK), GB(0x00950, OTHER), GB(0x00951, EXTEND), GB(0x00958, OTHER), GB(0x00962, EXTEND),
+	GB(0x00964, OTHER), GB(0x00981, EXTEND), GB(0x00982, SPACING_MARK), GB(0x00984, OTHER), GB(0x009BC, EXTEND),
+	GB(0x009BD, OTHER), GB(0x009BE, EXTEND), GB(0x009BF, SPACING_MARK), GB(0x009C1, EXTEND), GB(0x009C5, OTHER),
+	GB(0x009C7, SPACING_MARK), GB(0x009C9, OTHER), GB(0x009CB, SPACING_MARK), GB(0x009CD, EXTEND), GB(0x009CE, OTHER),
+	GB(0x009D7, EXTEND), GB(0x009D8, OTHER), GB(0x009E2, EXTEND), GB(0x009E4, OTHER), GB(0x009FE, EXTEND),
+	GB(0x009FF, OTHER), GB(0x00A01, EXTEND), GB(0x00A03, SPACING_MARK), GB(0x00A04, OTHER), GB(0x00A3C, EXTEND),
+	GB(0x00A3D, OTHER), GB(0x00A3E, SPACING_MARK), GB(0x00A41, EXTEND), GB(0x00A43, OTHER), GB(0x00A47, EXTEND),
+	GB(0x00A49, OTHER), GB(0x00A4B, EXTEND), GB(0x00A4E, OTHER), GB(0x00A51, EXTEND), GB(0x00A52, OTHER),
+	GB(0x00A70, EXTEND), GB(0x00A72, OTHER), GB(0x00A75, EXTEND), GB(0x00A76, OTHER), GB(0x00A81, EXTEND),
+	GB(0x00A83, SPACING_MARK), GB(0x00A84, OTHER), GB(0x00ABC, EXTEND), GB(0x00ABD, OTHER), GB(0x00ABE, SPACING_MARK),
+	GB(0x00AC1, EXTEND), GB(0x00AC6, OTHER), GB(0x00AC7, EXTEND), GB(0x00AC9, SPACING_MARK), GB(0x00ACA, OTHER),
+	GB(0x00ACB, SPACING_MARK), GB(0x00ACD, EXTEND), GB(0x00ACE, OTHER), GB(0x00AE2, EXTEND), GB(0x00AE4, OTHER),
+	GB(0x00AFA, EXTEND), GB(0x00B00, OTHER), GB(0x00B01, EXTEND), GB(0x00B02, SPACING_MARK), GB(0x00B04, OTHER),
+	GB(0x00B3C, EXTEND), GB(0x00B3D, OTHER), GB(0x00B3E, EXTEND), GB(0x00B40, SPACING_MARK), GB(0x00B41, EXTEND),
+	GB(0x00B45, OTHER), GB(0x00B47, SPACING_MARK), GB(0x00B49, OTHER), GB(0x00B4B, SPACING_MARK), GB(0x00B4D, EXTEND),
+	GB(0x00B4E, OTHER), GB(0x00B55, EXTEND), GB(0x00B58, OTHER), GB(0x00B62, EXTEND), GB(0x00B64, OTHER),
+	GB(0x00B82, EXTEND), GB(0x00B83, OTHER), GB(0x00BBE, EXTEND), GB(0x00BBF, SPACING_MARK), GB(0x00BC0, EXTEND),
+	GB(0x00BC1, SPACING_MARK), GB(0x00BC3, OTHER), GB(0x00BC6, SPACING_MARK), GB(0x00BC9, OTHER),
+	GB(0x00BCA, SPACING_MARK), GB(0x00BCD, EXTEND), GB(0x00BCE, OTHER), GB(0x00BD7, EXTEND), GB(0x00BD8, OTHER),
+	GB(0x00C00, EXTEND), GB(0x00C01, SPACING_MARK), GB(0x00C04, EXTEND), GB(0x00C05, OTHER), GB(0x00C3C, EXTEND),
+	GB(0x00C3D, OTHER), GB(0x00C3E, EXTEND), GB(0x00C41, SPACING_MARK), GB(0x00C45, OTHER), GB(0x00C46, EXTEND),
+	GB(0x00C49, OTHER), GB(0x00C4A, EXTEND), GB(0x00C4E, OTHER), GB(0x00C55, EXTEND), GB(0x00C57, OTHER),
+	GB(0x00C62, EXTEND), GB(0x00C64, OTHER), GB(0x00C81, EXTEND), GB(0x00C82, SPACING_MARK), GB(0x00C84, OTHER),
+	GB(0x00CBC, EXTEND), GB(0x00CBD, OTHER), GB(0x00CBE, SPACING_MARK), GB(0x00CBF, EXTEND), GB(0x00CC0, SPACING_MARK),
+	GB(0x00CC2, EXTEND), GB(0x00CC3, SPACING_MARK), GB(0x00CC5, OTHER), GB(0x00CC6, EXTEND), GB(0x00CC7, SPACING_MARK),
+	GB(0x00CC9, OTHER), GB(0x00CCA, SPACING_MARK), GB(0x00CCC, EXTEND), GB(0x00CCE, OTHER), GB(0x00CD5, EXTEND),
+	GB(0x00CD7, OTHER), GB(0x00CE2, EXTEND), GB(0x00CE4, OTHER), GB(0x00CF3, SPACING_MARK), GB(0x00CF4, OTHER),
+	GB(0x00D00, EXTEND), GB(0x00D02, SPACING_MARK), GB(0x00D04, OTHER), GB(0x00D3B, EXTEND), GB(0x00D3D, OTHER),
+	GB(0x00D3E, EXTEND), GB(0x00D3F, SPACING_MARK), GB(0x00D41, EXTEND), GB(0x00D45, OTHER), GB(0x00D46, SPACING_MARK),
+	GB(0x00D49, OTHER), GB(0x00D4A, SPACING_MARK), GB(0x00D4D, EXTEND), GB(0x00D4E, PREPEND), GB(0x00D4F, OTHER),
+	GB(0x00D57, EXTEND), GB(0x00D58, OTHER), GB(0x00D62, EXTEND), GB(0x00D64, OTHER), GB(0x00D81, EXTEND),
+	GB(0x00D82, SPACING_MARK), GB(0x00D84, OTHER), GB(0x00DCA, EXTEND), GB(0x00DCB, OTHER), GB(0x00DCF, EXTEND),
+	GB(0x00DD0, SPACING_MARK), GB(0x00DD2, EXTEND), GB(0x00DD5, OTHER), GB(0x00DD6, EXTEND), GB(0x00DD7, OTHER),
+	GB(0x00DD8, SPACING_MARK), GB(0x00DDF, EXTEND), GB(0x00DE0, OTHER), GB(0x00DF2, SPACING_MARK), GB(0x00DF4, OTHER),
+	GB(0x00E31, EXTEND), GB(0x00E32, OTHER), GB(0x00E33, SPACING_MARK), GB(0x00E34, EXTEND), GB(0x00E3B, OTHER),
+	GB(0x00E47, EXTEND), GB(0x00E4F, OTHER), GB(0x00EB1, EXTEND), GB(0x00EB2, OTHER), GB(0x00EB3, SPACING_MARK),
+	GB(0x00EB4, EXTEND), GB(0x00EBD, OTHER), GB(0x00EC8, EXTEND), GB(0x00ECF, OTHER), GB(0x00F18, EXTEND),
+	GB(0x00F1A, OTHER), GB(0x00F35, EXTEND), GB(0x00F36, OTHER), GB(0x00F37, EXTEND), GB(0x00F38, OTHER),
+	GB(0x00F39, EXTEND), GB(0x00F3A, OTHER), GB(0x00F3E, SPACING_MARK), GB(0x00F40, OTHER), GB(0x00F71, EXTEND),
+	GB(0x00F7F, SPACING_MARK), GB(0x00F80, EXTEND), GB(0x00F85, OTHER), GB(0x00F86, EXTEND), GB(0x00F88, OTHER),
+	GB(0x00F8D, EXTEND), GB(0x00F98, OTHER), GB(0x00F99, EXTEND), GB(0x00FBD, OTHER), GB(0x00FC6, EXTEND),
+	GB(0x00FC7, OTHER), GB(0x0102D, EXTEND), GB(0x01031, SPACING_MARK), GB(0x01032, EXTEND), GB(0x01038, OTHER),
+	GB(0x01039, EXTEND), GB(0x0103B, SPACING_MARK), GB(0x0103D, EXTEND), GB(0x0103F, OTHER), GB(0x01056, SPACING_MARK),
+	GB(0x01058, EXTEND), GB(0x0105A, OTHER), GB(0x0105E, EXTEND), GB(0x01061, OTHER), GB(0x01071, EXTEND),
+	GB(0x01075, OTHER), GB(0x01082, EXTEND), GB(0x01083, OTHER), GB(0x01084, SPACING_MARK), GB(0x01085, EXTEND),
+	GB(0x01087, OTHER), GB(0x0108D, EXTEND), GB(0x0108E, OTHER), GB(0x0109D, EXTEND), GB(0x0109E, OTHER),
+	GB(0x01100, L), GB(0x01160, V), GB(0x011A8, T), GB(0x01200, OTHER), GB(0x0135D, EXTEND), GB(0x01360, OTHER),
+	GB(0x01712, EXTEND), GB(0x01715, SPACING_MARK), GB(0x01716, OTHER), GB(0x01732, EXTEND), GB(0x01734, SPACING_MARK),
+	GB(0x01735, OTHER), GB(0x01752, EXTEND), GB(0x01754, OTHER), GB(0x01772, EXTEND), GB(0x01774, OTHER),
+	GB(0x017B4, EXTEND), GB(0x017B6, SPACING_MARK), GB(0x017B7, EXTEND), GB(0x017BE, SPACING_MARK), GB(0x017C6, EXTEND),
+	GB(0x017C7, SPACING_MARK), GB(0x017C9, EXTEND), GB(0x017D4, OTHER), GB(0x017DD, EXTEND), GB(0x017DE, OTHER),
+	GB(0x0180B, EXTEND), GB(0x0180E, CONTROL), GB(0x0180F, EXTEND), GB(0x01810, OTHER), GB(0x01885, EXTEND),
+	GB(0x01887, OTHER), GB(0x018A9, EXTEND), GB(0x018AA, OTHER), GB(0x01920, EXTEND), GB(0x01923, SPACING_MARK),
+	GB(0x01927, EXTEND), GB(0x01929, SPACING_MARK), GB(0x0192C, OTHER), GB(0x01930, SPACING_MARK), GB(0x01932, EXTEND),
+	GB(0x01933, SPACING_MARK), GB(0x01939, EXTEND), GB(0x0193C, OTHER), GB(0x01A17, EXTEND), GB(0x01A19, SPACING_MARK),
+	GB(0x01A1B, EXTEND), GB(0x01A1C, OTHER), GB(0x01A55, SPACING_MARK), GB(0x01A56, EXTEND), GB(0x01A57, SPACING_MARK),
+	GB(0x01A58, EXTEND), GB(0x01A5F, OTHER), GB(0x01A60, EXTEND), GB(0x01A61, OTHER), GB(0x01A62, EXTEND),
+	GB(0x01A63, OTHER), GB(0x01A65, EXTEND), GB(0x01A6D, SPACING_MARK), GB(0x01A73, EXTEND), GB(0x01A7D, OTHER),
+	GB(0x01A7F, EXTEND), GB(0x01A80, OTHER), GB(0x01AB0, EXTEND), GB(0x01ACF, OTHER), GB(0x01B00, EXTEND),
+	GB(0x01B04, SPACING_MARK), GB(0x01B05, OTHER), GB(0x01B34, EXTEND), GB(0x01B3B, SPACING_MARK), GB(0x01B3C, EXTEND),
+	GB(0x01B3D, SPACING_MARK), GB(0x01B42, EXTEND), GB(0x01B43, SPACING_MARK), GB(0x01B45, OTHER), GB(0x01B6B, EXTEND),
+	GB(0x01B74, OTHER), GB(0x01B80, EXTEND), GB(0x01B82, SPACING_MARK), GB(0x01B83, OTHER), GB(0x01BA1, SPACING_MARK),
+	GB(0x01BA2, EXTEND), GB(0x01BA6, SPACING_MARK), GB(0x01BA8, EXTEND), GB(0x01BAA, SPACING_MARK), GB(0x01BAB, EXTEND),
+	GB(0x01BAE, OTHER), GB(0x01BE6, EXTEND), GB(0x01BE7, SPACING_MARK), GB(0x01BE8, EXTEND), GB(0x01BEA, SPACING_MARK),
+	GB(0x01BED, EXTEND), GB(0x01BEE, SPACING_MARK), GB(0x01BEF, EXTEND), GB(0x01BF2, SPACING_MARK), GB(0x01BF4, OTHER),
+	GB(0x01C24, SPACING_MARK), GB(0x01C2C, EXTEND), GB(0x01C34, SPACING_MARK), GB(0x01C36, EXTEND), GB(0x01C38, OTHER),
+	GB(0x01CD0, EXTEND), GB(0x01CD3, OTHER), GB(0x01CD4, EXTEND), GB(0x01CE1, SPACING_MARK), GB(0x01CE2, EXTEND),
+	GB(0x01CE9, OTHER), GB(0x01CED, EXTEND), GB(0x01CEE, OTHER), GB(0x01CF4, EXTEND), GB(0x01CF5, OTHER),
+	GB(0x01CF7, SPACING_MARK), GB(0x01CF8, EXTEND), GB(0x01CFA, OTHER), GB(0x01DC0, EXTEND), GB(0x01E00, OTHER),
+	GB(0x0200B, CONTROL), GB(0x0200C, EXTEND), GB(0x0200D, ZWJ), GB(0x0200E, CONTROL), GB(0x02010, OTHER),
+	GB(0x02028, CONTROL), GB(0x0202F, OTHER), GB(0x0203C, EXT_PICT), GB(0x0203D, OTHER), GB(0x02049, EXT_PICT),
+	GB(0x0204A, OTHER), GB(0x02060, CONTROL), GB(0x02070, OTHER), GB(0x020D0, EXTEND), GB(0x020F1, OTHER),
+	GB(0x02122, EXT_PICT), GB(0x02123, OTHER), GB(0x02139, EXT_PICT), GB(0x0213A, OTHER), GB(0x02194, EXT_PICT),
+	GB(0x0219A, OTHER), GB(0x021A9, EXT_PICT), GB(0x021AB, OTHER), GB(0x0231A, EXT_PICT), GB(0x0231C, OTHER),
+	GB(0x02328, EXT_PICT), GB(0x02329, OTHER), GB(0x02388, EXT_PICT), GB(0x02389, OTHER), GB(0x023CF, EXT_PICT),
+	GB(0x023D0, OTHER), GB(0x023E9, EXT_PICT), GB(0x023F4, OTHER), GB(0x023F8, EXT_PICT), GB(0x023FB, OTHER),
+	GB(0x024C2, EXT_PICT), GB(0x024C3, OTHER), GB(0x025AA, EXT_PICT), GB(0x025AC, OTHER), GB(0x025B6, EXT_PICT),
+	GB(0x025B7, OTHER), GB(0x025C0, EXT_PICT), GB(0x025C1, OTHER), GB(0x025FB, EXT_PICT), GB(0x025FF, OTHER),
+	GB(0x02600, EXT_PICT), GB(0x02606, OTHER), GB(0x02607, EXT_PICT), GB(0x02613, OTHER), GB(0x02614, EXT_PICT),
+	GB(0x02686, OTHER), GB(0x02690, EXT_PICT), GB(0x02706, OTHER), GB(0x02708, EXT_PICT), GB(0x02713, OTHER),
+	GB(0x02714, EXT_PICT), GB(0x02715, OTHER), GB(0x02716, EXT_PICT), GB(0x02717, OTHER), GB(0x0271D, EXT_PICT),
+	GB(0x0271E, OTHER), GB(0x02721, EXT_PICT), GB(0x02722, OTHER), GB(0x02728, EXT_PICT), GB(0x02729, OTHER),
+	GB(0x02733, EXT_PICT), GB(0x02735, OTHER), GB(0x02744, EXT_PICT), GB(0x02745, OTHER), GB(0x02747, EXT_PICT),
+	GB(0x02748, OTHER), GB(0x0274C, EXT_PICT), GB(0x0274D, OTHER), GB(0x0274E, EXT_PICT), GB(0x0274F, OTHER),
+	GB(0x02753, EXT_PICT), GB(0x02756, OTHER), GB(0x02757, EXT_PICT), GB(0x02758, OTHER), GB(0x02763, EXT_PICT),
+	GB(0x02768, OTHER), GB(0x02795, EXT_PICT), GB(0x02798, OTHER), GB(0x027A1, EXT_PICT), GB(0x027A2, OTHER),
+	GB(0x027B0, EXT_PICT), GB(0x027B1, OTHER), GB(0x027BF, EXT_PICT), GB(0x027C0, OTHER), GB(0x02934, EXT_PICT),
+	GB(0x02936, OTHER), GB(0x02B05, EXT_PICT), GB(0x02B08, OTHER), GB(0x02B1B, EXT_PICT), GB(0x02B1D, OTHER),
+	GB(0x02B50, EXT_PICT), GB(0x02B51, OTHER), GB(0x02B55, EXT_PICT), GB(0x02B56, OTHER), GB(0x02CEF, EXTEND),
+	GB(0x02CF2, OTHER), GB(0x02D7F, EXTEND), GB(0x02D80, OTHER), GB(0x02DE0, EXTEND), GB(0x02E00, OTHER),
+	GB(0x0302A, EXTEND), GB(0x03030, EXT_PICT), GB(0x03031, OTHER), GB(0x0303D, EXT_PICT), GB(0x0303E, OTHER),
+	GB(0x03099, EXTEND), GB(0x0309B, OTHER), GB(0x03297, EXT_PICT), GB(0x03298, OTHER), GB(0x03299, EXT_PICT),
+	GB(0x0329A, OTHER), GB(0x0A66F, EXTEND), GB(0x0A673, OTHER), GB(0x0A674, EXTEND), GB(0x0A67E, OTHER),
+	GB(0x0A69E, EXTEND), GB(0x0A6A0, OTHER), GB(0x0A6F0, EXTEND), GB(0x0A6F2, OTHER), GB(0x0A802, EXTEND),
+	GB(0x0A803, OTHER), GB(0x0A806, EXTEND), GB(0x0A807, OTHER), GB(0x0A80B, EXTEND), GB(0x0A80C, OTHER),
+	GB(0x0A823, SPACING_MARK), GB(0x0A825, EXTEND), GB(0x0A827, SPACING_MARK), GB(0x0A828, OTHER), GB(0x0A82C, EXTEND),
+	GB(0x0A82D, OTHER), GB(0x0A880, SPACING_MARK), GB(0x0A882, OTHER), GB(0x0A8B4, SPACING_MARK), GB(0x0A8C4, EXTEND),
+	GB(0x0A8C6, OTHER), GB(0x0A8E0, EXTEND), GB(0x0A8F2, OTHER), GB(0x0A8FF, EXTEND), GB(0x0A900, OTHER),
+	GB(0x0A926, EXTEND), GB(0x0A92E, OTHER), GB(0x0A947, EXTEND), GB(0x0A952, SPACING_MARK), GB(0x0A954, OTHER),
+	GB(0x0A960, L), GB(0x0A97D, OTHER), GB(0x0A980, EXTEND), GB(0x0A983, SPACING_MARK), GB(0x0A984, OTHER),
+	GB(0x0A9B3, EXTEND), GB(0x0A9B4, SPACING_MARK), GB(0x0A9B6, EXTEND), GB(0x0A9BA, SPACING_MARK), GB(0x0A9BC, EXTEND),
+	GB(0x0A9BE, SPACING_MARK), GB(0x0A9C1, OTHER), GB(0x0A9E5, EXTEND), GB(0x0A9E6, OTHER), GB(0x0AA29, EXTEND),
+	GB(0x0AA2F, SPACING_MARK), GB(0x0AA31, EXTEND), GB(0x0AA33, SPACING_MARK), GB(0x0AA35, EXTEND), GB(0x0AA37, OTHER),
+	GB(0x0AA43, EXTEND), GB(0x0AA44, OTHER), GB(0x0AA4C, EXTEND), GB(0x0AA4D, SPACING_MARK), GB(0x0AA4E, OTHER),
+	GB(0x0AA7C, EXTEND), GB(0x0AA7D, OTHER), GB(0x0AAB0, EXTEND), GB(0x0AAB1, OTHER), GB(0x0AAB2, EXTEND),
+	GB(0x0AAB5, OTHER), GB(0x0AAB7, EXTEND), GB(0x0AAB9, OTHER), GB(0x0AABE, EXTEND), GB(0x0AAC0, OTHER),
+	GB(0x0AAC1, EXTEND), GB(0x0AAC2, OTHER), GB(0x0AAEB, SPACING_MARK), GB(0x0AAEC, EXTEND), GB(0x0AAEE, SPACING_MARK),
+	GB(0x0AAF0, OTHER), GB(0x0AAF5, SPACING_MARK), GB(0x0AAF6, EXTEND), GB(0x0AAF7, OTHER), GB(0x0ABE3, SPACING_MARK),
+	GB(0x0ABE5, EXTEND), GB(0x0ABE6, SPACING_MARK), GB(0x0ABE8, EXTEND), GB(0x0ABE9, SPACING_MARK), GB(0x0ABEB, OTHER),
+	GB(0x0ABEC, SPACING_MARK), GB(0x0ABED, EXTEND), GB(0x0ABEE, OTHER), GB(0x0D7B0, V), GB(0x0D7C7, OTHER),
+	GB(0x0D7CB, T), GB(0x0D7FC, OTHER), GB(0x0FB1E, EXTEND), GB(0x0FB1F, OTHER), GB(0x0FE00, EXTEND),
+	GB(0x0FE10, OTHER), GB(0x0FE20, EXTEND), GB(0x0FE30, OTHER), GB(0x0FEFF, CONTROL), GB(0x0FF00, OTHER),
+	GB(0x0FF9E, EXTEND), GB(0x0FFA0, OTHER), GB(0x0FFF0, CONTROL), GB(0x0FFFC, OTHER), GB(0x101FD, EXTEND),
+	GB(0x101FE, OTHER), GB(0x102E0, EXTEND), GB(0x102E1, OTHER), GB(0x10376, EXTEND), GB(0x1037B, OTHER),
+	GB(0x10A01, EXTEND), GB(0x10A04, OTHER), GB(0x10A05, EXTEND), GB(0x10A07, OTHER), GB(0x10A0C, EXTEND),
+	GB(0x10A10, OTHER), GB(0x10A38, EXTEND), GB(0x10A3B, OTHER), GB(0x10A3F, EXTEND), GB(0x10A40, OTHER),
+	GB(0x10AE5, EXTEND), GB(0x10AE7, OTHER), GB(0x10D24, EXTEND), GB(0x10D28, OTHER), GB(0x10EAB, EXTEND),
+	GB(0x10EAD, OTHER), GB(0x10EFD, EXTEND), GB(0x10F00, OTHER), GB(0x10F46, EXTEND), GB(0x10F51, OTHER),
+	GB(0x10F82, EXTEND), GB(0x10F86, OTHER), GB(0x11000, SPACING_MARK), GB(0x11001, EXTEND), GB(0x11002, SPACING_MARK),
+	GB(0x11003, OTHER), GB(0x11038, EXTEND), GB(0x11047, OTHER), GB(0x11070, EXTEND), GB(0x11071, OTHER),
+	GB(0x11073, EXTEND), GB(0x11075, OTHER), GB(0x1107F, EXTEND), GB(0x11082, SPACING_MARK), GB(0x11083, OTHER),
+	GB(0x110B0, SPACING_MARK), GB(0x110B3, EXTEND), GB(0x110B7, SPACING_MARK), GB(0x110B9, EXTEND), GB(0x110BB, OTHER),
+	GB(0x110BD, PREPEND), GB(0x110BE, OTHER), GB(0x110C2, EXTEND), GB(0x110C3, OTHER), GB(0x110CD, PREPEND),
+	GB(0x110CE, OTHER), GB(0x11100, EXTEND), GB(0x11103, OTHER), GB(0x11127, EXTEND), GB(0x1112C, SPACING_MARK),
+	GB(0x1112D, EXTEND), GB(0x11135, OTHER), GB(0x11145, SPACING_MARK), GB(0x11147, OTHER), GB(0x11173, EXTEND),
+	GB(0x11174, OTHER), GB(0x11180, EXTEND), GB(0x11182, SPACING_MARK), GB(0x11183, OTHER), GB(0x111B3, SPACING_MARK),
+	GB(0x111B6, EXTEND), GB(0x111BF, SPACING_MARK), GB(0x111C1, OTHER), GB(0x111C2, PREPEND), GB(0x111C4, OTHER),
+	GB(0x111C9, EXTEND), GB(0x111CD, OTHER), GB(0x111CE, SPACING_MARK), GB(0x111CF, EXTEND), GB(0x111D0, OTHER),
+	GB(0x1122C, SPACING_MARK), GB(0x1122F, EXTEND), GB(0x11232, SPACING_MARK), GB(0x11234, EXTEND),
+	GB(0x11235, SPACING_MARK), GB(0x11236, EXTEND), GB(0x11238, OTHER), GB(0x1123E, EXTEND), GB(0x1123F, OTHER),
+	GB(0x11241, EXTEND), GB(0x11242, OTHER), GB(0x112DF, EXTEND), GB(0x112E0, SPACING_MARK), GB(0x112E3, EXTEND),
+	GB(0x112EB, OTHER), GB(0x11300, EXTEND), GB(0x11302, SPACING_MARK), GB(0x11304, OTHER), GB(0x1133B, EXTEND),
+	GB(0x1133D, OTHER), GB(0x1133E, EXTEND), GB(0x1133F, SPACING_MARK), GB(0x11340, EXTEND), GB(0x11341, SPACING_MARK),
+	GB(0x11345, OTHER), GB(0x11347, SPACING_MARK), GB(0x11349, OTHER), GB(0x1134B, SPACING_MARK), GB(0x1134E, OTHER),
+	GB(0x11357, EXTEND), GB(0x11358, OTHER), GB(0x11362, SPACING_MARK), GB(0x11364, OTHER), GB(0x11366, EXTEND),
+	GB(0x1136D, OTHER), GB(0x11370, EXTEND), GB(0x11375, OTHER), GB(0x11435, SPACING_MARK), GB(0x11438, EXTEND),
+	GB(0x11440, SPACING_MARK), GB(0x11442, EXTEND), GB(0x11445, SPACING_MARK), GB(0x11446, EXTEND), GB(0x11447, OTHER),
+	GB(0x1145E, EXTEND), GB(0x1145F, OTHER), GB(0x114B0, EXTEND), GB(0x114B1, SPACING_MARK), GB(0x114B3, EXTEND),
+	GB(0x114B9, SPACING_MARK), GB(0x114BA, EXTEND), GB(0x114BB, SPACING_MARK), GB(0x114BD, EXTEND),
+	GB(0x114BE, SPACING_MARK), GB(0x114BF, EXTEND), GB(0x114C1, SPACING_MARK), GB(0x114C2, EXTEND), GB(0x114C4, OTHER),
+	GB(0x115AF, EXTEND), GB(0x115B0, SPACING_MARK), GB(0x115B2, EXTEND), GB(0x115B6, OTHER), GB(0x115B8, SPACING_MARK),
+	GB(0x115BC, EXTEND), GB(0x115BE, SPACING_MARK), GB(0x115BF, EXTEND), GB(0x115C1, OTHER), GB(0x115DC, EXTEND),
+	GB(0x115DE, OTHER), GB(0x11630, SPACING_MARK), GB(0x11633, EXTEND), GB(0x1163B, SPACING_MARK), GB(0x1163D, EXTEND),
+	GB(0x1163E, SPACING_MARK), GB(0x1163F, EXTEND), GB(0x11641, OTHER), GB(0x116AB, EXTEND), GB(0x116AC, SPACING_MARK),
+	GB(0x116AD, EXTEND), GB(0x116AE, SPACING_MARK), GB(0x116B0, EXTEND), GB(0x116B6, SPACING_MARK), GB(0x116B7, EXTEND),
+	GB(0x116B8, OTHER), GB(0x1171D, EXTEND), GB(0x11720, OTHER), GB(0x11722, EXTEND), GB(0x11726, SPACING_MARK),
+	GB(0x11727, EXTEND), GB(0x1172C, OTHER), GB(0x1182C, SPACING_MARK), GB(0x1182F, EXTEND), GB(0x11838, SPACING_MARK),
+	GB(0x11839, EXTEND), GB(0x1183B, OTHER), GB(0x11930, EXTEND), GB(0x11931, SPACING_MARK), GB(0x11936, OTHER),
+	GB(0x11937, SPACING_MARK), GB(0x11939, OTHER), GB(0x1193B, EXTEND), GB(0x1193D, SPACING_MARK), GB(0x1193E, EXTEND),
+	GB(0x1193F, PREPEND), GB(0x11940, SPACING_MARK), GB(0x11941, PREPEND), GB(0x11942, SPACING_MARK),
+	GB(0x11943, EXTEND), GB(0x11944, OTHER), GB(0x119D1, SPACING_MARK), GB(0x119D4, EXTEND), GB(0x119D8, OTHER),
+	GB(0x119DA, EXTEND), GB(0x119DC, SPACING_MARK), GB(0x119E0, EXTEND), GB(0x119E1, OTHER), GB(0x119E4, SPACING_MARK),
+	GB(0x119E5, OTHER), GB(0x11A01, EXTEND), GB(0x11A0B, OTHER), GB(0x11A33, EXTEND), GB(0x11A39, SPACING_MARK),
+	GB(0x11A3A, PREPEND), GB(0x11A3B, EXTEND), GB(0x11A3F, OTHER), GB(0x11A47, EXTEND), GB(0x11A48, OTHER),
+	GB(0x11A51, EXTEND), GB(0x11A57, SPACING_MARK), GB(0x11A59, EXTEND), GB(0x11A5C, OTHER), GB(0x11A84, PREPEND),
+	GB(0x11A8A, EXTEND), GB(0x11A97, SPACING_MARK), GB(0x11A98, EXTEND), GB(0x11A9A, OTHER), GB(0x11C2F, SPACING_MARK),
+	GB(0x11C30, EXTEND), GB(0x11C37, OTHER), GB(0x11C38, EXTEND), GB(0x11C3E, SPACING_MARK), GB(0x11C3F, EXTEND),
+	GB(0x11C40, OTHER), GB(0x11C92, EXTEND), GB(0x11CA8, OTHER), GB(0x11CA9, SPACING_MARK), GB(0x11CAA, EXTEND),
+	GB(0x11CB1, SPACING_MARK), GB(0x11CB2, EXTEND), GB(0x11CB4, SPACING_MARK), GB(0x11CB5, EXTEND), GB(0x11CB7, OTHER),
+	GB(0x11D31, EXTEND), GB(0x11D37, OTHER), GB(0x11D3A, EXTEND), GB(0x11D3B, OTHER), GB(0x11D3C, EXTEND),
+	GB(0x11D3E, OTHER), GB(0x11D3F, EXTEND), GB(0x11D46, PREPEND), GB(0x11D47, EXTEND), GB(0x11D48, OTHER),
+	GB(0x11D8A, SPACING_MARK), GB(0x11D8F, OTHER), GB(0x11D90, EXTEND), GB(0x11D92, OTHER), GB(0x11D93, SPACING_MARK),
+	GB(0x11D95, EXTEND), GB(0x11D96, SPACING_MARK), GB(0x11D97, EXTEND), GB(0x11D98, OTHER), GB(0x11EF3, EXTEND),
+	GB(0x11EF5, SPACING_MARK), GB(0x11EF7, OTHER), GB(0x11F00, EXTEND), GB(0x11F02, PREPEND), GB(0x11F03, SPACING_MARK),
+	GB(0x11F04, OTHER), GB(0x11F34, SPACING_MARK), GB(0x11F36, EXTEND), GB(0x11F3B, OTHER), GB(0x11F3E, SPACING_MARK),
+	GB(0x11F40, EXTEND), GB(0x11F41, SPACING_MARK), GB(0x11F42, EXTEND), GB(0x11F43, OTHER), GB(0x13430, CONTROL),
+	GB(0x13440, EXTEND), GB(0x13441, OTHER), GB(0x13447, EXTEND), GB(0x13456, OTHER), GB(0x16AF0, EXTEND),
+	GB(0x16AF5, OTHER), GB(0x16B30, EXTEND), GB(0x16B37, OTHER), GB(0x16F4F, EXTEND), GB(0x16F50, OTHER),
+	GB(0x16F51, SPACING_MARK), GB(0x16F88, OTHER), GB(0x16F8F, EXTEND), GB(0x16F93, OTHER), GB(0x16FE4, EXTEND),
+	GB(0x16FE5, OTHER), GB(0x16FF0, SPACING_MARK), GB(0x16FF2, OTHER), GB(0x1BC9D, EXTEND), GB(0x1BC9F, OTHER),
+	GB(0x1BCA0, CONTROL), GB(0x1BCA4, OTHER), GB(0x1CF00, EXTEND), GB(0x1CF2E, OTHER), GB(0x1CF30, EXTEND),
+	GB(0x1CF47, OTHER), GB(0x1D165, EXTEND), GB(0x1D166, SPACING_MARK), GB(0x1D167, EXTEND), GB(0x1D16A, OTHER),
+	GB(0x1D16D, SPACING_MARK), GB(0x1D16E, EXTEND), GB(0x1D173, CONTROL), GB(0x1D17B, EXTEND), GB(0x1D183, OTHER),
+	GB(0x1D185, EXTEND), GB(0x1D18C, OTHER), GB(0x1D1AA, EXTEND), GB(0x1D1AE, OTHER), GB(0x1D242, EXTEND),
+	GB(0x1D245, OTHER), GB(0x1DA00, EXTEND), GB(0x1DA37, OTHER), GB(0x1DA3B, EXTEND), GB(0x1DA6D, OTHER),
+	GB(0x1DA75, EXTEND), GB(0x1DA76, OTHER), GB(0x1DA84, EXTEND), GB(0x1DA85, OTHER), GB(0x1DA9B, EXTEND),
+	GB(0x1DAA0, OTHER), GB(0x1DAA1, EXTEND), GB(0x1DAB0, OTHER), GB(0x1E000, EXTEND), GB(0x1E007, OTHER),
+	GB(0x1E008, EXTEND), GB(0x1E019, OTHER), GB(0x1E01B, EXTEND), GB(0x1E022, OTHER), GB(0x1E023, EXTEND),
+	GB(0x1E025, OTHER), GB(0x1E026, EXTEND), GB(0x1E02B, OTHER), GB(0x1E08F, EXTEND), GB(0x1E090, OTHER),
+	GB(0x1E130, EXTEND), GB(0x1E137, OTHER), GB(0x1E2AE, EXTEND), GB(0x1E2AF, OTHER), GB(0x1E2EC, EXTEND),
+	GB(0x1E2F0, OTHER), GB(0x1E4EC, EXTEND), GB(0x1E4F0, OTHER), GB(0x1E8D0, EXTEND), GB(0x1E8D7, OTHER),
+	GB(0x1E944, EXTEND), GB(0x1E94B, OTHER), GB(0x1F000, EXT_PICT), GB(0x1F100, OTHER), GB(0x1F10D, EXT_PICT),
+	GB(0x1F110, OTHER), GB(0x1F12F, EXT_PICT), GB(0x1F130, OTHER), GB(0x1F16C, EXT_PICT), GB(0x1F172, OTHER),
+	GB(0x1F17E, EXT_PICT), GB(0x1F180, OTHER), GB(0x1F18E, EXT_PICT), GB(0x1F18F, OTHER), GB(0x1F191, EXT_PICT),
+	GB(0x1F19B, OTHER), GB(0x1F1AD, EXT_PICT), GB(0x1F1E6, RI), GB(0x1F200, OTHER), GB(0x1F201, EXT_PICT),
+	GB(0x1F210, OTHER), GB(0x1F21A, EXT_PICT), GB(0x1F21B, OTHER), GB(0x1F22F, EXT_PICT), GB(0x1F230, OTHER),
+	GB(0x1F232, EXT_PICT), GB(0x1F23B, OTHER), GB(0x1F23C, EXT_PICT), GB(0x1F240, OTHER), GB(0x1F249, EXT_PICT),
+	GB(0x1F3FB, EXTEND), GB(0x1F400, EXT_PICT), GB(0x1F53E, OTHER), GB(0x1F546, EXT_PICT), GB(0x1F650, OTHER),
+	GB(0x1F680, EXT_PICT), GB(0x1F700, OTHER), GB(0x1F774, EXT_PICT), GB(0x1F780, OTHER), GB(0x1F7D5, EXT_PICT),
+	GB(0x1F800, OTHER), GB(0x1F80C, EXT_PICT), GB(0x1F810, OTHER), GB(0x1F848, EXT_PICT), GB(0x1F850, OTHER),
+	GB(0x1F85A, EXT_PICT), GB(0x1F860, OTHER), GB(0x1F888, EXT_PICT), GB(0x1F890, OTHER), GB(0x1F8AE, EXT_PICT),
+	GB(0x1F900, OTHER), GB(0x1F90C, EXT_PICT), GB(0x1F93B, OTHER), GB(0x1F93C, EXT_PICT), GB(0x1F946, OTHER),
+	GB(0x1F947, EXT_PICT), GB(0x1FB00, OTHER), GB(0x1FC00, EXT_PICT), GB(0x1FFFE, OTHER), GB(0xE0000, CONTROL),
+	GB(0xE0020, EXTEND), GB(0xE0080, CONTROL), GB(0xE0100, EXTEND), GB(0xE01F0, CONTROL), GB(0xE1000, OTHER),
+};
+
+typedef enum GbPair
+{
+	GB_BREAK,
+	GB_KEEP,
+	GB_CONTEXT, /* GB11 or GB12/GB13: depends on what precedes the pair */
+} GbPair;
+
+FluxGraphemeBreak flux_grapheme_property(uint32_t cp) {
+	if (cp < 0x80) {
+		if (cp == '\r') return FLUX_GB_CR;
+		if (cp == '\n') return FLUX_GB_LF;
+		return cp < 0x20 || cp == 0x7f ? FLUX_GB_CONTROL : FLUX_GB_OTHER;
+	}
+	if (cp >= GB_HANGUL_FIRST && cp <= GB_HANGUL_LAST)
+		return (cp - GB_HANGUL_FIRST) % GB_HANGUL_T ? FLUX_GB_LVT : FLUX_GB_LV;
+
+	/* Last run starting at or before cp. */
+	uint32_t key = (cp << 4) | 0xf;
+	size_t   lo  = 0;
+	size_t   hi  = sizeof(gb_runs) / sizeof(gb_runs [0]);
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (gb_runs [mid] <= key) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo ? ( FluxGraphemeBreak ) (gb_runs [lo - 1] & 0xf) : FLUX_GB_CONTROL;
+}
+
+static uint32_t gb_len(FluxGraphemeText const *t) { return t->head_len + t->tail_len; }
+
+static uint8_t  gb_byte(FluxGraphemeText const *t, uint32_t i) {
+	if (t->byte_at) return t->byte_at(t->source, i);
+	return ( uint8_t ) (i < t->head_len ? t->head [i] : t->tail [i - t->head_len]);
+}
+
+/* Code point at @p pos and its byte length (0 at the end). */
+static uint32_t gb_decode(FluxGraphemeText const *t, uint32_t pos, uint32_t *cp) {
+	uint32_t len = gb_len(t);
+	if (pos >= len) return 0;
+
+	uint8_t c0 = gb_byte(t, pos);
+	*cp        = c0;
+	if (c0 < 0x80) return 1;
+
+	uint32_t n = c0 >= 0xf0 ? 4 : c0 >= 0xe0 ? 3 : 2;
+	uint32_t v = c0 & (0x7f >> n);
+	*cp        = 0xfffd;
+	if (c0 < 0xc2 || c0 > 0xf4) return 1;
+	if (!n || pos + n > len) return 1;
+	for (uint32_t i = 1; i < n; i++) {
+		uint8_t cx = gb_byte(t, pos + i);
+		if ((cx & 0xc0) != 0x80) return 1;
+		v = (v << 6) | (cx & 0x3f);
+	}
+	if ((n == 3 && v < 0x800) || (n == 4 && (v < 0x10000 || v > 0x10ffff))) return 1;
+	if (v >= 0xd800 && v <= 0xdfff) return 1;
+	*cp = v;
+	return n;
+}
+
+/* Start of the code point ending at @p pos (> 0). A byte run that does not
+ * decode back to @p pos is an invalid tail, which decodes one byte at a time. */
+static uint32_t gb_prev_start(FluxGraphemeText const *t, uint32_t pos) {
+	uint32_t p = pos - 1;
+	while (p > 0 && pos - p < 4 && (gb_byte(t, p) & 0xc0) == 0x80) p--;
+	uint32_t cp;
+	return gb_decode(t, p, &cp) == pos - p ? p : pos - 1;
+}
+
+static FluxGraphemeBreak gb_property_at(FluxGraphemeText const *t, uint32_t pos, uint32_t *len) {
+	uint32_t cp = 0;
+	uint32_t n  = gb_decode(t, pos, &cp);
+	if (len) *len = n;
+	return flux_grapheme_property(cp);
+}
+
+static bool gb_is_control(FluxGraphemeBreak p) { return p == FLUX_GB_CR || p == FLUX_GB_LF || p == FLUX_GB_CONTROL; }
+
+static GbPair gb_pair(FluxGraphemeBreak l, FluxGraphemeBreak r) {
+	if (l == FLUX_GB_CR && r == FLUX_GB_LF) return GB_KEEP;                                   /* GB3 */
+	if (gb_is_control(l) || gb_is_control(r)) return GB_BREAK;                                /* GB4, GB5 */
+	if (l == FLUX_GB_L && (r == FLUX_GB_L || r == FLUX_GB_V || r == FLUX_GB_LV || r == FLUX_GB_LVT))
+		return GB_KEEP;                                                                       /* GB6 */
+	if ((l == FLUX_GB_LV || l == FLUX_GB_V) && (r == FLUX_GB_V || r == FLUX_GB_T)) return GB_KEEP; /* GB7 */
+	if ((l == FLUX_GB_LVT || l == FLUX_GB_T) && r == FLUX_GB_T) return GB_KEEP;               /* GB8 */
+	if (r == FLUX_GB_EXTEND || r == FLUX_GB_ZWJ || r == FLUX_GB_SPACING_MARK) return GB_KEEP; /* GB9, GB9a */
+	if (l == FLUX_GB_PREPEND) return GB_KEEP;                                                 /* GB9b */
+	if (l == FLUX_GB_ZWJ && r == FLUX_GB_EXT_PICT) return GB_CONTEXT;                         /* GB11 */
+	if (l == FLUX_GB_RI && r == FLUX_GB_RI) return GB_CONTEXT;                                /* GB12, GB13 */
+	return GB_BREAK;                                                                          /* GB999 */
+}
+
+/* GB11: the code point ending at @p pos follows ExtPict Extend*. */
+static bool gb_emoji_before(FluxGraphemeText const *t, uint32_t pos) {
+	uint32_t p = gb_prev_start(t, pos);
+	for (uint32_t n = 0; p > 0 && n < GB_LOOKBACK; n++) {
+		uint32_t          q = gb_prev_start(t, p);
+		FluxGraphemeBreak b = gb_property_at(t, q, NULL);
+		if (b == FLUX_GB_EXT_PICT) return true;
+		if (b != FLUX_GB_EXTEND) return false;
+		p = q;
+	}
+	return false;
+}
+
+/* GB12/GB13: Regional_Indicator code points in the run ending at @p pos. */
+static uint32_t gb_ri_run(FluxGraphemeText const *t, uint32_t pos) {
+	uint32_t n = 0;
+	while (pos > 0 && n < GB_LOOKBACK) {
+		uint32_t p = gb_prev_start(t, pos);
+		if (gb_property_at(t, p, NULL) != FLUX_GB_RI) break;
+		n++;
+		pos = p;
+	}
+	return n;
+}
+
+/* GB11-GB13 context of the code point left of a candidate boundary. */
+typedef struct GbContext {
+	uint32_t ri;    /**< Regional_Indicators in the run ending here. */
+	bool     pict;  /**< The run ending here is ExtPict Extend*. */
+	bool     emoji; /**< This is a ZWJ following ExtPict Extend*. */
+} GbContext;
+
+/* Context of the code point of property @p p that ends at @p end. */
+static GbContext gb_context_at(FluxGraphemeText const *t, uint32_t end, FluxGraphemeBreak p) {
+	bool after_pict = (p == FLUX_GB_EXTEND || p == FLUX_GB_ZWJ) && gb_emoji_before(t, end);
+	return (GbContext) {
+	  .ri    = p == FLUX_GB_RI ? gb_ri_run(t, end) : 0,
+	  .pict  = p == FLUX_GB_EXT_PICT || (p == FLUX_GB_EXTEND && after_pict),
+	  .emoji = p == FLUX_GB_ZWJ && after_pict,
+	};
+}
+
+/* Context after stepping onto a code point of property @p p. */
+static void gb_context_step(GbContext *c, FluxGraphemeBreak p) {
+	c->emoji = p == FLUX_GB_ZWJ && c->pict;
+	c->pict  = p == FLUX_GB_EXT_PICT || (p == FLUX_GB_EXTEND && c->pict);
+	c->ri    = p == FLUX_GB_RI ? c->ri + 1 : 0;
+}
+
+/* Boundary between code points of properties @p l and @p r, @p c being the
+ * context of @p l. */
+static bool gb_breaks(GbContext const *c, FluxGraphemeBreak l, FluxGraphemeBreak r) {
+	switch (gb_pair(l, r)) {
+	case GB_BREAK   : return true;
+	case GB_KEEP    : return false;
+	case GB_CONTEXT : break;
+	}
+	if (l == FLUX_GB_ZWJ) return !c->emoji;
+	return c->ri % 2 == 0;
+}
+
+/* Boundary at @p pos, looking back for the context only when a rule needs it. */
+static bool gb_breaks_at(FluxGraphemeText const *t, uint32_t pos, FluxGraphemeBreak l, FluxGraphemeBreak r) {
+	GbPair pair = gb_pair(l, r);
+	if (pair != GB_CONTEXT) return pair == GB_BREAK;
+	GbContext c = gb_context_at(t, pos, l);
+	return gb_breaks(&c, l, r);
+}
+
+bool flux_grapheme_is_boundary(FluxGraphemeText const *text, uint32_t pos) {
+	if (!text || pos == 0 || pos >= gb_len(text)) return true;
+	FluxGraphemeBreak l = gb_property_at(text, gb_prev_start(text, pos), NULL);
+	FluxGraphemeBreak r = gb_property_at(text, pos, NULL);
+	return gb_breaks_at(text, pos, l, r);
+}
+
+uint32_t flux_grapheme_next(FluxGraphemeText const *text, uint32_t pos) {
+	if (!text) return 0;
+	uint32_t end = gb_len(text);
+	if (pos >= end) return end;
+
+	uint32_t          len;
+	FluxGraphemeBreak l = gb_property_at(text, pos, &len);
+	GbContext         c = {0};
+	/* From a boundary nothing before @p pos joins the cluster, so the context
+	 * starts fresh; only a start inside a cluster looks back. */
+	if (flux_grapheme_is_boundary(text, pos)) gb_context_step(&c, l);
+	else c = gb_context_at(text, pos + len, l);
+	for (pos += len; pos < end; pos += len) {
+		FluxGraphemeBreak r = gb_property_at(text, pos, &len);
+		if (gb_breaks(&c, l, r)) return pos;
+		gb_context_step(&c, r);
+		l = r;
+	}
+	return end;
+}
+
+uint32_t flux_grapheme_prev(FluxGraphemeText const *text, uint32_t pos) {
+	if (!text || pos == 0) return 0;
+	uint32_t end = gb_len(text);
+	if (pos > end) pos = end;
+
+	uint32_t          q = gb_prev_start(text, pos);
+	FluxGraphemeBreak r = gb_property_at(text, q, NULL);
+	while (q > 0) {
+		uint32_t          p = gb_prev_start(text, q);
+		FluxGraphemeBreak l = gb_property_at(text, p, NULL);
+		if (gb_breaks_at(text, q, l, r)) return q;
+		r = l;
+		q = p;
+	}
+	return 0;
+}
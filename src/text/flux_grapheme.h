@@ -0,0 +1,78 @@
+/**
+ * @file flux_grapheme.h
+ * @brief Extended grapheme cluster boundaries (UAX #29, Unicode 15.0) over UTF-8.
+ *
+ * Table-driven and platform-neutral: the Grapheme_Cluster_Break and
+ * Extended_Pictographic properties come from a sorted run table, Hangul
+ * syllables are classified arithmetically. Text is read through two spans, or
+ * a byte reader, so a gap buffer or piece table is segmented in place, without
+ * flattening or UTF-16 conversion.
+ *
+ * Every query is local: deciding a boundary reads the two code points around
+ * it, plus the preceding Regional_Indicator run (GB12/GB13) or Extend run
+ * before a ZWJ (GB11) when those rules apply. Stepping from a caret costs the
+ * cluster length, independent of the text size.
+ *
+ * Invalid UTF-8 bytes decode one at a time as U+FFFD, matching the textbox
+ * code point helpers. Positions passed in must be code point boundaries.
+ * @note This is an internal header; do not include from public API.
+ */
+#ifndef FLUX_GRAPHEME_H
+#define FLUX_GRAPHEME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Grapheme_Cluster_Break value, with Extended_Pictographic folded in (it only overlaps Other). */
+typedef enum FluxGraphemeBreak
+{
+	FLUX_GB_OTHER = 0,
+	FLUX_GB_CR,
+	FLUX_GB_LF,
+	FLUX_GB_CONTROL,
+	FLUX_GB_EXTEND,
+	FLUX_GB_ZWJ,
+	FLUX_GB_RI,
+	FLUX_GB_PREPEND,
+	FLUX_GB_SPACING_MARK,
+	FLUX_GB_L,
+	FLUX_GB_V,
+	FLUX_GB_T,
+	FLUX_GB_LV,
+	FLUX_GB_LVT,
+	FLUX_GB_EXT_PICT,
+} FluxGraphemeBreak;
+
+/** @brief UTF-8 text as two consecutive spans (@p tail may be empty); byte offsets run across both.
+ *  With @p byte_at set, bytes are read through it instead and @p head_len is the text length. */
+typedef struct FluxGraphemeText {
+	char const *head;
+	uint32_t    head_len;
+	char const *tail;
+	uint32_t    tail_len;
+	uint8_t     (*byte_at)(void *source, uint32_t pos); /**< Optional reader for text not held in two spans. */
+	void       *source;
+} FluxGraphemeText;
+
+/** @brief Break property of the code point @p cp. */
+FluxGraphemeBreak flux_grapheme_property(uint32_t cp);
+
+/** @brief True when a cluster boundary falls at byte offset @p pos (always at 0 and at the end). */
+bool              flux_grapheme_is_boundary(FluxGraphemeText const *text, uint32_t pos);
+
+/** @brief First boundary after @p pos, or the text length. */
+uint32_t          flux_grapheme_next(FluxGraphemeText const *text, uint32_t pos);
+
+/** @brief Last boundary before @p pos, or 0. */
+uint32_t          flux_grapheme_prev(FluxGraphemeText const *text, uint32_t pos);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
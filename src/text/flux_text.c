@@ -1,4 +1,5 @@
 #include "fluxent/flux_text.h"
+#include "runtime/flux_lru.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -11,16 +12,21 @@
 #include <cd2d.h>
 #include <cdwrite.h>
 
-#define FLUX_FORMAT_CACHE_SIZE 16
-#define FLUX_LAYOUT_CACHE_SIZE 64
+/* Cache charges: DirectWrite keeps per-format font state and per-layout
+ * cluster/glyph/line arrays that grow with the text. Estimates, not exact. */
+#define FLUX_FORMAT_COST            1024u
+#define FLUX_FORMAT_CACHE_BUDGET    (64u * 1024u)
+#define FLUX_LAYOUT_BASE_COST       2048u
+#define FLUX_LAYOUT_COST_PER_UNIT   64u
 
 /* The one default UI font family. Layout-time measure and paint-time draw MUST use
  * the same family or box widths disagree (text is measured narrow, drawn wide, and
  * clips). Both dwrite_create_measure_format and create_styled_format resolve to this. */
 #define FLUX_DEFAULT_FONT_FAMILY L"Segoe UI Variable"
 
+/* Fixed-size key head; the family name (and, for layouts, the text) follow
+ * as separate key parts. All fields are 32-bit, so the head has no padding. */
 typedef struct FluxFormatCacheKey {
-	uint32_t family_hash;
 	uint32_t size_bits;
 	int      font_weight;
 	int      text_align;
@@ -28,28 +34,12 @@ typedef struct FluxFormatCacheKey {
 	int      word_wrap;
 } FluxFormatCacheKey;
 
-typedef struct FluxFormatCacheEntry {
-	FluxFormatCacheKey key;
-	IDWriteTextFormat *format;
-	uint64_t           last_used;
-	bool               occupied;
-} FluxFormatCacheEntry;
-
 typedef struct FluxLayoutCacheKey {
-	uint32_t text_hash;
-	uint32_t text_len;
-	uint32_t format_hash;
-	uint32_t max_w_bits;
-	uint32_t max_h_bits;
+	FluxFormatCacheKey format;
+	uint32_t           max_w_bits;
+	uint32_t           max_h_bits;
 } FluxLayoutCacheKey;
 
-typedef struct FluxLayoutCacheEntry {
-	FluxLayoutCacheKey key;
-	IDWriteTextLayout *layout;
-	uint64_t           last_used;
-	bool               occupied;
-} FluxLayoutCacheEntry;
-
 typedef struct TextWideBuffer {
 	wchar_t  stack [256];
 	wchar_t *text;
@@ -77,34 +67,13 @@ struct FluxTextRenderer {
 	IDWriteFactory       *factory;
 	wchar_t              *default_font;
 	float                 default_size;
-	FluxFormatCacheEntry  format_cache [FLUX_FORMAT_CACHE_SIZE];
-	uint64_t              cache_tick;
-	FluxLayoutCacheEntry  layout_cache [FLUX_LAYOUT_CACHE_SIZE];
+	FluxLru              *format_cache;
+	FluxLru              *layout_cache;
 	ID2D1SolidColorBrush *shared_brush;
 	ID2D1RenderTarget    *brush_rt;
 	XentTextBackend       backend; /**< Persistent storage; xent stores the pointer, not a copy. */
 };
 
-static uint32_t fnv1a_str(char const *s) {
-	uint32_t h = 0x811c9dc5u;
-	if (!s) return h;
-	while (*s) {
-		h ^= ( uint8_t ) *s++;
-		h *= 0x01000193u;
-	}
-	return h;
-}
-
-static uint32_t fnv1a_bytes(void const *data, size_t len) {
-	uint8_t const *p = ( uint8_t const * ) data;
-	uint32_t       h = 0x811c9dc5u;
-	for (size_t i = 0; i < len; i++) {
-		h ^= p [i];
-		h *= 0x01000193u;
-	}
-	return h;
-}
-
 static uint32_t float_to_bits(float f) {
 	uint32_t bits;
 	memcpy(&bits, &f, sizeof(bits));
@@ -205,7 +174,6 @@ static IDWriteTextFormat *create_styled_format(FluxTextRenderer *tr, FluxTextSty
 
 static FluxFormatCacheKey make_format_key(FluxTextStyle const *s) {
 	FluxFormatCacheKey k;
-	k.family_hash = fnv1a_str(s->font_family);
 	k.size_bits   = float_to_bits(s->font_size > 0.0f ? s->font_size : 14.0f);
 	k.font_weight = s->font_weight > 0 ? s->font_weight : 400;
 	k.text_align  = ( int ) s->text_align;
@@ -214,73 +182,34 @@ static FluxFormatCacheKey make_format_key(FluxTextStyle const *s) {
 	return k;
 }
 
-#define DEFINE_TEXT_CACHE_ACCESSORS(                                                                        \
-  Name, EntryType, KeyType, ValueType, cache_field, cache_size, value_field, release_fn                     \
-)                                                                                                           \
-	static ValueType *find_cached_##Name(FluxTextRenderer *tr, KeyType const *key) {                        \
-		for (int i = 0; i < cache_size; i++) {                                                              \
-			EntryType *e = &tr->cache_field [i];                                                            \
-			if (!e->occupied || memcmp(&e->key, key, sizeof(*key)) != 0) continue;                          \
-			e->last_used = tr->cache_tick;                                                                  \
-			return e->value_field;                                                                          \
-		}                                                                                                   \
-		return NULL;                                                                                        \
-	}                                                                                                       \
-	static int find_##Name##_cache_slot(FluxTextRenderer *tr) {                                             \
-		int      slot   = 0;                                                                                \
-		uint64_t oldest = UINT64_MAX;                                                                       \
-		for (int i = 0; i < cache_size; i++) {                                                              \
-			if (!tr->cache_field [i].occupied) return i;                                                    \
-			if (tr->cache_field [i].last_used >= oldest) continue;                                          \
-			oldest = tr->cache_field [i].last_used;                                                         \
-			slot   = i;                                                                                     \
-		}                                                                                                   \
-		return slot;                                                                                        \
-	}                                                                                                       \
-	static void store_cached_##Name(FluxTextRenderer *tr, int slot, KeyType const *key, ValueType *value) { \
-		if (tr->cache_field [slot].occupied && tr->cache_field [slot].value_field)                          \
-			release_fn(tr->cache_field [slot].value_field);                                                 \
-		tr->cache_field [slot].key         = *key;                                                          \
-		tr->cache_field [slot].value_field = value;                                                         \
-		tr->cache_field [slot].last_used   = tr->cache_tick;                                                \
-		tr->cache_field [slot].occupied    = true;                                                          \
-	}
+static uint32_t text_key_len(char const *s) { return s ? ( uint32_t ) strlen(s) : 0; }
 
-DEFINE_TEXT_CACHE_ACCESSORS(
-  format, FluxFormatCacheEntry, FluxFormatCacheKey, IDWriteTextFormat, format_cache, FLUX_FORMAT_CACHE_SIZE, format,
-  IDWriteTextFormat_Release
-)
+static void release_format(void *value) { IDWriteTextFormat_Release(( IDWriteTextFormat * ) value); }
+
+static void release_layout(void *value) { IDWriteTextLayout_Release(( IDWriteTextLayout * ) value); }
 
 static IDWriteTextFormat *get_or_create_format(FluxTextRenderer *tr, FluxTextStyle const *s) {
-	FluxFormatCacheKey key = make_format_key(s);
-	IDWriteTextFormat *fmt = find_cached_format(tr, &key);
+	FluxFormatCacheKey head = make_format_key(s);
+	FluxLruKey         key  = {
+	  .data = {&head, s->font_family},
+	  .len  = {sizeof(head), text_key_len(s->font_family)},
+	};
+	IDWriteTextFormat *fmt = ( IDWriteTextFormat * ) flux_lru_get(tr->format_cache, &key);
 	if (fmt) return fmt;
 
 	fmt = create_styled_format(tr, s);
 	if (!fmt) return NULL;
-	store_cached_format(tr, find_format_cache_slot(tr), &key, fmt);
-	return fmt;
-}
-
-static FluxLayoutCacheKey make_layout_key(char const *utf8_text, FluxTextStyle const *s, float max_w, float max_h) {
-	FluxFormatCacheKey fk = make_format_key(s);
-	FluxLayoutCacheKey key;
-	key.text_hash   = fnv1a_str(utf8_text);
-	key.text_len    = ( uint32_t ) (utf8_text ? strlen(utf8_text) : 0);
-	key.format_hash = fnv1a_bytes(&fk, sizeof(fk));
-	key.max_w_bits  = float_to_bits(max_w);
-	key.max_h_bits  = float_to_bits(max_h);
-	return key;
+	/* The cache owns the format from here (a failed insert releases it). */
+	return flux_lru_put(tr->format_cache, &key, fmt, FLUX_FORMAT_COST) ? fmt : NULL;
 }
 
-DEFINE_TEXT_CACHE_ACCESSORS(
-  layout, FluxLayoutCacheEntry, FluxLayoutCacheKey, IDWriteTextLayout, layout_cache, FLUX_LAYOUT_CACHE_SIZE, layout,
-  IDWriteTextLayout_Release
-)
-
 static IDWriteTextLayout *get_or_create_layout(FluxTextRenderer *tr, TextLayoutCacheRequest const *req) {
-	FluxLayoutCacheKey key    = make_layout_key(req->utf8_text, req->style, req->max_w, req->max_h);
-	IDWriteTextLayout *layout = find_cached_layout(tr, &key);
+	FluxLayoutCacheKey head = {make_format_key(req->style), float_to_bits(req->max_w), float_to_bits(req->max_h)};
+	FluxLruKey         key  = {
+	  .data = {&head, req->style->font_family, req->utf8_text},
+	  .len  = {sizeof(head), text_key_len(req->style->font_family), text_key_len(req->utf8_text)},
+	};
+	IDWriteTextLayout *layout = ( IDWriteTextLayout * ) flux_lru_get(tr->layout_cache, &key);
 	if (layout) return layout;
 
 	IDWriteTextFormat *fmt = get_or_create_format(tr, req->style);
@@ -291,7 +220,10 @@ static IDWriteTextLayout *get_or_create_layout(FluxTextRenderer *tr, TextLayoutC
 	  tr->factory, req->wtext, ( UINT32 ) req->wlen, fmt, req->max_w, req->max_h, &layout
 	);
 	if (FAILED(hr)) return NULL;
-	store_cached_layout(tr, find_layout_cache_slot(tr), &key, layout);
+	/* Inserting trims older layouts but never the newest, so the pointer
+	 * stays valid for the caller's single use. */
+	size_t cost = FLUX_LAYOUT_BASE_COST + FLUX_LAYOUT_COST_PER_UNIT * ( size_t ) req->wlen;
+	if (!flux_lru_put(tr->layout_cache, &key, layout, cost)) return NULL;
 	return layout;
 }
 
@@ -400,6 +332,13 @@ FluxTextRenderer *flux_text_renderer_create(void) {
 		return NULL;
 	}
 
+	tr->format_cache = flux_lru_create(FLUX_FORMAT_CACHE_BUDGET, release_format);
+	tr->layout_cache = flux_lru_create(FLUX_TEXT_LAYOUT_CACHE_BUDGET, release_layout);
+	if (!tr->format_cache || !tr->layout_cache) {
+		flux_text_renderer_destroy(tr);
+		return NULL;
+	}
+
 	tr->default_size = 14.0f;
 	return tr;
 }
@@ -407,13 +346,8 @@ FluxTextRenderer *flux_text_renderer_create(void) {
 void flux_text_renderer_destroy(FluxTextRenderer *tr) {
 	if (!tr) return;
 
-	for (int i = 0; i < FLUX_FORMAT_CACHE_SIZE; i++)
-		if (tr->format_cache [i].occupied && tr->format_cache [i].format)
-			IDWriteTextFormat_Release(tr->format_cache [i].format);
-
-	for (int i = 0; i < FLUX_LAYOUT_CACHE_SIZE; i++)
-		if (tr->layout_cache [i].occupied && tr->layout_cache [i].layout)
-			IDWriteTextLayout_Release(tr->layout_cache [i].layout);
+	flux_lru_destroy(tr->layout_cache);
+	flux_lru_destroy(tr->format_cache);
 
 	if (tr->shared_brush) ID2D1SolidColorBrush_Release(tr->shared_brush);
 
@@ -433,6 +367,29 @@ bool flux_text_renderer_register(FluxTextRenderer *tr, XentContext *ctx) {
 	return xent_set_text_backend(ctx, &tr->backend);
 }
 
+void flux_text_renderer_set_cache_budget(FluxTextRenderer *tr, size_t bytes) {
+	if (tr) flux_lru_set_budget(tr->layout_cache, bytes);
+}
+
+static void text_cache_stats(FluxLru const *cache, FluxTextCacheStats *out) {
+	if (!out) return;
+	FluxLruStats st;
+	flux_lru_stats(cache, &st);
+	*out = (FluxTextCacheStats) {
+	  .hits      = st.hits,
+	  .misses    = st.misses,
+	  .evictions = st.evictions,
+	  .entries   = st.entries,
+	  .bytes     = st.bytes,
+	  .budget    = st.budget,
+	};
+}
+
+void flux_text_renderer_cache_stats(FluxTextRenderer const *tr, FluxTextCacheStats *layouts, FluxTextCacheStats *formats) {
+	text_cache_stats(tr ? tr->layout_cache : NULL, layouts);
+	text_cache_stats(tr ? tr->format_cache : NULL, formats);
+}
+
 #define FLUX_TEXT_UNBOUNDED 100000.0f
 
 static IDWriteTextLayout *text_layout_from_utf8(TextLayoutRequest const *req, TextWideBuffer *wide) {
@@ -487,8 +444,6 @@ void flux_text_draw(
 ) {
 	if (!tr || !rt || !text || !text [0] || !bounds || !style) return;
 
-	tr->cache_tick++;
-
 	TextWideBuffer     wide;
 	TextLayoutRequest  req    = {tr, text, style, bounds->w, bounds->h};
 	IDWriteTextLayout *layout = text_layout_from_utf8(&req, &wide);
@@ -511,8 +466,6 @@ FluxSize flux_text_measure(FluxTextRenderer *tr, char const *text, FluxTextStyle
 	FluxSize result = {0, 0};
 	if (!tr || !text || !text [0] || !style) return result;
 
-	tr->cache_tick++;
-
 	TextWideBuffer     wide;
 	float              mw     = text_effective_max_width(max_width);
 	TextLayoutRequest  req    = {tr, text, style, mw, FLUX_TEXT_UNBOUNDED};
@@ -533,8 +486,6 @@ int flux_text_hit_test(FluxTextHitTestQuery const *query) {
 	if (!query || !query->layout.renderer || !query->layout.text || !query->layout.text [0] || !query->layout.style)
 		return 0;
 
-	query->layout.renderer->cache_tick++;
-
 	TextWideBuffer     wide;
 	TextLayoutRequest  req    = text_layout_request(&query->layout, NULL);
 	IDWriteTextLayout *layout = text_layout_from_utf8(&req, &wide);
@@ -554,8 +505,6 @@ FluxRect flux_text_caret_rect(FluxTextCaretQuery const *query) {
 	FluxRect result = {0, 0, 1.0f, 0};
 	if (!query || !query->layout.renderer || !query->layout.style) return result;
 
-	query->layout.renderer->cache_tick++;
-
 	char const        *safe = (query->layout.text && query->layout.text [0]) ? query->layout.text : " ";
 	TextWideBuffer     wide;
 	TextLayoutRequest  req    = text_layout_request(&query->layout, safe);
@@ -628,8 +577,6 @@ uint32_t flux_text_selection_rects(FluxTextSelectionQuery const *query) {
 		return 0;
 	if (query->start >= query->end) return 0;
 
-	query->layout.renderer->cache_tick++;
-
 	TextWideBuffer     wide;
 	TextLayoutRequest  req    = text_layout_request(&query->layout, NULL);
 	IDWriteTextLayout *layout = text_layout_from_utf8(&req, &wide);
@@ -667,8 +614,6 @@ static IDWriteTextLayout *text_cluster_layout(FluxTextClusterQuery const *query,
 uint32_t flux_text_cluster_next(FluxTextClusterQuery const *query) {
 	if (!query || !query->layout.renderer || !query->layout.style) return query ? query->index : 0;
 
-	query->layout.renderer->cache_tick++;
-
 	TextWideBuffer     wide;
 	int                wlen   = 0;
 	IDWriteTextLayout *layout = text_cluster_layout(query, &wide, &wlen);
@@ -691,8 +636,6 @@ uint32_t flux_text_cluster_prev(FluxTextClusterQuery const *query) {
 	if (!query || !query->layout.renderer || !query->layout.style) return query ? query->index : 0;
 	if (query->index == 0) return 0;
 
-	query->layout.renderer->cache_tick++;
-
 	TextWideBuffer     wide;
 	int                wlen   = 0;
 	IDWriteTextLayout *layout = text_cluster_layout(query, &wide, &wlen);
@@ -0,0 +1,15 @@
+#include "flux_list_heights.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+static float ref[5000]; static int n;
+static double est(FluxListRowHeights*h){return flux_list_heights_estimate(h);}
+int main(){ FluxListRowHeights h={0}; h.fallback=20; srand(1); int bad=0;
+ for(int it=0;it<200000;it++){ int op=rand()%10;
+  if(op==0){ int c=rand()%3000; flux_list_heights_resize(&h,c); for(int i=n;i<c;i++) ref[i]=-1; n=c;}
+  else if(op<6 && n>0){int r=rand()%n; float v=(rand()%100)+1; flux_list_heights_measure(&h,r,v); ref[r]=v;}
+  else { if(!n) continue; int r=rand()%(n+1); double e=est(&h), s=0; for(int i=0;i<r;i++) s+= ref[i]>=0?ref[i]:e;
+    double o=flux_list_heights_offset(&h,r); if(fabs(o-s)>1e-3*(1+s)){ if(bad++<5) printf("offset mismatch it=%d r=%d %f %f\n",it,r,o,s);} 
+    double y= (double)(rand()%100000); int rr=flux_list_heights_row_at(&h,y); double t=0; int exp=0; for(int i=0;i<n;i++){ if(t<=y) exp=i; t+= ref[i]>=0?ref[i]:e;} if(y<=0) exp=0;
+    if(rr!=exp){ if(bad++<5) printf("row_at mismatch y=%f got %d exp %d\n",y,rr,exp);} }
+ } printf("bad=%d\n",bad); }
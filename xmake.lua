@@ -112,6 +112,117 @@ target("test_subtree")
     add_includedirs("include")
 target_end()
 
+target("test_node_store")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_node_store.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_fx_node_bench")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_fx_node_bench.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_fx_hit_index")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_fx_hit_index.c")
+    add_includedirs("include")
+target_end()
+
+target("test_fx_tree")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_fx_tree.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_lru")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_lru.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_grapheme")
+    set_kind("binary")
+    add_files("examples/tests/test_grapheme.c", "src/text/flux_grapheme.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_tb_buffer")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_tb_buffer.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_tb_undo")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_tb_undo.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_image_store")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_image_store.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_anim_driver")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_anim_driver.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_tween_batch")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_tween_batch.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_layout_skip")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_layout_skip.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_layout_partial")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_layout_partial.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_plugin_registry")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_plugin_registry.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_frame_stats")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_frame_stats.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_fx_hit_transform")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_fx_hit_transform.c")
+    add_includedirs("include")
+target_end()
+
 target("test_fx_el")
     set_kind("binary")
     add_deps("fluxent")
@@ -168,6 +279,34 @@ target("test_fx_new_controls")
     add_includedirs("include", "src", "src/bridge")
 target_end()
 
+target("test_fx_damage")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_fx_damage.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_fx_retain")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_fx_retain.c")
+    add_includedirs("include")
+target_end()
+
+target("test_fx_collect_bench")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_fx_collect_bench.c")
+    add_includedirs("include", "src")
+target_end()
+
+target("test_fx_gallery_commands")
+    set_kind("binary")
+    add_deps("fluxent")
+    add_files("examples/tests/test_fx_gallery_commands.c", "examples/gallery/gallery_helpers.c", "examples/gallery/page_*.c")
+    add_includedirs("include", "src", "src/bridge", "examples/gallery")
+target_end()
+
 target("hello_fluxent")
     set_kind("binary")
     add_deps("fluxent")